@@ -0,0 +1,206 @@
+// AnalyzeMain.cpp - โปรแกรมวิเคราะห์ไฟล์ replay จำนวนมาก fibo_analyze
+// เดินเกมซ้ำทุกไฟล์แบบขนานแล้วตอบคำค้น เช่น "ชนะกี่ % เมื่อ Ride G3-04 ภายในเทิร์น 5"
+//   fibo_analyze replays --event ride --where card=G3-04 --where turn<=5 --agg winrate
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <climits>
+#include "ReplayCorpus.h"
+#include "../Game Core/CardDatabase.h"
+#include "../Game Core/StateCodec.h"
+#include "../UI System/UIHelper.h"
+
+using namespace std;
+
+// เติมช่องว่างให้ข้อความกว้างเท่ากับ width ตามความกว้างที่แสดงจริง (setw นับเป็นไบต์ ภาษาไทยจึงเพี้ยน)
+static string padCell(const string &text, int width, bool align_right)
+{
+  string padding(static_cast<size_t>(max(0, width - UIHelper::GetDisplayWidth(text))), ' ');
+  return align_right ? padding + text : text + padding;
+}
+
+// แปลงค่าตัวเลขของตัวเลือก (ต้องเป็นเลขฐานสิบไม่ติดลบทั้งข้อความ และไม่เกิน max_value)
+static bool parseNumber(const string &text, uint64_t max_value, uint64_t &value)
+{
+  if (text.empty() || !isdigit(static_cast<unsigned char>(text[0])))
+  {
+    return false;
+  }
+  try
+  {
+    size_t used = 0;
+    value = stoull(text, &used);
+    return used == text.size() && value <= max_value;
+  }
+  catch (const exception &) // invalid_argument / out_of_range
+  {
+    return false;
+  }
+}
+
+// ตัวเลือก:
+//   --event <ชนิด>     ชนิดเหตุการณ์: ride, call, attack, guard, damage, result (ค่าเริ่มต้น result)
+//   --where <เงื่อนไข>  เช่น turn<=5, card=G3-04, guards>=1 (ใช้ซ้ำได้ ทุกข้อต้องเป็นจริง)
+//   --agg <วิธี>       count, winrate, sum:<ช่อง>, avg:<ช่อง>, min:<ช่อง>, max:<ช่อง> (ค่าเริ่มต้น count)
+//   --by <ช่อง>        แยกผลตามค่าของช่องที่กำหนด เช่น card หรือ turn
+//   --threads <n>      จำนวนเธรด (ค่าเริ่มต้น = จำนวนคอร์)
+//   --cards <file>     ไฟล์ข้อมูลการ์ด (ค่าเริ่มต้น cards.json) ต้องเป็นชุดเดียวกับตอนบันทึก
+// ตามด้วยโฟลเดอร์หรือไฟล์ replay อย่างน้อย 1 รายการ
+int main(int argc, char *argv[])
+{
+  string cards_path = "cards.json";
+  unsigned threads = 0;
+  vector<string> paths;
+  string event_kind = "result", aggregate = "count", group_by;
+  vector<string> conditions;
+  for (int i = 1; i < argc; ++i)
+  {
+    string arg = argv[i];
+    if (arg == "--event" && i + 1 < argc)
+    {
+      event_kind = argv[++i];
+    }
+    else if (arg == "--where" && i + 1 < argc)
+    {
+      conditions.push_back(argv[++i]);
+    }
+    else if (arg == "--agg" && i + 1 < argc)
+    {
+      aggregate = argv[++i];
+    }
+    else if (arg == "--by" && i + 1 < argc)
+    {
+      group_by = argv[++i];
+    }
+    else if (arg == "--threads" && i + 1 < argc)
+    {
+      uint64_t value = 0;
+      if (!parseNumber(argv[++i], UINT_MAX, value))
+      {
+        paths.clear(); // แสดงวิธีใช้แล้วออกด้วยรหัส 2
+        break;
+      }
+      threads = static_cast<unsigned>(value);
+    }
+    else if (arg == "--cards" && i + 1 < argc)
+    {
+      cards_path = argv[++i];
+    }
+    else if (!arg.empty() && arg[0] != '-')
+    {
+      paths.push_back(arg);
+    }
+    else
+    {
+      paths.clear();
+      break;
+    }
+  }
+  if (paths.empty())
+  {
+    cerr << "วิธีใช้: " << argv[0]
+         << " [--event <ชนิด>] [--where <เงื่อนไข>]... [--agg <วิธี>] [--by <ช่อง>] [--threads <n>] [--cards <file>]"
+            " <โฟลเดอร์หรือไฟล์ replay>..."
+         << endl;
+    return 2;
+  }
+
+  UIHelper::SetAnimationEnabled(false);
+  vector<Card> catalog = loadCardsFromJson(cards_path);
+  if (catalog.empty())
+  {
+    return 1;
+  }
+
+  // ตรวจคำค้นทั้งหมดก่อนเริ่มอ่านไฟล์
+  unordered_map<string, uint32_t> card_index = makeStateCardIndex(catalog);
+  ReplayQuery query;
+  string error;
+  bool valid = query.setKind(event_kind, error) && query.setAggregate(aggregate, error) &&
+               (group_by.empty() || query.setGroupBy(group_by, error));
+  for (size_t i = 0; valid && i < conditions.size(); ++i)
+  {
+    valid = query.addCondition(conditions[i], card_index, error);
+  }
+  if (!valid)
+  {
+    UIHelper::PrintError(error);
+    return 2;
+  }
+
+  vector<string> missing;
+  vector<string> files = listReplayFiles(paths, missing);
+  for (const string &path : missing)
+  {
+    UIHelper::PrintWarning("ไม่พบ '" + path + "'");
+  }
+  if (files.empty())
+  {
+    UIHelper::PrintError("ไม่พบไฟล์ replay");
+    return 1;
+  }
+
+  auto started = chrono::steady_clock::now();
+  QueryResult result = runCorpusQuery(files, catalog, query, threads);
+  double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+
+  cout << "อ่าน " << result.files << " ไฟล์ (" << result.bytes << " ไบต์) เดินเกมซ้ำ " << result.actions
+       << " การกระทำ ใน " << fixed << setprecision(3) << seconds << " วินาที";
+  if (seconds > 0)
+  {
+    cout << " (" << setprecision(0) << static_cast<double>(result.files) / seconds << " ไฟล์/วินาที)";
+  }
+  cout << "\nเกมที่นำมาคิด " << result.games << " เกม, เหตุการณ์ " << result.events << " แถว\n";
+  if (result.unfinished > 0)
+  {
+    UIHelper::PrintInfo("ข้าม " + to_string(result.unfinished) + " ไฟล์ที่จบก่อนเกมจบ");
+  }
+  if (result.failed > 0)
+  {
+    UIHelper::PrintWarning("ข้าม " + to_string(result.failed) + " ไฟล์ที่อ่านไม่ได้ เช่น " + result.first_error);
+  }
+
+  // เรียงกลุ่มตามค่าของช่องที่จัดกลุ่ม
+  vector<pair<int32_t, QueryAccumulator>> groups(result.groups.begin(), result.groups.end());
+  sort(groups.begin(), groups.end(),
+       [](const pair<int32_t, QueryAccumulator> &a, const pair<int32_t, QueryAccumulator> &b) { return a.first < b.first; });
+
+  bool per_side = query.getAggregate() == QueryAggregate::WinRate;
+  cout << "\n";
+  if (query.isGrouped())
+  {
+    cout << padCell(eventFieldName(query.getGroupField()), 10, false) << " ";
+  }
+  cout << padCell(per_side ? "ผู้เล่น" : "แถว", 10, true) << "  " << query.describe() << "\n";
+  for (const auto &group : groups)
+  {
+    if (query.isGrouped())
+    {
+      bool known_card = query.getGroupField() == EventField::Card && group.first >= 0 &&
+                        static_cast<size_t>(group.first) < catalog.size();
+      string key = known_card ? catalog[static_cast<size_t>(group.first)].getCodeName() : to_string(group.first);
+      cout << padCell(key, 10, false) << " ";
+    }
+    cout << padCell(to_string(per_side ? group.second.sides : group.second.count), 10, true) << "  ";
+    double value = query.valueOf(group.second);
+    if (query.getAggregate() == QueryAggregate::Average || per_side)
+    {
+      cout << setprecision(2) << value << (per_side ? " %" : "") << "\n";
+    }
+    else
+    {
+      cout << setprecision(0) << value << "\n";
+    }
+  }
+  if (groups.empty())
+  {
+    cout << "(ไม่มีแถวที่ตรงเงื่อนไข)\n";
+  }
+  return result.failed > 0 && result.games == 0 ? 1 : 0;
+}
@@ -0,0 +1,202 @@
+// ReplayCorpus.cpp - ไฟล์ Source สำหรับวิเคราะห์ไฟล์ replay จำนวนมาก
+#include "ReplayCorpus.h"
+#include "../Game Core/Replay.h"
+#include "../Game Core/StateCodec.h"
+#include "../UI System/OutputSink.h"
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static const size_t CORPUS_FILES_PER_CLAIM = 16; // ไฟล์ที่เธรดหยิบไปต่อครั้ง (ลดการแย่งตัวนับเมื่อไฟล์เล็กมาก)
+
+// --- MappedFile ---
+
+MappedFile::MappedFile() : data(nullptr), size(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+bool MappedFile::open(const std::string &path)
+{
+  close();
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size <= 0)
+  {
+    ::close(fd);
+    return false;
+  }
+  void *mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // การแมปยังอยู่หลังปิด fd
+  if (mapped == MAP_FAILED)
+  {
+    return false;
+  }
+  madvise(mapped, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+  data = static_cast<const uint8_t *>(mapped);
+  size = static_cast<size_t>(info.st_size);
+  return true;
+}
+
+void MappedFile::close()
+{
+  if (data)
+  {
+    munmap(const_cast<uint8_t *>(data), size);
+    data = nullptr;
+    size = 0;
+  }
+}
+
+// --- รายชื่อไฟล์ ---
+
+std::vector<std::string> listReplayFiles(const std::vector<std::string> &paths, std::vector<std::string> &missing)
+{
+  namespace fs = std::filesystem;
+  std::vector<std::string> files;
+  for (const std::string &path : paths)
+  {
+    std::error_code ec;
+    if (fs::is_directory(path, ec))
+    {
+      for (fs::recursive_directory_iterator it(path, ec), end; it != end && !ec; it.increment(ec))
+      {
+        if (it->is_regular_file(ec) && it->path().extension() == ".fibr")
+        {
+          files.push_back(it->path().string());
+        }
+      }
+    }
+    else if (fs::is_regular_file(path, ec))
+    {
+      files.push_back(path);
+    }
+    else
+    {
+      missing.push_back(path);
+    }
+  }
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+// --- การเดินเกมซ้ำหลายเธรด ---
+
+// งานของเธรด 1 เธรด: หยิบไฟล์ทีละชุดจาก next_file จนหมด แล้วรวมผลลงใน result ของตัวเอง
+static void analyzeFiles(const std::vector<std::string> &files, const std::vector<Card> &catalog,
+                         const std::unordered_map<std::string, uint32_t> &card_index, const ReplayQuery &query,
+                         std::atomic<size_t> &next_file, QueryResult &result)
+{
+  NullSink quiet; // ข้อความที่เกมพิมพ์ระหว่างเดินเกมซ้ำไม่ต้องแสดง (sink แยกกันในแต่ละเธรด)
+  ScopedOutputSink quiet_scope(&quiet);
+
+  ReplaySimulator simulator;
+  ReplayEventCollector collector(card_index);
+  MappedFile mapped;
+  ReplayRecord record;
+
+  for (;;)
+  {
+    size_t begin = next_file.fetch_add(CORPUS_FILES_PER_CLAIM, std::memory_order_relaxed);
+    if (begin >= files.size())
+    {
+      break;
+    }
+    size_t end = std::min(files.size(), begin + CORPUS_FILES_PER_CLAIM);
+    for (size_t i = begin; i < end; ++i)
+    {
+      result.files++;
+      if (!mapped.open(files[i]))
+      {
+        result.failed++;
+        if (result.first_error.empty())
+        {
+          result.first_error = files[i] + ": เปิดไฟล์ไม่ได้";
+        }
+        continue;
+      }
+      result.bytes += mapped.getSize();
+
+      bool ok = simulator.open(mapped.getData(), mapped.getSize(), catalog, &collector);
+      if (ok)
+      {
+        collector.begin(simulator.getMatch());
+        while (simulator.step(&record))
+        {
+          if (record.type == ReplayRecordType::Action)
+          {
+            collector.onAction(record.action);
+          }
+        }
+        ok = simulator.getError().empty();
+      }
+      mapped.close();
+
+      if (!ok)
+      {
+        result.failed++;
+        if (result.first_error.empty())
+        {
+          result.first_error = files[i] + ": " + simulator.getError();
+        }
+        continue;
+      }
+      result.actions += simulator.getActionsApplied();
+      if (!simulator.isFinished())
+      {
+        result.unfinished++;
+        continue;
+      }
+      collector.finish();
+      query.accumulate(collector.getEvents(), result);
+      result.games++;
+    }
+  }
+}
+
+QueryResult runCorpusQuery(const std::vector<std::string> &files, const std::vector<Card> &catalog,
+                           const ReplayQuery &query, unsigned threads)
+{
+  if (threads == 0)
+  {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  threads = static_cast<unsigned>(std::min<size_t>(threads, (files.size() + CORPUS_FILES_PER_CLAIM - 1) / CORPUS_FILES_PER_CLAIM));
+  threads = std::max(1u, threads);
+
+  std::unordered_map<std::string, uint32_t> card_index = makeStateCardIndex(catalog);
+  std::atomic<size_t> next_file(0);
+  std::vector<QueryResult> partial(threads); // ผลของแต่ละเธรด (เธรดเขียนเฉพาะช่องของตัวเอง)
+
+  std::vector<std::thread> workers;
+  for (unsigned t = 1; t < threads; ++t)
+  {
+    workers.emplace_back(analyzeFiles, std::cref(files), std::cref(catalog), std::cref(card_index), std::cref(query),
+                         std::ref(next_file), std::ref(partial[t]));
+  }
+  analyzeFiles(files, catalog, card_index, query, next_file, partial[0]); // เธรดหลักช่วยทำงานด้วย
+  for (std::thread &worker : workers)
+  {
+    worker.join();
+  }
+
+  // รวมผลหลังทุกเธรดจบแล้ว - ผลรวมทุกชนิดสลับลำดับได้ ผลลัพธ์จึงไม่ขึ้นกับว่าเธรดไหนได้ไฟล์ไหน
+  for (unsigned t = 1; t < threads; ++t)
+  {
+    partial[0].merge(partial[t]);
+  }
+  return std::move(partial[0]);
+}
@@ -0,0 +1,42 @@
+// ReplayCorpus.h - ไฟล์ Header สำหรับวิเคราะห์ไฟล์ replay จำนวนมากพร้อมกันหลายเธรด
+// แต่ละไฟล์ถูก mmap แล้วอ่านตรงจากหน่วยความจำที่แมปไว้ (ไม่คัดลอกผ่านบัฟเฟอร์ของ stdio)
+// เธรดแย่งกันหยิบไฟล์ถัดไปจากตัวนับ atomic ตัวเดียว และรวมผลลงโครงสร้างของตัวเองเท่านั้น
+// ผลของทุกเธรดถูกรวมกันครั้งเดียวหลังทุกเธรดจบ ระหว่างทำงานจึงไม่มี lock หรือข้อมูลที่ใช้ร่วมกันเลย
+#ifndef REPLAYCORPUS_H
+#define REPLAYCORPUS_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "ReplayQuery.h"
+#include "../Game Core/Card.h"
+
+// ไฟล์ที่แมปเข้าหน่วยความจำแบบอ่านอย่างเดียว (ยกเลิกการแมปเมื่อทำลายออบเจกต์)
+class MappedFile
+{
+private:
+  const uint8_t *data;
+  size_t size;
+
+public:
+  MappedFile();
+  ~MappedFile();
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  bool open(const std::string &path); // คืนค่า false ถ้าเปิดหรือแมปไม่ได้ (ไฟล์ว่างก็ถือว่าแมปไม่ได้)
+  void close();
+
+  const uint8_t *getData() const { return data; }
+  size_t getSize() const { return size; }
+};
+
+// รายชื่อไฟล์ replay จาก path ที่กำหนด: โฟลเดอร์ = ทุกไฟล์ .fibr ข้างใน (รวมโฟลเดอร์ย่อย), ไฟล์ = ใช้ตามนั้น
+// เรียงตามชื่อเพื่อให้ผลลัพธ์เหมือนเดิมทุกครั้ง - path ที่ไม่มีอยู่จริงจะถูกเก็บไว้ใน missing
+std::vector<std::string> listReplayFiles(const std::vector<std::string> &paths, std::vector<std::string> &missing);
+
+// เดินเกมซ้ำทุกไฟล์แล้วรวมผลของคำค้น (threads = 0 คือใช้ทุกคอร์)
+QueryResult runCorpusQuery(const std::vector<std::string> &files, const std::vector<Card> &catalog,
+                           const ReplayQuery &query, unsigned threads = 0);
+
+#endif // REPLAYCORPUS_H
@@ -0,0 +1,409 @@
+// ReplayQuery.cpp - ไฟล์ Source สำหรับเหตุการณ์จาก replay และคำค้น
+#include "ReplayQuery.h"
+#include "../Game Core/BattleResolver.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+static const char *const EVENT_KIND_NAMES[] = {"ride", "call", "attack", "guard", "damage", "result"};
+static const char *const EVENT_FIELD_NAMES[] = {"turn",   "seat",   "card",   "grade", "slot", "power",
+                                                "shield", "guards", "damage", "hit",   "won"};
+
+const char *eventFieldName(EventField field)
+{
+  return field < EventField::Count ? EVENT_FIELD_NAMES[static_cast<size_t>(field)] : "";
+}
+
+static bool parseField(const std::string &text, EventField &field)
+{
+  for (size_t i = 0; i < EVENT_FIELD_COUNT; ++i)
+  {
+    if (text == EVENT_FIELD_NAMES[i])
+    {
+      field = static_cast<EventField>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+// --- ReplayEventCollector ---
+
+ReplayEventCollector::ReplayEventCollector(const std::unordered_map<std::string, uint32_t> &card_catalog_index)
+    : card_index(card_catalog_index), match(nullptr), current_attack(-1)
+{
+}
+
+void ReplayEventCollector::begin(const Match &replayed_match)
+{
+  match = &replayed_match;
+  events.clear();
+  current_attack = -1;
+}
+
+ReplayEvent &ReplayEventCollector::push(ReplayEventKind kind, int seat, const Card *card)
+{
+  events.emplace_back();
+  ReplayEvent &event = events.back();
+  event.kind = kind;
+  event.set(EventField::Turn, match->getTurnCount());
+  event.set(EventField::Seat, seat);
+  event.set(EventField::Card, -1);
+  if (card)
+  {
+    auto it = card_index.find(card->getCodeName());
+    event.set(EventField::Card, it != card_index.end() ? static_cast<int32_t>(it->second) : -1);
+    event.set(EventField::Grade, card->getGrade());
+    event.set(EventField::Power, card->getPower());
+    event.set(EventField::Shield, card->getShield());
+  }
+  return event;
+}
+
+void ReplayEventCollector::onAction(const GameAction &action)
+{
+  int turn_seat = match->getCurrentPlayerIndex();
+  const Player &turn_player = match->getPlayer(turn_seat);
+  switch (action.type)
+  {
+  case ActionType::Ride:
+    if (turn_player.getVanguard())
+    {
+      push(ReplayEventKind::Ride, turn_seat, turn_player.getVanguard());
+    }
+    break;
+  case ActionType::Call:
+  {
+    const auto rear_guards = turn_player.getRearGuards();
+    if (action.target >= 0 && static_cast<size_t>(action.target) < rear_guards.size() &&
+        rear_guards[static_cast<size_t>(action.target)])
+    {
+      ReplayEvent &event = push(ReplayEventKind::Call, turn_seat, rear_guards[static_cast<size_t>(action.target)]);
+      event.set(EventField::Slot, action.target);
+    }
+    break;
+  }
+  case ActionType::Guard:
+  {
+    CardZoneView guardians = match->getPlayer(1 - turn_seat).getGuardianZone();
+    if (!guardians.empty())
+    {
+      push(ReplayEventKind::Guard, 1 - turn_seat, &guardians.back());
+    }
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+void ReplayEventCollector::onBattleResult(Player &attacker, Player &defender, const AttackState &attack,
+                                          int defense_power)
+{
+  ReplayEvent &event = push(ReplayEventKind::Attack, seatOf(attacker), attacker.getUnitAt(attack.attacker_idx));
+  event.set(EventField::Slot, attack.attacker_idx);
+  event.set(EventField::Power, attack.power);
+  event.set(EventField::Shield, defender.getGuardianZoneShieldTotal());
+  event.set(EventField::Guards, static_cast<int32_t>(defender.getGuardianZone().size()));
+  event.set(EventField::Hit, isBattleHit(attack.power, defense_power) ? 1 : 0);
+  current_attack = static_cast<int>(events.size()) - 1;
+}
+
+void ReplayEventCollector::onDamageRevealed(Player &defender, const Card &damage_card)
+{
+  push(ReplayEventKind::Damage, seatOf(defender), &damage_card);
+}
+
+void ReplayEventCollector::onDamageTaken(Player &defender, const TriggerOutput & /*trigger*/)
+{
+  int32_t damage = static_cast<int32_t>(defender.getDamageCount());
+  if (!events.empty() && events.back().kind == ReplayEventKind::Damage)
+  {
+    events.back().set(EventField::Damage, damage);
+  }
+  if (current_attack >= 0)
+  {
+    ReplayEvent &attack = events[static_cast<size_t>(current_attack)];
+    attack.set(EventField::Damage, attack.get(EventField::Damage) + 1);
+  }
+}
+
+void ReplayEventCollector::onAttackEnd(Player & /*attacker*/)
+{
+  current_attack = -1;
+}
+
+void ReplayEventCollector::finish()
+{
+  int winner = match->getWinnerIndex();
+  for (int seat = 0; seat < 2; ++seat)
+  {
+    ReplayEvent &event = push(ReplayEventKind::Result, seat, nullptr);
+    event.set(EventField::Damage, static_cast<int32_t>(match->getPlayer(seat).getDamageCount()));
+  }
+  for (ReplayEvent &event : events)
+  {
+    event.set(EventField::Won, event.get(EventField::Seat) == winner ? 1 : 0);
+  }
+}
+
+// --- QueryCondition / QueryAccumulator / QueryResult ---
+
+bool QueryCondition::test(const ReplayEvent &event) const
+{
+  int32_t actual = event.get(field);
+  switch (op)
+  {
+  case CompareOp::Equal:
+    return actual == value;
+  case CompareOp::NotEqual:
+    return actual != value;
+  case CompareOp::Less:
+    return actual < value;
+  case CompareOp::LessEqual:
+    return actual <= value;
+  case CompareOp::Greater:
+    return actual > value;
+  case CompareOp::GreaterEqual:
+    return actual >= value;
+  }
+  return false;
+}
+
+void QueryAccumulator::add(int32_t value)
+{
+  count++;
+  sum += value;
+  min = std::min(min, value);
+  max = std::max(max, value);
+}
+
+void QueryAccumulator::merge(const QueryAccumulator &other)
+{
+  count += other.count;
+  sum += other.sum;
+  min = std::min(min, other.min);
+  max = std::max(max, other.max);
+  sides += other.sides;
+  wins += other.wins;
+}
+
+void QueryResult::merge(const QueryResult &other)
+{
+  for (const auto &entry : other.groups)
+  {
+    groups[entry.first].merge(entry.second);
+  }
+  files += other.files;
+  games += other.games;
+  unfinished += other.unfinished;
+  failed += other.failed;
+  events += other.events;
+  actions += other.actions;
+  bytes += other.bytes;
+  if (first_error.empty())
+  {
+    first_error = other.first_error;
+  }
+}
+
+// --- ReplayQuery ---
+
+ReplayQuery::ReplayQuery()
+    : kind(ReplayEventKind::Result), aggregate(QueryAggregate::Count), value_field(EventField::Turn),
+      group_field(EventField::Count)
+{
+}
+
+bool ReplayQuery::setKind(const std::string &text, std::string &error)
+{
+  for (size_t i = 0; i < sizeof(EVENT_KIND_NAMES) / sizeof(EVENT_KIND_NAMES[0]); ++i)
+  {
+    if (text == EVENT_KIND_NAMES[i])
+    {
+      kind = static_cast<ReplayEventKind>(i);
+      return true;
+    }
+  }
+  error = "ไม่รู้จักชนิดเหตุการณ์ '" + text + "' (ride, call, attack, guard, damage, result)";
+  return false;
+}
+
+bool ReplayQuery::addCondition(const std::string &text, const std::unordered_map<std::string, uint32_t> &card_index,
+                               std::string &error)
+{
+  // ตัวดำเนินการ 2 ตัวอักษรต้องตรวจก่อน 1 ตัวอักษร
+  static const std::pair<const char *, CompareOp> OPERATORS[] = {
+      {"<=", CompareOp::LessEqual}, {">=", CompareOp::GreaterEqual}, {"!=", CompareOp::NotEqual},
+      {"=", CompareOp::Equal},      {"<", CompareOp::Less},          {">", CompareOp::Greater}};
+
+  QueryCondition condition;
+  size_t op_pos = std::string::npos;
+  size_t op_size = 0;
+  for (const auto &entry : OPERATORS)
+  {
+    size_t pos = text.find(entry.first);
+    if (pos != std::string::npos && pos > 0)
+    {
+      op_pos = pos;
+      op_size = std::char_traits<char>::length(entry.first);
+      condition.op = entry.second;
+      break;
+    }
+  }
+  if (op_pos == std::string::npos || !parseField(text.substr(0, op_pos), condition.field))
+  {
+    error = "เงื่อนไขไม่ถูกต้อง: '" + text + "' (ตัวอย่าง turn<=5, card=G3-04)";
+    return false;
+  }
+
+  std::string value = text.substr(op_pos + op_size);
+  if (condition.field == EventField::Card)
+  {
+    auto it = card_index.find(value);
+    if (it == card_index.end())
+    {
+      error = "ไม่พบการ์ดรหัส '" + value + "' ในแคตตาล็อก";
+      return false;
+    }
+    condition.value = static_cast<int32_t>(it->second);
+  }
+  else
+  {
+    try
+    {
+      size_t used = 0;
+      condition.value = std::stoi(value, &used);
+      if (used != value.size())
+      {
+        throw std::invalid_argument(value);
+      }
+    }
+    catch (const std::exception &)
+    {
+      error = "ค่าในเงื่อนไข '" + text + "' ต้องเป็นตัวเลข";
+      return false;
+    }
+  }
+  conditions.push_back(condition);
+  return true;
+}
+
+bool ReplayQuery::setAggregate(const std::string &text, std::string &error)
+{
+  static const std::pair<const char *, QueryAggregate> AGGREGATES[] = {{"sum", QueryAggregate::Sum},
+                                                                      {"avg", QueryAggregate::Average},
+                                                                      {"min", QueryAggregate::Min},
+                                                                      {"max", QueryAggregate::Max}};
+  if (text == "count")
+  {
+    aggregate = QueryAggregate::Count;
+    return true;
+  }
+  if (text == "winrate")
+  {
+    aggregate = QueryAggregate::WinRate;
+    return true;
+  }
+
+  size_t colon = text.find(':');
+  std::string name = text.substr(0, colon);
+  for (const auto &entry : AGGREGATES)
+  {
+    if (name == entry.first && colon != std::string::npos && parseField(text.substr(colon + 1), value_field))
+    {
+      aggregate = entry.second;
+      return true;
+    }
+  }
+  error = "การรวมผลไม่ถูกต้อง: '" + text + "' (count, winrate, sum:<ช่อง>, avg:<ช่อง>, min:<ช่อง>, max:<ช่อง>)";
+  return false;
+}
+
+bool ReplayQuery::setGroupBy(const std::string &text, std::string &error)
+{
+  if (!parseField(text, group_field))
+  {
+    error = "ไม่รู้จักช่องข้อมูล '" + text + "'";
+    return false;
+  }
+  return true;
+}
+
+bool ReplayQuery::matches(const ReplayEvent &event) const
+{
+  if (event.kind != kind)
+  {
+    return false;
+  }
+  for (const QueryCondition &condition : conditions)
+  {
+    if (!condition.test(event))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ReplayQuery::accumulate(const std::vector<ReplayEvent> &events, QueryResult &result) const
+{
+  // (กลุ่ม, ผู้เล่น) ที่นับใน sides แล้วในเกมนี้ - มีไม่กี่รายการต่อเกม ค้นแบบเส้นตรงเร็วกว่า hash
+  std::vector<std::pair<int32_t, int32_t>> counted_sides;
+  bool per_side = aggregate == QueryAggregate::WinRate;
+
+  for (const ReplayEvent &event : events)
+  {
+    if (!matches(event))
+    {
+      continue;
+    }
+    int32_t group = isGrouped() ? event.get(group_field) : 0;
+    QueryAccumulator &accumulator = result.groups[group];
+    accumulator.add(event.get(value_field));
+
+    if (per_side)
+    {
+      std::pair<int32_t, int32_t> side(group, event.get(EventField::Seat));
+      if (std::find(counted_sides.begin(), counted_sides.end(), side) == counted_sides.end())
+      {
+        counted_sides.push_back(side);
+        accumulator.sides++;
+        accumulator.wins += event.get(EventField::Won) ? 1 : 0;
+      }
+    }
+  }
+  result.events += events.size();
+}
+
+double ReplayQuery::valueOf(const QueryAccumulator &accumulator) const
+{
+  switch (aggregate)
+  {
+  case QueryAggregate::Count:
+    return static_cast<double>(accumulator.count);
+  case QueryAggregate::Sum:
+    return static_cast<double>(accumulator.sum);
+  case QueryAggregate::Average:
+    return accumulator.count ? static_cast<double>(accumulator.sum) / static_cast<double>(accumulator.count) : 0.0;
+  case QueryAggregate::Min:
+    return accumulator.count ? accumulator.min : 0.0;
+  case QueryAggregate::Max:
+    return accumulator.count ? accumulator.max : 0.0;
+  case QueryAggregate::WinRate:
+    return accumulator.sides ? 100.0 * static_cast<double>(accumulator.wins) / static_cast<double>(accumulator.sides)
+                             : 0.0;
+  }
+  return 0.0;
+}
+
+std::string ReplayQuery::describe() const
+{
+  static const char *const AGGREGATE_NAMES[] = {"count", "sum", "avg", "min", "max", "winrate"};
+  std::string text = AGGREGATE_NAMES[static_cast<size_t>(aggregate)];
+  if (aggregate != QueryAggregate::Count && aggregate != QueryAggregate::WinRate)
+  {
+    text += std::string(":") + eventFieldName(value_field);
+  }
+  return text;
+}
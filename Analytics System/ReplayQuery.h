@@ -0,0 +1,184 @@
+// ReplayQuery.h - ไฟล์ Header สำหรับเหตุการณ์ที่ได้จากการเดินเกมซ้ำ และคำค้นแบบกรอง/รวมผลบนเหตุการณ์เหล่านั้น
+// ไฟล์ replay เก็บแค่การกระทำ (เช่น "Ride การ์ดบนมือใบที่ 2") การ์ดที่เกี่ยวข้องจึงรู้ได้จากการเดินเกมซ้ำเท่านั้น
+// ReplayEventCollector รับเหตุการณ์ระหว่างเดินเกมซ้ำแล้วแปลงเป็นแถวที่มีช่องข้อมูลเป็นตัวเลขทั้งหมด
+// คำค้น (ReplayQuery) จึงเป็นแค่การเทียบตัวเลขกับแถวในหน่วยความจำ ไม่ต้องแปลงข้อความหรือเปิด JSON
+#ifndef REPLAYQUERY_H
+#define REPLAYQUERY_H
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "../Game Core/Match.h"
+
+// ชนิดของเหตุการณ์
+enum class ReplayEventKind : uint8_t
+{
+  Ride,   // ผู้เล่นเทิร์นนี้ Ride การ์ด
+  Call,   // ผู้เล่นเทิร์นนี้ Call การ์ดลง RC
+  Attack, // ผลการโจมตี 1 ครั้ง (หลังฝ่ายป้องกัน Guard เสร็จ)
+  Guard,  // ฝ่ายป้องกันวางการ์ด Guard จากมือ
+  Damage, // ฝ่ายป้องกันได้รับดาเมจ 1 ใบจาก Damage Check
+  Result  // ผลการแข่งขันของผู้เล่น 1 คน (2 แถวต่อเกม)
+};
+
+// ช่องข้อมูลของเหตุการณ์ - ช่องที่ไม่เกี่ยวกับชนิดของเหตุการณ์มีค่า 0 (card = -1)
+enum class EventField : uint8_t
+{
+  Turn,   // เทิร์นที่เกิดเหตุการณ์
+  Seat,   // ผู้เล่นเจ้าของเหตุการณ์ (0 หรือ 1): Guard/Damage เป็นฝ่ายป้องกัน นอกนั้นเป็นผู้เล่นเทิร์นนี้
+  Card,   // ดัชนีของการ์ดในแคตตาล็อก: การ์ดที่ Ride/Call/Guard, Attacker, การ์ดดาเมจ
+  Grade,  // เกรดของการ์ดในช่อง card
+  Slot,   // Call: ช่อง RC, Attack: ดัชนีสถานะของ Attacker
+  Power,  // Attack: พลังโจมตีรวม, นอกนั้น: พลังของการ์ด
+  Shield, // Attack: shield รวมใน Guardian Zone, Guard: shield ของการ์ด
+  Guards, // Attack: จำนวนการ์ด Guard
+  Damage, // Attack: ดาเมจที่ได้รับจากการโจมตีนี้, Damage/Result: ดาเมจสะสมของ seat
+  Hit,    // Attack: 1 = โจมตีเข้า
+  Won,    // 1 = seat ชนะเกมนี้
+  Count
+};
+
+constexpr size_t EVENT_FIELD_COUNT = static_cast<size_t>(EventField::Count);
+
+// เหตุการณ์ 1 แถว
+struct ReplayEvent
+{
+  ReplayEventKind kind = ReplayEventKind::Ride;
+  std::array<int32_t, EVENT_FIELD_COUNT> fields{};
+
+  int32_t get(EventField field) const { return fields[static_cast<size_t>(field)]; }
+  void set(EventField field, int32_t value) { fields[static_cast<size_t>(field)] = value; }
+};
+
+// ตัวเก็บเหตุการณ์ของเกม 1 เกม - ตั้งเป็น observer ของ ReplaySimulator แล้วส่งการกระทำที่อ่านได้ให้ onAction()
+// (Ride/Call/Guard ไม่มี callback ใน MatchObserver จึงดูการ์ดจากสถานะหลังเดินการกระทำนั้นแทน)
+class ReplayEventCollector : public MatchObserver
+{
+private:
+  const std::unordered_map<std::string, uint32_t> &card_index;
+  const Match *match;
+  std::vector<ReplayEvent> events;
+  int current_attack; // แถวของการโจมตีที่กำลังทำ Damage Check (-1 = ไม่มี)
+
+  int seatOf(const Player &player) const { return &player == &match->getPlayer(0) ? 0 : 1; }
+  ReplayEvent &push(ReplayEventKind kind, int seat, const Card *card);
+
+public:
+  explicit ReplayEventCollector(const std::unordered_map<std::string, uint32_t> &card_catalog_index);
+
+  void begin(const Match &replayed_match); // เริ่มเกมใหม่ (ล้างเหตุการณ์เดิม)
+  void onAction(const GameAction &action); // หลังเดินการกระทำที่อ่านจากไฟล์
+  void finish();                           // หลังเกมจบ: เพิ่มแถว Result และเติมช่อง won ทุกแถว
+
+  const std::vector<ReplayEvent> &getEvents() const { return events; }
+
+  void onBattleResult(Player &attacker, Player &defender, const AttackState &attack, int defense_power) override;
+  void onDamageRevealed(Player &defender, const Card &damage_card) override;
+  void onDamageTaken(Player &defender, const TriggerOutput &trigger) override;
+  void onAttackEnd(Player &attacker) override;
+};
+
+// การเปรียบเทียบในเงื่อนไข
+enum class CompareOp : uint8_t
+{
+  Equal,
+  NotEqual,
+  Less,
+  LessEqual,
+  Greater,
+  GreaterEqual
+};
+
+// เงื่อนไข 1 ข้อ เช่น turn<=5
+struct QueryCondition
+{
+  EventField field = EventField::Turn;
+  CompareOp op = CompareOp::Equal;
+  int32_t value = 0;
+
+  bool test(const ReplayEvent &event) const;
+};
+
+// วิธีรวมผล
+enum class QueryAggregate : uint8_t
+{
+  Count,
+  Sum,
+  Average,
+  Min,
+  Max,
+  WinRate // สัดส่วนผู้เล่นที่ชนะ นับผู้เล่นแต่ละคนในแต่ละเกมครั้งเดียวไม่ว่าจะมีแถวที่ตรงเงื่อนไขกี่แถว
+};
+
+// ผลรวมของ 1 กลุ่ม - รวมกันได้ในลำดับใดก็ได้ (ผลของแต่ละเธรดจึงรวมกันทีหลังได้)
+struct QueryAccumulator
+{
+  uint64_t count = 0;
+  int64_t sum = 0;
+  int32_t min = INT32_MAX;
+  int32_t max = INT32_MIN;
+  uint64_t sides = 0; // (เกม, ผู้เล่น) ที่มีแถวตรงเงื่อนไข
+  uint64_t wins = 0;  // ใน sides ที่ชนะเกมนั้น
+
+  void add(int32_t value);
+  void merge(const QueryAccumulator &other);
+};
+
+// ผลของคำค้นจากไฟล์ชุดหนึ่ง
+struct QueryResult
+{
+  std::unordered_map<int32_t, QueryAccumulator> groups; // ค่าของช่องที่จัดกลุ่ม -> ผลรวม (ไม่จัดกลุ่ม = กลุ่ม 0)
+  uint64_t files = 0;
+  uint64_t games = 0;      // เกมที่เดินซ้ำจนจบและนำมาคิด
+  uint64_t unfinished = 0; // ไฟล์ที่จบก่อนเกมจบ (ไม่นำมาคิด)
+  uint64_t failed = 0;     // ไฟล์ที่เปิดไม่ได้หรือเดินเกมซ้ำไม่ผ่าน
+  uint64_t events = 0;     // แถวเหตุการณ์ทั้งหมดที่ตรวจ
+  uint64_t actions = 0;
+  uint64_t bytes = 0;
+  std::string first_error; // สาเหตุของไฟล์เสียไฟล์แรกที่พบ (ใช้แจ้งผู้ใช้)
+
+  void merge(const QueryResult &other);
+};
+
+// คำค้น: เลือกแถวชนิดเดียวที่ตรงทุกเงื่อนไข จัดกลุ่มตามช่องที่กำหนด (ถ้ามี) แล้วรวมผล
+class ReplayQuery
+{
+private:
+  ReplayEventKind kind;
+  std::vector<QueryCondition> conditions;
+  QueryAggregate aggregate;
+  EventField value_field; // ช่องที่รวมผล (Sum/Average/Min/Max)
+  EventField group_field; // EventField::Count = ไม่จัดกลุ่ม
+
+public:
+  ReplayQuery();
+
+  // ตั้งค่าจากข้อความบรรทัดคำสั่ง - คืนค่า false ถ้าข้อความไม่ถูกต้อง (ดูสาเหตุใน error)
+  // ชนิด: ride, call, attack, guard, damage, result
+  // เงื่อนไข: <ช่อง><=,!=,<,<=,>,>=><ค่า> เช่น turn<=5, card=G3-04 (ช่อง card ใช้รหัสการ์ด)
+  // การรวมผล: count, winrate, sum:<ช่อง>, avg:<ช่อง>, min:<ช่อง>, max:<ช่อง>
+  bool setKind(const std::string &text, std::string &error);
+  bool addCondition(const std::string &text, const std::unordered_map<std::string, uint32_t> &card_index,
+                    std::string &error);
+  bool setAggregate(const std::string &text, std::string &error);
+  bool setGroupBy(const std::string &text, std::string &error);
+
+  bool matches(const ReplayEvent &event) const;
+
+  // รวมผลจากเหตุการณ์ของเกม 1 เกม
+  void accumulate(const std::vector<ReplayEvent> &events, QueryResult &result) const;
+
+  QueryAggregate getAggregate() const { return aggregate; }
+  EventField getGroupField() const { return group_field; }
+  bool isGrouped() const { return group_field != EventField::Count; }
+
+  // ค่าที่แสดงของกลุ่ม (ค่าเฉลี่ย, เปอร์เซ็นต์ชนะ ฯลฯ ตามวิธีรวมผล)
+  double valueOf(const QueryAccumulator &accumulator) const;
+  std::string describe() const; // คำค้นในรูปข้อความสั้นๆ สำหรับหัวตาราง
+};
+
+const char *eventFieldName(EventField field);
+
+#endif // REPLAYQUERY_H
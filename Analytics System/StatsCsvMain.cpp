@@ -0,0 +1,153 @@
+// StatsCsvMain.cpp - โปรแกรมแปลงไฟล์สถิติแบบคอลัมน์ (จาก --stats) เป็น CSV fibo_stats_csv
+//   fibo_stats_csv stats.fibc --table turns --out turns.csv
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../Game Core/GameStats.h"
+#include "../UI System/UIHelper.h"
+
+using namespace std;
+
+// ใส่เครื่องหมายคำพูดเมื่อข้อความมีตัวคั่นหรือเครื่องหมายคำพูด (ตาม RFC 4180)
+static void writeCsvField(ostream &out, const string &text)
+{
+  if (text.find_first_of(",\"\r\n") == string::npos)
+  {
+    out << text;
+    return;
+  }
+  out << '"';
+  for (char c : text)
+  {
+    if (c == '"')
+    {
+      out << '"';
+    }
+    out << c;
+  }
+  out << '"';
+}
+
+// ตัวเลือก:
+//   --table <ชื่อ>  ตารางที่ต้องการ: games (ค่าเริ่มต้น) หรือ turns
+//   --out <file>    เขียน CSV ลงไฟล์ (ค่าเริ่มต้น = แสดงทางหน้าจอ)
+// ตามด้วยไฟล์สถิติ 1 ไฟล์
+int main(int argc, char *argv[])
+{
+  string table_name = "games";
+  string out_path;
+  string stats_path;
+  for (int i = 1; i < argc; ++i)
+  {
+    string arg = argv[i];
+    if (arg == "--table" && i + 1 < argc)
+    {
+      table_name = argv[++i];
+    }
+    else if (arg == "--out" && i + 1 < argc)
+    {
+      out_path = argv[++i];
+    }
+    else if (!arg.empty() && arg[0] != '-' && stats_path.empty())
+    {
+      stats_path = arg;
+    }
+    else
+    {
+      stats_path.clear();
+      break;
+    }
+  }
+  if (stats_path.empty())
+  {
+    cerr << "วิธีใช้: " << argv[0] << " [--table games|turns] [--out <file>] <ไฟล์สถิติ>" << endl;
+    return 2;
+  }
+
+  GameStatsReader reader;
+  if (!reader.open(stats_path))
+  {
+    UIHelper::PrintError(reader.getError());
+    return 1;
+  }
+  const vector<StatsTable> &schema = reader.getSchema();
+  size_t table_idx = 0;
+  while (table_idx < schema.size() && schema[table_idx].name != table_name)
+  {
+    table_idx++;
+  }
+  if (table_idx >= schema.size())
+  {
+    UIHelper::PrintError("ไม่พบตาราง '" + table_name + "' ในไฟล์สถิติ");
+    return 2;
+  }
+
+  ofstream out_file;
+  if (!out_path.empty())
+  {
+    out_file.open(out_path, ios::binary);
+    if (!out_file)
+    {
+      UIHelper::PrintError("เปิดไฟล์ '" + out_path + "' เพื่อเขียนไม่ได้");
+      return 1;
+    }
+  }
+  ostream &out = out_path.empty() ? cout : out_file;
+
+  const vector<StatsColumn> &columns = schema[table_idx].columns;
+  for (size_t c = 0; c < columns.size(); ++c)
+  {
+    out << (c > 0 ? "," : "") << columns[c].name;
+  }
+  out << "\n";
+
+  StatsBlock block;
+  uint64_t rows = 0;
+  while (reader.next(static_cast<StatsTableId>(table_idx), block))
+  {
+    const vector<string> &dictionary = reader.getDictionary();
+    for (size_t r = 0; r < block.rows; ++r)
+    {
+      for (size_t c = 0; c < columns.size(); ++c)
+      {
+        if (c > 0)
+        {
+          out << ',';
+        }
+        int64_t value = block.columns[c][r];
+        switch (columns[c].type)
+        {
+        case StatsColumnType::String:
+          writeCsvField(out, dictionary[static_cast<size_t>(value)]);
+          break;
+        case StatsColumnType::Unsigned:
+          out << static_cast<uint64_t>(value);
+          break;
+        default:
+          out << value;
+          break;
+        }
+      }
+      out << '\n';
+    }
+    rows += block.rows;
+  }
+  out.flush();
+
+  if (!reader.getError().empty())
+  {
+    UIHelper::PrintError(reader.getError());
+    return 1;
+  }
+  if (reader.isTruncated())
+  {
+    UIHelper::PrintWarning("บล็อกสุดท้ายของไฟล์เขียนไม่ครบ (ข้ามไป)");
+  }
+  if (!out_path.empty())
+  {
+    UIHelper::PrintSuccess("เขียน " + to_string(rows) + " แถวลง '" + out_path + "'");
+  }
+  return 0;
+}
@@ -0,0 +1,13 @@
+// AllocationCounter.cpp - ไฟล์ Source สำหรับอ่านจำนวนการจองหน่วยความจำของเธรด
+// ตัวนับจริงอยู่ใน AllocationProfile.cpp (fibo_bench ถูก compile ด้วย -DFIBO_ALLOC_COUNT) ที่นี่รวมยอดทุกป้ายเท่านั้น
+#include "AllocationCounter.h"
+#include "../Game Core/AllocationProfile.h"
+
+AllocationCount currentThreadAllocations()
+{
+  AllocationTotals totals = currentThreadAllocationTotals();
+  AllocationCount count;
+  count.allocations = totals.totalAllocations();
+  count.bytes = totals.totalBytes();
+  return count;
+}
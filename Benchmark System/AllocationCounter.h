@@ -0,0 +1,18 @@
+// AllocationCounter.h - ไฟล์ Header สำหรับนับการจองหน่วยความจำ (operator new) ของแต่ละเธรด
+// อ่านยอดรวมจากตัวนับของ AllocationProfile ซึ่งแทนที่ operator new เมื่อ compile ด้วย -DFIBO_ALLOC_COUNT
+// (build_tools.sh ใส่ flag นี้ให้ fibo_bench เท่านั้น ถ้าไม่ใส่จะได้ 0 เสมอ)
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <cstdint>
+
+// ยอดสะสมตั้งแต่เธรดเริ่มทำงาน (ใช้ค่าต่างระหว่าง 2 ครั้งที่อ่าน)
+struct AllocationCount
+{
+  uint64_t allocations = 0; // จำนวนครั้งที่เรียก operator new (ทุกรูปแบบ)
+  uint64_t bytes = 0;       // จำนวนไบต์ที่ขอ
+};
+
+AllocationCount currentThreadAllocations();
+
+#endif // ALLOCATIONCOUNTER_H
@@ -0,0 +1,245 @@
+// BenchCompare.cpp - ไฟล์ Source สำหรับเทียบผลของ fibo_bench กับค่าอ้างอิง
+#include "BenchCompare.h"
+#include "../Library/json.hpp"
+#include <set>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <algorithm>
+
+double benchMedian(std::vector<double> values)
+{
+  if (values.empty())
+  {
+    return 0;
+  }
+  std::sort(values.begin(), values.end());
+  size_t middle = values.size() / 2;
+  return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+double benchRelativeNoise(const std::vector<double> &values)
+{
+  double median = benchMedian(values);
+  if (values.size() < 2 || median <= 0)
+  {
+    return 0;
+  }
+  std::vector<double> deviations;
+  for (double value : values)
+  {
+    deviations.push_back(std::fabs(value - median));
+  }
+  return 1.4826 * benchMedian(deviations) / median;
+}
+
+double benchSlowerPValue(const std::vector<double> &current, const std::vector<double> &baseline)
+{
+  if (current.size() < 3 || baseline.size() < 3)
+  {
+    return -1;
+  }
+  // U = จำนวนคู่ (current, baseline) ที่ current ช้ากว่า (เท่ากันนับครึ่ง)
+  double u = 0;
+  for (double x : current)
+  {
+    for (double y : baseline)
+    {
+      u += x > y ? 1.0 : (x == y ? 0.5 : 0.0);
+    }
+  }
+  double n1 = static_cast<double>(current.size());
+  double n2 = static_cast<double>(baseline.size());
+  double z = (u - n1 * n2 / 2 - 0.5) / std::sqrt(n1 * n2 * (n1 + n2 + 1) / 12);
+  return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+// รับค่าเดียว (ผลของ fibo_bench) หรืออาร์เรย์ (ไฟล์ baseline)
+static void appendValues(const nlohmann::json &value, std::vector<double> &out)
+{
+  if (value.is_array())
+  {
+    for (const auto &item : value)
+    {
+      out.push_back(item.get<double>());
+    }
+  }
+  else
+  {
+    out.push_back(value.get<double>());
+  }
+}
+
+bool readBenchRuns(const std::string &text, BenchRuns &runs, std::string &error)
+{
+  try
+  {
+    nlohmann::json document = nlohmann::json::parse(text);
+    std::string format = document.value("format", "");
+    if (format != "fibo_bench" && format != "fibo_bench_baseline")
+    {
+      error = "ไม่ใช่ผลของ fibo_bench (format = '" + format + "')";
+      return false;
+    }
+    for (const auto &entry : document.at("benchmarks"))
+    {
+      BenchSamples &samples = runs[entry.at("name").get<std::string>()];
+      appendValues(entry.at("ns_per_op"), samples.ns_per_op);
+      appendValues(entry.at("allocs_per_op"), samples.allocs_per_op);
+    }
+    return true;
+  }
+  catch (const nlohmann::json::exception &e)
+  {
+    error = std::string("อ่าน JSON ไม่ได้: ") + e.what();
+    return false;
+  }
+}
+
+bool writeBenchBaseline(const std::string &path, const BenchRuns &runs)
+{
+  nlohmann::ordered_json document;
+  document["format"] = "fibo_bench_baseline";
+  document["version"] = 1;
+  document["context"]["date"] = static_cast<int64_t>(std::time(nullptr));
+  document["benchmarks"] = nlohmann::ordered_json::array();
+  for (const auto &entry : runs)
+  {
+    document["benchmarks"].push_back({{"name", entry.first},
+                                      {"ns_per_op", entry.second.ns_per_op},
+                                      {"allocs_per_op", entry.second.allocs_per_op}});
+  }
+  std::ofstream file(path);
+  if (!file)
+  {
+    return false;
+  }
+  file << document.dump(2) << '\n';
+  return static_cast<bool>(file);
+}
+
+std::vector<BenchComparison> compareBenchRuns(const BenchRuns &baseline, const BenchRuns &current,
+                                              const BenchCompareOptions &options)
+{
+  std::set<std::string> names;
+  for (const auto &entry : baseline)
+  {
+    names.insert(entry.first);
+  }
+  for (const auto &entry : current)
+  {
+    names.insert(entry.first);
+  }
+
+  std::vector<BenchComparison> comparisons;
+  for (const std::string &name : names)
+  {
+    BenchComparison row;
+    row.name = name;
+    auto base = baseline.find(name);
+    auto now = current.find(name);
+    row.in_baseline = base != baseline.end();
+    row.in_current = now != current.end();
+    if (row.in_baseline)
+    {
+      row.baseline_runs = base->second.ns_per_op.size();
+      row.baseline_ns = benchMedian(base->second.ns_per_op);
+      row.baseline_allocs = benchMedian(base->second.allocs_per_op);
+    }
+    if (row.in_current)
+    {
+      row.current_runs = now->second.ns_per_op.size();
+      row.current_ns = benchMedian(now->second.ns_per_op);
+      row.current_allocs = benchMedian(now->second.allocs_per_op);
+    }
+    if (!row.in_baseline || !row.in_current || row.baseline_ns <= 0)
+    {
+      comparisons.push_back(row);
+      continue;
+    }
+
+    row.change = row.current_ns / row.baseline_ns - 1;
+    row.noise = std::max(benchRelativeNoise(base->second.ns_per_op), benchRelativeNoise(now->second.ns_per_op));
+    row.p_value = benchSlowerPValue(now->second.ns_per_op, base->second.ns_per_op);
+    // ทดสอบไม่ได้ (ผลน้อยกว่า 3 ครั้ง): ต้องต่างเกิน 3 เท่าของสัญญาณรบกวนจึงนับว่าต่างจริง
+    bool slower = row.p_value >= 0 ? row.p_value < options.alpha : row.change > 3 * row.noise;
+    bool faster = row.p_value >= 0 ? benchSlowerPValue(base->second.ns_per_op, now->second.ns_per_op) < options.alpha
+                                   : -row.change > 3 * row.noise;
+    if (row.change > options.threshold && slower)
+    {
+      row.regression = true;
+      row.reason = "ns/op";
+    }
+    else if (row.change < -options.threshold && faster)
+    {
+      row.improvement = true;
+    }
+    // จำนวนครั้งที่จองหน่วยความจำแทบไม่แปรปรวน จึงเทียบตรงๆ (ต้องเพิ่มอย่างน้อย 1 ครั้งต่อรอบ)
+    if (row.current_allocs > row.baseline_allocs * (1 + options.threshold) &&
+        row.current_allocs - row.baseline_allocs >= 1)
+    {
+      row.regression = true;
+      row.reason += row.reason.empty() ? "allocs/op" : ", allocs/op";
+    }
+    comparisons.push_back(row);
+  }
+  return comparisons;
+}
+
+void writeBenchMarkdown(std::ostream &out, const std::vector<BenchComparison> &comparisons,
+                        const BenchCompareOptions &options)
+{
+  out << "| Benchmark | Baseline ns/op | Current ns/op | Change | Noise | p | Allocs/op | Status |\n";
+  out << "|---|---:|---:|---:|---:|---:|---:|---|\n";
+  out << std::fixed;
+  for (const BenchComparison &row : comparisons)
+  {
+    out << "| `" << row.name << "` | ";
+    if (row.in_baseline)
+    {
+      out << std::setprecision(1) << row.baseline_ns;
+    }
+    out << " | ";
+    if (row.in_current)
+    {
+      out << std::setprecision(1) << row.current_ns;
+    }
+    out << " | ";
+    if (!row.in_baseline || !row.in_current)
+    {
+      out << " |  |  | " << std::setprecision(2) << (row.in_current ? row.current_allocs : row.baseline_allocs) << " | "
+          << (row.in_current ? "new" : "missing") << " |\n";
+      continue;
+    }
+    out << std::showpos << std::setprecision(1) << row.change * 100 << "%" << std::noshowpos << " | ±"
+        << row.noise * 100 << "% | ";
+    if (row.p_value >= 0)
+    {
+      out << std::setprecision(3) << row.p_value;
+    }
+    else
+    {
+      out << "-";
+    }
+    out << " | " << std::setprecision(2) << row.baseline_allocs << " → " << row.current_allocs << " | ";
+    if (row.regression)
+    {
+      out << "**regression** (" << row.reason << ")";
+    }
+    else if (row.improvement)
+    {
+      out << "faster";
+    }
+    else
+    {
+      out << "ok";
+    }
+    out << " |\n";
+  }
+  out << "\nregression = ช้าลงเกิน " << std::setprecision(0) << options.threshold * 100
+      << "% และ p < " << std::setprecision(2) << options.alpha
+      << " (Mann-Whitney U) หรือจองหน่วยความจำเพิ่มเกิน " << std::setprecision(0) << options.threshold * 100
+      << "%\n";
+}
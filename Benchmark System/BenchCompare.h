@@ -0,0 +1,73 @@
+// BenchCompare.h - ไฟล์ Header สำหรับเทียบผลของ fibo_bench กับค่าอ้างอิง (baseline) ที่เก็บไว้ใน repository
+// ผลของแต่ละชุดวัดมาจากการรันหลายครั้ง ใช้ค่ากลาง (median) และประเมินสัญญาณรบกวนจาก MAD
+// ชุดที่ช้าลงเกินเกณฑ์ (threshold) และต่างอย่างมีนัยสำคัญ (Mann-Whitney U ทางเดียว) ถือว่าถดถอย (regression)
+//
+// รูปแบบไฟล์ baseline (JSON): {"format": "fibo_bench_baseline", "version": 1, "context": {...},
+//   "benchmarks": [{"name": ..., "ns_per_op": [ทุกครั้งที่รัน], "allocs_per_op": [ทุกครั้งที่รัน]}, ...]}
+// ไฟล์ผลของ fibo_bench --json ใช้เป็น baseline ได้เช่นกัน (นับเป็นการรัน 1 ครั้ง)
+#ifndef BENCHCOMPARE_H
+#define BENCHCOMPARE_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <iosfwd>
+
+// ผลทุกครั้งที่รันของชุดวัด 1 ชุด
+struct BenchSamples
+{
+  std::vector<double> ns_per_op;
+  std::vector<double> allocs_per_op;
+};
+
+typedef std::map<std::string, BenchSamples> BenchRuns; // ชื่อชุดวัด -> ผลทุกครั้ง
+
+// ค่ากลางและสัญญาณรบกวน (1.4826 * MAD / median = ค่าประมาณของส่วนเบี่ยงเบนมาตรฐานแบบสัมพัทธ์)
+double benchMedian(std::vector<double> values);
+double benchRelativeNoise(const std::vector<double> &values);
+
+// p-value ทางเดียวว่า current ช้ากว่า baseline (Mann-Whitney U, ประมาณด้วยการแจกแจงปกติ)
+// คืนค่า -1 ถ้าฝั่งใดมีผลน้อยกว่า 3 ครั้ง (ทดสอบไม่ได้)
+double benchSlowerPValue(const std::vector<double> &current, const std::vector<double> &baseline);
+
+// อ่าน JSON จาก fibo_bench หรือไฟล์ baseline แล้วเพิ่มผลลงใน runs
+bool readBenchRuns(const std::string &text, BenchRuns &runs, std::string &error);
+
+// เขียนไฟล์ baseline จากผลทุกครั้งที่รัน
+bool writeBenchBaseline(const std::string &path, const BenchRuns &runs);
+
+// ผลการเทียบของชุดวัด 1 ชุด
+struct BenchComparison
+{
+  std::string name;
+  bool in_baseline = false;
+  bool in_current = false;
+  size_t baseline_runs = 0;
+  size_t current_runs = 0;
+  double baseline_ns = 0; // median
+  double current_ns = 0;  // median
+  double change = 0;      // current / baseline - 1
+  double noise = 0;       // สัญญาณรบกวนสัมพัทธ์ที่มากกว่าของ 2 ฝั่ง
+  double p_value = -1;    // -1 = ไม่ได้ทดสอบ (ใช้เกณฑ์ 3 เท่าของสัญญาณรบกวนแทน)
+  double baseline_allocs = 0;
+  double current_allocs = 0;
+  bool regression = false;
+  bool improvement = false;
+  std::string reason; // เหตุผลที่ถือว่าถดถอย (ว่าง = ไม่ถดถอย)
+};
+
+struct BenchCompareOptions
+{
+  double threshold = 0.20; // ช้าลงเกิน 20% (หรือจองหน่วยความจำเพิ่มเกิน 20%) จึงนับ
+  double alpha = 0.01;     // ระดับนัยสำคัญของ Mann-Whitney U (ต้องรันอย่างน้อย 5 ครั้งต่อฝั่งจึงถึง)
+};
+
+// เทียบทุกชุดที่อยู่ในฝั่งใดฝั่งหนึ่ง (เรียงตามชื่อ)
+std::vector<BenchComparison> compareBenchRuns(const BenchRuns &baseline, const BenchRuns &current,
+                                              const BenchCompareOptions &options);
+
+// ตาราง markdown ของผลการเทียบ (ใส่ในคอมเมนต์ของ pull request ได้ทันที)
+void writeBenchMarkdown(std::ostream &out, const std::vector<BenchComparison> &comparisons,
+                        const BenchCompareOptions &options);
+
+#endif // BENCHCOMPARE_H
@@ -0,0 +1,141 @@
+// BenchMain.cpp - โปรแกรมวัดความเร็วของการทำงานหลักในเกม fibo_bench
+// รายงานเวลา (ns) และการจองหน่วยความจำต่อรอบของแต่ละชุดวัด ทั้งเป็นตารางบนหน้าจอและเป็น JSON
+//   fibo_bench --json bench.json
+//   fibo_bench --filter Deck:: --min-time 2
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "Benchmark.h"
+#include "../UI System/UIHelper.h"
+#include "../UI System/OutputSink.h"
+
+using namespace std;
+
+// ตัวเลือก:
+//   --filter <text>   วัดเฉพาะชุดที่ชื่อมีข้อความนี้ (ใส่ซ้ำได้)
+//   --min-time <sec>  เวลาขั้นต่ำของแต่ละชุด (ค่าเริ่มต้น 0.5)
+//   --json <file>     เขียนผลเป็น JSON ("-" = stdout โดยย้ายตารางไป stderr)
+//   --cards <file>    ไฟล์ข้อมูลการ์ด (ค่าเริ่มต้น cards.json)
+//   --list            แสดงชื่อชุดวัดทั้งหมดแล้วจบ
+int main(int argc, char *argv[])
+{
+  vector<string> filters;
+  double min_seconds = 0.5;
+  string json_path;
+  string cards_path = "cards.json";
+  bool list_only = false;
+  bool valid = true;
+  for (int i = 1; i < argc && valid; ++i)
+  {
+    string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    try
+    {
+      if (arg == "--filter" && has_value)
+      {
+        filters.push_back(argv[++i]);
+      }
+      else if (arg == "--min-time" && has_value)
+      {
+        min_seconds = stod(argv[++i]);
+        valid = min_seconds > 0;
+      }
+      else if (arg == "--json" && has_value)
+      {
+        json_path = argv[++i];
+      }
+      else if (arg == "--cards" && has_value)
+      {
+        cards_path = argv[++i];
+      }
+      else if (arg == "--list")
+      {
+        list_only = true;
+      }
+      else
+      {
+        valid = false;
+      }
+    }
+    catch (const exception &)
+    {
+      valid = false;
+    }
+  }
+  if (!valid)
+  {
+    cerr << "วิธีใช้: " << argv[0] << " [--filter <text>] [--min-time <sec>] [--json <file>] [--cards <file>] [--list]"
+         << endl;
+    return 2;
+  }
+
+  vector<BenchSpec> selected;
+  for (const BenchSpec &spec : getGameBenchmarks())
+  {
+    bool match = filters.empty();
+    for (const string &filter : filters)
+    {
+      match = match || string(spec.name).find(filter) != string::npos;
+    }
+    if (match)
+    {
+      selected.push_back(spec);
+    }
+  }
+  if (list_only)
+  {
+    for (const BenchSpec &spec : selected)
+    {
+      cout << spec.name << endl;
+    }
+    return 0;
+  }
+  if (selected.empty())
+  {
+    UIHelper::PrintError("ไม่มีชุดวัดที่ตรงกับ --filter");
+    return 1;
+  }
+
+  UIHelper::SetAnimationEnabled(false);
+  bool loaded;
+  {
+    NullSink quiet; // stdout อาจเป็น JSON (--json -)
+    ScopedOutputSink quiet_scope(&quiet);
+    loaded = loadBenchData(cards_path);
+  }
+  if (!loaded)
+  {
+    UIHelper::PrintError("โหลดข้อมูลการ์ดจาก '" + cards_path + "' ไม่ได้");
+    return 1;
+  }
+
+  // ตารางแสดงทาง stderr เมื่อ JSON ออกทาง stdout
+  ostream &table = json_path == "-" ? cerr : cout;
+  table << left << setw(36) << "benchmark" << right << setw(12) << "iterations" << setw(14) << "ns/op" << setw(12)
+        << "allocs/op" << setw(12) << "bytes/op" << endl;
+
+  BenchRunner runner(min_seconds);
+  vector<BenchResult> results;
+  for (const BenchSpec &spec : selected)
+  {
+    BenchResult result;
+    {
+      NullSink quiet; // ข้อความที่เกมพิมพ์ระหว่างวัดไม่ต้องแสดง
+      ScopedOutputSink quiet_scope(&quiet);
+      result = runner.run(spec);
+    }
+    table << left << setw(36) << result.name << right << setw(12) << result.iterations << fixed << setprecision(1)
+          << setw(14) << result.ns_per_op << setprecision(2) << setw(12) << result.allocs_per_op << setprecision(0)
+          << setw(12) << result.bytes_per_op << endl;
+    results.push_back(result);
+  }
+
+  if (!json_path.empty() && !writeBenchJson(json_path, results, min_seconds))
+  {
+    UIHelper::PrintError("เขียนไฟล์ '" + json_path + "' ไม่ได้");
+    return 1;
+  }
+  return 0;
+}
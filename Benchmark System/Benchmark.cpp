@@ -0,0 +1,111 @@
+// Benchmark.cpp - ไฟล์ Source สำหรับตัววัดความเร็วขนาดเล็กของ fibo_bench
+#include "Benchmark.h"
+#include "../Library/json.hpp"
+#include <ctime>
+#include <thread>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+BenchState::BenchState(uint64_t iterations)
+    : iterations(iterations), remaining(iterations), running(false), elapsed_ns(0)
+{
+}
+
+void BenchState::resume()
+{
+  if (running)
+  {
+    return;
+  }
+  running = true;
+  allocations_at_resume = currentThreadAllocations();
+  resumed_at = std::chrono::steady_clock::now();
+}
+
+void BenchState::pause()
+{
+  if (!running)
+  {
+    return;
+  }
+  auto now = std::chrono::steady_clock::now();
+  AllocationCount allocations = currentThreadAllocations();
+  running = false;
+  elapsed_ns += std::chrono::duration<double, std::nano>(now - resumed_at).count();
+  measured.allocations += allocations.allocations - allocations_at_resume.allocations;
+  measured.bytes += allocations.bytes - allocations_at_resume.bytes;
+}
+
+bool BenchState::keepRunning()
+{
+  if (remaining == iterations)
+  {
+    resume(); // รอบแรก: งานเตรียมข้อมูลก่อนลูปไม่ถูกนับ
+  }
+  if (remaining > 0)
+  {
+    remaining--;
+    return true;
+  }
+  pause();
+  return false;
+}
+
+BenchResult BenchRunner::run(const BenchSpec &spec) const
+{
+  const double min_ns = min_seconds * 1e9;
+  uint64_t iterations = 1;
+  for (;;)
+  {
+    BenchState state(iterations);
+    spec.function(state);
+    double elapsed = std::max(state.getElapsedNs(), 1.0);
+    if (elapsed >= min_ns || iterations >= (uint64_t(1) << 40))
+    {
+      BenchResult result;
+      result.name = spec.name;
+      result.iterations = iterations;
+      result.ns_per_op = elapsed / static_cast<double>(iterations);
+      result.allocs_per_op = static_cast<double>(state.getAllocations().allocations) / static_cast<double>(iterations);
+      result.bytes_per_op = static_cast<double>(state.getAllocations().bytes) / static_cast<double>(iterations);
+      return result;
+    }
+    // คาดจำนวนรอบที่ใช้เวลาถึงขั้นต่ำจากรอบนี้ (เผื่อ 40%) แต่เพิ่มไม่เกิน 10 เท่าต่อครั้ง
+    double scale = std::min(10.0, std::max(2.0, min_ns * 1.4 / elapsed));
+    iterations = static_cast<uint64_t>(static_cast<double>(iterations) * scale);
+  }
+}
+
+bool writeBenchJson(const std::string &path, const std::vector<BenchResult> &results, double min_seconds)
+{
+  nlohmann::ordered_json document;
+  document["format"] = "fibo_bench";
+  document["version"] = 1;
+  document["context"]["date"] = static_cast<int64_t>(std::time(nullptr));
+  document["context"]["compiler"] = __VERSION__;
+  document["context"]["cpus"] = std::thread::hardware_concurrency();
+  document["context"]["min_time"] = min_seconds;
+  document["benchmarks"] = nlohmann::ordered_json::array();
+  for (const BenchResult &result : results)
+  {
+    document["benchmarks"].push_back({{"name", result.name},
+                                      {"iterations", result.iterations},
+                                      {"ns_per_op", result.ns_per_op},
+                                      {"allocs_per_op", result.allocs_per_op},
+                                      {"bytes_per_op", result.bytes_per_op}});
+  }
+
+  if (path == "-")
+  {
+    std::cout << document.dump(2) << std::endl;
+    return true;
+  }
+  std::ofstream file(path);
+  if (!file)
+  {
+    return false;
+  }
+  file << document.dump(2) << '\n';
+  return static_cast<bool>(file);
+}
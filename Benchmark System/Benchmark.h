@@ -0,0 +1,91 @@
+// Benchmark.h - ไฟล์ Header สำหรับตัววัดความเร็วขนาดเล็ก (microbenchmark) ของ fibo_bench
+// แต่ละชุดวัดเป็นฟังก์ชันที่เตรียมข้อมูลก่อน แล้ววนทำงานที่ต้องการวัดใน while (state.keepRunning())
+// BenchRunner เพิ่มจำนวนรอบจนใช้เวลาถึงเวลาขั้นต่ำ แล้วรายงานเวลาและการจองหน่วยความจำเฉลี่ยต่อรอบ
+// ทุกชุดวัดใช้ seed คงที่ ผลจึงเทียบกันได้ระหว่างเครื่องและระหว่าง commit
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include "AllocationCounter.h"
+
+// ผลของชุดวัด 1 ชุด
+struct BenchResult
+{
+  std::string name;
+  uint64_t iterations = 0;
+  double ns_per_op = 0;
+  double allocs_per_op = 0; // จำนวนครั้งที่เรียก operator new ต่อรอบ
+  double bytes_per_op = 0;  // จำนวนไบต์ที่จองต่อรอบ
+};
+
+// สถานะของการวัด 1 ครั้ง (จำนวนรอบกำหนดโดย BenchRunner)
+class BenchState
+{
+private:
+  uint64_t iterations;
+  uint64_t remaining;
+  bool running;
+  std::chrono::steady_clock::time_point resumed_at;
+  AllocationCount allocations_at_resume;
+  double elapsed_ns;
+  AllocationCount measured;
+
+  void resume();
+  void pause();
+
+public:
+  explicit BenchState(uint64_t iterations);
+
+  // เริ่มจับเวลาในครั้งแรกที่เรียก คืนค่า false (และหยุดจับเวลา) เมื่อครบจำนวนรอบ
+  bool keepRunning();
+
+  // หยุดจับเวลาชั่วคราว เช่น ระหว่างเตรียมสำรับใหม่ (การจองหน่วยความจำช่วงนี้ไม่ถูกนับ)
+  void pauseTiming() { pause(); }
+  void resumeTiming() { resume(); }
+
+  uint64_t getIterations() const { return iterations; }
+  double getElapsedNs() const { return elapsed_ns; }
+  const AllocationCount &getAllocations() const { return measured; }
+};
+
+// บังคับให้ compiler คำนวณค่าที่วัดจริง (ไม่ตัดทิ้งเพราะไม่มีใครใช้ผล)
+template <typename T>
+inline void doNotOptimize(const T &value)
+{
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+typedef void (*BenchFunction)(BenchState &state);
+
+struct BenchSpec
+{
+  const char *name;
+  BenchFunction function;
+};
+
+// โหลดแคตตาล็อกที่ชุดวัดใช้ (loadCardsFromJson วัดการโหลดไฟล์เดียวกันซ้ำ) คืนค่า false ถ้าโหลดไม่ได้
+bool loadBenchData(const std::string &cards_path);
+
+// รายการชุดวัดทั้งหมดของเกม (GameBenchmarks.cpp)
+const std::vector<BenchSpec> &getGameBenchmarks();
+
+class BenchRunner
+{
+private:
+  double min_seconds; // เวลาขั้นต่ำของการวัดที่นำมารายงาน
+
+public:
+  explicit BenchRunner(double min_seconds = 0.5) : min_seconds(min_seconds) {}
+
+  // วัดชุดเดียว: เริ่มจาก 1 รอบแล้วเพิ่มจำนวนรอบจนใช้เวลาถึง min_seconds
+  BenchResult run(const BenchSpec &spec) const;
+};
+
+// เขียนผลเป็น JSON: {"format": "fibo_bench", "version": 1, "context": {...}, "benchmarks": [...]}
+// คืนค่า false ถ้าเปิดไฟล์ไม่ได้ (path "-" = stdout)
+bool writeBenchJson(const std::string &path, const std::vector<BenchResult> &results, double min_seconds);
+
+#endif // BENCHMARK_H
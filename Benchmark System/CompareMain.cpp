@@ -0,0 +1,246 @@
+// CompareMain.cpp - โปรแกรมตรวจการถดถอยของความเร็ว bench_compare
+// รัน fibo_bench หลายครั้ง เทียบค่ากลางกับ baseline ที่เก็บใน repository แล้วพิมพ์ตาราง markdown
+// คืนค่า 1 ถ้ามีชุดวัดที่ถดถอย (ใช้เป็นด่านตรวจก่อนรวมโค้ดจาก upstream)
+//   bench_compare --runs 5
+//   bench_compare --runs 7 --update-baseline   (หลังตั้งใจเปลี่ยนความเร็ว หรือย้ายเครื่องที่ใช้วัด)
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BenchCompare.h"
+#include "../UI System/UIHelper.h"
+
+using namespace std;
+
+// ใส่เครื่องหมายคำพูดให้ shell (popen)
+static string shellQuote(const string &text)
+{
+  string quoted = "'";
+  for (char c : text)
+  {
+    quoted += c == '\'' ? string("'\\''") : string(1, c);
+  }
+  return quoted + "'";
+}
+
+// รัน fibo_bench 1 ครั้งแล้วอ่าน JSON จาก stdout
+static bool runBench(const string &command, BenchRuns &runs, string &error)
+{
+  FILE *pipe = popen(command.c_str(), "r");
+  if (!pipe)
+  {
+    error = "รัน fibo_bench ไม่ได้";
+    return false;
+  }
+  string output;
+  char buffer[4096];
+  size_t read_bytes;
+  while ((read_bytes = fread(buffer, 1, sizeof(buffer), pipe)) > 0)
+  {
+    output.append(buffer, read_bytes);
+  }
+  if (pclose(pipe) != 0)
+  {
+    error = "fibo_bench จบด้วยข้อผิดพลาด (" + command + ")";
+    return false;
+  }
+  return readBenchRuns(output, runs, error);
+}
+
+static bool readFile(const string &path, string &text)
+{
+  ifstream file(path);
+  if (!file)
+  {
+    return false;
+  }
+  stringstream content;
+  content << file.rdbuf();
+  text = content.str();
+  return true;
+}
+
+// ตัวเลือก:
+//   --bench <path>        โปรแกรม fibo_bench ที่จะรัน (ค่าเริ่มต้น ./fibo_bench)
+//   --runs <n>            จำนวนครั้งที่รัน (ค่าเริ่มต้น 5 - น้อยกว่านี้ไม่ถึงระดับนัยสำคัญเริ่มต้น)
+//   --min-time <sec>      ส่งต่อให้ fibo_bench (ค่าเริ่มต้น 0.5)
+//   --filter <text>       ส่งต่อให้ fibo_bench (ใส่ซ้ำได้)
+//   --cards <file>        ส่งต่อให้ fibo_bench
+//   --current <file>      ใช้ผล JSON ของ fibo_bench ที่มีอยู่แทนการรัน (ใส่ซ้ำได้ 1 ไฟล์ต่อ 1 ครั้ง)
+//   --baseline <file>     ค่าเริ่มต้น "Benchmark System/baseline.json"
+//   --threshold <ratio>   ช้าลงเกินเท่าไรจึงนับ (ค่าเริ่มต้น 0.20 = 20%)
+//   --alpha <p>           ระดับนัยสำคัญ (ค่าเริ่มต้น 0.01)
+//   --markdown <file>     เขียนตารางลงไฟล์ด้วย (ตารางแสดงทางหน้าจอเสมอ)
+//   --update-baseline     เขียนผลครั้งนี้เป็น baseline ใหม่แทนการเทียบ
+// exit code: 0 = ไม่ถดถอย, 1 = ถดถอย, 2 = ใช้งานผิดหรือเกิดข้อผิดพลาด
+int main(int argc, char *argv[])
+{
+  string bench_path = "./fibo_bench";
+  int runs_wanted = 5;
+  string bench_args;
+  vector<string> current_files;
+  string baseline_path = "Benchmark System/baseline.json";
+  string markdown_path;
+  bool update_baseline = false;
+  BenchCompareOptions options;
+  bool valid = true;
+  for (int i = 1; i < argc && valid; ++i)
+  {
+    string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    try
+    {
+      if (arg == "--bench" && has_value)
+      {
+        bench_path = argv[++i];
+      }
+      else if (arg == "--runs" && has_value)
+      {
+        runs_wanted = stoi(argv[++i]);
+        valid = runs_wanted > 0;
+      }
+      else if ((arg == "--min-time" || arg == "--filter" || arg == "--cards") && has_value)
+      {
+        bench_args += " " + arg + " " + shellQuote(argv[++i]);
+      }
+      else if (arg == "--current" && has_value)
+      {
+        current_files.push_back(argv[++i]);
+      }
+      else if (arg == "--baseline" && has_value)
+      {
+        baseline_path = argv[++i];
+      }
+      else if (arg == "--threshold" && has_value)
+      {
+        options.threshold = stod(argv[++i]);
+      }
+      else if (arg == "--alpha" && has_value)
+      {
+        options.alpha = stod(argv[++i]);
+      }
+      else if (arg == "--markdown" && has_value)
+      {
+        markdown_path = argv[++i];
+      }
+      else if (arg == "--update-baseline")
+      {
+        update_baseline = true;
+      }
+      else
+      {
+        valid = false;
+      }
+    }
+    catch (const exception &)
+    {
+      valid = false;
+    }
+  }
+  if (!valid)
+  {
+    cerr << "วิธีใช้: " << argv[0]
+         << " [--bench <path>] [--runs <n>] [--min-time <sec>] [--filter <text>] [--cards <file>] [--current <file>]"
+            " [--baseline <file>] [--threshold <ratio>] [--alpha <p>] [--markdown <file>] [--update-baseline]"
+         << endl;
+    return 2;
+  }
+
+  // --- ผลครั้งนี้ ---
+  BenchRuns current;
+  string error;
+  if (!current_files.empty())
+  {
+    for (const string &path : current_files)
+    {
+      string text;
+      if (!readFile(path, text))
+      {
+        UIHelper::PrintError("เปิดไฟล์ '" + path + "' ไม่ได้");
+        return 2;
+      }
+      if (!readBenchRuns(text, current, error))
+      {
+        UIHelper::PrintError(path + ": " + error);
+        return 2;
+      }
+    }
+  }
+  else
+  {
+    string command = shellQuote(bench_path) + " --json -" + bench_args + " 2>/dev/null";
+    for (int run = 0; run < runs_wanted; ++run)
+    {
+      cerr << "\rรัน fibo_bench ครั้งที่ " << (run + 1) << "/" << runs_wanted << flush;
+      if (!runBench(command, current, error))
+      {
+        cerr << endl;
+        UIHelper::PrintError(error);
+        return 2;
+      }
+    }
+    cerr << endl;
+  }
+
+  if (update_baseline)
+  {
+    if (!writeBenchBaseline(baseline_path, current))
+    {
+      UIHelper::PrintError("เขียนไฟล์ '" + baseline_path + "' ไม่ได้");
+      return 2;
+    }
+    UIHelper::PrintSuccess("บันทึก baseline " + to_string(current.size()) + " ชุดลง '" + baseline_path + "'");
+    return 0;
+  }
+
+  // --- เทียบกับ baseline ---
+  string baseline_text;
+  BenchRuns baseline;
+  if (!readFile(baseline_path, baseline_text))
+  {
+    UIHelper::PrintError("เปิดไฟล์ baseline '" + baseline_path + "' ไม่ได้ (สร้างด้วย --update-baseline)");
+    return 2;
+  }
+  if (!readBenchRuns(baseline_text, baseline, error))
+  {
+    UIHelper::PrintError(baseline_path + ": " + error);
+    return 2;
+  }
+  // --filter วัดเฉพาะบางชุด: ชุดอื่นใน baseline ไม่นับว่าหายไป
+  if (bench_args.find("--filter") != string::npos)
+  {
+    for (auto it = baseline.begin(); it != baseline.end();)
+    {
+      it = current.count(it->first) ? next(it) : baseline.erase(it);
+    }
+  }
+
+  vector<BenchComparison> comparisons = compareBenchRuns(baseline, current, options);
+  writeBenchMarkdown(cout, comparisons, options);
+  if (!markdown_path.empty())
+  {
+    ofstream file(markdown_path);
+    writeBenchMarkdown(file, comparisons, options);
+    if (!file)
+    {
+      UIHelper::PrintError("เขียนไฟล์ '" + markdown_path + "' ไม่ได้");
+      return 2;
+    }
+  }
+
+  int regressions = 0;
+  for (const BenchComparison &row : comparisons)
+  {
+    regressions += row.regression ? 1 : 0;
+  }
+  if (regressions > 0)
+  {
+    UIHelper::PrintError("ถดถอย " + to_string(regressions) + " ชุด");
+    return 1;
+  }
+  UIHelper::PrintSuccess("ไม่มีชุดวัดที่ถดถอย");
+  return 0;
+}
@@ -0,0 +1,350 @@
+// GameBenchmarks.cpp - ไฟล์ Source สำหรับชุดวัดความเร็วของการทำงานหลักในเกม (fibo_bench)
+// ทุกชุดถูกเรียกภายใต้ NullSink (ยกเว้น displayField ที่เขียนลง DiscardSink เพื่อวัดการจัดรูปแบบข้อความ)
+#include "Benchmark.h"
+#include "../Game Core/CardDatabase.h"
+#include "../Game Core/CardTable.h"
+#include "../Game Core/BattleResolver.h"
+#include "../Game Core/Player.h"
+#include "../Game Core/Match.h"
+#include "../UI System/OutputSink.h"
+#include "../Training System/VecEnv.h"
+#include <optional>
+
+static std::string bench_cards_path = "cards.json";
+static std::vector<Card> bench_catalog;
+
+bool loadBenchData(const std::string &cards_path)
+{
+  bench_cards_path = cards_path;
+  bench_catalog = loadCardsFromJson(cards_path);
+  return !bench_catalog.empty();
+}
+
+// รับข้อมูลทุกไบต์แต่ทิ้งไป - ต่างจาก NullSink ตรงที่โค้ดแสดงผลยังจัดรูปแบบข้อความตามปกติ
+class DiscardSink : public OutputSink
+{
+public:
+  size_t bytes = 0;
+  void Write(const char *, size_t size) override { bytes += size; }
+};
+
+// ตัวสุ่มการกระทำที่ทำได้ (SplitMix64) สำหรับเดินเกมแบบสุ่ม - ผลขึ้นกับ seed เท่านั้น
+class BenchRandom
+{
+private:
+  uint64_t state;
+
+public:
+  explicit BenchRandom(uint64_t seed) : state(seed) {}
+
+  // เดินเกม 1 การกระทำ คืนค่า false ถ้าเกมจบหรือไม่มีการกระทำที่ทำได้
+  bool step(Match &match)
+  {
+    if (match.isOver())
+    {
+      return false;
+    }
+    uint8_t mask[ENV_ACTION_COUNT];
+    writeEnvLegalMask(match, mask);
+    int legal[ENV_ACTION_COUNT];
+    int legal_count = 0;
+    for (int id = 0; id < ENV_ACTION_COUNT; ++id)
+    {
+      if (mask[id])
+      {
+        legal[legal_count++] = id;
+      }
+    }
+    if (legal_count == 0)
+    {
+      return false;
+    }
+    state = nextEpisodeSeed(state);
+    GameAction action;
+    return envActionToGame(match, legal[state % static_cast<uint64_t>(legal_count)], action) && match.submit(action);
+  }
+};
+
+static Match makeBenchMatch(const Deck &deck, uint64_t seed)
+{
+  Match match("Player 1", deck, "Player 2", deck);
+  match.setup(STARTER_CODE_NAME, seed);
+  match.start(static_cast<int>(seed & 1));
+  return match;
+}
+
+// ผู้เล่นกลางเกมที่มียูนิตบนสนามอย่างน้อย 4 ช่อง (เดินเกมแบบสุ่มจาก seed คงที่จนถึงสถานะนั้น)
+static Player makeMidGamePlayer()
+{
+  Deck deck(bench_catalog, getStandardDeckRecipe());
+  for (uint64_t seed = 1;; ++seed)
+  {
+    Match match = makeBenchMatch(deck, seed);
+    BenchRandom random(seed);
+    while (random.step(match))
+    {
+      const Player &player = match.getPlayer(0);
+      int units = 0;
+      for (int idx = 0; idx < NUM_FIELD_UNITS; ++idx)
+      {
+        units += player.hasUnitAt(idx) ? 1 : 0;
+      }
+      if (units >= 4)
+      {
+        return player;
+      }
+    }
+  }
+}
+
+static void benchLoadCards(BenchState &state)
+{
+  while (state.keepRunning())
+  {
+    std::vector<Card> catalog = loadCardsFromJson(bench_cards_path);
+    doNotOptimize(catalog);
+  }
+}
+
+static void benchDeckConstruct(BenchState &state)
+{
+  const std::map<std::string, int> &recipe = getStandardDeckRecipe();
+  while (state.keepRunning())
+  {
+    Deck deck(bench_catalog, recipe);
+    doNotOptimize(deck);
+  }
+}
+
+static void benchDeckShuffle(BenchState &state)
+{
+  Deck deck(bench_catalog, getStandardDeckRecipe());
+  uint64_t seed = 1;
+  while (state.keepRunning())
+  {
+    deck.shuffle(seed++);
+  }
+  doNotOptimize(deck);
+}
+
+static void benchDeckDraw(BenchState &state)
+{
+  Deck prototype(bench_catalog, getStandardDeckRecipe());
+  prototype.shuffle(1);
+  Deck deck = prototype;
+  while (state.keepRunning())
+  {
+    if (deck.isEmpty())
+    {
+      state.pauseTiming();
+      deck = prototype;
+      state.resumeTiming();
+    }
+    std::optional<Card> card = deck.draw();
+    doNotOptimize(card);
+  }
+}
+
+// ลบการ์ดทีละรหัสตามสูตรเด็ค แล้วใส่คืนก้นสำรับนอกการจับเวลา (สำรับมี 50 ใบตลอดการวัด)
+static void benchDeckRemoveByCode(BenchState &state)
+{
+  std::vector<std::string> codes;
+  for (const auto &entry : getStandardDeckRecipe())
+  {
+    codes.push_back(entry.first);
+  }
+  Deck deck(bench_catalog, getStandardDeckRecipe());
+  deck.shuffle(1);
+  size_t next = 0;
+  while (state.keepRunning())
+  {
+    std::optional<Card> card = deck.removeCardByCodeName(codes[next]);
+    next = (next + 1) % codes.size();
+    state.pauseTiming();
+    if (card.has_value())
+    {
+      deck.addCardToBottom(*card);
+    }
+    state.resumeTiming();
+  }
+}
+
+static void benchPlayerSetup(BenchState &state)
+{
+  const Deck deck(bench_catalog, getStandardDeckRecipe());
+  uint64_t seed = 1;
+  while (state.keepRunning())
+  {
+    state.pauseTiming();
+    Player player("Player 1", Deck(deck));
+    state.resumeTiming();
+    bool ok = player.setupGame(STARTER_CODE_NAME, 5, seed++);
+    doNotOptimize(ok);
+    state.pauseTiming(); // ไม่นับการทำลาย Player
+    {
+      Player discarded(std::move(player));
+    }
+    state.resumeTiming();
+  }
+}
+
+// Drive Check 1 ใบต่อรอบ (เตรียมผู้เล่นใหม่นอกการจับเวลาเมื่อสำรับเหลือน้อย)
+static void benchDriveCheck(BenchState &state)
+{
+  const Deck deck(bench_catalog, getStandardDeckRecipe());
+  Player prototype("Player 1", Deck(deck));
+  Player opponent("Player 2", Deck(deck));
+  prototype.setupGame(STARTER_CODE_NAME, 5, 1);
+  opponent.setupGame(STARTER_CODE_NAME, 5, 2);
+  Player player = prototype;
+  while (state.keepRunning())
+  {
+    if (player.getDeck().getSize() < 4)
+    {
+      state.pauseTiming();
+      player = prototype;
+      state.resumeTiming();
+    }
+    TriggerOutput output = player.performDriveCheck(1, &opponent);
+    doNotOptimize(output);
+  }
+}
+
+// พลังของแถวหน้าทั้ง 3 ช่อง ทั้งแบบไม่มี Boost, มี Boost จากช่องด้านหลัง และแบบป้องกัน
+static void benchUnitPower(BenchState &state)
+{
+  const Player player = makeMidGamePlayer();
+  static const int queries[][3] = {
+      {static_cast<int>(UNIT_STATUS_VC_IDX), -1, 0},
+      {static_cast<int>(UNIT_STATUS_VC_IDX), static_cast<int>(UNIT_STATUS_RC_BC_IDX), 0},
+      {static_cast<int>(UNIT_STATUS_RC_FL_IDX), static_cast<int>(UNIT_STATUS_RC_BL_IDX), 0},
+      {static_cast<int>(UNIT_STATUS_RC_FR_IDX), static_cast<int>(UNIT_STATUS_RC_BR_IDX), 0},
+      {static_cast<int>(UNIT_STATUS_VC_IDX), -1, 1},
+      {static_cast<int>(UNIT_STATUS_RC_FL_IDX), -1, 1},
+  };
+  const size_t query_count = sizeof(queries) / sizeof(queries[0]);
+  size_t next = 0;
+  while (state.keepRunning())
+  {
+    const int *query = queries[next];
+    next = (next + 1) % query_count;
+    int power = player.getUnitPowerAtStatusIndex(query[0], query[1], query[2] != 0);
+    doNotOptimize(power);
+  }
+}
+
+static void benchDisplayField(BenchState &state)
+{
+  const Player player = makeMidGamePlayer();
+  DiscardSink discard;
+  ScopedOutputSink scope(&discard);
+  while (state.keepRunning())
+  {
+    player.displayField();
+  }
+  doNotOptimize(discard.bytes);
+}
+
+// รายการ CardId ของสำรับมาตรฐาน 50 ใบ (ลำดับหลังสับด้วย seed 1)
+static std::vector<CardId> benchDeckIds(const CardTable &table)
+{
+  Deck deck(bench_catalog, getStandardDeckRecipe());
+  deck.shuffle(1);
+  std::vector<Card> cards;
+  while (std::optional<Card> card = deck.draw())
+  {
+    cards.push_back(*card);
+  }
+  std::vector<CardId> ids(cards.size());
+  ids.resize(table.collectIds(cards, ids.data()));
+  return ids;
+}
+
+// รวม shield ของทั้งสำรับ 1 ครั้งต่อรอบ
+static void benchTableSumShield(BenchState &state)
+{
+  const CardTable table(bench_catalog);
+  const std::vector<CardId> ids = benchDeckIds(table);
+  while (state.keepRunning())
+  {
+    int total = table.sumShield(ids);
+    doNotOptimize(total);
+  }
+}
+
+// นับการ์ดทริกเกอร์ของทั้งสำรับ 1 ครั้งต่อรอบ
+static void benchTableCountByRole(BenchState &state)
+{
+  const CardTable table(bench_catalog);
+  const std::vector<CardId> ids = benchDeckIds(table);
+  while (state.keepRunning())
+  {
+    size_t triggers = table.countByRole(ids, ROLE_TRIGGER);
+    doNotOptimize(triggers);
+  }
+}
+
+// ตัดสินการโจมตี 4096 แบบต่อรอบ (ค่าสุ่มคงที่ในช่วงพลัง/shield ของการ์ดจริง)
+static void benchResolveBattles(BenchState &state)
+{
+  const size_t count = 4096;
+  std::vector<int32_t> attacker(count), booster(count), drive(count), defender(count), shield(count), critical(count);
+  uint64_t seed = 1;
+  for (size_t i = 0; i < count; ++i)
+  {
+    seed = nextEpisodeSeed(seed);
+    attacker[i] = static_cast<int32_t>(5000 + seed % 8 * 1000);
+    booster[i] = seed >> 8 & 1 ? static_cast<int32_t>(5000 + (seed >> 9) % 4 * 1000) : 0;
+    drive[i] = static_cast<int32_t>((seed >> 12) % 3 * 10000);
+    defender[i] = static_cast<int32_t>(5000 + (seed >> 16) % 8 * 1000);
+    shield[i] = static_cast<int32_t>((seed >> 20) % 4 * 10000);
+    critical[i] = static_cast<int32_t>(1 + (seed >> 24) % 2);
+  }
+  const BattleLines lines{attacker.data(), booster.data(), drive.data(), defender.data(), shield.data(), critical.data(),
+                          count};
+  std::vector<uint8_t> hit(count);
+  std::vector<int32_t> damage(count);
+  while (state.keepRunning())
+  {
+    size_t hits = resolveBattles(lines, hit.data(), damage.data());
+    doNotOptimize(hits);
+  }
+  doNotOptimize(damage);
+}
+
+// เกมสุ่ม 1 เกมต่อรอบ ตั้งแต่สร้าง Match จนจบ (วนใช้ seed 1-32)
+static void benchRandomGame(BenchState &state)
+{
+  const Deck deck(bench_catalog, getStandardDeckRecipe());
+  uint64_t game = 0;
+  while (state.keepRunning())
+  {
+    uint64_t seed = game++ % 32 + 1;
+    Match match = makeBenchMatch(deck, seed);
+    BenchRandom random(seed);
+    while (random.step(match))
+    {
+    }
+    doNotOptimize(match);
+  }
+}
+
+const std::vector<BenchSpec> &getGameBenchmarks()
+{
+  static const std::vector<BenchSpec> benchmarks = {
+      {"loadCardsFromJson", benchLoadCards},
+      {"Deck::Deck", benchDeckConstruct},
+      {"Deck::shuffle", benchDeckShuffle},
+      {"Deck::draw", benchDeckDraw},
+      {"Deck::removeCardByCodeName", benchDeckRemoveByCode},
+      {"Player::setupGame", benchPlayerSetup},
+      {"Player::performDriveCheck", benchDriveCheck},
+      {"Player::getUnitPowerAtStatusIndex", benchUnitPower},
+      {"Player::displayField", benchDisplayField},
+      {"CardTable::sumShield", benchTableSumShield},
+      {"CardTable::countByRole", benchTableCountByRole},
+      {"resolveBattles", benchResolveBattles},
+      {"Match::randomGame", benchRandomGame},
+  };
+  return benchmarks;
+}
@@ -0,0 +1,53 @@
+#!/bin/bash
+# build_network.sh - Script สำหรับ compile เซิร์ฟเวอร์และไคลเอนต์สำหรับเล่นผ่านเครือข่าย (Linux/macOS)
+
+# ย้ายไปที่โฟลเดอร์หลักของโปรเจค
+cd "$(dirname "$0")/.." || exit 1
+
+# ไฟล์ที่ใช้ร่วมกันระหว่าง fibo_server และ fibo_client
+COMMON_SOURCES=(
+    "Game Core/Card.cpp"
+    "Game Core/Deck.cpp"
+    "Game Core/Player.cpp"
+    "Game Core/Match.cpp"
+    "Game Core/BattleResolver.cpp"
+    "Game Core/MatchArena.cpp"
+    "Game Core/MatchScheduler.cpp"
+    "Game Core/CardDatabase.cpp"
+    "Game Core/CardTable.cpp"
+    "Game Core/Replay.cpp"
+    "Game Core/GameStats.cpp"
+    "Game Core/Trace.cpp"
+    "Game Core/Metrics.cpp"
+    "Game Core/AllocationProfile.cpp"
+    "UI System/UIHelper.cpp"
+    "UI System/MenuSystem.cpp"
+    "UI System/InputSource.cpp"
+    "UI System/OutputSink.cpp"
+    "UI System/KeyboardInput.cpp"
+    "Network System/Protocol.cpp"
+    "Network System/Socket.cpp"
+)
+
+echo "🔧 Compiling fibo_server..."
+g++ -std=c++17 -Wall -Wextra -O2 \
+    "${COMMON_SOURCES[@]}" \
+    "Network System/MatchServer.cpp" \
+    "Network System/ServerMain.cpp" \
+    -I"Game Core" \
+    -I"UI System" \
+    -o fibo_server || { echo "❌ Compilation failed!"; exit 1; }
+
+echo "🔧 Compiling fibo_client..."
+g++ -std=c++17 -Wall -Wextra -O2 \
+    "${COMMON_SOURCES[@]}" \
+    "Network System/Lockstep.cpp" \
+    "Network System/ClientMain.cpp" \
+    -I"Game Core" \
+    -I"UI System" \
+    -o fibo_client || { echo "❌ Compilation failed!"; exit 1; }
+
+cp "Data/cards.json" "cards.json" 2>/dev/null
+echo "✅ Compilation successful!"
+echo "   ./fibo_server --port 7777"
+echo "   ./fibo_client --port 7777 --name <ชื่อ>"
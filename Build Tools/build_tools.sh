@@ -0,0 +1,106 @@
+#!/bin/bash
+# build_tools.sh - Script สำหรับ compile เครื่องมือวิเคราะห์ข้อมูลเกม (Linux/macOS)
+
+# ย้ายไปที่โฟลเดอร์หลักของโปรเจค
+cd "$(dirname "$0")/.." || exit 1
+
+# ส่วนของเกมที่เครื่องมือทุกตัวใช้ร่วมกัน
+COMMON_SOURCES=(
+    "Game Core/Card.cpp"
+    "Game Core/Deck.cpp"
+    "Game Core/Player.cpp"
+    "Game Core/Match.cpp"
+    "Game Core/BattleResolver.cpp"
+    "Game Core/MatchArena.cpp"
+    "Game Core/CardDatabase.cpp"
+    "Game Core/CardTable.cpp"
+    "Game Core/Replay.cpp"
+    "Game Core/GameStats.cpp"
+    "Game Core/Trace.cpp"
+    "Game Core/Metrics.cpp"
+    "Game Core/AllocationProfile.cpp"
+    "UI System/UIHelper.cpp"
+    "UI System/MenuSystem.cpp"
+    "UI System/InputSource.cpp"
+    "UI System/OutputSink.cpp"
+    "UI System/KeyboardInput.cpp"
+)
+
+echo "🔧 Compiling fibo_analyze..."
+g++ -std=c++17 -Wall -Wextra -O2 -pthread \
+    "${COMMON_SOURCES[@]}" \
+    "Analytics System/ReplayQuery.cpp" \
+    "Analytics System/ReplayCorpus.cpp" \
+    "Analytics System/AnalyzeMain.cpp" \
+    -I"Game Core" \
+    -I"UI System" \
+    -o fibo_analyze || { echo "❌ Compilation failed!"; exit 1; }
+
+echo "🔧 Compiling fibo_stats_csv..."
+g++ -std=c++17 -Wall -Wextra -O2 \
+    "${COMMON_SOURCES[@]}" \
+    "Analytics System/StatsCsvMain.cpp" \
+    -I"Game Core" \
+    -I"UI System" \
+    -o fibo_stats_csv || { echo "❌ Compilation failed!"; exit 1; }
+
+echo "🔧 Compiling libfibo_env.so..."
+g++ -std=c++17 -Wall -Wextra -O2 -flto=auto -pthread -fPIC -shared \
+    "${COMMON_SOURCES[@]}" \
+    "Training System/ObservationEncoder.cpp" \
+    "Training System/VecEnv.cpp" \
+    "Training System/FiboEnv.cpp" \
+    -I"Game Core" \
+    -I"UI System" \
+    -o libfibo_env.so || { echo "❌ Compilation failed!"; exit 1; }
+
+echo "🔧 Compiling fibo_selfplay..."
+g++ -std=c++17 -Wall -Wextra -O2 -flto=auto -pthread \
+    "${COMMON_SOURCES[@]}" \
+    "Training System/ObservationEncoder.cpp" \
+    "Training System/VecEnv.cpp" \
+    "Training System/RolloutSearch.cpp" \
+    "Training System/SelfPlayDataset.cpp" \
+    "Training System/SelfPlay.cpp" \
+    "Training System/SelfPlayMain.cpp" \
+    -I"Game Core" \
+    -I"UI System" \
+    -o fibo_selfplay || { echo "❌ Compilation failed!"; exit 1; }
+
+# flag เดียวกับตัวเกม (compile_and_run.sh) ผลที่วัดได้จึงตรงกับเกมจริง
+# ยกเว้น -DFIBO_ALLOC_COUNT ที่ให้ AllocationProfile.cpp แทนที่ operator new เพื่อนับ allocs/op
+echo "🔧 Compiling fibo_bench..."
+g++ -std=c++17 -Wall -Wextra -O2 -pthread -DFIBO_ALLOC_COUNT \
+    "${COMMON_SOURCES[@]}" \
+    "Training System/ObservationEncoder.cpp" \
+    "Training System/VecEnv.cpp" \
+    "Benchmark System/AllocationCounter.cpp" \
+    "Benchmark System/Benchmark.cpp" \
+    "Benchmark System/GameBenchmarks.cpp" \
+    "Benchmark System/BenchMain.cpp" \
+    -I"Game Core" \
+    -I"UI System" \
+    -o fibo_bench || { echo "❌ Compilation failed!"; exit 1; }
+
+echo "🔧 Compiling bench_compare..."
+g++ -std=c++17 -Wall -Wextra -O2 \
+    "Game Core/AllocationProfile.cpp" \
+    "Game Core/Trace.cpp" \
+    "UI System/UIHelper.cpp" \
+    "UI System/InputSource.cpp" \
+    "UI System/OutputSink.cpp" \
+    "UI System/KeyboardInput.cpp" \
+    "Benchmark System/BenchCompare.cpp" \
+    "Benchmark System/CompareMain.cpp" \
+    -I"Game Core" \
+    -I"UI System" \
+    -o bench_compare || { echo "❌ Compilation failed!"; exit 1; }
+
+cp "Data/cards.json" "cards.json" 2>/dev/null
+echo "✅ Compilation successful!"
+echo "   ./fibo_analyze <โฟลเดอร์ replay> --event ride --where card=G3-04 --where turn<=5 --agg winrate"
+echo "   ./fibo_stats_csv <ไฟล์สถิติ> --table turns --out turns.csv"
+echo "   ./fibo_selfplay selfplay --games 100000 --simulations 64"
+echo "   ./fibo_bench --json bench.json"
+echo "   ./bench_compare --runs 5 --markdown bench.md"
+echo "   libfibo_env.so (C ABI ใน \"Training System/fibo_env.h\") สำหรับโปรแกรมฝึก RL"
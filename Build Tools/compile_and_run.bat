@@ -12,8 +12,22 @@ g++ -std=c++17 -Wall -Wextra -O2 ^
     "Game Core\Card.cpp" ^
     "Game Core\Deck.cpp" ^
     "Game Core\Player.cpp" ^
+    "Game Core\Match.cpp" ^
+    "Game Core\BattleResolver.cpp" ^
+    "Game Core\MatchArena.cpp" ^
+    "Game Core\MatchScheduler.cpp" ^
+    "Game Core\CardDatabase.cpp" ^
+    "Game Core\CardTable.cpp" ^
+    "Game Core\Replay.cpp" ^
+    "Game Core\GameStats.cpp" ^
+    "Game Core\Trace.cpp" ^
+    "Game Core\Metrics.cpp" ^
+    "Game Core\AllocationProfile.cpp" ^
     "UI System\UIHelper.cpp" ^
     "UI System\MenuSystem.cpp" ^
+    "UI System\InputSource.cpp" ^
+    "UI System\OutputSink.cpp" ^
+    "UI System\KeyboardInput.cpp" ^
     -I"Game Core" ^
     -I"UI System" ^
     -I. ^
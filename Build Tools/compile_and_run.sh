@@ -1,16 +1,35 @@
 #!/bin/bash
 # compile_and_run.sh - Script สำหรับ compile และรันเกม
 
+# ย้ายไปที่โฟลเดอร์หลักของโปรเจค
+cd "$(dirname "$0")/.." || exit 1
+
 echo "🔧 Compiling FIBO Card Commandos..."
 
 # Compile the improved version with all new UI files
 g++ -std=c++17 -Wall -Wextra -O2 \
-    Main.cpp \
-    Card.cpp \
-    Deck.cpp \
-    Player.cpp \
-    UIHelper.cpp \
-    MenuSystem.cpp \
+    "Game Core/Main.cpp" \
+    "Game Core/Card.cpp" \
+    "Game Core/Deck.cpp" \
+    "Game Core/Player.cpp" \
+    "Game Core/Match.cpp" \
+    "Game Core/BattleResolver.cpp" \
+    "Game Core/MatchArena.cpp" \
+    "Game Core/MatchScheduler.cpp" \
+    "Game Core/CardDatabase.cpp" \
+    "Game Core/CardTable.cpp" \
+    "Game Core/Replay.cpp" \
+    "Game Core/GameStats.cpp" \
+    "Game Core/Trace.cpp" \
+    "Game Core/Metrics.cpp" \
+    "Game Core/AllocationProfile.cpp" \
+    "UI System/UIHelper.cpp" \
+    "UI System/MenuSystem.cpp" \
+    "UI System/InputSource.cpp" \
+    "UI System/OutputSink.cpp" \
+    "UI System/KeyboardInput.cpp" \
+    -I"Game Core" \
+    -I"UI System" \
     -o fibo_card_commandos
 
 # Check if compilation was successful
@@ -18,8 +37,9 @@ if [ $? -eq 0 ]; then
     echo "✅ Compilation successful!"
     echo "🚀 Starting FIBO Card Commandos..."
     echo ""
-    ./fibo_card_commandos
+    cp "Data/cards.json" "cards.json" 2>/dev/null
+    ./fibo_card_commandos "$@"
 else
     echo "❌ Compilation failed!"
     exit 1
-fi
\ No newline at end of file
+fi
@@ -0,0 +1,173 @@
+// AllocationProfile.cpp - ไฟล์ Source สำหรับนับการจองหน่วยความจำแยกตามระบบย่อย
+// (แทนที่ operator new/delete ของทั้งโปรแกรมเฉพาะเมื่อ compile ด้วย -DFIBO_ALLOC_PROFILE หรือ -DFIBO_ALLOC_COUNT)
+// นี่คือชุดแทนที่ operator new เพียงชุดเดียวของโปรแกรม - fibo_bench อ่านยอดจากที่นี่ผ่าน AllocationCounter
+#include "AllocationProfile.h"
+#include <new>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+static const char *const ALLOCATION_TAG_NAMES[ALLOCATION_TAG_COUNT] = {"Other", "Deck", "Player", "UI", "Loader", "AI"};
+
+const char *allocationTagName(AllocationTag tag)
+{
+  return ALLOCATION_TAG_NAMES[static_cast<size_t>(tag)];
+}
+
+uint64_t AllocationTotals::totalAllocations() const
+{
+  uint64_t total = 0;
+  for (uint64_t count : allocations)
+  {
+    total += count;
+  }
+  return total;
+}
+
+uint64_t AllocationTotals::totalBytes() const
+{
+  uint64_t total = 0;
+  for (uint64_t count : bytes)
+  {
+    total += count;
+  }
+  return total;
+}
+
+AllocationTotals &AllocationTotals::operator+=(const AllocationTotals &other)
+{
+  for (size_t tag = 0; tag < ALLOCATION_TAG_COUNT; ++tag)
+  {
+    allocations[tag] += other.allocations[tag];
+    bytes[tag] += other.bytes[tag];
+  }
+  return *this;
+}
+
+AllocationTotals AllocationTotals::operator-(const AllocationTotals &other) const
+{
+  AllocationTotals result;
+  for (size_t tag = 0; tag < ALLOCATION_TAG_COUNT; ++tag)
+  {
+    result.allocations[tag] = allocations[tag] - other.allocations[tag];
+    result.bytes[tag] = bytes[tag] - other.bytes[tag];
+  }
+  return result;
+}
+
+void writeAllocationReport(std::ostream &out, const std::string &title, const AllocationTotals &totals, uint64_t games)
+{
+  double divisor = games > 0 ? static_cast<double>(games) : 1.0;
+  std::ios::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision();
+  out << "การจองหน่วยความจำ: " << title;
+  if (games > 1)
+  {
+    out << " (เฉลี่ยต่อเกม จาก " << games << " เกม)";
+  }
+  out << "\n" << std::fixed << std::setprecision(games > 1 ? 1 : 0);
+  for (size_t tag = 0; tag < ALLOCATION_TAG_COUNT; ++tag)
+  {
+    out << "  " << std::left << std::setw(8) << ALLOCATION_TAG_NAMES[tag] << std::right << std::setw(14)
+        << static_cast<double>(totals.allocations[tag]) / divisor << " ครั้ง" << std::setw(16)
+        << static_cast<double>(totals.bytes[tag]) / divisor << " ไบต์\n";
+  }
+  out << "  " << std::left << std::setw(8) << "Total" << std::right << std::setw(14)
+      << static_cast<double>(totals.totalAllocations()) / divisor << " ครั้ง" << std::setw(16)
+      << static_cast<double>(totals.totalBytes()) / divisor << " ไบต์\n";
+  out.flags(flags);
+  out.precision(precision);
+}
+
+ScopedAllocationReport::ScopedAllocationReport(const std::string &report_title)
+    : title(report_title), started(currentThreadAllocationTotals())
+{
+}
+
+ScopedAllocationReport::~ScopedAllocationReport()
+{
+  if (ALLOCATION_PROFILE_ENABLED)
+  {
+    writeAllocationReport(std::cerr, title, currentThreadAllocationTotals() - started);
+  }
+}
+
+#if defined(FIBO_ALLOC_PROFILE) || defined(FIBO_ALLOC_COUNT)
+
+// ค่าเริ่มต้นเป็นค่าคงที่ทั้งหมด จึงใช้ได้ตั้งแต่การจองครั้งแรกของเธรด (ไม่มีขั้นตอนสร้างตัวแปร thread_local)
+// -DFIBO_ALLOC_COUNT อย่างเดียวไม่มี ALLOC_SCOPE ทุกการจองจึงถูกนับเป็น Other
+static thread_local AllocationTag current_tag = AllocationTag::Other;
+static thread_local AllocationTotals thread_totals;
+
+#ifdef FIBO_ALLOC_PROFILE
+ScopedAllocationTag::ScopedAllocationTag(AllocationTag tag) : previous(current_tag) { current_tag = tag; }
+ScopedAllocationTag::~ScopedAllocationTag() { current_tag = previous; }
+#endif
+
+AllocationTotals currentThreadAllocationTotals() { return thread_totals; }
+
+static void countAllocation(std::size_t size)
+{
+  size_t tag = static_cast<size_t>(current_tag);
+  thread_totals.allocations[tag]++;
+  thread_totals.bytes[tag] += size;
+}
+
+static void *profiledAllocate(std::size_t size)
+{
+  countAllocation(size);
+  void *memory = std::malloc(size > 0 ? size : 1);
+  if (!memory)
+  {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+static void *profiledAllocateAligned(std::size_t size, std::align_val_t alignment)
+{
+  countAllocation(size);
+  std::size_t align = static_cast<std::size_t>(alignment);
+  void *memory = std::aligned_alloc(align, (size + align - 1) / align * align);
+  if (!memory)
+  {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+void *operator new(std::size_t size) { return profiledAllocate(size); }
+void *operator new[](std::size_t size) { return profiledAllocate(size); }
+void *operator new(std::size_t size, std::align_val_t alignment) { return profiledAllocateAligned(size, alignment); }
+void *operator new[](std::size_t size, std::align_val_t alignment) { return profiledAllocateAligned(size, alignment); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+  try
+  {
+    return profiledAllocate(size);
+  }
+  catch (const std::bad_alloc &)
+  {
+    return nullptr;
+  }
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &tag) noexcept { return operator new(size, tag); }
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete[](void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void *memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void *memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void *memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void *memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void *memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void *memory, const std::nothrow_t &) noexcept { std::free(memory); }
+void operator delete[](void *memory, const std::nothrow_t &) noexcept { std::free(memory); }
+
+#else
+
+AllocationTotals currentThreadAllocationTotals() { return AllocationTotals(); }
+
+#endif
@@ -0,0 +1,90 @@
+// AllocationProfile.h - ไฟล์ Header สำหรับนับการจองหน่วยความจำแยกตามระบบย่อยของเกม (โหมด build สำหรับวัดเท่านั้น)
+// compile ด้วย -DFIBO_ALLOC_PROFILE เพื่อแทนที่ operator new/delete ของทั้งโปรแกรม แล้วนับจำนวนครั้งและไบต์ต่อเธรด
+// แยกตามป้าย (tag) ของ ALLOC_SCOPE ที่อยู่ด้านในสุดขณะจอง ใช้ยืนยันว่างานลดการจองหน่วยความจำได้ผลจริง
+//
+// ถ้าไม่ได้ใส่ -DFIBO_ALLOC_PROFILE: ALLOC_SCOPE ถูกตัดออกทั้งหมด และไม่มีการแทนที่ operator new
+// -DFIBO_ALLOC_COUNT (ใช้กับ fibo_bench) แทนที่ operator new เพื่อนับยอดรวมอย่างเดียว ไม่มีป้ายและไม่แสดงรายงาน
+#ifndef ALLOCATIONPROFILE_H
+#define ALLOCATIONPROFILE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+#ifdef FIBO_ALLOC_PROFILE
+static const bool ALLOCATION_PROFILE_ENABLED = true;
+#else
+static const bool ALLOCATION_PROFILE_ENABLED = false;
+#endif
+
+// ระบบย่อยที่จองหน่วยความจำ (Other = นอก ALLOC_SCOPE ทุกตัว เช่น Match และโค้ดของโปรแกรมหลัก)
+enum class AllocationTag : uint8_t
+{
+  Other,
+  Deck,
+  Player,
+  UI,
+  Loader,
+  AI,
+};
+
+static const size_t ALLOCATION_TAG_COUNT = 6;
+
+const char *allocationTagName(AllocationTag tag);
+
+// ยอดสะสมต่อป้าย (ใช้ค่าต่างระหว่าง 2 ครั้งที่อ่าน)
+struct AllocationTotals
+{
+  uint64_t allocations[ALLOCATION_TAG_COUNT] = {}; // จำนวนครั้งที่เรียก operator new (ทุกรูปแบบ)
+  uint64_t bytes[ALLOCATION_TAG_COUNT] = {};       // จำนวนไบต์ที่ขอ
+
+  uint64_t totalAllocations() const;
+  uint64_t totalBytes() const;
+  AllocationTotals &operator+=(const AllocationTotals &other);
+  AllocationTotals operator-(const AllocationTotals &other) const;
+};
+
+// ยอดสะสมของเธรดปัจจุบันตั้งแต่เธรดเริ่มทำงาน (เป็น 0 เสมอเมื่อไม่ได้ compile ด้วย -DFIBO_ALLOC_PROFILE หรือ -DFIBO_ALLOC_COUNT)
+AllocationTotals currentThreadAllocationTotals();
+
+// ตารางจำนวนครั้งและไบต์ต่อป้าย หารด้วย games เพื่อแสดงค่าเฉลี่ยต่อเกม
+void writeAllocationReport(std::ostream &out, const std::string &title, const AllocationTotals &totals,
+                           uint64_t games = 1);
+
+#ifdef FIBO_ALLOC_PROFILE
+// ตั้งป้ายของเธรดปัจจุบันจนออกจาก scope (ซ้อนกันได้ ป้ายด้านในสุดเป็นผู้ถูกนับ)
+class ScopedAllocationTag
+{
+private:
+  AllocationTag previous;
+
+public:
+  explicit ScopedAllocationTag(AllocationTag tag);
+  ~ScopedAllocationTag();
+  ScopedAllocationTag(const ScopedAllocationTag &) = delete;
+  ScopedAllocationTag &operator=(const ScopedAllocationTag &) = delete;
+};
+
+#define ALLOC_SCOPE_CONCAT_INNER(a, b) a##b
+#define ALLOC_SCOPE_CONCAT(a, b) ALLOC_SCOPE_CONCAT_INNER(a, b)
+#define ALLOC_SCOPE(tag) ScopedAllocationTag ALLOC_SCOPE_CONCAT(alloc_scope_, __LINE__)(AllocationTag::tag)
+#else
+#define ALLOC_SCOPE(tag) ((void)0)
+#endif
+
+// แสดงการจองหน่วยความจำของเธรดนี้ระหว่างสร้างจนออกจาก scope ทาง stderr (เฉพาะเมื่อ compile ด้วย -DFIBO_ALLOC_PROFILE)
+class ScopedAllocationReport
+{
+private:
+  std::string title;
+  AllocationTotals started;
+
+public:
+  explicit ScopedAllocationReport(const std::string &report_title);
+  ~ScopedAllocationReport();
+  ScopedAllocationReport(const ScopedAllocationReport &) = delete;
+  ScopedAllocationReport &operator=(const ScopedAllocationReport &) = delete;
+};
+
+#endif // ALLOCATIONPROFILE_H
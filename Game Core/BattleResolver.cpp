@@ -0,0 +1,67 @@
+// BattleResolver.cpp - ไฟล์ Source สำหรับตัดสินผลการโจมตีหลายแบบพร้อมกัน
+#include "BattleResolver.h"
+#include "SimdDispatch.h"
+#include <cstring>
+
+static size_t resolveBattlesScalar(const BattleLines &lines, size_t begin, uint8_t *hit, int32_t *damage)
+{
+  size_t hits = 0;
+  for (size_t i = begin; i < lines.count; ++i)
+  {
+    int attack_power = lines.attacker_power[i] + lines.booster_power[i] + lines.drive_bonus[i];
+    int defense_power = lines.defender_power[i] + lines.shield[i];
+    bool is_hit = isBattleHit(attack_power, defense_power);
+    hit[i] = is_hit ? 1 : 0;
+    damage[i] = is_hit ? lines.critical[i] : 0;
+    hits += is_hit;
+  }
+  return hits;
+}
+
+#if SIMD_HAS_AVX2_DISPATCH
+SIMD_TARGET_AVX2 static __m256i load8(const int32_t *values)
+{
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values));
+}
+
+// ตัดสินครั้งละ 8 แบบ: เข้า = ไม่ใช่ (ป้องกัน > โจมตี) แล้วใช้ผลเป็น mask ของ critical
+SIMD_TARGET_AVX2 static size_t resolveBattlesAvx2(const BattleLines &lines, uint8_t *hit, int32_t *damage, size_t &done)
+{
+  const __m256i all_ones = _mm256_set1_epi32(-1);
+  size_t hits = 0;
+  size_t i = 0;
+  for (; i + 8 <= lines.count; i += 8)
+  {
+    __m256i attack_power = _mm256_add_epi32(
+        _mm256_add_epi32(load8(lines.attacker_power + i), load8(lines.booster_power + i)), load8(lines.drive_bonus + i));
+    __m256i defense_power = _mm256_add_epi32(load8(lines.defender_power + i), load8(lines.shield + i));
+    __m256i is_hit = _mm256_xor_si256(_mm256_cmpgt_epi32(defense_power, attack_power), all_ones);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(damage + i), _mm256_and_si256(is_hit, load8(lines.critical + i)));
+
+    // ช่องละ 0/1 แล้วบีบจาก 32 บิตเหลือ 8 บิต (packs/packus ทำงานแยกครึ่งละ 128 บิต จึงได้ 4 ไบต์จากแต่ละครึ่ง)
+    __m256i flags = _mm256_srli_epi32(is_hit, 31);
+    __m256i words = _mm256_packs_epi32(flags, flags);
+    __m256i bytes = _mm256_packus_epi16(words, words);
+    uint32_t low = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm256_castsi256_si128(bytes)));
+    uint32_t high = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm256_extracti128_si256(bytes, 1)));
+    std::memcpy(hit + i, &low, sizeof(low));
+    std::memcpy(hit + i + 4, &high, sizeof(high));
+    hits += static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(is_hit)))));
+  }
+  done = i;
+  return hits;
+}
+#endif
+
+size_t resolveBattles(const BattleLines &lines, uint8_t *hit, int32_t *damage)
+{
+  size_t done = 0;
+  size_t hits = 0;
+#if SIMD_HAS_AVX2_DISPATCH
+  if (lines.count >= 8 && cpuHasAvx2())
+  {
+    hits = resolveBattlesAvx2(lines, hit, damage, done);
+  }
+#endif
+  return hits + resolveBattlesScalar(lines, done, hit, damage);
+}
@@ -0,0 +1,33 @@
+// BattleResolver.h - ไฟล์ Header สำหรับตัดสินผลการโจมตีหลายแบบพร้อมกัน (ใช้วางแผนของบอท)
+// Match ตัดสินการโจมตีทีละครั้งหลังรอการตัดสินใจของทั้ง 2 ฝ่าย ส่วนบอทที่ต้องลองชุด Attacker/Booster/Guard
+// หลายพันแบบต่อโหนดเตรียมค่าของแต่ละแบบเป็นอาร์เรย์ แล้วตัดสินทั้งหมดด้วย resolveBattles() ครั้งเดียว
+// (ใช้ AVX2 ครั้งละ 8 แบบเมื่อ CPU รองรับ ผลเท่ากับโค้ด scalar ทุกบิต)
+#ifndef BATTLERESOLVER_H
+#define BATTLERESOLVER_H
+
+#include <cstdint>
+#include <cstddef>
+
+// กติกาการโจมตีเข้า: พลังโจมตีรวม (Attacker + Booster + Drive Check) ไม่น้อยกว่าพลังป้องกันรวม (ยูนิต + shield)
+inline bool isBattleHit(int attack_power, int defense_power)
+{
+  return attack_power >= defense_power;
+}
+
+// การโจมตี count แบบ - ทุกช่องเป็นอาร์เรย์ยาว count ช่อง (struct-of-arrays)
+struct BattleLines
+{
+  const int32_t *attacker_power; // พลังของ Attacker
+  const int32_t *booster_power;  // พลังของ Booster (0 = ไม่ Boost)
+  const int32_t *drive_bonus;    // พลังที่ได้จากทริกเกอร์ตอน Drive Check (0 = ไม่มี)
+  const int32_t *defender_power; // พลังของยูนิตที่ถูกโจมตี
+  const int32_t *shield;         // shield รวมใน Guardian Zone
+  const int32_t *critical;       // จำนวน Damage Check เมื่อโจมตีเข้า
+  size_t count;
+};
+
+// เขียนผลของแต่ละแบบ: hit[i] = 1 ถ้าโจมตีเข้า (0 = ไม่เข้า), damage[i] = critical[i] ถ้าเข้า (0 = ไม่เข้า)
+// hit และ damage ต้องมีที่อย่างน้อย count ช่อง - คืนค่าจำนวนแบบที่โจมตีเข้า
+size_t resolveBattles(const BattleLines &lines, uint8_t *hit, int32_t *damage);
+
+#endif // BATTLERESOLVER_H
@@ -1,5 +1,7 @@
 // Card.cpp - ไฟล์ Source สำหรับการดำเนินการของคลาส Card
 #include "Card.h"
+#include "../UI System/OutputSink.h"
+#include <utility>
 
 // Constructor - สร้างออบเจ็กต์การ์ดใหม่
 // รับพารามิเตอร์ทั้งหมดที่จำเป็นสำหรับการสร้างการ์ด
@@ -11,13 +13,29 @@ Card::Card(const std::string &code_name,
            int shield,
            const std::string &skill_description,
            const std::string &type_role,
-           int critical)
-    : code_name(code_name), name(name), grade(grade), power(power),
-      shield(shield), skill_description(skill_description), type_role(type_role),
+           int critical,
+           const allocator_type &alloc)
+    : code_name(code_name, alloc), name(name, alloc), grade(grade), power(power),
+      shield(shield), skill_description(skill_description, alloc), type_role(type_role, alloc),
       critical(critical)
 {
 }
 
+Card::Card(const Card &other, const allocator_type &alloc)
+    : code_name(other.code_name, alloc), name(other.name, alloc), grade(other.grade), power(other.power),
+      shield(other.shield), skill_description(other.skill_description, alloc), type_role(other.type_role, alloc),
+      critical(other.critical)
+{
+}
+
+// ย้ายข้อความมาได้เลยถ้า alloc ตรงกับของเดิม ไม่เช่นนั้นจะคัดลอกลงใน alloc
+Card::Card(Card &&other, const allocator_type &alloc)
+    : code_name(std::move(other.code_name), alloc), name(std::move(other.name), alloc), grade(other.grade),
+      power(other.power), shield(other.shield), skill_description(std::move(other.skill_description), alloc),
+      type_role(std::move(other.type_role), alloc), critical(other.critical)
+{
+}
+
 // Destructor - ทำความสะอาดหน่วยความจำเมื่อออบเจ็กต์ถูกทำลาย
 Card::~Card()
 {
@@ -28,13 +46,13 @@ Card::~Card()
 // ดึงรหัสการ์ด
 std::string Card::getCodeName() const
 {
-  return code_name;
+  return std::string(code_name.data(), code_name.size());
 }
 
 // ดึงชื่อการ์ด
 std::string Card::getName() const
 {
-  return name;
+  return std::string(name.data(), name.size());
 }
 
 // ดึงเกรดของการ์ด
@@ -58,13 +76,13 @@ int Card::getShield() const
 // ดึงคำอธิบายความสามารถพิเศษ
 std::string Card::getSkillDescription() const
 {
-  return skill_description;
+  return std::string(skill_description.data(), skill_description.size());
 }
 
 // ดึงประเภทของการ์ด
 std::string Card::getTypeRole() const
 {
-  return type_role;
+  return std::string(type_role.data(), type_role.size());
 }
 
 // ดึงค่าคริติคอล
@@ -73,17 +91,37 @@ int Card::getCritical() const
   return critical;
 }
 
+std::string_view Card::getCodeNameView() const
+{
+  return code_name;
+}
+
+std::string_view Card::getNameView() const
+{
+  return name;
+}
+
+std::string_view Card::getSkillDescriptionView() const
+{
+  return skill_description;
+}
+
+std::string_view Card::getTypeRoleView() const
+{
+  return type_role;
+}
+
 // แสดงข้อมูลการ์ดทั้งหมดในรูปแบบที่อ่านง่าย
 // แสดงผลทางหน้าจอโดยใช้เส้นขีดเป็นกรอบ
 void Card::displayInfo() const
 {
-  std::cout << "------------------------------------" << std::endl;
-  std::cout << "รหัสการ์ด: " << code_name << std::endl;
-  std::cout << "ชื่อการ์ด: " << name << " (G" << grade << ")" << std::endl;
-  std::cout << "ประเภท/บทบาท: " << type_role << std::endl;
-  std::cout << "พลัง: " << power << " / โล่ห์: " << shield << " / คริติคอล: " << critical << std::endl;
-  std::cout << "สกิล: " << skill_description << std::endl;
-  std::cout << "------------------------------------" << std::endl;
+  Out() << "------------------------------------" << std::endl;
+  Out() << "รหัสการ์ด: " << code_name << std::endl;
+  Out() << "ชื่อการ์ด: " << name << " (G" << grade << ")" << std::endl;
+  Out() << "ประเภท/บทบาท: " << type_role << std::endl;
+  Out() << "พลัง: " << power << " / โล่ห์: " << shield << " / คริติคอล: " << critical << std::endl;
+  Out() << "สกิล: " << skill_description << std::endl;
+  Out() << "------------------------------------" << std::endl;
 }
 
 // โอเวอร์โหลดตัวดำเนินการ << สำหรับแสดงข้อมูลการ์ดแบบย่อ
@@ -3,21 +3,27 @@
 #define CARD_H
 
 #include <string>
+#include <string_view>
 #include <iostream>
+#include <memory_resource>
 
 // คลาส Card - เป็นคลาสที่ใช้เก็บข้อมูลการ์ดแต่ละใบในเกม
+// ข้อความของการ์ดจองจาก memory resource ที่กำหนด การ์ดในโซนของแมตช์จึงอยู่ใน arena เดียวกับแมตช์
 class Card
 {
+public:
+  using allocator_type = std::pmr::polymorphic_allocator<char>; // ให้ std::pmr::vector<Card> ส่ง allocator ต่อมาที่การ์ด
+
 private:
   // ตัวแปรสมาชิกสำหรับเก็บคุณสมบัติต่างๆ ของการ์ด
-  std::string code_name;         // รหัสการ์ด
-  std::string name;              // ชื่อการ์ด
-  int grade;                     // เกรดของการ์ด
-  int power;                     // ค่าพลังโจมตี
-  int shield;                    // ค่าการป้องกัน
-  std::string skill_description; // คำอธิบายความสามารถพิเศษ
-  std::string type_role;         // ประเภทของการ์ด
-  int critical;                  // ค่าโจมตีคริติคอล
+  std::pmr::string code_name;         // รหัสการ์ด
+  std::pmr::string name;              // ชื่อการ์ด
+  int grade;                          // เกรดของการ์ด
+  int power;                          // ค่าพลังโจมตี
+  int shield;                         // ค่าการป้องกัน
+  std::pmr::string skill_description; // คำอธิบายความสามารถพิเศษ
+  std::pmr::string type_role;         // ประเภทของการ์ด
+  int critical;                       // ค่าโจมตีคริติคอล
 
 public:
   // Constructor - สร้างการ์ดใหม่พร้อมกำหนดค่าเริ่มต้น
@@ -28,7 +34,17 @@ public:
        int shield,
        const std::string &skill_description,
        const std::string &type_role,
-       int critical);
+       int critical,
+       const allocator_type &alloc = {});
+
+  // สำเนาการ์ดที่จองข้อความจาก alloc (ใช้โดย std::pmr::vector<Card> และช่องวางการ์ดของ Player)
+  Card(const Card &other, const allocator_type &alloc);
+  Card(Card &&other, const allocator_type &alloc);
+
+  Card(const Card &other) = default;
+  Card(Card &&other) = default;
+  Card &operator=(const Card &other) = default;
+  Card &operator=(Card &&other) = default;
 
   // Destructor - ทำลายออบเจ็กต์การ์ดเมื่อไม่ได้ใช้งาน
   ~Card();
@@ -43,6 +59,12 @@ public:
   std::string getTypeRole() const;         // ดึงประเภทการ์ด
   int getCritical() const;                 // ดึงค่าคริติคอล
 
+  // ดูข้อความของการ์ดโดยไม่คัดลอก (ใช้ได้ตราบที่การ์ดใบนี้ยังอยู่)
+  std::string_view getCodeNameView() const;
+  std::string_view getNameView() const;
+  std::string_view getSkillDescriptionView() const;
+  std::string_view getTypeRoleView() const;
+
   // แสดงข้อมูลการ์ดทั้งหมด
   void displayInfo() const;
 
@@ -0,0 +1,106 @@
+// CardDatabase.cpp - ไฟล์ Source สำหรับโหลดฐานข้อมูลการ์ดและสูตรเด็คมาตรฐาน
+#include "CardDatabase.h"
+#include "StateHash.h"
+#include "AllocationProfile.h"
+#include <fstream> // สำหรับอ่านไฟล์
+#include "../UI System/UIHelper.h"
+#include "../Library/json.hpp" // สำหรับอ่านไฟล์ JSON
+
+using json = nlohmann::json;
+using namespace std;
+
+const char *const STARTER_CODE_NAME = "G0-01";
+
+// โหลดข้อมูลการ์ดจากไฟล์ JSON
+// filename: ชื่อไฟล์ที่จะโหลด
+// คืนค่า: vector ของการ์ดทั้งหมดที่โหลดได้
+vector<Card> loadCardsFromJson(const string &filename)
+{
+  ALLOC_SCOPE(Loader);
+  vector<Card> all_cards;
+
+  // พยายามเปิดไฟล์
+  ifstream file_stream(filename);
+  if (!file_stream.is_open())
+  {
+    UIHelper::PrintError("เปิดไฟล์ JSON '" + filename + "' ไม่ได้");
+    return all_cards;
+  }
+
+  // พยายามแปลง JSON
+  json card_data_json;
+  try
+  {
+    file_stream >> card_data_json;
+  }
+  catch (json::parse_error &e)
+  {
+    UIHelper::PrintError("Parse JSON ผิดพลาด: " + string(e.what()));
+    file_stream.close();
+    return all_cards;
+  }
+  file_stream.close();
+
+  // ตรวจสอบรูปแบบข้อมูล JSON
+  if (!card_data_json.is_array())
+  {
+    UIHelper::PrintError("ข้อมูล JSON ไม่ได้อยู่ในรูปแบบ Array");
+    return all_cards;
+  }
+
+  // แปลงข้อมูล JSON เป็นออบเจ็กต์การ์ด
+  for (const auto &obj : card_data_json)
+  {
+    try
+    {
+      all_cards.emplace_back(
+          obj.value("code_name", "N/A"),      // รหัสการ์ด
+          obj.value("name", "Unknown"),       // ชื่อการ์ด
+          obj.value("grade", -1),             // เกรด
+          obj.value("power", 0),              // พลังโจมตี
+          obj.value("shield", 0),             // ค่าป้องกัน
+          obj.value("skill_description", ""), // คำอธิบายสกิล
+          obj.value("type_role", "Unknown"),  // ประเภท/บทบาท
+          obj.value("critical", 1)            // ค่าคริติคอล
+      );
+    }
+    catch (json::type_error &e)
+    {
+      UIHelper::PrintWarning("Type error ขณะอ่าน JSON object: " + string(e.what()));
+    }
+  }
+
+  UIHelper::PrintSuccess("โหลดข้อมูลการ์ด " + to_string(all_cards.size()) + " ใบเรียบร้อย");
+  return all_cards;
+}
+
+const map<string, int> &getStandardDeckRecipe()
+{
+  ALLOC_SCOPE(Loader);
+  static const map<string, int> deck_recipe_v1_3 = {
+      {"G0-01", 1}, {"G0-02", 4}, {"G0-03", 4}, {"G0-04", 8}, {"G1-01", 3}, {"G1-02", 4}, {"G1-03", 3}, {"G1-04", 2}, {"G1-05", 1}, {"G2-01", 3}, {"G2-02", 3}, {"G2-03", 3}, {"G2-04", 2}, {"G3-01", 2}, {"G3-02", 2}, {"G3-03", 2}, {"G3-04", 2}, {"G4-01", 1}};
+  return deck_recipe_v1_3;
+}
+
+uint64_t catalogChecksum(const vector<Card> &catalog)
+{
+  StateHash hash;
+  hash.addInt(static_cast<int64_t>(catalog.size()));
+  for (const Card &card : catalog)
+  {
+    hash.addString(card.getCodeName());
+    hash.addString(card.getName());
+    hash.addInt(card.getGrade());
+    hash.addInt(card.getPower());
+    hash.addInt(card.getShield());
+    hash.addString(card.getSkillDescription());
+    hash.addString(card.getTypeRole());
+    hash.addInt(card.getCritical());
+  }
+  for (const auto &entry : getStandardDeckRecipe())
+  {
+    hash.addString(entry.first);
+    hash.addInt(entry.second);
+  }
+  return hash.get();
+}
@@ -0,0 +1,27 @@
+// CardDatabase.h - ไฟล์ Header สำหรับโหลดฐานข้อมูลการ์ดและสูตรเด็คมาตรฐาน
+// ใช้ร่วมกันระหว่างเกมบนคอนโซล เซิร์ฟเวอร์ และเครื่องมืออื่นๆ ที่ต้องสร้างเด็คแบบเดียวกัน
+#ifndef CARDDATABASE_H
+#define CARDDATABASE_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include <cstdint>
+#include "Card.h"
+
+// รหัสการ์ด starter ที่วางบน Vanguard Circle ตอนเริ่มเกม
+extern const char *const STARTER_CODE_NAME;
+
+// โหลดข้อมูลการ์ดจากไฟล์ JSON
+// filename: ชื่อไฟล์ที่จะโหลด
+// คืนค่า: vector ของการ์ดทั้งหมดที่โหลดได้ (ว่างถ้าโหลดไม่สำเร็จ)
+std::vector<Card> loadCardsFromJson(const std::string &filename);
+
+// สูตรเด็คมาตรฐาน v1.3 (รหัสการ์ด -> จำนวนใบ)
+const std::map<std::string, int> &getStandardDeckRecipe();
+
+// checksum ของแคตตาล็อกการ์ด (ข้อมูลทุกช่องตามลำดับ) รวมกับสูตรเด็คมาตรฐาน
+// 2 เครื่องที่ได้ค่าเท่ากันจะสร้างเด็คและเดินเกมด้วยข้อมูลการ์ดชุดเดียวกัน
+uint64_t catalogChecksum(const std::vector<Card> &catalog);
+
+#endif // CARDDATABASE_H
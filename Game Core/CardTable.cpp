@@ -0,0 +1,211 @@
+// CardTable.cpp - ไฟล์ Source สำหรับตารางคุณสมบัติของการ์ดแบบแยกคอลัมน์และการรวมค่าตามรายการ CardId
+#include "CardTable.h"
+#include "SimdDispatch.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// แฮชของรหัสการ์ด: รหัสส่วนใหญ่ยาวไม่เกิน 8 ไบต์ จึงอ่านทั้งก้อนเป็นตัวเลขเดียวแล้วผสมบิต
+// (เร็วกว่าวนทีละไบต์ และไม่ขึ้นกับ std::hash ของไลบรารี)
+static uint32_t hashCode(std::string_view code_name)
+{
+  uint64_t word = code_name.size();
+  for (size_t offset = 0; offset < code_name.size(); offset += sizeof(uint64_t))
+  {
+    uint64_t chunk = 0;
+    std::memcpy(&chunk, code_name.data() + offset, std::min(sizeof(uint64_t), code_name.size() - offset));
+    word = (word ^ chunk) * 0x9E3779B97F4A7C15ull;
+  }
+  return static_cast<uint32_t>(word >> 32);
+}
+
+int32_t cardRoleFlags(std::string_view type_role)
+{
+  int32_t flags = 0;
+  if (type_role.find("Trigger") != std::string_view::npos)
+  {
+    flags |= ROLE_TRIGGER;
+  }
+  if (type_role == "Trigger - Critical")
+  {
+    flags |= ROLE_CRITICAL_TRIGGER;
+  }
+  else if (type_role == "Trigger - Draw")
+  {
+    flags |= ROLE_DRAW_TRIGGER;
+  }
+  else if (type_role == "Trigger - Heal")
+  {
+    flags |= ROLE_HEAL_TRIGGER;
+  }
+  if (type_role.find("Sentinel") != std::string_view::npos)
+  {
+    flags |= ROLE_SENTINEL;
+  }
+  if (type_role.find("Perfect Guard") != std::string_view::npos)
+  {
+    flags |= ROLE_PERFECT_GUARD;
+  }
+  if (type_role == "Starter")
+  {
+    flags |= ROLE_STARTER;
+  }
+  if (type_role == "Booster")
+  {
+    flags |= ROLE_BOOSTER;
+  }
+  return flags;
+}
+
+CardTable::CardTable(std::vector<Card> catalog) : cards(std::move(catalog)), slot_mask(0)
+{
+  if (cards.size() >= INVALID_CARD_ID)
+  {
+    throw std::length_error("CardTable: catalog too large");
+  }
+  grades.reserve(cards.size());
+  powers.reserve(cards.size());
+  shields.reserve(cards.size());
+  criticals.reserve(cards.size());
+  roles.reserve(cards.size());
+  for (const Card &card : cards)
+  {
+    grades.push_back(card.getGrade());
+    powers.push_back(card.getPower());
+    shields.push_back(card.getShield());
+    criticals.push_back(card.getCritical());
+    roles.push_back(cardRoleFlags(card.getTypeRoleView()));
+  }
+
+  // ตารางมีช่องอย่างน้อย 2 เท่าของจำนวนการ์ด การค้นหาส่วนใหญ่จึงจบในช่องแรก
+  size_t capacity = 16;
+  while (capacity < cards.size() * 2)
+  {
+    capacity *= 2;
+  }
+  slots.assign(capacity, -1);
+  slot_mask = static_cast<uint32_t>(capacity - 1);
+  for (size_t i = 0; i < cards.size(); ++i)
+  {
+    std::string_view code_name = cards[i].getCodeNameView();
+    if (findId(code_name) != INVALID_CARD_ID)
+    {
+      continue; // รหัสซ้ำในแคตตาล็อก: ใช้ใบแรก
+    }
+    uint32_t slot = hashCode(code_name) & slot_mask;
+    while (slots[slot] >= 0)
+    {
+      slot = (slot + 1) & slot_mask;
+    }
+    slots[slot] = static_cast<int32_t>(i);
+  }
+}
+
+CardId CardTable::findId(std::string_view code_name) const
+{
+  for (uint32_t slot = hashCode(code_name) & slot_mask;; slot = (slot + 1) & slot_mask)
+  {
+    int32_t index = slots[slot];
+    if (index < 0)
+    {
+      return INVALID_CARD_ID;
+    }
+    if (cards[static_cast<size_t>(index)].getCodeNameView() == code_name)
+    {
+      return static_cast<CardId>(index);
+    }
+  }
+}
+
+// --- การรวมค่าตามรายการ CardId ---
+
+static int gatherSumScalar(const int32_t *column, const CardId *ids, size_t count)
+{
+  int total = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    total += column[ids[i]];
+  }
+  return total;
+}
+
+static size_t gatherCountScalar(const int32_t *column, const CardId *ids, size_t count, int32_t mask)
+{
+  size_t matched = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    matched += (column[ids[i]] & mask) != 0;
+  }
+  return matched;
+}
+
+#if SIMD_HAS_AVX2_DISPATCH
+// บวก 8 ช่องของ vector เข้าด้วยกัน
+SIMD_TARGET_AVX2 static int horizontalSum(__m256i values)
+{
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1));
+  sum = _mm_hadd_epi32(sum, sum);
+  sum = _mm_hadd_epi32(sum, sum);
+  return _mm_cvtsi128_si32(sum);
+}
+
+// อ่าน CardId ครั้งละ 8 ตัว (16 บิต) ขยายเป็นดัชนี 32 บิต แล้ว gather ค่าจากคอลัมน์
+SIMD_TARGET_AVX2 static __m256i gatherEight(const int32_t *column, const CardId *ids)
+{
+  __m256i index = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ids)));
+  return _mm256_i32gather_epi32(column, index, sizeof(int32_t));
+}
+
+SIMD_TARGET_AVX2 static int gatherSumAvx2(const int32_t *column, const CardId *ids, size_t count)
+{
+  __m256i total = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    total = _mm256_add_epi32(total, gatherEight(column, ids + i));
+  }
+  return horizontalSum(total) + gatherSumScalar(column, ids + i, count - i);
+}
+
+SIMD_TARGET_AVX2 static size_t gatherCountAvx2(const int32_t *column, const CardId *ids, size_t count, int32_t mask)
+{
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i role_mask = _mm256_set1_epi32(mask);
+  __m256i misses = _mm256_setzero_si256(); // ช่องละ -1 ต่อการ์ดที่ไม่ตรง
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256i flags = _mm256_and_si256(gatherEight(column, ids + i), role_mask);
+    misses = _mm256_add_epi32(misses, _mm256_cmpeq_epi32(flags, zero));
+  }
+  size_t matched = i - static_cast<size_t>(-horizontalSum(misses));
+  return matched + gatherCountScalar(column, ids + i, count - i, mask);
+}
+#endif
+
+static int gatherSum(const int32_t *column, const CardId *ids, size_t count)
+{
+#if SIMD_HAS_AVX2_DISPATCH
+  if (count >= 8 && cpuHasAvx2())
+  {
+    return gatherSumAvx2(column, ids, count);
+  }
+#endif
+  return gatherSumScalar(column, ids, count);
+}
+
+int CardTable::sumGrade(const CardId *ids, size_t count) const { return gatherSum(grades.data(), ids, count); }
+int CardTable::sumPower(const CardId *ids, size_t count) const { return gatherSum(powers.data(), ids, count); }
+int CardTable::sumShield(const CardId *ids, size_t count) const { return gatherSum(shields.data(), ids, count); }
+int CardTable::sumCritical(const CardId *ids, size_t count) const { return gatherSum(criticals.data(), ids, count); }
+
+size_t CardTable::countByRole(const CardId *ids, size_t count, int32_t role_mask) const
+{
+#if SIMD_HAS_AVX2_DISPATCH
+  if (count >= 8 && cpuHasAvx2())
+  {
+    return gatherCountAvx2(roles.data(), ids, count, role_mask);
+  }
+#endif
+  return gatherCountScalar(roles.data(), ids, count, role_mask);
+}
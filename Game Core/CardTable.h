@@ -0,0 +1,107 @@
+// CardTable.h - ไฟล์ Header สำหรับตารางคุณสมบัติตัวเลขของการ์ดในแคตตาล็อกแบบแยกคอลัมน์ (struct-of-arrays)
+// Card เก็บตัวเลขสลับกับข้อความหลายก้อน การรวม shield/power ทีละใบจึงอ่านหน่วยความจำทิ้งเกือบทั้งหมด
+// ตารางนี้เก็บเกรด พลัง shield คริติคอล และบทบาทของการ์ดแต่ละใบเป็นคอลัมน์ int32_t ติดกัน
+// แล้วอ้างการ์ดด้วย CardId (ลำดับในแคตตาล็อก) ผู้ประเมินที่ลองตัวเลือก Guard/โจมตีหลายแบบต่อโหนด
+// แปลงโซนเป็นรายการ CardId ครั้งเดียว แล้วรวมค่าด้วยฟังก์ชันด้านล่างได้หลายรอบ (ใช้ AVX2 gather เมื่อ CPU รองรับ)
+// Deck ก็สร้างตารางของการ์ดในสูตรไว้ 1 ตาราง โซนของ Player จึงเก็บแค่ CardId แล้วอ่านการ์ดจาก getCard()
+#ifndef CARDTABLE_H
+#define CARDTABLE_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include "Card.h"
+
+using CardId = uint16_t;                      // ลำดับของการ์ดในแคตตาล็อกที่สร้างตาราง
+static const CardId INVALID_CARD_ID = 0xFFFF; // ไม่มีการ์ดรหัสนี้ในแคตตาล็อก
+
+// บทบาทของการ์ด (บิตรวมกันได้) แปลงจากข้อความ type_role ตอนสร้างตาราง
+enum CardRole : int32_t
+{
+  ROLE_TRIGGER = 1 << 0,          // การ์ดทริกเกอร์ทุกชนิด
+  ROLE_CRITICAL_TRIGGER = 1 << 1, // "Trigger - Critical"
+  ROLE_DRAW_TRIGGER = 1 << 2,     // "Trigger - Draw"
+  ROLE_HEAL_TRIGGER = 1 << 3,     // "Trigger - Heal"
+  ROLE_SENTINEL = 1 << 4,         // มีคำว่า "Sentinel"
+  ROLE_PERFECT_GUARD = 1 << 5,    // มีคำว่า "Perfect Guard"
+  ROLE_STARTER = 1 << 6,          // "Starter"
+  ROLE_BOOSTER = 1 << 7,          // "Booster"
+};
+
+// บิตบทบาทของข้อความ type_role หนึ่งค่า
+int32_t cardRoleFlags(std::string_view type_role);
+
+class CardTable
+{
+private:
+  std::vector<int32_t> grades;
+  std::vector<int32_t> powers;
+  std::vector<int32_t> shields;
+  std::vector<int32_t> criticals;
+  std::vector<int32_t> roles;
+  std::vector<Card> cards;    // การ์ดตามลำดับ CardId (ใช้แสดงผลและค้นด้วยรหัสการ์ด)
+  std::vector<int32_t> slots; // ตารางแฮชแบบ open addressing: รหัสการ์ด -> CardId (-1 = ว่าง)
+  uint32_t slot_mask;
+
+public:
+  // แคตตาล็อกต้องมีไม่เกิน INVALID_CARD_ID ใบ (เกินจะ throw std::length_error)
+  explicit CardTable(std::vector<Card> catalog);
+
+  size_t size() const { return cards.size(); }
+
+  // การ์ดของ CardId (id ต้องน้อยกว่า size())
+  const Card &getCard(CardId id) const { return cards[id]; }
+
+  // CardId ของรหัสการ์ด (INVALID_CARD_ID = ไม่มี, รหัสซ้ำในแคตตาล็อกได้ใบแรก)
+  CardId findId(std::string_view code_name) const;
+
+  // เขียน CardId ของการ์ดทุกใบใน cards ลงใน out ตามลำดับ ข้ามใบที่ไม่อยู่ในแคตตาล็อก
+  // out ต้องมีที่อย่างน้อย cards.size() ช่อง - คืนค่าจำนวนที่เขียน
+  template <typename CardList>
+  size_t collectIds(const CardList &cards, CardId *out) const
+  {
+    size_t count = 0;
+    for (const Card &card : cards)
+    {
+      CardId id = findId(card.getCodeNameView());
+      if (id != INVALID_CARD_ID)
+      {
+        out[count++] = id;
+      }
+    }
+    return count;
+  }
+
+  // คอลัมน์ทั้งคอลัมน์ (ยาว size() ช่อง เรียงตาม CardId)
+  const int32_t *gradeColumn() const { return grades.data(); }
+  const int32_t *powerColumn() const { return powers.data(); }
+  const int32_t *shieldColumn() const { return shields.data(); }
+  const int32_t *criticalColumn() const { return criticals.data(); }
+  const int32_t *roleColumn() const { return roles.data(); }
+
+  int getGrade(CardId id) const { return grades[id]; }
+  int getPower(CardId id) const { return powers[id]; }
+  int getShield(CardId id) const { return shields[id]; }
+  int getCritical(CardId id) const { return criticals[id]; }
+  int32_t getRoles(CardId id) const { return roles[id]; }
+
+  // ผลรวมของคอลัมน์ตาม ids (ใบซ้ำนับซ้ำ) - ทุก id ต้องน้อยกว่า size()
+  int sumGrade(const CardId *ids, size_t count) const;
+  int sumPower(const CardId *ids, size_t count) const;
+  int sumShield(const CardId *ids, size_t count) const;
+  int sumCritical(const CardId *ids, size_t count) const;
+
+  // จำนวนใน ids ที่มีบทบาทตรงกับ role_mask อย่างน้อย 1 บิต
+  size_t countByRole(const CardId *ids, size_t count, int32_t role_mask) const;
+
+  int sumShield(const std::vector<CardId> &ids) const { return sumShield(ids.data(), ids.size()); }
+  int sumPower(const std::vector<CardId> &ids) const { return sumPower(ids.data(), ids.size()); }
+  size_t countByRole(const std::vector<CardId> &ids, int32_t role_mask) const
+  {
+    return countByRole(ids.data(), ids.size(), role_mask);
+  }
+};
+
+#endif // CARDTABLE_H
@@ -1,17 +1,27 @@
 // Deck.cpp - ไฟล์ Source สำหรับการดำเนินการของคลาส Deck
 #include "Deck.h"
+#include "StateHash.h"
+#include "StateCodec.h"
+#include "Metrics.h"
+#include "AllocationProfile.h"
+#include "../UI System/OutputSink.h"
 #include <iostream>
-#include <algorithm> // สำหรับฟังก์ชัน std::shuffle และ std::find_if
+#include <algorithm> // สำหรับฟังก์ชัน std::swap และ std::find_if
 #include <random>    // สำหรับตัวสร้างเลขสุ่ม (random number generator)
 #include <chrono>    // สำหรับจับเวลาระบบใช้เป็นเมล็ดพันธุ์ในการสุ่ม
+#include <stdexcept> // สำหรับ std::length_error เมื่อสูตรเกิน MAX_CARDS
 
 // Constructor - สร้างสำรับไพ่จากคลังการ์ดและสูตรที่กำหนด
 // all_cards_pool: คลังการ์ดทั้งหมดที่มีในเกม
 // deck_recipe: แผนผังการ์ดที่ต้องการ (รหัสการ์ด -> จำนวนที่ต้องการ)
 Deck::Deck(const std::vector<Card> &all_cards_pool,
-           const std::map<std::string, int> &deck_recipe)
+           const std::map<std::string, int> &deck_recipe,
+           const allocator_type &alloc)
+    : cards(alloc)
 {
+  ALLOC_SCOPE(Deck);
   this->cards.clear(); // ล้างสำรับให้ว่างก่อนเริ่มต้น
+  std::vector<Card> card_kinds;
 
   // วนลูปผ่านทุกคู่ของรหัสการ์ดและจำนวนที่ต้องการจากสูตร
   for (const auto &pair : deck_recipe)
@@ -23,38 +33,75 @@ Deck::Deck(const std::vector<Card> &all_cards_pool,
     auto it_pool = std::find_if(all_cards_pool.begin(), all_cards_pool.end(),
                                 [&code_name_to_find](const Card &card_in_pool)
                                 {
-                                  return card_in_pool.getCodeName() == code_name_to_find;
+                                  return card_in_pool.getCodeNameView() == code_name_to_find;
                                 });
 
     // ถ้าพบการ์ดในคลัง เพิ่มเข้าสำรับตามจำนวนที่ต้องการ
-    if (it_pool != all_cards_pool.end())
+    if (it_pool != all_cards_pool.end() && quantity > 0)
     {
+      // โซนการ์ดของผู้เล่นจุได้ MAX_CARDS ใบ สำรับที่ใหญ่กว่านี้จึงใช้เล่นไม่ได้
+      if (static_cast<size_t>(quantity) > MAX_CARDS - this->cards.size())
+      {
+        throw std::length_error("Deck: recipe exceeds MAX_CARDS");
+      }
+      card_kinds.push_back(*it_pool);
       for (int i = 0; i < quantity; ++i)
       {
         this->cards.push_back(*it_pool);
       }
     }
   }
+  card_table = std::make_shared<const CardTable>(std::move(card_kinds));
+}
+
+Deck::Deck(const Deck &other, const allocator_type &alloc) : cards(other.cards, alloc), card_table(other.card_table)
+{
+}
+
+Deck::Deck(Deck &&other, const allocator_type &alloc)
+    : cards(std::move(other.cards), alloc), card_table(std::move(other.card_table))
+{
 }
 
 // สับการ์ดในสำรับให้สุ่ม โดยใช้เวลาปัจจุบันเป็นเมล็ดพันธุ์
 void Deck::shuffle()
 {
   // สร้างเมล็ดพันธุ์สำหรับการสุ่มจากเวลาระบบ
-  unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-  // สับการ์ดแบบสุ่มด้วยเมล็ดพันธุ์ที่สร้าง
-  std::shuffle(this->cards.begin(), this->cards.end(), std::default_random_engine(seed));
+  uint64_t seed = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+  shuffle(seed);
+}
+
+// สับการ์ดด้วย seed ที่กำหนด
+// std::shuffle และ distribution ของไลบรารีมาตรฐานให้ผลต่างกันในแต่ละคอมไพเลอร์
+// จึงเขียน Fisher-Yates เองบน std::mt19937_64 ซึ่งมาตรฐานกำหนดลำดับตัวเลขไว้ตายตัว
+void Deck::shuffle(uint64_t seed)
+{
+  gameMetrics().shuffles.add();
+  std::mt19937_64 rng(seed);
+  for (size_t remaining = this->cards.size(); remaining > 1; --remaining)
+  {
+    // สุ่มตำแหน่ง 0..remaining-1 แบบไม่ลำเอียง: ทิ้งค่าที่อยู่ในช่วงท้ายที่หารไม่ลงตัว
+    uint64_t bound = remaining;
+    uint64_t limit = UINT64_MAX - UINT64_MAX % bound;
+    uint64_t value;
+    do
+    {
+      value = rng();
+    } while (value >= limit);
+    std::swap(this->cards[remaining - 1], this->cards[static_cast<size_t>(value % bound)]);
+  }
 }
 
 // จั่วการ์ดใบบนสุดของสำรับ
 // คืนค่า: การ์ดที่จั่วได้ หรือ std::nullopt ถ้าไม่มีการ์ดเหลือ
 std::optional<Card> Deck::draw()
 {
+  ALLOC_SCOPE(Deck);
   if (this->cards.empty())
   {
     return std::nullopt;
   }
-  Card drawn_card = this->cards.back();
+  std::optional<Card> drawn_card(std::move(this->cards.back()));
   this->cards.pop_back();
   return drawn_card;
 }
@@ -74,12 +121,14 @@ size_t Deck::getSize() const
 // เพิ่มการ์ดหนึ่งใบไปที่ก้นสำรับ
 void Deck::addCardToBottom(const Card &card)
 {
+  ALLOC_SCOPE(Deck);
   this->cards.insert(this->cards.begin(), card);
 }
 
 // เพิ่มการ์ดหลายใบไปที่ก้นสำรับพร้อมกัน
 void Deck::addCardsToBottom(const std::vector<Card> &cards_to_add)
 {
+  ALLOC_SCOPE(Deck);
   this->cards.insert(this->cards.begin(), cards_to_add.begin(), cards_to_add.end());
 }
 
@@ -87,17 +136,18 @@ void Deck::addCardsToBottom(const std::vector<Card> &cards_to_add)
 // คืนค่า: การ์ดที่ลบออก หรือ std::nullopt ถ้าไม่พบการ์ด
 std::optional<Card> Deck::removeCardByCodeName(const std::string &code_name_to_remove)
 {
+  ALLOC_SCOPE(Deck);
   // ค้นหาการ์ดในสำรับที่มีรหัสตรงกับที่ต้องการ
   auto it = std::find_if(cards.begin(), cards.end(),
                          [&code_name_to_remove](const Card &c)
                          {
-                           return c.getCodeName() == code_name_to_remove;
+                           return c.getCodeNameView() == code_name_to_remove;
                          });
 
   // ถ้าพบการ์ด
   if (it != cards.end())
   {
-    Card found_card = *it;
+    std::optional<Card> found_card(std::move(*it));
     cards.erase(it);   // ลบการ์ดออกจากสำรับ
     return found_card; // ส่งการ์ดที่ลบกลับไป
   }
@@ -109,17 +159,55 @@ std::optional<Card> Deck::removeCardByCodeName(const std::string &code_name_to_r
 // แสดงรายละเอียดการ์ดทั้งหมดในสำรับ (สำหรับการดีบั๊ก)
 void Deck::printDeckContents() const
 {
-  std::cout << "--- รายการการ์ดในเด็ค (" << this->cards.size() << " ใบ) ---" << std::endl;
+  Out() << "--- รายการการ์ดในเด็ค (" << this->cards.size() << " ใบ) ---" << std::endl;
   if (this->cards.empty())
   {
-    std::cout << "(เด็คว่างเปล่า)" << std::endl;
+    Out() << "(เด็คว่างเปล่า)" << std::endl;
   }
   else
   {
     for (const Card &card : this->cards)
     {
-      std::cout << card << std::endl;
+      Out() << card << std::endl;
+    }
+  }
+  Out() << "------------------------------------" << std::endl;
+}
+
+void Deck::hashState(StateHash &hash) const
+{
+  hash.addInt(static_cast<int64_t>(this->cards.size()));
+  for (const Card &card : this->cards)
+  {
+    hash.addCard(card);
+  }
+}
+
+void Deck::dumpState(std::ostream &out) const
+{
+  out << "deck (" << this->cards.size() << "):";
+  for (const Card &card : this->cards)
+  {
+    out << " " << card.getCodeNameView();
+  }
+  out << "\n";
+}
+
+void Deck::saveState(StateEncoder &out) const
+{
+  out.addCards(this->cards);
+}
+
+void Deck::loadState(StateDecoder &in)
+{
+  ALLOC_SCOPE(Deck);
+  in.readCards(this->cards, MAX_CARDS);
+  for (const Card &card : this->cards)
+  {
+    if (card_table->findId(card.getCodeNameView()) == INVALID_CARD_ID)
+    {
+      in.markInvalid(); // ผู้เล่นถือได้เฉพาะการ์ดในตารางของสำรับ
+      return;
     }
   }
-  std::cout << "------------------------------------" << std::endl;
 }
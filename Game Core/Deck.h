@@ -5,36 +5,75 @@
 #include <vector>
 #include <string>
 #include <map>
-#include <optional> // ใช้สำหรับฟังก์ชันที่อาจจะไม่ส่งค่ากลับมา เช่น เมื่อไพ่หมด
-#include "Card.h"   // include คลาส Card ที่ใช้เป็นองค์ประกอบของสำรับ
+#include <cstdint>
+#include <iosfwd>
+#include <memory_resource>
+#include <memory>
+#include <optional>    // ใช้สำหรับฟังก์ชันที่อาจจะไม่ส่งค่ากลับมา เช่น เมื่อไพ่หมด
+#include "Card.h"      // include คลาส Card ที่ใช้เป็นองค์ประกอบของสำรับ
+#include "CardTable.h" // ตารางการ์ดทุกแบบในสำรับ (โซนของผู้เล่นเก็บเป็น CardId ของตารางนี้)
+
+class StateHash;
+class StateEncoder;
+class StateDecoder;
 
 // คลาส Deck - จัดการสำรับไพ่ทั้งหมดของผู้เล่น
 class Deck
 {
+public:
+  static constexpr size_t MAX_CARDS = 50; // จำนวนการ์ดสูงสุดในสำรับ (สูตรมาตรฐานมี 50 ใบพอดี)
+
+  using allocator_type = std::pmr::polymorphic_allocator<Card>; // สำรับของแมตช์ใช้ arena ของแมตช์ (ดู MatchArena.h)
+
 private:
-  std::vector<Card> cards; // เก็บการ์ดทั้งหมดในสำรับในรูปแบบ vector
+  std::pmr::vector<Card> cards; // เก็บการ์ดทั้งหมดในสำรับในรูปแบบ vector
+
+  // การ์ดทุกแบบในสูตร (แบบละ 1 ใบ ตามลำดับรหัสในสูตร) - สร้างครั้งเดียวตอนสร้างสำรับ สำเนาของสำรับใช้ตารางเดียวกัน
+  std::shared_ptr<const CardTable> card_table;
 
 public:
   // Constructor - สร้างสำรับไพ่จากคลังการ์ดและสูตรการ์ดที่กำหนด
   // all_cards_pool: คลังการ์ดทั้งหมดที่มีในเกม
   // deck_recipe: แผนผังการ์ดที่ต้องการใส่ในสำรับ (รหัสการ์ด -> จำนวนที่ต้องการ)
+  // สูตรที่รวมแล้วเกิน MAX_CARDS ใบจะ throw std::length_error
   Deck(const std::vector<Card> &all_cards_pool,
-       const std::map<std::string, int> &deck_recipe);
+       const std::map<std::string, int> &deck_recipe,
+       const allocator_type &alloc = {});
 
-  void shuffle();                         // สับการ์ดในสำรับให้สุ่ม
-  std::optional<Card> draw();             // จั่วการ์ดจากบนสุดของสำรับ (ถ้าไม่มีการ์ดจะคืนค่า empty)
+  // สำเนา/ย้ายสำรับมาไว้ใน alloc (การ์ดทุกใบถูกสร้างใหม่ใน alloc ถ้าต่างจากของเดิม)
+  Deck(const Deck &other, const allocator_type &alloc);
+  Deck(Deck &&other, const allocator_type &alloc);
+
+  Deck(const Deck &other) = default;
+  Deck(Deck &&other) = default;
+  Deck &operator=(const Deck &other) = default;
+  Deck &operator=(Deck &&other) = default;
+
+  void shuffle();                         // สับการ์ดในสำรับให้สุ่ม (seed จากเวลาระบบ)
+  void shuffle(uint64_t seed);            // สับการ์ดด้วย seed ที่กำหนด - seed เดียวกันให้ลำดับเดียวกันทุกเครื่อง
+  std::optional<Card> draw();             // ย้ายการ์ดบนสุดออกจากสำรับ (ถ้าไม่มีการ์ดจะคืนค่า empty)
   bool isEmpty() const;                   // ตรวจสอบว่าสำรับว่างหรือไม่
   size_t getSize() const;                 // ดูจำนวนการ์ดที่เหลือในสำรับ
   void addCardToBottom(const Card &card); // เพิ่มการ์ดไปที่ก้นสำรับ
 
+  // ตารางการ์ดทุกแบบที่สำรับนี้มีได้ - การ์ดทุกใบที่จั่วจากสำรับมี CardId ในตารางนี้
+  const CardTable &getCardTable() const { return *card_table; }
+
   // ลบการ์ดที่ต้องการออกจากสำรับโดยใช้รหัสการ์ด
   // คืนค่าการ์ดที่ลบถ้าพบ หรือ empty ถ้าไม่พบ
+  // การ์ดที่คืนจาก draw() และฟังก์ชันนี้ถูกย้ายออกมา ข้อความยังอยู่ในหน่วยความจำของสำรับ (arena ของแมตช์)
+  // จึงควรย้ายต่อเข้าโซนของผู้เล่นคนเดิม หรือคัดลอกก่อนถ้าต้องเก็บไว้หลังแมตช์จบ
   std::optional<Card> removeCardByCodeName(const std::string &code_name_to_remove);
 
   // เพิ่มการ์ดหลายใบไปที่ก้นสำรับ
   void addCardsToBottom(const std::vector<Card> &cards_to_add);
 
   void printDeckContents() const; // แสดงรายละเอียดการ์ดทั้งหมดในสำรับ (ใช้สำหรับดีบั๊ก)
+
+  void hashState(StateHash &hash) const;   // ป้อนลำดับการ์ดทั้งหมดในสำรับให้ checksum
+  void dumpState(std::ostream &out) const; // เขียนรหัสการ์ดตามลำดับในสำรับ (บนสุดอยู่ท้ายบรรทัด)
+  void saveState(StateEncoder &out) const; // เข้ารหัสการ์ดทั้งหมดตามลำดับ (ใช้ทำ keyframe ของ replay)
+  void loadState(StateDecoder &in);        // แทนที่การ์ดในสำรับด้วยข้อมูลจาก saveState() (การ์ดนอกตารางถือว่าข้อมูลเสีย)
 };
 
 #endif // DECK_H
@@ -0,0 +1,582 @@
+// GameStats.cpp - ไฟล์ Source สำหรับบันทึกสถิติรายเกมและรายเทิร์นในรูปแบบคอลัมน์
+#include "GameStats.h"
+#include "StateCodec.h"
+
+static const char STATS_MAGIC[] = "FIBOCOL";           // 7 ไบต์แรกของไฟล์ (ไม่รวม '\0')
+static const uint8_t STATS_FORMAT_VERSION = 1;         // เปลี่ยนเมื่อรูปแบบไฟล์เปลี่ยน
+static const uint64_t STATS_MAX_BLOCK_SIZE = 1u << 26; // บล็อกที่ใหญ่กว่านี้ถือว่าข้อมูลเสีย
+static const uint8_t STATS_ENCODING_PLAIN = 0;         // zigzag varint ทีละค่า
+static const uint8_t STATS_ENCODING_RLE = 1;           // (zigzag varint ค่า, varint จำนวนซ้ำ) ทีละช่วง
+
+const std::vector<StatsTable> &gameStatsSchema()
+{
+  static const std::vector<StatsTable> schema = {
+      {"games",
+       {{"game", StatsColumnType::Int},
+        {"seed", StatsColumnType::Unsigned},
+        {"first_player", StatsColumnType::Int},
+        {"winner", StatsColumnType::Int},
+        {"end_reason", StatsColumnType::Int},
+        {"turns", StatsColumnType::Int},
+        {"actions", StatsColumnType::Int},
+        {"player0", StatsColumnType::String},
+        {"player1", StatsColumnType::String},
+        {"deck0", StatsColumnType::String},
+        {"deck1", StatsColumnType::String},
+        {"damage0", StatsColumnType::Int},
+        {"damage1", StatsColumnType::Int}}},
+      {"turns",
+       {{"game", StatsColumnType::Int},
+        {"turn", StatsColumnType::Int},
+        {"seat", StatsColumnType::Int},
+        {"turn_player", StatsColumnType::Int},
+        {"damage", StatsColumnType::Int},
+        {"hand", StatsColumnType::Int},
+        {"soul", StatsColumnType::Int},
+        {"deck", StatsColumnType::Int},
+        {"triggers", StatsColumnType::Int},
+        {"vanguard", StatsColumnType::String}}}};
+  return schema;
+}
+
+std::string deckSignature(const std::map<std::string, int> &recipe)
+{
+  std::string signature;
+  for (const auto &entry : recipe)
+  {
+    if (!signature.empty())
+    {
+      signature.push_back(' ');
+    }
+    signature += entry.first + "x" + std::to_string(entry.second);
+  }
+  return signature;
+}
+
+// --- การเข้ารหัส ---
+
+static void putString(std::string &out, const std::string &text)
+{
+  appendVarint(out, text.size());
+  out += text;
+}
+
+static uint64_t zigzag(int64_t value)
+{
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static int64_t unzigzag(uint64_t value)
+{
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// เข้ารหัสคอลัมน์ 1 คอลัมน์ต่อท้าย out: ลองทั้งสองแบบแล้วเลือกแบบที่สั้นกว่า
+// (คอลัมน์อย่าง game, turn, seat ในตาราง turns ซ้ำกันเป็นช่วงยาว RLE จึงเหลือไม่กี่ไบต์)
+static void encodeColumn(const std::vector<int64_t> &values, std::string &out, std::string &scratch)
+{
+  std::string &plain = scratch;
+  plain.clear();
+  for (int64_t value : values)
+  {
+    appendVarint(plain, zigzag(value));
+  }
+
+  size_t plain_size = plain.size();
+  size_t rle_start = out.size() + 1; // เผื่อไบต์การเข้ารหัส
+  out.push_back(static_cast<char>(STATS_ENCODING_RLE));
+  for (size_t i = 0; i < values.size() && out.size() - rle_start < plain_size;)
+  {
+    size_t run = 1;
+    while (i + run < values.size() && values[i + run] == values[i])
+    {
+      run++;
+    }
+    appendVarint(out, zigzag(values[i]));
+    appendVarint(out, run);
+    i += run;
+  }
+
+  if (out.size() - rle_start < plain_size)
+  {
+    std::string rle = out.substr(rle_start);
+    out.resize(rle_start);
+    appendVarint(out, rle.size());
+    out += rle;
+  }
+  else
+  {
+    out.resize(rle_start - 1);
+    out.push_back(static_cast<char>(STATS_ENCODING_PLAIN));
+    appendVarint(out, plain_size);
+    out += plain;
+  }
+}
+
+// --- GameStatsWriter ---
+
+GameStatsWriter::GameStatsWriter() : file(nullptr), next_game(1), rows_written(0), bytes_written(0), failed(false)
+{
+}
+
+GameStatsWriter::~GameStatsWriter()
+{
+  close();
+}
+
+bool GameStatsWriter::open(const std::string &path)
+{
+  close();
+  file = std::fopen(path.c_str(), "wb");
+  if (!file)
+  {
+    return false;
+  }
+  const std::vector<StatsTable> &schema = gameStatsSchema();
+  for (size_t t = 0; t < columns.size(); ++t)
+  {
+    columns[t].assign(schema[t].columns.size(), std::vector<int64_t>());
+  }
+  dictionary.clear();
+  new_words.clear();
+  next_game = 1;
+  rows_written = 0;
+  bytes_written = 0;
+  failed = false;
+
+  block.assign(STATS_MAGIC, sizeof(STATS_MAGIC) - 1);
+  block.push_back(static_cast<char>(STATS_FORMAT_VERSION));
+  appendVarint(block, schema.size());
+  for (const StatsTable &table : schema)
+  {
+    putString(block, table.name);
+    appendVarint(block, table.columns.size());
+    for (const StatsColumn &column : table.columns)
+    {
+      putString(block, column.name);
+      block.push_back(static_cast<char>(column.type));
+    }
+  }
+  write(block);
+  return true;
+}
+
+void GameStatsWriter::close()
+{
+  if (file)
+  {
+    writeBlock(StatsTableId::Games);
+    writeBlock(StatsTableId::Turns);
+    std::fclose(file);
+    file = nullptr;
+  }
+}
+
+void GameStatsWriter::write(const std::string &data)
+{
+  // เขียนทั้งบล็อกในครั้งเดียวแล้ว flush ทันที (เหมือน ReplayWriter)
+  if (std::fwrite(data.data(), 1, data.size(), file) != data.size() || std::fflush(file) != 0)
+  {
+    failed = true;
+  }
+  bytes_written += data.size();
+}
+
+int64_t GameStatsWriter::intern(const std::string &text)
+{
+  auto inserted = dictionary.emplace(text, static_cast<uint32_t>(dictionary.size()));
+  if (inserted.second)
+  {
+    new_words.push_back(text);
+  }
+  return inserted.first->second;
+}
+
+void GameStatsWriter::addRow(StatsTableId table, const int64_t *values, size_t count)
+{
+  if (!file)
+  {
+    return;
+  }
+  std::vector<std::vector<int64_t>> &table_columns = columns[static_cast<size_t>(table)];
+  for (size_t c = 0; c < count; ++c)
+  {
+    table_columns[c].push_back(values[c]);
+  }
+  rows_written++;
+  if (table_columns[0].size() >= STATS_BLOCK_ROWS)
+  {
+    writeBlock(table);
+  }
+}
+
+void GameStatsWriter::writeBlock(StatsTableId table)
+{
+  std::vector<std::vector<int64_t>> &table_columns = columns[static_cast<size_t>(table)];
+  if (!file || table_columns.empty() || table_columns[0].empty())
+  {
+    return;
+  }
+
+  // คำใหม่ในพจนานุกรมไปกับบล็อกที่เขียนก่อน ไม่ว่าจะเป็นของตารางไหน
+  // บล็อกใดๆ จึงอ้างถึงได้เฉพาะคำที่ประกาศในบล็อกนั้นหรือก่อนหน้า
+  std::string body;
+  appendVarint(body, table_columns[0].size());
+  appendVarint(body, new_words.size());
+  for (const std::string &word : new_words)
+  {
+    putString(body, word);
+  }
+  new_words.clear();
+  for (std::vector<int64_t> &values : table_columns)
+  {
+    encodeColumn(values, body, column_data);
+    values.clear();
+  }
+
+  block.clear();
+  block.push_back(static_cast<char>(table));
+  appendVarint(block, body.size());
+  block += body;
+  write(block);
+}
+
+void GameStatsWriter::addGame(const GameStatsRow &row)
+{
+  int64_t values[] = {static_cast<int64_t>(row.game),
+                      static_cast<int64_t>(row.seed),
+                      row.first_player,
+                      row.winner,
+                      static_cast<int64_t>(row.end_reason),
+                      row.turns,
+                      static_cast<int64_t>(row.actions),
+                      intern(row.players[0]),
+                      intern(row.players[1]),
+                      intern(row.decks[0]),
+                      intern(row.decks[1]),
+                      row.damage[0],
+                      row.damage[1]};
+  addRow(StatsTableId::Games, values, sizeof(values) / sizeof(values[0]));
+}
+
+void GameStatsWriter::addTurn(const TurnStatsRow &row)
+{
+  int64_t values[] = {static_cast<int64_t>(row.game),
+                      row.turn,
+                      row.seat,
+                      row.turn_player ? 1 : 0,
+                      row.damage,
+                      row.hand,
+                      row.soul,
+                      row.deck,
+                      row.triggers,
+                      intern(row.vanguard)};
+  addRow(StatsTableId::Turns, values, sizeof(values) / sizeof(values[0]));
+}
+
+// --- GameStatsRecorder ---
+
+GameStatsRecorder::GameStatsRecorder(GameStatsWriter &stats_writer, const ReplayHeader &header)
+    : writer(stats_writer), last_turn_written(0)
+{
+  game.game = writer.allocateGame();
+  game.seed = header.seed;
+  game.first_player = header.first_player;
+  for (size_t i = 0; i < 2; ++i)
+  {
+    game.players[i] = header.player_names[i];
+    game.decks[i] = deckSignature(header.deck_recipes[i]);
+  }
+}
+
+void GameStatsRecorder::recordAction(const GameAction & /*action*/)
+{
+  game.actions++;
+}
+
+void GameStatsRecorder::recordTriggers(int player_idx, int count)
+{
+  triggers[static_cast<size_t>(player_idx)] += count;
+}
+
+void GameStatsRecorder::writeTurn(const Match &match)
+{
+  for (int seat = 0; seat < 2; ++seat)
+  {
+    const Player &player = match.getPlayer(seat);
+    TurnStatsRow row;
+    row.game = game.game;
+    row.turn = match.getTurnCount();
+    row.seat = seat;
+    row.turn_player = seat == match.getCurrentPlayerIndex();
+    row.damage = static_cast<int>(player.getDamageCount());
+    row.hand = static_cast<int>(player.getHandSize());
+    row.soul = static_cast<int>(player.getSoulCount());
+    row.deck = static_cast<int>(player.getDeck().getSize());
+    row.triggers = triggers[static_cast<size_t>(seat)];
+    if (player.getVanguard())
+    {
+      row.vanguard = player.getVanguard()->getCodeName();
+    }
+    writer.addTurn(row);
+  }
+  triggers = {0, 0};
+  last_turn_written = match.getTurnCount();
+}
+
+void GameStatsRecorder::recordTurnEnd(const Match &match)
+{
+  writeTurn(match);
+}
+
+void GameStatsRecorder::recordGameOver(const Match &match)
+{
+  // เกมที่จบกลางเทิร์นยังไม่มีแถวของเทิร์นสุดท้าย
+  if (match.getTurnCount() > last_turn_written)
+  {
+    writeTurn(match);
+  }
+  game.winner = match.getWinnerIndex();
+  game.end_reason = match.getEndReason();
+  game.turns = match.getTurnCount();
+  for (int seat = 0; seat < 2; ++seat)
+  {
+    game.damage[static_cast<size_t>(seat)] = static_cast<int>(match.getPlayer(seat).getDamageCount());
+  }
+  writer.addGame(game);
+}
+
+// --- GameStatsReader ---
+
+// ตัวอ่านไบต์จากบัฟเฟอร์ของบล็อก 1 บล็อก
+namespace
+{
+struct StatsCursor
+{
+  const uint8_t *data;
+  size_t size;
+  size_t pos;
+
+  bool readVarint(uint64_t &value)
+  {
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < size; shift += 7)
+    {
+      uint8_t byte = data[pos++];
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool readString(std::string &text)
+  {
+    uint64_t length;
+    if (!readVarint(length) || length > size - pos)
+    {
+      return false;
+    }
+    text.assign(reinterpret_cast<const char *>(data + pos), static_cast<size_t>(length));
+    pos += static_cast<size_t>(length);
+    return true;
+  }
+};
+} // namespace
+
+static bool readFileVarint(std::FILE *file, uint64_t &value)
+{
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7)
+  {
+    int byte = std::fgetc(file);
+    if (byte == EOF)
+    {
+      return false;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool readFileString(std::FILE *file, std::string &text)
+{
+  uint64_t length;
+  if (!readFileVarint(file, length) || length > 4096)
+  {
+    return false;
+  }
+  text.resize(static_cast<size_t>(length));
+  return length == 0 || std::fread(&text[0], 1, text.size(), file) == text.size();
+}
+
+GameStatsReader::GameStatsReader() : file(nullptr), truncated(false)
+{
+}
+
+GameStatsReader::~GameStatsReader()
+{
+  close();
+}
+
+bool GameStatsReader::open(const std::string &path)
+{
+  close();
+  schema.clear();
+  dictionary.clear();
+  truncated = false;
+  error.clear();
+  file = std::fopen(path.c_str(), "rb");
+  if (!file)
+  {
+    error = "เปิดไฟล์ '" + path + "' ไม่ได้";
+    return false;
+  }
+
+  char magic[sizeof(STATS_MAGIC) - 1];
+  int version = 0;
+  if (std::fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+      std::string(magic, sizeof(magic)) != STATS_MAGIC || (version = std::fgetc(file)) == EOF)
+  {
+    error = "'" + path + "' ไม่ใช่ไฟล์สถิติ";
+    close();
+    return false;
+  }
+  if (version != STATS_FORMAT_VERSION)
+  {
+    error = "ไฟล์สถิติรุ่น " + std::to_string(version) + " ไม่รองรับ";
+    close();
+    return false;
+  }
+
+  uint64_t table_count = 0;
+  bool ok = readFileVarint(file, table_count) && table_count <= 16;
+  for (uint64_t t = 0; ok && t < table_count; ++t)
+  {
+    StatsTable table;
+    uint64_t column_count = 0;
+    ok = readFileString(file, table.name) && readFileVarint(file, column_count) && column_count <= 256;
+    for (uint64_t c = 0; ok && c < column_count; ++c)
+    {
+      StatsColumn column;
+      int type = EOF;
+      ok = readFileString(file, column.name) && (type = std::fgetc(file)) != EOF;
+      column.type = static_cast<StatsColumnType>(type);
+      table.columns.push_back(column);
+    }
+    schema.push_back(table);
+  }
+  if (!ok)
+  {
+    error = "ส่วนหัวของไฟล์สถิติไม่ครบ";
+    close();
+    return false;
+  }
+  return true;
+}
+
+void GameStatsReader::close()
+{
+  if (file)
+  {
+    std::fclose(file);
+    file = nullptr;
+  }
+}
+
+bool GameStatsReader::next(StatsTableId table, StatsBlock &out)
+{
+  while (file)
+  {
+    int tag = std::fgetc(file);
+    if (tag == EOF)
+    {
+      return false;
+    }
+    uint64_t size = 0;
+    if (!readFileVarint(file, size) || size > STATS_MAX_BLOCK_SIZE)
+    {
+      truncated = true;
+      return false;
+    }
+    block.resize(static_cast<size_t>(size));
+    if (size > 0 && std::fread(&block[0], 1, block.size(), file) != block.size())
+    {
+      truncated = true; // บล็อกสุดท้ายเขียนไม่ครบ (เช่น โปรแกรมถูกปิดระหว่างเขียน)
+      return false;
+    }
+    if (static_cast<size_t>(tag) >= schema.size())
+    {
+      error = "พบบล็อกของตารางที่ไม่รู้จัก (" + std::to_string(tag) + ")";
+      return false;
+    }
+
+    // พจนานุกรมต้องอ่านทุกบล็อก แม้เป็นบล็อกของตารางที่ไม่ต้องการ
+    StatsCursor cursor{reinterpret_cast<const uint8_t *>(block.data()), block.size(), 0};
+    uint64_t rows = 0, words = 0;
+    bool ok = cursor.readVarint(rows) && cursor.readVarint(words) && words <= block.size();
+    for (uint64_t w = 0; ok && w < words; ++w)
+    {
+      std::string word;
+      ok = cursor.readString(word);
+      dictionary.push_back(word);
+    }
+    if (!ok)
+    {
+      error = "พจนานุกรมในบล็อกผิดรูปแบบ";
+      return false;
+    }
+    if (tag != static_cast<int>(table))
+    {
+      continue;
+    }
+
+    const std::vector<StatsColumn> &column_types = schema[static_cast<size_t>(tag)].columns;
+    out.table = table;
+    out.rows = static_cast<size_t>(rows);
+    out.columns.resize(column_types.size());
+    for (size_t c = 0; ok && c < column_types.size(); ++c)
+    {
+      std::vector<int64_t> &values = out.columns[c];
+      values.clear();
+      uint64_t encoding = 0, column_size = 0;
+      ok = cursor.pos < cursor.size;
+      if (ok)
+      {
+        encoding = cursor.data[cursor.pos++];
+        ok = cursor.readVarint(column_size) && column_size <= cursor.size - cursor.pos;
+      }
+      StatsCursor column{cursor.data + cursor.pos, static_cast<size_t>(column_size), 0};
+      cursor.pos += static_cast<size_t>(column_size);
+      while (ok && column.pos < column.size && values.size() < out.rows)
+      {
+        uint64_t value = 0, run = 1;
+        ok = column.readVarint(value) &&
+             (encoding == STATS_ENCODING_PLAIN || (encoding == STATS_ENCODING_RLE && column.readVarint(run))) &&
+             run <= out.rows - values.size();
+        values.insert(values.end(), ok ? static_cast<size_t>(run) : 0, unzigzag(value));
+      }
+      ok = ok && values.size() == out.rows;
+      if (ok && column_types[c].type == StatsColumnType::String)
+      {
+        for (int64_t value : values)
+        {
+          ok = ok && value >= 0 && static_cast<size_t>(value) < dictionary.size();
+        }
+      }
+    }
+    if (!ok)
+    {
+      error = "คอลัมน์ในบล็อกผิดรูปแบบ";
+      return false;
+    }
+    return true;
+  }
+  return false;
+}
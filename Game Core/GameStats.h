@@ -0,0 +1,190 @@
+// GameStats.h - ไฟล์ Header สำหรับบันทึกสถิติรายเกมและรายเทิร์นในรูปแบบคอลัมน์ (columnar)
+// แต่ละตารางถูกเก็บเป็นบล็อกละไม่เกิน STATS_BLOCK_ROWS แถว ภายในบล็อกเก็บทีละคอลัมน์
+// คอลัมน์ตัวเลขเข้ารหัสแบบ zigzag varint และเลือก run-length (ค่า, จำนวนซ้ำ) เมื่อได้ขนาดเล็กกว่า
+// คอลัมน์ข้อความ (ชื่อผู้เล่น, เด็ค, รหัสการ์ด) เก็บเป็นหมายเลขในพจนานุกรมของไฟล์แทนข้อความ
+// ตัวอ่านจึงข้ามบล็อกของตารางที่ไม่ต้องการได้ทั้งบล็อก และแปลงเป็น CSV ได้ด้วย fibo_stats_csv
+//
+// รูปแบบไฟล์ (varint = LEB128 ไม่มีเครื่องหมาย, str = varint ความยาว + ข้อความ UTF-8)
+//   ส่วนหัว: "FIBOCOL" u8 รุ่น, varint จำนวนตาราง, (str ชื่อตาราง, varint จำนวนคอลัมน์, (str ชื่อ, u8 ชนิด)...)...
+//   บล็อก:  u8 ตาราง, varint ขนาดบล็อก (ไบต์ที่ตามมา), varint จำนวนแถว,
+//           varint คำใหม่ในพจนานุกรม, str..., แล้วทุกคอลัมน์ตามลำดับ: u8 การเข้ารหัส, varint ขนาด, ข้อมูล
+// พจนานุกรมสะสมต่อกันทั้งไฟล์ (บล็อกหนึ่งอ้างถึงคำที่ประกาศในบล็อกก่อนหน้าได้)
+// บล็อกถูกเขียนลงไฟล์ทีละบล็อกแล้ว flush ถ้าโปรแกรมล่มจะเสียเฉพาะแถวที่ยังอยู่ในบัฟเฟอร์
+#ifndef GAMESTATS_H
+#define GAMESTATS_H
+
+#include <map>
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <unordered_map>
+#include "Replay.h"
+
+// ชนิดของคอลัมน์
+enum class StatsColumnType : uint8_t
+{
+  Int = 0,     // จำนวนเต็มมีเครื่องหมาย 64 บิต
+  String = 1,  // หมายเลขคำในพจนานุกรม
+  Unsigned = 2 // จำนวนเต็มไม่มีเครื่องหมาย 64 บิต (seed) เก็บแบบเดียวกับ Int แต่แสดงผลเป็นค่าบวก
+};
+
+struct StatsColumn
+{
+  std::string name;
+  StatsColumnType type;
+};
+
+struct StatsTable
+{
+  std::string name;
+  std::vector<StatsColumn> columns;
+};
+
+// ตารางในไฟล์สถิติ (ลำดับคอลัมน์ตรงกับ GameStatsRow / TurnStatsRow)
+enum class StatsTableId : uint8_t
+{
+  Games = 0, // 1 แถวต่อเกม
+  Turns = 1  // 2 แถวต่อเทิร์น (ผู้เล่นละแถว)
+};
+
+const std::vector<StatsTable> &gameStatsSchema();
+
+// ผลของเกม 1 เกม
+struct GameStatsRow
+{
+  uint64_t game = 0; // หมายเลขเกมในไฟล์ (เริ่มที่ 1)
+  uint64_t seed = 0;
+  int first_player = 0;
+  int winner = -1;                      // -1 = ไม่มีผู้ชนะ
+  MatchEnd end_reason = MatchEnd::None; // เก็บเป็นค่าตัวเลขของ MatchEnd
+  int turns = 0;
+  uint64_t actions = 0;
+  std::array<std::string, 2> players;
+  std::array<std::string, 2> decks; // สูตรเด็คในรูป "รหัสxจำนวน" คั่นด้วยช่องว่าง
+  std::array<int, 2> damage{};
+};
+
+// สถานะของผู้เล่น 1 คน ณ จบเทิร์น (หรือจุดที่เกมจบ)
+struct TurnStatsRow
+{
+  uint64_t game = 0;
+  int turn = 0;
+  int seat = 0;
+  bool turn_player = false; // ผู้เล่นคนนี้เป็นเจ้าของเทิร์น
+  int damage = 0;
+  int hand = 0;
+  int soul = 0;
+  int deck = 0;     // การ์ดที่เหลือในเด็ค
+  int triggers = 0; // การ์ด Trigger ที่เปิดได้ในเทิร์นนี้ (Drive Check หรือ Damage Check)
+  std::string vanguard;
+};
+
+// ตัวเขียนไฟล์สถิติ - สะสมแถวไว้ทีละคอลัมน์แล้วเขียนเป็นบล็อก
+class GameStatsWriter
+{
+public:
+  static constexpr size_t STATS_BLOCK_ROWS = 8192;
+
+private:
+  std::FILE *file;
+  std::array<std::vector<std::vector<int64_t>>, 2> columns; // [ตาราง][คอลัมน์] -> ค่าของแถวที่ยังไม่ได้เขียน
+  std::unordered_map<std::string, uint32_t> dictionary;
+  std::vector<std::string> new_words; // คำที่ยังไม่ได้เขียนลงไฟล์
+  std::string block;
+  std::string column_data;
+  uint64_t next_game;
+  uint64_t rows_written;
+  uint64_t bytes_written;
+  bool failed;
+
+  int64_t intern(const std::string &text);
+  void addRow(StatsTableId table, const int64_t *values, size_t count);
+  void writeBlock(StatsTableId table);
+  void write(const std::string &data);
+
+public:
+  GameStatsWriter();
+  ~GameStatsWriter();
+  GameStatsWriter(const GameStatsWriter &) = delete;
+  GameStatsWriter &operator=(const GameStatsWriter &) = delete;
+
+  // สร้างไฟล์ใหม่ (เขียนทับไฟล์เดิม) แล้วเขียนส่วนหัว - คืนค่า false ถ้าเปิดไฟล์ไม่ได้
+  bool open(const std::string &path);
+  void close(); // เขียนแถวที่เหลือแล้วปิดไฟล์
+  bool isOpen() const { return file != nullptr; }
+  bool hasFailed() const { return failed; }
+
+  uint64_t allocateGame() { return next_game++; } // หมายเลขเกมถัดไปสำหรับ GameStatsRow::game
+  void addGame(const GameStatsRow &row);
+  void addTurn(const TurnStatsRow &row);
+
+  uint64_t getRowsWritten() const { return rows_written; }
+  uint64_t getBytesWritten() const { return bytes_written; }
+};
+
+// ตัวบันทึกสถิติของแมตช์ 1 แมตช์ - ตั้งให้แมตช์ด้วย Match::setRecorder()
+// (ใช้ร่วมกับ ReplayWriter ผ่าน MatchRecorderGroup)
+class GameStatsRecorder : public MatchRecorder
+{
+private:
+  GameStatsWriter &writer;
+  GameStatsRow game;
+  std::array<int, 2> triggers{}; // Trigger ที่เปิดได้ในเทิร์นปัจจุบัน
+  int last_turn_written;
+
+  void writeTurn(const Match &match);
+
+public:
+  // header: ข้อมูลเดียวกับส่วนหัวของ replay (seed, ผู้เล่นที่เริ่มก่อน, ชื่อ, สูตรเด็ค)
+  GameStatsRecorder(GameStatsWriter &stats_writer, const ReplayHeader &header);
+
+  void recordAction(const GameAction &action) override;
+  void recordTurnEnd(const Match &match) override;
+  void recordGameOver(const Match &match) override;
+  void recordTriggers(int player_idx, int count) override;
+};
+
+// บล็อก 1 บล็อกที่อ่านได้ (ค่าของคอลัมน์ข้อความเป็นหมายเลขใน getDictionary())
+struct StatsBlock
+{
+  StatsTableId table = StatsTableId::Games;
+  size_t rows = 0;
+  std::vector<std::vector<int64_t>> columns;
+};
+
+// ตัวอ่านไฟล์สถิติทีละบล็อก
+class GameStatsReader
+{
+private:
+  std::FILE *file;
+  std::vector<StatsTable> schema;
+  std::vector<std::string> dictionary;
+  std::string block;
+  bool truncated;
+  std::string error;
+
+public:
+  GameStatsReader();
+  ~GameStatsReader();
+  GameStatsReader(const GameStatsReader &) = delete;
+  GameStatsReader &operator=(const GameStatsReader &) = delete;
+
+  bool open(const std::string &path); // อ่านส่วนหัว - คืนค่า false ถ้าไม่ใช่ไฟล์สถิติ (ดู getError())
+  void close();
+
+  // อ่านบล็อกถัดไปของตารางที่กำหนด (บล็อกของตารางอื่นถูกข้ามโดยไม่ถอดรหัสคอลัมน์)
+  // คืนค่า false เมื่อจบไฟล์ บล็อกสุดท้ายเขียนไม่ครบ (isTruncated()) หรือข้อมูลผิดรูปแบบ (getError())
+  bool next(StatsTableId table, StatsBlock &out);
+
+  const std::vector<StatsTable> &getSchema() const { return schema; }
+  const std::vector<std::string> &getDictionary() const { return dictionary; }
+  bool isTruncated() const { return truncated; }
+  const std::string &getError() const { return error; }
+};
+
+// สูตรเด็คในรูปข้อความเดียว (ใช้เป็นค่าของคอลัมน์ deck)
+std::string deckSignature(const std::map<std::string, int> &recipe);
+
+#endif // GAMESTATS_H
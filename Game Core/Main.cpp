@@ -2,7 +2,6 @@
 // รับผิดชอบการทำงานหลักของเกม การโหลดข้อมูล และการควบคุมการเล่น
 
 #include <iostream>
-#include <fstream>  // สำหรับอ่านไฟล์
 #include <vector>   // สำหรับเก็บข้อมูลแบบรายการ
 #include <string>   // สำหรับจัดการข้อความ
 #include <map>      // สำหรับเก็บข้อมูลแบบ key-value
@@ -11,78 +10,45 @@
 #include <iomanip>  // สำหรับจัดรูปแบบการแสดงผล
 #include <thread>   // สำหรับการทำงานแบบหลายเธรด
 #include <chrono>   // สำหรับจับเวลาและหน่วงเวลา
+#include <memory>   // สำหรับ unique_ptr
+#include <sstream>  // สำหรับแยกค่าจากบรรทัดที่รับเข้ามา
+#include <cctype>   // สำหรับตรวจตัวเลขในค่าของตัวเลือก
 #include "Card.h"
 #include "Deck.h"
 #include "Player.h"
+#include "Match.h"
+#include "CardDatabase.h"
+#include "Replay.h"
+#include "GameStats.h"
+#include "Trace.h"
+#include "Metrics.h"
+#include "AllocationProfile.h"
 #include "../UI System/UIHelper.h"
 #include "MenuSystem.h"
-#include "../Library/json.hpp" // สำหรับอ่านไฟล์ JSON
+#include "InputSource.h"
+#include "OutputSink.h"
+#include "KeyboardInput.h"
 
-using json = nlohmann::json;
 using namespace std;
 
 // --- ฟังก์ชันช่วยต่างๆ ---
 
-// โหลดข้อมูลการ์ดจากไฟล์ JSON
-// filename: ชื่อไฟล์ที่จะโหลด
-// คืนค่า: vector ของการ์ดทั้งหมดที่โหลดได้
-vector<Card> loadCardsFromJson(const string &filename)
-{
-  vector<Card> all_cards;
-
-  // พยายามเปิดไฟล์
-  ifstream file_stream(filename);
-  if (!file_stream.is_open())
-  {
-    UIHelper::PrintError("เปิดไฟล์ JSON '" + filename + "' ไม่ได้");
-    return all_cards;
-  }
+// เวลาตัดสินใจของผู้เล่นบนคอนโซล นับจากการกระทำก่อนหน้า (หรือเริ่มแมตช์) จนถึงการกระทำที่แมตช์ยอมรับ
+static string console_player_type = "human"; // "script" เมื่อเล่นด้วย --script
+static chrono::steady_clock::time_point decision_started;
 
-  // พยายามแปลง JSON
-  json card_data_json;
-  try
-  {
-    file_stream >> card_data_json;
-  }
-  catch (json::parse_error &e)
-  {
-    UIHelper::PrintError("Parse JSON ผิดพลาด: " + string(e.what()));
-    file_stream.close();
-    return all_cards;
-  }
-  file_stream.close();
-
-  // ตรวจสอบรูปแบบข้อมูล JSON
-  if (!card_data_json.is_array())
-  {
-    UIHelper::PrintError("ข้อมูล JSON ไม่ได้อยู่ในรูปแบบ Array");
-    return all_cards;
-  }
-
-  // แปลงข้อมูล JSON เป็นออบเจ็กต์การ์ด
-  for (const auto &obj : card_data_json)
+// ส่งการกระทำให้แมตช์ และบันทึกเวลาที่ใช้ตัดสินใจเมื่อแมตช์ยอมรับ
+bool submitDecision(Match &match, const GameAction &action)
+{
+  static MetricHistogram &latency = decisionLatencyMetric(console_player_type);
+  chrono::steady_clock::time_point decided = chrono::steady_clock::now();
+  bool accepted = match.submit(action);
+  if (accepted)
   {
-    try
-    {
-      all_cards.emplace_back(
-          obj.value("code_name", "N/A"),      // รหัสการ์ด
-          obj.value("name", "Unknown"),       // ชื่อการ์ด
-          obj.value("grade", -1),             // เกรด
-          obj.value("power", 0),              // พลังโจมตี
-          obj.value("shield", 0),             // ค่าป้องกัน
-          obj.value("skill_description", ""), // คำอธิบายสกิล
-          obj.value("type_role", "Unknown"),  // ประเภท/บทบาท
-          obj.value("critical", 1)            // ค่าคริติคอล
-      );
-    }
-    catch (json::type_error &e)
-    {
-      UIHelper::PrintWarning("Type error ขณะอ่าน JSON object: " + string(e.what()));
-    }
+    latency.record(static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(decided - decision_started).count()));
+    decision_started = chrono::steady_clock::now(); // ไม่นับเวลาที่แมตช์เดินเกมและแสดงผลหลังรับการกระทำ
   }
-
-  UIHelper::PrintSuccess("โหลดข้อมูลการ์ด " + to_string(all_cards.size()) + " ใบเรียบร้อย");
-  return all_cards;
+  return accepted;
 }
 
 // เลือกเป้าหมายการโจมตีจากฝ่ายตรงข้าม
@@ -96,31 +62,31 @@ int chooseTargetFromOpponent(Player *attacker, Player *defender)
 
   // แสดงสนามของทั้งสองฝ่าย
   attacker->displayField();
-  cout << "\n"
-       << Colors::BRIGHT_RED << "--- สนามของฝ่ายป้องกัน ("
-       << defender->getName() << ") ---" << Colors::RESET << "\n";
+  Out() << "\n"
+        << Colors::BRIGHT_RED << "--- สนามของฝ่ายป้องกัน ("
+        << defender->getName() << ") ---" << Colors::RESET << "\n";
   defender->displayField(true);
 
   // รวบรวมเป้าหมายที่สามารถโจมตีได้
   vector<pair<int, string>> available_targets;
 
   // เพิ่ม Vanguard เป็นเป้าหมาย (ถ้ามี)
-  if (defender->getVanguard().has_value())
+  if (defender->getVanguard())
   {
     available_targets.push_back({UNIT_STATUS_VC_IDX,
-                                 Icons::CROWN + " VC: " + defender->getVanguard().value().getName()});
+                                 UIHelper::Join({Icons::CROWN, " VC: ", defender->getVanguard()->getNameView()})});
   }
 
   // เพิ่ม Rear-guards แถวหน้าเป็นเป้าหมาย
-  const auto &opp_rcs = defender->getRearGuards();
+  const auto opp_rcs = defender->getRearGuards();
   const size_t opp_front_row_rcs_indices[] = {RC_FRONT_LEFT, RC_FRONT_RIGHT};
   for (size_t rc_idx : opp_front_row_rcs_indices)
   {
-    if (opp_rcs[rc_idx].has_value())
+    if (opp_rcs[rc_idx])
     {
       string rc_name = (rc_idx == RC_FRONT_LEFT) ? "FL" : "FR";
       available_targets.push_back({(int)defender->getUnitStatusIndexForRC(rc_idx),
-                                   Icons::SWORD + " RC " + rc_name + ": " + opp_rcs[rc_idx].value().getName()});
+                                   UIHelper::Join({Icons::SWORD, " RC ", rc_name, ": ", opp_rcs[rc_idx]->getNameView()})});
     }
   }
 
@@ -133,11 +99,11 @@ int chooseTargetFromOpponent(Player *attacker, Player *defender)
   }
 
   // แสดงเป้าหมายที่โจมตีได้
-  cout << "\n"
-       << Colors::BRIGHT_YELLOW << Icons::TARGET << " เป้าหมายที่โจมตีได้:" << Colors::RESET << "\n";
+  Out() << "\n"
+        << Colors::BRIGHT_YELLOW << Icons::TARGET << " เป้าหมายที่โจมตีได้:" << Colors::RESET << "\n";
   for (size_t i = 0; i < available_targets.size(); ++i)
   {
-    cout << Colors::CYAN << "[" << i << "] " << Colors::RESET << available_targets[i].second << "\n";
+    Out() << Colors::CYAN << "[" << i << "] " << Colors::RESET << available_targets[i].second << "\n";
   }
 
   // รับค่าการเลือกเป้าหมายจากผู้เล่น
@@ -145,11 +111,140 @@ int chooseTargetFromOpponent(Player *attacker, Player *defender)
   return available_targets[static_cast<size_t>(choice_idx)].first;
 }
 
+// ชื่อการ์ดของยูนิตในตำแหน่งที่ระบุ (ใช้แสดงผลการต่อสู้)
+string_view unitNameAt(const Player &player, int unit_status_idx)
+{
+  const Card *unit = player.getUnitAt(unit_status_idx);
+  return unit ? unit->getNameView() : string_view();
+}
+
+// แสดงเหตุการณ์ของแมตช์บนคอนโซล พร้อมจังหวะหยุดรอผู้เล่นอ่านหน้าจอ
+class ConsoleMatchView : public MatchObserver
+{
+public:
+  void onTurnStart(Player &turn_player, int turn_number) override
+  {
+    MenuSystem::ShowTurnStartScreen(&turn_player, turn_number);
+  }
+
+  void onPhaseTransition(const string &from, const string &to) override
+  {
+    UIHelper::ShowPhaseTransition(from, to);
+  }
+
+  void onDriveCheckBegin(Player &attacker) override
+  {
+    UIHelper::ClearScreen();
+    attacker.displayField();
+  }
+
+  void onDriveCheckEnd(Player &) override
+  {
+    MenuSystem::WaitForKeyPress("กด Enter เพื่อให้ฝ่ายตรงข้ามป้องกัน...");
+  }
+
+  void onAttackPower(Player &attacker, Player &defender, const AttackState &attack) override
+  {
+    UIHelper::PrintBattleStats(unitNameAt(attacker, attack.attacker_idx), attack.power,
+                               attack.critical, unitNameAt(defender, attack.target_idx),
+                               defender.getUnitPowerAtStatusIndex(attack.target_idx, -1, true));
+  }
+
+  void onBattleResult(Player &attacker, Player &defender, const AttackState &attack, int defense_power) override
+  {
+    UIHelper::ClearScreen();
+    UIHelper::PrintBattleStats(unitNameAt(attacker, attack.attacker_idx), attack.power,
+                               attack.critical, unitNameAt(defender, attack.target_idx),
+                               defense_power);
+  }
+
+  void onDamageCheck(Player &defender, int check_number, int total_checks) override
+  {
+    if (check_number == 1)
+    {
+      UIHelper::PrintSectionHeader(defender.getName() + ": DAMAGE CHECK x" + to_string(total_checks),
+                                   Icons::DAMAGE, Colors::BRIGHT_RED);
+    }
+    else
+    {
+      MenuSystem::WaitForKeyPress("กด Enter เพื่อดูดาเมจต่อไป...");
+    }
+    UIHelper::ClearScreen();
+    defender.displayField();
+    Out() << Colors::BRIGHT_RED << "Damage Check ครั้งที่ " << check_number
+          << "/" << total_checks << Colors::RESET << "\n";
+  }
+
+  void onDamageRevealed(Player &, const Card &damage_card) override
+  {
+    Out() << Colors::BRIGHT_CYAN << "เปิดได้: " << Colors::RESET
+          << UIHelper::FormatCard(damage_card.getNameView(), damage_card.getGrade()) << "\n";
+  }
+
+  void onDamageTaken(Player &defender, const TriggerOutput &trigger) override
+  {
+    if (trigger.extra_power > 0)
+    {
+      Out() << Colors::BRIGHT_MAGENTA << "Damage Trigger Effect: +"
+            << trigger.extra_power << " Power!" << Colors::RESET << "\n";
+    }
+    defender.displayField();
+  }
+
+  void onAttackEnd(Player &) override
+  {
+    MenuSystem::WaitForKeyPress("กด Enter เพื่อดำเนินการต่อ...");
+  }
+
+  void onEndPhase(Player &turn_player) override
+  {
+    UIHelper::PrintSectionHeader(turn_player.getName() + ": END PHASE", Icons::PHASE);
+  }
+
+  void onTurnEnd(Player &turn_player) override
+  {
+    UIHelper::PrintInfo("เทิร์นของ " + turn_player.getName() + " สิ้นสุด");
+    MenuSystem::WaitForKeyPress("กด Enter เพื่อให้ผู้เล่นถัดไปเริ่มเทิร์น...");
+  }
+
+  void onGameOver(Match &match) override
+  {
+    if (match.getEndReason() == MatchEnd::TurnLimit)
+    {
+      UIHelper::PrintInfo("จบการจำลอง " + to_string(match.getTurnCount()) + " เทิร์น");
+      return;
+    }
+
+    Player *winner = &match.getPlayer(match.getWinnerIndex());
+    Player *loser = &match.getPlayer(1 - match.getWinnerIndex());
+    switch (match.getEndReason())
+    {
+    case MatchEnd::DrawDeckOut:
+      MenuSystem::ShowGameOverScreen(winner, loser, loser->getName() + " ไม่สามารถจั่วการ์ดได้ (เด็คหมด)");
+      break;
+    case MatchEnd::DamageDeckOut:
+      UIHelper::ClearScreen();
+      MenuSystem::ShowGameOverScreen(winner, loser, loser->getName() + " ไม่สามารถทำ Damage Check ได้ (เด็คหมด)");
+      break;
+    case MatchEnd::DamageLimit:
+      MenuSystem::ShowGameOverScreen(winner, loser, loser->getName() + " ได้รับ " + to_string(Player::MAX_DAMAGE) + " ดาเมจ");
+      break;
+    case MatchEnd::Conceded:
+      MenuSystem::ShowGameOverScreen(winner, loser, loser->getName() + " ยอมแพ้");
+      break;
+    default:
+      MenuSystem::ShowGameOverScreen(winner, loser, "ดาเมจครบ " + to_string(Player::MAX_DAMAGE) + " แต้ม");
+      break;
+    }
+  }
+};
+
 // ดำเนินการใน Ride Phase
-// current_player: ผู้เล่นที่กำลังเล่น
+// match: แมตช์ที่กำลังรอการตัดสินใจใน Main Phase
 // คืนค่า: true ถ้าผู้เล่นต้องการออกจากเกม, false ถ้าไม่ต้องการ
-bool performRidePhase(Player *current_player)
+bool performRidePhase(Match &match)
 {
+  Player *current_player = &match.getPlayer(match.getCurrentPlayerIndex());
   while (true)
   {
     MenuResult ride_result = MenuSystem::ShowRideMenu(current_player);
@@ -172,7 +267,7 @@ bool performRidePhase(Player *current_player)
       return false;
     }
 
-    if (current_player->rideFromHand(static_cast<size_t>(card_idx)))
+    if (submitDecision(match, GameAction::ride(card_idx)))
     {
       UIHelper::PrintSuccess("Ride สำเร็จ!");
       MenuSystem::WaitForKeyPress();
@@ -186,12 +281,13 @@ bool performRidePhase(Player *current_player)
   }
 }
 
-// ดำเนินการใน Main Phase
-// current_player: ผู้เล่นที่กำลังเล่น
+// ดำเนินการใน Main Phase จนกว่าผู้เล่นจะไป Battle Phase
+// match: แมตช์ที่กำลังรอการตัดสินใจใน Main Phase
 // คืนค่า: true ถ้าผู้เล่นต้องการออกจากเกม, false ถ้าไม่ต้องการ
-bool performMainPhase(Player *current_player)
+bool performMainPhase(Match &match)
 {
-  while (true)
+  Player *current_player = &match.getPlayer(match.getCurrentPlayerIndex());
+  while (match.getPendingDecision() == DecisionType::MainPhase)
   {
     MenuResult main_result = MenuSystem::ShowMainPhaseMenu(current_player);
 
@@ -207,7 +303,7 @@ bool performMainPhase(Player *current_player)
 
     if (main_result.selected_key == "1") // Ride
     {
-      if (performRidePhase(current_player))
+      if (performRidePhase(match))
         return true; // Exit game
     }
     else if (main_result.selected_key == "2") // Call
@@ -224,7 +320,7 @@ bool performMainPhase(Player *current_player)
           int card_idx = stoi(call_result.selected_key.substr(0, comma_pos));
           int rc_idx = stoi(call_result.selected_key.substr(comma_pos + 1));
 
-          if (current_player->callToRearGuard(static_cast<size_t>(card_idx), static_cast<size_t>(rc_idx)))
+          if (submitDecision(match, GameAction::call(card_idx, rc_idx)))
           {
             UIHelper::PrintSuccess("Call สำเร็จ!");
           }
@@ -248,7 +344,7 @@ bool performMainPhase(Player *current_player)
     else if (main_result.selected_key == "5") // Go to Battle Phase
     {
       UIHelper::PrintInfo("ไปยัง Battle Phase");
-      return false;
+      submitDecision(match, GameAction::endMain());
     }
     else if (main_result.selected_key == "h") // Help
     {
@@ -260,19 +356,18 @@ bool performMainPhase(Player *current_player)
       continue;
     }
   }
+  return false;
 }
 
-// ดำเนินการใน Battle Phase
-// current_player: ผู้เล่นที่กำลังเล่น
-// opponent_player: ผู้เล่นฝ่ายตรงข้าม
-// game_over: ตัวแปรที่บอกว่าเกมจบหรือไม่
+// ดำเนินการใน Battle Phase จนกว่าจะประกาศโจมตีหรือจบ Battle Phase
+// match: แมตช์ที่กำลังรอการตัดสินใจใน Battle Phase
 // คืนค่า: true ถ้าผู้เล่นต้องการออกจากเกม, false ถ้าไม่ต้องการ
-bool performBattlePhase(Player *current_player, Player *opponent_player, bool &game_over)
+bool performBattlePhase(Match &match)
 {
-  current_player->clearGuardianZoneAndMoveToDrop();
-  opponent_player->clearGuardianZoneAndMoveToDrop();
+  Player *current_player = &match.getPlayer(match.getCurrentPlayerIndex());
+  Player *opponent_player = &match.getPlayer(1 - match.getCurrentPlayerIndex());
 
-  while (true)
+  while (match.getPendingDecision() == DecisionType::BattlePhase)
   {
     MenuResult battle_result = MenuSystem::ShowBattlePhaseMenu(current_player);
 
@@ -299,9 +394,9 @@ bool performBattlePhase(Player *current_player, Player *opponent_player, bool &g
         return true;
 
       int attacker_status_idx = stoi(attacker_result.selected_key);
-      optional<Card> attacker_card_opt = current_player->getUnitAtStatusIndex(attacker_status_idx);
+      const Card *attacker_card = current_player->getUnitAt(attacker_status_idx);
 
-      if (!attacker_card_opt.has_value())
+      if (!attacker_card)
       {
         UIHelper::PrintError("ไม่พบการ์ด Attacker ที่เลือก");
         continue;
@@ -312,8 +407,8 @@ bool performBattlePhase(Player *current_player, Player *opponent_player, bool &g
       if (target_status_idx == -1)
         continue;
 
-      optional<Card> target_card_opt = opponent_player->getUnitAtStatusIndex(target_status_idx);
-      if (!target_card_opt.has_value())
+      const Card *target_card = opponent_player->getUnitAt(target_status_idx);
+      if (!target_card)
       {
         UIHelper::PrintError("ไม่พบเป้าหมายที่เลือก");
         continue;
@@ -321,10 +416,10 @@ bool performBattlePhase(Player *current_player, Player *opponent_player, bool &g
 
       UIHelper::ClearScreen();
       UIHelper::PrintSectionHeader("BATTLE DECLARATION", Icons::SWORD, Colors::BRIGHT_RED);
-      cout << Colors::BRIGHT_CYAN << Icons::SWORD << " Attacker: " << Colors::BOLD
-           << attacker_card_opt.value().getName() << Colors::RESET << "\n";
-      cout << Colors::BRIGHT_YELLOW << Icons::TARGET << " Target: " << Colors::BOLD
-           << target_card_opt.value().getName() << Colors::RESET << "\n\n";
+      Out() << Colors::BRIGHT_CYAN << Icons::SWORD << " Attacker: " << Colors::BOLD
+            << attacker_card->getNameView() << Colors::RESET << "\n";
+      Out() << Colors::BRIGHT_YELLOW << Icons::TARGET << " Target: " << Colors::BOLD
+            << target_card->getNameView() << Colors::RESET << "\n\n";
 
       // Choose booster
       int potential_booster_idx = current_player->chooseBooster(attacker_status_idx);
@@ -335,156 +430,148 @@ bool performBattlePhase(Player *current_player, Player *opponent_player, bool &g
         if (MenuSystem::ShowYesNoPrompt("คุณต้องการ Boost หรือไม่?"))
         {
           booster_status_idx = potential_booster_idx;
-          optional<Card> booster_card_opt = current_player->getUnitAtStatusIndex(booster_status_idx);
-          if (booster_card_opt.has_value())
+          if (const Card *booster_card = current_player->getUnitAt(booster_status_idx))
           {
-            cout << Colors::BRIGHT_GREEN << Icons::MAGIC << " Booster: "
-                 << booster_card_opt.value().getName() << Colors::RESET << "\n";
+            Out() << Colors::BRIGHT_GREEN << Icons::MAGIC << " Booster: "
+                  << booster_card->getNameView() << Colors::RESET << "\n";
           }
         }
       }
 
-      int final_attacker_power = current_player->getUnitPowerAtStatusIndex(attacker_status_idx, booster_status_idx);
-      int final_attacker_crit = attacker_card_opt.value().getCritical();
-      TriggerOutput drive_trigger_effects;
-
-      // Drive Check for VG attack
-      if (attacker_status_idx == UNIT_STATUS_VC_IDX)
+      // แมตช์คำนวณพลัง ทำ Drive Check แล้วรอฝ่ายป้องกัน Guard
+      if (!submitDecision(match, GameAction::attack(attacker_status_idx, target_status_idx, booster_status_idx)))
       {
-        UIHelper::ClearScreen();
-        current_player->displayField();
-        int num_drives = (attacker_card_opt.value().getGrade() >= 3) ? 2 : 1;
-        drive_trigger_effects = current_player->performDriveCheck(num_drives, opponent_player);
-        final_attacker_power += drive_trigger_effects.extra_power;
-        final_attacker_crit += drive_trigger_effects.extra_crit;
-        MenuSystem::WaitForKeyPress("กด Enter เพื่อให้ฝ่ายตรงข้ามป้องกัน...");
-      }
-
-      // Show final attack stats
-      UIHelper::PrintBattleStats(attacker_card_opt.value().getName(), final_attacker_power,
-                                 final_attacker_crit, target_card_opt.value().getName(),
-                                 opponent_player->getUnitPowerAtStatusIndex(target_status_idx, -1, true));
-
-      // Guard Phase
-      int total_shield_from_guard = 0;
-      if (MenuSystem::ShowYesNoPrompt("คุณ (" + opponent_player->getName() + ") ต้องการ Guard หรือไม่?"))
-      {
-        total_shield_from_guard = opponent_player->performGuardStep(final_attacker_power, target_card_opt);
+        UIHelper::PrintError("ไม่สามารถโจมตีด้วยยูนิตที่เลือกได้");
       }
+    }
+    else if (battle_result.selected_key == "2") // Show field overview
+    {
+      MenuSystem::ShowFieldOverview(current_player, opponent_player, current_player);
+    }
+    else if (battle_result.selected_key == "3") // End Battle Phase
+    {
+      UIHelper::PrintInfo("จบ Battle Phase");
+      submitDecision(match, GameAction::endBattle());
+    }
+    else if (battle_result.selected_key == "h") // Help
+    {
+      MenuSystem::ShowGameHelp("BATTLE PHASE");
+    }
+  }
+  return false;
+}
 
-      // Calculate battle result
-      int opponent_target_base_power = opponent_player->getUnitPowerAtStatusIndex(target_status_idx, -1, true);
-      int opponent_total_defense_power = opponent_target_base_power + total_shield_from_guard;
+// ขั้นตอนการ Guard ของฝ่ายป้องกัน
+// match: แมตช์ที่กำลังรอฝ่ายป้องกันตัดสินใจ Guard
+void performGuardStep(Match &match)
+{
+  Player &defender = match.getPlayer(1 - match.getCurrentPlayerIndex());
+  const AttackState &attack = match.getAttack();
 
-      bool is_hit = final_attacker_power >= opponent_total_defense_power;
+  if (MenuSystem::ShowYesNoPrompt("คุณ (" + defender.getName() + ") ต้องการ Guard หรือไม่?"))
+  {
+    UIHelper::PrintSectionHeader(defender.getName() + ": GUARD PHASE", Icons::SHIELD, Colors::BRIGHT_BLUE);
 
-      UIHelper::ClearScreen();
-      UIHelper::PrintBattleStats(attacker_card_opt.value().getName(), final_attacker_power,
-                                 final_attacker_crit, target_card_opt.value().getName(),
-                                 opponent_total_defense_power);
+    Out() << Colors::BRIGHT_RED << Icons::SWORD << " พลังโจมตีที่เข้ามา: "
+          << attack.power << Colors::RESET << endl;
+    if (const Card *target_unit = defender.getUnitAt(attack.target_idx))
+    {
+      Out() << Colors::BRIGHT_YELLOW << Icons::TARGET << " เป้าหมายคือ: "
+            << target_unit->getNameView()
+            << " (Power ปัจจุบัน: " << target_unit->getPower() << ")"
+            << Colors::RESET << endl;
+    }
 
-      opponent_player->clearGuardianZoneAndMoveToDrop();
+    char continue_guard_choice = 'y';
 
-      if (is_hit)
+    while ((continue_guard_choice == 'y' || continue_guard_choice == 'Y'))
+    {
+      if (defender.getHandSize() == 0)
       {
-        // Damage Check
-        UIHelper::PrintSectionHeader(opponent_player->getName() + ": DAMAGE CHECK x" + to_string(final_attacker_crit),
-                                     Icons::DAMAGE, Colors::BRIGHT_RED);
+        UIHelper::PrintWarning("ไม่เหลือการ์ดบนมือให้ Guard แล้ว!");
+        break;
+      }
 
-        for (int i = 0; i < final_attacker_crit && !game_over; ++i)
-        {
-          UIHelper::ClearScreen();
-          opponent_player->displayField();
-          cout << Colors::BRIGHT_RED << "Damage Check ครั้งที่ " << (i + 1)
-               << "/" << final_attacker_crit << Colors::RESET << "\n";
+      Out() << "\n"
+            << Colors::BRIGHT_CYAN << Icons::HAND << " การ์ดบนมือของคุณ ("
+            << defender.getName() << "):" << Colors::RESET << endl;
+      defender.displayHand(true);
 
-          if (opponent_player->getDeck().isEmpty())
-          {
-            UIHelper::ClearScreen();
-            MenuSystem::ShowGameOverScreen(current_player, opponent_player,
-                                           opponent_player->getName() + " ไม่สามารถทำ Damage Check ได้ (เด็คหมด)");
-            game_over = true;
-            break;
-          }
+      Out() << Colors::BRIGHT_BLUE << Icons::GUARD << " Guardian Zone ปัจจุบัน: " << Colors::RESET;
+      defender.displayGuardianZone();
+      Out() << endl;
 
-          optional<Card> damage_card_opt = opponent_player->getDeck().draw();
-          if (damage_card_opt.has_value())
-          {
-            Card actual_damage_card = damage_card_opt.value();
-            cout << Colors::BRIGHT_CYAN << "เปิดได้: " << Colors::RESET
-                 << UIHelper::FormatCard(actual_damage_card.getName(), actual_damage_card.getGrade()) << "\n";
-
-            opponent_player->takeDamage(actual_damage_card);
-
-            TriggerOutput dmg_trigger_effects = opponent_player->handleDamageCheckTrigger(actual_damage_card, current_player);
-            if (dmg_trigger_effects.extra_power > 0)
-            {
-              cout << Colors::BRIGHT_MAGENTA << "Damage Trigger Effect: +"
-                   << dmg_trigger_effects.extra_power << " Power!" << Colors::RESET << "\n";
-            }
-
-            opponent_player->displayField();
-            if (opponent_player->getDamageCount() >= Player::MAX_DAMAGE)
-            {
-              MenuSystem::ShowGameOverScreen(current_player, opponent_player,
-                                             opponent_player->getName() + " ได้รับ " + std::to_string(Player::MAX_DAMAGE) + " ดาเมจ");
-              game_over = true;
-              break;
-            }
-          }
+      Out() << Colors::BRIGHT_BLUE << Icons::SHIELD << " Shield รวมปัจจุบัน: "
+            << defender.getGuardianZoneShieldTotal() << Colors::RESET << endl;
 
-          if (!game_over && i < final_attacker_crit - 1)
-          {
-            MenuSystem::WaitForKeyPress("กด Enter เพื่อดูดาเมจต่อไป...");
-          }
-        }
+      Out() << Colors::BRIGHT_CYAN << "เลือกการ์ดจากมือเพื่อ Guard (-1 เพื่อหยุด Guard): " << Colors::RESET;
+      string s_idx;
+      istringstream(InputSource::NextLine()) >> s_idx;
+      int card_idx = -1;
+      try
+      {
+        card_idx = stoi(s_idx);
+      }
+      catch (...)
+      {
+        card_idx = -2; /* invalid input */
       }
 
-      // Rest units
-      current_player->restUnit(attacker_status_idx);
-      if (booster_status_idx != -1)
+      if (card_idx == -1)
+        break;
+
+      if (!submitDecision(match, GameAction::guard(card_idx)))
       {
-        current_player->restUnit(booster_status_idx);
+        UIHelper::PrintError("เลือกไม่ถูกต้อง");
       }
 
-      if (game_over)
-        return false;
+      if (defender.getHandSize() == 0)
+      {
+        UIHelper::PrintWarning("ไม่เหลือการ์ดบนมือให้ Guard แล้ว!");
+        break;
+      }
 
-      MenuSystem::WaitForKeyPress("กด Enter เพื่อดำเนินการต่อ...");
+      Out() << Colors::BRIGHT_CYAN << "ต้องการ Guard เพิ่มหรือไม่ (y/n): " << Colors::RESET;
+      continue_guard_choice = 'n';
+      istringstream(InputSource::NextLine()) >> continue_guard_choice;
     }
-    else if (battle_result.selected_key == "2") // Show field overview
+
+    Out() << Colors::BRIGHT_GREEN << Icons::CONFIRM << " จบขั้นตอนการ Guard. Shield ที่ได้ทั้งหมด: "
+          << defender.getGuardianZoneShieldTotal() << Colors::RESET << endl;
+  }
+
+  // แมตช์คำนวณผลการต่อสู้และทำ Damage Check
+  submitDecision(match, GameAction::endGuard());
+}
+// เล่นเกม 1 รอบตั้งแต่เมนูหลักจนจบเกม
+// shuffle_seed: seed สำหรับสับสำรับ (ไม่ระบุ = สุ่มจากเวลาระบบ)
+// record_path: ไฟล์สำหรับบันทึก replay (ว่าง = ไม่บันทึก)
+// stats_path: ไฟล์สำหรับบันทึกสถิติรายเกม/รายเทิร์น (ว่าง = ไม่บันทึก)
+// คืนค่า: exit code ของโปรแกรม
+int runGameSession(optional<uint64_t> shuffle_seed, const string &record_path, const string &stats_path)
+{
+  // เริ่มเกม (วนกลับมาที่เมนูหลักหลังดูคำแนะนำ)
+  while (true)
+  {
+    MenuResult start_result = MenuSystem::ShowGameStartMenu();
+
+    if (start_result.should_exit || start_result.selected_key == "3")
     {
-      MenuSystem::ShowFieldOverview(current_player, opponent_player, current_player);
+      Out() << Colors::BRIGHT_CYAN << "ไว้พบกันใหม่โอกาสหน้า! " << Icons::EXIT << Colors::RESET << endl;
+      return 0;
     }
-    else if (battle_result.selected_key == "3") // End Battle Phase
+
+    if (start_result.selected_key == "2")
     {
-      UIHelper::PrintInfo("จบ Battle Phase");
-      return false;
+      MenuSystem::ShowGameHelp();
+      continue;
     }
-    else if (battle_result.selected_key == "h") // Help
+
+    if (start_result.selected_key == "1")
     {
-      MenuSystem::ShowGameHelp("BATTLE PHASE");
+      break;
     }
   }
-}
-
-// ฟังก์ชันหลักของโปรแกรม
-int main()
-{
-  // เริ่มเกม
-  MenuResult start_result = MenuSystem::ShowGameStartMenu();
-
-  if (start_result.should_exit || start_result.selected_key == "3")
-  {
-    cout << Colors::BRIGHT_CYAN << "ไว้พบกันใหม่โอกาสหน้า! " << Icons::EXIT << Colors::RESET << endl;
-    return 0;
-  }
-
-  if (start_result.selected_key == "2")
-  {
-    MenuSystem::ShowGameHelp();
-    return main(); // Restart
-  }
 
   // โหลดข้อมูลการ์ด
   UIHelper::ClearScreen();
@@ -505,16 +592,25 @@ int main()
   string p2_name = MenuSystem::GetPlayerName("👤 ใส่ชื่อผู้เล่น 2: ");
 
   // สร้างเด็คและผู้เล่น
-  map<string, int> deck_recipe_v1_3 = {
-      {"G0-01", 1}, {"G0-02", 4}, {"G0-03", 4}, {"G0-04", 8}, {"G1-01", 3}, {"G1-02", 4}, {"G1-03", 3}, {"G1-04", 2}, {"G1-05", 1}, {"G2-01", 3}, {"G2-02", 3}, {"G2-03", 3}, {"G2-04", 2}, {"G3-01", 2}, {"G3-02", 2}, {"G3-03", 2}, {"G3-04", 2}, {"G4-01", 1}};
+  const map<string, int> &deck_recipe_v1_3 = getStandardDeckRecipe();
 
   UIHelper::ShowLoadingAnimation("กำลังสร้างเด็ค...", 1000);
 
-  Player player1(p1_name, Deck(full_card_list, deck_recipe_v1_3));
-  Player player2(p2_name, Deck(full_card_list, deck_recipe_v1_3));
+  // นับตั้งแต่สร้างแมตช์จนแมตช์ถูกทำลาย ไม่รวมเมนูเริ่มเกมและการโหลดการ์ด (แสดงเมื่อ compile ด้วย -DFIBO_ALLOC_PROFILE เท่านั้น)
+  ScopedAllocationReport allocation_report("แมตช์นี้");
+  Match match(p1_name, Deck(full_card_list, deck_recipe_v1_3),
+              p2_name, Deck(full_card_list, deck_recipe_v1_3));
+
+  // replay และสถิติต้องรู้ seed จึงสุ่ม seed เองเมื่อบันทึกโดยไม่ได้ระบุ --seed
+  if ((!record_path.empty() || !stats_path.empty()) && !shuffle_seed.has_value())
+  {
+    shuffle_seed = static_cast<uint64_t>(chrono::system_clock::now().time_since_epoch().count());
+  }
 
   // ตั้งค่าเกม
-  if (!player1.setupGame("G0-01") || !player2.setupGame("G0-01"))
+  bool setup_ok = shuffle_seed.has_value() ? match.setup(STARTER_CODE_NAME, shuffle_seed.value())
+                                           : match.setup(STARTER_CODE_NAME);
+  if (!setup_ok)
   {
     UIHelper::PrintError("ไม่สามารถตั้งค่าเกมได้");
     return 1;
@@ -523,90 +619,429 @@ int main()
   // เลือกผู้เล่นคนแรก
   UIHelper::ClearScreen();
   UIHelper::PrintSectionHeader("GAME START", Icons::CONFIRM);
-  cout << Colors::BRIGHT_CYAN << "ใครจะเริ่มเล่นก่อน?" << Colors::RESET << "\n";
-  cout << Colors::YELLOW << "[1] " << p1_name << Colors::RESET << "\n";
-  cout << Colors::YELLOW << "[2] " << p2_name << Colors::RESET << "\n";
+  Out() << Colors::BRIGHT_CYAN << "ใครจะเริ่มเล่นก่อน?" << Colors::RESET << "\n";
+  Out() << Colors::YELLOW << "[1] " << p1_name << Colors::RESET << "\n";
+  Out() << Colors::YELLOW << "[2] " << p2_name << Colors::RESET << "\n";
 
   int first_player_choice = MenuSystem::GetIntegerInput("เลือก: ", 1, 2);
 
-  Player *currentPlayer = (first_player_choice == 1) ? &player1 : &player2;
-  Player *opponentPlayer = (first_player_choice == 1) ? &player2 : &player1;
-
-  UIHelper::PrintSuccess(currentPlayer->getName() + " ได้เริ่มเล่นก่อน!");
+  UIHelper::PrintSuccess(match.getPlayer(first_player_choice - 1).getName() + " ได้เริ่มเล่นก่อน!");
   MenuSystem::WaitForKeyPress("กด Enter เพื่อเริ่มเกม...");
 
-  // วนลูปหลักของเกม
-  int turn_count = 0;
-  bool game_over = false;
+  // บันทึก replay และสถิติตั้งแต่ก่อนเริ่มเทิร์นแรก
+  ReplayHeader header;
+  if (shuffle_seed.has_value())
+  {
+    header.seed = shuffle_seed.value();
+  }
+  header.catalog_checksum = catalogChecksum(full_card_list);
+  header.first_player = first_player_choice - 1;
+  header.starter_code_name = STARTER_CODE_NAME;
+  header.player_names = {p1_name, p2_name};
+  header.deck_recipes = {deck_recipe_v1_3, deck_recipe_v1_3};
+
+  MatchRecorderGroup recorders;
+  ReplayWriter replay_writer;
+  if (!record_path.empty())
+  {
+    if (replay_writer.open(record_path, header, full_card_list))
+    {
+      recorders.add(&replay_writer);
+    }
+    else
+    {
+      UIHelper::PrintWarning("เปิดไฟล์ '" + record_path + "' เพื่อบันทึก replay ไม่ได้ เกมนี้จะไม่ถูกบันทึก");
+      MenuSystem::WaitForKeyPress();
+    }
+  }
+  GameStatsWriter stats_writer;
+  optional<GameStatsRecorder> stats_recorder;
+  if (!stats_path.empty())
+  {
+    if (stats_writer.open(stats_path))
+    {
+      stats_recorder.emplace(stats_writer, header);
+      recorders.add(&stats_recorder.value());
+    }
+    else
+    {
+      UIHelper::PrintWarning("เปิดไฟล์ '" + stats_path + "' เพื่อบันทึกสถิติไม่ได้ เกมนี้จะไม่ถูกบันทึกสถิติ");
+      MenuSystem::WaitForKeyPress();
+    }
+  }
+  if (!recorders.isEmpty())
+  {
+    match.setRecorder(&recorders);
+  }
+
+  // วนลูปหลักของเกม: แมตช์เดินเกมเองจนถึงการตัดสินใจครั้งถัดไป แล้วรอคำตอบจากเมนู
+  ConsoleMatchView match_view;
+  match.setObserver(&match_view);
+  match.start(first_player_choice - 1);
+  decision_started = chrono::steady_clock::now();
+
   bool should_exit = false;
+  while (!match.isOver() && !should_exit)
+  {
+    switch (match.getPendingDecision())
+    {
+    case DecisionType::MainPhase:
+      should_exit = performMainPhase(match);
+      break;
+    case DecisionType::BattlePhase:
+      should_exit = performBattlePhase(match);
+      break;
+    case DecisionType::Guard:
+      performGuardStep(match);
+      break;
+    default:
+      should_exit = true;
+      break;
+    }
+  }
 
-  while (!game_over && !should_exit && turn_count < 50)
+  if (!should_exit)
   {
-    turn_count++;
+    Out() << "\n"
+          << Colors::BRIGHT_MAGENTA << Icons::VICTORY
+          << " ขอบคุณที่เล่น FIBO Card Commandos! " << Icons::VICTORY << Colors::RESET << "\n";
+    MenuSystem::WaitForKeyPress("กด Enter เพื่อออกจากโปรแกรม...");
+  }
 
-    // เริ่มเทิร์น
-    MenuSystem::ShowTurnStartScreen(currentPlayer, turn_count);
+  return 0;
+}
 
-    // Stand Phase
-    currentPlayer->performStandPhase();
+// เดินเกมซ้ำจากไฟล์ replay แล้วแสดงผลสรุปและสถานะสุดท้าย (ใช้ตรวจสอบบั๊กที่ผู้เล่นแจ้งมา)
+// คืนค่า: exit code ของโปรแกรม (1 = ไฟล์เสียหรือเดินเกมซ้ำแล้วไม่ตรงกับที่บันทึกไว้)
+int runReplay(const string &replay_path)
+{
+  vector<Card> full_card_list = loadCardsFromJson("cards.json");
+  if (full_card_list.empty())
+  {
+    return 1;
+  }
 
-    // Draw Phase
-    if (!currentPlayer->performDrawPhase())
+  ReplaySimulator simulator;
+  if (!simulator.open(replay_path, full_card_list))
+  {
+    UIHelper::PrintError("เปิด replay ไม่ได้: " + simulator.getError());
+    return 1;
+  }
+
+  const ReplayHeader &header = simulator.getHeader();
+  UIHelper::PrintSectionHeader("REPLAY: " + header.player_names[0] + " vs " + header.player_names[1], Icons::CARD);
+  Out() << "seed " << header.seed << ", ผู้เล่นที่เริ่มก่อน: " << header.player_names[static_cast<size_t>(header.first_player)] << "\n";
+
+  {
+    NullSink quiet; // ข้อความที่เกมพิมพ์ระหว่างเดินเกมซ้ำไม่ต้องแสดง
+    ScopedOutputSink quiet_scope(&quiet);
+    while (simulator.step())
     {
-      MenuSystem::ShowGameOverScreen(opponentPlayer, currentPlayer,
-                                     currentPlayer->getName() + " ไม่สามารถจั่วการ์ดได้ (เด็คหมด)");
-      game_over = true;
-      break;
     }
+  }
 
-    UIHelper::ShowPhaseTransition("DRAW PHASE", "MAIN PHASE");
+  const Match &match = simulator.getMatch();
+  Out() << "เดินเกมซ้ำ " << simulator.getActionsApplied() << " การกระทำ ใน " << match.getTurnCount()
+        << " เทิร์น จากไฟล์ " << simulator.getBytesRead() << " ไบต์ (ตรวจ checksum ตรงกัน "
+        << simulator.getChecksumsVerified() << " จุด)\n\n";
+  match.dumpState(Out());
+  Out() << "\n";
 
-    // Main Phase
-    should_exit = performMainPhase(currentPlayer);
-    if (should_exit)
-      break;
+  if (!simulator.getError().empty())
+  {
+    UIHelper::PrintError(simulator.getError());
+    return 1;
+  }
+  if (simulator.isTruncated())
+  {
+    UIHelper::PrintWarning("ไฟล์จบกลางรายการ (โปรแกรมที่บันทึกอาจปิดตัวกะทันหัน) - แสดงสถานะถึงรายการสุดท้ายที่สมบูรณ์");
+  }
+  else if (!simulator.isFinished())
+  {
+    UIHelper::PrintInfo("replay จบก่อนเกมจบ (ผู้เล่นออกจากเกมระหว่างเล่น)");
+  }
+  else if (match.getWinnerIndex() >= 0)
+  {
+    UIHelper::PrintSuccess("ผู้ชนะ: " + match.getPlayer(match.getWinnerIndex()).getName());
+  }
+  else
+  {
+    UIHelper::PrintInfo("จบเกมโดยไม่มีผู้ชนะ");
+  }
+  return 0;
+}
 
-    UIHelper::ShowPhaseTransition("MAIN PHASE", "BATTLE PHASE");
+// คำอธิบายการกระทำ 1 ครั้งสำหรับตัวดู replay
+string describeAction(const GameAction &action)
+{
+  switch (action.type)
+  {
+  case ActionType::Ride:
+    return "Ride การ์ดบนมือ [" + to_string(action.source) + "]";
+  case ActionType::Call:
+    return "Call การ์ดบนมือ [" + to_string(action.source) + "] ลง RC " + to_string(action.target);
+  case ActionType::EndMain:
+    return "ไป Battle Phase";
+  case ActionType::Attack:
+    return "โจมตีด้วยยูนิต " + to_string(action.source) + " ไปที่ยูนิต " + to_string(action.target) +
+           (action.booster >= 0 ? " (Boost จากยูนิต " + to_string(action.booster) + ")" : "");
+  case ActionType::EndBattle:
+    return "จบ Battle Phase";
+  case ActionType::Guard:
+    return "Guard ด้วยการ์ดบนมือ [" + to_string(action.source) + "]";
+  case ActionType::EndGuard:
+    return "จบการ Guard";
+  }
+  return "";
+}
 
-    // Battle Phase
-    should_exit = performBattlePhase(currentPlayer, opponentPlayer, game_over);
-    if (should_exit || game_over)
-      break;
+// ตัวดู replay: เลื่อนไปข้างหน้า/ย้อนกลับทีละการกระทำ หรือกระโดดไปเทิร์นที่ต้องการ
+// การย้อนกลับและกระโดดโหลด keyframe ที่ใกล้ที่สุดในไฟล์ แล้วเดินเกมต่ออีกไม่กี่การกระทำ
+// คืนค่า: exit code ของโปรแกรม
+int runReplayViewer(const string &replay_path)
+{
+  vector<Card> full_card_list = loadCardsFromJson("cards.json");
+  if (full_card_list.empty())
+  {
+    return 1;
+  }
 
-    // End Phase
-    UIHelper::PrintSectionHeader(currentPlayer->getName() + ": END PHASE", Icons::PHASE);
-    currentPlayer->clearGuardianZoneAndMoveToDrop();
-    opponentPlayer->clearGuardianZoneAndMoveToDrop();
+  NullSink quiet; // ข้อความที่เกมพิมพ์ระหว่างเดินเกมซ้ำไม่ต้องแสดง
+  ReplaySimulator simulator;
+  bool opened;
+  {
+    ScopedOutputSink quiet_scope(&quiet);
+    opened = simulator.open(replay_path, full_card_list);
+  }
+  if (!opened)
+  {
+    UIHelper::PrintError("เปิด replay ไม่ได้: " + simulator.getError());
+    return 1;
+  }
 
-    // ตรวจสอบเงื่อนไขการชนะ
-    if (currentPlayer->getDamageCount() >= Player::MAX_DAMAGE || opponentPlayer->getDamageCount() >= Player::MAX_DAMAGE)
+  const ReplayHeader &header = simulator.getHeader();
+  string last_action = "เริ่มเกม";
+  while (true)
+  {
+    const Match &match = simulator.getMatch();
+    UIHelper::ClearScreen();
+    UIHelper::PrintSectionHeader("REPLAY: " + header.player_names[0] + " vs " + header.player_names[1], Icons::CARD);
+    Out() << Colors::BRIGHT_CYAN << "เทิร์น " << match.getTurnCount() << " | การกระทำที่ " << simulator.getActionsApplied()
+          << " | keyframe " << simulator.getKeyframes().size() << " จุด" << Colors::RESET << "\n"
+          << Colors::YELLOW << "ล่าสุด: " << last_action << Colors::RESET << "\n";
+    for (int i = 0; i < 2; ++i)
     {
-      Player *winner = (currentPlayer->getDamageCount() < Player::MAX_DAMAGE) ? currentPlayer : opponentPlayer;
-      Player *loser = (currentPlayer->getDamageCount() >= Player::MAX_DAMAGE) ? currentPlayer : opponentPlayer;
-      MenuSystem::ShowGameOverScreen(winner, loser, "ดาเมจครบ " + std::to_string(Player::MAX_DAMAGE) + " แต้ม");
-      game_over = true;
-      break;
+      match.getPlayer(i).displayField();
+    }
+    if (!simulator.getError().empty())
+    {
+      UIHelper::PrintError(simulator.getError());
+    }
+    else if (match.isOver())
+    {
+      UIHelper::PrintInfo(match.getWinnerIndex() >= 0 ? "ผู้ชนะ: " + match.getPlayer(match.getWinnerIndex()).getName()
+                                                      : "จบเกมโดยไม่มีผู้ชนะ");
     }
 
-    UIHelper::PrintInfo("เทิร์นของ " + currentPlayer->getName() + " สิ้นสุด");
-    MenuSystem::WaitForKeyPress("กด Enter เพื่อให้ผู้เล่นถัดไปเริ่มเทิร์น...");
+    Out() << Colors::BRIGHT_CYAN << "[n] ถัดไป  [p] ย้อนกลับ  [t <เทิร์น>] ไปเทิร์น  [a <ลำดับ>] ไปการกระทำ  [q] ออก: "
+          << Colors::RESET;
+    string command;
+    long long value = -1;
+    istringstream(InputSource::NextLine()) >> command >> value;
 
-    // สลับผู้เล่น
-    swap(currentPlayer, opponentPlayer);
+    ScopedOutputSink quiet_scope(&quiet);
+    if (command == "q")
+    {
+      return 0;
+    }
+    else if (command == "p")
+    {
+      last_action = simulator.stepBack() ? "ย้อนกลับ 1 การกระทำ" : "อยู่ที่จุดเริ่มเกมแล้ว";
+    }
+    else if (command == "t" && value > 0)
+    {
+      last_action = simulator.seekTurn(static_cast<int>(value)) ? "ไปยังต้นเทิร์น " + to_string(value)
+                                                                : "เกมจบก่อนถึงเทิร์น " + to_string(value);
+    }
+    else if (command == "a" && value >= 0)
+    {
+      last_action = simulator.seekAction(static_cast<uint64_t>(value)) ? "ไปยังการกระทำที่ " + to_string(value)
+                                                                       : "replay มีการกระทำไม่ถึง " + to_string(value);
+    }
+    else if (command.empty() || command == "n")
+    {
+      // เดินจนครบ 1 การกระทำ (ข้ามรายการ checksum และ keyframe)
+      int actor = match.getActingPlayerIndex();
+      ReplayRecord record;
+      bool stepped = false;
+      while (!stepped && simulator.step(&record))
+      {
+        stepped = record.type == ReplayRecordType::Action;
+      }
+      last_action = stepped ? header.player_names[static_cast<size_t>(actor)] + ": " + describeAction(record.action)
+                            : "จบ replay แล้ว";
+    }
   }
+}
 
-  if (!should_exit && !game_over)
+// แปลงค่าของ --seed (ต้องเป็นเลขฐานสิบไม่ติดลบทั้งข้อความ และไม่เกินช่วงของ uint64_t)
+static bool parseSeed(const string &text, uint64_t &seed)
+{
+  if (text.empty() || !isdigit(static_cast<unsigned char>(text[0])))
+  {
+    return false;
+  }
+  try
   {
-    UIHelper::PrintInfo("จบการจำลอง " + to_string(turn_count) + " เทิร์น");
+    size_t used = 0;
+    seed = stoull(text, &used);
+    return used == text.size();
   }
+  catch (const exception &) // invalid_argument / out_of_range
+  {
+    return false;
+  }
+}
 
-  if (!should_exit)
+// ฟังก์ชันหลักของโปรแกรม
+// ตัวเลือก:
+//   --script <file>  ใช้ไฟล์สคริปต์แทนการพิมพ์จากคีย์บอร์ด
+//   --no-animation   ปิดแอนิเมชันและการหน่วงเวลาทั้งหมด
+//   --output <spec>  ปลายทางผลลัพธ์: stdout (ค่าเริ่มต้น), null, file:<path>, ring[:<bytes>]
+//   --line-input     ปิดโหมดกดปุ่มเดียว ใช้การพิมพ์แล้วกด Enter ทุกครั้ง
+//   --seed <n>       สับสำรับด้วย seed ที่กำหนด (เล่นซ้ำได้ผลเดิมเมื่อป้อนคำสั่งชุดเดิม)
+//   --record <file>  บันทึกเกมเป็นไฟล์ replay
+//   --stats <file>   บันทึกสถิติรายเกมและรายเทิร์นเป็นไฟล์คอลัมน์ (แปลงเป็น CSV ด้วย fibo_stats_csv)
+//   --replay <file>  เดินเกมซ้ำจากไฟล์ replay แล้วแสดงสถานะสุดท้าย (ไม่เปิดเมนู)
+//   --replay-view <file>  ดู replay ทีละการกระทำ (เลื่อนไปข้างหน้า/ย้อนกลับ/กระโดดไปเทิร์นที่ต้องการ)
+//   --trace <file>   บันทึกเวลาของแต่ละเฟสและการแสดงผลเป็น Chrome trace JSON (เปิดใน ui.perfetto.dev)
+//   --metrics <file> เขียนตัวนับและฮิสโตแกรมของเกมเป็นไฟล์ Prometheus ตอนจบโปรแกรม ("-" = แสดงสรุปทาง stderr)
+int main(int argc, char *argv[])
+{
+  string script_path;
+  string output_spec = "stdout";
+  optional<uint64_t> shuffle_seed;
+  string record_path;
+  string stats_path;
+  string replay_path;
+  string replay_view_path;
+  string trace_path;
+  string metrics_path;
+  bool valid = true;
+  for (int i = 1; i < argc; ++i)
   {
-    cout << "\n"
-         << Colors::BRIGHT_MAGENTA << Icons::VICTORY
-         << " ขอบคุณที่เล่น FIBO Card Commandos! " << Icons::VICTORY << Colors::RESET << "\n";
-    MenuSystem::WaitForKeyPress("กด Enter เพื่อออกจากโปรแกรม...");
+    string arg = argv[i];
+    if (arg == "--script" && i + 1 < argc)
+    {
+      script_path = argv[++i];
+    }
+    else if (arg == "--no-animation")
+    {
+      UIHelper::SetAnimationEnabled(false);
+    }
+    else if (arg == "--output" && i + 1 < argc)
+    {
+      output_spec = argv[++i];
+    }
+    else if (arg == "--line-input")
+    {
+      KeyboardInput::SetEnabled(false);
+    }
+    else if (arg == "--seed" && i + 1 < argc)
+    {
+      uint64_t seed = 0;
+      valid = parseSeed(argv[++i], seed);
+      shuffle_seed = seed;
+    }
+    else if (arg == "--record" && i + 1 < argc)
+    {
+      record_path = argv[++i];
+    }
+    else if (arg == "--stats" && i + 1 < argc)
+    {
+      stats_path = argv[++i];
+    }
+    else if (arg == "--replay" && i + 1 < argc)
+    {
+      replay_path = argv[++i];
+    }
+    else if (arg == "--replay-view" && i + 1 < argc)
+    {
+      replay_view_path = argv[++i];
+    }
+    else if (arg == "--trace" && i + 1 < argc)
+    {
+      trace_path = argv[++i];
+    }
+    else if (arg == "--metrics" && i + 1 < argc)
+    {
+      metrics_path = argv[++i];
+    }
+    else
+    {
+      valid = false;
+    }
+    if (!valid)
+    {
+      cerr << "ตัวเลือกไม่ถูกต้อง: " << arg << (arg == "--seed" ? string(" ") + argv[i] : string()) << "\n"
+           << "วิธีใช้: " << argv[0] << " [--script <file>] [--no-animation] [--output <spec>] [--line-input] [--seed <n>]"
+           << " [--record <file>] [--stats <file>] [--replay <file>] [--replay-view <file>]"
+           << " [--trace <file>] [--metrics <file>]" << endl;
+      return 2;
+    }
   }
+  ScopedTrace trace_scope(trace_path); // เขียนไฟล์ trace เมื่อ main จบไม่ว่าจะออกทางใด
+  ScopedMetricsOutput metrics_scope(metrics_path);
 
-  return 0;
-}
\ No newline at end of file
+  unique_ptr<OutputSink> output_sink = OutputSink::Create(output_spec);
+  if (!output_sink)
+  {
+    cerr << "ไม่สามารถสร้างปลายทางผลลัพธ์ '" << output_spec << "' ได้" << endl;
+    return 2;
+  }
+  ScopedOutputSink output_scope(output_sink.get());
+  RingBufferSink *crash_ring = dynamic_cast<RingBufferSink *>(output_sink.get());
+
+  optional<ScriptInputSource> script_source;
+  if (!script_path.empty())
+  {
+    console_player_type = "script";
+    script_source.emplace(script_path);
+    if (!script_source->IsOpen())
+    {
+      UIHelper::PrintError("เปิดไฟล์สคริปต์ '" + script_path + "' ไม่ได้");
+      return 1;
+    }
+    InputSource::SetCurrent(&script_source.value());
+  }
+
+  if (!replay_path.empty())
+  {
+    return runReplay(replay_path);
+  }
+
+  try
+  {
+    if (!replay_view_path.empty())
+    {
+      return runReplayViewer(replay_view_path);
+    }
+    return runGameSession(shuffle_seed, record_path, stats_path);
+  }
+  catch (const InputExhaustedError &)
+  {
+    // สคริปต์จบ (หรือปิด stdin) ก่อนเกมจบ - ออกจากโปรแกรมอย่างปกติ
+    UIHelper::PrintInfo("ข้อมูลนำเข้าหมดแล้ว จบการทำงาน");
+    return 0;
+  }
+  catch (const exception &e)
+  {
+    // บันทึกข้อความล่าสุดจาก ring buffer ไว้ตรวจสอบสาเหตุที่โปรแกรมล่ม
+    cerr << "เกิดข้อผิดพลาดร้ายแรง: " << e.what() << endl;
+    if (crash_ring && crash_ring->DumpTo("fibo_crash_dump.txt"))
+    {
+      cerr << "บันทึกผลลัพธ์ล่าสุดไว้ที่ fibo_crash_dump.txt" << endl;
+    }
+    return 1;
+  }
+}
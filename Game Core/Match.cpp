@@ -0,0 +1,501 @@
+// Match.cpp - ไฟล์ Source สำหรับเครื่องดำเนินเกม 1 แมตช์
+// กติกาและลำดับเฟสเหมือนลูปเกมเดิมใน Main.cpp ทุกประการ
+// ต่างกันเพียงว่าแทนที่จะเรียกเมนูแล้วรอคำตอบ แมตช์จะหยุดที่สถานะ pending แล้วคืนการควบคุมกลับ
+#include "Match.h"
+#include "StateHash.h"
+#include "StateCodec.h"
+#include "Trace.h"
+#include "Metrics.h"
+#include "BattleResolver.h"
+#include <ostream>
+
+// Constructor - สร้างแมตช์จากชื่อและสำรับของผู้เล่นทั้งสองฝ่าย
+Match::Match(const std::string &player1_name, Deck &&player1_deck,
+             const std::string &player2_name, Deck &&player2_deck)
+    : arena(acquireMatchArena()),
+      players{{Player(player1_name, std::move(player1_deck), arena.get()),
+               Player(player2_name, std::move(player2_deck), arena.get())}},
+      current_player_idx(0), turn_count(0), pending(DecisionType::None),
+      end_reason(MatchEnd::None), winner_idx(-1), observer(nullptr), recorder(nullptr)
+{
+}
+
+Match::Match(const std::string &player1_name, const Deck &player1_deck,
+             const std::string &player2_name, const Deck &player2_deck)
+    : arena(acquireMatchArena()),
+      players{{Player(player1_name, player1_deck, arena.get()), Player(player2_name, player2_deck, arena.get())}},
+      current_player_idx(0), turn_count(0), pending(DecisionType::None),
+      end_reason(MatchEnd::None), winner_idx(-1), observer(nullptr), recorder(nullptr)
+{
+}
+
+Match::Match(const Match &other)
+    : arena(acquireMatchArena()),
+      players{{Player(other.players[0], arena.get()), Player(other.players[1], arena.get())}},
+      current_player_idx(other.current_player_idx), turn_count(other.turn_count), pending(other.pending),
+      attack(other.attack), end_reason(other.end_reason), winner_idx(other.winner_idx), observer(other.observer),
+      recorder(other.recorder)
+{
+}
+
+bool Match::setup(const std::string &starter_code_name)
+{
+  return players[0].setupGame(starter_code_name) && players[1].setupGame(starter_code_name);
+}
+
+// แยก seed ของแต่ละฝ่ายออกจาก seed ของแมตช์ (SplitMix64) เพื่อไม่ให้สองสำรับถูกสับเป็นลำดับเดียวกัน
+static uint64_t playerSeed(uint64_t match_seed, int player_idx)
+{
+  uint64_t z = match_seed + 0x9E3779B97F4A7C15ull * static_cast<uint64_t>(player_idx + 1);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+bool Match::setup(const std::string &starter_code_name, uint64_t shuffle_seed)
+{
+  return players[0].setupGame(starter_code_name, 5, playerSeed(shuffle_seed, 0)) &&
+         players[1].setupGame(starter_code_name, 5, playerSeed(shuffle_seed, 1));
+}
+
+void Match::start(int first_player_idx)
+{
+  current_player_idx = (first_player_idx == 1) ? 1 : 0;
+  beginTurn();
+}
+
+int Match::getActingPlayerIndex() const
+{
+  switch (pending)
+  {
+  case DecisionType::MainPhase:
+  case DecisionType::BattlePhase:
+    return current_player_idx;
+  case DecisionType::Guard:
+    return 1 - current_player_idx;
+  default:
+    return -1;
+  }
+}
+
+// เริ่มเทิร์นใหม่: Stand Phase → Draw Phase → รอการตัดสินใจใน Main Phase
+void Match::beginTurn()
+{
+  turn_count++;
+  events().onTurnStart(turnPlayer(), turn_count);
+
+  {
+    TRACE_SPAN("phase", "Stand Phase");
+    turnPlayer().performStandPhase();
+  }
+
+  bool drew;
+  {
+    TRACE_SPAN("phase", "Draw Phase");
+    drew = turnPlayer().performDrawPhase();
+  }
+  if (!drew)
+  {
+    finish(MatchEnd::DrawDeckOut, 1 - current_player_idx);
+    return;
+  }
+
+  events().onPhaseTransition("DRAW PHASE", "MAIN PHASE");
+  phase_span.begin("phase", "Main Phase");
+  pending = DecisionType::MainPhase;
+  if (recorder)
+  {
+    recorder->recordTurnStart(*this);
+  }
+}
+
+// เข้าสู่ Battle Phase: เคลียร์ Guardian Zone ของทั้งสองฝ่ายก่อนเริ่มโจมตี
+void Match::beginBattlePhase()
+{
+  events().onPhaseTransition("MAIN PHASE", "BATTLE PHASE");
+  turnPlayer().clearGuardianZoneAndMoveToDrop();
+  opponentPlayer().clearGuardianZoneAndMoveToDrop();
+  phase_span.begin("phase", "Battle Phase"); // จบช่วงของ Main Phase
+  pending = DecisionType::BattlePhase;
+}
+
+// ตรวจสอบการประกาศโจมตี คำนวณพลัง ทำ Drive Check แล้วรอฝ่ายป้องกัน Guard
+bool Match::isValidAttack(const GameAction &action) const
+{
+  const Player &attacker = players[static_cast<size_t>(current_player_idx)];
+  const Player &defender = players[static_cast<size_t>(1 - current_player_idx)];
+  int attacker_idx = action.source;
+  int target_idx = action.target;
+  int booster_idx = action.booster;
+
+  // Attacker ต้องเป็นยูนิตแถวหน้าที่ยังยืนอยู่
+  bool front_row_attacker = attacker_idx == UNIT_STATUS_VC_IDX || attacker_idx == UNIT_STATUS_RC_FL_IDX ||
+                            attacker_idx == UNIT_STATUS_RC_FR_IDX;
+  if (!front_row_attacker || !attacker.hasUnitAt(attacker_idx) || !attacker.isUnitStanding(attacker_idx))
+  {
+    return false;
+  }
+
+  // เป้าหมายต้องเป็น Vanguard หรือ Rear-guard แถวหน้าของฝ่ายตรงข้าม
+  bool front_row_target = target_idx == UNIT_STATUS_VC_IDX || target_idx == UNIT_STATUS_RC_FL_IDX ||
+                          target_idx == UNIT_STATUS_RC_FR_IDX;
+  if (!front_row_target || !defender.hasUnitAt(target_idx))
+  {
+    return false;
+  }
+
+  // Booster ต้องเป็นตำแหน่งที่ Boost ให้ Attacker นี้ได้จริง
+  return booster_idx == -1 || booster_idx == attacker.chooseBooster(attacker_idx);
+}
+
+bool Match::declareAttack(const GameAction &action)
+{
+  if (!isValidAttack(action))
+  {
+    return false;
+  }
+  Player &attacker = turnPlayer();
+  Player &defender = opponentPlayer();
+  int attacker_idx = action.source;
+  int target_idx = action.target;
+  int booster_idx = action.booster;
+  const Card &attacker_card = *attacker.getUnitAt(attacker_idx); // isValidAttack() ตรวจแล้วว่ามียูนิต
+
+  attack = AttackState();
+  attack.attacker_idx = attacker_idx;
+  attack.target_idx = target_idx;
+  attack.booster_idx = booster_idx;
+  attack.power = attacker.getUnitPowerAtStatusIndex(attacker_idx, booster_idx);
+  attack.critical = attacker_card.getCritical();
+
+  // Drive Check เมื่อ Vanguard โจมตี
+  if (attacker_idx == UNIT_STATUS_VC_IDX)
+  {
+    events().onDriveCheckBegin(attacker);
+    int num_drives = (attacker_card.getGrade() >= 3) ? 2 : 1;
+    TriggerOutput drive_trigger_effects = attacker.performDriveCheck(num_drives, &defender);
+    attack.power += drive_trigger_effects.extra_power;
+    attack.critical += drive_trigger_effects.extra_crit;
+    if (recorder && drive_trigger_effects.triggers_revealed > 0)
+    {
+      recorder->recordTriggers(current_player_idx, drive_trigger_effects.triggers_revealed);
+    }
+    events().onDriveCheckEnd(attacker);
+  }
+
+  events().onAttackPower(attacker, defender, attack);
+  gameMetrics().attacks.add();
+  guard_span.begin("battle", "Guard Step");
+  pending = DecisionType::Guard;
+  return true;
+}
+
+// คำนวณผลการต่อสู้หลังฝ่ายป้องกัน Guard เสร็จ แล้วทำ Damage Check ถ้าโจมตีเข้า
+void Match::resolveAttack()
+{
+  guard_span.end();
+  TRACE_SPAN("battle", "Resolve Attack");
+  Player &attacker = turnPlayer();
+  Player &defender = opponentPlayer();
+
+  int defense_power = defender.getUnitPowerAtStatusIndex(attack.target_idx, -1, true) +
+                      defender.getGuardianZoneShieldTotal();
+  bool is_hit = isBattleHit(attack.power, defense_power);
+  size_t guard_cards = defender.getGuardianZone().size();
+  if (guard_cards > 0)
+  {
+    gameMetrics().guards.add();
+    gameMetrics().cards_per_guard.record(guard_cards);
+  }
+
+  events().onBattleResult(attacker, defender, attack, defense_power);
+  defender.clearGuardianZoneAndMoveToDrop();
+
+  if (is_hit)
+  {
+    gameMetrics().hits.add();
+    for (int i = 0; i < attack.critical && !isOver(); ++i)
+    {
+      TRACE_SPAN("battle", "Damage Check");
+      events().onDamageCheck(defender, i + 1, attack.critical);
+
+      if (defender.getDeck().isEmpty())
+      {
+        finish(MatchEnd::DamageDeckOut, current_player_idx);
+        break;
+      }
+
+      std::optional<Card> damage_card_opt = defender.getDeck().draw();
+      if (damage_card_opt.has_value())
+      {
+        events().onDamageRevealed(defender, damage_card_opt.value());
+        TriggerOutput dmg_trigger_effects = defender.handleDamageCheckTrigger(damage_card_opt.value(), &attacker);
+        if (recorder && dmg_trigger_effects.triggers_revealed > 0)
+        {
+          recorder->recordTriggers(1 - current_player_idx, dmg_trigger_effects.triggers_revealed);
+        }
+        events().onDamageTaken(defender, dmg_trigger_effects);
+
+        if (defender.getDamageCount() >= Player::MAX_DAMAGE)
+        {
+          finish(MatchEnd::DamageLimit, current_player_idx);
+          break;
+        }
+      }
+    }
+  }
+
+  // Attacker และ Booster หมุนตัว (Rest) หลังโจมตี
+  attacker.restUnit(attack.attacker_idx);
+  if (attack.booster_idx != -1)
+  {
+    attacker.restUnit(attack.booster_idx);
+  }
+
+  if (isOver())
+  {
+    return;
+  }
+
+  events().onAttackEnd(attacker);
+  pending = DecisionType::BattlePhase;
+}
+
+// End Phase: เคลียร์ Guardian Zone ตรวจเงื่อนไขการชนะ แล้วส่งเทิร์นให้อีกฝ่าย
+void Match::performEndPhase()
+{
+  phase_span.end();
+  {
+    TRACE_SPAN("phase", "End Phase"); // ไม่รวมเทิร์นถัดไปที่เริ่มท้ายฟังก์ชันนี้
+    events().onEndPhase(turnPlayer());
+    turnPlayer().clearGuardianZoneAndMoveToDrop();
+    opponentPlayer().clearGuardianZoneAndMoveToDrop();
+
+    // ตรวจสอบเงื่อนไขการชนะ
+    if (turnPlayer().getDamageCount() >= Player::MAX_DAMAGE || opponentPlayer().getDamageCount() >= Player::MAX_DAMAGE)
+    {
+      int winner = (turnPlayer().getDamageCount() < Player::MAX_DAMAGE) ? current_player_idx : 1 - current_player_idx;
+      finish(MatchEnd::EndPhaseDamage, winner);
+      return;
+    }
+
+    events().onTurnEnd(turnPlayer());
+    if (recorder)
+    {
+      recorder->recordTurnEnd(*this);
+    }
+  }
+
+  // สลับผู้เล่น
+  current_player_idx = 1 - current_player_idx;
+  if (turn_count >= MAX_TURNS)
+  {
+    finish(MatchEnd::TurnLimit, -1);
+    return;
+  }
+  beginTurn();
+}
+
+void Match::finish(MatchEnd reason, int winner)
+{
+  end_reason = reason;
+  winner_idx = winner;
+  pending = DecisionType::None;
+  guard_span.end();
+  phase_span.end();
+  gameMetrics().games.add();
+  gameMetrics().turns_per_game.record(static_cast<uint64_t>(turn_count));
+  if (recorder)
+  {
+    recorder->recordGameOver(*this);
+  }
+  events().onGameOver(*this);
+}
+
+void Match::concede(int player_idx)
+{
+  if (!isOver())
+  {
+    finish(MatchEnd::Conceded, 1 - player_idx);
+  }
+}
+
+bool Match::submit(const GameAction &action)
+{
+  // จบ Battle Phase และจบการ Guard ถูกยอมรับเสมอเมื่อรอการตัดสินใจนั้นอยู่ จึงบันทึกก่อนเดินเกม
+  // เพื่อให้การจบเทิร์นหรือจบเกมที่ตามมาถูกบันทึกต่อท้ายการกระทำที่เป็นต้นเหตุ
+  bool always_accepted = (action.type == ActionType::EndBattle && pending == DecisionType::BattlePhase) ||
+                         (action.type == ActionType::EndGuard && pending == DecisionType::Guard);
+  if (always_accepted)
+  {
+    record(action);
+  }
+  bool accepted = apply(action);
+  if (accepted && !always_accepted)
+  {
+    record(action);
+  }
+  return accepted;
+}
+
+void Match::record(const GameAction &action)
+{
+  if (recorder)
+  {
+    recorder->recordAction(action);
+  }
+}
+
+bool Match::apply(const GameAction &action)
+{
+  switch (pending)
+  {
+  case DecisionType::MainPhase:
+    if (action.type == ActionType::Ride)
+    {
+      return action.source >= 0 && turnPlayer().rideFromHand(static_cast<size_t>(action.source));
+    }
+    if (action.type == ActionType::Call)
+    {
+      return action.source >= 0 && action.target >= 0 &&
+             turnPlayer().callToRearGuard(static_cast<size_t>(action.source), static_cast<size_t>(action.target));
+    }
+    if (action.type == ActionType::EndMain)
+    {
+      beginBattlePhase();
+      return true;
+    }
+    return false;
+
+  case DecisionType::BattlePhase:
+    if (action.type == ActionType::Attack)
+    {
+      return declareAttack(action);
+    }
+    if (action.type == ActionType::EndBattle)
+    {
+      performEndPhase();
+      return true;
+    }
+    return false;
+
+  case DecisionType::Guard:
+    if (action.type == ActionType::Guard)
+    {
+      Player &defender = opponentPlayer();
+      if (action.source < 0 || static_cast<size_t>(action.source) >= defender.getHandSize())
+      {
+        return false;
+      }
+      defender.addCardToGuardianZoneFromHand(static_cast<size_t>(action.source));
+      return true;
+    }
+    if (action.type == ActionType::EndGuard)
+    {
+      resolveAttack();
+      return true;
+    }
+    return false;
+
+  default:
+    return false;
+  }
+}
+
+bool Match::isLegal(const GameAction &action) const
+{
+  const Player &turn_player = players[static_cast<size_t>(current_player_idx)];
+  switch (pending)
+  {
+  case DecisionType::MainPhase:
+    switch (action.type)
+    {
+    case ActionType::Ride:
+      return action.source >= 0 && turn_player.canRide(static_cast<size_t>(action.source));
+    case ActionType::Call:
+      return action.source >= 0 && action.target >= 0 &&
+             turn_player.canCall(static_cast<size_t>(action.source), static_cast<size_t>(action.target));
+    default:
+      return action.type == ActionType::EndMain;
+    }
+
+  case DecisionType::BattlePhase:
+    return action.type == ActionType::EndBattle || (action.type == ActionType::Attack && isValidAttack(action));
+
+  case DecisionType::Guard:
+    if (action.type == ActionType::Guard)
+    {
+      return action.source >= 0 &&
+             static_cast<size_t>(action.source) < players[static_cast<size_t>(1 - current_player_idx)].getHandSize();
+    }
+    return action.type == ActionType::EndGuard;
+
+  default:
+    return false;
+  }
+}
+
+uint64_t Match::checksum() const
+{
+  StateHash hash;
+  hash.addInt(current_player_idx);
+  hash.addInt(turn_count);
+  hash.addByte(static_cast<uint8_t>(pending));
+  hash.addInt(attack.attacker_idx);
+  hash.addInt(attack.target_idx);
+  hash.addInt(attack.booster_idx);
+  hash.addInt(attack.power);
+  hash.addInt(attack.critical);
+  hash.addByte(static_cast<uint8_t>(end_reason));
+  hash.addInt(winner_idx);
+  players[0].hashState(hash);
+  players[1].hashState(hash);
+  return hash.get();
+}
+
+void Match::dumpState(std::ostream &out) const
+{
+  out << "turn " << turn_count << ", current player " << current_player_idx
+      << ", pending " << static_cast<int>(pending) << ", end " << static_cast<int>(end_reason)
+      << ", winner " << winner_idx << "\n";
+  out << "attack: attacker " << attack.attacker_idx << ", target " << attack.target_idx
+      << ", booster " << attack.booster_idx << ", power " << attack.power << ", critical " << attack.critical << "\n";
+  for (int i = 0; i < 2; ++i)
+  {
+    out << "\n[player " << i << "]\n";
+    players[static_cast<size_t>(i)].dumpState(out);
+  }
+}
+
+void Match::saveState(StateEncoder &out) const
+{
+  out.addInt(current_player_idx);
+  out.addInt(turn_count);
+  out.addUnsigned(static_cast<uint64_t>(pending));
+  out.addInt(attack.attacker_idx);
+  out.addInt(attack.target_idx);
+  out.addInt(attack.booster_idx);
+  out.addInt(attack.power);
+  out.addInt(attack.critical);
+  out.addUnsigned(static_cast<uint64_t>(end_reason));
+  out.addInt(winner_idx);
+  players[0].saveState(out);
+  players[1].saveState(out);
+}
+
+bool Match::loadState(StateDecoder &in)
+{
+  current_player_idx = in.readInt() == 1 ? 1 : 0;
+  turn_count = static_cast<int>(in.readInt());
+  pending = static_cast<DecisionType>(in.readUnsigned());
+  attack.attacker_idx = static_cast<int>(in.readInt());
+  attack.target_idx = static_cast<int>(in.readInt());
+  attack.booster_idx = static_cast<int>(in.readInt());
+  attack.power = static_cast<int>(in.readInt());
+  attack.critical = static_cast<int>(in.readInt());
+  end_reason = static_cast<MatchEnd>(in.readUnsigned());
+  winner_idx = static_cast<int>(in.readInt());
+  players[0].loadState(in);
+  players[1].loadState(in);
+  return in.isValid() && in.isAtEnd();
+}
@@ -0,0 +1,270 @@
+// Match.h - ไฟล์ Header สำหรับเครื่องดำเนินเกม 1 แมตช์ (Match Engine)
+// ลำดับเทิร์นทั้งหมด (Stand → Draw → Main → Battle → End) ถูกเขียนเป็น state machine
+// ที่เดินเกมไปจนถึงจุดที่ต้องรอผู้เล่นตัดสินใจ แล้วคืนการควบคุมกลับทันที
+// เมื่อได้รับการกระทำ (GameAction) ผ่าน submit() ก็จะเดินเกมต่อจากจุดเดิม
+// แมตช์ที่รอผู้เล่นอยู่จึงไม่ต้องมีเธรดหรือ call stack ค้างไว้ ใช้หน่วยความจำคงที่ต่อแมตช์
+#ifndef MATCH_H
+#define MATCH_H
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iosfwd>
+#include "Player.h"
+#include "MatchArena.h"
+#include "Trace.h"
+
+class Match;
+class StateEncoder;
+class StateDecoder;
+
+// ชนิดของการตัดสินใจที่แมตช์กำลังรออยู่
+enum class DecisionType : uint8_t
+{
+  None,        // แมตช์ยังไม่เริ่มหรือจบแล้ว
+  MainPhase,   // ผู้เล่นเทิร์นนี้: Ride / Call / ไป Battle Phase
+  BattlePhase, // ผู้เล่นเทิร์นนี้: ประกาศโจมตี / จบ Battle Phase
+  Guard        // ฝ่ายป้องกัน: วางการ์ด Guard / จบการ Guard
+};
+
+// ชนิดของการกระทำที่ผู้เล่นส่งเข้ามา
+enum class ActionType : uint8_t
+{
+  Ride,      // source = ดัชนีการ์ดบนมือ
+  Call,      // source = ดัชนีการ์ดบนมือ, target = ตำแหน่ง RC
+  EndMain,   // ไป Battle Phase
+  Attack,    // source = ดัชนีสถานะของ Attacker, target = ดัชนีสถานะของเป้าหมาย, booster = ดัชนีสถานะของ Booster หรือ -1
+  EndBattle, // จบ Battle Phase และเข้าสู่ End Phase
+  Guard,     // source = ดัชนีการ์ดบนมือ
+  EndGuard   // จบการ Guard และคำนวณผลการต่อสู้
+};
+
+// การกระทำ 1 ครั้ง - ขนาดเล็กพอจะเก็บในคิวหรือส่งผ่านเครือข่ายได้โดยตรง
+struct GameAction
+{
+  ActionType type;
+  int8_t source = -1;
+  int8_t target = -1;
+  int8_t booster = -1;
+
+  static GameAction ride(int hand_index) { return {ActionType::Ride, narrow(hand_index)}; }
+  static GameAction call(int hand_index, int rc_slot) { return {ActionType::Call, narrow(hand_index), narrow(rc_slot)}; }
+  static GameAction endMain() { return {ActionType::EndMain}; }
+  static GameAction attack(int attacker_idx, int target_idx, int booster_idx = -1)
+  {
+    return {ActionType::Attack, narrow(attacker_idx), narrow(target_idx), narrow(booster_idx)};
+  }
+  static GameAction endBattle() { return {ActionType::EndBattle}; }
+  static GameAction guard(int hand_index) { return {ActionType::Guard, narrow(hand_index)}; }
+  static GameAction endGuard() { return {ActionType::EndGuard}; }
+
+  // ค่าที่เกินช่วงของ int8_t จะกลายเป็น INT8_MIN ซึ่งไม่ตรงกับตำแหน่งใดเลย (ถูกปฏิเสธโดย Match::submit)
+  static int8_t narrow(int value)
+  {
+    return (value >= -1 && value <= INT8_MAX) ? static_cast<int8_t>(value) : INT8_MIN;
+  }
+};
+
+// สาเหตุที่แมตช์จบ
+enum class MatchEnd : uint8_t
+{
+  None,           // ยังเล่นอยู่
+  DrawDeckOut,    // จั่วการ์ดใน Draw Phase ไม่ได้
+  DamageDeckOut,  // ทำ Damage Check ไม่ได้เพราะเด็คหมด
+  DamageLimit,    // ได้รับดาเมจครบระหว่าง Damage Check
+  EndPhaseDamage, // ตรวจพบดาเมจครบตอน End Phase
+  TurnLimit,      // เล่นครบจำนวนเทิร์นสูงสุด (ไม่มีผู้ชนะ)
+  Conceded        // ผู้เล่นยอมแพ้หรือออกจากแมตช์
+};
+
+// ข้อมูลการโจมตีที่กำลังดำเนินอยู่
+struct AttackState
+{
+  int attacker_idx = -1; // ดัชนีสถานะของ Attacker
+  int target_idx = -1;   // ดัชนีสถานะของเป้าหมาย
+  int booster_idx = -1;  // ดัชนีสถานะของ Booster (-1 = ไม่ Boost)
+  int power = 0;         // พลังโจมตีรวม (รวม Boost และ Drive Trigger)
+  int critical = 0;      // คริติคอลรวม
+};
+
+// ตัวรับเหตุการณ์จากแมตช์ - ใช้แสดงผลหรือบันทึก ไม่มีผลต่อกติกาของเกม
+// ทุกเมธอดถูกเรียกระหว่าง submit() ตามลำดับที่เกิดขึ้นจริง
+class MatchObserver
+{
+public:
+  virtual ~MatchObserver() = default;
+
+  virtual void onTurnStart(Player & /*turn_player*/, int /*turn_number*/) {}
+  virtual void onPhaseTransition(const std::string & /*from*/, const std::string & /*to*/) {}
+  virtual void onDriveCheckBegin(Player & /*attacker*/) {}
+  virtual void onDriveCheckEnd(Player & /*attacker*/) {}
+  virtual void onAttackPower(Player & /*attacker*/, Player & /*defender*/, const AttackState & /*attack*/) {}
+  virtual void onBattleResult(Player & /*attacker*/, Player & /*defender*/, const AttackState & /*attack*/, int /*defense_power*/) {}
+  virtual void onDamageCheck(Player & /*defender*/, int /*check_number*/, int /*total_checks*/) {}
+  virtual void onDamageRevealed(Player & /*defender*/, const Card & /*damage_card*/) {}
+  virtual void onDamageTaken(Player & /*defender*/, const TriggerOutput & /*trigger*/) {}
+  virtual void onAttackEnd(Player & /*attacker*/) {}
+  virtual void onEndPhase(Player & /*turn_player*/) {}
+  virtual void onTurnEnd(Player & /*turn_player*/) {}
+  virtual void onGameOver(Match & /*match*/) {}
+};
+
+// ตัวบันทึกแมตช์ (เช่น ReplayWriter) - ได้รับทุกการกระทำที่ยอมรับ และสถานะ ณ จุดจบเทิร์น/จบเกม
+// การกระทำถูกส่งมาก่อนผลที่ตามมา (จบเทิร์นหรือจบเกมที่เกิดจากการกระทำนั้นจะตามมาทีหลัง)
+class MatchRecorder
+{
+public:
+  virtual ~MatchRecorder() = default;
+
+  virtual void recordAction(const GameAction &action) = 0;
+  virtual void recordTurnEnd(const Match &match) = 0;               // หลัง End Phase ก่อนส่งเทิร์นให้อีกฝ่าย
+  virtual void recordGameOver(const Match &match) = 0;              // รวมถึงการยอมแพ้
+  virtual void recordTurnStart(const Match & /*match*/) {}          // เทิร์นใหม่ถึงการตัดสินใจแรกใน Main Phase
+  virtual void recordTriggers(int /*player_idx*/, int /*count*/) {} // การ์ด Trigger ที่เปิดได้จาก Drive/Damage Check
+};
+
+// ส่งต่อทุกเหตุการณ์ให้ตัวบันทึกหลายตัวตามลำดับที่เพิ่ม (เช่น replay และสถิติของแมตช์เดียวกัน)
+class MatchRecorderGroup : public MatchRecorder
+{
+private:
+  std::vector<MatchRecorder *> recorders;
+
+public:
+  void add(MatchRecorder *recorder) { recorders.push_back(recorder); }
+  bool isEmpty() const { return recorders.empty(); }
+
+  void recordAction(const GameAction &action) override
+  {
+    for (MatchRecorder *recorder : recorders)
+    {
+      recorder->recordAction(action);
+    }
+  }
+  void recordTurnEnd(const Match &match) override
+  {
+    for (MatchRecorder *recorder : recorders)
+    {
+      recorder->recordTurnEnd(match);
+    }
+  }
+  void recordGameOver(const Match &match) override
+  {
+    for (MatchRecorder *recorder : recorders)
+    {
+      recorder->recordGameOver(match);
+    }
+  }
+  void recordTurnStart(const Match &match) override
+  {
+    for (MatchRecorder *recorder : recorders)
+    {
+      recorder->recordTurnStart(match);
+    }
+  }
+  void recordTriggers(int player_idx, int count) override
+  {
+    for (MatchRecorder *recorder : recorders)
+    {
+      recorder->recordTriggers(player_idx, count);
+    }
+  }
+};
+
+// คลาส Match - ถือสถานะทั้งหมดของเกม 1 แมตช์ และเดินเกมตามการกระทำที่ได้รับ
+class Match
+{
+public:
+  static constexpr int MAX_TURNS = 50;         // จำนวนเทิร์นสูงสุดก่อนจบการจำลอง
+  static constexpr uint32_t RULES_VERSION = 1; // เพิ่มเมื่อกติกาเปลี่ยนจนเดินเกมจาก seed และการกระทำเดิมได้ผลต่างไป
+
+private:
+  MatchArenaHandle arena;        // หน่วยความจำของสำรับและโซนการ์ดทั้งหมด (ต้องประกาศก่อน players เพื่อถูกคืนทีหลัง)
+  std::array<Player, 2> players; // ผู้เล่นทั้งสองฝ่าย
+  int current_player_idx;        // ผู้เล่นเจ้าของเทิร์น (0 หรือ 1)
+  int turn_count;                // จำนวนเทิร์นที่เริ่มไปแล้ว
+  DecisionType pending;          // การตัดสินใจที่กำลังรอ
+  AttackState attack;            // การโจมตีที่รอฝ่ายป้องกัน Guard
+  MatchEnd end_reason;           // สาเหตุที่จบเกม
+  int winner_idx;                // ผู้ชนะ (-1 = ยังไม่จบหรือไม่มีผู้ชนะ)
+  MatchObserver *observer;       // ตัวรับเหตุการณ์ (nullptr = ไม่มี)
+  MatchObserver null_observer;   // ใช้แทนเมื่อไม่ได้ตั้ง observer
+  MatchRecorder *recorder;       // ตัวบันทึกแมตช์ (nullptr = ไม่บันทึก)
+  TraceInterval phase_span;      // Main/Battle Phase ที่กำลังรอการตัดสินใจ (ไม่ถูกคัดลอกไปยังสำเนาของแมตช์)
+  TraceInterval guard_span;      // Guard Step ที่กำลังรอฝ่ายป้องกัน
+
+  MatchObserver &events() { return observer ? *observer : null_observer; }
+  Player &turnPlayer() { return players[static_cast<size_t>(current_player_idx)]; }
+  Player &opponentPlayer() { return players[static_cast<size_t>(1 - current_player_idx)]; }
+
+  // ขั้นตอนภายในที่เดินเกมต่อจนถึงการตัดสินใจครั้งถัดไป
+  void beginTurn();
+  void beginBattlePhase();
+  bool isValidAttack(const GameAction &action) const;
+  bool declareAttack(const GameAction &action);
+  void resolveAttack();
+  void performEndPhase();
+  void finish(MatchEnd reason, int winner);
+  bool apply(const GameAction &action);
+  void record(const GameAction &action);
+
+public:
+  // สำรับของทั้งสองฝ่ายถูกคัดลอกลงใน arena ของแมตช์ (รุ่น const Deck & ไม่ต้องสร้างสำเนาชั่วคราวก่อน)
+  Match(const std::string &player1_name, Deck &&player1_deck,
+        const std::string &player2_name, Deck &&player2_deck);
+  Match(const std::string &player1_name, const Deck &player1_deck,
+        const std::string &player2_name, const Deck &player2_deck);
+
+  // สำเนาของแมตช์ได้ arena ใหม่ของตัวเอง (เช่นการจำลองของ RolloutSearch)
+  Match(const Match &other);
+  Match(Match &&other) = default;
+  Match &operator=(const Match &) = delete;
+  Match &operator=(Match &&) = delete;
+
+  void setObserver(MatchObserver *new_observer) { observer = new_observer; }
+  void setRecorder(MatchRecorder *new_recorder) { recorder = new_recorder; }
+
+  // วาง starter และจั่วมือเริ่มต้นของทั้งสองฝ่าย (คืนค่า false ถ้าไม่พบ starter)
+  bool setup(const std::string &starter_code_name);
+
+  // เหมือน setup() แต่สับสำรับด้วย seed ที่กำหนด - แมตช์ที่ใช้ seed และการกระทำชุดเดียวกันจะได้ผลเหมือนกันทุกเครื่อง
+  bool setup(const std::string &starter_code_name, uint64_t shuffle_seed);
+
+  // เริ่มเทิร์นแรกแล้วเดินเกมจนถึงการตัดสินใจครั้งแรก
+  void start(int first_player_idx);
+
+  // ส่งการกระทำของผู้เล่นที่ต้องตัดสินใจ
+  // คืนค่า false ถ้าการกระทำไม่ถูกต้องในสถานะปัจจุบัน (สถานะเกมจะไม่เปลี่ยน)
+  bool submit(const GameAction &action);
+
+  // submit(action) จะยอมรับการกระทำนี้หรือไม่ - ตรวจโดยไม่เปลี่ยนสถานะ (ใช้สร้างรายการการกระทำที่ทำได้)
+  bool isLegal(const GameAction &action) const;
+
+  // ผู้เล่นยอมแพ้ (เช่น หลุดการเชื่อมต่อ) - อีกฝ่ายชนะทันที
+  void concede(int player_idx);
+
+  // --- ฟังก์ชันเข้าถึงข้อมูล (Getters) ---
+  DecisionType getPendingDecision() const { return pending; }
+  int getActingPlayerIndex() const; // ผู้เล่นที่ต้องตัดสินใจ (-1 = ไม่มี)
+  int getCurrentPlayerIndex() const { return current_player_idx; }
+  int getTurnCount() const { return turn_count; }
+  const AttackState &getAttack() const { return attack; }
+  bool isOver() const { return end_reason != MatchEnd::None; }
+  MatchEnd getEndReason() const { return end_reason; }
+  int getWinnerIndex() const { return winner_idx; }
+  Player &getPlayer(int index) { return players[static_cast<size_t>(index)]; }
+  const Player &getPlayer(int index) const { return players[static_cast<size_t>(index)]; }
+
+  // checksum 64 บิตของสถานะทั้งหมด (รวมมือและลำดับสำรับของทั้งสองฝ่าย) ใช้ตรวจว่า 2 เครื่องยังเดินเกมตรงกัน
+  uint64_t checksum() const;
+
+  // เขียนสถานะทั้งหมดเป็นข้อความธรรมดา ใช้เทียบหาจุดที่ต่างกันเมื่อ checksum ไม่ตรง
+  void dumpState(std::ostream &out) const;
+
+  // บันทึก/โหลดสถานะทั้งหมด (ยกเว้นชื่อผู้เล่น) - ใช้ทำ keyframe ของ replay
+  // loadState() คืนค่า false ถ้าข้อมูลเสีย (สถานะของแมตช์จะใช้ต่อไม่ได้)
+  void saveState(StateEncoder &out) const;
+  bool loadState(StateDecoder &in);
+};
+
+#endif // MATCH_H
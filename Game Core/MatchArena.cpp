@@ -0,0 +1,113 @@
+// MatchArena.cpp - ไฟล์ Source สำหรับหน่วยความจำแบบ arena ของแมตช์และคลัง arena ของแต่ละเธรด
+#include "MatchArena.h"
+#include <new>
+#include <cstdint>
+#include <algorithm>
+
+static const size_t MAX_POOLED_ARENAS = 4; // arena ว่างที่เก็บไว้ต่อเธรด (ที่เกินถูกคืนให้ระบบ)
+
+MatchArena::MatchArena() : block_idx(0), cursor(nullptr), limit(nullptr)
+{
+}
+
+MatchArena::~MatchArena()
+{
+  for (const Block &block : blocks)
+  {
+    ::operator delete(block.memory);
+  }
+}
+
+void MatchArena::reset()
+{
+  block_idx = 0;
+  cursor = blocks.empty() ? nullptr : blocks[0].memory;
+  limit = blocks.empty() ? nullptr : blocks[0].memory + blocks[0].size;
+}
+
+size_t MatchArena::getReservedBytes() const
+{
+  size_t total = 0;
+  for (const Block &block : blocks)
+  {
+    total += block.size;
+  }
+  return total;
+}
+
+// ย้ายไปก้อนถัดไปที่จุได้อย่างน้อย min_bytes (ใช้ก้อนเดิมที่จองไว้ก่อน ถ้าไม่พอจึงจองก้อนใหม่ขนาดเป็น 2 เท่า)
+void MatchArena::useNextBlock(size_t min_bytes)
+{
+  size_t next = blocks.empty() || cursor == nullptr ? 0 : block_idx + 1;
+  if (next >= blocks.size() || blocks[next].size < min_bytes)
+  {
+    size_t size = blocks.empty() ? FIRST_BLOCK_BYTES : blocks.back().size * 2;
+    size = std::max(size, min_bytes);
+    Block block{static_cast<unsigned char *>(::operator new(size)), size};
+    blocks.insert(blocks.begin() + static_cast<std::ptrdiff_t>(std::min(next, blocks.size())), block);
+  }
+  block_idx = next;
+  cursor = blocks[next].memory;
+  limit = blocks[next].memory + blocks[next].size;
+}
+
+void *MatchArena::do_allocate(size_t bytes, size_t alignment)
+{
+  for (;;)
+  {
+    if (cursor)
+    {
+      uintptr_t address = reinterpret_cast<uintptr_t>(cursor);
+      uintptr_t aligned = (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+      if (aligned + bytes <= reinterpret_cast<uintptr_t>(limit))
+      {
+        cursor = reinterpret_cast<unsigned char *>(aligned + bytes);
+        return reinterpret_cast<void *>(aligned);
+      }
+    }
+    useNextBlock(bytes + alignment);
+  }
+}
+
+// --- คลัง arena ของแต่ละเธรด ---
+
+struct MatchArenaPool
+{
+  std::vector<MatchArena *> idle;
+  ~MatchArenaPool();
+};
+
+// ตั้งเป็นจริงเมื่อคลังของเธรดถูกทำลายแล้ว (แมตช์ที่ถูกทำลายหลังจากนั้นคืน arena ให้ระบบโดยตรง)
+static thread_local bool pool_closed = false;
+static thread_local MatchArenaPool pool;
+
+MatchArenaPool::~MatchArenaPool()
+{
+  pool_closed = true;
+  for (MatchArena *arena : idle)
+  {
+    delete arena;
+  }
+}
+
+void MatchArenaReturn::operator()(MatchArena *arena) const
+{
+  arena->reset();
+  if (pool_closed || pool.idle.size() >= MAX_POOLED_ARENAS)
+  {
+    delete arena;
+    return;
+  }
+  pool.idle.push_back(arena);
+}
+
+MatchArenaHandle acquireMatchArena()
+{
+  if (!pool_closed && !pool.idle.empty())
+  {
+    MatchArena *arena = pool.idle.back();
+    pool.idle.pop_back();
+    return MatchArenaHandle(arena);
+  }
+  return MatchArenaHandle(new MatchArena());
+}
@@ -0,0 +1,62 @@
+// MatchArena.h - ไฟล์ Header สำหรับหน่วยความจำแบบ arena ของแมตช์ (std::pmr::memory_resource)
+// สำรับ โซนการ์ดทุกโซน และข้อความของการ์ดในแมตช์ถูกจองต่อท้ายกันใน arena ของแมตช์นั้น (bump pointer)
+// การคืนหน่วยความจำทีละชิ้นไม่ทำอะไร ทั้งหมดถูกคืนพร้อมกันด้วย reset() ตอนแมตช์จบ ซึ่งใช้เวลาคงที่
+// ก้อนหน่วยความจำที่จองไว้แล้วไม่ถูกคืนให้ระบบ แมตช์ถัดไปบนเธรดเดียวกันจึงใช้ก้อนเดิมต่อได้ทันที
+//
+// Match ยืม arena จากคลังของเธรดที่สร้างแมตช์ (acquireMatchArena) และคืนเมื่อแมตช์ถูกทำลาย
+// ผู้จำลองเกมจำนวนมาก (fibo_selfplay, RolloutSearch, VecEnv) จึงไม่ต้องเรียก malloc/free ระหว่างเกมเลย
+#ifndef MATCHARENA_H
+#define MATCHARENA_H
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <memory_resource>
+
+class MatchArena : public std::pmr::memory_resource
+{
+public:
+  static const size_t FIRST_BLOCK_BYTES = 64 * 1024; // พอสำหรับสถานะของแมตช์ปกติทั้งแมตช์
+
+private:
+  struct Block
+  {
+    unsigned char *memory;
+    size_t size;
+  };
+  std::vector<Block> blocks; // ก้อนที่จองไว้แล้ว (ใช้ซ้ำหลัง reset)
+  size_t block_idx;          // ก้อนที่กำลังใช้
+  unsigned char *cursor;     // ตำแหน่งว่างถัดไปในก้อนที่กำลังใช้
+  unsigned char *limit;      // ท้ายก้อนที่กำลังใช้
+
+  void useNextBlock(size_t min_bytes);
+
+protected:
+  void *do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void * /*memory*/, size_t /*bytes*/, size_t /*alignment*/) override {}
+  bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+public:
+  MatchArena();
+  ~MatchArena() override;
+  MatchArena(const MatchArena &) = delete;
+  MatchArena &operator=(const MatchArena &) = delete;
+
+  // คืนหน่วยความจำทั้งหมดพร้อมกัน (ต้องไม่มีออบเจ็กต์ที่ยังใช้หน่วยความจำของ arena นี้อยู่)
+  void reset();
+
+  size_t getReservedBytes() const; // ขนาดรวมของก้อนที่จองไว้
+};
+
+// คืน arena ให้คลังของเธรดที่ทำลายแมตช์ (reset แล้วเก็บไว้ให้แมตช์ถัดไป)
+struct MatchArenaReturn
+{
+  void operator()(MatchArena *arena) const;
+};
+
+using MatchArenaHandle = std::unique_ptr<MatchArena, MatchArenaReturn>;
+
+// ยืม arena ว่างจากคลังของเธรดปัจจุบัน (สร้างใหม่ถ้าคลังว่าง)
+MatchArenaHandle acquireMatchArena();
+
+#endif // MATCHARENA_H
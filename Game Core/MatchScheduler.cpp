@@ -0,0 +1,112 @@
+// MatchScheduler.cpp - ไฟล์ Source สำหรับตัวจัดคิวแมตช์
+#include "MatchScheduler.h"
+#include <chrono>
+
+MatchScheduler::MatchScheduler() : next_id(1), stopping(false)
+{
+}
+
+MatchId MatchScheduler::addMatch(std::unique_ptr<Match> match)
+{
+  MatchId id = next_id++;
+  matches.emplace(id, std::move(match));
+  return id;
+}
+
+Match *MatchScheduler::findMatch(MatchId id)
+{
+  auto it = matches.find(id);
+  return (it != matches.end()) ? it->second.get() : nullptr;
+}
+
+void MatchScheduler::removeMatch(MatchId id)
+{
+  matches.erase(id);
+}
+
+void MatchScheduler::post(MatchId id, int player_idx, const GameAction &action)
+{
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    incoming.push_back({id, player_idx, action});
+  }
+  queue_ready.notify_one();
+}
+
+size_t MatchScheduler::runPending()
+{
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    processing.swap(incoming);
+  }
+
+  // ประมวลผลนอก lock เพื่อให้เธรดอื่นส่งข้อมูลเข้าคิวต่อได้ระหว่างเดินเกม
+  for (const QueuedAction &queued : processing)
+  {
+    auto it = matches.find(queued.match_id);
+    if (it == matches.end())
+    {
+      continue; // แมตช์จบหรือถูกนำออกไปแล้ว
+    }
+    Match &match = *it->second;
+    bool accepted = queued.player_idx == match.getActingPlayerIndex() && match.submit(queued.action);
+    if (update_handler)
+    {
+      update_handler(queued.match_id, queued.player_idx, match, accepted);
+    }
+    // handler อาจนำแมตช์ออกไปเองแล้ว จึงต้องค้นหาใหม่ก่อนตรวจว่าจบหรือยัง
+    it = matches.find(queued.match_id);
+    if (it != matches.end() && it->second->isOver())
+    {
+      matches.erase(it);
+    }
+  }
+
+  size_t processed = processing.size();
+  processing.clear();
+  return processed;
+}
+
+size_t MatchScheduler::waitAndRun(int timeout_ms)
+{
+  {
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    auto has_work = [this]
+    { return !incoming.empty() || stopping; };
+    if (timeout_ms < 0)
+    {
+      queue_ready.wait(lock, has_work);
+    }
+    else
+    {
+      queue_ready.wait_for(lock, std::chrono::milliseconds(timeout_ms), has_work);
+    }
+  }
+  return runPending();
+}
+
+void MatchScheduler::run()
+{
+  while (true)
+  {
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex);
+      if (stopping)
+      {
+        stopping = false;
+        break;
+      }
+    }
+    waitAndRun();
+  }
+  runPending(); // ประมวลผลการกระทำที่ค้างอยู่ให้หมดก่อนออก
+}
+
+void MatchScheduler::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    stopping = true;
+  }
+  queue_ready.notify_all();
+}
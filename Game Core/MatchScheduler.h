@@ -0,0 +1,76 @@
+// MatchScheduler.h - ไฟล์ Header สำหรับตัวจัดคิวแมตช์ (Match Scheduler)
+// ดูแลหลายแมตช์พร้อมกันบน event loop เธรดเดียว: เธรดอื่น (เช่น เครือข่าย) ส่งการกระทำเข้าคิวผ่าน post()
+// แล้ว event loop จะปลุกเฉพาะแมตช์ที่มีข้อมูลเข้ามาและเดินเกมต่อจนถึงการตัดสินใจครั้งถัดไป
+// แมตช์ที่รอผู้เล่นอยู่ไม่ใช้ CPU และใช้หน่วยความจำเท่ากับสถานะของเกมเท่านั้น
+// หมายเหตุ: ข้อความที่เกมพิมพ์ระหว่างเดินเกมจะออกทาง Out() ของเธรด event loop
+// (ตั้ง NullSink ให้เธรดนั้นเมื่อไม่ต้องการแสดงผล)
+#ifndef MATCHSCHEDULER_H
+#define MATCHSCHEDULER_H
+
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <unordered_map>
+#include <cstdint>
+#include "Match.h"
+
+using MatchId = uint32_t;
+
+// การกระทำที่รอส่งให้แมตช์
+struct QueuedAction
+{
+  MatchId match_id;
+  int player_idx; // ผู้เล่นที่ส่งการกระทำ (ต้องตรงกับผู้ที่แมตช์รอการตัดสินใจอยู่)
+  GameAction action;
+};
+
+class MatchScheduler
+{
+public:
+  // ถูกเรียกบนเธรดของ event loop หลังแมตช์เดินเกมจากการกระทำ 1 ครั้ง
+  // accepted = false เมื่อการกระทำไม่ถูกต้อง (ส่งผิดคนหรือผิดกติกา) และสถานะเกมไม่เปลี่ยน
+  using UpdateHandler = std::function<void(MatchId, int player_idx, Match &, bool accepted)>;
+
+private:
+  std::unordered_map<MatchId, std::unique_ptr<Match>> matches; // แมตช์ที่ยังเล่นอยู่ (เข้าถึงจาก event loop เท่านั้น)
+  MatchId next_id;                                             // หมายเลขแมตช์ถัดไป
+  UpdateHandler update_handler;
+
+  // คิวข้อมูลเข้า - ป้องกันด้วย mutex เพราะถูกเขียนจากหลายเธรด
+  std::mutex queue_mutex;
+  std::condition_variable queue_ready;
+  std::vector<QueuedAction> incoming;
+  std::vector<QueuedAction> processing; // สลับกับ incoming เพื่อไม่ต้องจองหน่วยความจำใหม่ทุกรอบ
+  bool stopping;
+
+public:
+  MatchScheduler();
+  MatchScheduler(const MatchScheduler &) = delete;
+  MatchScheduler &operator=(const MatchScheduler &) = delete;
+
+  void setUpdateHandler(UpdateHandler handler) { update_handler = std::move(handler); }
+
+  // รับแมตช์เข้ามาดูแล คืนค่าหมายเลขแมตช์ (เรียก start() ก่อนหรือหลังก็ได้)
+  MatchId addMatch(std::unique_ptr<Match> match);
+  Match *findMatch(MatchId id);
+  void removeMatch(MatchId id);
+  size_t getMatchCount() const { return matches.size(); }
+
+  // ส่งการกระทำเข้าคิว - เรียกได้จากทุกเธรด
+  void post(MatchId id, int player_idx, const GameAction &action);
+
+  // เดินเกมทุกแมตช์ที่มีการกระทำรออยู่ในคิว คืนค่าจำนวนการกระทำที่ประมวลผล
+  // แมตช์ที่จบแล้วจะถูกนำออกหลังแจ้ง update handler
+  size_t runPending();
+
+  // รอจนมีการกระทำเข้าคิว (ไม่เกิน timeout_ms, ค่าติดลบ = รอจนกว่าจะมี) แล้วประมวลผล
+  size_t waitAndRun(int timeout_ms = -1);
+
+  // วนรอบ event loop จนกว่าจะเรียก stop() (จากเธรดใดก็ได้)
+  void run();
+  void stop();
+};
+
+#endif // MATCHSCHEDULER_H
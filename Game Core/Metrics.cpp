@@ -0,0 +1,334 @@
+// Metrics.cpp - ไฟล์ Source สำหรับตัวนับ ฮิสโตแกรม และการรายงาน metric
+#include "Metrics.h"
+#include <cmath>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+size_t nextMetricShard()
+{
+  static std::atomic<size_t> next_shard{0};
+  return next_shard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+}
+
+uint64_t MetricCounter::get() const
+{
+  uint64_t total = 0;
+  for (const Shard &shard : shards)
+  {
+    total += shard.value.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+// ค่าน้อยกว่า 64 มีช่องของตัวเอง ค่าที่มากกว่าใช้ 6 บิตบนสุด (บิตนำ + 5 บิตย่อย) เป็นช่อง
+size_t MetricHistogram::bucketIndex(uint64_t value)
+{
+  const uint64_t limit = (uint64_t(1) << MAX_VALUE_BITS) - 1;
+  if (value > limit)
+  {
+    value = limit;
+  }
+  if (value < (uint64_t(2) << SUB_BUCKET_BITS))
+  {
+    return static_cast<size_t>(value);
+  }
+  int msb = 0;
+  for (uint64_t rest = value >> 1; rest; rest >>= 1)
+  {
+    ++msb;
+  }
+  int shift = msb - SUB_BUCKET_BITS;
+  return (static_cast<size_t>(shift + 1) << SUB_BUCKET_BITS) +
+         static_cast<size_t>((value >> shift) - (uint64_t(1) << SUB_BUCKET_BITS));
+}
+
+uint64_t MetricHistogram::bucketLowerBound(size_t index)
+{
+  if (index < (size_t(2) << SUB_BUCKET_BITS))
+  {
+    return index;
+  }
+  size_t group = index >> SUB_BUCKET_BITS;
+  uint64_t mantissa = (index & ((size_t(1) << SUB_BUCKET_BITS) - 1)) + (uint64_t(1) << SUB_BUCKET_BITS);
+  return mantissa << (group - 1);
+}
+
+uint64_t MetricHistogram::bucketUpperBound(size_t index)
+{
+  if (index < (size_t(2) << SUB_BUCKET_BITS))
+  {
+    return index + 1;
+  }
+  size_t group = index >> SUB_BUCKET_BITS;
+  uint64_t mantissa = (index & ((size_t(1) << SUB_BUCKET_BITS) - 1)) + (uint64_t(1) << SUB_BUCKET_BITS);
+  return (mantissa + 1) << (group - 1);
+}
+
+MetricHistogram::MetricHistogram() : shards(new Shard[METRIC_SHARDS]())
+{
+}
+
+void MetricHistogram::record(uint64_t value)
+{
+  Shard &shard = shards[metricShardIndex()];
+  shard.counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  shard.sum.fetch_add(value, std::memory_order_relaxed);
+  uint64_t current_max = shard.max.load(std::memory_order_relaxed);
+  while (value > current_max && !shard.max.compare_exchange_weak(current_max, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+MetricHistogramSnapshot MetricHistogram::snapshot() const
+{
+  MetricHistogramSnapshot result;
+  result.counts.assign(BUCKET_COUNT, 0);
+  for (size_t s = 0; s < METRIC_SHARDS; ++s)
+  {
+    const Shard &shard = shards[s];
+    for (size_t idx = 0; idx < BUCKET_COUNT; ++idx)
+    {
+      uint64_t count = shard.counts[idx].load(std::memory_order_relaxed);
+      result.counts[idx] += count;
+      result.count += count;
+    }
+    result.sum += shard.sum.load(std::memory_order_relaxed);
+    result.max = std::max(result.max, shard.max.load(std::memory_order_relaxed));
+  }
+  return result;
+}
+
+uint64_t MetricHistogramSnapshot::valueAtPercentile(double percentile) const
+{
+  if (count == 0)
+  {
+    return 0;
+  }
+  uint64_t target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count)));
+  target = std::max<uint64_t>(1, std::min(target, count));
+  uint64_t seen = 0;
+  for (size_t idx = 0; idx < counts.size(); ++idx)
+  {
+    seen += counts[idx];
+    if (seen >= target)
+    {
+      return std::min(MetricHistogram::bucketUpperBound(idx) - 1, max);
+    }
+  }
+  return max;
+}
+
+MetricsRegistry &MetricsRegistry::global()
+{
+  static MetricsRegistry registry;
+  return registry;
+}
+
+MetricCounter &MetricsRegistry::counter(const std::string &name, const std::string &help, const std::string &labels)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  CounterEntry &entry = counters[name];
+  if (entry.help.empty())
+  {
+    entry.help = help;
+  }
+  std::unique_ptr<MetricCounter> &slot = entry.series[labels];
+  if (!slot)
+  {
+    slot.reset(new MetricCounter());
+  }
+  return *slot;
+}
+
+MetricHistogram &MetricsRegistry::histogram(const std::string &name, const std::string &help, double scale,
+                                            const std::string &labels)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  HistogramEntry &entry = histograms[name];
+  if (entry.series.empty())
+  {
+    entry.help = help;
+    entry.scale = scale;
+  }
+  std::unique_ptr<MetricHistogram> &slot = entry.series[labels];
+  if (!slot)
+  {
+    slot.reset(new MetricHistogram());
+  }
+  return *slot;
+}
+
+// ชื่อ series พร้อม labels เช่น fibo_triggers_total{kind="critical"}
+static std::string seriesName(const std::string &name, const std::string &labels, const std::string &extra = "")
+{
+  std::string joined = labels;
+  if (!extra.empty())
+  {
+    joined += joined.empty() ? extra : "," + extra;
+  }
+  return joined.empty() ? name : name + "{" + joined + "}";
+}
+
+void MetricsRegistry::writeText(std::ostream &out) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  for (const auto &entry : counters)
+  {
+    for (const auto &series : entry.second.series)
+    {
+      out << seriesName(entry.first, series.first) << " " << series.second->get() << "\n";
+    }
+  }
+  std::ostringstream line;
+  line << std::setprecision(4);
+  for (const auto &entry : histograms)
+  {
+    double scale = entry.second.scale;
+    for (const auto &series : entry.second.series)
+    {
+      MetricHistogramSnapshot snapshot = series.second->snapshot();
+      line.str("");
+      line << seriesName(entry.first, series.first) << " count=" << snapshot.count
+           << " mean=" << snapshot.mean() / scale
+           << " p50=" << snapshot.valueAtPercentile(50) / scale
+           << " p90=" << snapshot.valueAtPercentile(90) / scale
+           << " p99=" << snapshot.valueAtPercentile(99) / scale
+           << " p99.9=" << snapshot.valueAtPercentile(99.9) / scale
+           << " max=" << snapshot.max / scale;
+      out << line.str() << "\n";
+    }
+  }
+}
+
+// ขอบเขต le ของ Prometheus เป็น 2^k - 1 (ค่าที่บันทึกเป็นจำนวนเต็ม จึงนับช่องได้ตรงทุกขอบ)
+// จนถึงช่วงที่มีค่าสูงสุด ฮิสโตแกรมที่มีแต่ค่าน้อย (เช่นจำนวนการ์ด) จึงมีไม่กี่บรรทัด
+void MetricsRegistry::writePrometheus(std::ostream &out) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  for (const auto &entry : counters)
+  {
+    out << "# HELP " << entry.first << " " << entry.second.help << "\n";
+    out << "# TYPE " << entry.first << " counter\n";
+    for (const auto &series : entry.second.series)
+    {
+      out << seriesName(entry.first, series.first) << " " << series.second->get() << "\n";
+    }
+  }
+  std::ostringstream number;
+  number << std::setprecision(6);
+  for (const auto &entry : histograms)
+  {
+    double scale = entry.second.scale;
+    out << "# HELP " << entry.first << " " << entry.second.help << "\n";
+    out << "# TYPE " << entry.first << " histogram\n";
+    for (const auto &series : entry.second.series)
+    {
+      MetricHistogramSnapshot snapshot = series.second->snapshot();
+      uint64_t cumulative = 0;
+      size_t idx = 0;
+      for (int bits = 0; bits <= MetricHistogram::MAX_VALUE_BITS; ++bits)
+      {
+        uint64_t bound = uint64_t(1) << bits; // นับค่าที่น้อยกว่า bound
+        while (idx < snapshot.counts.size() && MetricHistogram::bucketUpperBound(idx) <= bound)
+        {
+          cumulative += snapshot.counts[idx++];
+        }
+        number.str("");
+        number << static_cast<double>(bound - 1) / scale;
+        out << seriesName(entry.first + "_bucket", series.first, "le=\"" + number.str() + "\"") << " " << cumulative
+            << "\n";
+        if (bound > snapshot.max)
+        {
+          break;
+        }
+      }
+      number.str("");
+      number << static_cast<double>(snapshot.sum) / scale;
+      out << seriesName(entry.first + "_bucket", series.first, "le=\"+Inf\"") << " " << snapshot.count << "\n";
+      out << seriesName(entry.first + "_sum", series.first) << " " << number.str() << "\n";
+      out << seriesName(entry.first + "_count", series.first) << " " << snapshot.count << "\n";
+    }
+  }
+}
+
+bool MetricsRegistry::writePrometheusFile(const std::string &path) const
+{
+  std::string temp_path = path + ".tmp";
+  {
+    std::ofstream file(temp_path);
+    if (!file)
+    {
+      return false;
+    }
+    writePrometheus(file);
+    if (!file)
+    {
+      return false;
+    }
+  }
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0)
+  {
+    std::remove(path.c_str()); // Windows ไม่ยอม rename ทับไฟล์ที่มีอยู่
+    return std::rename(temp_path.c_str(), path.c_str()) == 0;
+  }
+  return true;
+}
+
+static GameMetrics makeGameMetrics(MetricsRegistry &registry)
+{
+  GameMetrics metrics{
+      registry.counter("fibo_cards_drawn_total", "Cards drawn from the deck into the hand (draw phase, starting hand, draw triggers)"),
+      registry.counter("fibo_deck_shuffles_total", "Deck shuffles"),
+      registry.counter("fibo_attacks_total", "Attacks declared"),
+      registry.counter("fibo_attack_hits_total", "Attacks that hit (attack power >= defense power)"),
+      registry.counter("fibo_guards_total", "Attacks guarded with at least one card"),
+      registry.counter("fibo_games_total", "Games finished"),
+      {},
+      registry.histogram("fibo_guard_cards", "Cards placed in the guardian zone per guard"),
+      registry.histogram("fibo_game_turns", "Turns per finished game"),
+  };
+  static const char *const checks[2] = {"drive", "damage"};
+  static const char *const kinds[4] = {"critical", "draw", "heal", "other"};
+  for (int check = 0; check < 2; ++check)
+  {
+    for (int kind = 0; kind < 4; ++kind)
+    {
+      metrics.triggers[check][kind] =
+          registry.counter("fibo_triggers_total", "Trigger cards revealed by check and kind",
+                            std::string("check=\"") + checks[check] + "\",kind=\"" + kinds[kind] + "\"");
+    }
+  }
+  return metrics;
+}
+
+const GameMetrics &gameMetrics()
+{
+  static const GameMetrics metrics = makeGameMetrics(MetricsRegistry::global());
+  return metrics;
+}
+
+MetricHistogram &decisionLatencyMetric(const std::string &player_type)
+{
+  return MetricsRegistry::global().histogram("fibo_decision_latency_seconds", "Time taken by one decision", 1e9,
+                                             "player=\"" + player_type + "\"");
+}
+
+ScopedMetricsOutput::~ScopedMetricsOutput()
+{
+  if (path.empty())
+  {
+    return;
+  }
+  if (path == "-")
+  {
+    MetricsRegistry::global().writeText(std::cerr);
+  }
+  else if (!MetricsRegistry::global().writePrometheusFile(path))
+  {
+    std::fprintf(stderr, "เขียนไฟล์ metric '%s' ไม่ได้\n", path.c_str());
+  }
+}
@@ -0,0 +1,208 @@
+// Metrics.h - ไฟล์ Header สำหรับตัวนับและฮิสโตแกรมของเครื่องเกม (metrics registry)
+// ใช้เฝ้าดูความเร็วของบอทและความสมดุลของเกมระหว่างรันจริงโดยไม่ต้องเก็บ replay
+//
+// - MetricCounter แบ่งค่าเป็นหลายช่อง (shard) ตามเธรด แต่ละช่องอยู่คนละ cache line
+//   เธรดที่จำลองเกมพร้อมกันจึงไม่แย่ง cache line เดียวกัน (อ่านค่ารวมทุกช่องตอนรายงาน)
+// - MetricHistogram แบ่งช่วงค่าแบบ HDR (log-linear): 32 ช่องย่อยต่อช่วงกำลังสอง คลาดเคลื่อนไม่เกิน ~3%
+//   ตั้งแต่ 1 ถึง 2^40 (ราว 18 นาทีเมื่อเก็บเป็น ns) ค่าที่เกินถูกนับในช่องสุดท้าย
+// - รายงานได้ 2 แบบ: ข้อความสรุป (writeText) และไฟล์รูปแบบ Prometheus (writePrometheus)
+//   ไฟล์ Prometheus ถูกเขียนลงไฟล์ชั่วคราวแล้ว rename ทับ จึงใช้กับ textfile collector ของ node_exporter ได้ทันที
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <map>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iosfwd>
+#include "Simulation.h"
+
+static const size_t METRIC_SHARDS = 8; // จำนวนช่องของตัวนับ/ฮิสโตแกรมแต่ละตัว (เธรดที่เกินวนใช้ช่องซ้ำ)
+
+// ช่องของเธรดปัจจุบัน (กำหนดครั้งแรกที่ใช้ เรียงตามลำดับที่เธรดเริ่มบันทึก)
+size_t nextMetricShard();
+inline size_t metricShardIndex()
+{
+  thread_local size_t shard = nextMetricShard();
+  return shard;
+}
+
+class MetricCounter
+{
+private:
+  struct alignas(64) Shard
+  {
+    std::atomic<uint64_t> value{0};
+  };
+  std::array<Shard, METRIC_SHARDS> shards;
+
+public:
+  void add(uint64_t amount = 1) { shards[metricShardIndex()].value.fetch_add(amount, std::memory_order_relaxed); }
+  uint64_t get() const;
+};
+
+// ค่าของฮิสโตแกรม ณ เวลาหนึ่ง (รวมทุกช่องแล้ว)
+struct MetricHistogramSnapshot
+{
+  std::vector<uint64_t> counts; // จำนวนต่อช่อง (ดัชนีตาม MetricHistogram::bucketIndex)
+  uint64_t count = 0;
+  uint64_t sum = 0;
+  uint64_t max = 0;
+
+  // ค่าที่ percentile (0-100) ของข้อมูลน้อยกว่าหรือเท่ากับ (ขอบบนของช่อง ไม่เกิน max)
+  uint64_t valueAtPercentile(double percentile) const;
+  double mean() const { return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+};
+
+class MetricHistogram
+{
+public:
+  static const int SUB_BUCKET_BITS = 5;
+  static const int MAX_VALUE_BITS = 40;
+  static const size_t BUCKET_COUNT = static_cast<size_t>(MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+  static size_t bucketIndex(uint64_t value);
+  static uint64_t bucketLowerBound(size_t index);
+  static uint64_t bucketUpperBound(size_t index); // ไม่รวมค่านี้
+
+private:
+  struct alignas(64) Shard
+  {
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> counts{};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> max{0};
+  };
+  std::unique_ptr<Shard[]> shards;
+
+public:
+  MetricHistogram();
+  void record(uint64_t value);
+  MetricHistogramSnapshot snapshot() const;
+};
+
+// จับเวลาตั้งแต่สร้างจนออกจาก scope แล้วบันทึกเป็น ns ลงฮิสโตแกรม
+class MetricTimer
+{
+private:
+  MetricHistogram &histogram;
+  std::chrono::steady_clock::time_point started;
+
+public:
+  explicit MetricTimer(MetricHistogram &target) : histogram(target), started(std::chrono::steady_clock::now()) {}
+  ~MetricTimer()
+  {
+    histogram.record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count()));
+  }
+  MetricTimer(const MetricTimer &) = delete;
+  MetricTimer &operator=(const MetricTimer &) = delete;
+};
+
+// ทะเบียนของ metric ทั้งหมดในโปรแกรม - ตัวนับ/ฮิสโตแกรมที่คืนให้อยู่จนจบโปรแกรม จึงเก็บ reference ไว้ใช้ซ้ำได้
+// ชื่อใช้รูปแบบ Prometheus (fibo_<สิ่งที่นับ>_total สำหรับตัวนับ) ส่วน labels เขียนแบบ kind="critical",check="drive"
+class MetricsRegistry
+{
+private:
+  struct CounterEntry
+  {
+    std::string help;
+    std::map<std::string, std::unique_ptr<MetricCounter>> series; // labels -> ตัวนับ
+  };
+  struct HistogramEntry
+  {
+    std::string help;
+    double scale = 1; // หารค่าที่บันทึกด้วยค่านี้ตอนรายงาน (เช่น 1e9 เพื่อแปลง ns เป็นวินาที)
+    std::map<std::string, std::unique_ptr<MetricHistogram>> series;
+  };
+
+  mutable std::mutex mutex;
+  std::map<std::string, CounterEntry> counters;
+  std::map<std::string, HistogramEntry> histograms;
+
+public:
+  static MetricsRegistry &global();
+
+  MetricCounter &counter(const std::string &name, const std::string &help, const std::string &labels = "");
+  MetricHistogram &histogram(const std::string &name, const std::string &help, double scale = 1,
+                             const std::string &labels = "");
+
+  // ข้อความสรุป 1 บรรทัดต่อ series (ฮิสโตแกรมแสดง count, mean, p50, p90, p99, p99.9, max)
+  void writeText(std::ostream &out) const;
+  void writePrometheus(std::ostream &out) const;
+  bool writePrometheusFile(const std::string &path) const; // เขียนไฟล์ชั่วคราวแล้ว rename ทับ
+};
+
+// ตัวนับ/ฮิสโตแกรมของกติกาเกม - ภายใต้ ScopedSimulation (Simulation.h) ไม่ทำอะไรเลย
+// เกมจำลองของบอทจึงไม่ถูกนับรวมกับเกมจริง และไม่ต้องจ่ายค่า atomic ของตัวนับ
+class GameCounter
+{
+private:
+  MetricCounter *counter = nullptr;
+
+public:
+  GameCounter() = default;
+  GameCounter(MetricCounter &target) : counter(&target) {}
+  void add(uint64_t amount = 1) const
+  {
+    if (!isSimulating())
+    {
+      counter->add(amount);
+    }
+  }
+};
+
+class GameHistogram
+{
+private:
+  MetricHistogram *histogram = nullptr;
+
+public:
+  GameHistogram() = default;
+  GameHistogram(MetricHistogram &target) : histogram(&target) {}
+  void record(uint64_t value) const
+  {
+    if (!isSimulating())
+    {
+      histogram->record(value);
+    }
+  }
+};
+
+// metric ของกติกาเกมที่ Game Core บันทึกเอง (สร้างครั้งแรกที่เรียก)
+struct GameMetrics
+{
+  GameCounter cards_drawn;
+  GameCounter shuffles;
+  GameCounter attacks;
+  GameCounter hits;
+  GameCounter guards;
+  GameCounter games;
+  GameCounter triggers[2][4];     // [0 = Drive Check, 1 = Damage Check][critical, draw, heal, other]
+  GameHistogram cards_per_guard; // การ์ดใน Guardian Zone ต่อการ Guard 1 ครั้ง
+  GameHistogram turns_per_game;
+};
+
+const GameMetrics &gameMetrics();
+
+// เวลาที่ใช้ตัดสินใจ 1 ครั้ง แยกตามชนิดผู้เล่น (เช่น "human", "script", "remote", "rollout_search")
+MetricHistogram &decisionLatencyMetric(const std::string &player_type);
+
+// เขียน metric เมื่อออกจาก scope: path = "-" แสดงข้อความสรุปทาง stderr, อื่นๆ = ไฟล์ Prometheus (ว่าง = ไม่ทำอะไร)
+class ScopedMetricsOutput
+{
+private:
+  std::string path;
+
+public:
+  explicit ScopedMetricsOutput(const std::string &output_path) : path(output_path) {}
+  ~ScopedMetricsOutput();
+  ScopedMetricsOutput(const ScopedMetricsOutput &) = delete;
+  ScopedMetricsOutput &operator=(const ScopedMetricsOutput &) = delete;
+};
+
+#endif // METRICS_H
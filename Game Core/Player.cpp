@@ -4,36 +4,77 @@
 #include "Player.h"
 #include <optional>
 #include "Card.h"
+#include "CardTable.h"
+#include "StateHash.h"
+#include "StateCodec.h"
+#include "Trace.h"
+#include "Metrics.h"
+#include "AllocationProfile.h"
 #include "../UI System/UIHelper.h"
 #include "../UI System/MenuSystem.h"
+#include "../UI System/InputSource.h"
+#include "../UI System/OutputSink.h"
 #include <iostream>
 #include <algorithm>
-#include <iomanip>
 #include <sstream>
-#include <limits>
+#include <charconv>
+#include <stdexcept>
 
 // ฟังก์ชันช่วยสำหรับแสดงเส้นคั่นบนหน้าจอ
 void Player::printDisplayLine(char c, int length)
 {
-  std::cout << std::string(length, c) << std::endl;
+  Out() << std::string(length, c) << std::endl;
 }
 
 // Constructor - สร้างผู้เล่นใหม่พร้อมสำรับไพ่
-Player::Player(const std::string &player_name, Deck &&player_deck)
-    : name(player_name), deck(std::move(player_deck)), turn_count(0)
+Player::Player(const std::string &player_name, Deck &&player_deck, const allocator_type &alloc)
+    : name(player_name), deck(std::move(player_deck), alloc), turn_count(0)
 {
-  unit_is_standing.fill(true); // เริ่มต้นให้ทุกยูนิตอยู่ในสถานะยืน (Standing)
+  field_units.fill(INVALID_CARD_ID);  // เริ่มต้นด้วยสนามว่าง
+  unit_is_standing.fill(true);        // เริ่มต้นให้ทุกยูนิตอยู่ในสถานะยืน (Standing)
+  current_battle_power_buffs.fill(0); // บัฟต้องมีค่าเริ่มต้นที่แน่นอน เพราะรวมอยู่ใน checksum ของสถานะ
+  current_battle_crit_buffs.fill(0);
+}
+
+Player::Player(const std::string &player_name, const Deck &player_deck, const allocator_type &alloc)
+    : name(player_name), deck(player_deck, alloc), turn_count(0)
+{
+  field_units.fill(INVALID_CARD_ID);
+  unit_is_standing.fill(true);
+  current_battle_power_buffs.fill(0);
+  current_battle_crit_buffs.fill(0);
+}
+
+Player::Player(const Player &other, const allocator_type &alloc)
+    : name(other.name), deck(other.deck, alloc), turn_count(other.turn_count), hand(other.hand),
+      field_units(other.field_units), unit_is_standing(other.unit_is_standing), damage_zone(other.damage_zone),
+      soul(other.soul), drop_zone(other.drop_zone), guardian_zone(other.guardian_zone),
+      current_battle_power_buffs(other.current_battle_power_buffs),
+      current_battle_crit_buffs(other.current_battle_crit_buffs)
+{
+}
+
+CardId Player::idOf(const Card &card) const
+{
+  CardId id = deck.getCardTable().findId(card.getCodeNameView());
+  if (id == INVALID_CARD_ID)
+  {
+    throw std::invalid_argument("Player: card is not part of this player's deck");
+  }
+  return id;
 }
 
 // ฟังก์ชันช่วยสำหรับจั่วการ์ดจำนวนที่กำหนด
 void Player::drawCards(int num_to_draw)
 {
+  ALLOC_SCOPE(Player);
   for (int i = 0; i < num_to_draw; ++i)
   {
     std::optional<Card> drawn_card = deck.draw();
     if (drawn_card.has_value())
     {
-      hand.push_back(drawn_card.value());
+      hand.push_back(idOf(drawn_card.value()));
+      gameMetrics().cards_drawn.add();
     }
     else
     {
@@ -43,8 +84,10 @@ void Player::drawCards(int num_to_draw)
 }
 
 // เตรียมเกมเริ่มต้น โดยวาง starter และจั่วการ์ดเริ่มต้น
-bool Player::setupGame(const std::string &starter_code_name, int initial_hand_size)
+bool Player::setupGame(const std::string &starter_code_name, int initial_hand_size,
+                       std::optional<uint64_t> shuffle_seed)
 {
+  ALLOC_SCOPE(Player);
   // ค้นหาและดึง starter การ์ดจากสำรับ
   std::optional<Card> starter_card_opt = deck.removeCardByCodeName(starter_code_name);
   if (!starter_card_opt.has_value())
@@ -53,11 +96,18 @@ bool Player::setupGame(const std::string &starter_code_name, int initial_hand_si
   }
 
   // วาง starter ลงใน vanguard circle
-  vanguard_circle = starter_card_opt.value();
+  field_units[UNIT_STATUS_VC_IDX] = idOf(starter_card_opt.value());
   unit_is_standing[UNIT_STATUS_VC_IDX] = true;
 
   // สับสำรับและจั่วการ์ดเริ่มต้น
-  deck.shuffle();
+  if (shuffle_seed.has_value())
+  {
+    deck.shuffle(shuffle_seed.value());
+  }
+  else
+  {
+    deck.shuffle();
+  }
   drawCards(initial_hand_size);
   return true;
 }
@@ -71,6 +121,7 @@ void Player::performStandPhase()
 // จั่วการ์ด 1 ใบในเฟสจั่ว (Draw Phase)
 bool Player::performDrawPhase()
 {
+  ALLOC_SCOPE(Player);
   if (deck.isEmpty())
   {
     return false;
@@ -80,7 +131,8 @@ bool Player::performDrawPhase()
 }
 
 // ไรด์การ์ดจากมือลงบน Vanguard Circle
-bool Player::rideFromHand(size_t hand_card_index)
+// ตรวจเงื่อนไขการไรด์โดยไม่เปลี่ยนสถานะ
+bool Player::canRide(size_t hand_card_index) const
 {
   // ตรวจสอบความถูกต้องของ index
   if (hand_card_index >= hand.size())
@@ -88,46 +140,42 @@ bool Player::rideFromHand(size_t hand_card_index)
     return false;
   }
 
-  Card card_to_ride = hand[hand_card_index];
-  int current_vg_grade = vanguard_circle.has_value() ? vanguard_circle.value().getGrade() : -1;
-
-  // ตรวจสอบเงื่อนไขการไรด์
-  bool can_ride = false;
-  if (!vanguard_circle.has_value())
+  const CardTable &table = deck.getCardTable();
+  int ride_grade = table.getGrade(hand[hand_card_index]);
+  CardId vanguard = field_units[UNIT_STATUS_VC_IDX];
+  if (vanguard == INVALID_CARD_ID)
   {
     // ถ้ายังไม่มี vanguard ต้องเป็นการ์ดเกรด 0
-    if (card_to_ride.getGrade() == 0)
-      can_ride = true;
-  }
-  else
-  {
-    // ถ้ามี vanguard แล้ว ต้องเป็นเกรดเท่ากันหรือมากกว่า 1 เกรด
-    if (card_to_ride.getGrade() == current_vg_grade || card_to_ride.getGrade() == current_vg_grade + 1)
-    {
-      can_ride = true;
-    }
+    return ride_grade == 0;
   }
+  // ถ้ามี vanguard แล้ว ต้องเป็นเกรดเท่ากันหรือมากกว่า 1 เกรด
+  int current_vg_grade = table.getGrade(vanguard);
+  return ride_grade == current_vg_grade || ride_grade == current_vg_grade + 1;
+}
 
-  if (!can_ride)
+bool Player::rideFromHand(size_t hand_card_index)
+{
+  ALLOC_SCOPE(Player);
+  if (!canRide(hand_card_index))
   {
     return false;
   }
-
   // ย้าย vanguard เดิมลง soul (ถ้ามี)
-  if (vanguard_circle.has_value())
+  if (field_units[UNIT_STATUS_VC_IDX] != INVALID_CARD_ID)
   {
-    soul.push_back(vanguard_circle.value());
+    soul.push_back(field_units[UNIT_STATUS_VC_IDX]);
   }
 
   // วางการ์ดใหม่เป็น vanguard
-  vanguard_circle = card_to_ride;
+  field_units[UNIT_STATUS_VC_IDX] = hand[hand_card_index];
   unit_is_standing[UNIT_STATUS_VC_IDX] = true;
   hand.erase(hand.begin() + hand_card_index);
   return true;
 }
 
 // เรียกการ์ดจากมือลงบน Rear-guard Circle
-bool Player::callToRearGuard(size_t hand_card_index, size_t rc_slot_index)
+// ตรวจเงื่อนไขการ Call โดยไม่เปลี่ยนสถานะ
+bool Player::canCall(size_t hand_card_index, size_t rc_slot_index) const
 {
   // ตรวจสอบความถูกต้องของ indexes และเงื่อนไขต่างๆ
   if (hand_card_index >= hand.size())
@@ -138,20 +186,26 @@ bool Player::callToRearGuard(size_t hand_card_index, size_t rc_slot_index)
   {
     return false;
   }
-  if (rear_guard_circles[rc_slot_index].has_value())
+  if (field_units[getUnitStatusIndexForRC(rc_slot_index)] != INVALID_CARD_ID)
   {
     return false;
   }
-  Card card_to_call = hand[hand_card_index];
-  if (!vanguard_circle.has_value())
+  if (field_units[UNIT_STATUS_VC_IDX] == INVALID_CARD_ID)
   {
     return false;
   }
-  if (card_to_call.getGrade() > vanguard_circle.value().getGrade())
+  const CardTable &table = deck.getCardTable();
+  return table.getGrade(hand[hand_card_index]) <= table.getGrade(field_units[UNIT_STATUS_VC_IDX]);
+}
+
+bool Player::callToRearGuard(size_t hand_card_index, size_t rc_slot_index)
+{
+  ALLOC_SCOPE(Player);
+  if (!canCall(hand_card_index, rc_slot_index))
   {
     return false;
   }
-  rear_guard_circles[rc_slot_index] = card_to_call;
+  field_units[getUnitStatusIndexForRC(rc_slot_index)] = hand[hand_card_index];
   unit_is_standing[getUnitStatusIndexForRC(rc_slot_index)] = true;
   hand.erase(hand.begin() + hand_card_index);
   return true;
@@ -160,15 +214,17 @@ bool Player::callToRearGuard(size_t hand_card_index, size_t rc_slot_index)
 // เลือกยูนิตที่จะใช้โจมตี
 std::vector<std::pair<int, std::string>> Player::chooseAttacker()
 {
+  ALLOC_SCOPE(Player);
   std::vector<std::pair<int, std::string>> available_attackers;
 
   // ตรวจสอบ Vanguard
-  if (vanguard_circle.has_value() && unit_is_standing[UNIT_STATUS_VC_IDX])
+  const Card *vanguard = getUnitAt(UNIT_STATUS_VC_IDX);
+  if (vanguard && unit_is_standing[UNIT_STATUS_VC_IDX])
   {
     // เพิ่ม Vanguard เข้าลิสต์ผู้โจมตีที่เป็นไปได้
-    std::string vg_info = Icons::CROWN + " VC: " + vanguard_circle.value().getName() +
-                          " (G" + std::to_string(vanguard_circle.value().getGrade()) +
-                          " P:" + std::to_string(vanguard_circle.value().getPower()) + ")";
+    std::string vg_info = UIHelper::Join({Icons::CROWN, " VC: ", vanguard->getNameView(),
+                                          " (G", std::to_string(vanguard->getGrade()),
+                                          " P:", std::to_string(vanguard->getPower()), ")"});
     available_attackers.push_back({UNIT_STATUS_VC_IDX, vg_info});
   }
 
@@ -177,12 +233,13 @@ std::vector<std::pair<int, std::string>> Player::chooseAttacker()
   for (size_t rc_idx : front_row_rcs)
   {
     // เพิ่ม Rear-guards ที่ยังยืนอยู่เข้าลิสต์
-    if (rear_guard_circles[rc_idx].has_value() && unit_is_standing[getUnitStatusIndexForRC(rc_idx)])
+    const Card *rc_unit = getUnitAt(getUnitStatusIndexForRC(rc_idx));
+    if (rc_unit && unit_is_standing[getUnitStatusIndexForRC(rc_idx)])
     {
-      const Card &rc_card = rear_guard_circles[rc_idx].value();
-      std::string rc_info = Icons::SWORD + " RC" + (rc_idx == RC_FRONT_LEFT ? "L" : "R") +
-                            ": " + rc_card.getName() + " (G" + std::to_string(rc_card.getGrade()) +
-                            " P:" + std::to_string(rc_card.getPower()) + ")";
+      const Card &rc_card = *rc_unit;
+      std::string rc_info = UIHelper::Join({Icons::SWORD, " RC", (rc_idx == RC_FRONT_LEFT ? "L" : "R"),
+                                            ": ", rc_card.getNameView(), " (G", std::to_string(rc_card.getGrade()),
+                                            " P:", std::to_string(rc_card.getPower()), ")"});
       available_attackers.push_back({(int)getUnitStatusIndexForRC(rc_idx), rc_info});
     }
   }
@@ -194,26 +251,26 @@ std::vector<std::pair<int, std::string>> Player::chooseAttacker()
   }
   else
   {
-    std::cout << Colors::BRIGHT_CYAN << Icons::SWORD << " ยูนิตที่สามารถโจมตีได้:" << Colors::RESET << std::endl;
+    Out() << Colors::BRIGHT_CYAN << Icons::SWORD << " ยูนิตที่สามารถโจมตีได้:" << Colors::RESET << std::endl;
     for (size_t i = 0; i < available_attackers.size(); ++i)
     {
-      std::cout << Colors::YELLOW << "[" << i << "] " << Colors::RESET
-                << available_attackers[i].second << std::endl;
+      Out() << Colors::YELLOW << "[" << i << "] " << Colors::RESET
+            << available_attackers[i].second << std::endl;
     }
   }
   return available_attackers;
 }
 
 // เลือก Booster สำหรับยูนิตที่โจมตี
-int Player::chooseBooster(int attacker_unit_status_idx)
+int Player::chooseBooster(int attacker_unit_status_idx) const
 {
+  ALLOC_SCOPE(Player);
   // ตรวจสอบความถูกต้องของตำแหน่งผู้โจมตี
   if (attacker_unit_status_idx == -1)
     return -1;
 
   // ดึงข้อมูลการ์ดผู้โจมตี
-  std::optional<Card> attacker_card = getUnitAtStatusIndex(attacker_unit_status_idx);
-  if (!attacker_card.has_value())
+  if (!hasUnitAt(attacker_unit_status_idx))
     return -1;
 
   // หาตำแหน่งที่เป็นไปได้สำหรับ booster
@@ -243,13 +300,11 @@ int Player::chooseBooster(int attacker_unit_status_idx)
     // 1. มีการ์ดในตำแหน่ง booster
     // 2. การ์ดนั้นต้องยังยืนอยู่
     // 3. การ์ดนั้นต้องเป็นเกรด 0 หรือ 1
-    if (rear_guard_circles[booster_rc_idx].has_value() &&
+    const Card *booster = getUnitAt(potential_booster_status_idx);
+    if (booster &&
         unit_is_standing[potential_booster_status_idx] &&
-        (rear_guard_circles[booster_rc_idx].value().getGrade() <= 1))
+        (booster->getGrade() <= 1))
     {
-      // แสดงข้อมูล booster ที่สามารถใช้ได้
-      const Card &booster_card = rear_guard_circles[booster_rc_idx].value();
-      // ...existing UI code...
       return potential_booster_status_idx;
     }
   }
@@ -275,83 +330,106 @@ bool Player::isUnitStanding(int unit_status_idx) const
   return false;
 }
 
-// ดึงข้อมูลการ์ดจากตำแหน่งที่ระบุ
-std::optional<Card> Player::getUnitAtStatusIndex(int unit_status_idx) const
+// มียูนิตในตำแหน่งที่ระบุหรือไม่
+bool Player::hasUnitAt(int unit_status_idx) const
+{
+  return getUnitAt(unit_status_idx) != nullptr;
+}
+
+// การ์ดในตำแหน่งที่ระบุ (nullptr ถ้าไม่มียูนิตหรือตำแหน่งไม่ถูกต้อง)
+const Card *Player::getUnitAt(int unit_status_idx) const
 {
-  // ถ้าเป็นตำแหน่ง Vanguard
-  if (unit_status_idx == UNIT_STATUS_VC_IDX)
+  if (unit_status_idx < 0 || static_cast<size_t>(unit_status_idx) >= NUM_FIELD_UNITS)
   {
-    return vanguard_circle;
+    return nullptr;
   }
-  // ถ้าเป็นตำแหน่ง Rear-guard
-  else if (unit_status_idx > 0 && static_cast<size_t>(unit_status_idx - 1) < NUM_REAR_GUARD_CIRCLES)
+  CardId unit = field_units[static_cast<size_t>(unit_status_idx)];
+  return unit != INVALID_CARD_ID ? &cardOf(unit) : nullptr;
+}
+
+// ดึงสำเนาการ์ดจากตำแหน่งที่ระบุ
+std::optional<Card> Player::getUnitAtStatusIndex(int unit_status_idx) const
+{
+  ALLOC_SCOPE(Player);
+  const Card *unit = getUnitAt(unit_status_idx);
+  if (!unit)
   {
-    return rear_guard_circles[static_cast<size_t>(unit_status_idx - 1)];
+    return std::nullopt;
   }
-  return std::nullopt; // ถ้าตำแหน่งไม่ถูกต้อง
+  return *unit;
 }
 
-// คำนวณพลังโจมตีรวมของยูนิต รวมถึง booster (ถ้ามี)
+// คำนวณพลังโจมตีรวมของยูนิต รวมถึง booster (ถ้ามี) - รวมจากคอลัมน์พลังของตารางสำรับ
 int Player::getUnitPowerAtStatusIndex(int unit_status_idx, int booster_unit_status_idx, bool for_defense) const
 {
-  int total_power = 0;
-  std::optional<Card> unit_opt = getUnitAtStatusIndex(unit_status_idx);
-  if (unit_opt.has_value())
-  {
-    total_power += unit_opt.value().getPower();
-  }
-  if (!for_defense && booster_unit_status_idx != -1)
+  CardId units[2];
+  size_t count = 0;
+  auto addUnit = [this, &units, &count](int idx)
   {
-    std::optional<Card> booster_opt = getUnitAtStatusIndex(booster_unit_status_idx);
-    if (booster_opt.has_value())
+    if (idx >= 0 && static_cast<size_t>(idx) < NUM_FIELD_UNITS && field_units[static_cast<size_t>(idx)] != INVALID_CARD_ID)
     {
-      total_power += booster_opt.value().getPower();
+      units[count++] = field_units[static_cast<size_t>(idx)];
     }
+  };
+  addUnit(unit_status_idx);
+  if (!for_defense && booster_unit_status_idx != -1)
+  {
+    addUnit(booster_unit_status_idx);
   }
-  return total_power;
+  return deck.getCardTable().sumPower(units, count);
+}
+
+// แสดงการ์ด Trigger ที่เปิดได้ (เรียกก่อนใช้ผล)
+static void announceTrigger(const Card &trigger_card)
+{
+  Out() << Colors::BRIGHT_MAGENTA << Icons::MAGIC << " เปิดได้ Trigger: " << Colors::BOLD
+        << trigger_card.getNameView() << Colors::RESET << Colors::BRIGHT_BLACK
+        << " (" << trigger_card.getTypeRoleView() << ")" << Colors::RESET << "!" << std::endl;
 }
 
 // ฟังก์ชันช่วยสำหรับการประมวลผล Trigger
 // - self: ผู้เล่นที่เปิด trigger
-// - trigger_card: การ์ดที่เปิดได้
+// - trigger_roles: บิตบทบาทของการ์ดที่เปิดได้ (CardTable::getRoles())
 // - is_drive_check: เป็นการเช็คจาก drive check หรือไม่
 // - opponent_for_heal_check: ผู้เล่นฝ่ายตรงข้าม (ใช้สำหรับเช็คเงื่อนไขการฮีล)
-TriggerOutput apply_trigger_logic_helper(Player *self, const Card &trigger_card, bool is_drive_check, Player *opponent_for_heal_check)
+TriggerOutput apply_trigger_logic_helper(Player *self, int32_t trigger_roles, bool is_drive_check, Player *opponent_for_heal_check)
 {
   TriggerOutput output;
-  std::cout << Colors::BRIGHT_MAGENTA << Icons::MAGIC << " เปิดได้ Trigger: " << Colors::BOLD
-            << trigger_card.getName() << Colors::RESET << Colors::BRIGHT_BLACK
-            << " (" << trigger_card.getTypeRole() << ")" << Colors::RESET << "!" << std::endl;
+  int metric_kind = 3; // critical, draw, heal, อื่นๆ (ตามลำดับของ GameMetrics::triggers)
 
-  if (trigger_card.getTypeRole() == "Trigger - Critical")
+  if (trigger_roles & ROLE_CRITICAL_TRIGGER)
   {
+    metric_kind = 0;
     output.extra_power += 10000; // เพิ่มพลังโจมตี 10000
     if (is_drive_check)
     {
       output.extra_crit += 1; // เพิ่มคริติคอล 1 (เฉพาะ Drive Check)
-      std::cout << Colors::BRIGHT_RED << Icons::CRITICAL << " ผล: +10000 Power และ +1 Critical!" << Colors::RESET << std::endl;
+      Out() << Colors::BRIGHT_RED << Icons::CRITICAL << " ผล: +10000 Power และ +1 Critical!" << Colors::RESET << std::endl;
     }
     else
     {
-      std::cout << Colors::BRIGHT_RED << Icons::CRITICAL << " ผล: +10000 Power!" << Colors::RESET << std::endl;
+      Out() << Colors::BRIGHT_RED << Icons::CRITICAL << " ผล: +10000 Power!" << Colors::RESET << std::endl;
     }
   }
-  else if (trigger_card.getTypeRole() == "Trigger - Draw")
+  else if (trigger_roles & ROLE_DRAW_TRIGGER)
   {
+    metric_kind = 1;
     output.extra_power += 10000; // เพิ่มพลังโจมตี 10000
     // จั่วการ์ดเพิ่ม 1 ใบ
     std::optional<Card> drawn = self->getDeck().draw();
     if (drawn.has_value())
     {
-      self->addCardToHand(drawn.value());
-      std::cout << Colors::BRIGHT_CYAN << Icons::DRAW << " ผล: +10000 Power และ จั่ว 1 ใบ!" << Colors::RESET << std::endl;
+      self->addCardToHand(std::move(drawn.value()));
+      gameMetrics().cards_drawn.add();
+      Out() << Colors::BRIGHT_CYAN << Icons::DRAW << " ผล: +10000 Power และ จั่ว 1 ใบ!" << Colors::RESET << std::endl;
       output.card_drawn = true;
     }
   }
-  else if (trigger_card.getTypeRole() == "Trigger - Heal")
+  else if (trigger_roles & ROLE_HEAL_TRIGGER)
   {
+    metric_kind = 2;
     output.extra_power += 10000; // เพิ่มพลังโจมตี 10000
-    std::cout << Colors::BRIGHT_GREEN << Icons::HEAL << " ผล: +10000 Power" << Colors::RESET;
+    Out() << Colors::BRIGHT_GREEN << Icons::HEAL << " ผล: +10000 Power" << Colors::RESET;
     // ตรวจสอบเงื่อนไขการฮีล:
     // 1. ต้องมีดาเมจมากกว่าหรือเท่ากับฝ่ายตรงข้าม (ถ้ามีฝ่ายตรงข้าม)
     // 2. ต้องมีดาเมจอย่างน้อย 1
@@ -360,7 +438,7 @@ TriggerOutput apply_trigger_logic_helper(Player *self, const Card &trigger_card,
       if (self->healOneDamage())
       {
         output.damage_healed = true;
-        std::cout << Colors::BRIGHT_GREEN << " และ Heal 1 ดาเมจ!" << Colors::RESET << std::endl;
+        Out() << Colors::BRIGHT_GREEN << " และ Heal 1 ดาเมจ!" << Colors::RESET << std::endl;
       }
     }
     else if (!opponent_for_heal_check && self->getDamageCount() > 0)
@@ -368,22 +446,28 @@ TriggerOutput apply_trigger_logic_helper(Player *self, const Card &trigger_card,
       if (self->healOneDamage())
       {
         output.damage_healed = true;
-        std::cout << Colors::BRIGHT_GREEN << " และ Heal 1 ดาเมจ!" << Colors::RESET << std::endl;
+        Out() << Colors::BRIGHT_GREEN << " และ Heal 1 ดาเมจ!" << Colors::RESET << std::endl;
       }
     }
     else
     {
-      std::cout << Colors::BRIGHT_BLACK << " (ไม่สามารถ Heal ได้)" << Colors::RESET << std::endl;
+      Out() << Colors::BRIGHT_BLACK << " (ไม่สามารถ Heal ได้)" << Colors::RESET << std::endl;
     }
   }
+  gameMetrics().triggers[is_drive_check ? 0 : 1][metric_kind].add();
   return output;
 }
 
 // ทำการ Drive Check ตามจำนวนที่กำหนด
 TriggerOutput Player::performDriveCheck(int num_drives, Player *opponent_for_heal_check)
 {
+  TRACE_SPAN("battle", "Drive Check");
+  ALLOC_SCOPE(Player);
   // แสดงหัวข้อการ Drive Check
-  UIHelper::PrintSectionHeader(name + ": DRIVE CHECK x" + std::to_string(num_drives), Icons::DIAMOND);
+  if (OutputSink::Enabled())
+  {
+    UIHelper::PrintSectionHeader(name + ": DRIVE CHECK x" + std::to_string(num_drives), Icons::DIAMOND);
+  }
 
   TriggerOutput total_trigger_output; // เก็บผลรวมของ trigger ทั้งหมด
 
@@ -404,17 +488,25 @@ TriggerOutput Player::performDriveCheck(int num_drives, Player *opponent_for_hea
     std::optional<Card> drive_card_opt = deck.draw();
     if (drive_card_opt.has_value())
     {
-      Card drive_card = drive_card_opt.value();
-      std::cout << Colors::BRIGHT_CYAN << "Drive Check ครั้งที่ " << (i + 1) << ": "
-                << Colors::RESET << UIHelper::FormatCard(drive_card.getName(), drive_card.getGrade()) << std::endl;
-      hand.push_back(drive_card); // เพิ่มการ์ดเข้ามือ
+      // ย้ายการ์ดเข้ามือ แล้วอ่านข้อมูลจากตารางของสำรับ (ไม่ขึ้นกับการเปลี่ยนแปลงของโซนระหว่างใช้ผล Trigger)
+      CardId drive_id = idOf(drive_card_opt.value());
+      hand.push_back(drive_id);
+      const Card &drive_card = cardOf(drive_id);
+      if (OutputSink::Enabled())
+      {
+        Out() << Colors::BRIGHT_CYAN << "Drive Check ครั้งที่ " << (i + 1) << ": "
+              << Colors::RESET << UIHelper::FormatCard(drive_card.getNameView(), drive_card.getGrade()) << std::endl;
+      }
 
       // ตรวจสอบว่าเป็นการ์ด Trigger หรือไม่
-      if (drive_card.getTypeRole().find("Trigger") != std::string::npos)
+      int32_t trigger_roles = deck.getCardTable().getRoles(drive_id);
+      if (trigger_roles & ROLE_TRIGGER)
       {
-        TriggerOutput current_drive_trigger_output = apply_trigger_logic_helper(this, drive_card, true, opponent_for_heal_check);
+        announceTrigger(drive_card);
+        TriggerOutput current_drive_trigger_output = apply_trigger_logic_helper(this, trigger_roles, true, opponent_for_heal_check);
         total_trigger_output.extra_power += current_drive_trigger_output.extra_power;
         total_trigger_output.extra_crit += current_drive_trigger_output.extra_crit;
+        total_trigger_output.triggers_revealed++;
       }
     }
   }
@@ -423,25 +515,39 @@ TriggerOutput Player::performDriveCheck(int num_drives, Player *opponent_for_hea
 
 TriggerOutput Player::handleDamageCheckTrigger(const Card &damage_card, Player *opponent_for_heal_check)
 {
-  std::cout << Colors::BRIGHT_RED << name << " เปิดได้จากการ Damage Check: " << Colors::RESET
-            << UIHelper::FormatCard(damage_card.getName(), damage_card.getGrade()) << std::endl;
-  if (damage_card.getTypeRole().find("Trigger") != std::string::npos)
+  ALLOC_SCOPE(Player);
+  takeDamage(damage_card);
+
+  // ใบล่าสุดใน Damage Zone คือใบที่เพิ่งเปิด - อ่านจากตารางของสำรับ จึงใช้ได้แม้ Heal จะย้ายใบนี้ไป Drop Zone
+  CardId damage_id = damage_zone.back();
+  const Card &revealed = cardOf(damage_id);
+  int32_t trigger_roles = deck.getCardTable().getRoles(damage_id);
+  if (OutputSink::Enabled())
+  {
+    Out() << Colors::BRIGHT_RED << name << " เปิดได้จากการ Damage Check: " << Colors::RESET
+          << UIHelper::FormatCard(revealed.getNameView(), revealed.getGrade()) << std::endl;
+  }
+  if (trigger_roles & ROLE_TRIGGER)
   {
-    return apply_trigger_logic_helper(this, damage_card, false, opponent_for_heal_check);
+    announceTrigger(revealed);
+    TriggerOutput damage_trigger_output = apply_trigger_logic_helper(this, trigger_roles, false, opponent_for_heal_check);
+    damage_trigger_output.triggers_revealed = 1;
+    return damage_trigger_output;
   }
   return TriggerOutput();
 }
 
 bool Player::healOneDamage()
 {
+  ALLOC_SCOPE(Player);
   if (!damage_zone.empty())
   {
-    Card healed_card = damage_zone.back(); // Heal การ์ดใบล่าสุด
+    const Card &healed_card = cardOf(damage_zone.back()); // Heal การ์ดใบล่าสุด
+    drop_zone.push_back(damage_zone.back());
     damage_zone.pop_back();
-    drop_zone.push_back(healed_card);
-    std::cout << Colors::BRIGHT_GREEN << name << " Heal 1 ดาเมจ! " << Colors::RESET
-              << Colors::BRIGHT_BLACK << "(การ์ด '" << healed_card.getName()
-              << "' ไปยัง Drop Zone)" << Colors::RESET << std::endl;
+    Out() << Colors::BRIGHT_GREEN << name << " Heal 1 ดาเมจ! " << Colors::RESET
+          << Colors::BRIGHT_BLACK << "(การ์ด '" << healed_card.getNameView()
+          << "' ไปยัง Drop Zone)" << Colors::RESET << std::endl;
     return true;
   }
   return false;
@@ -449,19 +555,20 @@ bool Player::healOneDamage()
 
 int Player::chooseUnitForTriggerEffect(const std::string &trigger_effect_description)
 {
-  std::cout << Colors::BRIGHT_YELLOW << name << ": " << trigger_effect_description << Colors::RESET << std::endl;
-  std::cout << "เลือกยูนิตที่จะรับผล:" << std::endl;
+  ALLOC_SCOPE(Player);
+  Out() << Colors::BRIGHT_YELLOW << name << ": " << trigger_effect_description << Colors::RESET << std::endl;
+  Out() << "เลือกยูนิตที่จะรับผล:" << std::endl;
   std::vector<std::pair<int, std::string>> available_units;
-  if (vanguard_circle.has_value())
+  if (const Card *vanguard = getUnitAt(UNIT_STATUS_VC_IDX))
   {
-    available_units.push_back({UNIT_STATUS_VC_IDX, Icons::CROWN + " VC: " + vanguard_circle.value().getName()});
+    available_units.push_back({UNIT_STATUS_VC_IDX, UIHelper::Join({Icons::CROWN, " VC: ", vanguard->getNameView()})});
   }
   for (size_t i = 0; i < NUM_REAR_GUARD_CIRCLES; ++i)
   {
-    if (rear_guard_circles[i].has_value())
+    if (const Card *rear_guard = getUnitAt(getUnitStatusIndexForRC(i)))
     {
-      std::string rc_name = "RC" + std::to_string(i) + ": " + rear_guard_circles[i].value().getName();
-      available_units.push_back({(int)getUnitStatusIndexForRC(i), Icons::SWORD + " " + rc_name});
+      std::string rc_slot = std::to_string(i);
+      available_units.push_back({(int)getUnitStatusIndexForRC(i), UIHelper::Join({Icons::SWORD, " RC", rc_slot, ": ", rear_guard->getNameView()})});
     }
   }
   if (available_units.empty())
@@ -471,13 +578,13 @@ int Player::chooseUnitForTriggerEffect(const std::string &trigger_effect_descrip
   }
   for (size_t i = 0; i < available_units.size(); ++i)
   {
-    std::cout << Colors::YELLOW << "[" << i << "] " << Colors::RESET
-              << available_units[i].second << std::endl;
+    Out() << Colors::YELLOW << "[" << i << "] " << Colors::RESET
+          << available_units[i].second << std::endl;
   }
   int choice_idx = -1;
-  std::cout << Colors::BRIGHT_CYAN << "เลือกหมายเลขยูนิต (-1 หากไม่ต้องการให้ผลกับยูนิตใด): " << Colors::RESET;
-  std::cin >> choice_idx;
-  std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  Out() << Colors::BRIGHT_CYAN << "เลือกหมายเลขยูนิต (-1 หากไม่ต้องการให้ผลกับยูนิตใด): " << Colors::RESET;
+  std::istringstream choice_stream(InputSource::NextLine());
+  choice_stream >> choice_idx;
   if (choice_idx >= 0 && static_cast<size_t>(choice_idx) < available_units.size())
   {
     return available_units[static_cast<size_t>(choice_idx)].first;
@@ -488,348 +595,305 @@ int Player::chooseUnitForTriggerEffect(const std::string &trigger_effect_descrip
 // --- Guarding Methods ---
 int Player::addCardToGuardianZoneFromHand(size_t hand_card_index)
 {
+  ALLOC_SCOPE(Player);
   if (hand_card_index >= hand.size())
   {
     UIHelper::PrintError("ไม่สามารถ Guard ด้วยการ์ดตำแหน่ง " + std::to_string(hand_card_index) + " (ไม่มีการ์ด)");
     return -1;
   }
-  Card card_to_guard = hand[hand_card_index];
-  guardian_zone.push_back(card_to_guard);
+  const Card &card_to_guard = cardOf(hand[hand_card_index]);
+  guardian_zone.push_back(hand[hand_card_index]);
   int shield_value = card_to_guard.getShield();
   hand.erase(hand.begin() + static_cast<long>(hand_card_index));
 
-  std::cout << Colors::BRIGHT_BLUE << Icons::SHIELD << " " << name << " ใช้ '"
-            << card_to_guard.getName() << "' (Shield: " << shield_value
-            << ") ในการ Guard." << Colors::RESET << std::endl;
+  Out() << Colors::BRIGHT_BLUE << Icons::SHIELD << " " << name << " ใช้ '"
+        << card_to_guard.getNameView() << "' (Shield: " << shield_value
+        << ") ในการ Guard." << Colors::RESET << std::endl;
   return shield_value;
 }
 
 int Player::getGuardianZoneShieldTotal() const
 {
-  int total_shield = 0;
-  for (const auto &card : guardian_zone)
-  {
-    total_shield += card.getShield();
-  }
-  return total_shield;
+  return deck.getCardTable().sumShield(guardian_zone.data(), guardian_zone.size());
 }
 
-int Player::performGuardStep(int incoming_attack_power, const std::optional<Card> &target_unit_opt)
+void Player::displayGuardianZone() const
 {
-  UIHelper::PrintSectionHeader(name + ": GUARD PHASE", Icons::SHIELD, Colors::BRIGHT_BLUE);
-
-  std::cout << Colors::BRIGHT_RED << Icons::SWORD << " พลังโจมตีที่เข้ามา: "
-            << incoming_attack_power << Colors::RESET << std::endl;
-  if (target_unit_opt.has_value())
+  if (!OutputSink::Enabled())
+    return;
+  TRACE_SPAN("ui", "Player::displayGuardianZone");
+  ALLOC_SCOPE(UI);
+  if (guardian_zone.empty())
   {
-    std::cout << Colors::BRIGHT_YELLOW << Icons::TARGET << " เป้าหมายคือ: "
-              << target_unit_opt.value().getName()
-              << " (Power ปัจจุบัน: " << target_unit_opt.value().getPower() << ")"
-              << Colors::RESET << std::endl;
+    Out() << Colors::BRIGHT_BLACK << "(ว่าง)" << Colors::RESET;
   }
-
-  char continue_guard_choice = 'y';
-
-  while ((continue_guard_choice == 'y' || continue_guard_choice == 'Y'))
+  else
   {
-    if (hand.empty())
+    for (CardId id : guardian_zone)
     {
-      UIHelper::PrintWarning("ไม่เหลือการ์ดบนมือให้ Guard แล้ว!");
-      break;
+      const Card &card = cardOf(id);
+      Out() << Colors::BLUE << "[" << card.getNameView() << " S:" << card.getShield() << "] " << Colors::RESET;
     }
+  }
+}
+
+// Enhanced field display
+// เขียนช่องการ์ด 1 ช่องลงบัฟเฟอร์โดยตรง (จัดกึ่งกลางตามความกว้าง width) ไม่มีการสร้างสตริงชั่วคราว
+static void appendCardCell(TextBuffer &out, const Card *card_ptr, int width, bool is_standing)
+{
+  if (!card_ptr)
+  {
+    const std::string_view empty_cell = "[     ว่าง     ]";
+    int padding = std::max(0, width - UIHelper::GetDisplayWidth(empty_cell));
+    int pad_left = padding / 2;
+    out.Spaces(pad_left) << Colors::BRIGHT_BLACK << empty_cell << Colors::RESET;
+    out.Spaces(padding - pad_left);
+    return;
+  }
 
-    std::cout << "\n"
-              << Colors::BRIGHT_CYAN << Icons::HAND << " การ์ดบนมือของคุณ ("
-              << name << "):" << Colors::RESET << std::endl;
-    displayHand(true);
+  const Card &card = *card_ptr;
+  std::string_view grade_icon = UIHelper::GetGradeIcon(card.getGrade());
+  std::string_view status_icon = UIHelper::GetStatusIcon(is_standing);
+  std::string_view name_str = card.getNameView();
 
-    std::cout << Colors::BRIGHT_BLUE << Icons::GUARD << " Guardian Zone ปัจจุบัน: " << Colors::RESET;
-    displayGuardianZone();
-    std::cout << std::endl;
+  // Safe truncation for Unicode/Thai/emoji
+  char name_trunc[64]; // 12 display columns * 4 bytes + ".." fits comfortably
+  size_t name_trunc_len = 0;
+  int max_display_width = 12; // Maximum display width we want
+  int display_width = 0;      // Current display width
+  size_t byte_pos = 0;        // Current byte position in name_str
 
-    std::cout << Colors::BRIGHT_BLUE << Icons::SHIELD << " Shield รวมปัจจุบัน: "
-              << getGuardianZoneShieldTotal() << Colors::RESET << std::endl;
+  while (byte_pos < name_str.length())
+  {
+    // Get next character width
+    unsigned char c = name_str[byte_pos];
+    int char_width;
+    size_t char_bytes;
 
-    std::cout << Colors::BRIGHT_CYAN << "เลือกการ์ดจากมือเพื่อ Guard (-1 เพื่อหยุด Guard): " << Colors::RESET;
-    std::string s_idx;
-    std::cin >> s_idx;
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    int card_idx = -1;
-    try
+    if ((c & 0x80) == 0)
     {
-      card_idx = std::stoi(s_idx);
+      // ASCII
+      char_width = 1;
+      char_bytes = 1;
     }
-    catch (...)
+    else if ((c & 0xE0) == 0xC0)
     {
-      card_idx = -2; /* invalid input */
+      // 2-byte UTF-8
+      char_width = 2;
+      char_bytes = 2;
     }
-
-    if (card_idx == -1)
-      break;
-
-    if (card_idx >= 0 && static_cast<size_t>(card_idx) < hand.size())
+    else if ((c & 0xF0) == 0xE0)
     {
-      addCardToGuardianZoneFromHand(static_cast<size_t>(card_idx));
+      // 3-byte UTF-8 (Thai, etc)
+      char_width = 2;
+      char_bytes = 3;
     }
-    else
+    else if ((c & 0xF8) == 0xF0)
     {
-      UIHelper::PrintError("เลือกไม่ถูกต้อง");
+      // 4-byte UTF-8 (emoji)
+      char_width = 2;
+      char_bytes = 4;
     }
-
-    if (hand.empty())
+    else
     {
-      UIHelper::PrintWarning("ไม่เหลือการ์ดบนมือให้ Guard แล้ว!");
-      break;
+      // Invalid UTF-8, skip
+      byte_pos++;
+      continue;
     }
 
-    std::cout << Colors::BRIGHT_CYAN << "ต้องการ Guard เพิ่มหรือไม่ (y/n): " << Colors::RESET;
-    std::cin >> continue_guard_choice;
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-  }
-
-  int final_shield = getGuardianZoneShieldTotal();
-  std::cout << Colors::BRIGHT_GREEN << Icons::CONFIRM << " จบขั้นตอนการ Guard. Shield ที่ได้ทั้งหมด: "
-            << final_shield << Colors::RESET << std::endl;
-  return final_shield;
-}
+    // Check if adding this character would exceed max width
+    if (display_width + char_width > max_display_width)
+      break;
 
-void Player::displayGuardianZone() const
-{
-  if (guardian_zone.empty())
-  {
-    std::cout << Colors::BRIGHT_BLACK << "(ว่าง)" << Colors::RESET;
-  }
-  else
-  {
-    for (const auto &card : guardian_zone)
+    // Safe to append this character
+    if (byte_pos + char_bytes <= name_str.length())
     {
-      std::cout << Colors::BLUE << "[" << card.getName() << " S:" << card.getShield() << "] " << Colors::RESET;
+      name_str.copy(name_trunc + name_trunc_len, char_bytes, byte_pos);
+      name_trunc_len += char_bytes;
+      display_width += char_width;
     }
+
+    byte_pos += char_bytes;
   }
-}
 
-// Enhanced field display
-std::string formatCardForDisplayImproved(const std::optional<Card> &card_opt, int width, bool is_standing)
-{
-  std::ostringstream oss;
-  std::string content;
-  if (card_opt.has_value())
+  // Add truncation indicator if necessary
+  if (byte_pos < name_str.length() && name_trunc_len > 0)
   {
-    const Card &card = card_opt.value();
-    std::string grade_icon = UIHelper::GetGradeIcon(card.getGrade());
-    std::string status_icon = is_standing ? Icons::RUNNER : Icons::SLEEP;
-    std::string name_str = card.getName();
-    std::string power_str = "P:" + std::to_string(card.getPower());
-
-    // Safe truncation for Unicode/Thai/emoji
-    std::string name_trunc;
-    int max_display_width = 12; // Maximum display width we want
-    int display_width = 0;      // Current display width
-    size_t byte_pos = 0;        // Current byte position in name_str
-
-    while (byte_pos < name_str.length())
-    {
-      // Get next character width
-      unsigned char c = name_str[byte_pos];
-      int char_width;
-      size_t char_bytes;
-
-      if ((c & 0x80) == 0)
-      {
-        // ASCII
-        char_width = 1;
-        char_bytes = 1;
-      }
-      else if ((c & 0xE0) == 0xC0)
-      {
-        // 2-byte UTF-8
-        char_width = 2;
-        char_bytes = 2;
-      }
-      else if ((c & 0xF0) == 0xE0)
-      {
-        // 3-byte UTF-8 (Thai, etc)
-        char_width = 2;
-        char_bytes = 3;
-      }
-      else if ((c & 0xF8) == 0xF0)
-      {
-        // 4-byte UTF-8 (emoji)
-        char_width = 2;
-        char_bytes = 4;
-      }
-      else
-      {
-        // Invalid UTF-8, skip
-        byte_pos++;
-        continue;
-      }
-
-      // Check if adding this character would exceed max width
-      if (display_width + char_width > max_display_width)
-        break;
-
-      // Safe to append this character
-      if (byte_pos + char_bytes <= name_str.length())
-      {
-        name_trunc.append(name_str.substr(byte_pos, char_bytes));
-        display_width += char_width;
-      }
-
-      byte_pos += char_bytes;
-    }
-
-    // Add truncation indicator if necessary
-    if (byte_pos < name_str.length() && !name_trunc.empty())
-    {
-      name_trunc += "..";
-    }
-    else if (name_trunc.empty())
-    {
-      name_trunc = "??";
-    }
-
-    content = grade_icon + " " + name_trunc + " " + power_str + " " + status_icon;
+    name_trunc[name_trunc_len++] = '.';
+    name_trunc[name_trunc_len++] = '.';
   }
-  else
+  else if (name_trunc_len == 0)
   {
-    content = Colors::BRIGHT_BLACK + "[     ว่าง     ]" + Colors::RESET;
+    name_trunc[name_trunc_len++] = '?';
+    name_trunc[name_trunc_len++] = '?';
   }
+  std::string_view name_view(name_trunc, name_trunc_len);
 
-  // Calculate actual display width including color codes
-  std::string stripped_content = content;
-  size_t pos = 0;
-  while ((pos = stripped_content.find("\033[", pos)) != std::string::npos)
-  {
-    size_t end_pos = stripped_content.find('m', pos);
-    if (end_pos != std::string::npos)
-    {
-      stripped_content.erase(pos, end_pos - pos + 1);
-    }
-  }
+  char power_text[16] = "P:";
+  std::string_view power_str(power_text, std::to_chars(power_text + 2, power_text + sizeof(power_text), card.getPower()).ptr - power_text);
 
-  int text_len = UIHelper::GetDisplayWidth(stripped_content);
+  // เนื้อหาช่องไม่มีรหัสสี จึงวัดความกว้างจากแต่ละส่วนได้โดยตรง
+  int text_len = UIHelper::GetDisplayWidth(grade_icon) + 1 + UIHelper::GetDisplayWidth(name_view) + 1 +
+                 UIHelper::GetDisplayWidth(power_str) + 1 + UIHelper::GetDisplayWidth(status_icon);
   int padding = width - text_len;
   if (padding < 0)
     padding = 0;
   int pad_left = padding / 2;
   int pad_right = padding - pad_left;
 
-  oss << std::string(pad_left, ' ') << content << std::string(pad_right, ' ');
-  return oss.str();
+  out.Spaces(pad_left) << grade_icon << ' ' << name_view << ' ' << power_str << ' ' << status_icon;
+  out.Spaces(pad_right);
 }
 
 void Player::displayField(bool show_opponent_field_for_targeting) const
 {
+  if (!OutputSink::Enabled())
+    return;
+  TRACE_SPAN("ui", "Player::displayField");
+  ALLOC_SCOPE(UI);
   const int card_cell_width = 15; // Width for each card cell
-  const std::string V_BORDER = Colors::BRIGHT_BLACK + "│" + Colors::RESET;
-  const std::string H_BORDER_THICK_SEGMENT = Colors::BRIGHT_BLACK + std::string(card_cell_width, '=') + Colors::RESET;
-  const std::string H_BORDER_THIN_SEGMENT = Colors::BRIGHT_BLACK + std::string(card_cell_width, '-') + Colors::RESET;
+  TextBuffer out;
+  auto v_border = [&out]() -> TextBuffer &
+  { return out << Colors::BRIGHT_BLACK << "│" << Colors::RESET; };
+  auto h_border = [&out](char c) -> TextBuffer &
+  {
+    out << Colors::BRIGHT_BLACK;
+    return out.Repeat(c, card_cell_width) << Colors::RESET;
+  };
+  // ป้ายกำกับช่อง - ข้อความพร้อมรหัสสียาวเกินความกว้างช่องเสมอ จึงไม่ต้องเติมช่องว่าง
+  auto slot_label = [&out, show_opponent_field_for_targeting](std::string_view targeting_label, std::string_view label) -> TextBuffer &
+  {
+    if (show_opponent_field_for_targeting)
+      return out << Colors::YELLOW << targeting_label << Colors::RESET;
+    return out << Colors::BRIGHT_BLACK << label << Colors::RESET;
+  };
 
   // Player Name and Deck/Soul/Drop
-  std::cout << Colors::BOLD << Colors::YELLOW << name << Colors::RESET << " - Turn "
-            << Colors::BOLD << turn_count << Colors::RESET << std::endl;
+  out << Colors::BOLD << Colors::YELLOW << name << Colors::RESET << " - Turn "
+      << Colors::BOLD << turn_count << Colors::RESET << '\n';
 
-  std::cout << "  " << Colors::CYAN << "┌" << H_BORDER_THICK_SEGMENT << "┬" << H_BORDER_THIN_SEGMENT
-            << "┬" << H_BORDER_THIN_SEGMENT << "┐" << Colors::RESET << std::endl;
+  out << "  " << Colors::CYAN << "┌";
+  h_border('=') << "┬";
+  h_border('-') << "┬";
+  h_border('-') << "┐" << Colors::RESET << '\n';
 
-  std::cout << "  " << V_BORDER << std::left << std::setw(card_cell_width) << std::setfill(' ')
-            << (Colors::GREEN + Icons::DECK + " Deck: " + Colors::BOLD + std::to_string(deck.getSize()) + Colors::RESET)
-            << V_BORDER << std::left << std::setw(card_cell_width) << std::setfill(' ')
-            << (Colors::MAGENTA + Icons::SOUL + " Soul: " + Colors::BOLD + std::to_string(soul.size()) + Colors::RESET)
-            << V_BORDER << std::left << std::setw(card_cell_width) << std::setfill(' ')
-            << (Colors::BRIGHT_BLACK + Icons::DROP + " Drop: " + Colors::BOLD + std::to_string(drop_zone.size()) + Colors::RESET)
-            << V_BORDER << std::endl;
+  out << "  ";
+  v_border() << Colors::GREEN << Icons::DECK << " Deck: " << Colors::BOLD << deck.getSize() << Colors::RESET;
+  v_border() << Colors::MAGENTA << Icons::SOUL << " Soul: " << Colors::BOLD << soul.size() << Colors::RESET;
+  v_border() << Colors::BRIGHT_BLACK << Icons::DROP << " Drop: " << Colors::BOLD << drop_zone.size() << Colors::RESET;
+  v_border() << '\n';
 
   // Field Separator (Top)
-  std::cout << "  " << Colors::CYAN << "├" << H_BORDER_THIN_SEGMENT << "┼" << H_BORDER_THICK_SEGMENT
-            << "┼" << H_BORDER_THIN_SEGMENT << "┤" << Colors::RESET << std::endl;
+  out << "  " << Colors::CYAN << "├";
+  h_border('-') << "┼";
+  h_border('=') << "┼";
+  h_border('-') << "┤" << Colors::RESET << '\n';
 
   // Front Row Cards
-  std::cout << "  " << V_BORDER << formatCardForDisplayImproved(rear_guard_circles[RC_FRONT_LEFT], card_cell_width, unit_is_standing[getUnitStatusIndexForRC(RC_FRONT_LEFT)])
-            << V_BORDER << formatCardForDisplayImproved(vanguard_circle, card_cell_width, unit_is_standing[UNIT_STATUS_VC_IDX])
-            << V_BORDER << formatCardForDisplayImproved(rear_guard_circles[RC_FRONT_RIGHT], card_cell_width, unit_is_standing[getUnitStatusIndexForRC(RC_FRONT_RIGHT)])
-            << V_BORDER << " " << Colors::RED << Icons::DAMAGE << " Damage: " << Colors::BOLD << damage_zone.size() << "/" << MAX_DAMAGE << Colors::RESET << std::endl;
+  out << "  ";
+  v_border();
+  appendCardCell(out, getUnitAt(getUnitStatusIndexForRC(RC_FRONT_LEFT)), card_cell_width, unit_is_standing[getUnitStatusIndexForRC(RC_FRONT_LEFT)]);
+  v_border();
+  appendCardCell(out, getUnitAt(UNIT_STATUS_VC_IDX), card_cell_width, unit_is_standing[UNIT_STATUS_VC_IDX]);
+  v_border();
+  appendCardCell(out, getUnitAt(getUnitStatusIndexForRC(RC_FRONT_RIGHT)), card_cell_width, unit_is_standing[getUnitStatusIndexForRC(RC_FRONT_RIGHT)]);
+  v_border() << " " << Colors::RED << Icons::DAMAGE << " Damage: " << Colors::BOLD << damage_zone.size() << "/" << MAX_DAMAGE << Colors::RESET << '\n';
 
   // Front Row Labels
-  std::cout << "  " << V_BORDER << std::left << std::setw(card_cell_width) << std::setfill(' ')
-            << (show_opponent_field_for_targeting ? Colors::YELLOW + "   (0: RC FL)" + Colors::RESET : Colors::BRIGHT_BLACK + "   (RC FL)" + Colors::RESET)
-            << V_BORDER << std::left << std::setw(card_cell_width) << std::setfill(' ')
-            << (Colors::BRIGHT_YELLOW + "   (VC)" + Colors::RESET)
-            << V_BORDER << std::left << std::setw(card_cell_width) << std::setfill(' ')
-            << (show_opponent_field_for_targeting ? Colors::YELLOW + "   (1: RC FR)" + Colors::RESET : Colors::BRIGHT_BLACK + "   (RC FR)" + Colors::RESET)
-            << V_BORDER << std::endl;
+  out << "  ";
+  v_border();
+  slot_label("   (0: RC FL)", "   (RC FL)");
+  v_border() << Colors::BRIGHT_YELLOW << "   (VC)" << Colors::RESET;
+  v_border();
+  slot_label("   (1: RC FR)", "   (RC FR)");
+  v_border() << '\n';
 
   // Field Separator (Middle)
-  std::cout << "  " << Colors::CYAN << "├" << H_BORDER_THIN_SEGMENT << "┼" << H_BORDER_THIN_SEGMENT
-            << "┼" << H_BORDER_THIN_SEGMENT << "┤" << Colors::RESET << std::endl;
+  out << "  " << Colors::CYAN << "├";
+  h_border('-') << "┼";
+  h_border('-') << "┼";
+  h_border('-') << "┤" << Colors::RESET << '\n';
 
   // Back Row Cards
-  std::cout << "  " << V_BORDER << formatCardForDisplayImproved(rear_guard_circles[RC_BACK_LEFT], card_cell_width, unit_is_standing[getUnitStatusIndexForRC(RC_BACK_LEFT)])
-            << V_BORDER << formatCardForDisplayImproved(rear_guard_circles[RC_BACK_CENTER], card_cell_width, unit_is_standing[getUnitStatusIndexForRC(RC_BACK_CENTER)])
-            << V_BORDER << formatCardForDisplayImproved(rear_guard_circles[RC_BACK_RIGHT], card_cell_width, unit_is_standing[getUnitStatusIndexForRC(RC_BACK_RIGHT)])
-            << V_BORDER << std::endl;
+  out << "  ";
+  v_border();
+  appendCardCell(out, getUnitAt(getUnitStatusIndexForRC(RC_BACK_LEFT)), card_cell_width, unit_is_standing[getUnitStatusIndexForRC(RC_BACK_LEFT)]);
+  v_border();
+  appendCardCell(out, getUnitAt(getUnitStatusIndexForRC(RC_BACK_CENTER)), card_cell_width, unit_is_standing[getUnitStatusIndexForRC(RC_BACK_CENTER)]);
+  v_border();
+  appendCardCell(out, getUnitAt(getUnitStatusIndexForRC(RC_BACK_RIGHT)), card_cell_width, unit_is_standing[getUnitStatusIndexForRC(RC_BACK_RIGHT)]);
+  v_border() << '\n';
 
   // Back Row Labels
-  std::cout << "  " << V_BORDER << std::left << std::setw(card_cell_width) << std::setfill(' ')
-            << (show_opponent_field_for_targeting ? Colors::YELLOW + "   (2: RC BL)" + Colors::RESET : Colors::BRIGHT_BLACK + "   (RC BL)" + Colors::RESET)
-            << V_BORDER << std::left << std::setw(card_cell_width) << std::setfill(' ')
-            << (show_opponent_field_for_targeting ? Colors::YELLOW + "   (3: RC BC)" + Colors::RESET : Colors::BRIGHT_BLACK + "   (RC BC)" + Colors::RESET)
-            << V_BORDER << std::left << std::setw(card_cell_width) << std::setfill(' ')
-            << (show_opponent_field_for_targeting ? Colors::YELLOW + "   (4: RC BR)" + Colors::RESET : Colors::BRIGHT_BLACK + "   (RC BR)" + Colors::RESET)
-            << V_BORDER << std::endl;
+  out << "  ";
+  v_border();
+  slot_label("   (2: RC BL)", "   (RC BL)");
+  v_border();
+  slot_label("   (3: RC BC)", "   (RC BC)");
+  v_border();
+  slot_label("   (4: RC BR)", "   (RC BR)");
+  v_border() << '\n';
 
   // Field Separator (Bottom)
-  std::cout << "  " << Colors::CYAN << "└" << H_BORDER_THIN_SEGMENT << "┴" << H_BORDER_THIN_SEGMENT
-            << "┴" << H_BORDER_THIN_SEGMENT << "┘" << Colors::RESET << std::endl;
+  out << "  " << Colors::CYAN << "└";
+  h_border('-') << "┴";
+  h_border('-') << "┴";
+  h_border('-') << "┘" << Colors::RESET << '\n';
 
   // Damage Zone
-  std::cout << "\n"
-            << Colors::RED << Icons::DAMAGE << " Damage Zone (" << damage_zone.size() << "): " << Colors::RESET;
+  out << "\n"
+      << Colors::RED << Icons::DAMAGE << " Damage Zone (" << damage_zone.size() << "): " << Colors::RESET;
   if (damage_zone.empty())
   {
-    std::cout << Colors::BRIGHT_BLACK << "(ยังไม่ได้รับดาเมจ)" << Colors::RESET;
+    out << Colors::BRIGHT_BLACK << "(ยังไม่ได้รับดาเมจ)" << Colors::RESET;
   }
   else
   {
     for (size_t i = 0; i < damage_zone.size(); ++i)
     {
-      std::string name_short = damage_zone[i].getName().substr(0, 6);
-      if (damage_zone[i].getName().length() > 6)
+      const Card &damage_card = cardOf(damage_zone[i]);
+      std::string_view damage_name = damage_card.getNameView();
+      out << Colors::RED << "[" << UIHelper::GetGradeIcon(damage_card.getGrade())
+          << " " << damage_name.substr(0, 6);
+      if (damage_name.length() > 6)
       {
-        name_short += "..";
+        out << "..";
       }
-      std::cout << Colors::RED << "[" << UIHelper::GetGradeIcon(damage_zone[i].getGrade())
-                << " " << name_short << "]" << Colors::RESET;
+      out << "]" << Colors::RESET;
       if (i < damage_zone.size() - 1)
-        std::cout << " ";
+        out << " ";
     }
   }
-  std::cout << std::endl;
-  UIHelper::PrintHorizontalLine('=', 70, Colors::CYAN);
+  out << '\n';
+  UIHelper::AppendHorizontalLine(out, "=", 70, Colors::CYAN);
 }
 
 void Player::displayHand(bool show_details) const
 {
+  if (!OutputSink::Enabled())
+    return;
+  TRACE_SPAN("ui", "Player::displayHand");
+  ALLOC_SCOPE(UI);
   UIHelper::PrintHorizontalLine('-', 40, Colors::YELLOW);
-  std::cout << Colors::YELLOW << Icons::HAND << " มือของ " << Colors::BOLD << name
-            << Colors::RESET << Colors::YELLOW << " (" << hand.size() << " ใบ)" << Colors::RESET << std::endl;
+  Out() << Colors::YELLOW << Icons::HAND << " มือของ " << Colors::BOLD << name
+        << Colors::RESET << Colors::YELLOW << " (" << hand.size() << " ใบ)" << Colors::RESET << std::endl;
 
   if (hand.empty())
   {
-    std::cout << Colors::BRIGHT_BLACK << "(มือว่าง)" << Colors::RESET << std::endl;
+    Out() << Colors::BRIGHT_BLACK << "(มือว่าง)" << Colors::RESET << std::endl;
   }
   else
   {
     for (size_t i = 0; i < hand.size(); ++i)
     {
-      std::cout << Colors::CYAN << "[" << i << "] " << Colors::RESET
-                << UIHelper::FormatCard(hand[i].getName(), hand[i].getGrade());
+      const Card &card = cardOf(hand[i]);
+      Out() << Colors::CYAN << "[" << i << "] " << Colors::RESET
+            << UIHelper::FormatCard(card.getNameView(), card.getGrade());
       if (show_details)
       {
-        std::cout << " " << UIHelper::FormatPowerShield(hand[i].getPower(), hand[i].getShield());
+        Out() << " " << UIHelper::FormatPowerShield(card.getPower(), card.getShield());
       }
-      std::cout << std::endl;
+      Out() << std::endl;
     }
   }
   UIHelper::PrintHorizontalLine('-', 40, Colors::YELLOW);
@@ -838,15 +902,27 @@ void Player::displayHand(bool show_details) const
 // Getters
 std::string Player::getName() const { return name; }
 size_t Player::getHandSize() const { return hand.size(); }
-const std::vector<Card> &Player::getHand() const { return hand; }
+CardZoneView Player::getHand() const { return CardZoneView(hand, deck.getCardTable()); }
 size_t Player::getDamageCount() const { return damage_zone.size(); }
-const std::optional<Card> &Player::getVanguard() const { return vanguard_circle; }
-const std::array<std::optional<Card>, NUM_REAR_GUARD_CIRCLES> &Player::getRearGuards() const { return rear_guard_circles; }
+size_t Player::getSoulCount() const { return soul.size(); }
+size_t Player::getDropZoneCount() const { return drop_zone.size(); }
+const Card *Player::getVanguard() const { return getUnitAt(UNIT_STATUS_VC_IDX); }
+std::array<const Card *, NUM_REAR_GUARD_CIRCLES> Player::getRearGuards() const
+{
+  std::array<const Card *, NUM_REAR_GUARD_CIRCLES> rear_guards{};
+  for (size_t i = 0; i < NUM_REAR_GUARD_CIRCLES; ++i)
+  {
+    rear_guards[i] = getUnitAt(getUnitStatusIndexForRC(i));
+  }
+  return rear_guards;
+}
+CardZoneView Player::getGuardianZone() const { return CardZoneView(guardian_zone, deck.getCardTable()); }
 Deck &Player::getDeck() { return deck; }
 const Deck &Player::getDeck() const { return deck; }
 
 void Player::displayFullStatus() const
 {
+  ALLOC_SCOPE(UI);
   UIHelper::ClearScreen();
   UIHelper::PrintSectionHeader("FULL STATUS: " + name, Icons::PLAYER);
   displayField();
@@ -856,33 +932,43 @@ void Player::displayFullStatus() const
 
 void Player::takeDamage(const Card &damage_card)
 {
-  UIHelper::ShowDamageAnimation();
-  std::cout << Colors::BRIGHT_RED << Icons::DAMAGE << " " << name << " ได้รับ 1 ดาเมจ! " << Colors::RESET
-            << "การ์ดที่ตก Damage Zone: " << UIHelper::FormatCard(damage_card.getName(), damage_card.getGrade()) << std::endl;
-  damage_zone.push_back(damage_card);
+  ALLOC_SCOPE(Player);
+  if (OutputSink::Enabled())
+  {
+    UIHelper::ShowDamageAnimation();
+    Out() << Colors::BRIGHT_RED << Icons::DAMAGE << " " << name << " ได้รับ 1 ดาเมจ! " << Colors::RESET
+          << "การ์ดที่ตก Damage Zone: " << UIHelper::FormatCard(damage_card.getNameView(), damage_card.getGrade()) << std::endl;
+  }
+  damage_zone.push_back(idOf(damage_card));
   if (getDamageCount() >= MAX_DAMAGE)
   {
-    std::cout << Colors::BRIGHT_RED << Colors::BOLD << Icons::SKULL << " " << name
-              << " ได้รับ " << MAX_DAMAGE << " ดาเมจแล้ว! " << name << " แพ้แล้ว! " << Icons::SKULL
-              << Colors::RESET << std::endl;
+    Out() << Colors::BRIGHT_RED << Colors::BOLD << Icons::SKULL << " " << name
+          << " ได้รับ " << MAX_DAMAGE << " ดาเมจแล้ว! " << name << " แพ้แล้ว! " << Icons::SKULL
+          << Colors::RESET << std::endl;
     // Potentially add game over logic here or set a flag
   }
 }
 
 void Player::addCardToHand(const Card &card)
 {
-  hand.push_back(card);
+  ALLOC_SCOPE(Player);
+  hand.push_back(idOf(card));
 }
 
 void Player::clearGuardianZoneAndMoveToDrop()
 {
+  ALLOC_SCOPE(Player);
   if (!guardian_zone.empty())
   {
-    std::cout << Colors::BRIGHT_BLACK << Icons::DROP << " " << name << " ย้ายการ์ดจาก Guardian Zone ไป Drop Zone:" << Colors::RESET << std::endl;
-    for (const auto &card : guardian_zone)
+    Out() << Colors::BRIGHT_BLACK << Icons::DROP << " " << name << " ย้ายการ์ดจาก Guardian Zone ไป Drop Zone:" << Colors::RESET << std::endl;
+    for (CardId id : guardian_zone)
     {
-      std::cout << "  - " << UIHelper::FormatCard(card.getName(), card.getGrade()) << std::endl;
-      drop_zone.push_back(card);
+      if (OutputSink::Enabled())
+      {
+        const Card &card = cardOf(id);
+        Out() << "  - " << UIHelper::FormatCard(card.getNameView(), card.getGrade()) << std::endl;
+      }
+      drop_zone.push_back(id);
     }
     guardian_zone.clear();
   }
@@ -890,19 +976,194 @@ void Player::clearGuardianZoneAndMoveToDrop()
 
 void Player::discardFromHandToDrop(size_t hand_card_index)
 {
+  ALLOC_SCOPE(Player);
   if (hand_card_index < hand.size())
   {
-    Card discarded_card = hand[hand_card_index];
-    std::cout << Colors::BRIGHT_BLACK << Icons::DROP << " " << name << " ทิ้งการ์ด '"
-              << discarded_card.getName() << "' จากมือลง Drop Zone." << Colors::RESET << std::endl;
+    const Card &discarded_card = cardOf(hand[hand_card_index]);
+    drop_zone.push_back(hand[hand_card_index]);
+    Out() << Colors::BRIGHT_BLACK << Icons::DROP << " " << name << " ทิ้งการ์ด '"
+          << discarded_card.getNameView() << "' จากมือลง Drop Zone." << Colors::RESET << std::endl;
     hand.erase(hand.begin() + hand_card_index);
-    drop_zone.push_back(discarded_card);
   }
 }
 
 void Player::placeCardIntoSoul(const Card &card)
 {
-  soul.push_back(card);
-  std::cout << Colors::MAGENTA << Icons::SOUL << " " << name << " วางการ์ด '"
-            << card.getName() << "' ลง Soul." << Colors::RESET << std::endl;
-}
\ No newline at end of file
+  ALLOC_SCOPE(Player);
+  soul.push_back(idOf(card));
+  Out() << Colors::MAGENTA << Icons::SOUL << " " << name << " วางการ์ด '"
+        << card.getNameView() << "' ลง Soul." << Colors::RESET << std::endl;
+}
+
+// ป้อนสถานะทั้งหมดของผู้เล่นให้ checksum ตามลำดับที่ตายตัว
+void Player::hashState(StateHash &hash) const
+{
+  hash.addString(name);
+  hash.addInt(turn_count);
+  hash.addCard(getUnitAt(UNIT_STATUS_VC_IDX));
+  for (size_t rc = 0; rc < NUM_REAR_GUARD_CIRCLES; ++rc)
+  {
+    hash.addCard(getUnitAt(getUnitStatusIndexForRC(rc)));
+  }
+  for (int unit = 0; unit < NUM_FIELD_UNITS; ++unit)
+  {
+    hash.addByte(unit_is_standing[static_cast<size_t>(unit)] ? 1 : 0);
+    hash.addInt(current_battle_power_buffs[static_cast<size_t>(unit)]);
+    hash.addInt(current_battle_crit_buffs[static_cast<size_t>(unit)]);
+  }
+  const CardTable &table = deck.getCardTable();
+  auto hashZone = [&hash, &table](const auto &zone)
+  {
+    hash.addInt(static_cast<int64_t>(zone.size()));
+    for (CardId id : zone)
+    {
+      hash.addCard(table.getCard(id));
+    }
+  };
+  hashZone(hand);
+  hashZone(damage_zone);
+  hashZone(soul);
+  hashZone(drop_zone);
+  hashZone(guardian_zone);
+  deck.hashState(hash);
+}
+
+// เขียนสถานะของผู้เล่นเป็นรหัสการ์ด บรรทัดละ 1 โซน
+void Player::dumpState(std::ostream &out) const
+{
+  const CardTable &table = deck.getCardTable();
+  auto writeZone = [&out, &table](const char *title, const auto &zone)
+  {
+    out << title << " (" << zone.size() << "):";
+    for (CardId id : zone)
+    {
+      out << " " << table.getCard(id).getCodeNameView();
+    }
+    out << "\n";
+  };
+  auto unitCode = [this](size_t unit) -> std::string_view
+  {
+    const Card *card = getUnitAt(unit);
+    return card ? card->getCodeNameView() : std::string_view("-");
+  };
+
+  out << "player: " << name << " (turn_count " << turn_count << ")\n";
+  out << "vanguard: " << unitCode(UNIT_STATUS_VC_IDX)
+      << (unit_is_standing[UNIT_STATUS_VC_IDX] ? " stand" : " rest") << "\n";
+  for (size_t rc = 0; rc < NUM_REAR_GUARD_CIRCLES; ++rc)
+  {
+    size_t unit = getUnitStatusIndexForRC(rc);
+    out << "rc" << rc << ": " << unitCode(unit)
+        << (unit_is_standing[unit] ? " stand" : " rest") << "\n";
+  }
+  out << "buffs:";
+  for (size_t unit = 0; unit < current_battle_power_buffs.size(); ++unit)
+  {
+    out << " " << current_battle_power_buffs[unit] << "/" << current_battle_crit_buffs[unit];
+  }
+  out << "\n";
+  writeZone("hand", hand);
+  writeZone("damage", damage_zone);
+  writeZone("soul", soul);
+  writeZone("drop", drop_zone);
+  writeZone("guardian", guardian_zone);
+  deck.dumpState(out);
+}
+
+void Player::saveState(StateEncoder &out) const
+{
+  out.addInt(turn_count);
+  out.addCard(getUnitAt(UNIT_STATUS_VC_IDX));
+  for (size_t rc = 0; rc < NUM_REAR_GUARD_CIRCLES; ++rc)
+  {
+    out.addCard(getUnitAt(getUnitStatusIndexForRC(rc)));
+  }
+  uint64_t standing_bits = 0;
+  for (size_t unit = 0; unit < unit_is_standing.size(); ++unit)
+  {
+    standing_bits |= static_cast<uint64_t>(unit_is_standing[unit] ? 1 : 0) << unit;
+  }
+  out.addUnsigned(standing_bits);
+  for (size_t unit = 0; unit < current_battle_power_buffs.size(); ++unit)
+  {
+    out.addInt(current_battle_power_buffs[unit]);
+    out.addInt(current_battle_crit_buffs[unit]);
+  }
+  const CardTable &table = deck.getCardTable();
+  out.addCards(CardZoneView(hand, table));
+  out.addCards(CardZoneView(damage_zone, table));
+  out.addCards(CardZoneView(soul, table));
+  out.addCards(CardZoneView(drop_zone, table));
+  out.addCards(CardZoneView(guardian_zone, table));
+  deck.saveState(out);
+}
+
+// อ่านการ์ด 1 ใบแล้วแปลงเป็น CardId ของสำรับ (การ์ดที่ไม่อยู่ในสูตรสำรับถือว่าข้อมูลเสีย)
+static CardId readCardId(StateDecoder &in, const CardTable &table, bool allow_empty)
+{
+  const Card *card = in.readCardRef();
+  if (!card)
+  {
+    if (!allow_empty)
+    {
+      in.markInvalid();
+    }
+    return INVALID_CARD_ID;
+  }
+  CardId id = table.findId(card->getCodeNameView());
+  if (id == INVALID_CARD_ID)
+  {
+    in.markInvalid();
+  }
+  return id;
+}
+
+// อ่านรายการการ์ดมาแทนที่ zone (เกิน max_count/ความจุของโซน ถือว่าข้อมูลเสีย)
+template <typename Zone>
+static void readCardIds(StateDecoder &in, const CardTable &table, Zone &zone, size_t max_count)
+{
+  uint64_t count = in.readUnsigned();
+  zone.clear();
+  if (count > max_count || count > zone.max_size())
+  {
+    in.markInvalid();
+    return;
+  }
+  for (uint64_t i = 0; i < count && in.isValid(); ++i)
+  {
+    CardId id = readCardId(in, table, false);
+    if (id == INVALID_CARD_ID)
+    {
+      return;
+    }
+    zone.push_back(id);
+  }
+}
+
+void Player::loadState(StateDecoder &in)
+{
+  ALLOC_SCOPE(Player);
+  const CardTable &table = deck.getCardTable();
+  turn_count = static_cast<int>(in.readInt());
+  field_units[UNIT_STATUS_VC_IDX] = readCardId(in, table, true);
+  for (size_t rc = 0; rc < NUM_REAR_GUARD_CIRCLES; ++rc)
+  {
+    field_units[getUnitStatusIndexForRC(rc)] = readCardId(in, table, true);
+  }
+  uint64_t standing_bits = in.readUnsigned();
+  for (size_t unit = 0; unit < unit_is_standing.size(); ++unit)
+  {
+    unit_is_standing[unit] = ((standing_bits >> unit) & 1) != 0;
+  }
+  for (size_t unit = 0; unit < current_battle_power_buffs.size(); ++unit)
+  {
+    current_battle_power_buffs[unit] = static_cast<int>(in.readInt());
+    current_battle_crit_buffs[unit] = static_cast<int>(in.readInt());
+  }
+  readCardIds(in, table, hand, Deck::MAX_CARDS);
+  readCardIds(in, table, damage_zone, MAX_DAMAGE);
+  readCardIds(in, table, soul, Deck::MAX_CARDS);
+  readCardIds(in, table, drop_zone, Deck::MAX_CARDS);
+  readCardIds(in, table, guardian_zone, Deck::MAX_CARDS);
+  deck.loadState(in);
+}
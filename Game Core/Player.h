@@ -6,9 +6,18 @@
 #include <vector>
 #include <array>
 #include <optional>
+#include <cstdint>
+#include <iosfwd>
+#include <memory_resource>
 #include <utility> // สำหรับใช้งาน std::pair
 #include "Deck.h"  // สำหรับจัดการสำรับไพ่
 #include "Card.h"  // สำหรับข้อมูลการ์ด
+#include "CardTable.h"
+#include "StaticVector.h"
+
+class StateHash;
+class StateEncoder;
+class StateDecoder;
 
 // ค่าคงที่สำหรับตำแหน่งวางการ์ดบนสนาม (Rear-guard Circles)
 constexpr size_t RC_FRONT_LEFT = 0;   // ตำแหน่งซ้ายแถวหน้า
@@ -34,6 +43,7 @@ struct TriggerOutput
   int extra_crit = 0;         // คริติคอลเพิ่มเติม
   bool card_drawn = false;    // เช็คว่าได้จั่วการ์ดหรือไม่
   bool damage_healed = false; // เช็คว่าได้ฮีลหรือไม่
+  int triggers_revealed = 0;  // จำนวนการ์ด Trigger ที่เปิดได้ (ใช้ทำสถิติ)
 
   // ฟิลด์สำรองสำหรับการใช้งานในอนาคต
   int power_to_chosen_unit = 0;    // พลังโจมตีที่จะให้กับยูนิตที่เลือก
@@ -41,6 +51,49 @@ struct TriggerOutput
   int chosen_unit_status_idx = -1; // ดัชนีของยูนิตที่ถูกเลือก
 };
 
+// โซนการ์ดของผู้เล่น (มือ, Soul, Drop, Guardian) - เก็บ CardId ในตารางของสำรับไว้ในตัว Player เอง
+// การ์ดทุกใบในโซนมาจากสำรับของผู้เล่น จึงมีได้ไม่เกินขนาดสำรับ
+using CardZone = StaticVector<CardId, Deck::MAX_CARDS>;
+
+// มุมมองของโซนสำหรับผู้อ่านภายนอก: ไล่ CardId ในโซนแล้วคืนการ์ดจากตารางของสำรับ (ใช้ได้จนกว่าโซนจะเปลี่ยน)
+class CardZoneView
+{
+private:
+  const CardId *ids;
+  size_t count;
+  const CardTable *table;
+
+public:
+  class iterator
+  {
+  private:
+    const CardId *id;
+    const CardTable *table;
+
+  public:
+    iterator(const CardId *card_id, const CardTable *card_table) : id(card_id), table(card_table) {}
+    const Card &operator*() const { return table->getCard(*id); }
+    iterator &operator++()
+    {
+      ++id;
+      return *this;
+    }
+    bool operator!=(const iterator &other) const { return id != other.id; }
+  };
+
+  template <typename Zone>
+  CardZoneView(const Zone &zone, const CardTable &card_table) : ids(zone.data()), count(zone.size()), table(&card_table) {}
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  const Card &operator[](size_t index) const { return table->getCard(ids[index]); }
+  const Card &back() const { return table->getCard(ids[count - 1]); }
+  const CardId *data() const { return ids; } // CardId ในตารางของ getTable() (ใช้กับฟังก์ชันรวมค่าของ CardTable)
+  const CardTable &getTable() const { return *table; }
+  iterator begin() const { return iterator(ids, table); }
+  iterator end() const { return iterator(ids + count, table); }
+};
+
 // คลาส Player - จัดการข้อมูลและการกระทำของผู้เล่น
 class Player
 {
@@ -48,23 +101,27 @@ public:
   // --- ค่าคงที่สำหรับเงื่อนไขการชนะ ---
   static constexpr int MAX_DAMAGE = 2; // จำนวนดาเมจสูงสุดก่อนแพ้ (ปรับจาก 6 เป็น 2)
 
+  // Damage Zone - แมตช์จบทันทีที่ดาเมจครบ MAX_DAMAGE จึงไม่มีวันเกินนี้
+  using DamageZone = StaticVector<CardId, MAX_DAMAGE>;
+
+  using allocator_type = std::pmr::polymorphic_allocator<Card>; // สำรับของผู้เล่นจองจากที่นี่
+
 private:
   // ข้อมูลพื้นฐานของผู้เล่น
   std::string name; // ชื่อผู้เล่น
   Deck deck;        // สำรับไพ่
   int turn_count;   // จำนวนรอบที่เล่น
 
-  // การ์ดในส่วนต่างๆ
-  std::vector<Card> hand;                                                     // การ์ดบนมือ
-  std::optional<Card> vanguard_circle;                                        // การ์ดในตำแหน่ง Vanguard
-  std::array<std::optional<Card>, NUM_REAR_GUARD_CIRCLES> rear_guard_circles; // การ์ดในตำแหน่ง Rear-guard
-  std::array<bool, NUM_FIELD_UNITS> unit_is_standing;                         // สถานะการยืน/หมุนของยูนิต
+  // การ์ดในส่วนต่างๆ (ทุกช่องเก็บ CardId ในตารางของสำรับ ข้อมูลของการ์ดอ่านจาก cardOf())
+  CardZone hand;                                      // การ์ดบนมือ
+  std::array<CardId, NUM_FIELD_UNITS> field_units;    // ยูนิตตามดัชนีสถานะ: Vanguard แล้ว Rear-guard (INVALID_CARD_ID = ว่าง)
+  std::array<bool, NUM_FIELD_UNITS> unit_is_standing; // สถานะการยืน/หมุนของยูนิต
 
   // โซนพิเศษต่างๆ
-  std::vector<Card> damage_zone;   // โซนเก็บความเสียหาย
-  std::vector<Card> soul;          // โซน Soul
-  std::vector<Card> drop_zone;     // โซนทิ้งการ์ด
-  std::vector<Card> guardian_zone; // โซนการ์ดป้องกัน
+  DamageZone damage_zone; // โซนเก็บความเสียหาย
+  CardZone soul;          // โซน Soul
+  CardZone drop_zone;     // โซนทิ้งการ์ด
+  CardZone guardian_zone; // โซนการ์ดป้องกัน
 
   // บัฟต่างๆ ในรอบการต่อสู้
   std::array<int, NUM_FIELD_UNITS> current_battle_power_buffs; // บัฟพลังโจมตี
@@ -73,9 +130,22 @@ private:
   // ฟังก์ชันภายในสำหรับจั่วการ์ด
   void drawCards(int num_to_draw);
 
+  // แปลงระหว่างการ์ดกับ CardId ในตารางของสำรับ (การ์ดที่ไม่อยู่ในสำรับจะ throw std::invalid_argument)
+  const Card &cardOf(CardId id) const { return deck.getCardTable().getCard(id); }
+  CardId idOf(const Card &card) const;
+
 public:
   // Constructor
-  Player(const std::string &player_name, Deck &&player_deck);
+  Player(const std::string &player_name, Deck &&player_deck, const allocator_type &alloc = {});
+  Player(const std::string &player_name, const Deck &player_deck, const allocator_type &alloc = {});
+
+  // สำเนาผู้เล่นทั้งหมดโดยคัดลอกสำรับลงใน alloc (ใช้คัดลอกแมตช์ไปไว้ใน arena ใหม่ - โซนเป็น CardId จึงคัดลอกตรง ๆ)
+  Player(const Player &other, const allocator_type &alloc);
+
+  Player(const Player &other) = default;
+  Player(Player &&other) = default;
+  Player &operator=(const Player &other) = default;
+  Player &operator=(Player &&other) = default;
 
   // ฟังก์ชันช่วยแสดงเส้นคั่น
   static void printDisplayLine(char c = '-', int length = 70);
@@ -87,7 +157,9 @@ public:
   }
 
   // --- ฟังก์ชันเกี่ยวกับการเซ็ตอัพและเริ่มเกม ---
-  bool setupGame(const std::string &starter_code_name, int initial_hand_size = 5);
+  // shuffle_seed: seed สำหรับสับสำรับ (ไม่ระบุ = สุ่มจากเวลาระบบ)
+  bool setupGame(const std::string &starter_code_name, int initial_hand_size = 5,
+                 std::optional<uint64_t> shuffle_seed = std::nullopt);
 
   // --- ฟังก์ชันเกี่ยวกับเฟสต่างๆ ในเกม ---
   void performStandPhase(); // เฟสทำให้การ์ดกลับมายืน
@@ -95,14 +167,17 @@ public:
 
   // --- ฟังก์ชันเกี่ยวกับการต่อสู้ ---
   std::vector<std::pair<int, std::string>> chooseAttacker();
-  int chooseBooster(int attacker_unit_status_idx);
+  int chooseBooster(int attacker_unit_status_idx) const;
   void restUnit(int unit_status_idx);
   bool isUnitStanding(int unit_status_idx) const;
+  bool hasUnitAt(int unit_status_idx) const;
   std::optional<Card> getUnitAtStatusIndex(int unit_status_idx) const;
+  const Card *getUnitAt(int unit_status_idx) const; // เหมือน getUnitAtStatusIndex() แต่ไม่คัดลอกการ์ด (nullptr = ไม่มียูนิต)
   int getUnitPowerAtStatusIndex(int unit_status_idx, int booster_unit_status_idx = -1, bool for_defense = false) const;
 
   // --- ฟังก์ชันเกี่ยวกับการตรวจสอบ Trigger ---
   TriggerOutput performDriveCheck(int num_drives, Player *opponent_for_heal_check);
+  // วางการ์ดที่เปิดจาก Damage Check ลง Damage Zone แล้วใช้ผล Trigger ของการ์ดใบนั้น
   TriggerOutput handleDamageCheckTrigger(const Card &damage_card, Player *opponent_for_heal_check);
   int chooseUnitForTriggerEffect(const std::string &trigger_effect_description);
   bool healOneDamage();
@@ -110,9 +185,10 @@ public:
   // --- ฟังก์ชันเกี่ยวกับการป้องกันและ Intercept ---
   int addCardToGuardianZoneFromHand(size_t hand_card_index);
   int getGuardianZoneShieldTotal() const;
-  int performGuardStep(int incoming_attack_power, const std::optional<Card> &target_unit_opt);
 
   // --- ฟังก์ชันเกี่ยวกับการวางการ์ดบนสนาม ---
+  bool canRide(size_t hand_card_index) const;                       // ตรวจเงื่อนไขของ rideFromHand() โดยไม่เปลี่ยนสถานะ
+  bool canCall(size_t hand_card_index, size_t rc_slot_index) const; // ตรวจเงื่อนไขของ callToRearGuard() โดยไม่เปลี่ยนสถานะ
   bool rideFromHand(size_t hand_card_index);
   bool callToRearGuard(size_t hand_card_index, size_t rc_slot_index);
 
@@ -125,20 +201,31 @@ public:
   // --- ฟังก์ชันเข้าถึงข้อมูล (Getters) ---
   std::string getName() const;
   size_t getHandSize() const;
-  const std::vector<Card> &getHand() const;
+  CardZoneView getHand() const;
   size_t getDamageCount() const;
-  const std::optional<Card> &getVanguard() const;
-  const std::array<std::optional<Card>, NUM_REAR_GUARD_CIRCLES> &getRearGuards() const;
+  size_t getSoulCount() const;
+  size_t getDropZoneCount() const;
+  const Card *getVanguard() const;                                          // nullptr = ยังไม่มี Vanguard
+  std::array<const Card *, NUM_REAR_GUARD_CIRCLES> getRearGuards() const; // nullptr = ช่องว่าง
+  CardZoneView getGuardianZone() const;
   Deck &getDeck();
   const Deck &getDeck() const;
 
-  // --- ฟังก์ชันจัดการการ์ดและความเสียหาย ---
+  // --- ฟังก์ชันจัดการการ์ดและความเสียหาย (การ์ดต้องเป็นแบบที่มีในสำรับของผู้เล่น) ---
   void takeDamage(const Card &damage_card);
   void placeCardIntoSoul(const Card &card);
   void discardFromHandToDrop(size_t hand_card_index);
   void clearGuardianZoneAndMoveToDrop();
 
   void addCardToHand(const Card &card);
+
+  // --- ฟังก์ชันสำหรับตรวจสอบสถานะ (lockstep) ---
+  void hashState(StateHash &hash) const;   // ป้อนสถานะทั้งหมดของผู้เล่น (รวมลำดับการ์ดในสำรับ) ให้ checksum
+  void dumpState(std::ostream &out) const; // เขียนสถานะทั้งหมดเป็นข้อความธรรมดา (ใช้เทียบหาจุดที่ต่างกัน)
+
+  // --- ฟังก์ชันสำหรับบันทึก/โหลดสถานะ (keyframe ของ replay) ---
+  void saveState(StateEncoder &out) const; // ทุกโซนและสถานะของยูนิต ยกเว้นชื่อผู้เล่น
+  void loadState(StateDecoder &in);        // แทนที่สถานะทั้งหมดด้วยข้อมูลจาก saveState()
 };
 
 #endif // PLAYER_H
\ No newline at end of file
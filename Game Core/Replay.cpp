@@ -0,0 +1,791 @@
+// Replay.cpp - ไฟล์ Source สำหรับบันทึกและเล่นซ้ำแมตช์
+#include "Replay.h"
+#include "CardDatabase.h"
+#include "StateCodec.h"
+#include <algorithm>
+
+static const char REPLAY_MAGIC[] = "FIBORPL";        // 7 ไบต์แรกของไฟล์ (ไม่รวม '\0')
+static const char REPLAY_INDEX_MAGIC[] = "FIDX";     // 4 ไบต์สุดท้ายของไฟล์ที่มีส่วนท้าย
+static const uint8_t REPLAY_FORMAT_VERSION = 2;      // เปลี่ยนเมื่อรูปแบบไฟล์เปลี่ยน
+static const size_t REPLAY_READ_BUFFER_SIZE = 4096;  // ขนาดบัฟเฟอร์ของตัวอ่าน
+static const size_t REPLAY_TRAILER_SIZE = 12;        // u64 ตำแหน่งของ Index + "FIDX"
+static const uint64_t REPLAY_MAX_STATE_SIZE = 65536; // keyframe ที่ใหญ่กว่านี้ถือว่าข้อมูลเสีย
+
+// --- การเข้ารหัส ---
+
+static void putFixed(std::string &out, uint64_t value, int bytes)
+{
+  for (int i = 0; i < bytes; ++i)
+  {
+    out.push_back(static_cast<char>(value >> (8 * i)));
+  }
+}
+
+static void putString(std::string &out, const std::string &text)
+{
+  appendVarint(out, text.size());
+  out += text;
+}
+
+// --- ReplayWriter ---
+
+ReplayWriter::ReplayWriter()
+    : file(nullptr), keyframe_interval(DEFAULT_KEYFRAME_INTERVAL), actions_recorded(0), bytes_written(0), failed(false)
+{
+}
+
+ReplayWriter::~ReplayWriter()
+{
+  close();
+}
+
+bool ReplayWriter::open(const std::string &path, const ReplayHeader &header, const std::vector<Card> &catalog,
+                        int keyframe_every)
+{
+  close();
+  file = std::fopen(path.c_str(), "wb");
+  if (!file)
+  {
+    return false;
+  }
+  card_index = makeStateCardIndex(catalog);
+  keyframe_interval = keyframe_every;
+  keyframes.clear();
+  actions_recorded = 0;
+  bytes_written = 0;
+  failed = false;
+
+  record.assign(REPLAY_MAGIC, sizeof(REPLAY_MAGIC) - 1);
+  record.push_back(static_cast<char>(REPLAY_FORMAT_VERSION));
+  appendVarint(record, header.rules_version);
+  putFixed(record, header.seed, 8);
+  putFixed(record, header.catalog_checksum, 8);
+  record.push_back(static_cast<char>(header.first_player));
+  putString(record, header.starter_code_name);
+  for (size_t i = 0; i < 2; ++i)
+  {
+    putString(record, header.player_names[i]);
+    appendVarint(record, header.deck_recipes[i].size());
+    for (const auto &entry : header.deck_recipes[i])
+    {
+      putString(record, entry.first);
+      appendVarint(record, static_cast<uint64_t>(entry.second));
+    }
+  }
+  writeRecord();
+  return !failed;
+}
+
+void ReplayWriter::close()
+{
+  if (file)
+  {
+    uint64_t index_offset = bytes_written;
+    record.push_back(static_cast<char>(ReplayRecordType::Index));
+    appendVarint(record, keyframes.size());
+    for (const ReplayKeyframe &keyframe : keyframes)
+    {
+      appendVarint(record, static_cast<uint64_t>(keyframe.turn));
+      appendVarint(record, keyframe.offset);
+      appendVarint(record, keyframe.actions_before);
+    }
+    putFixed(record, index_offset, 8);
+    record.append(REPLAY_INDEX_MAGIC, sizeof(REPLAY_INDEX_MAGIC) - 1);
+    writeRecord();
+    std::fclose(file);
+    file = nullptr;
+  }
+}
+
+void ReplayWriter::writeRecord()
+{
+  if (file && !record.empty())
+  {
+    // เขียนทั้งรายการในครั้งเดียวแล้ว flush ทันที - ถ้าโปรแกรมล่มหลังจากนี้ รายการนี้ยังอยู่ในไฟล์
+    if (std::fwrite(record.data(), 1, record.size(), file) != record.size() || std::fflush(file) != 0)
+    {
+      failed = true;
+    }
+    bytes_written += record.size();
+  }
+  record.clear();
+}
+
+void ReplayWriter::recordAction(const GameAction &action)
+{
+  record.push_back(static_cast<char>(action.type));
+  switch (action.type)
+  {
+  case ActionType::Ride:
+  case ActionType::Guard:
+    appendVarint(record, static_cast<uint64_t>(action.source));
+    break;
+  case ActionType::Call:
+    appendVarint(record, static_cast<uint64_t>(action.source));
+    appendVarint(record, static_cast<uint64_t>(action.target));
+    break;
+  case ActionType::Attack:
+    appendVarint(record, static_cast<uint64_t>(action.source));
+    appendVarint(record, static_cast<uint64_t>(action.target));
+    appendVarint(record, static_cast<uint64_t>(action.booster + 1));
+    break;
+  default:
+    break;
+  }
+  actions_recorded++;
+  writeRecord();
+}
+
+void ReplayWriter::recordTurnEnd(const Match &match)
+{
+  record.push_back(static_cast<char>(ReplayRecordType::TurnEnd));
+  putFixed(record, replayChecksum(match), 4);
+  writeRecord();
+}
+
+void ReplayWriter::recordGameOver(const Match &match)
+{
+  record.push_back(static_cast<char>(ReplayRecordType::GameOver));
+  record.push_back(static_cast<char>(match.getEndReason()));
+  appendVarint(record, static_cast<uint64_t>(match.getWinnerIndex() + 1));
+  putFixed(record, replayChecksum(match), 4);
+  writeRecord();
+}
+
+void ReplayWriter::recordTurnStart(const Match &match)
+{
+  int turn = match.getTurnCount();
+  if (keyframe_interval <= 0 || turn <= 1 || (turn - 1) % keyframe_interval != 0)
+  {
+    return;
+  }
+
+  state.clear();
+  StateEncoder encoder(state, card_index);
+  match.saveState(encoder);
+
+  keyframes.push_back({turn, bytes_written, actions_recorded});
+  record.push_back(static_cast<char>(ReplayRecordType::Keyframe));
+  appendVarint(record, static_cast<uint64_t>(turn));
+  appendVarint(record, actions_recorded);
+  putString(record, state);
+  writeRecord();
+}
+
+// --- ReplayReader ---
+
+ReplayReader::ReplayReader()
+    : file(nullptr), buffer(REPLAY_READ_BUFFER_SIZE), window(buffer.data()), buffer_pos(0), buffer_end(0),
+      in_memory(false), offset(0), records_begin(0), truncated(false)
+{
+}
+
+ReplayReader::~ReplayReader()
+{
+  close();
+}
+
+bool ReplayReader::open(const std::string &path)
+{
+  close();
+  header = ReplayHeader();
+  offset = 0;
+  truncated = false;
+  error.clear();
+
+  file = std::fopen(path.c_str(), "rb");
+  if (!file)
+  {
+    error = "เปิดไฟล์ '" + path + "' ไม่ได้";
+    return false;
+  }
+  if (!readHeader())
+  {
+    if (error.empty())
+    {
+      error = "ส่วนหัวของไฟล์ replay ไม่ครบ";
+    }
+    close();
+    return false;
+  }
+  records_begin = offset;
+  return true;
+}
+
+bool ReplayReader::open(const uint8_t *data, size_t size)
+{
+  close();
+  header = ReplayHeader();
+  window = data;
+  buffer_end = size;
+  in_memory = true;
+  offset = 0;
+  truncated = false;
+  error.clear();
+
+  if (!readHeader())
+  {
+    if (error.empty())
+    {
+      error = "ส่วนหัวของไฟล์ replay ไม่ครบ";
+    }
+    close();
+    return false;
+  }
+  records_begin = offset;
+  return true;
+}
+
+void ReplayReader::close()
+{
+  if (file)
+  {
+    std::fclose(file);
+    file = nullptr;
+  }
+  window = buffer.data();
+  buffer_pos = buffer_end = 0;
+  in_memory = false;
+}
+
+bool ReplayReader::readByte(uint8_t &byte)
+{
+  if (buffer_pos == buffer_end)
+  {
+    if (in_memory)
+    {
+      return false; // ข้อมูลในหน่วยความจำมีทั้งไฟล์อยู่แล้ว อ่านหมดคือจบไฟล์
+    }
+    buffer_pos = 0;
+    buffer_end = file ? std::fread(buffer.data(), 1, buffer.size(), file) : 0;
+    if (buffer_end == 0)
+    {
+      return false;
+    }
+  }
+  byte = window[buffer_pos++];
+  offset++;
+  return true;
+}
+
+bool ReplayReader::readVarint(uint64_t &value)
+{
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7)
+  {
+    uint8_t byte;
+    if (!readByte(byte))
+    {
+      return false;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+    {
+      return true;
+    }
+  }
+  error = "varint ยาวเกิน 64 บิต";
+  return false;
+}
+
+bool ReplayReader::readFixed(uint64_t &value, int bytes)
+{
+  value = 0;
+  for (int i = 0; i < bytes; ++i)
+  {
+    uint8_t byte;
+    if (!readByte(byte))
+    {
+      return false;
+    }
+    value |= static_cast<uint64_t>(byte) << (8 * i);
+  }
+  return true;
+}
+
+bool ReplayReader::readString(std::string &text)
+{
+  uint64_t size;
+  if (!readVarint(size))
+  {
+    return false;
+  }
+  if (size > REPLAY_MAX_STATE_SIZE)
+  {
+    error = "ข้อความในไฟล์ยาวผิดปกติ";
+    return false;
+  }
+  text.clear();
+  for (uint64_t i = 0; i < size; ++i)
+  {
+    uint8_t byte;
+    if (!readByte(byte))
+    {
+      return false;
+    }
+    text.push_back(static_cast<char>(byte));
+  }
+  return true;
+}
+
+bool ReplayReader::readHeader()
+{
+  for (size_t i = 0; i < sizeof(REPLAY_MAGIC) - 1; ++i)
+  {
+    uint8_t byte;
+    if (!readByte(byte) || byte != static_cast<uint8_t>(REPLAY_MAGIC[i]))
+    {
+      error = "ไม่ใช่ไฟล์ replay";
+      return false;
+    }
+  }
+  uint8_t format_version;
+  if (!readByte(format_version))
+  {
+    return false;
+  }
+  if (format_version == 0 || format_version > REPLAY_FORMAT_VERSION) // รุ่น 1 ไม่มี keyframe และส่วนท้าย แต่อ่านได้เหมือนเดิม
+  {
+    error = "ไม่รองรับไฟล์ replay รุ่น " + std::to_string(format_version);
+    return false;
+  }
+
+  uint64_t value;
+  uint8_t byte;
+  if (!readVarint(value))
+    return false;
+  header.rules_version = static_cast<uint32_t>(value);
+  if (!readFixed(header.seed, 8) || !readFixed(header.catalog_checksum, 8) || !readByte(byte))
+    return false;
+  header.first_player = byte;
+  if (!readString(header.starter_code_name))
+    return false;
+
+  for (size_t i = 0; i < 2; ++i)
+  {
+    uint64_t entries;
+    if (!readString(header.player_names[i]) || !readVarint(entries))
+      return false;
+    uint64_t deck_size = 0;
+    for (uint64_t e = 0; e < entries; ++e)
+    {
+      std::string code_name;
+      if (!readString(code_name) || !readVarint(value))
+        return false;
+      if (value > Deck::MAX_CARDS - deck_size)
+        return false; // โซนการ์ดของผู้เล่นจุได้ไม่เกินขนาดสำรับสูงสุด
+      deck_size += value;
+      header.deck_recipes[i][code_name] = static_cast<int>(value);
+    }
+  }
+  return true;
+}
+
+bool ReplayReader::next(ReplayRecord &out)
+{
+  uint8_t tag;
+  if (!isOpen() || !readByte(tag))
+  {
+    return false; // จบไฟล์พอดีระหว่างรายการ
+  }
+
+  // อ่านส่วนที่เหลือของรายการ - ถ้าไฟล์จบก่อนครบแปลว่ารายการสุดท้ายเขียนไม่ครบ
+  bool complete = true;
+  uint64_t a = 0, b = 0, c = 0;
+  out = ReplayRecord();
+  switch (tag)
+  {
+  case static_cast<uint8_t>(ActionType::Ride):
+  case static_cast<uint8_t>(ActionType::Guard):
+    complete = readVarint(a);
+    out.action = {static_cast<ActionType>(tag), GameAction::narrow(static_cast<int>(a))};
+    break;
+  case static_cast<uint8_t>(ActionType::Call):
+    complete = readVarint(a) && readVarint(b);
+    out.action = GameAction::call(static_cast<int>(a), static_cast<int>(b));
+    break;
+  case static_cast<uint8_t>(ActionType::Attack):
+    complete = readVarint(a) && readVarint(b) && readVarint(c);
+    out.action = GameAction::attack(static_cast<int>(a), static_cast<int>(b), static_cast<int>(c) - 1);
+    break;
+  case static_cast<uint8_t>(ActionType::EndMain):
+  case static_cast<uint8_t>(ActionType::EndBattle):
+  case static_cast<uint8_t>(ActionType::EndGuard):
+    out.action = {static_cast<ActionType>(tag)};
+    break;
+  case static_cast<uint8_t>(ReplayRecordType::TurnEnd):
+    out.type = ReplayRecordType::TurnEnd;
+    complete = readFixed(a, 4);
+    out.checksum = static_cast<uint32_t>(a);
+    break;
+  case static_cast<uint8_t>(ReplayRecordType::GameOver):
+  {
+    uint8_t reason = 0;
+    out.type = ReplayRecordType::GameOver;
+    complete = readByte(reason) && readVarint(a) && readFixed(b, 4);
+    out.end_reason = static_cast<MatchEnd>(reason);
+    out.winner_idx = static_cast<int>(a) - 1;
+    out.checksum = static_cast<uint32_t>(b);
+    break;
+  }
+  case static_cast<uint8_t>(ReplayRecordType::Keyframe):
+    out.type = ReplayRecordType::Keyframe;
+    out.keyframe.offset = offset - 1;
+    complete = readVarint(a) && readVarint(out.keyframe.actions_before) && readString(out.state);
+    out.keyframe.turn = static_cast<int>(a);
+    break;
+  case static_cast<uint8_t>(ReplayRecordType::Index):
+    return false; // ส่วนท้ายไฟล์ - ไม่มีรายการของเกมต่อจากนี้
+  default:
+    error = "พบรายการชนิดที่ไม่รู้จัก (" + std::to_string(tag) + ") ที่ตำแหน่ง " + std::to_string(offset - 1);
+    return false;
+  }
+
+  if (!complete && error.empty())
+  {
+    truncated = true;
+  }
+  return complete;
+}
+
+bool ReplayReader::seek(uint64_t position)
+{
+  if (in_memory)
+  {
+    if (position > buffer_end)
+    {
+      return false;
+    }
+    buffer_pos = static_cast<size_t>(position);
+  }
+  else if (!file || std::fseek(file, static_cast<long>(position), SEEK_SET) != 0)
+  {
+    return false;
+  }
+  else
+  {
+    buffer_pos = buffer_end = 0;
+  }
+  offset = position;
+  truncated = false;
+  error.clear();
+  return true;
+}
+
+// อ่านรายการ Index ที่ตำแหน่งปัจจุบัน
+bool ReplayReader::readIndexRecord(std::vector<ReplayKeyframe> &keyframes)
+{
+  uint8_t tag;
+  uint64_t count;
+  if (!readByte(tag) || tag != static_cast<uint8_t>(ReplayRecordType::Index) || !readVarint(count))
+  {
+    return false;
+  }
+  keyframes.clear();
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    uint64_t turn;
+    ReplayKeyframe keyframe;
+    if (!readVarint(turn) || !readVarint(keyframe.offset) || !readVarint(keyframe.actions_before))
+    {
+      return false;
+    }
+    keyframe.turn = static_cast<int>(turn);
+    keyframes.push_back(keyframe);
+  }
+  return true;
+}
+
+bool ReplayReader::readKeyframes(std::vector<ReplayKeyframe> &keyframes)
+{
+  if (!isOpen())
+  {
+    return false;
+  }
+
+  // ไฟล์ที่ปิดเรียบร้อยมีตำแหน่งของ Index อยู่ใน 12 ไบต์สุดท้าย
+  bool from_footer = false;
+  uint8_t trailer[REPLAY_TRAILER_SIZE];
+  bool has_trailer = false;
+  if (in_memory)
+  {
+    has_trailer = buffer_end >= REPLAY_TRAILER_SIZE;
+    if (has_trailer)
+    {
+      std::copy(window + buffer_end - REPLAY_TRAILER_SIZE, window + buffer_end, trailer);
+    }
+  }
+  else if (std::fseek(file, -static_cast<long>(REPLAY_TRAILER_SIZE), SEEK_END) == 0)
+  {
+    has_trailer = std::fread(trailer, 1, sizeof(trailer), file) == sizeof(trailer);
+  }
+  if (has_trailer &&
+      std::equal(trailer + 8, trailer + REPLAY_TRAILER_SIZE, reinterpret_cast<const uint8_t *>(REPLAY_INDEX_MAGIC)))
+  {
+    uint64_t index_offset = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+      index_offset |= static_cast<uint64_t>(trailer[i]) << (8 * i);
+    }
+    from_footer = index_offset >= records_begin && seek(index_offset) && readIndexRecord(keyframes);
+  }
+
+  // ไม่มีส่วนท้าย (เช่น โปรแกรมที่บันทึกล่ม) - ไล่อ่านทุกรายการเพื่อหา keyframe
+  if (!from_footer)
+  {
+    keyframes.clear();
+    seek(records_begin);
+    ReplayRecord record;
+    while (next(record))
+    {
+      if (record.type == ReplayRecordType::Keyframe)
+      {
+        keyframes.push_back(record.keyframe);
+      }
+    }
+  }
+  return seek(records_begin);
+}
+
+// --- ReplaySimulator ---
+
+ReplaySimulator::ReplaySimulator()
+    : observer(nullptr), catalog(nullptr), indexed_catalog(nullptr), indexed_checksum(0), actions_applied(0),
+      checksums_verified(0), finished(false)
+{
+}
+
+bool ReplaySimulator::open(const std::string &path, const std::vector<Card> &card_catalog, MatchObserver *match_observer)
+{
+  match.reset();
+  if (!reader.open(path))
+  {
+    error = reader.getError();
+    return false;
+  }
+  return begin(card_catalog, match_observer);
+}
+
+bool ReplaySimulator::open(const uint8_t *data, size_t size, const std::vector<Card> &card_catalog,
+                           MatchObserver *match_observer)
+{
+  match.reset();
+  if (!reader.open(data, size))
+  {
+    error = reader.getError();
+    return false;
+  }
+  return begin(card_catalog, match_observer);
+}
+
+bool ReplaySimulator::begin(const std::vector<Card> &card_catalog, MatchObserver *match_observer)
+{
+  observer = match_observer;
+  catalog = &card_catalog;
+  keyframes.clear();
+  error.clear();
+
+  if (indexed_catalog != &card_catalog)
+  {
+    indexed_catalog = &card_catalog;
+    indexed_checksum = catalogChecksum(card_catalog);
+    card_index = makeStateCardIndex(card_catalog);
+  }
+
+  const ReplayHeader &header = reader.getHeader();
+  if (header.rules_version != Match::RULES_VERSION)
+  {
+    error = "ไฟล์บันทึกด้วยกติกาเวอร์ชัน " + std::to_string(header.rules_version) +
+            " แต่โปรแกรมนี้ใช้เวอร์ชัน " + std::to_string(Match::RULES_VERSION);
+    return false;
+  }
+  if (header.catalog_checksum != indexed_checksum)
+  {
+    error = "ข้อมูลการ์ดไม่ตรงกับตอนบันทึก (checksum ของแคตตาล็อกต่างกัน)";
+    return false;
+  }
+  reader.readKeyframes(keyframes);
+  return restart();
+}
+
+bool ReplaySimulator::restart()
+{
+  const ReplayHeader &header = reader.getHeader();
+  pending_checksums.clear();
+  actions_applied = 0;
+  checksums_verified = 0;
+  finished = false;
+  error.clear();
+
+  match = std::make_unique<Match>(header.player_names[0], Deck(*catalog, header.deck_recipes[0]),
+                                  header.player_names[1], Deck(*catalog, header.deck_recipes[1]));
+  if (!match->setup(header.starter_code_name, header.seed))
+  {
+    error = "ไม่พบการ์ด starter '" + header.starter_code_name + "'";
+    return false;
+  }
+  match->setObserver(observer);
+  match->setRecorder(this);
+  match->start(header.first_player);
+  return reader.seek(reader.getRecordsBegin());
+}
+
+bool ReplaySimulator::loadKeyframe(const ReplayKeyframe &keyframe)
+{
+  ReplayRecord record;
+  if (!reader.seek(keyframe.offset) || !reader.next(record) || record.type != ReplayRecordType::Keyframe)
+  {
+    error = "อ่าน keyframe ของเทิร์น " + std::to_string(keyframe.turn) + " ไม่ได้";
+    return false;
+  }
+  StateDecoder decoder(record.state, *catalog);
+  if (!match->loadState(decoder))
+  {
+    error = "ข้อมูล keyframe ของเทิร์น " + std::to_string(keyframe.turn) + " เสียหาย";
+    return false;
+  }
+  pending_checksums.clear();
+  actions_applied = record.keyframe.actions_before;
+  finished = false;
+  error.clear();
+  return true;
+}
+
+// keyframe สุดท้ายที่ไม่เกินทั้งเทิร์นและจำนวนการกระทำที่กำหนด (nullptr = ต้องเริ่มจากต้นเกม)
+const ReplayKeyframe *ReplaySimulator::nearestKeyframe(int turn, uint64_t action) const
+{
+  const ReplayKeyframe *nearest = nullptr;
+  for (const ReplayKeyframe &keyframe : keyframes)
+  {
+    if (keyframe.turn <= turn && keyframe.actions_before <= action)
+    {
+      nearest = &keyframe;
+    }
+  }
+  return nearest;
+}
+
+bool ReplaySimulator::seekAction(uint64_t action)
+{
+  if (!match)
+  {
+    return false;
+  }
+
+  // เดินต่อจากตำแหน่งปัจจุบันได้ถ้าเป้าหมายอยู่ข้างหน้าและไม่มี keyframe ที่ใกล้กว่า
+  const ReplayKeyframe *nearest = nearestKeyframe(INT32_MAX, action);
+  bool forward = action >= actions_applied && error.empty() &&
+                 (nearest == nullptr || nearest->actions_before <= actions_applied);
+  if (!forward && !(nearest ? loadKeyframe(*nearest) : restart()))
+  {
+    return false;
+  }
+  while (actions_applied < action && step())
+  {
+  }
+  return actions_applied == action;
+}
+
+bool ReplaySimulator::seekTurn(int turn)
+{
+  if (!match)
+  {
+    return false;
+  }
+
+  const ReplayKeyframe *nearest = nearestKeyframe(turn, UINT64_MAX);
+  int current = match->getTurnCount();
+  bool forward = current < turn && error.empty() && (nearest == nullptr || nearest->turn <= current);
+  if (!forward && !(nearest ? loadKeyframe(*nearest) : restart()))
+  {
+    return false;
+  }
+  while (match->getTurnCount() < turn && step())
+  {
+  }
+  return match->getTurnCount() == turn && !match->isOver();
+}
+
+bool ReplaySimulator::step(ReplayRecord *out)
+{
+  if (!match || finished || !error.empty())
+  {
+    return false;
+  }
+
+  ReplayRecord record;
+  if (!reader.next(record))
+  {
+    error = reader.getError();
+    return false;
+  }
+  if (out)
+  {
+    *out = record;
+  }
+
+  switch (record.type)
+  {
+  case ReplayRecordType::Action:
+    if (!match->submit(record.action))
+    {
+      error = "การกระทำที่ " + std::to_string(actions_applied + 1) + " ไม่ถูกต้องในสถานะที่เดินเกมซ้ำ (เทิร์น " +
+              std::to_string(match->getTurnCount()) + ")";
+      return false;
+    }
+    actions_applied++;
+    return true;
+
+  case ReplayRecordType::TurnEnd:
+    return verifyChecksum(record.checksum);
+
+  case ReplayRecordType::Keyframe:
+  {
+    // keyframe ต้องตรงกับสถานะที่เดินเกมซ้ำมาทุกไบต์
+    std::string current;
+    StateEncoder encoder(current, card_index);
+    match->saveState(encoder);
+    if (current != record.state)
+    {
+      error = "keyframe ของเทิร์น " + std::to_string(record.keyframe.turn) + " ไม่ตรงกับสถานะที่เดินเกมซ้ำ";
+      return false;
+    }
+    return true;
+  }
+
+  case ReplayRecordType::GameOver:
+    if (!match->isOver() && record.end_reason == MatchEnd::Conceded && record.winner_idx >= 0)
+    {
+      match->concede(1 - record.winner_idx);
+    }
+    finished = true;
+    if (!match->isOver() || match->getEndReason() != record.end_reason || match->getWinnerIndex() != record.winner_idx)
+    {
+      error = "ผลการแข่งขันที่เดินเกมซ้ำไม่ตรงกับที่บันทึกไว้";
+      return false;
+    }
+    return verifyChecksum(record.checksum);
+
+  default:
+    return false;
+  }
+}
+
+bool ReplaySimulator::verifyChecksum(uint32_t recorded)
+{
+  if (pending_checksums.empty())
+  {
+    error = "ไฟล์มี checksum ที่ตำแหน่ง " + std::to_string(reader.getOffset()) + " แต่แมตช์ที่เดินซ้ำยังไม่จบเทิร์น";
+    return false;
+  }
+  uint32_t computed = pending_checksums.front();
+  pending_checksums.erase(pending_checksums.begin());
+  if (computed != recorded)
+  {
+    error = "checksum ไม่ตรงกับที่บันทึกไว้ (เทิร์น " + std::to_string(match->getTurnCount()) +
+            ") - การเดินเกมซ้ำแยกทางจากเกมจริง";
+    return false;
+  }
+  checksums_verified++;
+  return true;
+}
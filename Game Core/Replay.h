@@ -0,0 +1,238 @@
+// Replay.h - ไฟล์ Header สำหรับบันทึกและเล่นซ้ำแมตช์ (Replay)
+// ไฟล์ replay เก็บเฉพาะข้อมูลที่จำเป็นต่อการเดินเกมซ้ำ: ส่วนหัว (seed, เวอร์ชันกติกา, checksum ของแคตตาล็อก,
+// สูตรเด็ค) ตามด้วยการกระทำที่ถูกยอมรับทีละรายการในรูปแบบ varint
+// ผลสุ่มทั้งหมดของเกม (ลำดับสำรับ ซึ่งกำหนดการ์ดที่จั่ว Drive Check และ Damage Check) มาจาก seed ในส่วนหัว
+// ท้ายทุกเทิร์นบันทึก checksum 32 บิตของสถานะไว้ด้วย ตัวอ่านจึงรู้ทันทีถ้าการเดินเกมซ้ำแยกทางจากเกมจริง
+//
+// รูปแบบไฟล์ (ตัวเลขหลายไบต์เป็น little-endian, varint = LEB128 ไม่มีเครื่องหมาย)
+//   ส่วนหัว: "FIBORPL" u8 รุ่นรูปแบบไฟล์, varint เวอร์ชันกติกา, u64 seed, u64 checksum แคตตาล็อก,
+//            u8 ผู้เล่นที่เริ่มก่อน, str รหัส starter, ผู้เล่น 2 คน × (str ชื่อ, varint จำนวนรายการ, (str รหัส, varint จำนวน)...)
+//   ข้อมูล:  u8 ชนิดรายการ ตามด้วยข้อมูลของรายการนั้น (ดู ReplayRecordType)
+//   ท้ายไฟล์: รายการ Index (ตำแหน่งของทุก keyframe) ตามด้วย u64 ตำแหน่งของรายการ Index และ "FIDX"
+//   str = varint ความยาว ตามด้วยข้อความ UTF-8
+//
+// ทุก N เทิร์นจะมี keyframe (สถานะทั้งหมด ณ การตัดสินใจแรกของเทิร์น) แทรกอยู่ในไฟล์
+// การกระโดดไปเทิร์นใดก็ได้จึงโหลด keyframe ที่ใกล้ที่สุดแล้วเดินเกมต่ออีกไม่กี่การกระทำ ไม่ต้องเริ่มจากเทิร์น 1
+//
+// ตัวเขียนต่อท้ายไฟล์อย่างเดียวและส่งข้อมูลออกจากบัฟเฟอร์ทุกรายการ ถ้าโปรแกรมล่มกลางเกม
+// ไฟล์จะมีทุกการกระทำก่อนหน้า (รายการสุดท้ายที่เขียนไม่ครบจะถูกตัวอ่านข้ามไป) จึงเล่นซ้ำถึงจุดที่ล่มได้
+// ส่วนท้ายไฟล์เขียนตอนปิดไฟล์เท่านั้น ไฟล์ที่ไม่มีส่วนท้ายจะถูกไล่อ่านทั้งไฟล์ 1 รอบเพื่อหา keyframe แทน
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdio>
+#include <cstdint>
+#include <unordered_map>
+#include "Match.h"
+
+// ข้อมูลที่ต้องใช้สร้างแมตช์ขึ้นมาใหม่ให้เหมือนเดิม
+struct ReplayHeader
+{
+  uint32_t rules_version = Match::RULES_VERSION;
+  uint64_t seed = 0;
+  uint64_t catalog_checksum = 0; // catalogChecksum() ของแคตตาล็อกที่ใช้ตอนเล่น
+  int first_player = 0;
+  std::string starter_code_name;
+  std::array<std::string, 2> player_names;
+  std::array<std::map<std::string, int>, 2> deck_recipes;
+};
+
+// ชนิดของรายการในไฟล์ - ค่า 0-6 ตรงกับ ActionType ของการกระทำ
+enum class ReplayRecordType : uint8_t
+{
+  Action = 0,      // การกระทำ: ไบต์ชนิดคือ ActionType ตามด้วย varint ตามชนิด (ตำแหน่ง, ช่อง RC, Booster + 1)
+  TurnEnd = 0x10,  // จบเทิร์น: u32 checksum (32 บิตล่างของ Match::checksum())
+  GameOver = 0x11, // จบเกม: u8 MatchEnd, varint ผู้ชนะ + 1, u32 checksum ของสถานะสุดท้าย
+  Keyframe = 0x12, // สถานะทั้งหมด: varint เทิร์น, varint จำนวนการกระทำก่อนหน้า, varint ความยาว, ข้อมูลจาก Match::saveState()
+  Index = 0x13     // ส่วนท้ายไฟล์: varint จำนวน keyframe, (varint เทิร์น, varint ตำแหน่งในไฟล์, varint จำนวนการกระทำก่อนหน้า)...
+};
+
+// ตำแหน่งของ keyframe 1 จุด
+struct ReplayKeyframe
+{
+  int turn = 0;
+  uint64_t offset = 0;         // ตำแหน่งในไฟล์ของรายการ Keyframe
+  uint64_t actions_before = 0; // จำนวนการกระทำก่อนถึง keyframe นี้
+};
+
+// รายการ 1 รายการที่อ่านได้จากไฟล์
+struct ReplayRecord
+{
+  ReplayRecordType type = ReplayRecordType::Action;
+  GameAction action{ActionType::EndMain}; // ใช้เมื่อ type == Action
+  uint32_t checksum = 0;                  // ใช้เมื่อ type == TurnEnd หรือ GameOver
+  MatchEnd end_reason = MatchEnd::None;   // ใช้เมื่อ type == GameOver
+  int winner_idx = -1;                    // ใช้เมื่อ type == GameOver
+  ReplayKeyframe keyframe;                // ใช้เมื่อ type == Keyframe
+  std::string state;                      // ใช้เมื่อ type == Keyframe
+};
+
+// 32 บิตล่างของ checksum ที่เก็บในไฟล์ (พอสำหรับจับการแยกทาง แต่ใช้พื้นที่ครึ่งเดียว)
+inline uint32_t replayChecksum(const Match &match) { return static_cast<uint32_t>(match.checksum()); }
+
+// ตัวเขียนไฟล์ replay - ตั้งให้แมตช์ด้วย Match::setRecorder() แล้วแมตช์จะบันทึกเองทุกการกระทำที่ยอมรับ
+class ReplayWriter : public MatchRecorder
+{
+public:
+  static constexpr int DEFAULT_KEYFRAME_INTERVAL = 5; // เทิร์นระหว่าง keyframe (ราว 150 ไบต์ต่อ keyframe)
+
+private:
+  std::FILE *file;
+  std::string record; // บัฟเฟอร์ของรายการที่กำลังเข้ารหัส
+  std::string state;  // บัฟเฟอร์ของสถานะใน keyframe
+  std::unordered_map<std::string, uint32_t> card_index;
+  int keyframe_interval;
+  std::vector<ReplayKeyframe> keyframes; // เขียนเป็นส่วนท้ายไฟล์ตอนปิด
+  uint64_t actions_recorded;
+  uint64_t bytes_written;
+  bool failed;
+
+  void writeRecord(); // เขียนรายการใน record ต่อท้ายไฟล์ทีเดียวแล้ว flush
+
+public:
+  ReplayWriter();
+  ~ReplayWriter();
+  ReplayWriter(const ReplayWriter &) = delete;
+  ReplayWriter &operator=(const ReplayWriter &) = delete;
+
+  // สร้างไฟล์ใหม่ (เขียนทับไฟล์เดิม) แล้วเขียนส่วนหัว - คืนค่า false ถ้าเปิดไฟล์ไม่ได้
+  // catalog: แคตตาล็อกที่ใช้สร้างเด็ค (การ์ดใน keyframe เก็บเป็นดัชนีในแคตตาล็อกนี้), keyframe_every: 0 = ไม่ทำ keyframe
+  bool open(const std::string &path, const ReplayHeader &header, const std::vector<Card> &catalog,
+            int keyframe_every = DEFAULT_KEYFRAME_INTERVAL);
+  void close(); // เขียนส่วนท้ายไฟล์ (Index) แล้วปิดไฟล์
+  bool isOpen() const { return file != nullptr; }
+  bool hasFailed() const { return failed; } // เขียนไฟล์ไม่สำเร็จอย่างน้อย 1 ครั้ง (เช่น ดิสก์เต็ม)
+  uint64_t getBytesWritten() const { return bytes_written; }
+
+  void recordAction(const GameAction &action) override;
+  void recordTurnEnd(const Match &match) override;
+  void recordGameOver(const Match &match) override;
+  void recordTurnStart(const Match &match) override;
+};
+
+// ตัวอ่านไฟล์ replay แบบทีละรายการ - อ่านผ่านบัฟเฟอร์ขนาดคงที่ ไม่โหลดทั้งไฟล์เข้าหน่วยความจำ
+// หรืออ่านตรงจากข้อมูลที่อยู่ในหน่วยความจำแล้ว (เช่น ไฟล์ที่ mmap ไว้) โดยไม่คัดลอก
+class ReplayReader
+{
+private:
+  std::FILE *file;
+  ReplayHeader header;
+  std::vector<uint8_t> buffer;
+  const uint8_t *window; // ข้อมูลที่กำลังอ่าน: buffer หรือข้อมูลทั้งไฟล์ในหน่วยความจำ
+  size_t buffer_pos;     // ตำแหน่งใน window
+  size_t buffer_end;
+  bool in_memory;
+  uint64_t offset;        // ตำแหน่งในไฟล์ของไบต์ถัดไปที่จะอ่าน
+  uint64_t records_begin; // ตำแหน่งของรายการแรกหลังส่วนหัว
+  bool truncated;
+  std::string error;
+
+  bool readByte(uint8_t &byte);
+  bool readVarint(uint64_t &value);
+  bool readFixed(uint64_t &value, int bytes);
+  bool readString(std::string &text);
+  bool readHeader();
+  bool readIndexRecord(std::vector<ReplayKeyframe> &keyframes);
+
+public:
+  ReplayReader();
+  ~ReplayReader();
+  ReplayReader(const ReplayReader &) = delete;
+  ReplayReader &operator=(const ReplayReader &) = delete;
+
+  // เปิดไฟล์และอ่านส่วนหัว - คืนค่า false ถ้าเปิดไม่ได้หรือไม่ใช่ไฟล์ replay (ดูสาเหตุจาก getError())
+  bool open(const std::string &path);
+
+  // อ่านจากข้อมูลในหน่วยความจำ (ข้อมูลต้องอยู่จนกว่าจะปิดตัวอ่านหรือเปิดไฟล์อื่น)
+  bool open(const uint8_t *data, size_t size);
+  void close();
+  bool isOpen() const { return file != nullptr || in_memory; }
+
+  // อ่านรายการถัดไป - คืนค่า false เมื่อจบไฟล์ (หรือถึงส่วนท้ายไฟล์) หรือพบรายการที่เขียนไม่ครบ (isTruncated())
+  // หรือข้อมูลผิดรูปแบบ (getError() ไม่ว่าง)
+  bool next(ReplayRecord &out);
+
+  // ย้ายไปอ่านที่ตำแหน่งที่กำหนด (ต้องเป็นตำแหน่งเริ่มของรายการ เช่น ReplayKeyframe::offset)
+  bool seek(uint64_t position);
+
+  // รายการ keyframe ทั้งหมด: อ่านจากส่วนท้ายไฟล์ หรือไล่อ่านทั้งไฟล์ถ้าไม่มีส่วนท้าย
+  // (ตำแหน่งอ่านกลับไปที่รายการแรกหลังส่วนหัว)
+  bool readKeyframes(std::vector<ReplayKeyframe> &keyframes);
+
+  const ReplayHeader &getHeader() const { return header; }
+  uint64_t getOffset() const { return offset; }
+  uint64_t getRecordsBegin() const { return records_begin; }
+  bool isTruncated() const { return truncated; } // ไฟล์จบกลางรายการ (เช่น โปรแกรมที่บันทึกล่ม)
+  const std::string &getError() const { return error; }
+};
+
+// เดินเกมซ้ำจากไฟล์ replay ทีละรายการ และตรวจ checksum ท้ายทุกเทิร์นกับค่าที่บันทึกไว้
+// ตัวจำลองเป็นตัวบันทึกของแมตช์ที่เดินซ้ำเอง จึงได้ checksum ณ จุดเดียวกับตอนบันทึก
+// (รายการ TurnEnd อยู่หลังการกระทำที่จบเทิร์น ซึ่งตอนนั้นแมตช์เริ่มเทิร์นถัดไปแล้ว)
+// keyframe ที่พบระหว่างเดินเกมตามลำดับจะถูกเทียบกับสถานะที่เดินซ้ำทุกไบต์ด้วย
+class ReplaySimulator : private MatchRecorder
+{
+private:
+  ReplayReader reader;
+  std::unique_ptr<Match> match;
+  MatchObserver *observer;
+  const std::vector<Card> *catalog;
+  const std::vector<Card> *indexed_catalog; // แคตตาล็อกที่คำนวณ checksum และ card_index ไว้แล้ว
+  uint64_t indexed_checksum;
+  std::unordered_map<std::string, uint32_t> card_index;
+  std::vector<ReplayKeyframe> keyframes;
+  std::vector<uint32_t> pending_checksums; // checksum ที่แมตช์คำนวณแล้วแต่ยังไม่ได้เทียบกับไฟล์
+  uint64_t actions_applied;
+  uint64_t checksums_verified;
+  bool finished;
+  std::string error;
+
+  void recordAction(const GameAction &) override {}
+  void recordTurnEnd(const Match &state) override { pending_checksums.push_back(replayChecksum(state)); }
+  void recordGameOver(const Match &state) override { pending_checksums.push_back(replayChecksum(state)); }
+  bool begin(const std::vector<Card> &card_catalog, MatchObserver *match_observer); // ตรวจส่วนหัวแล้วเริ่มแมตช์
+  bool verifyChecksum(uint32_t recorded);
+  bool restart();                                    // สร้างแมตช์ใหม่จากส่วนหัวแล้วอ่านจากรายการแรก
+  bool loadKeyframe(const ReplayKeyframe &keyframe); // โหลดสถานะจาก keyframe แล้วอ่านต่อจากรายการถัดไป
+  const ReplayKeyframe *nearestKeyframe(int turn, uint64_t action) const;
+
+public:
+  ReplaySimulator();
+
+  // เปิดไฟล์ สร้างเด็คจากแคตตาล็อกตามสูตรในส่วนหัว แล้วเริ่มแมตช์
+  // คืนค่า false ถ้าไฟล์เสีย แคตตาล็อกไม่ตรงกับตอนบันทึก (checksum ต่างกัน) หรือเวอร์ชันกติกาไม่ตรง
+  // เปิดด้วยแคตตาล็อกชุดเดิมซ้ำๆ (เช่น วิเคราะห์ไฟล์จำนวนมาก) จะคำนวณ checksum ของแคตตาล็อกครั้งเดียว
+  // จึงห้ามแก้ไขแคตตาล็อกระหว่างการเปิดแต่ละครั้ง
+  bool open(const std::string &path, const std::vector<Card> &catalog, MatchObserver *match_observer = nullptr);
+  bool open(const uint8_t *data, size_t size, const std::vector<Card> &catalog, MatchObserver *match_observer = nullptr);
+
+  // เดินเกมตามรายการถัดไป 1 รายการ (ถ้า out ไม่ใช่ nullptr จะคัดลอกรายการนั้นให้)
+  // คืนค่า false เมื่อจบไฟล์หรือพบปัญหา (getError() ว่าง = จบไฟล์ตามปกติ)
+  bool step(ReplayRecord *out = nullptr);
+
+  // ย้อนกลับ 1 การกระทำ (โหลด keyframe ที่ใกล้ที่สุดก่อนหน้าแล้วเดินต่อ)
+  bool stepBack() { return actions_applied > 0 && seekAction(actions_applied - 1); }
+
+  // ไปยังสถานะหลังการกระทำครั้งที่ action (0 = ก่อนการกระทำแรก)
+  bool seekAction(uint64_t action);
+
+  // ไปยังการตัดสินใจแรกของเทิร์นที่กำหนด - คืนค่า false ถ้าเกมจบก่อนถึงเทิร์นนั้น
+  bool seekTurn(int turn);
+
+  const Match &getMatch() const { return *match; }
+  const ReplayHeader &getHeader() const { return reader.getHeader(); }
+  uint64_t getActionsApplied() const { return actions_applied; }
+  uint64_t getChecksumsVerified() const { return checksums_verified; }
+  uint64_t getBytesRead() const { return reader.getOffset(); }
+  const std::vector<ReplayKeyframe> &getKeyframes() const { return keyframes; }
+  bool isFinished() const { return finished; } // อ่านถึงรายการ GameOver แล้ว
+  bool isTruncated() const { return reader.isTruncated(); }
+  const std::string &getError() const { return error; }
+};
+
+#endif // REPLAY_H
@@ -0,0 +1,31 @@
+// SimdDispatch.h - ไฟล์ Header สำหรับเลือกโค้ด SIMD ตามความสามารถของ CPU ขณะรัน
+// สคริปต์ build ของเกม compile ด้วย -O2 เฉยๆ (ไม่มี -mavx2) เพื่อให้ไฟล์โปรแกรมรันได้ทุกเครื่อง x86-64
+// ฟังก์ชันที่ใช้ AVX2 จึงประกาศด้วย SIMD_TARGET_AVX2 แล้วถูกเรียกเฉพาะเมื่อ cpuHasAvx2() เป็นจริง
+// คอมไพเลอร์/สถาปัตยกรรมอื่น (เช่น MSVC, ARM) ใช้โค้ดแบบ scalar เสมอ
+#ifndef SIMDDISPATCH_H
+#define SIMDDISPATCH_H
+
+#include <cstdlib>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_HAS_AVX2_DISPATCH 1
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#else
+#define SIMD_HAS_AVX2_DISPATCH 0
+#define SIMD_TARGET_AVX2
+#endif
+
+// CPU เครื่องนี้รองรับ AVX2 หรือไม่ (ตรวจครั้งเดียวต่อโปรแกรม)
+// ตั้งตัวแปรสภาพแวดล้อม FIBO_NO_SIMD เพื่อบังคับใช้โค้ด scalar (ใช้เทียบผลและวัดความเร็ว)
+inline bool cpuHasAvx2()
+{
+#if SIMD_HAS_AVX2_DISPATCH
+  static const bool has_avx2 = std::getenv("FIBO_NO_SIMD") == nullptr && __builtin_cpu_supports("avx2");
+  return has_avx2;
+#else
+  return false;
+#endif
+}
+
+#endif // SIMDDISPATCH_H
@@ -0,0 +1,24 @@
+// Simulation.h - ไฟล์ Header สำหรับบอกว่าเธรดปัจจุบันกำลังเดินเกมจำลองของบอท (เช่นการจำลองของ RolloutSearch)
+// เกมจำลองไม่ใช่เกมที่เล่นจริง ระหว่างนั้นตัวนับของ gameMetrics() จึงไม่ถูกนับ และ TRACE_SPAN ไม่บันทึก
+// (บอท 1 ตัวจำลองหลายพันเกมต่อการตัดสินใจ ถ้านับด้วยจะกลบสถิติสมดุลของเกมจริงและทำให้ไฟล์ trace ใหญ่เกินใช้)
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+inline thread_local int simulation_depth = 0; // จำนวน ScopedSimulation ที่ซ้อนกันอยู่ในเธรดนี้
+
+inline bool isSimulating()
+{
+  return simulation_depth > 0;
+}
+
+// ทุกอย่างที่เธรดนี้ทำจนออกจาก scope ถือเป็นเกมจำลอง (ซ้อนกันได้)
+class ScopedSimulation
+{
+public:
+  ScopedSimulation() { ++simulation_depth; }
+  ~ScopedSimulation() { --simulation_depth; }
+  ScopedSimulation(const ScopedSimulation &) = delete;
+  ScopedSimulation &operator=(const ScopedSimulation &) = delete;
+};
+
+#endif // SIMULATION_H
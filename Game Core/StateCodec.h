@@ -0,0 +1,175 @@
+// StateCodec.h - ไฟล์ Header สำหรับเข้ารหัส/ถอดรหัสสถานะเกมทั้งหมดเป็นไบต์ (ใช้ทำ keyframe ของ replay)
+// การ์ดเก็บเป็นดัชนีในแคตตาล็อก (varint) แทนรหัสการ์ด ผู้อ่านจึงต้องใช้แคตตาล็อกชุดเดียวกับตอนเขียน
+// (replay ตรวจเรื่องนี้ด้วย checksum ของแคตตาล็อกในส่วนหัวอยู่แล้ว)
+#ifndef STATECODEC_H
+#define STATECODEC_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include "Card.h"
+
+// ต่อ varint (LEB128 ไม่มีเครื่องหมาย) ท้าย out
+inline void appendVarint(std::string &out, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+// ตัวเข้ารหัสสถานะ - ต่อข้อมูลท้าย out
+class StateEncoder
+{
+private:
+  std::string &out;
+  const std::unordered_map<std::string, uint32_t> &card_index; // รหัสการ์ด -> ดัชนีในแคตตาล็อก
+
+public:
+  StateEncoder(std::string &output, const std::unordered_map<std::string, uint32_t> &index)
+      : out(output), card_index(index) {}
+
+  void addUnsigned(uint64_t value) { appendVarint(out, value); }
+
+  // จำนวนเต็มมีเครื่องหมายแบบ zigzag (ค่าติดลบเล็กๆ เช่น -1 ใช้ 1 ไบต์)
+  void addInt(int64_t value)
+  {
+    appendVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+  }
+
+  // การ์ดเก็บเป็นดัชนี + 1 (0 = ไม่มีการ์ด)
+  void addCard(const Card *card)
+  {
+    if (!card)
+    {
+      appendVarint(out, 0);
+      return;
+    }
+    auto it = card_index.find(card->getCodeName());
+    appendVarint(out, it != card_index.end() ? it->second + 1ull : 0);
+  }
+
+  void addCard(const std::optional<Card> &card) { addCard(card.has_value() ? &card.value() : nullptr); }
+
+  template <typename CardList>
+  void addCards(const CardList &cards)
+  {
+    appendVarint(out, cards.size());
+    for (const Card &card : cards)
+    {
+      addCard(&card);
+    }
+  }
+};
+
+// ตัวถอดรหัสสถานะ - อ่านจากบัฟเฟอร์ที่กำหนด ข้อมูลที่ขาดหรือผิดรูปแบบทำให้ isValid() เป็น false
+class StateDecoder
+{
+private:
+  const uint8_t *data;
+  size_t size;
+  size_t pos;
+  const std::vector<Card> &catalog;
+  bool valid;
+
+public:
+  StateDecoder(const std::string &input, const std::vector<Card> &card_catalog)
+      : data(reinterpret_cast<const uint8_t *>(input.data())), size(input.size()), pos(0),
+        catalog(card_catalog), valid(true) {}
+
+  bool isValid() const { return valid; }
+  void markInvalid() { valid = false; } // ผู้อ่านพบข้อมูลที่ใช้ไม่ได้ (เช่นการ์ดที่ผู้เล่นคนนั้นมีไม่ได้)
+  bool isAtEnd() const { return pos == size; }
+
+  uint64_t readUnsigned()
+  {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+      if (pos >= size)
+      {
+        break;
+      }
+      uint8_t byte = data[pos++];
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+      {
+        return value;
+      }
+    }
+    valid = false;
+    return 0;
+  }
+
+  int64_t readInt()
+  {
+    uint64_t zigzag = readUnsigned();
+    return static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+  }
+
+  // การ์ดในแคตตาล็อกโดยไม่คัดลอก (nullptr = ไม่มีการ์ด หรือดัชนีเกินแคตตาล็อกซึ่งทำให้ isValid() เป็น false)
+  const Card *readCardRef()
+  {
+    uint64_t index = readUnsigned();
+    if (index == 0)
+    {
+      return nullptr;
+    }
+    if (index > catalog.size())
+    {
+      valid = false;
+      return nullptr;
+    }
+    return &catalog[static_cast<size_t>(index - 1)];
+  }
+
+  std::optional<Card> readCard()
+  {
+    const Card *card = readCardRef();
+    if (!card)
+    {
+      return std::nullopt;
+    }
+    return *card;
+  }
+
+  // อ่านรายการการ์ดมาแทนที่ cards (ช่องว่างในรายการ หรือการ์ดเกิน max_count/ความจุของโซน ถือว่าข้อมูลเสีย)
+  template <typename CardList>
+  void readCards(CardList &cards, size_t max_count)
+  {
+    uint64_t count = readUnsigned();
+    cards.clear();
+    if (count > max_count || count > cards.max_size())
+    {
+      valid = false;
+      return;
+    }
+    for (uint64_t i = 0; i < count && valid; ++i)
+    {
+      const Card *card = readCardRef();
+      if (!card)
+      {
+        valid = false;
+        return;
+      }
+      cards.push_back(*card);
+    }
+  }
+};
+
+// ดัชนีการ์ดสำหรับ StateEncoder
+inline std::unordered_map<std::string, uint32_t> makeStateCardIndex(const std::vector<Card> &catalog)
+{
+  std::unordered_map<std::string, uint32_t> index;
+  for (size_t i = 0; i < catalog.size(); ++i)
+  {
+    index.emplace(catalog[i].getCodeName(), static_cast<uint32_t>(i));
+  }
+  return index;
+}
+
+#endif // STATECODEC_H
@@ -0,0 +1,61 @@
+// StateHash.h - ไฟล์ Header สำหรับคำนวณ checksum 64 บิตของสถานะเกม
+// ใช้ FNV-1a แบบป้อนทีละไบต์ ผลลัพธ์จึงเหมือนกันทุกเครื่องไม่ขึ้นกับ endianness หรือขนาดของ int
+// ใช้เทียบสถานะระหว่าง 2 เครื่องที่เดินเกมเดียวกัน (lockstep) ไม่ได้ออกแบบมาเพื่อความปลอดภัย
+#ifndef STATEHASH_H
+#define STATEHASH_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <optional>
+#include "Card.h"
+
+class StateHash
+{
+private:
+  uint64_t value = 14695981039346656037ull; // FNV offset basis
+
+public:
+  void addByte(uint8_t byte)
+  {
+    value = (value ^ byte) * 1099511628211ull; // FNV prime
+  }
+
+  // จำนวนเต็มทุกชนิดถูกขยายเป็น 8 ไบต์ก่อน (little-endian)
+  void addInt(int64_t number)
+  {
+    uint64_t bits = static_cast<uint64_t>(number);
+    for (int i = 0; i < 8; ++i)
+    {
+      addByte(static_cast<uint8_t>(bits >> (8 * i)));
+    }
+  }
+
+  void addString(std::string_view text)
+  {
+    addInt(static_cast<int64_t>(text.size()));
+    for (char c : text)
+    {
+      addByte(static_cast<uint8_t>(c));
+    }
+  }
+
+  // การ์ดระบุด้วยรหัสการ์ด (ข้อมูลอื่นของการ์ดรหัสเดียวกันเหมือนกันเสมอ)
+  void addCard(const Card &card) { addString(card.getCodeNameView()); }
+
+  // ช่องวางการ์ด (nullptr = ว่าง)
+  void addCard(const Card *card)
+  {
+    addByte(card ? 1 : 0);
+    if (card)
+    {
+      addCard(*card);
+    }
+  }
+
+  void addCard(const std::optional<Card> &card) { addCard(card.has_value() ? &card.value() : nullptr); }
+
+  uint64_t get() const { return value; }
+};
+
+#endif // STATEHASH_H
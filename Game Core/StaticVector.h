@@ -0,0 +1,168 @@
+// StaticVector.h - ไฟล์ Header สำหรับ vector ความจุคงที่ที่เก็บสมาชิกไว้ในตัวออบเจ็กต์เอง (ไม่จองหน่วยความจำเพิ่ม)
+// ใช้กับโซนการ์ดของผู้เล่นที่รู้ขนาดสูงสุดแน่นอน (มือ, Damage, Soul, Drop, Guardian เก็บเป็น CardId)
+// เพิ่มเกินความจุจะ throw std::length_error เหมือน std::vector ที่จองหน่วยความจำไม่ได้
+//
+// ถ้า T ใช้ allocator (เช่น Card ที่มีข้อความแบบ std::pmr) สมาชิกทุกตัวถูกสร้างด้วย allocator ของ StaticVector
+#ifndef STATICVECTOR_H
+#define STATICVECTOR_H
+
+#include <cstddef>
+#include <new>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include <memory_resource>
+
+template <typename T, size_t N>
+class StaticVector
+{
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = T *;
+  using const_iterator = const T *;
+  using allocator_type = std::pmr::polymorphic_allocator<T>;
+
+private:
+  alignas(T) unsigned char storage[N * sizeof(T)];
+  size_t count;
+  allocator_type alloc;
+
+  T *slots() { return std::launder(reinterpret_cast<T *>(storage)); }
+  const T *slots() const { return std::launder(reinterpret_cast<const T *>(storage)); }
+
+  template <typename... Args>
+  void constructAt(T *slot, Args &&...args)
+  {
+    if constexpr (std::uses_allocator<T, allocator_type>::value)
+    {
+      ::new (static_cast<void *>(slot)) T(std::forward<Args>(args)..., alloc);
+    }
+    else
+    {
+      ::new (static_cast<void *>(slot)) T(std::forward<Args>(args)...);
+    }
+  }
+
+  void checkRoom() const
+  {
+    if (count >= N)
+    {
+      throw std::length_error("StaticVector: capacity exceeded");
+    }
+  }
+
+public:
+  StaticVector() : count(0) {}
+  explicit StaticVector(const allocator_type &allocator) : count(0), alloc(allocator) {}
+
+  // สำเนาแบบไม่ระบุ allocator ใช้หน่วยความจำปกติ (เหมือน std::pmr::vector)
+  StaticVector(const StaticVector &other) : StaticVector(other, allocator_type()) {}
+  StaticVector(const StaticVector &other, const allocator_type &allocator) : count(0), alloc(allocator)
+  {
+    for (const T &item : other)
+    {
+      constructAt(slots() + count, item);
+      ++count;
+    }
+  }
+
+  StaticVector(StaticVector &&other) : StaticVector(std::move(other), other.alloc) {}
+  StaticVector(StaticVector &&other, const allocator_type &allocator) : count(0), alloc(allocator)
+  {
+    for (T &item : other)
+    {
+      constructAt(slots() + count, std::move(item));
+      ++count;
+    }
+    other.clear();
+  }
+
+  ~StaticVector() { clear(); }
+
+  StaticVector &operator=(const StaticVector &other)
+  {
+    if (this != &other)
+    {
+      clear();
+      for (const T &item : other)
+      {
+        push_back(item);
+      }
+    }
+    return *this;
+  }
+
+  StaticVector &operator=(StaticVector &&other)
+  {
+    if (this != &other)
+    {
+      clear();
+      for (T &item : other)
+      {
+        push_back(std::move(item));
+      }
+      other.clear();
+    }
+    return *this;
+  }
+
+  allocator_type get_allocator() const { return alloc; }
+
+  iterator begin() { return slots(); }
+  iterator end() { return slots() + count; }
+  const_iterator begin() const { return slots(); }
+  const_iterator end() const { return slots() + count; }
+  T *data() { return slots(); }
+  const T *data() const { return slots(); }
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  static constexpr size_t capacity() { return N; }
+  static constexpr size_t max_size() { return N; }
+
+  T &operator[](size_t idx) { return slots()[idx]; }
+  const T &operator[](size_t idx) const { return slots()[idx]; }
+  T &front() { return slots()[0]; }
+  const T &front() const { return slots()[0]; }
+  T &back() { return slots()[count - 1]; }
+  const T &back() const { return slots()[count - 1]; }
+
+  void push_back(const T &item) { emplace_back(item); }
+  void push_back(T &&item) { emplace_back(std::move(item)); }
+
+  template <typename... Args>
+  T &emplace_back(Args &&...args)
+  {
+    checkRoom();
+    constructAt(slots() + count, std::forward<Args>(args)...);
+    return slots()[count++];
+  }
+
+  void pop_back()
+  {
+    slots()[--count].~T();
+  }
+
+  // ลบสมาชิกที่ pos แล้วเลื่อนตัวที่อยู่ถัดไปขึ้นมา (คงลำดับเดิม)
+  iterator erase(const_iterator pos)
+  {
+    T *target = slots() + (pos - slots());
+    std::move(target + 1, end(), target);
+    pop_back();
+    return target;
+  }
+
+  void clear()
+  {
+    while (count > 0)
+    {
+      pop_back();
+    }
+  }
+};
+
+#endif // STATICVECTOR_H
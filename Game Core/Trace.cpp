@@ -0,0 +1,232 @@
+// Trace.cpp - ไฟล์ Source สำหรับบันทึกช่วงเวลาการทำงานและเขียน Chrome trace-event JSON
+#include "Trace.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// เหตุการณ์ 1 ช่วง (ph = "X" ในรูปแบบ Chrome trace-event)
+struct TraceEvent
+{
+  const char *category;
+  const char *name;
+  int64_t start_ns;
+  int64_t duration_ns;
+};
+
+static const size_t TRACE_CHUNK_EVENTS = 4096; // จองหน่วยความจำทีละก้อนเมื่อใช้จริง ไม่จองทั้งหมดตอนเริ่ม
+
+// บัฟเฟอร์ของเธรดเดียว: มีเธรดเจ้าของเท่านั้นที่เขียน เธรดอื่นอ่านได้ถึง count (acquire)
+// ก้อนข้อมูลไม่เคยถูกย้ายหรือคืนระหว่างบันทึก จึงอ่านเหตุการณ์ที่เผยแพร่แล้วได้อย่างปลอดภัย
+struct TraceThreadBuffer
+{
+  int tid = 0;
+  std::string thread_name; // ป้องกันด้วย registry_mutex
+  std::vector<std::unique_ptr<TraceEvent[]>> chunks;
+  std::atomic<size_t> count{0};
+  std::atomic<uint64_t> dropped{0};
+  std::atomic<uint32_t> generation{0};
+};
+
+std::atomic<bool> Trace::enabled{false};
+
+static std::atomic<uint32_t> trace_generation{0};
+static std::atomic<size_t> trace_capacity{0};
+static std::atomic<int64_t> trace_epoch_ns{0};
+static std::mutex registry_mutex;
+static std::vector<std::shared_ptr<TraceThreadBuffer>> registry; // ทุกเธรดที่เคยบันทึก (อยู่ต่อหลังเธรดจบ)
+
+static int64_t steadyNowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// บัฟเฟอร์ของเธรดปัจจุบัน (ลงทะเบียนครั้งแรกที่ใช้)
+static TraceThreadBuffer &threadBuffer()
+{
+  thread_local std::shared_ptr<TraceThreadBuffer> buffer;
+  if (!buffer)
+  {
+    buffer = std::make_shared<TraceThreadBuffer>();
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    buffer->tid = static_cast<int>(registry.size()) + 1;
+    buffer->thread_name = "thread " + std::to_string(buffer->tid);
+    registry.push_back(buffer);
+  }
+  return *buffer;
+}
+
+void Trace::start(size_t events_per_thread)
+{
+  enabled.store(false, std::memory_order_relaxed);
+  trace_capacity.store(events_per_thread, std::memory_order_relaxed);
+  trace_epoch_ns.store(steadyNowNs(), std::memory_order_relaxed);
+  trace_generation.fetch_add(1, std::memory_order_release);
+  enabled.store(true, std::memory_order_release);
+}
+
+void Trace::stop()
+{
+  enabled.store(false, std::memory_order_release);
+}
+
+void Trace::setThreadName(const std::string &name)
+{
+  TraceThreadBuffer &buffer = threadBuffer();
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  buffer.thread_name = name;
+}
+
+uint64_t Trace::getDroppedCount()
+{
+  uint32_t generation = trace_generation.load(std::memory_order_acquire);
+  uint64_t dropped = 0;
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  for (const auto &buffer : registry)
+  {
+    if (buffer->generation.load(std::memory_order_acquire) == generation)
+    {
+      dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+  }
+  return dropped;
+}
+
+int64_t Trace::now()
+{
+  return steadyNowNs() - trace_epoch_ns.load(std::memory_order_relaxed);
+}
+
+void Trace::record(const char *category, const char *name, int64_t start_ns, int64_t end_ns)
+{
+  TraceThreadBuffer &buffer = threadBuffer();
+  uint32_t generation = trace_generation.load(std::memory_order_acquire);
+  size_t capacity = trace_capacity.load(std::memory_order_relaxed);
+  size_t count = buffer.count.load(std::memory_order_relaxed);
+  if (buffer.generation.load(std::memory_order_relaxed) != generation)
+  {
+    // การบันทึกรอบใหม่: เธรดเจ้าของล้างบัฟเฟอร์ของตัวเอง (ก้อนข้อมูลเดิมใช้ซ้ำ)
+    // ตาราง chunks ขยายได้เฉพาะตอนนี้ที่ยังไม่มีเหตุการณ์ให้เธรดอื่นอ่าน
+    count = 0;
+    buffer.count.store(0, std::memory_order_relaxed);
+    buffer.dropped.store(0, std::memory_order_relaxed);
+    if (buffer.chunks.size() < (capacity + TRACE_CHUNK_EVENTS - 1) / TRACE_CHUNK_EVENTS)
+    {
+      buffer.chunks.resize((capacity + TRACE_CHUNK_EVENTS - 1) / TRACE_CHUNK_EVENTS);
+    }
+    buffer.generation.store(generation, std::memory_order_release);
+  }
+  if (count >= capacity)
+  {
+    buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  size_t chunk = count / TRACE_CHUNK_EVENTS;
+  if (!buffer.chunks[chunk])
+  {
+    buffer.chunks[chunk].reset(new TraceEvent[TRACE_CHUNK_EVENTS]);
+  }
+  buffer.chunks[chunk][count % TRACE_CHUNK_EVENTS] = {category, name, start_ns, end_ns - start_ns};
+  buffer.count.store(count + 1, std::memory_order_release);
+}
+
+// เขียนข้อความเป็น JSON string (ชื่อเธรดอาจมีอักขระพิเศษ)
+static void writeJsonString(FILE *file, const char *text)
+{
+  std::fputc('"', file);
+  for (const char *c = text; *c; ++c)
+  {
+    if (*c == '"' || *c == '\\')
+    {
+      std::fputc('\\', file);
+      std::fputc(*c, file);
+    }
+    else if (static_cast<unsigned char>(*c) < 0x20)
+    {
+      std::fprintf(file, "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(*c)));
+    }
+    else
+    {
+      std::fputc(*c, file);
+    }
+  }
+  std::fputc('"', file);
+}
+
+bool Trace::writeChromeJson(const std::string &path)
+{
+  FILE *file = std::fopen(path.c_str(), "w");
+  if (!file)
+  {
+    return false;
+  }
+  uint32_t generation = trace_generation.load(std::memory_order_acquire);
+  std::vector<std::shared_ptr<TraceThreadBuffer>> buffers;
+  std::vector<std::string> names;
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    buffers = registry;
+    for (const auto &buffer : buffers)
+    {
+      names.push_back(buffer->thread_name);
+    }
+  }
+
+  std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  std::fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"FIBO Card Commandos\"}}");
+  uint64_t dropped = 0;
+  for (size_t idx = 0; idx < buffers.size(); ++idx)
+  {
+    const TraceThreadBuffer &buffer = *buffers[idx];
+    if (buffer.generation.load(std::memory_order_acquire) != generation)
+    {
+      continue; // เธรดนี้ยังไม่ได้บันทึกอะไรในรอบนี้
+    }
+    std::fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", buffer.tid);
+    writeJsonString(file, names[idx].c_str());
+    std::fprintf(file, "}}");
+    size_t count = buffer.count.load(std::memory_order_acquire);
+    for (size_t event_idx = 0; event_idx < count; ++event_idx)
+    {
+      const TraceEvent &event = buffer.chunks[event_idx / TRACE_CHUNK_EVENTS][event_idx % TRACE_CHUNK_EVENTS];
+      std::fprintf(file, ",\n{\"name\":");
+      writeJsonString(file, event.name);
+      std::fprintf(file, ",\"cat\":");
+      writeJsonString(file, event.category);
+      std::fprintf(file, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}", event.start_ns / 1000.0,
+                   event.duration_ns / 1000.0, buffer.tid);
+    }
+    dropped += buffer.dropped.load(std::memory_order_relaxed);
+  }
+  std::fprintf(file, "\n],\"otherData\":{\"dropped_events\":%llu}}\n", static_cast<unsigned long long>(dropped));
+  bool ok = !std::ferror(file);
+  return std::fclose(file) == 0 && ok;
+}
+
+ScopedTrace::ScopedTrace(const std::string &output_path) : path(output_path)
+{
+  if (!path.empty())
+  {
+    Trace::start();
+  }
+}
+
+ScopedTrace::~ScopedTrace()
+{
+  if (path.empty())
+  {
+    return;
+  }
+  Trace::stop();
+  if (!Trace::writeChromeJson(path))
+  {
+    std::fprintf(stderr, "เขียนไฟล์ trace '%s' ไม่ได้\n", path.c_str());
+  }
+  else if (Trace::getDroppedCount() > 0)
+  {
+    std::fprintf(stderr, "trace: ทิ้ง %llu เหตุการณ์ (บัฟเฟอร์เต็ม)\n",
+                 static_cast<unsigned long long>(Trace::getDroppedCount()));
+  }
+}
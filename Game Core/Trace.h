@@ -0,0 +1,120 @@
+// Trace.h - ไฟล์ Header สำหรับบันทึกช่วงเวลาการทำงาน (trace span) แล้วเขียนเป็น Chrome trace-event JSON
+// เปิดไฟล์ที่ได้ใน https://ui.perfetto.dev หรือ chrome://tracing เพื่อดูว่าแต่ละเฟส/การแสดงผลใช้เวลาเท่าไร
+// แต่ละเธรดเขียนเหตุการณ์ลงบัฟเฟอร์ของตัวเองโดยไม่มี lock (เผยแพร่จำนวนเหตุการณ์ผ่าน atomic)
+// เธรดที่เขียนไฟล์จึงอ่านเหตุการณ์ที่จบแล้วของทุกเธรดได้แม้เธรดอื่นยังบันทึกอยู่
+//
+// ค่าเริ่มต้นคือปิด: TRACE_SPAN อ่านค่า bool 1 ครั้งแล้วไม่ทำอะไรอีก
+// เกมจำลองของบอท (ScopedSimulation ใน Simulation.h) ไม่ถูกบันทึก แม้จะเปิดการบันทึกอยู่
+// compile ด้วย -DFIBO_NO_TRACE เพื่อตัด TRACE_SPAN ออกทั้งหมด
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include "Simulation.h"
+
+class Trace
+{
+private:
+  static std::atomic<bool> enabled;
+
+public:
+  static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+  static bool isActive() { return isEnabled() && !isSimulating(); } // เธรดนี้ควรบันทึกช่วงที่เริ่มตอนนี้หรือไม่
+
+  // เริ่มบันทึกใหม่ (ทิ้งเหตุการณ์เดิมทั้งหมด) แต่ละเธรดเก็บได้ไม่เกิน events_per_thread เหตุการณ์
+  // เหตุการณ์ที่เกินถูกนับไว้ใน getDroppedCount() - ห้ามเรียกพร้อมกับ writeChromeJson()
+  static void start(size_t events_per_thread = 1 << 20);
+  static void stop();
+
+  // เขียนเหตุการณ์ที่จบแล้วของทุกเธรด คืนค่า false ถ้าเปิดไฟล์ไม่ได้
+  static bool writeChromeJson(const std::string &path);
+
+  static void setThreadName(const std::string &name); // ชื่อเธรดที่แสดงในไฟล์ (ค่าเริ่มต้น "thread <n>")
+  static uint64_t getDroppedCount();
+
+  static int64_t now(); // ns ตั้งแต่ start()
+  static void record(const char *category, const char *name, int64_t start_ns, int64_t end_ns);
+};
+
+// บันทึกช่วงเวลาตั้งแต่สร้างจนออกจาก scope (category และ name ต้องเป็นข้อความคงที่ที่อยู่ตลอดโปรแกรม)
+class TraceSpan
+{
+private:
+  const char *category;
+  const char *name;
+  int64_t start_ns; // -1 = ไม่ได้บันทึก (ปิดอยู่ตอนสร้าง)
+
+public:
+  TraceSpan(const char *category, const char *name)
+      : category(category), name(name), start_ns(Trace::isActive() ? Trace::now() : -1)
+  {
+  }
+
+  ~TraceSpan()
+  {
+    if (start_ns >= 0)
+    {
+      Trace::record(category, name, start_ns, Trace::now());
+    }
+  }
+
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+};
+
+// ช่วงเวลาที่เริ่มและจบคนละจุดของโปรแกรม (เช่นเฟสของ Match ที่หยุดรอการตัดสินใจของผู้เล่นระหว่างกลาง)
+// ช่วงที่ยังไม่จบเมื่อออบเจ็กต์ถูกทำลายจะไม่ถูกบันทึก
+class TraceInterval
+{
+private:
+  const char *category = nullptr;
+  const char *name = nullptr;
+  int64_t start_ns = -1; // -1 = ไม่มีช่วงที่เปิดอยู่
+
+public:
+  // จบช่วงเดิมที่ยังเปิดอยู่ (ถ้ามี) แล้วเริ่มช่วงใหม่ (ข้อความต้องอยู่ตลอดโปรแกรมเหมือน TraceSpan)
+  void begin(const char *new_category, const char *new_name)
+  {
+    end();
+    if (Trace::isActive())
+    {
+      category = new_category;
+      name = new_name;
+      start_ns = Trace::now();
+    }
+  }
+
+  void end()
+  {
+    if (start_ns >= 0)
+    {
+      Trace::record(category, name, start_ns, Trace::now());
+      start_ns = -1;
+    }
+  }
+};
+
+// เปิดการบันทึกภายใน scope แล้วเขียนไฟล์เมื่อออกจาก scope (path ว่าง = ไม่ทำอะไร)
+class ScopedTrace
+{
+private:
+  std::string path;
+
+public:
+  explicit ScopedTrace(const std::string &output_path);
+  ~ScopedTrace();
+  ScopedTrace(const ScopedTrace &) = delete;
+  ScopedTrace &operator=(const ScopedTrace &) = delete;
+};
+
+#ifdef FIBO_NO_TRACE
+#define TRACE_SPAN(category, name) ((void)0)
+#else
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SPAN(category, name) TraceSpan TRACE_CONCAT(trace_span_, __LINE__)(category, name)
+#endif
+
+#endif // TRACE_H
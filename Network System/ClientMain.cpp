@@ -0,0 +1,1310 @@
+// ClientMain.cpp - โปรแกรมไคลเอนต์ fibo_client
+// โหมดปกติ: ผู้เล่น 1 คนพิมพ์คำสั่งเล่นกับคู่แข่งที่เซิร์ฟเวอร์จับคู่ให้
+// โหมดบอท (--bot): เปิดหลายการเชื่อมต่อบน event loop เดียว แต่ละการเชื่อมต่อเล่นด้วยกลยุทธ์ง่ายๆ
+// ใช้ทดสอบเซิร์ฟเวอร์ด้วยแมตช์จำนวนมากพร้อมกันผ่าน loopback
+// โหมดผู้ชม (--spectate): รับ Keyframe แล้วอัปเดตสนามด้วย Delta หลังทุกการกระทำ
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <optional>
+#include <unordered_set>
+#include <chrono>
+#include <csignal>
+#include <cctype>
+#include <cstdint>
+#include <climits>
+#include "Protocol.h"
+#include "Socket.h"
+#include "Lockstep.h"
+#include "../Game Core/CardDatabase.h"
+#include "../Game Core/AllocationProfile.h"
+#include "../UI System/UIHelper.h"
+#include "../UI System/InputSource.h"
+#include "../UI System/OutputSink.h"
+
+using namespace std;
+
+// ดัชนีสถานะของ Booster ที่อยู่หลัง Attacker แต่ละตำแหน่ง (VC, RC ซ้ายหน้า, RC ขวาหน้า)
+static const int BOOSTER_BEHIND[3] = {4, 3, 5};
+
+// สถานะของการเชื่อมต่อ 1 การเชื่อมต่อกับเซิร์ฟเวอร์
+struct ClientSession
+{
+  int fd = -1;
+  string inbox;
+  string outbox;
+  string name;
+  string opponent;
+  bool want_write = false;
+
+  bool in_match = false;
+  uint32_t match_id = 0;
+  int seat = -1;
+  StateView state;
+  bool awaiting_reply = false; // ส่งการกระทำไปแล้วและรอ State ตอบกลับ
+  bool last_rejected = false;  // ข้อความก่อนหน้าเป็น Rejected
+  int rejected_in_row = 0;     // จำนวนครั้งที่ถูกปฏิเสธติดกัน
+  int games_played = 0;
+  int wins = 0;
+  bool finished = false; // เล่นครบจำนวนเกมแล้ว
+
+  // ข้อมูลที่บอทใช้ตัดสินใจ
+  int ride_turn = -1; // เทิร์นล่าสุดที่ Ride แล้ว (หรือตัดสินใจไม่ Ride)
+  int guards_this_attack = 0;
+  int shield_this_attack = 0;
+};
+
+// สถิติรวมของโหมดบอท (แมตช์ที่บอท 2 ตัวในโปรเซสนี้เล่นกันเองถูกนับครั้งเดียว)
+struct BotStats
+{
+  unordered_set<uint32_t> finished_matches;
+  uint64_t decided = 0; // เกมที่มีผู้ชนะ
+  uint64_t actions = 0;
+  uint64_t rejected = 0;
+  uint64_t turns = 0;
+};
+
+static vector<CardInfo> catalog; // แคตตาล็อกการ์ดจาก Welcome (เหมือนกันทุกการเชื่อมต่อ)
+
+static const CardInfo *cardAt(uint8_t index)
+{
+  return index < catalog.size() ? &catalog[index] : nullptr;
+}
+
+// การ์ดของยูนิตที่ดัชนีสถานะ (0 = VC, 1-5 = RC)
+static const CardInfo *unitAt(const SeatView &seat, int unit_status_idx)
+{
+  if (unit_status_idx == 0)
+  {
+    return cardAt(seat.vanguard);
+  }
+  if (unit_status_idx >= 1 && unit_status_idx <= NUM_REAR_GUARD_CIRCLES)
+  {
+    return cardAt(seat.rear_guards[unit_status_idx - 1]);
+  }
+  return nullptr;
+}
+
+static const char *matchEndText(MatchEnd reason)
+{
+  switch (reason)
+  {
+  case MatchEnd::DrawDeckOut:
+    return "การ์ดในเด็คหมดตอนจั่ว";
+  case MatchEnd::DamageDeckOut:
+    return "การ์ดในเด็คหมดตอน Damage Check";
+  case MatchEnd::DamageLimit:
+  case MatchEnd::EndPhaseDamage:
+    return "ดาเมจครบ";
+  case MatchEnd::TurnLimit:
+    return "ครบจำนวนเทิร์นสูงสุด";
+  case MatchEnd::Conceded:
+    return "ยอมแพ้หรือหลุดการเชื่อมต่อ";
+  default:
+    return "-";
+  }
+}
+
+static void sendHello(ClientSession &session)
+{
+  MessageWriter(session.outbox, MessageType::Hello).u8(PROTOCOL_VERSION).str(session.name);
+}
+
+static void sendAction(ClientSession &session, const GameAction &action)
+{
+  writeAction(session.outbox, action);
+  session.awaiting_reply = true;
+}
+
+// --- กลยุทธ์ของบอท ---
+
+static GameAction chooseMainPhaseAction(ClientSession &session)
+{
+  const SeatView &me = session.state.seats[session.seat];
+  const CardInfo *vanguard = cardAt(me.vanguard);
+  int vanguard_grade = vanguard ? vanguard->grade : 0;
+
+  // Ride การ์ดเกรดถัดไปเทิร์นละครั้ง
+  if (session.ride_turn != session.state.turn)
+  {
+    session.ride_turn = session.state.turn;
+    for (size_t i = 0; i < me.hand.size(); ++i)
+    {
+      const CardInfo *card = cardAt(me.hand[i]);
+      if (card && card->grade == vanguard_grade + 1)
+      {
+        return GameAction::ride(static_cast<int>(i));
+      }
+    }
+  }
+
+  // Call การ์ดที่เกรดไม่เกิน Vanguard ลงช่อง RC ที่ว่าง
+  for (int slot = 0; slot < NUM_REAR_GUARD_CIRCLES; ++slot)
+  {
+    if (me.rear_guards[slot] != NO_CARD)
+    {
+      continue;
+    }
+    for (size_t i = 0; i < me.hand.size(); ++i)
+    {
+      const CardInfo *card = cardAt(me.hand[i]);
+      if (card && card->grade <= vanguard_grade)
+      {
+        return GameAction::call(static_cast<int>(i), slot);
+      }
+    }
+  }
+  return GameAction::endMain();
+}
+
+static GameAction chooseBattlePhaseAction(const ClientSession &session)
+{
+  const SeatView &me = session.state.seats[session.seat];
+  for (int attacker = 0; attacker < 3; ++attacker)
+  {
+    if (!unitAt(me, attacker) || !me.isStanding(attacker))
+    {
+      continue;
+    }
+    int booster = BOOSTER_BEHIND[attacker];
+    const CardInfo *booster_card = unitAt(me, booster);
+    if (!booster_card || !me.isStanding(booster) || booster_card->grade > 1)
+    {
+      booster = -1;
+    }
+    return GameAction::attack(attacker, 0, booster);
+  }
+  return GameAction::endBattle();
+}
+
+static GameAction chooseGuardAction(ClientSession &session)
+{
+  const SeatView &me = session.state.seats[session.seat];
+  const CardInfo *target = unitAt(me, session.state.attack.target_idx);
+  int defense = (target ? target->power : 0) + session.shield_this_attack;
+  if (session.guards_this_attack >= 2 || session.state.attack.power < defense)
+  {
+    return GameAction::endGuard();
+  }
+
+  // Guard ด้วยการ์ดที่มี Shield มากที่สุดบนมือ
+  int best = -1;
+  int best_shield = 0;
+  for (size_t i = 0; i < me.hand.size(); ++i)
+  {
+    const CardInfo *card = cardAt(me.hand[i]);
+    if (card && card->shield > best_shield)
+    {
+      best = static_cast<int>(i);
+      best_shield = card->shield;
+    }
+  }
+  if (best < 0)
+  {
+    return GameAction::endGuard();
+  }
+  session.guards_this_attack++;
+  session.shield_this_attack += best_shield;
+  return GameAction::guard(best);
+}
+
+static GameAction chooseBotAction(ClientSession &session)
+{
+  ALLOC_SCOPE(AI);
+  DecisionType decision = session.state.decision;
+  if (session.rejected_in_row > 2)
+  {
+    // ถูกปฏิเสธซ้ำๆ - จบขั้นตอนปัจจุบันแทนการลองต่อ
+    return decision == DecisionType::MainPhase     ? GameAction::endMain()
+           : decision == DecisionType::BattlePhase ? GameAction::endBattle()
+                                                   : GameAction::endGuard();
+  }
+  switch (decision)
+  {
+  case DecisionType::MainPhase:
+    return chooseMainPhaseAction(session);
+  case DecisionType::BattlePhase:
+    return chooseBattlePhaseAction(session);
+  default:
+    return chooseGuardAction(session);
+  }
+}
+
+// --- การแสดงผลในโหมดผู้เล่น ---
+
+static void printSeat(const SeatView &seat, const string &title, bool show_hand)
+{
+  Out() << Colors::BRIGHT_CYAN << "--- " << title << " ---" << Colors::RESET << "\n";
+  for (int unit = 0; unit < NUM_FIELD_UNITS; ++unit)
+  {
+    const CardInfo *card = unitAt(seat, unit);
+    Out() << "  [" << unit << "] " << (unit == 0 ? "VC " : "RC" + to_string(unit - 1)) << ": ";
+    if (card)
+    {
+      Out() << UIHelper::FormatCard(card->name, card->grade, seat.isStanding(unit)) << " "
+            << UIHelper::FormatPowerShield(card->power, card->shield);
+    }
+    else
+    {
+      Out() << Colors::BRIGHT_BLACK << "(ว่าง)" << Colors::RESET;
+    }
+    Out() << "\n";
+  }
+  Out() << "  ดาเมจ: " << static_cast<int>(seat.damage) << "  Soul: " << static_cast<int>(seat.soul)
+        << "  Drop: " << static_cast<int>(seat.drop) << "  เด็ค: " << static_cast<int>(seat.deck)
+        << "  มือ: " << static_cast<int>(seat.hand_count) << "\n";
+  if (show_hand)
+  {
+    for (size_t i = 0; i < seat.hand.size(); ++i)
+    {
+      const CardInfo *card = cardAt(seat.hand[i]);
+      if (card)
+      {
+        Out() << Colors::YELLOW << "  (" << i << ") " << Colors::RESET
+              << UIHelper::FormatCardShort(card->code_name, card->name, card->grade) << " "
+              << UIHelper::FormatPowerShield(card->power, card->shield) << "\n";
+      }
+    }
+  }
+}
+
+static void printState(const ClientSession &session)
+{
+  const StateView &state = session.state;
+  UIHelper::PrintHorizontalLine('=', 70);
+  Out() << Colors::BOLD << "เทิร์น " << state.turn << " - "
+        << (state.current_seat == session.seat ? session.name : session.opponent) << Colors::RESET << "\n";
+  printSeat(state.seats[1 - session.seat], "สนามของ " + session.opponent, false);
+  printSeat(state.seats[session.seat], "สนามของคุณ (" + session.name + ")", true);
+  if (state.decision == DecisionType::Guard)
+  {
+    Out() << Colors::BRIGHT_RED << "ถูกโจมตี! ยูนิต [" << state.attack.target_idx << "] พลังโจมตี "
+          << state.attack.power << " คริติคอล " << state.attack.critical << Colors::RESET << "\n";
+  }
+}
+
+static void printCommands(DecisionType decision)
+{
+  switch (decision)
+  {
+  case DecisionType::MainPhase:
+    UIHelper::PrintInfo("MAIN PHASE: r <มือ> = Ride, c <มือ> <ช่อง RC 0-4> = Call, b = ไป Battle Phase, q = ออก");
+    break;
+  case DecisionType::BattlePhase:
+    UIHelper::PrintInfo("BATTLE PHASE: a <ยูนิต> <เป้าหมาย> [booster] = โจมตี, e = จบเทิร์น, q = ออก");
+    break;
+  case DecisionType::Guard:
+    UIHelper::PrintInfo("GUARD: g <มือ> = วางการ์ด Guard, e = ไม่ Guard เพิ่ม, q = ออก");
+    break;
+  default:
+    break;
+  }
+}
+
+// แปลงคำสั่งที่ผู้เล่นพิมพ์เป็นการกระทำ (nullopt = คำสั่งไม่ถูกต้อง)
+static optional<GameAction> parseCommand(const string &line, DecisionType decision)
+{
+  istringstream input(line);
+  string command;
+  input >> command;
+  int a = -1, b = -1, c = -1;
+  if (decision == DecisionType::MainPhase)
+  {
+    if (command == "r" && input >> a)
+      return GameAction::ride(a);
+    if (command == "c" && input >> a >> b)
+      return GameAction::call(a, b);
+    if (command == "b")
+      return GameAction::endMain();
+  }
+  else if (decision == DecisionType::BattlePhase)
+  {
+    if (command == "a" && input >> a >> b)
+    {
+      if (!(input >> c))
+        c = -1;
+      return GameAction::attack(a, b, c);
+    }
+    if (command == "e")
+      return GameAction::endBattle();
+  }
+  else if (decision == DecisionType::Guard)
+  {
+    if (command == "g" && input >> a)
+      return GameAction::guard(a);
+    if (command == "e")
+      return GameAction::endGuard();
+  }
+  return nullopt;
+}
+
+static void printEvent(const ClientSession &session, MessageReader &reader)
+{
+  auto seatName = [&session](uint8_t seat)
+  { return seat == session.seat ? session.name : session.opponent; };
+
+  switch (static_cast<EventType>(reader.u8()))
+  {
+  case EventType::TurnStart:
+  {
+    uint8_t seat = reader.u8();
+    uint16_t turn = reader.u16();
+    UIHelper::PrintPhaseHeader("STAND & DRAW", seatName(seat), turn);
+    break;
+  }
+  case EventType::Attack:
+  {
+    uint8_t seat = reader.u8();
+    int attacker = reader.i8();
+    int target = reader.i8();
+    int booster = reader.i8();
+    uint32_t power = reader.u32();
+    int critical = reader.u8();
+    Out() << Colors::BRIGHT_RED << Icons::SWORD << " " << seatName(seat) << " โจมตีด้วยยูนิต [" << attacker
+          << "] ไปที่ [" << target << "]" << (booster >= 0 ? " (Boost)" : "") << " พลัง " << power
+          << " คริติคอล " << critical << Colors::RESET << "\n";
+    break;
+  }
+  case EventType::BattleResult:
+  {
+    uint32_t defense = reader.u32();
+    bool hit = reader.u8() != 0;
+    Out() << "  พลังป้องกันรวม " << defense << " -> "
+          << (hit ? UIHelper::ColorText("โจมตีเข้า!", Colors::BRIGHT_RED) : UIHelper::ColorText("ป้องกันได้", Colors::BRIGHT_GREEN))
+          << "\n";
+    break;
+  }
+  case EventType::DamageCard:
+  {
+    uint8_t seat = reader.u8();
+    const CardInfo *card = cardAt(reader.u8());
+    Out() << "  " << seatName(seat) << " ได้รับดาเมจ: " << (card ? card->name : "?") << "\n";
+    break;
+  }
+  case EventType::TurnEnd:
+    Out() << Colors::BRIGHT_BLACK << "  จบเทิร์นของ " << seatName(reader.u8()) << Colors::RESET << "\n";
+    break;
+  }
+}
+
+// --- การประมวลผลข้อความจากเซิร์ฟเวอร์ (ใช้ทั้งสองโหมด) ---
+
+// คืนค่า false เมื่อเซิร์ฟเวอร์ส่งข้อความผิดพลาดหรือข้อมูลเสีย
+static bool processMessages(ClientSession &session, bool interactive, BotStats &stats, int games_per_session)
+{
+  size_t offset = 0;
+  Frame frame;
+  int result;
+  bool ok = true;
+  while ((result = extractFrame(session.inbox, offset, frame)) != 0)
+  {
+    if (result < 0)
+    {
+      ok = false;
+      break;
+    }
+    MessageReader reader(frame.payload, frame.payload_size);
+    switch (frame.type)
+    {
+    case MessageType::Welcome:
+      if (catalog.empty() && !readWelcome(reader, catalog))
+      {
+        ok = false;
+      }
+      break;
+
+    case MessageType::MatchStart:
+    {
+      session.match_id = reader.u32();
+      session.seat = reader.u8();
+      int first_seat = reader.u8();
+      session.opponent = reader.str();
+      session.in_match = true;
+      session.awaiting_reply = false;
+      session.rejected_in_row = 0;
+      session.ride_turn = -1;
+      if (interactive)
+      {
+        UIHelper::PrintSuccess("พบคู่แข่ง: " + session.opponent +
+                               (first_seat == session.seat ? " (คุณเริ่มก่อน)" : " (คู่แข่งเริ่มก่อน)"));
+      }
+      break;
+    }
+
+    case MessageType::State:
+      if (!readStateView(reader, session.state))
+      {
+        ok = false;
+        break;
+      }
+      session.awaiting_reply = false;
+      session.rejected_in_row = session.last_rejected ? session.rejected_in_row : 0;
+      session.last_rejected = false;
+      break;
+
+    case MessageType::Rejected:
+      session.last_rejected = true;
+      session.rejected_in_row++;
+      stats.rejected++;
+      if (interactive)
+      {
+        UIHelper::PrintError("คำสั่งไม่ถูกต้องตามกติกา ลองใหม่อีกครั้ง");
+      }
+      break;
+
+    case MessageType::Event:
+      if (interactive)
+      {
+        printEvent(session, reader);
+      }
+      else if (reader.u8() == static_cast<uint8_t>(EventType::Attack))
+      {
+        session.guards_this_attack = 0;
+        session.shield_this_attack = 0;
+      }
+      break;
+
+    case MessageType::GameOver:
+    {
+      MatchEnd reason = static_cast<MatchEnd>(reader.u8());
+      uint8_t winner = reader.u8();
+      uint16_t turns = reader.u16();
+      session.in_match = false;
+      session.games_played++;
+      session.wins += (winner == session.seat) ? 1 : 0;
+      if (stats.finished_matches.insert(session.match_id).second)
+      {
+        stats.turns += turns;
+        stats.decided += (winner != NO_SEAT) ? 1 : 0;
+      }
+      if (interactive)
+      {
+        UIHelper::PrintHorizontalLine('=', 70);
+        if (winner == NO_SEAT)
+          UIHelper::PrintInfo(string("เสมอ - ") + matchEndText(reason));
+        else if (winner == session.seat)
+          UIHelper::PrintSuccess(string("คุณชนะ! (") + matchEndText(reason) + ")");
+        else
+          UIHelper::PrintError(string("คุณแพ้ (") + matchEndText(reason) + ")");
+      }
+      if (session.games_played < games_per_session)
+      {
+        sendHello(session); // เข้าคิวหาแมตช์ถัดไป
+      }
+      else
+      {
+        session.finished = true;
+      }
+      break;
+    }
+
+    case MessageType::Error:
+      if (interactive)
+      {
+        UIHelper::PrintError("เซิร์ฟเวอร์: " + reader.str());
+      }
+      ok = false;
+      break;
+
+    default:
+      break;
+    }
+    if (!ok)
+    {
+      break;
+    }
+  }
+  session.inbox.erase(0, offset);
+  return ok;
+}
+
+static bool myDecision(const ClientSession &session)
+{
+  return session.in_match && !session.awaiting_reply && session.state.decision != DecisionType::None &&
+         session.state.acting_seat == session.seat;
+}
+
+// --- โหมดบอท ---
+
+static int runBots(const Endpoint &endpoint, int connection_count, int games_per_session)
+{
+  EventLoop loop;
+  vector<ClientSession> sessions(static_cast<size_t>(connection_count));
+  vector<int> session_of_fd;
+  BotStats stats;
+
+  auto started = chrono::steady_clock::now();
+  for (size_t i = 0; i < sessions.size(); ++i)
+  {
+    ClientSession &session = sessions[i];
+    session.fd = connectTo(endpoint);
+    if (session.fd < 0)
+    {
+      cerr << "เชื่อมต่อเซิร์ฟเวอร์ไม่ได้ (การเชื่อมต่อที่ " << i + 1 << ")" << endl;
+      return 1;
+    }
+    if (session_of_fd.size() <= static_cast<size_t>(session.fd))
+    {
+      session_of_fd.resize(static_cast<size_t>(session.fd) + 1, -1);
+    }
+    session_of_fd[static_cast<size_t>(session.fd)] = static_cast<int>(i);
+    session.name = "Bot" + to_string(i + 1);
+    sendHello(session);
+    writePending(session.fd, session.outbox);
+    loop.add(session.fd, !session.outbox.empty());
+  }
+
+  size_t active = sessions.size();
+  vector<IoEvent> events;
+  while (active > 0)
+  {
+    loop.wait(events, 1000);
+    for (const IoEvent &event : events)
+    {
+      int index = session_of_fd[static_cast<size_t>(event.fd)];
+      if (index < 0)
+      {
+        continue;
+      }
+      ClientSession &session = sessions[static_cast<size_t>(index)];
+
+      bool open = true;
+      if (event.readable || event.closed)
+      {
+        open = readAvailable(session.fd, session.inbox) && processMessages(session, false, stats, games_per_session);
+      }
+      if (open && myDecision(session))
+      {
+        sendAction(session, chooseBotAction(session));
+        stats.actions++;
+      }
+      if (open)
+      {
+        open = writePending(session.fd, session.outbox);
+      }
+
+      if (!open || (session.finished && session.outbox.empty()))
+      {
+        if (!session.finished)
+        {
+          cerr << session.name << ": การเชื่อมต่อถูกปิดก่อนเล่นครบ" << endl;
+        }
+        loop.remove(session.fd);
+        closeSocket(session.fd);
+        session_of_fd[static_cast<size_t>(session.fd)] = -1;
+        active--;
+        continue;
+      }
+      bool need_write = !session.outbox.empty();
+      if (need_write != session.want_write)
+      {
+        session.want_write = need_write;
+        loop.modify(session.fd, need_write);
+      }
+    }
+  }
+
+  double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+  size_t games = stats.finished_matches.size();
+  cout << "เล่นจบ " << games << " เกม ด้วย " << connection_count << " การเชื่อมต่อ ใน " << seconds << " วินาที\n"
+       << "  " << (seconds > 0 ? games / seconds : 0) << " เกม/วินาที, "
+       << (seconds > 0 ? stats.actions / seconds : 0) << " การกระทำ/วินาที\n"
+       << "  เทิร์นเฉลี่ยต่อเกม: " << (games > 0 ? static_cast<double>(stats.turns) / games : 0)
+       << ", เกมที่มีผู้ชนะ: " << stats.decided
+       << ", การกระทำที่ถูกปฏิเสธ: " << stats.rejected << endl;
+  return 0;
+}
+
+// --- โหมดผู้ชม ---
+
+// สถานะของการเชื่อมต่อผู้ชม 1 การเชื่อมต่อ
+struct SpectatorSession
+{
+  int fd = -1;
+  string inbox;
+  uint32_t match_id = 0;
+  string names[2];
+  StateView state; // สถานะจาก Keyframe ที่อัปเดตด้วย Delta ทุกข้อความ
+  bool finished = false;
+};
+
+static void printSpectatorView(const SpectatorSession &session)
+{
+  const StateView &state = session.state;
+  UIHelper::PrintHorizontalLine('=', 70);
+  Out() << Colors::BOLD << "แมตช์ #" << session.match_id << " เทิร์น " << state.turn << " - "
+        << session.names[state.current_seat & 1] << Colors::RESET << "\n";
+  printSeat(state.seats[0], session.names[0], false);
+  printSeat(state.seats[1], session.names[1], false);
+}
+
+// ประมวลผลข้อความของผู้ชม คืนค่า false เมื่อข้อมูลเสียหรือเซิร์ฟเวอร์แจ้งข้อผิดพลาด
+static bool processSpectatorMessages(SpectatorSession &session, bool render, uint64_t &deltas)
+{
+  size_t offset = 0;
+  Frame frame;
+  int result;
+  bool ok = true;
+  while (ok && (result = extractFrame(session.inbox, offset, frame)) != 0)
+  {
+    if (result < 0)
+    {
+      ok = false;
+      break;
+    }
+    MessageReader reader(frame.payload, frame.payload_size);
+    switch (frame.type)
+    {
+    case MessageType::Welcome:
+      ok = !catalog.empty() || readWelcome(reader, catalog);
+      break;
+    case MessageType::Keyframe:
+      ok = readKeyframe(reader, session.match_id, session.names, session.state);
+      if (ok && render)
+      {
+        printSpectatorView(session);
+      }
+      break;
+    case MessageType::Delta:
+      ok = applyDelta(reader, session.state);
+      deltas++;
+      if (ok && render)
+      {
+        printSpectatorView(session);
+      }
+      break;
+    case MessageType::GameOver:
+    {
+      MatchEnd reason = static_cast<MatchEnd>(reader.u8());
+      uint8_t winner = reader.u8();
+      if (render)
+      {
+        UIHelper::PrintInfo(string("จบแมตช์: ") + (winner == NO_SEAT ? "เสมอ" : session.names[winner & 1] + " ชนะ") +
+                            " (" + matchEndText(reason) + ")");
+      }
+      session.finished = true;
+      break;
+    }
+    case MessageType::Error:
+      if (render)
+      {
+        UIHelper::PrintError("เซิร์ฟเวอร์: " + reader.str());
+      }
+      ok = false;
+      break;
+    default:
+      break;
+    }
+  }
+  session.inbox.erase(0, offset);
+  return ok;
+}
+
+// ชมแมตช์ - ถ้าเปิดหลายการเชื่อมต่อจะไม่แสดงสนามแต่สรุปจำนวนข้อความที่ได้รับแทน (ใช้ทดสอบโหลด)
+static int runSpectators(const Endpoint &endpoint, uint32_t match_id, int connection_count)
+{
+  bool render = connection_count == 1;
+  EventLoop loop;
+  vector<SpectatorSession> sessions(static_cast<size_t>(connection_count));
+  vector<int> session_of_fd;
+
+  for (size_t i = 0; i < sessions.size(); ++i)
+  {
+    SpectatorSession &session = sessions[i];
+    session.fd = connectTo(endpoint);
+    if (session.fd < 0)
+    {
+      cerr << "เชื่อมต่อเซิร์ฟเวอร์ไม่ได้ (การเชื่อมต่อที่ " << i + 1 << ")" << endl;
+      return 1;
+    }
+    if (session_of_fd.size() <= static_cast<size_t>(session.fd))
+    {
+      session_of_fd.resize(static_cast<size_t>(session.fd) + 1, -1);
+    }
+    session_of_fd[static_cast<size_t>(session.fd)] = static_cast<int>(i);
+    string request;
+    MessageWriter(request, MessageType::Spectate).u32(match_id);
+    writePending(session.fd, request);
+    loop.add(session.fd);
+  }
+
+  auto started = chrono::steady_clock::now();
+  size_t active = sessions.size();
+  size_t completed = 0;
+  uint64_t deltas = 0;
+  vector<IoEvent> events;
+  while (active > 0)
+  {
+    loop.wait(events, 1000);
+    for (const IoEvent &event : events)
+    {
+      int index = session_of_fd[static_cast<size_t>(event.fd)];
+      if (index < 0)
+      {
+        continue;
+      }
+      SpectatorSession &session = sessions[static_cast<size_t>(index)];
+      bool open = readAvailable(session.fd, session.inbox);
+      bool ok = processSpectatorMessages(session, render, deltas);
+      if (open && ok && !session.finished)
+      {
+        continue;
+      }
+      completed += session.finished ? 1 : 0;
+      loop.remove(session.fd);
+      closeSocket(session.fd);
+      session_of_fd[static_cast<size_t>(session.fd)] = -1;
+      active--;
+    }
+  }
+
+  if (!render)
+  {
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+    cout << "ผู้ชม " << completed << "/" << connection_count << " คนดูจนจบแมตช์ ใน " << seconds << " วินาที, "
+         << "ได้รับ Delta รวม " << deltas << " ข้อความ" << endl;
+  }
+  return completed == sessions.size() ? 0 : 1;
+}
+
+// --- โหมดผู้เล่น ---
+
+static int runInteractive(const Endpoint &endpoint, const string &name)
+{
+  ClientSession session;
+  session.name = name;
+  session.fd = connectTo(endpoint);
+  if (session.fd < 0)
+  {
+    UIHelper::PrintError("เชื่อมต่อเซิร์ฟเวอร์ไม่ได้");
+    return 1;
+  }
+  EventLoop loop;
+  loop.add(session.fd);
+  BotStats stats;
+  sendHello(session);
+  UIHelper::PrintInfo("กำลังรอคู่แข่ง...");
+
+  vector<IoEvent> events;
+  while (true)
+  {
+    if (!writePending(session.fd, session.outbox))
+    {
+      break;
+    }
+    loop.wait(events, -1);
+    if (!readAvailable(session.fd, session.inbox))
+    {
+      processMessages(session, true, stats, 1);
+      UIHelper::PrintWarning("เซิร์ฟเวอร์ปิดการเชื่อมต่อ");
+      break;
+    }
+    if (!processMessages(session, true, stats, 1))
+    {
+      break;
+    }
+
+    if (session.finished)
+    {
+      Out() << "พิมพ์ n เพื่อหาแมตช์ใหม่ หรือ q เพื่อออก: ";
+      if (InputSource::NextLine() != "n")
+      {
+        break;
+      }
+      session.finished = false;
+      session.games_played = 0;
+      sendHello(session);
+      UIHelper::PrintInfo("กำลังรอคู่แข่ง...");
+      continue;
+    }
+
+    if (myDecision(session))
+    {
+      printState(session);
+      while (true)
+      {
+        printCommands(session.state.decision);
+        Out() << "> ";
+        string line = InputSource::NextLine();
+        if (line == "q")
+        {
+          closeSocket(session.fd);
+          return 0; // ปิดการเชื่อมต่อ = ยอมแพ้
+        }
+        optional<GameAction> action = parseCommand(line, session.state.decision);
+        if (action.has_value())
+        {
+          sendAction(session, action.value());
+          break;
+        }
+        UIHelper::PrintError("คำสั่งไม่ถูกต้อง");
+      }
+    }
+  }
+  closeSocket(session.fd);
+  return 0;
+}
+
+// --- โหมด lockstep (peer-to-peer) ---
+
+// รอจนได้ข้อความครบ 1 ข้อความจากอีกฝ่าย โดยส่งข้อมูลที่ค้างใน outbox ไประหว่างรอ
+// frame ชี้เข้าไปใน session.inbox ผู้เรียกต้องลบ frame_end ไบต์แรกออกหลังใช้ข้อความเสร็จ
+// คืนค่า false เมื่ออีกฝ่ายปิดการเชื่อมต่อหรือข้อมูลเสีย
+static bool waitForPeerFrame(ClientSession &session, EventLoop &loop, Frame &frame, size_t &frame_end)
+{
+  vector<IoEvent> events;
+  while (true)
+  {
+    frame_end = 0;
+    int result = extractFrame(session.inbox, frame_end, frame);
+    if (result != 0)
+    {
+      return result > 0;
+    }
+    if (!writePending(session.fd, session.outbox))
+    {
+      return false;
+    }
+    loop.modify(session.fd, !session.outbox.empty());
+    loop.wait(events, -1);
+    if (!readAvailable(session.fd, session.inbox))
+    {
+      frame_end = 0;
+      return extractFrame(session.inbox, frame_end, frame) > 0;
+    }
+  }
+}
+
+// ส่งข้อมูลที่เหลือใน outbox ให้หมดก่อนปิดการเชื่อมต่อ
+static void flushOutbox(ClientSession &session, EventLoop &loop)
+{
+  vector<IoEvent> events;
+  while (!session.outbox.empty() && writePending(session.fd, session.outbox))
+  {
+    loop.modify(session.fd, !session.outbox.empty());
+    loop.wait(events, 1000);
+  }
+}
+
+// เปิดรับการเชื่อมต่อจากอีกฝ่าย 1 ราย (คืนค่า -1 ถ้าเปิดรับไม่ได้)
+static int acceptPeer(const Endpoint &endpoint)
+{
+  int listen_fd = listenOn(endpoint, 1);
+  if (listen_fd < 0)
+  {
+    return -1;
+  }
+  EventLoop loop;
+  loop.add(listen_fd);
+  vector<IoEvent> events;
+  int fd = -1;
+  while (fd < 0)
+  {
+    loop.wait(events, -1);
+    fd = acceptClient(listen_fd);
+  }
+  closeSocket(listen_fd);
+  if (!endpoint.unix_path.empty())
+  {
+    remove(endpoint.unix_path.c_str());
+  }
+  return fd;
+}
+
+// ถามคำสั่งจากผู้เล่นจนได้การกระทำ (nullopt = ผู้เล่นออกจากเกม)
+static optional<GameAction> promptAction(const ClientSession &session)
+{
+  printState(session);
+  while (true)
+  {
+    printCommands(session.state.decision);
+    Out() << "> ";
+    string line = InputSource::NextLine();
+    if (line == "q")
+    {
+      return nullopt;
+    }
+    optional<GameAction> action = parseCommand(line, session.state.decision);
+    if (action.has_value())
+    {
+      return action;
+    }
+    UIHelper::PrintError("คำสั่งไม่ถูกต้อง");
+  }
+}
+
+// เล่นกับอีกเครื่องโดยตรง: ทั้งสองฝ่ายเดินเกมเอง ส่งกันเฉพาะการกระทำและ checksum หลังจบทุกเทิร์น
+// ฝ่ายที่เปิดรับการเชื่อมต่อนั่งที่นั่ง 0 และเป็นผู้กำหนด seed ของทุกแมตช์
+static int runLockstep(const Endpoint &endpoint, bool listen_for_peer, const string &name, bool bot,
+                       optional<uint64_t> seed, int games, const string &cards_path)
+{
+  vector<Card> cards = loadCardsFromJson(cards_path);
+  if (cards.empty())
+  {
+    return 1;
+  }
+  catalog = describeCatalog(cards);
+  CardIndex card_index = makeCardIndex(cards);
+
+  ClientSession session;
+  session.name = name;
+  session.seat = listen_for_peer ? 0 : 1;
+  if (listen_for_peer)
+  {
+    UIHelper::PrintInfo("รอการเชื่อมต่อจากอีกฝ่ายที่ " + describeEndpoint(endpoint) + "...");
+  }
+  session.fd = listen_for_peer ? acceptPeer(endpoint) : connectTo(endpoint);
+  if (session.fd < 0)
+  {
+    UIHelper::PrintError("เชื่อมต่อกับอีกฝ่ายไม่ได้");
+    return 1;
+  }
+  EventLoop loop;
+  loop.add(session.fd);
+
+  // ทั้งสองฝ่ายต้องใช้โปรโตคอลและข้อมูลการ์ดชุดเดียวกัน ไม่เช่นนั้นเกมจะแยกทางกันตั้งแต่สับสำรับ
+  uint64_t catalog_checksum = catalogChecksum(cards);
+  MessageWriter(session.outbox, MessageType::PeerHello).u8(PROTOCOL_VERSION).u64(catalog_checksum).str(name);
+  Frame frame;
+  size_t frame_end = 0;
+  if (!waitForPeerFrame(session, loop, frame, frame_end) || frame.type != MessageType::PeerHello)
+  {
+    UIHelper::PrintError("อีกฝ่ายไม่ได้อยู่ในโหมด lockstep");
+    closeSocket(session.fd);
+    return 1;
+  }
+  {
+    MessageReader reader(frame.payload, frame.payload_size);
+    uint8_t version = reader.u8();
+    uint64_t peer_catalog = reader.u64();
+    session.opponent = reader.str();
+    if (version != PROTOCOL_VERSION || peer_catalog != catalog_checksum)
+    {
+      UIHelper::PrintError("เวอร์ชันของโปรโตคอลหรือข้อมูลการ์ดไม่ตรงกับอีกฝ่าย");
+      closeSocket(session.fd);
+      return 1;
+    }
+  }
+  session.inbox.erase(0, frame_end);
+  string names[2];
+  names[session.seat] = name;
+  names[1 - session.seat] = session.opponent;
+
+  uint64_t base_seed = seed.has_value()
+                           ? seed.value()
+                           : static_cast<uint64_t>(chrono::system_clock::now().time_since_epoch().count());
+  auto started = chrono::steady_clock::now();
+  uint64_t verified = 0;
+  int played = 0;
+  int wins = 0;
+  bool desync = false;
+  bool peer_left = false;
+  for (int game = 0; game < games && !desync && !peer_left; ++game)
+  {
+    uint64_t match_seed = base_seed + static_cast<uint64_t>(game);
+    int first_seat = game % 2;
+    if (session.seat == 0)
+    {
+      MessageWriter(session.outbox, MessageType::PeerStart).u64(match_seed).u8(static_cast<uint8_t>(first_seat));
+    }
+    else
+    {
+      if (!waitForPeerFrame(session, loop, frame, frame_end) || frame.type != MessageType::PeerStart)
+      {
+        break;
+      }
+      MessageReader reader(frame.payload, frame.payload_size);
+      match_seed = reader.u64();
+      first_seat = reader.u8() & 1;
+      session.inbox.erase(0, frame_end);
+    }
+
+    LockstepMatch lockstep(cards, names, session.seat, match_seed, first_seat);
+    if (!lockstep.isReady())
+    {
+      UIHelper::PrintError("ไม่พบการ์ด starter ในข้อมูลการ์ด");
+      break;
+    }
+    if (!bot)
+    {
+      UIHelper::PrintSuccess("เริ่มแมตช์กับ " + session.opponent + " (seed " + to_string(match_seed) + ", " +
+                             (first_seat == session.seat ? "คุณเริ่มก่อน)" : "คู่แข่งเริ่มก่อน)"));
+    }
+    session.ride_turn = -1;
+    session.rejected_in_row = 0;
+    DecisionType last_decision = DecisionType::None;
+
+    while (!lockstep.getMatch().isOver() || !lockstep.isFullyVerified())
+    {
+      session.state = makeStateView(lockstep.getMatch(), session.seat, card_index);
+      if (session.state.decision == DecisionType::Guard && last_decision != DecisionType::Guard)
+      {
+        session.guards_this_attack = 0;
+        session.shield_this_attack = 0;
+      }
+      last_decision = session.state.decision;
+
+      if (!lockstep.getMatch().isOver() && lockstep.isLocalDecision())
+      {
+        optional<GameAction> action = bot ? chooseBotAction(session) : promptAction(session);
+        if (!action.has_value())
+        {
+          closeSocket(session.fd);
+          return 0; // ปิดการเชื่อมต่อ = ยอมแพ้
+        }
+        if (lockstep.submitLocal(action.value(), session.outbox))
+        {
+          session.rejected_in_row = 0;
+        }
+        else
+        {
+          session.rejected_in_row++;
+          if (!bot)
+          {
+            UIHelper::PrintError("คำสั่งไม่ถูกต้องตามกติกา ลองใหม่อีกครั้ง");
+          }
+        }
+        continue;
+      }
+
+      if (!waitForPeerFrame(session, loop, frame, frame_end))
+      {
+        if (!lockstep.getMatch().isOver())
+        {
+          lockstep.concede(1 - session.seat);
+        }
+        peer_left = true;
+        break;
+      }
+      MessageReader reader(frame.payload, frame.payload_size);
+      if (frame.type == MessageType::Action)
+      {
+        GameAction action;
+        desync = !readAction(reader, action) || !lockstep.submitRemote(action, session.outbox);
+      }
+      else if (frame.type == MessageType::Checksum)
+      {
+        uint16_t turn = reader.u16();
+        uint64_t checksum = reader.u64();
+        desync = !lockstep.verifyRemote(turn, checksum);
+      }
+      else if (frame.type == MessageType::Error)
+      {
+        lockstep.dumpOnPeerReport("อีกฝ่ายแจ้ง: " + reader.str());
+        desync = true;
+        session.inbox.erase(0, frame_end);
+        break;
+      }
+      session.inbox.erase(0, frame_end);
+      if (desync)
+      {
+        // แจ้งอีกฝ่ายให้บันทึกสถานะของตัวเองไว้เทียบด้วย
+        MessageWriter(session.outbox, MessageType::Error).str("สถานะเกมไม่ตรงกัน (" + lockstep.getDumpPath() + ")");
+        break;
+      }
+    }
+
+    const Match &match = lockstep.getMatch();
+    verified += lockstep.getVerifiedCount();
+    if (desync)
+    {
+      UIHelper::PrintError("สถานะเกมไม่ตรงกับอีกฝ่าย! บันทึกสถานะของเครื่องนี้ไว้ที่ " + lockstep.getDumpPath());
+      break;
+    }
+    if (peer_left && match.getEndReason() == MatchEnd::Conceded)
+    {
+      UIHelper::PrintWarning("อีกฝ่ายออกจากเกม");
+    }
+    else if (peer_left)
+    {
+      UIHelper::PrintWarning("อีกฝ่ายปิดการเชื่อมต่อก่อนยืนยัน checksum สุดท้าย");
+    }
+    played++;
+    wins += match.getWinnerIndex() == session.seat ? 1 : 0;
+    if (!bot)
+    {
+      UIHelper::PrintHorizontalLine('=', 70);
+      if (match.getWinnerIndex() < 0)
+        UIHelper::PrintInfo(string("เสมอ - ") + matchEndText(match.getEndReason()));
+      else if (match.getWinnerIndex() == session.seat)
+        UIHelper::PrintSuccess(string("คุณชนะ! (") + matchEndText(match.getEndReason()) + ")");
+      else
+        UIHelper::PrintError(string("คุณแพ้ (") + matchEndText(match.getEndReason()) + ")");
+    }
+  }
+
+  flushOutbox(session, loop);
+  closeSocket(session.fd);
+  double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+  cout << "lockstep: เล่นจบ " << played << " เกม (ชนะ " << wins << ") ตรวจ checksum ตรงกัน " << verified
+       << " จุด ใน " << seconds << " วินาที" << endl;
+  return desync ? 1 : 0;
+}
+
+// แปลงค่าตัวเลขของตัวเลือก (ต้องเป็นเลขฐานสิบไม่ติดลบทั้งข้อความ และอยู่ในช่วง min_value..max_value)
+static bool parseNumber(const string &text, uint64_t min_value, uint64_t max_value, uint64_t &value)
+{
+  if (text.empty() || !isdigit(static_cast<unsigned char>(text[0])))
+  {
+    return false;
+  }
+  try
+  {
+    size_t used = 0;
+    value = stoull(text, &used);
+    return used == text.size() && value >= min_value && value <= max_value;
+  }
+  catch (const exception &) // invalid_argument / out_of_range
+  {
+    return false;
+  }
+}
+
+// ตัวเลือก:
+//   --host <ip> / --port <n> / --unix <path>  ปลายทางของเซิร์ฟเวอร์
+//   --name <ชื่อ>        ชื่อผู้เล่น
+//   --script <file>      ใช้ไฟล์สคริปต์แทนการพิมพ์คำสั่ง
+//   --bot                เล่นด้วยบอทแทนผู้เล่น
+//   --connections <n>    จำนวนการเชื่อมต่อพร้อมกันในโหมดบอท (ค่าเริ่มต้น 2) หรือโหมดผู้ชม (ค่าเริ่มต้น 1)
+//   --games <n>          จำนวนเกมที่แต่ละการเชื่อมต่อเล่นในโหมดบอท (ค่าเริ่มต้น 1)
+//   --spectate <id>      ชมแมตช์หมายเลข id (0 = แมตช์ล่าสุด) ถ้ามีหลายการเชื่อมต่อจะสรุปผลแทนการแสดงสนาม
+//   --peer-listen        โหมด lockstep: รอให้อีกเครื่องเชื่อมต่อเข้ามาที่ปลายทางที่กำหนด (ไม่ใช้เซิร์ฟเวอร์)
+//   --peer               โหมด lockstep: เชื่อมต่อไปยังเครื่องที่รันด้วย --peer-listen
+//   --seed <n>           seed ของแมตช์แรกในโหมด lockstep (กำหนดโดยฝ่าย --peer-listen)
+//   --cards <file>       ไฟล์ข้อมูลการ์ดสำหรับโหมด lockstep (ค่าเริ่มต้น cards.json)
+int main(int argc, char *argv[])
+{
+#ifdef _WIN32
+  (void)argc;
+  cerr << argv[0] << ": ยังไม่รองรับ Windows" << endl;
+  return 1;
+#else
+  Endpoint endpoint;
+  string name = "Player";
+  string script_path;
+  bool bot = false;
+  optional<uint32_t> spectate_id;
+  int peer_mode = 0; // 0 = เล่นผ่านเซิร์ฟเวอร์, 1 = --peer-listen, 2 = --peer
+  optional<uint64_t> seed;
+  string cards_path = "cards.json";
+  int connection_count = 0; // 0 = ใช้ค่าเริ่มต้นของแต่ละโหมด
+  int games = 1;
+  bool valid = true;
+  for (int i = 1; i < argc; ++i)
+  {
+    string arg = argv[i];
+    uint64_t value = 0;
+    if (arg == "--host" && i + 1 < argc)
+    {
+      endpoint.host = argv[++i];
+    }
+    else if (arg == "--port" && i + 1 < argc)
+    {
+      valid = parseNumber(argv[++i], 0, UINT16_MAX, value);
+      endpoint.port = static_cast<uint16_t>(value);
+    }
+    else if (arg == "--unix" && i + 1 < argc)
+    {
+      endpoint.unix_path = argv[++i];
+    }
+    else if (arg == "--name" && i + 1 < argc)
+    {
+      name = argv[++i];
+    }
+    else if (arg == "--script" && i + 1 < argc)
+    {
+      script_path = argv[++i];
+    }
+    else if (arg == "--bot")
+    {
+      bot = true;
+    }
+    else if (arg == "--connections" && i + 1 < argc)
+    {
+      valid = parseNumber(argv[++i], 1, INT_MAX, value);
+      connection_count = static_cast<int>(value);
+    }
+    else if (arg == "--games" && i + 1 < argc)
+    {
+      valid = parseNumber(argv[++i], 1, INT_MAX, value);
+      games = static_cast<int>(value);
+    }
+    else if (arg == "--spectate" && i + 1 < argc)
+    {
+      valid = parseNumber(argv[++i], 0, UINT32_MAX, value);
+      spectate_id = static_cast<uint32_t>(value);
+    }
+    else if (arg == "--peer-listen")
+    {
+      peer_mode = 1;
+    }
+    else if (arg == "--peer")
+    {
+      peer_mode = 2;
+    }
+    else if (arg == "--seed" && i + 1 < argc)
+    {
+      valid = parseNumber(argv[++i], 0, UINT64_MAX, value);
+      seed = value;
+    }
+    else if (arg == "--cards" && i + 1 < argc)
+    {
+      cards_path = argv[++i];
+    }
+    else
+    {
+      valid = false;
+    }
+    if (!valid)
+    {
+      cerr << "ตัวเลือกไม่ถูกต้อง: " << arg << (arg != argv[i] ? string(" ") + argv[i] : string()) << "\n"
+           << "วิธีใช้: " << argv[0]
+           << " [--host <ip>] [--port <n>] [--unix <path>] [--name <ชื่อ>] [--script <file>]"
+              " [--bot] [--connections <n>] [--games <n>] [--spectate <id>]"
+              " [--peer-listen | --peer] [--seed <n>] [--cards <file>]"
+           << endl;
+      return 2;
+    }
+  }
+
+  signal(SIGPIPE, SIG_IGN);
+  if (spectate_id.has_value())
+  {
+    raiseOpenFileLimit();
+    return runSpectators(endpoint, spectate_id.value(), connection_count > 0 ? connection_count : 1);
+  }
+  if (bot && peer_mode == 0)
+  {
+    raiseOpenFileLimit();
+    return runBots(endpoint, connection_count > 0 ? connection_count : 2, games);
+  }
+
+  optional<ScriptInputSource> script_source;
+  if (!script_path.empty())
+  {
+    script_source.emplace(script_path);
+    if (!script_source->IsOpen())
+    {
+      UIHelper::PrintError("เปิดไฟล์สคริปต์ '" + script_path + "' ไม่ได้");
+      return 1;
+    }
+    InputSource::SetCurrent(&script_source.value());
+  }
+
+  try
+  {
+    if (peer_mode != 0)
+    {
+      return runLockstep(endpoint, peer_mode == 1, name, bot, seed, games, cards_path);
+    }
+    return runInteractive(endpoint, name);
+  }
+  catch (const InputExhaustedError &)
+  {
+    UIHelper::PrintInfo("ข้อมูลนำเข้าหมดแล้ว จบการทำงาน");
+    return 0;
+  }
+#endif
+}
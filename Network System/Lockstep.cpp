@@ -0,0 +1,121 @@
+// Lockstep.cpp - ไฟล์ Source สำหรับแมตช์แบบ lockstep ระหว่าง 2 เครื่อง
+#include "Lockstep.h"
+#include <fstream>
+#include "../Game Core/CardDatabase.h"
+
+LockstepMatch::LockstepMatch(const std::vector<Card> &catalog, const std::string names[2], int seat,
+                             uint64_t seed, int first_seat)
+    : match(names[0], Deck(catalog, getStandardDeckRecipe()), names[1], Deck(catalog, getStandardDeckRecipe())),
+      local_seat(seat), setup_ok(false), verified_count(0)
+{
+  ScopedOutputSink output_scope(&quiet);
+  setup_ok = match.setup(STARTER_CODE_NAME, seed);
+  if (setup_ok)
+  {
+    match.setObserver(this);
+    match.start(first_seat);
+  }
+}
+
+// จุดตรวจสอบ: หลังจบ End Phase ของทุกเทิร์น
+void LockstepMatch::onTurnEnd(Player &)
+{
+  addCheckpoint();
+}
+
+// จุดตรวจสอบสุดท้าย: ตอนจบเกม (ยกเว้นการยอมแพ้ ซึ่งอีกฝ่ายอาจปิดการเชื่อมต่อไปแล้ว)
+void LockstepMatch::onGameOver(Match &finished)
+{
+  if (finished.getEndReason() != MatchEnd::Conceded)
+  {
+    addCheckpoint();
+  }
+}
+
+void LockstepMatch::addCheckpoint()
+{
+  unverified.push_back({static_cast<uint16_t>(match.getTurnCount()), match.checksum(), match});
+}
+
+bool LockstepMatch::submit(const GameAction &action, std::string &outbox, bool local)
+{
+  ScopedOutputSink output_scope(&quiet);
+  size_t first_new = unverified.size();
+  if (!match.submit(action))
+  {
+    return false;
+  }
+  if (local)
+  {
+    writeAction(outbox, action);
+  }
+  for (size_t i = first_new; i < unverified.size(); ++i)
+  {
+    MessageWriter(outbox, MessageType::Checksum).u16(unverified[i].turn).u64(unverified[i].checksum);
+  }
+  return true;
+}
+
+bool LockstepMatch::submitLocal(const GameAction &action, std::string &outbox)
+{
+  return submit(action, outbox, true);
+}
+
+bool LockstepMatch::submitRemote(const GameAction &action, std::string &outbox)
+{
+  if (submit(action, outbox, false))
+  {
+    return true;
+  }
+  writeDump(match, static_cast<uint16_t>(match.getTurnCount()), match.checksum(), 0,
+            "การกระทำจากอีกฝ่ายไม่ถูกต้องในสถานะของเครื่องนี้");
+  return false;
+}
+
+bool LockstepMatch::verifyRemote(uint16_t turn, uint64_t checksum)
+{
+  if (unverified.empty())
+  {
+    writeDump(match, turn, match.checksum(), checksum, "ได้รับ checksum ก่อนที่เครื่องนี้จะถึงจุดตรวจสอบเดียวกัน");
+    return false;
+  }
+  const Checkpoint &checkpoint = unverified.front();
+  if (checkpoint.turn != turn || checkpoint.checksum != checksum)
+  {
+    writeDump(checkpoint.snapshot, checkpoint.turn, checkpoint.checksum, checksum, "checksum ไม่ตรงกัน");
+    return false;
+  }
+  unverified.pop_front();
+  verified_count++;
+  return true;
+}
+
+void LockstepMatch::dumpOnPeerReport(const std::string &reason)
+{
+  if (unverified.empty())
+  {
+    writeDump(match, static_cast<uint16_t>(match.getTurnCount()), match.checksum(), 0, reason);
+    return;
+  }
+  const Checkpoint &checkpoint = unverified.front();
+  writeDump(checkpoint.snapshot, checkpoint.turn, checkpoint.checksum, 0, reason);
+}
+
+void LockstepMatch::concede(int seat)
+{
+  ScopedOutputSink output_scope(&quiet);
+  match.concede(seat);
+  unverified.clear();
+}
+
+// บันทึกสถานะของเครื่องนี้ลงไฟล์ (แต่ละที่นั่งใช้ชื่อไฟล์ต่างกัน จึงเทียบกันได้แม้รันบนเครื่องเดียวกัน)
+void LockstepMatch::writeDump(const Match &state, uint16_t turn, uint64_t local_checksum, uint64_t remote_checksum,
+                              const std::string &reason)
+{
+  dump_path = "fibo_desync_seat" + std::to_string(local_seat) + "_turn" + std::to_string(turn) + ".txt";
+  std::ofstream out(dump_path);
+  out << "# " << reason << "\n"
+      << "# seat " << local_seat << ", turn " << turn << std::hex
+      << ", local checksum " << local_checksum << ", remote checksum " << remote_checksum << std::dec << "\n";
+  state.dumpState(out);
+}
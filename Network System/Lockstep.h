@@ -0,0 +1,76 @@
+// Lockstep.h - ไฟล์ Header สำหรับแมตช์แบบ lockstep ระหว่าง 2 เครื่อง (peer-to-peer)
+// ทั้งสองฝ่ายเดินเกมด้วย Match ของตัวเองจาก seed เดียวกัน แล้วส่งกันเฉพาะการกระทำ ไม่ต้องผ่านเซิร์ฟเวอร์
+// หลังจบ End Phase ทุกเทิร์น (และตอนจบเกม) แต่ละฝ่ายส่ง checksum ของสถานะทั้งหมดให้อีกฝ่ายเทียบ
+// ถ้าไม่ตรงกันจะบันทึกสถานะ ณ จุดที่คำนวณ checksum ลงไฟล์ เพื่อนำไฟล์ของทั้งสองฝ่ายมาเทียบหาจุดที่ต่างกัน
+#ifndef LOCKSTEP_H
+#define LOCKSTEP_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <cstdint>
+#include "Protocol.h"
+#include "../Game Core/Match.h"
+#include "../Game Core/Card.h"
+#include "../UI System/OutputSink.h"
+
+class LockstepMatch : private MatchObserver
+{
+private:
+  // สถานะที่คำนวณ checksum แล้วแต่อีกฝ่ายยังไม่ได้ยืนยัน
+  struct Checkpoint
+  {
+    uint16_t turn;
+    uint64_t checksum;
+    Match snapshot; // สำเนาสถานะ ณ จุดนั้น (ใช้บันทึกลงไฟล์เมื่อไม่ตรงกัน)
+  };
+
+  Match match;
+  NullSink quiet; // ข้อความที่เกมพิมพ์ระหว่างเดินเกมถูกทิ้ง (ไคลเอนต์แสดงผลจาก StateView เอง)
+  int local_seat;
+  bool setup_ok;
+  std::deque<Checkpoint> unverified; // เรียงตามลำดับที่เกิด (อีกฝ่ายส่ง checksum มาในลำดับเดียวกัน)
+  uint64_t verified_count;
+  std::string dump_path; // ไฟล์ที่บันทึกสถานะเมื่อ checksum ไม่ตรง
+
+  void onTurnEnd(Player &turn_player) override;
+  void onGameOver(Match &finished) override;
+  void addCheckpoint();
+  bool submit(const GameAction &action, std::string &outbox, bool local);
+  void writeDump(const Match &state, uint16_t turn, uint64_t local_checksum, uint64_t remote_checksum,
+                 const std::string &reason);
+
+public:
+  // names: ชื่อผู้เล่นตามลำดับที่นั่ง, local_seat: ที่นั่งของเครื่องนี้
+  LockstepMatch(const std::vector<Card> &catalog, const std::string names[2], int local_seat,
+                uint64_t seed, int first_seat);
+  LockstepMatch(const LockstepMatch &) = delete;
+  LockstepMatch &operator=(const LockstepMatch &) = delete;
+
+  bool isReady() const { return setup_ok; } // false = ไม่พบการ์ด starter ในแคตตาล็อก
+  const Match &getMatch() const { return match; }
+  int getLocalSeat() const { return local_seat; }
+  bool isLocalDecision() const { return match.getActingPlayerIndex() == local_seat; }
+
+  // การกระทำของเครื่องนี้ - ถ้าถูกต้องจะต่อข้อความ Action และ Checksum ที่เกิดขึ้นท้าย outbox
+  // คืนค่า false ถ้าการกระทำไม่ถูกต้อง (สถานะไม่เปลี่ยนและไม่ส่งอะไร)
+  bool submitLocal(const GameAction &action, std::string &outbox);
+
+  // การกระทำจากอีกฝ่าย - คืนค่า false ถ้าการกระทำไม่ถูกต้องในสถานะของเครื่องนี้ (เกมแยกทางกันแล้ว)
+  bool submitRemote(const GameAction &action, std::string &outbox);
+
+  // เทียบ checksum จากอีกฝ่ายกับของเครื่องนี้ตามลำดับ - คืนค่า false ถ้าไม่ตรง (บันทึกสถานะลงไฟล์แล้ว)
+  bool verifyRemote(uint16_t turn, uint64_t checksum);
+
+  // อีกฝ่ายแจ้งว่าสถานะไม่ตรงกัน - บันทึกสถานะ ณ จุดตรวจสอบที่ยังไม่ได้ยืนยัน (หรือสถานะปัจจุบัน) ลงไฟล์
+  void dumpOnPeerReport(const std::string &reason);
+
+  // ยอมแพ้ (ผู้เล่นออกหรืออีกฝ่ายปิดการเชื่อมต่อ) - ไม่มีการเทียบ checksum หลังจากนี้
+  void concede(int seat);
+
+  bool isFullyVerified() const { return unverified.empty(); }
+  uint64_t getVerifiedCount() const { return verified_count; }
+  const std::string &getDumpPath() const { return dump_path; }
+};
+
+#endif // LOCKSTEP_H
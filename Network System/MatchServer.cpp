@@ -0,0 +1,737 @@
+// MatchServer.cpp - ไฟล์ Source สำหรับเซิร์ฟเวอร์จับคู่และเดินเกมผ่านเครือข่าย
+#include "MatchServer.h"
+#include "../Game Core/Deck.h"
+#include "../Game Core/CardDatabase.h"
+#include "../Game Core/Metrics.h"
+#include "../Game Core/BattleResolver.h"
+#include <algorithm>
+#include <ctime>
+
+// ตัวรับเหตุการณ์ของแมตช์ที่เล่นผ่านเครือข่าย
+// แต่ละเหตุการณ์ถูกเข้ารหัสครั้งเดียวแล้วคัดลอกไปต่อท้าย outbox ของผู้เล่นทั้งสองฝ่าย
+// ผู้ชมได้รับ Keyframe ตอนเริ่มชม แล้วตามด้วย Delta 1 ข้อความต่อการกระทำ ซึ่งเข้ารหัสครั้งเดียว
+// และแชร์บัฟเฟอร์เดียวกันให้ผู้ชมทุกคน ต้นทุนต่อการกระทำจึงไม่ขึ้นกับจำนวนผู้ชม
+class NetworkMatchView : public MatchObserver
+{
+private:
+  MatchServer &server;
+  MatchId id;
+  Match &match;
+  int seat_fds[2];                // fd ของผู้เล่นแต่ละที่นั่ง
+  std::vector<int> spectator_fds; // fd ของผู้ชม
+  StateView public_state;         // สถานะสาธารณะล่าสุดที่ส่งให้ผู้ชม (Delta ถัดไปคำนวณจากค่านี้)
+
+  int seatOf(const Player &player) const { return &player == &match.getPlayer(0) ? 0 : 1; }
+
+  // ส่งข้อความใน server.scratch ให้ทั้งสองที่นั่ง
+  void broadcast()
+  {
+    server.send(seat_fds[0], server.scratch);
+    server.send(seat_fds[1], server.scratch);
+    server.scratch.clear();
+  }
+
+public:
+  NetworkMatchView(MatchServer &owner, MatchId match_id, Match &watched_match, int fd0, int fd1)
+      : server(owner), id(match_id), match(watched_match), seat_fds{fd0, fd1}
+  {
+  }
+
+  // เวลาที่แมตช์เริ่มรอการตัดสินใจปัจจุบัน (เริ่มแมตช์หรือการกระทำล่าสุดที่ยอมรับ)
+  std::chrono::steady_clock::time_point awaiting_since = std::chrono::steady_clock::now();
+
+  int getSeatFd(int seat) const { return seat_fds[seat]; }
+  const std::vector<int> &getSpectators() const { return spectator_fds; }
+
+  // เพิ่มผู้ชมและส่ง Keyframe ของสถานะปัจจุบัน
+  void addSpectator(int fd)
+  {
+    if (spectator_fds.empty())
+    {
+      public_state = makeStateView(match, -1, server.card_index); // ไม่มีผู้ชมก่อนหน้า - ยังไม่ได้ติดตามสถานะ
+    }
+    spectator_fds.push_back(fd);
+    auto keyframe = std::make_shared<std::string>();
+    writeKeyframe(*keyframe, id, match.getPlayer(0).getName(),
+                  match.getPlayer(1).getName(), public_state);
+    server.sendShared(fd, keyframe);
+  }
+
+  void removeSpectator(int fd)
+  {
+    spectator_fds.erase(std::remove(spectator_fds.begin(), spectator_fds.end(), fd), spectator_fds.end());
+  }
+
+  // เข้ารหัสการเปลี่ยนแปลงตั้งแต่ Delta ก่อนหน้าครั้งเดียว แล้วแชร์ให้ผู้ชมทุกคน
+  void publishDelta()
+  {
+    if (spectator_fds.empty())
+    {
+      return;
+    }
+    StateView current = makeStateView(match, -1, server.card_index);
+    auto delta = std::make_shared<std::string>();
+    if (!writeDelta(*delta, public_state, current))
+    {
+      return;
+    }
+    public_state = current;
+    server.stats.deltas_published++;
+    server.stats.delta_bytes += delta->size();
+    for (int fd : spectator_fds)
+    {
+      server.sendShared(fd, delta);
+    }
+  }
+
+  void onTurnStart(Player &turn_player, int turn_number) override
+  {
+    MessageWriter(server.scratch, MessageType::Event)
+        .u8(static_cast<uint8_t>(EventType::TurnStart))
+        .u8(static_cast<uint8_t>(seatOf(turn_player)))
+        .u16(static_cast<uint16_t>(turn_number));
+    broadcast();
+  }
+
+  void onAttackPower(Player &attacker, Player &, const AttackState &attack) override
+  {
+    MessageWriter(server.scratch, MessageType::Event)
+        .u8(static_cast<uint8_t>(EventType::Attack))
+        .u8(static_cast<uint8_t>(seatOf(attacker)))
+        .i8(static_cast<int8_t>(attack.attacker_idx))
+        .i8(static_cast<int8_t>(attack.target_idx))
+        .i8(static_cast<int8_t>(attack.booster_idx))
+        .u32(static_cast<uint32_t>(attack.power))
+        .u8(static_cast<uint8_t>(attack.critical));
+    broadcast();
+  }
+
+  void onBattleResult(Player &, Player &, const AttackState &attack, int defense_power) override
+  {
+    MessageWriter(server.scratch, MessageType::Event)
+        .u8(static_cast<uint8_t>(EventType::BattleResult))
+        .u32(static_cast<uint32_t>(defense_power))
+        .u8(isBattleHit(attack.power, defense_power) ? 1 : 0);
+    broadcast();
+  }
+
+  void onDamageRevealed(Player &defender, const Card &damage_card) override
+  {
+    MessageWriter(server.scratch, MessageType::Event)
+        .u8(static_cast<uint8_t>(EventType::DamageCard))
+        .u8(static_cast<uint8_t>(seatOf(defender)))
+        .u8(server.cardIndexOf(damage_card));
+    broadcast();
+  }
+
+  void onTurnEnd(Player &turn_player) override
+  {
+    MessageWriter(server.scratch, MessageType::Event)
+        .u8(static_cast<uint8_t>(EventType::TurnEnd))
+        .u8(static_cast<uint8_t>(seatOf(turn_player)));
+    broadcast();
+  }
+
+  void onGameOver(Match &finished) override
+  {
+    publishDelta(); // ผู้ชมต้องเห็นสถานะสุดท้ายก่อนผลการแข่งขัน
+
+    int winner = finished.getWinnerIndex();
+    MessageWriter(server.scratch, MessageType::GameOver)
+        .u8(static_cast<uint8_t>(finished.getEndReason()))
+        .u8(winner < 0 ? NO_SEAT : static_cast<uint8_t>(winner))
+        .u16(static_cast<uint16_t>(finished.getTurnCount()));
+    if (!spectator_fds.empty())
+    {
+      auto game_over = std::make_shared<std::string>(server.scratch);
+      for (int fd : spectator_fds)
+      {
+        server.sendShared(fd, game_over);
+      }
+    }
+    broadcast();
+  }
+};
+
+// Constructor - เตรียมดัชนีการ์ดและข้อความ Welcome ไว้ล่วงหน้า
+MatchServer::MatchServer(std::vector<Card> card_catalog, bool verbose_output)
+    : listen_fd(-1), waiting_fd(-1), next_first_seat(0), latest_match(0), catalog(std::move(card_catalog)),
+      seed_source(std::random_device{}()), metrics_interval(10), verbose(verbose_output)
+{
+  if (catalog.size() >= NO_CARD)
+  {
+    catalog.erase(catalog.begin() + (NO_CARD - 1), catalog.end()); // ดัชนีการ์ดส่งเป็น 1 ไบต์ (NO_CARD สงวนไว้สำหรับช่องว่าง)
+  }
+  card_index = makeCardIndex(catalog);
+  catalog_checksum = catalogChecksum(catalog);
+  writeWelcome(welcome_message, catalog);
+
+  scheduler.setUpdateHandler([this](MatchId id, int player_idx, Match &match, bool accepted)
+                             { onMatchUpdate(id, player_idx, match, accepted); });
+}
+
+MatchServer::~MatchServer()
+{
+  for (auto &entry : connections)
+  {
+    closeSocket(entry.first);
+  }
+  closeSocket(listen_fd);
+}
+
+bool MatchServer::listen(const Endpoint &endpoint)
+{
+  listen_fd = listenOn(endpoint);
+  return listen_fd >= 0 && loop.add(listen_fd);
+}
+
+void MatchServer::setReplayDirectory(const std::string &directory)
+{
+  replay_prefix = directory.empty() ? std::string() : directory + "/match_" + std::to_string(std::time(nullptr)) + "_";
+}
+
+bool MatchServer::setStatsFile(const std::string &path)
+{
+  return stats_writer.open(path);
+}
+
+void MatchServer::setMetricsFile(const std::string &path, int interval_seconds)
+{
+  metrics_path = path;
+  metrics_interval = std::chrono::seconds(interval_seconds);
+  metrics_written = std::chrono::steady_clock::now();
+}
+
+void MatchServer::closeStatsFile()
+{
+  if (stats_writer.isOpen())
+  {
+    stats_writer.close();
+    stats.stats_rows = stats_writer.getRowsWritten();
+    stats.stats_bytes = stats_writer.getBytesWritten();
+  }
+}
+
+void MatchServer::run(const std::atomic<bool> &stop_requested)
+{
+  // ข้อความที่เกมพิมพ์ระหว่างเดินเกมจะออกทาง sink ของเธรดนี้
+  ScopedOutputSink quiet(verbose ? &OutputSink::Current() : &null_sink);
+
+  std::vector<IoEvent> events;
+  while (!stop_requested.load())
+  {
+    loop.wait(events, 500);
+    for (const IoEvent &event : events)
+    {
+      if (event.fd == listen_fd)
+      {
+        acceptPending();
+        continue;
+      }
+      auto it = connections.find(event.fd);
+      if (it == connections.end())
+      {
+        continue;
+      }
+      Connection &connection = it->second;
+      if (event.readable || event.closed)
+      {
+        handleReadable(connection);
+      }
+      if (event.writable && !connection.closing)
+      {
+        connection.dirty = true;
+        dirty_fds.push_back(connection.fd);
+      }
+    }
+
+    // เดินเกมทุกแมตช์ที่ได้รับการกระทำในรอบนี้ แล้วส่งผลลัพธ์ออกไปพร้อมกัน
+    scheduler.runPending();
+    flushDirty();
+    closePending();
+
+    if (!metrics_path.empty() && std::chrono::steady_clock::now() - metrics_written >= metrics_interval)
+    {
+      MetricsRegistry::global().writePrometheusFile(metrics_path);
+      metrics_written = std::chrono::steady_clock::now();
+    }
+  }
+  if (!metrics_path.empty())
+  {
+    MetricsRegistry::global().writePrometheusFile(metrics_path);
+  }
+}
+
+void MatchServer::acceptPending()
+{
+  while (true)
+  {
+    int fd = acceptClient(listen_fd);
+    if (fd < 0)
+    {
+      return;
+    }
+    if (!loop.add(fd))
+    {
+      closeSocket(fd);
+      continue;
+    }
+    connections[fd].fd = fd;
+    stats.connections_accepted++;
+    stats.peak_connections = std::max(stats.peak_connections, connections.size());
+  }
+}
+
+void MatchServer::handleReadable(Connection &connection)
+{
+  size_t before = connection.inbox.size();
+  bool open = readAvailable(connection.fd, connection.inbox);
+  stats.bytes_received += connection.inbox.size() - before;
+
+  size_t offset = 0;
+  Frame frame;
+  int result;
+  while (!connection.closing && (result = extractFrame(connection.inbox, offset, frame)) != 0)
+  {
+    if (result < 0 || !handleMessage(connection, frame))
+    {
+      sendError(connection, "ข้อความไม่ถูกต้อง");
+      break;
+    }
+  }
+  connection.inbox.erase(0, offset);
+
+  if (!open && !connection.closing)
+  {
+    connection.closing = true;
+    closing_fds.push_back(connection.fd);
+  }
+}
+
+// ประมวลผลข้อความ 1 ข้อความจากไคลเอนต์ คืนค่า false ถ้าข้อความผิดรูปแบบ
+bool MatchServer::handleMessage(Connection &connection, const Frame &frame)
+{
+  MessageReader reader(frame.payload, frame.payload_size);
+  switch (frame.type)
+  {
+  case MessageType::Hello:
+  {
+    uint8_t version = reader.u8();
+    std::string name = reader.str();
+    if (!reader.ok() || version != PROTOCOL_VERSION)
+    {
+      return false;
+    }
+    if (connection.match_id != 0)
+    {
+      return true; // กำลังเล่นอยู่ - รอให้แมตช์จบก่อนจึงจะเข้าคิวใหม่ได้
+    }
+    connection.name = name.empty() ? "Player" : name;
+    if (!connection.greeted)
+    {
+      connection.greeted = true;
+      send(connection.fd, welcome_message);
+    }
+
+    // จับคู่กับไคลเอนต์ที่รออยู่ หรือรอคู่แข่งคนถัดไป
+    if (waiting_fd < 0 || waiting_fd == connection.fd)
+    {
+      waiting_fd = connection.fd;
+    }
+    else
+    {
+      int opponent_fd = waiting_fd;
+      waiting_fd = -1;
+      pairPlayers(opponent_fd, connection.fd);
+    }
+    return true;
+  }
+
+  case MessageType::Action:
+  {
+    GameAction action;
+    if (!readAction(reader, action))
+    {
+      return false;
+    }
+    stats.actions_received++;
+    if (connection.match_id == 0)
+    {
+      MessageWriter(scratch, MessageType::Rejected);
+      send(connection.fd, scratch);
+      scratch.clear();
+      return true;
+    }
+    scheduler.post(connection.match_id, connection.seat, action);
+    return true;
+  }
+
+  case MessageType::Spectate:
+  {
+    MatchId id = reader.u32();
+    if (!reader.ok())
+    {
+      return false;
+    }
+    if (connection.match_id == 0)
+    {
+      startSpectating(connection, id == 0 ? latest_match : id);
+    }
+    return true;
+  }
+
+  default:
+    return false;
+  }
+}
+
+void MatchServer::send(int fd, const std::string &message)
+{
+  auto it = connections.find(fd);
+  if (it == connections.end() || it->second.closing)
+  {
+    return;
+  }
+  it->second.outbox += message;
+  markForWrite(it->second);
+}
+
+// ส่งข้อความที่เข้ารหัสไว้แล้วโดยไม่คัดลอก - ผู้ชมทุกคนถือ pointer ไปยังบัฟเฟอร์เดียวกัน
+void MatchServer::sendShared(int fd, const std::shared_ptr<const std::string> &message)
+{
+  auto it = connections.find(fd);
+  if (it == connections.end() || it->second.closing)
+  {
+    return;
+  }
+  Connection &connection = it->second;
+  connection.shared_out.push_back(message);
+  connection.shared_bytes += message->size();
+  markForWrite(connection);
+}
+
+bool MatchServer::markForWrite(Connection &connection)
+{
+  if (connection.outbox.size() + connection.shared_bytes > MAX_OUTBOX_SIZE)
+  {
+    // ไคลเอนต์ไม่อ่านข้อมูล - ตัดการเชื่อมต่อแทนที่จะเก็บข้อมูลไว้ไม่จำกัด
+    connection.closing = true;
+    closing_fds.push_back(connection.fd);
+    return false;
+  }
+  if (!connection.dirty)
+  {
+    connection.dirty = true;
+    dirty_fds.push_back(connection.fd);
+  }
+  return true;
+}
+
+void MatchServer::sendError(Connection &connection, const std::string &message)
+{
+  MessageWriter(scratch, MessageType::Error).str(message);
+  send(connection.fd, scratch);
+  scratch.clear();
+  writePending(connection.fd, connection.outbox); // พยายามส่งก่อนปิด
+  if (!connection.closing)
+  {
+    connection.closing = true;
+    closing_fds.push_back(connection.fd);
+  }
+}
+
+// ส่งข้อมูลที่ค้างอยู่ของทุกการเชื่อมต่อที่มีข้อมูลใหม่ และลงทะเบียนรอ socket ว่างถ้าส่งไม่หมด
+void MatchServer::flushDirty()
+{
+  for (int fd : dirty_fds)
+  {
+    auto it = connections.find(fd);
+    if (it == connections.end() || it->second.closing)
+    {
+      continue;
+    }
+    Connection &connection = it->second;
+    connection.dirty = false;
+
+    size_t before = connection.outbox.size();
+    bool ok = writePending(fd, connection.outbox);
+    stats.bytes_sent += before - connection.outbox.size();
+
+    // ข้อความที่แชร์กับผู้ชมคนอื่นส่งต่อจาก outbox ตามลำดับ
+    while (ok && connection.outbox.empty() && !connection.shared_out.empty())
+    {
+      const std::string &message = *connection.shared_out.front();
+      size_t offset_before = connection.shared_offset;
+      ok = writeSome(fd, message.data(), message.size(), connection.shared_offset);
+      connection.shared_bytes -= connection.shared_offset - offset_before;
+      stats.bytes_sent += connection.shared_offset - offset_before;
+      if (connection.shared_offset < message.size())
+      {
+        break; // socket เต็ม
+      }
+      connection.shared_out.pop_front();
+      connection.shared_offset = 0;
+    }
+
+    if (!ok)
+    {
+      connection.closing = true;
+      closing_fds.push_back(fd);
+      continue;
+    }
+
+    bool need_write = !connection.outbox.empty() || !connection.shared_out.empty();
+    if (need_write != connection.want_write)
+    {
+      connection.want_write = need_write;
+      loop.modify(fd, need_write);
+    }
+  }
+  dirty_fds.clear();
+}
+
+void MatchServer::closePending()
+{
+  // disconnect() อาจส่งข้อมูลให้คู่แข่ง ซึ่งอาจทำให้ต้องปิดการเชื่อมต่อเพิ่ม จึงวนจนกว่าจะว่าง
+  while (!closing_fds.empty())
+  {
+    std::vector<int> to_close;
+    to_close.swap(closing_fds);
+    for (int fd : to_close)
+    {
+      disconnect(fd);
+    }
+    flushDirty();
+  }
+}
+
+// ปิดการเชื่อมต่อ ถ้ากำลังเล่นอยู่ถือว่ายอมแพ้ และแจ้งผลให้คู่แข่ง
+void MatchServer::disconnect(int fd)
+{
+  auto it = connections.find(fd);
+  if (it == connections.end())
+  {
+    return;
+  }
+  MatchId match_id = it->second.match_id;
+  int seat = it->second.seat;
+  MatchId spectating = it->second.spectating;
+
+  // นำออกจากตารางก่อน เพื่อไม่ให้มีข้อความถูกส่งไปยัง fd ที่ปิดแล้ว
+  loop.remove(fd);
+  closeSocket(fd);
+  connections.erase(it);
+  if (waiting_fd == fd)
+  {
+    waiting_fd = -1;
+  }
+
+  auto spectated = views.find(spectating);
+  if (spectated != views.end())
+  {
+    spectated->second->removeSpectator(fd);
+  }
+
+  Match *match = match_id != 0 ? scheduler.findMatch(match_id) : nullptr;
+  if (match)
+  {
+    match->concede(seat); // onGameOver ของ view จะส่ง GameOver ให้คู่แข่ง
+    endMatch(match_id);
+  }
+}
+
+void MatchServer::pairPlayers(int first_fd, int second_fd)
+{
+  Connection &first = connections[first_fd];
+  Connection &second = connections[second_fd];
+  const std::map<std::string, int> &recipe = getStandardDeckRecipe();
+
+  uint64_t seed = seed_source();
+  auto match = std::make_unique<Match>(first.name, Deck(catalog, recipe), second.name, Deck(catalog, recipe));
+  if (!match->setup(STARTER_CODE_NAME, seed))
+  {
+    sendError(first, "ไม่พบการ์ด Starter ในแคตตาล็อกของเซิร์ฟเวอร์");
+    sendError(second, "ไม่พบการ์ด Starter ในแคตตาล็อกของเซิร์ฟเวอร์");
+    return;
+  }
+
+  Match &match_ref = *match;
+  MatchId id = scheduler.addMatch(std::move(match));
+  auto view = std::make_unique<NetworkMatchView>(*this, id, match_ref, first_fd, second_fd);
+  match_ref.setObserver(view.get());
+  views[id] = std::move(view);
+
+  first.match_id = id;
+  first.seat = 0;
+  second.match_id = id;
+  second.seat = 1;
+  latest_match = id;
+  stats.matches_started++;
+  stats.peak_matches = std::max(stats.peak_matches, scheduler.getMatchCount());
+
+  int first_seat = next_first_seat;
+  next_first_seat = 1 - next_first_seat;
+  if (!replay_prefix.empty() || stats_writer.isOpen())
+  {
+    ReplayHeader header;
+    header.seed = seed;
+    header.catalog_checksum = catalog_checksum;
+    header.first_player = first_seat;
+    header.starter_code_name = STARTER_CODE_NAME;
+    header.player_names = {first.name, second.name};
+    header.deck_recipes = {recipe, recipe};
+    auto recording = std::make_unique<MatchRecording>();
+    if (!replay_prefix.empty() && recording->replay.open(replay_prefix + std::to_string(id) + ".fibr", header, catalog))
+    {
+      recording->has_replay = true;
+      recording->group.add(&recording->replay);
+    }
+    if (stats_writer.isOpen())
+    {
+      recording->stats.emplace(stats_writer, header);
+      recording->group.add(&recording->stats.value());
+    }
+    if (!recording->group.isEmpty())
+    {
+      match_ref.setRecorder(&recording->group);
+      recordings[id] = std::move(recording);
+    }
+  }
+  MessageWriter(scratch, MessageType::MatchStart)
+      .u32(id)
+      .u8(0)
+      .u8(static_cast<uint8_t>(first_seat))
+      .str(second.name);
+  send(first_fd, scratch);
+  scratch.clear();
+  MessageWriter(scratch, MessageType::MatchStart)
+      .u32(id)
+      .u8(1)
+      .u8(static_cast<uint8_t>(first_seat))
+      .str(first.name);
+  send(second_fd, scratch);
+  scratch.clear();
+
+  match_ref.start(first_seat);
+  sendState(first_fd, match_ref, 0);
+  sendState(second_fd, match_ref, 1);
+  if (match_ref.isOver())
+  {
+    endMatch(id);
+  }
+}
+
+// เริ่มชมแมตช์ (ถ้ากำลังชมแมตช์อื่นอยู่จะย้ายมาแมตช์นี้แทน)
+void MatchServer::startSpectating(Connection &connection, MatchId id)
+{
+  auto view_it = views.find(id);
+  if (view_it == views.end())
+  {
+    sendError(connection, "ไม่พบแมตช์ที่ต้องการชม");
+    return;
+  }
+  auto previous = views.find(connection.spectating);
+  if (previous != views.end())
+  {
+    previous->second->removeSpectator(connection.fd);
+  }
+  if (waiting_fd == connection.fd)
+  {
+    waiting_fd = -1; // ผู้ชมไม่ได้รอจับคู่แล้ว
+  }
+  if (!connection.greeted)
+  {
+    connection.greeted = true;
+    send(connection.fd, welcome_message); // ผู้ชมต้องมีแคตตาล็อกก่อนอ่าน Keyframe
+  }
+  connection.spectating = id;
+  view_it->second->addSpectator(connection.fd);
+  stats.spectators_joined++;
+}
+
+void MatchServer::sendState(int fd, Match &match, int seat)
+{
+  writeStateView(scratch, makeStateView(match, seat, card_index));
+  send(fd, scratch);
+  scratch.clear();
+}
+
+// ถูกเรียกโดย MatchScheduler หลังเดินเกมจากการกระทำ 1 ครั้ง
+void MatchServer::onMatchUpdate(MatchId id, int player_idx, Match &match, bool accepted)
+{
+  auto view_it = views.find(id);
+  if (view_it == views.end())
+  {
+    return;
+  }
+  NetworkMatchView &view = *view_it->second;
+
+  if (!accepted)
+  {
+    stats.actions_rejected++;
+    MessageWriter(scratch, MessageType::Rejected);
+    send(view.getSeatFd(player_idx), scratch);
+    scratch.clear();
+    sendState(view.getSeatFd(player_idx), match, player_idx);
+    return;
+  }
+
+  static MetricHistogram &remote_latency = decisionLatencyMetric("remote");
+  auto now = std::chrono::steady_clock::now();
+  remote_latency.record(
+      static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - view.awaiting_since).count()));
+  view.awaiting_since = now;
+
+  view.publishDelta();
+  sendState(view.getSeatFd(0), match, 0);
+  sendState(view.getSeatFd(1), match, 1);
+  if (match.isOver())
+  {
+    endMatch(id);
+  }
+}
+
+// นำแมตช์ที่จบแล้วออก ผู้เล่นทั้งสองส่ง Hello อีกครั้งเพื่อเข้าคิวแมตช์ใหม่ได้
+void MatchServer::endMatch(MatchId id)
+{
+  auto view_it = views.find(id);
+  if (view_it != views.end())
+  {
+    for (int seat = 0; seat < 2; ++seat)
+    {
+      auto it = connections.find(view_it->second->getSeatFd(seat));
+      if (it != connections.end() && it->second.match_id == id)
+      {
+        it->second.match_id = 0;
+        it->second.seat = -1;
+      }
+    }
+    for (int fd : view_it->second->getSpectators())
+    {
+      auto it = connections.find(fd);
+      if (it != connections.end())
+      {
+        it->second.spectating = 0;
+      }
+    }
+    views.erase(view_it);
+  }
+  auto recording_it = recordings.find(id);
+  if (recording_it != recordings.end())
+  {
+    if (recording_it->second->has_replay)
+    {
+      stats.replays_recorded++;
+      stats.replay_bytes += recording_it->second->replay.getBytesWritten();
+    }
+    recordings.erase(recording_it);
+  }
+  scheduler.removeMatch(id);
+  stats.matches_finished++;
+}
+
+uint8_t MatchServer::cardIndexOf(const Card &card) const
+{
+  auto it = card_index.find(card.getCodeName());
+  return it != card_index.end() ? it->second : NO_CARD;
+}
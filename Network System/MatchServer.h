@@ -0,0 +1,164 @@
+// MatchServer.h - ไฟล์ Header สำหรับเซิร์ฟเวอร์จับคู่และเดินเกมผ่านเครือข่าย (fibo_server)
+// ทุกอย่างทำงานบนเธรดเดียว: event loop รับ/ส่งข้อมูลของทุกไคลเอนต์แบบ non-blocking
+// ส่วนการเดินเกมส่งต่อให้ MatchScheduler ซึ่งปลุกเฉพาะแมตช์ที่มีการกระทำเข้ามา
+// แมตช์ที่รอผู้เล่นอยู่จึงใช้แค่หน่วยความจำของสถานะเกมกับบัฟเฟอร์ของ 2 การเชื่อมต่อ
+#ifndef MATCHSERVER_H
+#define MATCHSERVER_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <random>
+#include <chrono>
+#include <optional>
+#include "Socket.h"
+#include "Protocol.h"
+#include "../Game Core/Card.h"
+#include "../Game Core/MatchScheduler.h"
+#include "../Game Core/Replay.h"
+#include "../Game Core/GameStats.h"
+#include "../UI System/OutputSink.h"
+
+class NetworkMatchView;
+
+// สถิติการทำงานของเซิร์ฟเวอร์ (แสดงตอนปิดเซิร์ฟเวอร์)
+struct ServerStats
+{
+  uint64_t connections_accepted = 0;
+  uint64_t matches_started = 0;
+  uint64_t matches_finished = 0;
+  uint64_t actions_received = 0;
+  uint64_t actions_rejected = 0;
+  uint64_t spectators_joined = 0;
+  uint64_t deltas_published = 0; // ข้อความ Delta ที่เข้ารหัส (ครั้งเดียวต่อการกระทำ ไม่ขึ้นกับจำนวนผู้ชม)
+  uint64_t delta_bytes = 0;
+  uint64_t bytes_received = 0;
+  uint64_t bytes_sent = 0;
+  uint64_t replays_recorded = 0; // ไฟล์ replay ที่บันทึกจนแมตช์จบ
+  uint64_t replay_bytes = 0;
+  uint64_t stats_rows = 0; // แถวสถิติที่บันทึก (เติมตอน closeStatsFile())
+  uint64_t stats_bytes = 0;
+  size_t peak_connections = 0;
+  size_t peak_matches = 0;
+};
+
+class MatchServer
+{
+  friend class NetworkMatchView;
+
+public:
+  static constexpr size_t MAX_OUTBOX_SIZE = 1024 * 1024; // ไคลเอนต์ที่อ่านไม่ทันเกินนี้จะถูกตัดการเชื่อมต่อ
+
+private:
+  // ข้อมูลของไคลเอนต์ 1 การเชื่อมต่อ
+  struct Connection
+  {
+    int fd = -1;
+    std::string inbox;       // ข้อมูลที่รับมาแต่ยังแยกเป็นข้อความไม่ครบ
+    std::string outbox;      // ข้อมูลที่รอส่ง
+    std::string name;        // ชื่อผู้เล่นจาก Hello
+    MatchId match_id = 0;    // แมตช์ที่กำลังเล่น (0 = ไม่มี)
+    int seat = -1;           // ที่นั่งในแมตช์ (0 หรือ 1)
+    MatchId spectating = 0;  // แมตช์ที่กำลังชม (0 = ไม่ได้ชม)
+    bool greeted = false;    // ได้รับ Hello แล้ว
+    bool want_write = false; // ลงทะเบียนรอ socket ว่างสำหรับเขียนอยู่หรือไม่
+    bool dirty = false;      // มีข้อมูลใหม่ใน outbox ที่ยังไม่ได้ลองส่ง
+    bool closing = false;    // จะถูกปิดหลังประมวลผลรอบนี้เสร็จ
+
+    // ข้อความที่ใช้บัฟเฟอร์ร่วมกับผู้ชมคนอื่น (ส่งต่อจาก outbox) - เก็บแค่ pointer ไม่คัดลอกข้อมูล
+    std::deque<std::shared_ptr<const std::string>> shared_out;
+    size_t shared_offset = 0; // ไบต์ที่ส่งไปแล้วของข้อความแรกใน shared_out
+    size_t shared_bytes = 0;  // จำนวนไบต์ใน shared_out ที่ยังไม่ได้ส่ง
+  };
+
+  // ตัวบันทึกของแมตช์ 1 แมตช์ (replay และ/หรือสถิติ) - แมตช์เห็นเป็นตัวบันทึกตัวเดียวผ่าน group
+  struct MatchRecording
+  {
+    ReplayWriter replay;
+    bool has_replay = false;
+    std::optional<GameStatsRecorder> stats;
+    MatchRecorderGroup group;
+  };
+
+  EventLoop loop;
+  int listen_fd;
+  std::unordered_map<int, Connection> connections; // fd -> การเชื่อมต่อ
+  int waiting_fd;                                  // ไคลเอนต์ที่รอคู่แข่งอยู่ (-1 = ไม่มี)
+  int next_first_seat;                             // สลับฝ่ายที่เริ่มก่อนในแต่ละแมตช์
+  MatchId latest_match;                            // แมตช์ล่าสุดที่เริ่ม (ใช้เมื่อผู้ชมขอชมแมตช์ 0)
+
+  MatchScheduler scheduler;
+  std::unordered_map<MatchId, std::unique_ptr<NetworkMatchView>> views;    // ตัวส่งเหตุการณ์ของแต่ละแมตช์
+  std::unordered_map<MatchId, std::unique_ptr<MatchRecording>> recordings; // ตัวบันทึกของแต่ละแมตช์
+
+  std::vector<Card> catalog;    // แคตตาล็อกการ์ดที่ใช้สร้างเด็ค
+  CardIndex card_index;         // รหัสการ์ด -> ดัชนีในแคตตาล็อก
+  std::string welcome_message;  // ข้อความ Welcome ที่เข้ารหัสไว้ล่วงหน้า
+  uint64_t catalog_checksum;    // ใส่ในส่วนหัวของ replay
+  std::mt19937_64 seed_source;  // seed สำหรับสับสำรับของแต่ละแมตช์ (บันทึกใน replay)
+  std::string replay_prefix;    // ต้นชื่อไฟล์ replay (ว่าง = ไม่บันทึก)
+  GameStatsWriter stats_writer; // ไฟล์สถิติที่ทุกแมตช์เขียนร่วมกัน (ไม่ได้เปิด = ไม่บันทึก)
+  std::string metrics_path;     // ไฟล์ Prometheus ที่เขียนทับเป็นระยะ (ว่าง = ไม่เขียน)
+  std::chrono::seconds metrics_interval;
+  std::chrono::steady_clock::time_point metrics_written;
+
+  std::vector<int> dirty_fds;   // การเชื่อมต่อที่มีข้อมูลรอส่ง
+  std::vector<int> closing_fds; // การเชื่อมต่อที่ต้องปิดหลังจบรอบ
+  std::string scratch;          // บัฟเฟอร์สำหรับเข้ารหัสข้อความก่อนคัดลอกให้ผู้รับ
+
+  NullSink null_sink; // ปิดข้อความที่เกมพิมพ์ระหว่างเดินเกม (เว้นแต่เปิด verbose)
+  bool verbose;
+  ServerStats stats;
+
+  // --- การรับส่งข้อมูล ---
+  void acceptPending();
+  void handleReadable(Connection &connection);
+  bool handleMessage(Connection &connection, const Frame &frame);
+  void send(int fd, const std::string &message); // ต่อข้อความท้าย outbox ของ fd (ถ้ายังเชื่อมต่ออยู่)
+  void sendShared(int fd, const std::shared_ptr<const std::string> &message);
+  bool markForWrite(Connection &connection); // คืนค่า false ถ้าข้อมูลค้างส่งเกินขนาดที่รับได้
+  void sendError(Connection &connection, const std::string &message);
+  void flushDirty();
+  void closePending();
+  void disconnect(int fd);
+
+  // --- การจัดการแมตช์ ---
+  void pairPlayers(int first_fd, int second_fd);
+  void startSpectating(Connection &connection, MatchId id);
+  void sendState(int fd, Match &match, int seat);
+  void onMatchUpdate(MatchId id, int player_idx, Match &match, bool accepted);
+  void endMatch(MatchId id);
+  uint8_t cardIndexOf(const Card &card) const;
+
+public:
+  MatchServer(std::vector<Card> card_catalog, bool verbose_output = false);
+  ~MatchServer();
+  MatchServer(const MatchServer &) = delete;
+  MatchServer &operator=(const MatchServer &) = delete;
+
+  bool listen(const Endpoint &endpoint);
+
+  // บันทึก replay ของทุกแมตช์ลงโฟลเดอร์ที่กำหนด (ชื่อไฟล์ match_<เวลาเริ่มเซิร์ฟเวอร์>_<หมายเลขแมตช์>.fibr)
+  void setReplayDirectory(const std::string &directory);
+
+  // บันทึกสถิติรายเกม/รายเทิร์นของทุกแมตช์ลงไฟล์เดียว - คืนค่า false ถ้าเปิดไฟล์ไม่ได้
+  bool setStatsFile(const std::string &path);
+  void closeStatsFile(); // เขียนแถวที่ค้างอยู่แล้วปิดไฟล์ (แมตช์ที่ยังไม่จบจะมีแค่แถวของเทิร์นที่เล่นไปแล้ว)
+
+  // เขียน metric ของเกมทั้งหมด (รวมเวลาตัดสินใจของผู้เล่นผ่านเครือข่าย) เป็นไฟล์ Prometheus ทุก interval วินาที
+  // และอีกครั้งเมื่อ run() จบ
+  void setMetricsFile(const std::string &path, int interval_seconds);
+
+  // วนรอบรับ/ส่งข้อมูลและเดินเกมจนกว่า stop_requested จะเป็น true
+  void run(const std::atomic<bool> &stop_requested);
+
+  size_t getConnectionCount() const { return connections.size(); }
+  size_t getMatchCount() const { return scheduler.getMatchCount(); }
+  const ServerStats &getStats() const { return stats; }
+};
+
+#endif // MATCHSERVER_H
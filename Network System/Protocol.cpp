@@ -0,0 +1,541 @@
+// Protocol.cpp - ไฟล์ Source สำหรับเข้ารหัส/ถอดรหัสข้อความของโปรโตคอลไบนารี
+#include "Protocol.h"
+#include <cstring>
+#include <algorithm>
+
+// --- MessageWriter ---
+MessageWriter::MessageWriter(std::string &destination, MessageType type)
+    : out(destination), frame_start(destination.size())
+{
+  out.append(2, '\0'); // จองที่สำหรับความยาว
+  out.push_back(static_cast<char>(type));
+}
+
+MessageWriter::~MessageWriter()
+{
+  size_t length = out.size() - frame_start - 2;
+  out[frame_start] = static_cast<char>(length & 0xFF);
+  out[frame_start + 1] = static_cast<char>((length >> 8) & 0xFF);
+}
+
+MessageWriter &MessageWriter::u8(uint8_t value)
+{
+  out.push_back(static_cast<char>(value));
+  return *this;
+}
+
+MessageWriter &MessageWriter::i8(int8_t value)
+{
+  return u8(static_cast<uint8_t>(value));
+}
+
+MessageWriter &MessageWriter::u16(uint16_t value)
+{
+  u8(static_cast<uint8_t>(value & 0xFF));
+  return u8(static_cast<uint8_t>(value >> 8));
+}
+
+MessageWriter &MessageWriter::u32(uint32_t value)
+{
+  u16(static_cast<uint16_t>(value & 0xFFFF));
+  return u16(static_cast<uint16_t>(value >> 16));
+}
+
+MessageWriter &MessageWriter::u64(uint64_t value)
+{
+  u32(static_cast<uint32_t>(value & 0xFFFFFFFFu));
+  return u32(static_cast<uint32_t>(value >> 32));
+}
+
+MessageWriter &MessageWriter::str(std::string_view value)
+{
+  size_t length = value.size() < 255 ? value.size() : 255;
+  u8(static_cast<uint8_t>(length));
+  out.append(value.data(), length);
+  return *this;
+}
+
+// --- MessageReader ---
+MessageReader::MessageReader(const char *payload, size_t payload_size)
+    : data(reinterpret_cast<const uint8_t *>(payload)), size(payload_size), position(0), valid(true)
+{
+}
+
+bool MessageReader::take(size_t count)
+{
+  if (!valid || size - position < count)
+  {
+    valid = false;
+    return false;
+  }
+  return true;
+}
+
+uint8_t MessageReader::u8()
+{
+  if (!take(1))
+    return 0;
+  return data[position++];
+}
+
+int8_t MessageReader::i8()
+{
+  return static_cast<int8_t>(u8());
+}
+
+uint16_t MessageReader::u16()
+{
+  if (!take(2))
+    return 0;
+  uint16_t value = static_cast<uint16_t>(data[position] | (data[position + 1] << 8));
+  position += 2;
+  return value;
+}
+
+uint32_t MessageReader::u32()
+{
+  uint32_t low = u16();
+  uint32_t high = u16();
+  return low | (high << 16);
+}
+
+uint64_t MessageReader::u64()
+{
+  uint64_t low = u32();
+  uint64_t high = u32();
+  return low | (high << 32);
+}
+
+std::string MessageReader::str()
+{
+  size_t length = u8();
+  if (!take(length))
+    return std::string();
+  std::string value(reinterpret_cast<const char *>(data + position), length);
+  position += length;
+  return value;
+}
+
+// --- Framing ---
+int extractFrame(const std::string &buffer, size_t &offset, Frame &frame)
+{
+  if (buffer.size() - offset < 2)
+  {
+    return 0;
+  }
+  size_t length = static_cast<uint8_t>(buffer[offset]) | (static_cast<uint8_t>(buffer[offset + 1]) << 8);
+  if (length == 0)
+  {
+    return -1; // ทุกข้อความต้องมีไบต์ชนิดอย่างน้อย 1 ไบต์
+  }
+  if (buffer.size() - offset - 2 < length)
+  {
+    return 0;
+  }
+  frame.type = static_cast<MessageType>(buffer[offset + 2]);
+  frame.payload = buffer.data() + offset + 3;
+  frame.payload_size = length - 1;
+  offset += 2 + length;
+  return 1;
+}
+
+// --- แคตตาล็อกและมุมมองสถานะ ---
+CardIndex makeCardIndex(const std::vector<Card> &catalog)
+{
+  CardIndex card_index;
+  for (size_t i = 0; i < catalog.size() && i < NO_CARD; ++i)
+  {
+    card_index.emplace(catalog[i].getCodeName(), static_cast<uint8_t>(i));
+  }
+  return card_index;
+}
+
+std::vector<CardInfo> describeCatalog(const std::vector<Card> &catalog)
+{
+  std::vector<CardInfo> infos;
+  for (const Card &card : catalog)
+  {
+    infos.push_back({card.getCodeName(), card.getName(), card.getGrade(), card.getPower(), card.getShield(),
+                     card.getCritical()});
+  }
+  return infos;
+}
+
+static uint8_t cardIndexOf(const CardIndex &card_index, const Card &card)
+{
+  auto it = card_index.find(card.getCodeName());
+  return it != card_index.end() ? it->second : NO_CARD;
+}
+
+StateView makeStateView(const Match &match, int seat, const CardIndex &card_index)
+{
+  StateView view;
+  view.decision = match.getPendingDecision();
+  int acting = match.getActingPlayerIndex();
+  view.acting_seat = acting < 0 ? NO_SEAT : static_cast<uint8_t>(acting);
+  view.current_seat = static_cast<uint8_t>(match.getCurrentPlayerIndex());
+  view.turn = static_cast<uint16_t>(match.getTurnCount());
+  view.attack = match.getAttack();
+
+  for (int i = 0; i < 2; ++i)
+  {
+    const Player &player = match.getPlayer(i);
+    SeatView &out = view.seats[i];
+    if (player.getVanguard())
+    {
+      out.vanguard = cardIndexOf(card_index, *player.getVanguard());
+    }
+    const auto rear_guards = player.getRearGuards();
+    for (size_t rc = 0; rc < NUM_REAR_GUARD_CIRCLES; ++rc)
+    {
+      if (rear_guards[rc])
+      {
+        out.rear_guards[rc] = cardIndexOf(card_index, *rear_guards[rc]);
+      }
+    }
+    for (int unit = 0; unit < NUM_FIELD_UNITS; ++unit)
+    {
+      if (player.isUnitStanding(unit))
+      {
+        out.standing_bits |= static_cast<uint8_t>(1u << unit);
+      }
+    }
+    out.damage = static_cast<uint8_t>(player.getDamageCount());
+    out.soul = static_cast<uint8_t>(std::min<size_t>(player.getSoulCount(), 0xFF));
+    out.drop = static_cast<uint8_t>(std::min<size_t>(player.getDropZoneCount(), 0xFF));
+    out.deck = static_cast<uint8_t>(std::min<size_t>(player.getDeck().getSize(), 0xFF));
+    out.hand_count = static_cast<uint8_t>(std::min<size_t>(player.getHandSize(), 0xFF));
+    if (i == seat)
+    {
+      for (const Card &card : player.getHand())
+      {
+        out.hand.push_back(cardIndexOf(card_index, card));
+      }
+    }
+  }
+  return view;
+}
+
+// --- Welcome ---
+void writeWelcome(std::string &out, const std::vector<Card> &catalog)
+{
+  MessageWriter writer(out, MessageType::Welcome);
+  writer.u8(PROTOCOL_VERSION).u8(static_cast<uint8_t>(catalog.size()));
+  for (const Card &card : catalog)
+  {
+    writer.str(card.getCodeName())
+        .str(card.getName())
+        .u8(static_cast<uint8_t>(card.getGrade()))
+        .u32(static_cast<uint32_t>(card.getPower()))
+        .u32(static_cast<uint32_t>(card.getShield()))
+        .u8(static_cast<uint8_t>(card.getCritical()));
+  }
+}
+
+bool readWelcome(MessageReader &reader, std::vector<CardInfo> &catalog)
+{
+  if (reader.u8() != PROTOCOL_VERSION)
+  {
+    return false;
+  }
+  catalog.resize(reader.u8());
+  for (CardInfo &card : catalog)
+  {
+    card.code_name = reader.str();
+    card.name = reader.str();
+    card.grade = reader.u8();
+    card.power = static_cast<int>(reader.u32());
+    card.shield = static_cast<int>(reader.u32());
+    card.critical = reader.u8();
+  }
+  return reader.ok();
+}
+
+// --- GameAction ---
+void writeAction(std::string &out, const GameAction &action)
+{
+  MessageWriter(out, MessageType::Action)
+      .u8(static_cast<uint8_t>(action.type))
+      .i8(action.source)
+      .i8(action.target)
+      .i8(action.booster);
+}
+
+bool readAction(MessageReader &reader, GameAction &action)
+{
+  uint8_t type = reader.u8();
+  action.source = reader.i8();
+  action.target = reader.i8();
+  action.booster = reader.i8();
+  if (!reader.ok() || type > static_cast<uint8_t>(ActionType::EndGuard))
+  {
+    return false;
+  }
+  action.type = static_cast<ActionType>(type);
+  return true;
+}
+
+// --- StateView ---
+static void writeSeatView(MessageWriter &writer, const SeatView &seat)
+{
+  writer.u8(seat.vanguard);
+  for (uint8_t rc : seat.rear_guards)
+  {
+    writer.u8(rc);
+  }
+  writer.u8(seat.standing_bits).u8(seat.damage).u8(seat.soul).u8(seat.drop).u8(seat.deck).u8(seat.hand_count);
+  writer.u8(static_cast<uint8_t>(seat.hand.size()));
+  for (uint8_t card : seat.hand)
+  {
+    writer.u8(card);
+  }
+}
+
+static void readSeatView(MessageReader &reader, SeatView &seat)
+{
+  seat.vanguard = reader.u8();
+  for (uint8_t &rc : seat.rear_guards)
+  {
+    rc = reader.u8();
+  }
+  seat.standing_bits = reader.u8();
+  seat.damage = reader.u8();
+  seat.soul = reader.u8();
+  seat.drop = reader.u8();
+  seat.deck = reader.u8();
+  seat.hand_count = reader.u8();
+  seat.hand.resize(reader.u8());
+  for (uint8_t &card : seat.hand)
+  {
+    card = reader.u8();
+  }
+}
+
+static void writeAttack(MessageWriter &writer, const AttackState &attack)
+{
+  writer.i8(static_cast<int8_t>(attack.attacker_idx))
+      .i8(static_cast<int8_t>(attack.target_idx))
+      .i8(static_cast<int8_t>(attack.booster_idx))
+      .u32(static_cast<uint32_t>(attack.power))
+      .u8(static_cast<uint8_t>(attack.critical));
+}
+
+static void readAttack(MessageReader &reader, AttackState &attack)
+{
+  attack.attacker_idx = reader.i8();
+  attack.target_idx = reader.i8();
+  attack.booster_idx = reader.i8();
+  attack.power = static_cast<int>(reader.u32());
+  attack.critical = reader.u8();
+}
+
+// ส่วนหัวของสถานะ: การตัดสินใจที่รอ ที่นั่งที่ต้องตัดสินใจ เจ้าของเทิร์น และเลขเทิร์น
+static void writePhase(MessageWriter &writer, const StateView &view)
+{
+  writer.u8(static_cast<uint8_t>(view.decision)).u8(view.acting_seat).u8(view.current_seat).u16(view.turn);
+}
+
+static bool readPhase(MessageReader &reader, StateView &view)
+{
+  uint8_t decision = reader.u8();
+  if (decision > static_cast<uint8_t>(DecisionType::Guard))
+  {
+    return false;
+  }
+  view.decision = static_cast<DecisionType>(decision);
+  view.acting_seat = reader.u8();
+  view.current_seat = reader.u8();
+  view.turn = reader.u16();
+  return true;
+}
+
+static void writeStateBody(MessageWriter &writer, const StateView &view)
+{
+  writePhase(writer, view);
+  writeSeatView(writer, view.seats[0]);
+  writeSeatView(writer, view.seats[1]);
+  if (view.decision == DecisionType::Guard)
+  {
+    writeAttack(writer, view.attack);
+  }
+}
+
+static bool readStateBody(MessageReader &reader, StateView &view)
+{
+  if (!readPhase(reader, view))
+  {
+    return false;
+  }
+  readSeatView(reader, view.seats[0]);
+  readSeatView(reader, view.seats[1]);
+  view.attack = AttackState();
+  if (view.decision == DecisionType::Guard)
+  {
+    readAttack(reader, view.attack);
+  }
+  return reader.ok();
+}
+
+void writeStateView(std::string &out, const StateView &view)
+{
+  MessageWriter writer(out, MessageType::State);
+  writeStateBody(writer, view);
+}
+
+bool readStateView(MessageReader &reader, StateView &view)
+{
+  return readStateBody(reader, view);
+}
+
+// --- ช่องทางผู้ชม ---
+void writeKeyframe(std::string &out, uint32_t match_id, const std::string &name0, const std::string &name1,
+                   const StateView &view)
+{
+  MessageWriter writer(out, MessageType::Keyframe);
+  writer.u32(match_id).str(name0).str(name1);
+  writeStateBody(writer, view);
+}
+
+bool readKeyframe(MessageReader &reader, uint32_t &match_id, std::string names[2], StateView &view)
+{
+  match_id = reader.u32();
+  names[0] = reader.str();
+  names[1] = reader.str();
+  return readStateBody(reader, view);
+}
+
+static bool sameAttack(const AttackState &a, const AttackState &b)
+{
+  return a.attacker_idx == b.attacker_idx && a.target_idx == b.target_idx && a.booster_idx == b.booster_idx &&
+         a.power == b.power && a.critical == b.critical;
+}
+
+bool writeDelta(std::string &out, const StateView &before, const StateView &after)
+{
+  size_t message_start = out.size();
+  size_t count_position;
+  uint8_t count = 0;
+  {
+    MessageWriter writer(out, MessageType::Delta);
+    count_position = out.size();
+    writer.u8(0); // จำนวน op (เขียนทับภายหลัง)
+
+    if (before.decision != after.decision || before.acting_seat != after.acting_seat ||
+        before.current_seat != after.current_seat || before.turn != after.turn ||
+        (after.decision == DecisionType::Guard && !sameAttack(before.attack, after.attack)))
+    {
+      writer.u8(static_cast<uint8_t>(DeltaOp::Phase));
+      writePhase(writer, after);
+      if (after.decision == DecisionType::Guard)
+      {
+        writeAttack(writer, after.attack);
+      }
+      count++;
+    }
+
+    for (uint8_t seat = 0; seat < 2; ++seat)
+    {
+      const SeatView &old_seat = before.seats[seat];
+      const SeatView &new_seat = after.seats[seat];
+
+      // การ์ดที่ย้ายเข้า/ออกจาก Vanguard Circle และ Rear-guard Circle
+      for (uint8_t unit = 0; unit < NUM_FIELD_UNITS; ++unit)
+      {
+        uint8_t old_card = unit == 0 ? old_seat.vanguard : old_seat.rear_guards[unit - 1];
+        uint8_t new_card = unit == 0 ? new_seat.vanguard : new_seat.rear_guards[unit - 1];
+        if (old_card != new_card)
+        {
+          writer.u8(static_cast<uint8_t>(DeltaOp::Place)).u8(seat).u8(unit).u8(new_card);
+          count++;
+        }
+      }
+
+      uint8_t flipped = old_seat.standing_bits ^ new_seat.standing_bits;
+      if (flipped != 0)
+      {
+        writer.u8(static_cast<uint8_t>(DeltaOp::Flip)).u8(seat).u8(flipped);
+        count++;
+      }
+
+      // ตัวนับเรียงตามลำดับของ DeltaCounter
+      const uint8_t old_counters[] = {old_seat.damage, old_seat.soul, old_seat.drop, old_seat.deck, old_seat.hand_count};
+      const uint8_t new_counters[] = {new_seat.damage, new_seat.soul, new_seat.drop, new_seat.deck, new_seat.hand_count};
+      for (uint8_t counter = 0; counter < 5; ++counter)
+      {
+        if (old_counters[counter] != new_counters[counter])
+        {
+          writer.u8(static_cast<uint8_t>(DeltaOp::Counter)).u8(seat).u8(counter).u8(new_counters[counter]);
+          count++;
+        }
+      }
+    }
+  }
+
+  if (count == 0)
+  {
+    out.resize(message_start);
+    return false;
+  }
+  out[count_position] = static_cast<char>(count);
+  return true;
+}
+
+bool applyDelta(MessageReader &reader, StateView &view)
+{
+  uint8_t count = reader.u8();
+  for (uint8_t i = 0; i < count && reader.ok(); ++i)
+  {
+    DeltaOp op = static_cast<DeltaOp>(reader.u8());
+    if (op == DeltaOp::Phase)
+    {
+      if (!readPhase(reader, view))
+      {
+        return false;
+      }
+      view.attack = AttackState();
+      if (view.decision == DecisionType::Guard)
+      {
+        readAttack(reader, view.attack);
+      }
+      continue;
+    }
+
+    uint8_t seat_index = reader.u8();
+    if (seat_index > 1)
+    {
+      return false;
+    }
+    SeatView &seat = view.seats[seat_index];
+    switch (op)
+    {
+    case DeltaOp::Place:
+    {
+      uint8_t unit = reader.u8();
+      uint8_t card = reader.u8();
+      if (unit == 0)
+        seat.vanguard = card;
+      else if (unit <= NUM_REAR_GUARD_CIRCLES)
+        seat.rear_guards[unit - 1] = card;
+      else
+        return false;
+      break;
+    }
+    case DeltaOp::Flip:
+      seat.standing_bits ^= reader.u8();
+      break;
+    case DeltaOp::Counter:
+    {
+      uint8_t counter = reader.u8();
+      uint8_t value = reader.u8();
+      uint8_t *counters[] = {&seat.damage, &seat.soul, &seat.drop, &seat.deck, &seat.hand_count};
+      if (counter >= 5)
+        return false;
+      *counters[counter] = value;
+      break;
+    }
+    default:
+      return false;
+    }
+  }
+  return reader.ok();
+}
@@ -0,0 +1,198 @@
+// Protocol.h - ไฟล์ Header สำหรับโปรโตคอลไบนารีระหว่าง fibo_server และ fibo_client (รวมถึง fibo_client 2 ตัวในโหมด lockstep)
+// ทุกข้อความอยู่ในรูป [ความยาว u16][ชนิด u8][ข้อมูล] โดยความยาวนับรวมไบต์ชนิดข้อความ
+// ตัวเลขหลายไบต์เป็น little-endian การ์ดส่งเป็นดัชนี 1 ไบต์ในแคตตาล็อกที่ส่งมาตอน Welcome
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "../Game Core/Match.h"
+#include "../Game Core/Card.h"
+
+constexpr uint8_t PROTOCOL_VERSION = 1;
+constexpr size_t MAX_MESSAGE_SIZE = 0xFFFF; // ขนาดข้อมูลสูงสุดของ 1 ข้อความ (รวมไบต์ชนิด)
+constexpr uint8_t NO_CARD = 0xFF;           // ช่องว่าง / ไม่มีการ์ด
+constexpr uint8_t NO_SEAT = 0xFF;           // ไม่มีผู้เล่นที่ต้องตัดสินใจ
+
+// ชนิดข้อความ
+enum class MessageType : uint8_t
+{
+  // client -> server
+  Hello = 1,    // u8 version, str name
+  Action = 2,   // u8 action type, i8 source, i8 target, i8 booster
+  Spectate = 3, // u32 match id (0 = แมตช์ล่าสุดที่เริ่ม)
+
+  // peer <-> peer (โหมด lockstep ไม่ผ่านเซิร์ฟเวอร์ การกระทำใช้ข้อความ Action เดียวกับด้านบน)
+  PeerHello = 4, // u8 version, u64 checksum ของแคตตาล็อกการ์ด, str name
+  PeerStart = 5, // u64 seed ของแมตช์, u8 ที่นั่งที่เริ่มก่อน - ฝ่ายที่เปิดรับการเชื่อมต่อ (ที่นั่ง 0) เป็นผู้ส่ง
+  Checksum = 6,  // u16 เทิร์น, u64 checksum ของสถานะหลังจบ End Phase (หรือตอนจบเกม)
+
+  // server -> client
+  Welcome = 16,    // u8 version, แคตตาล็อกการ์ด (ดู CardInfo) - ดัชนีการ์ดในข้อความอื่นอ้างอิงลำดับนี้
+  MatchStart = 17, // u32 match id, u8 ที่นั่งของเรา, u8 ที่นั่งที่เริ่มก่อน, str ชื่อคู่แข่ง
+  State = 18,      // สถานะที่ผู้เล่นคนนี้มองเห็น (ดู StateView)
+  Rejected = 19,   // การกระทำล่าสุดไม่ถูกต้อง สถานะเกมไม่เปลี่ยน
+  Event = 20,      // u8 EventType ตามด้วยข้อมูลของเหตุการณ์
+  GameOver = 21,   // u8 MatchEnd, u8 ที่นั่งผู้ชนะ (NO_SEAT = ไม่มี), u16 จำนวนเทิร์น
+  Error = 22,      // str ข้อความ - เซิร์ฟเวอร์จะปิดการเชื่อมต่อหลังส่ง
+  Keyframe = 23,   // u32 match id, str ชื่อที่นั่ง 0, str ชื่อที่นั่ง 1, สถานะสาธารณะ (StateView ไม่มีการ์ดบนมือ)
+  Delta = 24       // u8 จำนวน op ตามด้วย DeltaOp แต่ละตัว - ใช้กับสถานะจาก Keyframe ล่าสุดตามลำดับ
+};
+
+// เหตุการณ์ระหว่างเกม (ข้อความ Event)
+enum class EventType : uint8_t
+{
+  TurnStart = 1,    // u8 ที่นั่ง, u16 เทิร์น
+  Attack = 2,       // u8 ที่นั่งผู้โจมตี, i8 attacker, i8 target, i8 booster, u32 power, u8 critical
+  BattleResult = 3, // u32 พลังป้องกันรวม, u8 โจมตีเข้าหรือไม่
+  DamageCard = 4,   // u8 ที่นั่ง, u8 การ์ดที่เปิดได้
+  TurnEnd = 5       // u8 ที่นั่ง
+};
+
+// การเปลี่ยนแปลงของสถานะสาธารณะหลังการกระทำ 1 ครั้ง (ข้อความ Delta สำหรับผู้ชม)
+enum class DeltaOp : uint8_t
+{
+  Phase = 1,  // u8 decision, u8 acting seat, u8 current seat, u16 turn (+ ข้อมูลการโจมตีเมื่อ decision == Guard)
+  Place = 2,  // u8 ที่นั่ง, u8 ดัชนีสถานะ (0 = VC, 1-5 = RC), u8 การ์ด (NO_CARD = ช่องว่าง)
+  Flip = 3,   // u8 ที่นั่ง, u8 บิตที่สลับ Stand/Rest (XOR กับ standing_bits)
+  Counter = 4 // u8 ที่นั่ง, u8 DeltaCounter, u8 ค่าใหม่
+};
+
+// ตัวนับที่ส่งใน DeltaOp::Counter
+enum class DeltaCounter : uint8_t
+{
+  Damage = 0,
+  Soul = 1,
+  Drop = 2,
+  Deck = 3,
+  Hand = 4
+};
+
+// ข้อมูลการ์ด 1 ใบในแคตตาล็อกที่ส่งมากับ Welcome (ไคลเอนต์ไม่ต้องมี cards.json)
+struct CardInfo
+{
+  std::string code_name;
+  std::string name;
+  int grade = 0;
+  int power = 0;
+  int shield = 0;
+  int critical = 1;
+};
+
+// ข้อมูลสนามของผู้เล่น 1 ฝ่าย
+struct SeatView
+{
+  uint8_t vanguard = NO_CARD;
+  uint8_t rear_guards[NUM_REAR_GUARD_CIRCLES] = {NO_CARD, NO_CARD, NO_CARD, NO_CARD, NO_CARD};
+  uint8_t standing_bits = 0; // บิตที่ i = ยูนิตดัชนีสถานะ i ยืนอยู่
+  uint8_t damage = 0;
+  uint8_t soul = 0;
+  uint8_t drop = 0;
+  uint8_t deck = 0;
+  uint8_t hand_count = 0;
+  std::vector<uint8_t> hand; // เฉพาะของตัวเอง (ของคู่แข่งจะว่าง)
+
+  bool isStanding(int unit_status_idx) const { return (standing_bits >> unit_status_idx) & 1; }
+};
+
+// สถานะเกมจากมุมมองของผู้เล่น 1 คน (ข้อความ State)
+struct StateView
+{
+  DecisionType decision = DecisionType::None;
+  uint8_t acting_seat = NO_SEAT;
+  uint8_t current_seat = 0;
+  uint16_t turn = 0;
+  SeatView seats[2];
+  AttackState attack; // มีความหมายเมื่อ decision == Guard
+};
+
+// สร้างข้อความ 1 ข้อความต่อท้ายบัฟเฟอร์ปลายทาง
+class MessageWriter
+{
+private:
+  std::string &out;   // บัฟเฟอร์ปลายทาง (ข้อความถูกต่อท้าย)
+  size_t frame_start; // ตำแหน่งเริ่มต้นของข้อความนี้
+
+public:
+  MessageWriter(std::string &destination, MessageType type);
+  ~MessageWriter(); // เขียนความยาวจริงลงส่วนหัวของข้อความ
+
+  MessageWriter(const MessageWriter &) = delete;
+  MessageWriter &operator=(const MessageWriter &) = delete;
+
+  MessageWriter &u8(uint8_t value);
+  MessageWriter &i8(int8_t value);
+  MessageWriter &u16(uint16_t value);
+  MessageWriter &u32(uint32_t value);
+  MessageWriter &u64(uint64_t value);
+  MessageWriter &str(std::string_view value); // u8 ความยาว + ข้อความ (ตัดที่ 255 ไบต์)
+};
+
+// อ่านข้อมูลจากข้อความ 1 ข้อความ - ถ้าอ่านเกินขนาด ok() จะเป็น false และค่าที่อ่านได้เป็น 0
+class MessageReader
+{
+private:
+  const uint8_t *data;
+  size_t size;
+  size_t position;
+  bool valid;
+
+  bool take(size_t count);
+
+public:
+  MessageReader(const char *payload, size_t payload_size);
+
+  bool ok() const { return valid; }
+  bool atEnd() const { return position == size; }
+
+  uint8_t u8();
+  int8_t i8();
+  uint16_t u16();
+  uint32_t u32();
+  uint64_t u64();
+  std::string str();
+};
+
+// ข้อความที่แยกออกมาจากสตรีม (payload ชี้เข้าไปในบัฟเฟอร์รับ ใช้ได้จนกว่าบัฟเฟอร์จะถูกแก้ไข)
+struct Frame
+{
+  MessageType type;
+  const char *payload;
+  size_t payload_size;
+};
+
+// แยกข้อความถัดไปจาก buffer เริ่มที่ offset
+// คืนค่า 1 = ได้ข้อความ (offset เลื่อนไปข้อความถัดไป), 0 = ข้อมูลยังไม่ครบ, -1 = ข้อความเสีย
+int extractFrame(const std::string &buffer, size_t &offset, Frame &frame);
+
+// รหัสการ์ด -> ดัชนีในแคตตาล็อก (ดัชนีที่ใช้ส่งการ์ดเป็น 1 ไบต์)
+using CardIndex = std::unordered_map<std::string, uint8_t>;
+
+CardIndex makeCardIndex(const std::vector<Card> &catalog);
+std::vector<CardInfo> describeCatalog(const std::vector<Card> &catalog); // แคตตาล็อกแบบเดียวกับที่ได้จาก Welcome
+
+// สร้างสถานะเกมจากมุมมองของที่นั่ง seat (เห็นการ์ดบนมือเฉพาะของตัวเอง, seat = -1 คือมุมมองของผู้ชม)
+StateView makeStateView(const Match &match, int seat, const CardIndex &card_index);
+
+// เข้ารหัส / ถอดรหัสข้อมูลที่ใช้ร่วมกันระหว่างเซิร์ฟเวอร์และไคลเอนต์
+void writeWelcome(std::string &out, const std::vector<Card> &catalog);
+bool readWelcome(MessageReader &reader, std::vector<CardInfo> &catalog);
+void writeAction(std::string &out, const GameAction &action);
+bool readAction(MessageReader &reader, GameAction &action);
+void writeStateView(std::string &out, const StateView &view);
+bool readStateView(MessageReader &reader, StateView &view);
+
+// ช่องทางผู้ชม: Keyframe 1 ครั้งตอนเริ่มชม แล้วตามด้วย Delta หลังทุกการกระทำ
+void writeKeyframe(std::string &out, uint32_t match_id, const std::string &name0, const std::string &name1,
+                   const StateView &view);
+bool readKeyframe(MessageReader &reader, uint32_t &match_id, std::string names[2], StateView &view);
+
+// เขียนข้อความ Delta จาก before ไป after (เปรียบเทียบเฉพาะข้อมูลสาธารณะ)
+// คืนค่า false และไม่เขียนอะไรเลยถ้าไม่มีอะไรเปลี่ยน
+bool writeDelta(std::string &out, const StateView &before, const StateView &after);
+bool applyDelta(MessageReader &reader, StateView &view);
+
+#endif // PROTOCOL_H
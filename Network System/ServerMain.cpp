@@ -0,0 +1,174 @@
+// ServerMain.cpp - โปรแกรมเซิร์ฟเวอร์ fibo_server
+// รับไคลเอนต์ผ่าน TCP หรือ Unix-domain socket จับคู่ทีละ 2 คน แล้วเดินเกมทุกแมตช์บนเธรดเดียว
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <csignal>
+#include <cctype>
+#include <cstdint>
+#include <climits>
+#include "MatchServer.h"
+#include "../Game Core/CardDatabase.h"
+#include "../UI System/UIHelper.h"
+
+using namespace std;
+
+static atomic<bool> stop_requested(false);
+
+static void handleStopSignal(int)
+{
+  stop_requested.store(true);
+}
+
+// แปลงค่าตัวเลขของตัวเลือก (ต้องเป็นเลขฐานสิบไม่ติดลบทั้งข้อความ และอยู่ในช่วง min_value..max_value)
+static bool parseNumber(const string &text, uint64_t min_value, uint64_t max_value, uint64_t &value)
+{
+  if (text.empty() || !isdigit(static_cast<unsigned char>(text[0])))
+  {
+    return false;
+  }
+  try
+  {
+    size_t used = 0;
+    value = stoull(text, &used);
+    return used == text.size() && value >= min_value && value <= max_value;
+  }
+  catch (const exception &) // invalid_argument / out_of_range
+  {
+    return false;
+  }
+}
+
+// ตัวเลือก:
+//   --host <ip>       ที่อยู่สำหรับเปิดรับการเชื่อมต่อ (ค่าเริ่มต้น 127.0.0.1)
+//   --port <n>        พอร์ต TCP (ค่าเริ่มต้น 7777)
+//   --unix <path>     ใช้ Unix-domain socket แทน TCP
+//   --cards <file>    ไฟล์ข้อมูลการ์ด (ค่าเริ่มต้น cards.json)
+//   --replay-dir <d>  บันทึก replay ของทุกแมตช์ลงโฟลเดอร์ที่กำหนด
+//   --stats <file>    บันทึกสถิติรายเกม/รายเทิร์นของทุกแมตช์ลงไฟล์คอลัมน์ (แปลงเป็น CSV ด้วย fibo_stats_csv)
+//   --metrics <file>  เขียนตัวนับและฮิสโตแกรมของเกมเป็นไฟล์ Prometheus ทุก 10 วินาที (textfile collector)
+//   --metrics-interval <sec>  ระยะเวลาระหว่างการเขียนไฟล์ metric
+//   --verbose         แสดงข้อความของเกมทุกแมตช์ (ใช้ดีบั๊ก)
+int main(int argc, char *argv[])
+{
+#ifdef _WIN32
+  (void)argc;
+  cerr << argv[0] << ": ยังไม่รองรับ Windows" << endl;
+  return 1;
+#else
+  Endpoint endpoint;
+  string cards_path = "cards.json";
+  string replay_dir;
+  string stats_path;
+  string metrics_path;
+  int metrics_interval = 10;
+  bool verbose = false;
+  bool valid = true;
+  for (int i = 1; i < argc; ++i)
+  {
+    string arg = argv[i];
+    uint64_t value = 0;
+    if (arg == "--host" && i + 1 < argc)
+    {
+      endpoint.host = argv[++i];
+    }
+    else if (arg == "--port" && i + 1 < argc)
+    {
+      valid = parseNumber(argv[++i], 0, UINT16_MAX, value);
+      endpoint.port = static_cast<uint16_t>(value);
+    }
+    else if (arg == "--unix" && i + 1 < argc)
+    {
+      endpoint.unix_path = argv[++i];
+    }
+    else if (arg == "--cards" && i + 1 < argc)
+    {
+      cards_path = argv[++i];
+    }
+    else if (arg == "--replay-dir" && i + 1 < argc)
+    {
+      replay_dir = argv[++i];
+    }
+    else if (arg == "--stats" && i + 1 < argc)
+    {
+      stats_path = argv[++i];
+    }
+    else if (arg == "--metrics" && i + 1 < argc)
+    {
+      metrics_path = argv[++i];
+    }
+    else if (arg == "--metrics-interval" && i + 1 < argc)
+    {
+      valid = parseNumber(argv[++i], 1, INT_MAX, value);
+      metrics_interval = static_cast<int>(value);
+    }
+    else if (arg == "--verbose")
+    {
+      verbose = true;
+    }
+    else
+    {
+      valid = false;
+    }
+    if (!valid)
+    {
+      cerr << "ตัวเลือกไม่ถูกต้อง: " << arg << (arg != argv[i] ? string(" ") + argv[i] : string()) << "\n"
+           << "วิธีใช้: " << argv[0] << " [--host <ip>] [--port <n>] [--unix <path>] [--cards <file>] [--replay-dir <d>]"
+              " [--stats <file>] [--metrics <file>] [--metrics-interval <sec>] [--verbose]" << endl;
+      return 2;
+    }
+  }
+
+  UIHelper::SetAnimationEnabled(false);
+  vector<Card> catalog = loadCardsFromJson(cards_path);
+  if (catalog.empty())
+  {
+    return 1;
+  }
+
+  signal(SIGPIPE, SIG_IGN);
+  signal(SIGINT, handleStopSignal);
+  signal(SIGTERM, handleStopSignal);
+  raiseOpenFileLimit();
+
+  MatchServer server(move(catalog), verbose);
+  server.setReplayDirectory(replay_dir);
+  if (!stats_path.empty() && !server.setStatsFile(stats_path))
+  {
+    cerr << "เปิดไฟล์สถิติ '" << stats_path << "' ไม่ได้" << endl;
+    return 1;
+  }
+  if (!metrics_path.empty())
+  {
+    server.setMetricsFile(metrics_path, metrics_interval);
+  }
+  if (!server.listen(endpoint))
+  {
+    cerr << "เปิดรับการเชื่อมต่อที่ " << describeEndpoint(endpoint) << " ไม่ได้" << endl;
+    return 1;
+  }
+  cout << "fibo_server พร้อมรับการเชื่อมต่อที่ " << describeEndpoint(endpoint) << " (Ctrl+C เพื่อปิด)" << endl;
+
+  server.run(stop_requested);
+  server.closeStatsFile();
+
+  const ServerStats &stats = server.getStats();
+  cout << "\nปิดเซิร์ฟเวอร์\n"
+       << "  การเชื่อมต่อทั้งหมด: " << stats.connections_accepted << " (พร้อมกันสูงสุด " << stats.peak_connections << ")\n"
+       << "  แมตช์ที่เริ่ม/จบ: " << stats.matches_started << "/" << stats.matches_finished
+       << " (พร้อมกันสูงสุด " << stats.peak_matches << ")\n"
+       << "  การกระทำที่ได้รับ: " << stats.actions_received << " (ถูกปฏิเสธ " << stats.actions_rejected << ")\n"
+       << "  ผู้ชม: " << stats.spectators_joined << " (Delta ที่เข้ารหัส " << stats.deltas_published << " ข้อความ, "
+       << stats.delta_bytes << " ไบต์)\n"
+       << "  replay ที่บันทึก: " << stats.replays_recorded << " ไฟล์ (" << stats.replay_bytes << " ไบต์)\n"
+       << "  สถิติที่บันทึก: " << stats.stats_rows << " แถว (" << stats.stats_bytes << " ไบต์)\n"
+       << "  ข้อมูลรับ/ส่ง: " << stats.bytes_received << "/" << stats.bytes_sent << " ไบต์" << endl;
+  if (!endpoint.unix_path.empty())
+  {
+    remove(endpoint.unix_path.c_str());
+  }
+  return 0;
+#endif
+}
@@ -0,0 +1,326 @@
+// Socket.cpp - ไฟล์ Source สำหรับเครื่องมือ socket แบบ non-blocking และ event loop
+#include "Socket.h"
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // macOS: ใช้ SIGPIPE = SIG_IGN แทน (ตั้งไว้ใน main)
+#endif
+
+// สร้าง address ของปลายทาง คืนค่าความยาวของ address (0 = ผิดพลาด)
+static socklen_t makeAddress(const Endpoint &endpoint, sockaddr_storage &storage)
+{
+  std::memset(&storage, 0, sizeof(storage));
+  if (!endpoint.unix_path.empty())
+  {
+    sockaddr_un *address = reinterpret_cast<sockaddr_un *>(&storage);
+    if (endpoint.unix_path.size() >= sizeof(address->sun_path))
+    {
+      return 0;
+    }
+    address->sun_family = AF_UNIX;
+    std::memcpy(address->sun_path, endpoint.unix_path.c_str(), endpoint.unix_path.size() + 1);
+    return sizeof(sockaddr_un);
+  }
+
+  sockaddr_in *address = reinterpret_cast<sockaddr_in *>(&storage);
+  address->sin_family = AF_INET;
+  address->sin_port = htons(endpoint.port);
+  if (inet_pton(AF_INET, endpoint.host.c_str(), &address->sin_addr) != 1)
+  {
+    // ไม่ใช่ตัวเลข IP - ลองแปลงชื่อโฮสต์
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    addrinfo *result = nullptr;
+    if (getaddrinfo(endpoint.host.c_str(), nullptr, &hints, &result) != 0 || !result)
+    {
+      return 0;
+    }
+    address->sin_addr = reinterpret_cast<sockaddr_in *>(result->ai_addr)->sin_addr;
+    freeaddrinfo(result);
+  }
+  return sizeof(sockaddr_in);
+}
+
+std::string describeEndpoint(const Endpoint &endpoint)
+{
+  return endpoint.unix_path.empty() ? endpoint.host + ":" + std::to_string(endpoint.port) : endpoint.unix_path;
+}
+
+bool setNonBlocking(int fd)
+{
+  int flags = fcntl(fd, F_GETFL, 0);
+  return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// ปิด Nagle เพื่อให้ข้อความสั้นๆ ถูกส่งทันที (ไม่มีผลกับ Unix-domain socket)
+static void setNoDelay(int fd)
+{
+  int enabled = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+}
+
+int listenOn(const Endpoint &endpoint, int backlog)
+{
+  sockaddr_storage storage;
+  socklen_t length = makeAddress(endpoint, storage);
+  if (length == 0)
+  {
+    return -1;
+  }
+
+  int fd = socket(storage.ss_family, SOCK_STREAM, 0);
+  if (fd < 0)
+  {
+    return -1;
+  }
+  if (endpoint.unix_path.empty())
+  {
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  }
+  else
+  {
+    unlink(endpoint.unix_path.c_str()); // ลบไฟล์ socket เก่าที่ค้างอยู่
+  }
+
+  if (bind(fd, reinterpret_cast<sockaddr *>(&storage), length) != 0 ||
+      listen(fd, backlog) != 0 || !setNonBlocking(fd))
+  {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+int connectTo(const Endpoint &endpoint)
+{
+  sockaddr_storage storage;
+  socklen_t length = makeAddress(endpoint, storage);
+  if (length == 0)
+  {
+    return -1;
+  }
+
+  int fd = socket(storage.ss_family, SOCK_STREAM, 0);
+  if (fd < 0)
+  {
+    return -1;
+  }
+  if (connect(fd, reinterpret_cast<sockaddr *>(&storage), length) != 0 || !setNonBlocking(fd))
+  {
+    close(fd);
+    return -1;
+  }
+  if (endpoint.unix_path.empty())
+  {
+    setNoDelay(fd);
+  }
+  return fd;
+}
+
+int acceptClient(int listen_fd)
+{
+  sockaddr_storage storage;
+  socklen_t length = sizeof(storage);
+  int fd = accept(listen_fd, reinterpret_cast<sockaddr *>(&storage), &length);
+  if (fd < 0)
+  {
+    return -1;
+  }
+  setNonBlocking(fd);
+  if (storage.ss_family == AF_INET)
+  {
+    setNoDelay(fd);
+  }
+  return fd;
+}
+
+void closeSocket(int fd)
+{
+  if (fd >= 0)
+  {
+    close(fd);
+  }
+}
+
+void raiseOpenFileLimit()
+{
+  rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max)
+  {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+}
+
+bool readAvailable(int fd, std::string &buffer)
+{
+  char chunk[16 * 1024];
+  while (true)
+  {
+    ssize_t received = read(fd, chunk, sizeof(chunk));
+    if (received > 0)
+    {
+      buffer.append(chunk, static_cast<size_t>(received));
+      continue;
+    }
+    if (received == 0)
+    {
+      return false; // อีกฝั่งปิดการเชื่อมต่อ
+    }
+    if (errno == EINTR)
+    {
+      continue;
+    }
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+  }
+}
+
+bool writeSome(int fd, const char *data, size_t size, size_t &written)
+{
+  while (written < size)
+  {
+    ssize_t sent = send(fd, data + written, size - written, MSG_NOSIGNAL);
+    if (sent > 0)
+    {
+      written += static_cast<size_t>(sent);
+      continue;
+    }
+    if (sent < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    return sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK); // socket เต็ม - รอ EPOLLOUT
+  }
+  return true;
+}
+
+bool writePending(int fd, std::string &buffer)
+{
+  size_t sent_total = 0;
+  bool ok = writeSome(fd, buffer.data(), buffer.size(), sent_total);
+  buffer.erase(0, sent_total);
+  return ok;
+}
+
+// --- EventLoop ---
+#ifdef __linux__
+EventLoop::EventLoop() : epoll_fd(epoll_create1(0))
+{
+}
+
+EventLoop::~EventLoop()
+{
+  closeSocket(epoll_fd);
+}
+
+bool EventLoop::add(int fd, bool want_write)
+{
+  epoll_event event = {};
+  event.events = EPOLLIN | EPOLLRDHUP | (want_write ? EPOLLOUT : 0u);
+  event.data.fd = fd;
+  return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+bool EventLoop::modify(int fd, bool want_write)
+{
+  epoll_event event = {};
+  event.events = EPOLLIN | EPOLLRDHUP | (want_write ? EPOLLOUT : 0u);
+  event.data.fd = fd;
+  return epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event) == 0;
+}
+
+void EventLoop::remove(int fd)
+{
+  epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+int EventLoop::wait(std::vector<IoEvent> &events, int timeout_ms)
+{
+  epoll_event ready[256];
+  int count = epoll_wait(epoll_fd, ready, 256, timeout_ms);
+  events.clear();
+  for (int i = 0; i < count; ++i)
+  {
+    uint32_t flags = ready[i].events;
+    events.push_back({ready[i].data.fd, (flags & EPOLLIN) != 0, (flags & EPOLLOUT) != 0,
+                      (flags & (EPOLLERR | EPOLLHUP)) != 0});
+  }
+  return count < 0 ? 0 : count;
+}
+#else
+EventLoop::EventLoop()
+{
+}
+
+EventLoop::~EventLoop()
+{
+}
+
+bool EventLoop::add(int fd, bool want_write)
+{
+  watched_fds.push_back(fd);
+  watch_write.push_back(want_write);
+  return true;
+}
+
+bool EventLoop::modify(int fd, bool want_write)
+{
+  auto it = std::find(watched_fds.begin(), watched_fds.end(), fd);
+  if (it == watched_fds.end())
+  {
+    return false;
+  }
+  watch_write[static_cast<size_t>(it - watched_fds.begin())] = want_write;
+  return true;
+}
+
+void EventLoop::remove(int fd)
+{
+  auto it = std::find(watched_fds.begin(), watched_fds.end(), fd);
+  if (it != watched_fds.end())
+  {
+    size_t index = static_cast<size_t>(it - watched_fds.begin());
+    watched_fds.erase(it);
+    watch_write.erase(watch_write.begin() + static_cast<long>(index));
+  }
+}
+
+int EventLoop::wait(std::vector<IoEvent> &events, int timeout_ms)
+{
+  std::vector<pollfd> fds(watched_fds.size());
+  for (size_t i = 0; i < watched_fds.size(); ++i)
+  {
+    fds[i].fd = watched_fds[i];
+    fds[i].events = static_cast<short>(POLLIN | (watch_write[i] ? POLLOUT : 0));
+    fds[i].revents = 0;
+  }
+  int count = poll(fds.data(), static_cast<nfds_t>(fds.size()), timeout_ms);
+  events.clear();
+  for (const pollfd &fd : fds)
+  {
+    if (fd.revents != 0)
+    {
+      events.push_back({fd.fd, (fd.revents & POLLIN) != 0, (fd.revents & POLLOUT) != 0,
+                        (fd.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0});
+    }
+  }
+  return count < 0 ? 0 : static_cast<int>(events.size());
+}
+#endif
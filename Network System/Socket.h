@@ -0,0 +1,73 @@
+// Socket.h - ไฟล์ Header สำหรับเครื่องมือ socket แบบ non-blocking และ event loop
+// ใช้ epoll บน Linux และ poll บนระบบ POSIX อื่น (ยังไม่รองรับ Windows)
+#ifndef SOCKET_H
+#define SOCKET_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// ปลายทางสำหรับเปิดรับ/เชื่อมต่อ: TCP (host:port) หรือ Unix-domain socket (path)
+struct Endpoint
+{
+  std::string host = "127.0.0.1";
+  uint16_t port = 7777;
+  std::string unix_path; // ถ้าไม่ว่างจะใช้ Unix-domain socket แทน TCP
+};
+
+// ข้อความแสดงปลายทาง เช่น "127.0.0.1:7777" หรือ path ของ Unix-domain socket
+std::string describeEndpoint(const Endpoint &endpoint);
+
+// --- ฟังก์ชันช่วยจัดการ socket (คืนค่า -1 เมื่อผิดพลาด) ---
+int listenOn(const Endpoint &endpoint, int backlog = 1024);
+int connectTo(const Endpoint &endpoint); // เชื่อมต่อแบบ blocking แล้วเปลี่ยนเป็น non-blocking
+int acceptClient(int listen_fd);         // -1 เมื่อไม่มีไคลเอนต์รออยู่
+bool setNonBlocking(int fd);
+void closeSocket(int fd);
+void raiseOpenFileLimit(); // ขยายจำนวนไฟล์ที่เปิดได้พร้อมกันเท่าที่ระบบอนุญาต
+
+// อ่านข้อมูลทั้งหมดที่มีอยู่ต่อท้าย buffer - คืนค่า false เมื่ออีกฝั่งปิดการเชื่อมต่อหรือเกิดข้อผิดพลาด
+bool readAvailable(int fd, std::string &buffer);
+
+// เขียนข้อมูลจาก buffer เท่าที่ socket รับได้แล้วลบส่วนที่ส่งแล้วออก
+// คืนค่า false เมื่อเกิดข้อผิดพลาด (ข้อมูลที่ยังไม่ได้ส่งจะค้างอยู่ใน buffer)
+bool writePending(int fd, std::string &buffer);
+
+// เขียน data เท่าที่ socket รับได้ เพิ่มจำนวนไบต์ที่ส่งแล้วใน written - คืนค่า false เมื่อเกิดข้อผิดพลาด
+bool writeSome(int fd, const char *data, size_t size, size_t &written);
+
+// เหตุการณ์ที่ได้จาก EventLoop::wait
+struct IoEvent
+{
+  int fd;
+  bool readable;
+  bool writable;
+  bool closed; // อีกฝั่งปิดหรือเกิดข้อผิดพลาด
+};
+
+// ตัวรอเหตุการณ์ของหลาย socket พร้อมกัน
+class EventLoop
+{
+private:
+#ifdef __linux__
+  int epoll_fd;
+#else
+  std::vector<int> watched_fds;
+  std::vector<bool> watch_write;
+#endif
+
+public:
+  EventLoop();
+  ~EventLoop();
+  EventLoop(const EventLoop &) = delete;
+  EventLoop &operator=(const EventLoop &) = delete;
+
+  bool add(int fd, bool want_write = false);
+  bool modify(int fd, bool want_write);
+  void remove(int fd);
+
+  // รอเหตุการณ์ไม่เกิน timeout_ms (ค่าติดลบ = รอจนกว่าจะมี) เขียนผลลงใน events
+  int wait(std::vector<IoEvent> &events, int timeout_ms);
+};
+
+#endif // SOCKET_H
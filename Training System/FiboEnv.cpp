@@ -0,0 +1,126 @@
+// FiboEnv.cpp - ไฟล์ Source สำหรับ C ABI ของ VecEnv (fibo_env.h)
+// ข้อยกเว้นของ C++ ห้ามหลุดออกไปฝั่ง C จึงถูกแปลงเป็นค่าคืน -1/NULL พร้อมข้อความใน fibo_env_last_error()
+#include "fibo_env.h"
+#include "VecEnv.h"
+#include "../Game Core/CardDatabase.h"
+#include "../UI System/OutputSink.h"
+#include <memory>
+#include <exception>
+
+struct FiboVecEnv
+{
+  std::unique_ptr<VecEnv> env;
+};
+
+static thread_local std::string last_error;
+
+static int fail(const std::string &message)
+{
+  last_error = message;
+  return -1;
+}
+
+extern "C"
+{
+  int fibo_env_api_version(void) { return FIBO_ENV_API_VERSION; }
+  int fibo_env_action_count(void) { return ENV_ACTION_COUNT; }
+
+  FiboVecEnv *fibo_env_create(const char *cards_path, int num_envs, int num_threads)
+  {
+    if (cards_path == nullptr || num_envs <= 0 || num_threads < 0)
+    {
+      fail("พารามิเตอร์ไม่ถูกต้อง (ต้องมีไฟล์การ์ด, num_envs > 0 และ num_threads >= 0)");
+      return nullptr;
+    }
+    try
+    {
+      std::vector<Card> catalog;
+      {
+        NullSink quiet; // ไลบรารีไม่ควรพิมพ์ข้อความของ CardDatabase ลงหน้าจอของโปรแกรมที่เรียก
+        ScopedOutputSink quiet_scope(&quiet);
+        catalog = loadCardsFromJson(cards_path);
+      }
+      if (catalog.empty())
+      {
+        fail(std::string("โหลดการ์ดจาก '") + cards_path + "' ไม่ได้");
+        return nullptr;
+      }
+      FiboVecEnv *handle = new FiboVecEnv();
+      handle->env.reset(new VecEnv(static_cast<size_t>(num_envs), catalog, static_cast<unsigned>(num_threads)));
+      return handle;
+    }
+    catch (const std::exception &e)
+    {
+      fail(e.what());
+      return nullptr;
+    }
+  }
+
+  void fibo_env_destroy(FiboVecEnv *env) { delete env; }
+
+  int fibo_env_num_envs(const FiboVecEnv *env) { return env ? static_cast<int>(env->env->size()) : 0; }
+
+  int fibo_env_observation_size(const FiboVecEnv *env)
+  {
+    return env ? static_cast<int>(env->env->getObservationSize()) : 0;
+  }
+
+  uint64_t fibo_env_observation_schema(const FiboVecEnv *env) { return env ? env->env->getEncoder().getSchemaId() : 0; }
+
+  int fibo_env_reset(FiboVecEnv *env, const uint64_t *seeds, float *observations, uint8_t *masks, int8_t *players)
+  {
+    if (env == nullptr || seeds == nullptr || observations == nullptr || masks == nullptr)
+    {
+      return fail("fibo_env_reset: พารามิเตอร์เป็น NULL");
+    }
+    try
+    {
+      return env->env->reset(seeds, observations, masks, players) ? 0 : fail(env->env->getError());
+    }
+    catch (const std::exception &e)
+    {
+      return fail(e.what());
+    }
+  }
+
+  int fibo_env_step(FiboVecEnv *env, const int32_t *actions, float *observations, uint8_t *masks, float *rewards,
+                    uint8_t *dones, int8_t *players)
+  {
+    if (env == nullptr || actions == nullptr || observations == nullptr || masks == nullptr || rewards == nullptr ||
+        dones == nullptr)
+    {
+      return fail("fibo_env_step: พารามิเตอร์เป็น NULL");
+    }
+    try
+    {
+      return env->env->step(actions, observations, masks, rewards, dones, players) ? 0 : fail(env->env->getError());
+    }
+    catch (const std::exception &e)
+    {
+      return fail(e.what());
+    }
+  }
+
+  void fibo_env_stats(const FiboVecEnv *env, uint64_t *steps, uint64_t *episodes, uint64_t *illegal_actions)
+  {
+    VecEnvStats stats;
+    if (env)
+    {
+      stats = env->env->getStats();
+    }
+    if (steps)
+    {
+      *steps = stats.steps;
+    }
+    if (episodes)
+    {
+      *episodes = stats.episodes;
+    }
+    if (illegal_actions)
+    {
+      *illegal_actions = stats.illegal_actions;
+    }
+  }
+
+  const char *fibo_env_last_error(void) { return last_error.c_str(); }
+}
@@ -0,0 +1,121 @@
+// ObservationEncoder.cpp - ไฟล์ Source สำหรับแปลงสถานะเกมเป็นเวกเตอร์ความยาวคงที่
+#include "ObservationEncoder.h"
+#include "../Game Core/StateHash.h"
+#include <algorithm>
+
+static void put(float *out, int value) { *out = static_cast<float>(value); }
+
+static void put(int8_t *out, int value)
+{
+  *out = static_cast<int8_t>(std::max(static_cast<int>(INT8_MIN), std::min(value, static_cast<int>(INT8_MAX))));
+}
+
+static void increment(float *out) { *out += 1.0f; }
+
+static void increment(int8_t *out)
+{
+  if (*out < INT8_MAX)
+  {
+    ++*out;
+  }
+}
+
+// ปัดเป็นหน่วยพันที่ใกล้ที่สุด
+static int toPowerUnits(int value)
+{
+  int half = ObservationEncoder::POWER_UNIT / 2;
+  return (value >= 0 ? value + half : value - half) / ObservationEncoder::POWER_UNIT;
+}
+
+ObservationEncoder::ObservationEncoder(const std::vector<Card> &catalog) : cards(catalog), schema_id(0)
+{
+  StateHash hash;
+  hash.addInt(VERSION);
+  hash.addInt(static_cast<int64_t>(catalog.size()));
+  for (const Card &card : catalog)
+  {
+    hash.addString(card.getCodeNameView());
+  }
+  schema_id = hash.get();
+}
+
+int ObservationEncoder::findCard(std::string_view code_name) const
+{
+  CardId id = cards.findId(code_name);
+  return id == INVALID_CARD_ID ? -1 : static_cast<int>(id);
+}
+
+template <typename T>
+static T *encodeUnit(const Card *card, bool standing, T *out)
+{
+  if (card)
+  {
+    put(out + 0, 1);
+    put(out + 1, card->getGrade());
+    put(out + 2, toPowerUnits(card->getPower()));
+    put(out + 3, standing ? 1 : 0);
+  }
+  return out + ObservationEncoder::UNIT_FEATURES;
+}
+
+template <typename T>
+static T *encodeSeat(const Player &player, T *out)
+{
+  put(out + 0, static_cast<int>(player.getDamageCount()));
+  put(out + 1, static_cast<int>(player.getHandSize()));
+  put(out + 2, static_cast<int>(player.getSoulCount()));
+  put(out + 3, static_cast<int>(player.getDropZoneCount()));
+  put(out + 4, static_cast<int>(player.getDeck().getSize()));
+  out = encodeUnit(player.getVanguard(), player.isUnitStanding(UNIT_STATUS_VC_IDX), out + 5);
+  const auto rear_guards = player.getRearGuards();
+  for (size_t rc = 0; rc < rear_guards.size(); ++rc)
+  {
+    out = encodeUnit(rear_guards[rc], player.isUnitStanding(static_cast<int>(player.getUnitStatusIndexForRC(rc))), out);
+  }
+  return out;
+}
+
+template <typename T>
+void ObservationEncoder::encodeAs(const Match &match, int seat, T *out) const
+{
+  std::fill(out, out + size(), T(0));
+  const Player &self = match.getPlayer(seat);
+  const Player &opponent = match.getPlayer(1 - seat);
+
+  DecisionType decision = match.getPendingDecision();
+  put(out + 0, match.getTurnCount());
+  put(out + 1, seat == match.getCurrentPlayerIndex() ? 1 : 0);
+  if (decision != DecisionType::None)
+  {
+    put(out + 2 + static_cast<int>(decision) - static_cast<int>(DecisionType::MainPhase), 1);
+  }
+  if (decision == DecisionType::Guard)
+  {
+    const AttackState &attack = match.getAttack();
+    put(out + 5, toPowerUnits(attack.power));
+    put(out + 6, attack.critical);
+    put(out + 7, attack.target_idx);
+    put(out + 8, toPowerUnits(match.getPlayer(1 - match.getCurrentPlayerIndex()).getGuardianZoneShieldTotal()));
+  }
+  else
+  {
+    put(out + 7, -1);
+  }
+
+  T *cursor = encodeSeat(self, out + GLOBAL_FEATURES);
+  encodeSeat(opponent, cursor);
+
+  T *hand_counts = out + HAND_OFFSET;
+  for (const Card &card : self.getHand())
+  {
+    int index = findCard(card.getCodeNameView());
+    if (index >= 0)
+    {
+      increment(hand_counts + index);
+    }
+  }
+}
+
+void ObservationEncoder::encode(const Match &match, int seat, float *out) const { encodeAs(match, seat, out); }
+
+void ObservationEncoder::encode(const Match &match, int seat, int8_t *out) const { encodeAs(match, seat, out); }
@@ -0,0 +1,57 @@
+// ObservationEncoder.h - ไฟล์ Header สำหรับแปลงสถานะเกมจากมุมมองของผู้เล่น 1 คนเป็นเวกเตอร์ความยาวคงที่
+// ใช้ป้อนบอทและโปรแกรมฝึก (VecEnv, fibo_selfplay) - ผลลัพธ์ขึ้นกับสถานะเกมเท่านั้น (deterministic)
+// encode() ไม่จองหน่วยความจำเลย จึงเรียกได้ทุกก้าวของทุกเกมโดยไม่เป็นคอขวด
+#ifndef OBSERVATIONENCODER_H
+#define OBSERVATIONENCODER_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include "../Game Core/Match.h"
+#include "../Game Core/CardTable.h"
+
+// รูปแบบของเวกเตอร์ (VERSION 1) - N = จำนวนการ์ดในแคตตาล็อก
+//   [0, 9)         ส่วนรวม: เทิร์น, เป็นเจ้าของเทิร์น, Main/Battle/Guard (one-hot),
+//                  พลังโจมตี, คริติคอล, ดัชนีสถานะของเป้าหมาย (-1 = ไม่มีการโจมตี), shield ใน Guardian Zone
+//   [9, 38)        ตัวเอง: ดาเมจ, มือ, Soul, Drop, เด็ค แล้วยูนิตละ 4 ช่อง (มีการ์ด, เกรด, พลัง, ยืนอยู่) VC, RC0-RC4
+//   [38, 67)       ฝ่ายตรงข้าม: รูปแบบเดียวกับตัวเอง
+//   [67, 67 + N)   จำนวนการ์ดแต่ละใบในแคตตาล็อกที่อยู่บนมือตัวเอง (มือฝ่ายตรงข้ามมองไม่เห็น)
+// พลังและ shield เก็บเป็นหน่วยพัน (POWER_UNIT) เพื่อให้ค่าทุกช่องอยู่ในช่วงของ int8_t
+// ข้อมูลส่วนรวมของการโจมตีมีค่าเฉพาะตอนรอการ Guard
+class ObservationEncoder
+{
+public:
+  static constexpr uint32_t VERSION = 1; // เพิ่มเมื่อความหมายหรือลำดับของช่องเปลี่ยน
+  static constexpr int GLOBAL_FEATURES = 9;
+  static constexpr int UNIT_FEATURES = 4;
+  static constexpr int SEAT_FEATURES = 5 + NUM_FIELD_UNITS * UNIT_FEATURES;
+  static constexpr int HAND_OFFSET = GLOBAL_FEATURES + 2 * SEAT_FEATURES;
+  static constexpr int POWER_UNIT = 1000;
+
+private:
+  CardTable cards; // ค้นลำดับในแคตตาล็อกจากรหัสการ์ด (ลำดับเดียวกับช่องจำนวนการ์ดบนมือ)
+  uint64_t schema_id;
+
+  template <typename T>
+  void encodeAs(const Match &match, int seat, T *out) const;
+
+public:
+  // แคตตาล็อกต้องมีไม่เกิน INVALID_CARD_ID ใบ (ข้อจำกัดของ CardTable)
+  explicit ObservationEncoder(const std::vector<Card> &catalog);
+
+  size_t size() const { return HAND_OFFSET + cards.size(); } // จำนวนช่องของเวกเตอร์
+  size_t getCatalogSize() const { return cards.size(); }
+
+  // VERSION รวมกับรหัสการ์ดในแคตตาล็อก - ข้อมูลที่ encode ด้วยค่าเดียวกันเทียบกันได้ช่องต่อช่อง
+  uint64_t getSchemaId() const { return schema_id; }
+
+  // ลำดับของการ์ดในแคตตาล็อก (-1 = ไม่มี)
+  int findCard(std::string_view code_name) const;
+
+  // เขียน size() ช่องจากมุมมองของผู้เล่น seat (ค่าเดียวกันทั้ง 2 แบบ แบบ int8_t ตัดค่าที่เกินช่วง)
+  void encode(const Match &match, int seat, float *out) const;
+  void encode(const Match &match, int seat, int8_t *out) const;
+};
+
+#endif // OBSERVATIONENCODER_H
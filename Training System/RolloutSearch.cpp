@@ -0,0 +1,152 @@
+// RolloutSearch.cpp - ไฟล์ Source สำหรับบอทที่ค้นหาด้วยการจำลองเกมจนจบ
+#include "RolloutSearch.h"
+#include "../Game Core/AllocationProfile.h"
+#include "../Game Core/Simulation.h"
+#include <cmath>
+#include <algorithm>
+
+// ตัวสุ่มขนาดเล็กสำหรับการจำลอง (SplitMix64) - ผลขึ้นกับ seed เท่านั้นทุกเครื่อง
+class RolloutRandom
+{
+private:
+  uint64_t state;
+
+public:
+  explicit RolloutRandom(uint64_t seed) : state(seed) {}
+
+  uint64_t next()
+  {
+    state = nextEpisodeSeed(state);
+    return state;
+  }
+
+  // สุ่มหมายเลขการกระทำจาก mask (ต้องมีอย่างน้อย 1 ช่องที่ทำได้)
+  int pick(const uint8_t *mask, int legal_count)
+  {
+    int remaining = static_cast<int>(next() % static_cast<uint64_t>(legal_count));
+    for (int id = 0; id < ENV_ACTION_COUNT; ++id)
+    {
+      if (mask[id] && remaining-- == 0)
+      {
+        return id;
+      }
+    }
+    return -1;
+  }
+};
+
+static int countLegal(const uint8_t *mask)
+{
+  int count = 0;
+  for (int id = 0; id < ENV_ACTION_COUNT; ++id)
+  {
+    count += mask[id];
+  }
+  return count;
+}
+
+RolloutSearch::RolloutSearch(int simulations, double exploration)
+    : simulations(std::max(1, std::min(simulations, static_cast<int>(UINT16_MAX)))), exploration(exploration)
+{
+}
+
+void RolloutSearch::search(const Match &root, uint64_t seed, SearchResult &result) const
+{
+  ALLOC_SCOPE(AI);
+  result.visits.fill(0);
+  result.action = -1;
+  result.value = 0.0f;
+
+  uint8_t mask[ENV_ACTION_COUNT];
+  writeEnvLegalMask(root, mask);
+  int legal[ENV_ACTION_COUNT];
+  int legal_count = 0;
+  for (int id = 0; id < ENV_ACTION_COUNT; ++id)
+  {
+    if (mask[id])
+    {
+      legal[legal_count++] = id;
+    }
+  }
+  if (legal_count == 0)
+  {
+    return;
+  }
+  if (legal_count == 1)
+  {
+    result.action = legal[0];
+    result.visits[static_cast<size_t>(legal[0])] = 1;
+    return;
+  }
+
+  int actor = root.getActingPlayerIndex();
+  RolloutRandom random(seed);
+  ScopedSimulation simulation; // การจำลองไม่นับใน gameMetrics() และไม่บันทึก trace
+  std::array<double, ENV_ACTION_COUNT> total_value{};
+  for (int sim = 0; sim < simulations; ++sim)
+  {
+    // ลองทุกการกระทำอย่างละครั้งก่อน แล้วจึงเลือกด้วย UCB1
+    int chosen = legal[sim % legal_count];
+    if (sim >= legal_count)
+    {
+      double best_score = -INFINITY;
+      double log_total = std::log(static_cast<double>(sim));
+      for (int i = 0; i < legal_count; ++i)
+      {
+        size_t id = static_cast<size_t>(legal[i]);
+        double n = result.visits[id];
+        double score = total_value[id] / n + exploration * std::sqrt(log_total / n);
+        if (score > best_score)
+        {
+          best_score = score;
+          chosen = legal[i];
+        }
+      }
+    }
+
+    Match sim_match(root);
+    sim_match.setObserver(nullptr);
+    sim_match.setRecorder(nullptr);
+    sim_match.getPlayer(0).getDeck().shuffle(random.next());
+    sim_match.getPlayer(1).getDeck().shuffle(random.next());
+
+    GameAction action;
+    envActionToGame(sim_match, chosen, action);
+    sim_match.submit(action);
+    uint8_t rollout_mask[ENV_ACTION_COUNT];
+    for (int step = 0; step < MAX_ROLLOUT_ACTIONS && !sim_match.isOver(); ++step)
+    {
+      writeEnvLegalMask(sim_match, rollout_mask);
+      int count = countLegal(rollout_mask);
+      if (count == 0 || !envActionToGame(sim_match, random.pick(rollout_mask, count), action) ||
+          !sim_match.submit(action))
+      {
+        break;
+      }
+    }
+
+    int winner = sim_match.getWinnerIndex();
+    size_t slot = static_cast<size_t>(chosen);
+    total_value[slot] += winner < 0 ? 0.0 : (winner == actor ? 1.0 : -1.0);
+    result.visits[slot]++;
+  }
+
+  // เลือกการกระทำที่ถูกจำลองมากที่สุด (เท่ากันให้ผลเฉลี่ยสูงกว่า แล้วจึงหมายเลขน้อยกว่า)
+  double best_mean = -INFINITY;
+  for (int i = 0; i < legal_count; ++i)
+  {
+    size_t id = static_cast<size_t>(legal[i]);
+    if (result.visits[id] == 0)
+    {
+      continue; // จำนวนการจำลองน้อยกว่าจำนวนการกระทำที่ทำได้
+    }
+    double mean = total_value[id] / result.visits[id];
+    if (result.action < 0 || result.visits[id] > result.visits[static_cast<size_t>(result.action)] ||
+        (result.visits[id] == result.visits[static_cast<size_t>(result.action)] && mean > best_mean))
+    {
+      result.action = legal[i];
+      best_mean = mean;
+    }
+  }
+  result.value = static_cast<float>(best_mean);
+}
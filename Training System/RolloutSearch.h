@@ -0,0 +1,42 @@
+// RolloutSearch.h - ไฟล์ Header สำหรับบอทที่ค้นหาด้วยการจำลองเกมจนจบ (flat Monte-Carlo)
+// ทุกการจำลองเลือกการกระทำที่ราก (ผู้เล่นที่ต้องตัดสินใจ) ด้วย UCB1 แล้วเล่นสุ่มจากการกระทำที่ทำได้จนเกมจบ
+// จำนวนครั้งที่แต่ละการกระทำถูกเลือก (visit) ใช้เป็นเป้าหมายของ policy ในข้อมูลฝึก (fibo_selfplay)
+// ก่อนจำลองทุกครั้งจะสับสำรับของทั้ง 2 ฝ่ายใหม่ บอทจึงไม่รู้ลำดับการ์ดที่จะจั่วหรือเปิด
+// (การ์ดบนมือฝ่ายตรงข้ามยังมองเห็นในการจำลอง)
+#ifndef ROLLOUTSEARCH_H
+#define ROLLOUTSEARCH_H
+
+#include <array>
+#include <cstdint>
+#include "VecEnv.h"
+
+// ผลการค้นหา 1 ครั้ง
+struct SearchResult
+{
+  int action = -1;                               // หมายเลขการกระทำที่เลือก (ตาม VecEnv.h)
+  std::array<uint16_t, ENV_ACTION_COUNT> visits; // จำนวนการจำลองที่เริ่มด้วยแต่ละการกระทำ
+  float value = 0.0f;                            // ผลเฉลี่ยของการกระทำที่เลือก (+1 ชนะ ถึง -1 แพ้)
+};
+
+class RolloutSearch
+{
+public:
+  static constexpr int MAX_ROLLOUT_ACTIONS = 1000; // กันการจำลองที่ไม่จบ (ปกติเกมจบก่อนด้วย MAX_TURNS)
+
+private:
+  int simulations;
+  double exploration; // ค่าคงที่ของ UCB1 (มากขึ้น = ลองการกระทำที่ยังไม่ค่อยดีบ่อยขึ้น)
+
+public:
+  // simulations ถูกจำกัดไว้ที่ 1-65535 (visit เก็บเป็น uint16_t)
+  explicit RolloutSearch(int simulations, double exploration = 1.4);
+
+  int getSimulations() const { return simulations; }
+
+  // ค้นหาการกระทำของผู้เล่นที่ต้องตัดสินใจใน root - ผลขึ้นกับ root และ seed เท่านั้น
+  // ถ้ามีการกระทำที่ทำได้เพียงอย่างเดียวจะไม่จำลองและให้ visit = 1
+  // ต้องเรียกภายใต้ NullSink (การจำลองเดินเกมจริงซึ่งพิมพ์ข้อความผ่าน Out())
+  void search(const Match &root, uint64_t seed, SearchResult &result) const;
+};
+
+#endif // ROLLOUTSEARCH_H
@@ -0,0 +1,251 @@
+// SelfPlay.cpp - ไฟล์ Source สำหรับสร้างข้อมูลฝึกด้วยการให้บอทเล่นกับตัวเอง
+#include "SelfPlay.h"
+#include "../Game Core/CardDatabase.h"
+#include "../Game Core/Trace.h"
+#include "../Game Core/Metrics.h"
+#include "../UI System/OutputSink.h"
+#include <map>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <condition_variable>
+
+uint64_t selfPlayGameSeed(uint64_t base_seed, uint64_t game) { return nextEpisodeSeed(base_seed ^ nextEpisodeSeed(game)); }
+
+SelfPlaySettings makeSelfPlaySettings(const ObservationEncoder &encoder, const SelfPlayOptions &options)
+{
+  SelfPlaySettings settings;
+  settings.observation_size = static_cast<uint32_t>(encoder.size());
+  settings.action_count = ENV_ACTION_COUNT;
+  settings.schema_id = encoder.getSchemaId();
+  settings.rules_version = Match::RULES_VERSION;
+  settings.simulations = static_cast<uint32_t>(RolloutSearch(options.simulations).getSimulations());
+  settings.seed = options.seed;
+  return settings;
+}
+
+// สุ่มการกระทำตามสัดส่วน visit (ใช้ช่วงต้นเกมให้ข้อมูลหลากหลายขึ้น)
+static int sampleByVisits(const SearchResult &result, uint64_t random)
+{
+  uint64_t total = 0;
+  for (uint16_t visits : result.visits)
+  {
+    total += visits;
+  }
+  if (total == 0)
+  {
+    return result.action;
+  }
+  uint64_t remaining = random % total;
+  for (int id = 0; id < ENV_ACTION_COUNT; ++id)
+  {
+    uint16_t visits = result.visits[static_cast<size_t>(id)];
+    if (remaining < visits)
+    {
+      return id;
+    }
+    remaining -= visits;
+  }
+  return result.action;
+}
+
+bool playSelfPlayGame(const Deck &deck, const ObservationEncoder &encoder, const RolloutSearch &search,
+                      const SelfPlaySettings &settings, const SelfPlayOptions &options, uint64_t game,
+                      const std::atomic<bool> &stop_requested, std::string &records)
+{
+  TRACE_SPAN("selfplay", "game");
+  uint64_t game_seed = selfPlayGameSeed(options.seed, game);
+  Match match("Player 1", deck, "Player 2", deck);
+  if (!match.setup(STARTER_CODE_NAME, game_seed))
+  {
+    return false;
+  }
+  match.start(static_cast<int>(nextEpisodeSeed(game_seed) & 1));
+
+  std::vector<int8_t> observation(encoder.size());
+  uint8_t mask[ENV_ACTION_COUNT];
+  SearchResult result;
+  records.clear();
+  for (int decision = 0; !match.isOver(); ++decision)
+  {
+    if (stop_requested.load(std::memory_order_relaxed))
+    {
+      return false;
+    }
+    int seat = match.getActingPlayerIndex();
+    uint64_t search_seed = nextEpisodeSeed(game_seed + static_cast<uint64_t>(decision) + 1);
+    {
+      static MetricHistogram &search_latency = decisionLatencyMetric("rollout_search");
+      TRACE_SPAN("selfplay", "search");
+      MetricTimer timer(search_latency);
+      search.search(match, search_seed, result);
+    }
+    int action = decision < options.explore_decisions ? sampleByVisits(result, nextEpisodeSeed(search_seed))
+                                                      : result.action;
+
+    encoder.encode(match, seat, observation.data());
+    writeEnvLegalMask(match, mask);
+    appendSelfPlayRecord(records, settings, game, decision, seat, action, observation.data(), mask,
+                         result.visits.data());
+
+    GameAction game_action;
+    if (action < 0 || !envActionToGame(match, action, game_action) || !match.submit(game_action))
+    {
+      return false; // ไม่ควรเกิด: การกระทำมาจาก mask ของสถานะเดียวกัน
+    }
+  }
+  finishSelfPlayGame(records, settings, match.getWinnerIndex());
+  return true;
+}
+
+bool runSelfPlay(const std::vector<Card> &catalog, const SelfPlayOptions &options, SelfPlayWriter &writer,
+                 const std::atomic<bool> &stop_requested, const std::function<void(const SelfPlayProgress &)> &progress)
+{
+  const Deck deck(catalog, getStandardDeckRecipe());
+  const ObservationEncoder encoder(catalog);
+  const RolloutSearch search(options.simulations);
+  const SelfPlaySettings settings = makeSelfPlaySettings(encoder, options);
+
+  unsigned threads = options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+  size_t window = options.window_games > 0 ? options.window_games : 4 * static_cast<size_t>(threads);
+
+  // --- สถานะที่ใช้ร่วมกัน (ป้องกันด้วย mutex) ---
+  std::mutex mutex;
+  std::condition_variable game_finished; // ปลุกเธรดเขียนเมื่อมีเกมเสร็จ
+  std::condition_variable window_moved;  // ปลุกเธรดทำงานเมื่อเขียนเกมออกไปแล้ว
+  std::map<uint64_t, std::string> finished;
+  uint64_t next_claim = writer.getNextGame();
+  uint64_t next_write = writer.getNextGame();
+  unsigned active_workers = threads;
+  bool write_failed = false;
+  SelfPlayProgress status;
+  status.next_game = next_write;
+
+  auto worker = [&](unsigned worker_idx)
+  {
+    if (Trace::isEnabled())
+    {
+      Trace::setThreadName("worker " + std::to_string(worker_idx));
+    }
+    NullSink quiet; // ข้อความที่เกมพิมพ์ระหว่างจำลองไม่ต้องแสดง
+    ScopedOutputSink quiet_scope(&quiet);
+    std::string records;
+    for (;;)
+    {
+      uint64_t game;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto may_claim = [&] { return next_claim < next_write + window; };
+        if (!may_claim())
+        {
+          status.window_waits++;
+          window_moved.wait(lock, [&]
+                            { return may_claim() || write_failed || stop_requested.load(std::memory_order_relaxed); });
+        }
+        if (write_failed || stop_requested.load(std::memory_order_relaxed) || next_claim >= options.games)
+        {
+          break;
+        }
+        game = next_claim++;
+      }
+      AllocationTotals allocations_before = currentThreadAllocationTotals();
+      if (!playSelfPlayGame(deck, encoder, search, settings, options, game, stop_requested, records))
+      {
+        break;
+      }
+      AllocationTotals game_allocations = currentThreadAllocationTotals() - allocations_before;
+      std::lock_guard<std::mutex> lock(mutex);
+      status.allocations += game_allocations;
+      finished.emplace(game, std::move(records));
+      game_finished.notify_one();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    active_workers--;
+    game_finished.notify_one();
+  };
+
+  std::vector<std::thread> pool;
+  for (unsigned t = 0; t < threads; ++t)
+  {
+    pool.emplace_back(worker, t);
+  }
+
+  // เธรดนี้เขียนเกมตามลำดับหมายเลข (เกมที่เสร็จก่อนถึงลำดับจะรออยู่ใน finished)
+  if (Trace::isEnabled())
+  {
+    Trace::setThreadName("writer");
+  }
+  auto last_report = std::chrono::steady_clock::now();
+  for (;;)
+  {
+    std::string records;
+    bool have_game = false;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      game_finished.wait_for(lock, std::chrono::milliseconds(200),
+                             [&] { return finished.count(next_write) > 0 || active_workers == 0; });
+      if (stop_requested.load(std::memory_order_relaxed))
+      {
+        window_moved.notify_all(); // ปลุกเธรดที่รอ window ให้เห็นคำสั่งหยุด
+      }
+      auto ready = finished.find(next_write);
+      if (ready != finished.end())
+      {
+        records.swap(ready->second);
+        finished.erase(ready);
+        have_game = true;
+      }
+      else if (active_workers == 0)
+      {
+        break; // ครบแล้ว หรือถูกหยุดและเขียนเกมที่ต่อเนื่องกันหมดแล้ว
+      }
+    }
+
+    if (have_game)
+    {
+      auto write_started = std::chrono::steady_clock::now();
+      bool written;
+      {
+        TRACE_SPAN("selfplay", "writeGame");
+        written = writer.writeGame(records);
+      }
+      double write_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - write_started).count();
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!written)
+      {
+        write_failed = true;
+        window_moved.notify_all();
+        break;
+      }
+      next_write++;
+      status.games_written++;
+      status.records_written += records.size() / settings.getRecordSize();
+      status.next_game = next_write;
+      status.disk_seconds += write_seconds;
+      window_moved.notify_all();
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (progress && now - last_report >= std::chrono::seconds(1))
+    {
+      last_report = now;
+      SelfPlayProgress snapshot;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        snapshot = status;
+      }
+      progress(snapshot);
+    }
+  }
+
+  for (std::thread &thread : pool)
+  {
+    thread.join();
+  }
+  if (progress)
+  {
+    progress(status);
+  }
+  return !write_failed;
+}
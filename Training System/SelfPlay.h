@@ -0,0 +1,58 @@
+// SelfPlay.h - ไฟล์ Header สำหรับสร้างข้อมูลฝึกด้วยการให้บอทเล่นกับตัวเองหลายเกมพร้อมกัน (fibo_selfplay)
+// เธรดทำงานหยิบหมายเลขเกมไปเล่น เธรดที่เรียก runSelfPlay() เขียนเกมที่เสร็จลงดิสก์ตามลำดับหมายเลข
+// เธรดทำงานเล่นล่วงหน้าได้ไม่เกิน window เกมจากเกมที่เขียนล่าสุด หน่วยความจำจึงจำกัด
+// และถ้าดิสก์ช้ากว่าการสร้างข้อมูล เธรดทำงานจะรอ (back-pressure) แทนการสะสมข้อมูลไว้ในหน่วยความจำ
+// ผลของแต่ละเกมขึ้นกับ seed หลัก หมายเลขเกม และจำนวนการจำลองเท่านั้น (ไม่ขึ้นกับจำนวนเธรด)
+// การรันต่อหลังถูกหยุดจึงได้ข้อมูลเหมือนกับการรันรวดเดียว
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include "ObservationEncoder.h"
+#include "RolloutSearch.h"
+#include "SelfPlayDataset.h"
+#include "../Game Core/AllocationProfile.h"
+
+struct SelfPlayOptions
+{
+  uint64_t games = 1000;     // จำนวนเกมทั้งหมดในโฟลเดอร์ (นับรวมเกมที่สร้างไว้ก่อนหน้า)
+  unsigned threads = 0;      // 0 = ทุกคอร์
+  int simulations = 64;      // การจำลองต่อการตัดสินใจ
+  int explore_decisions = 8; // การตัดสินใจแรกของเกมที่สุ่มตามสัดส่วน visit แทนการเลือกที่ถูกจำลองมากที่สุด
+  uint64_t seed = 1;         // seed หลัก
+  size_t window_games = 0;   // เกมที่เล่นล่วงหน้าได้ (0 = 4 เท่าของจำนวนเธรด)
+};
+
+// ความคืบหน้า (ส่งให้ callback จากเธรดที่เรียก runSelfPlay())
+struct SelfPlayProgress
+{
+  uint64_t games_written = 0;   // เกมที่เขียนครบในครั้งนี้
+  uint64_t records_written = 0; // แถวที่เขียนในครั้งนี้
+  uint64_t next_game = 0;       // เกมถัดไปที่ต้องเขียน
+  double disk_seconds = 0;      // เวลาที่ใช้เขียนดิสก์
+  uint64_t window_waits = 0;    // ครั้งที่เธรดทำงานต้องรอเพราะเล่นล่วงหน้าเต็ม window (ดิสก์หรือเกมก่อนหน้าช้า)
+  AllocationTotals allocations; // การจองหน่วยความจำของเกมที่เล่นจบ (เฉพาะเมื่อ compile ด้วย -DFIBO_ALLOC_PROFILE)
+};
+
+// seed ของเกมหมายเลข game
+uint64_t selfPlayGameSeed(uint64_t base_seed, uint64_t game);
+
+// การตั้งค่าของชุดข้อมูลที่สร้างด้วย encoder และ options นี้ (ส่งให้ SelfPlayWriter::open)
+SelfPlaySettings makeSelfPlaySettings(const ObservationEncoder &encoder, const SelfPlayOptions &options);
+
+// เล่น 1 เกมด้วย RolloutSearch ทั้ง 2 ฝ่าย แล้วเขียนแถวของทุกการตัดสินใจลง records (แทนที่ข้อมูลเดิม)
+// คืนค่า false ถ้าถูกหยุด (stop_requested) ก่อนเกมจบ - ต้องเรียกภายใต้ NullSink
+bool playSelfPlayGame(const Deck &deck, const ObservationEncoder &encoder, const RolloutSearch &search,
+                      const SelfPlaySettings &settings, const SelfPlayOptions &options, uint64_t game,
+                      const std::atomic<bool> &stop_requested, std::string &records);
+
+// เล่นและเขียนจนมีครบ options.games เกม หรือจนกว่า stop_requested เป็นจริง (เกมที่เขียนไปแล้วถูกเก็บไว้ทั้งหมด)
+// คืนค่า false ถ้าเขียนดิสก์ไม่ได้ (ดู writer.getError())
+bool runSelfPlay(const std::vector<Card> &catalog, const SelfPlayOptions &options, SelfPlayWriter &writer,
+                 const std::atomic<bool> &stop_requested, const std::function<void(const SelfPlayProgress &)> &progress);
+
+#endif // SELFPLAY_H
@@ -0,0 +1,365 @@
+// SelfPlayDataset.cpp - ไฟล์ Source สำหรับชุดข้อมูลฝึกจากการเล่นกับตัวเอง
+#include "SelfPlayDataset.h"
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+
+namespace fs = std::filesystem;
+
+static const char SELFPLAY_MAGIC[] = "FIBOSPD";   // 7 ไบต์แรกของ shard (ไม่รวม '\0')
+static const uint8_t SELFPLAY_FORMAT_VERSION = 1; // เปลี่ยนเมื่อรูปแบบไฟล์เปลี่ยน
+static const char SELFPLAY_INDEX_NAME[] = "index.tsv";
+
+static void putFixed(std::string &out, uint64_t value, int bytes)
+{
+  for (int i = 0; i < bytes; ++i)
+  {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+static uint64_t getFixed(const unsigned char *data, int bytes)
+{
+  uint64_t value = 0;
+  for (int i = 0; i < bytes; ++i)
+  {
+    value |= static_cast<uint64_t>(data[i]) << (8 * i);
+  }
+  return value;
+}
+
+static std::string shardName(size_t number)
+{
+  char name[32];
+  std::snprintf(name, sizeof(name), "shard-%05zu.fsp", number);
+  return name;
+}
+
+static std::string encodeHeader(const SelfPlaySettings &settings)
+{
+  std::string header(SELFPLAY_MAGIC, sizeof(SELFPLAY_MAGIC) - 1);
+  header.push_back(static_cast<char>(SELFPLAY_FORMAT_VERSION));
+  putFixed(header, settings.getRecordSize(), 4);
+  putFixed(header, settings.observation_size, 4);
+  putFixed(header, settings.action_count, 4);
+  putFixed(header, settings.schema_id, 8);
+  putFixed(header, settings.rules_version, 4);
+  putFixed(header, settings.simulations, 4);
+  putFixed(header, settings.seed, 8);
+  header.resize(SELFPLAY_HEADER_SIZE, '\0');
+  return header;
+}
+
+void appendSelfPlayRecord(std::string &buffer, const SelfPlaySettings &settings, uint64_t game, int decision, int seat,
+                          int action, const int8_t *observation, const uint8_t *mask, const uint16_t *visits)
+{
+  putFixed(buffer, game, 8);
+  putFixed(buffer, static_cast<uint64_t>(std::min(decision, static_cast<int>(UINT16_MAX))), 2);
+  buffer.push_back(static_cast<char>(seat));
+  buffer.push_back(0); // ผลของเกม (เติมตอนเกมจบ)
+  putFixed(buffer, static_cast<uint16_t>(static_cast<int16_t>(action)), 2);
+  buffer.push_back(0); // flags
+  buffer.push_back(0);
+  buffer.append(reinterpret_cast<const char *>(observation), settings.observation_size);
+
+  size_t mask_start = buffer.size();
+  buffer.resize(mask_start + settings.getMaskBytes(), '\0');
+  for (uint32_t id = 0; id < settings.action_count; ++id)
+  {
+    if (mask[id])
+    {
+      buffer[mask_start + id / 8] = static_cast<char>(buffer[mask_start + id / 8] | (1 << (id % 8)));
+    }
+  }
+  for (uint32_t id = 0; id < settings.action_count; ++id)
+  {
+    putFixed(buffer, visits[id], 2);
+  }
+}
+
+void finishSelfPlayGame(std::string &buffer, const SelfPlaySettings &settings, int winner)
+{
+  size_t record_size = settings.getRecordSize();
+  for (size_t offset = 0; offset + record_size <= buffer.size(); offset += record_size)
+  {
+    int seat = static_cast<int8_t>(buffer[offset + 10]);
+    buffer[offset + 11] = static_cast<char>(winner < 0 ? 0 : (seat == winner ? 1 : -1));
+    if (offset + record_size == buffer.size())
+    {
+      buffer[offset + 14] = static_cast<char>(SELFPLAY_FLAG_LAST);
+    }
+  }
+}
+
+SelfPlayWriter::SelfPlayWriter() : shard_records(0), file(nullptr), next_game(0), total_records(0) {}
+
+SelfPlayWriter::~SelfPlayWriter() { close(); }
+
+// ตรวจส่วนหัวของ shard ที่มีอยู่แล้ว และนับแถว - shard สุดท้ายจะถูกตัดแถว/เกมที่เขียนไม่ครบทิ้ง
+bool SelfPlayWriter::readShard(const std::string &path, SelfPlayShard &shard, bool is_last)
+{
+  std::error_code ec;
+  uint64_t size = fs::file_size(path, ec);
+  if (ec)
+  {
+    error = "อ่านขนาดของ '" + path + "' ไม่ได้";
+    return false;
+  }
+  std::FILE *in = std::fopen(path.c_str(), "rb");
+  if (!in)
+  {
+    error = "เปิด '" + path + "' ไม่ได้";
+    return false;
+  }
+  std::string expected = encodeHeader(settings);
+  std::string header(SELFPLAY_HEADER_SIZE, '\0');
+  bool has_header = size >= SELFPLAY_HEADER_SIZE && std::fread(&header[0], 1, header.size(), in) == header.size();
+  if (!has_header && is_last)
+  {
+    // ล่มระหว่างเขียนส่วนหัวของ shard ใหม่: เขียนใหม่ทั้งไฟล์
+    std::fclose(in);
+    shard.records = 0;
+    return true;
+  }
+  if (!has_header || header.compare(0, 8, expected, 0, 8) != 0)
+  {
+    std::fclose(in);
+    error = "'" + path + "' ไม่ใช่ไฟล์ข้อมูลของ fibo_selfplay รุ่นนี้";
+    return false;
+  }
+  if (header != expected)
+  {
+    std::fclose(in);
+    error = "'" + path + "' สร้างด้วยการตั้งค่าต่างจากครั้งนี้ (seed, จำนวนการจำลอง, แคตตาล็อก หรือเวอร์ชันกติกา)";
+    return false;
+  }
+
+  size_t record_size = settings.getRecordSize();
+  uint64_t records = (size - SELFPLAY_HEADER_SIZE) / record_size;
+  unsigned char prefix[SELFPLAY_RECORD_PREFIX];
+  auto readPrefix = [&](uint64_t record) -> bool
+  {
+    return std::fseek(in, static_cast<long>(SELFPLAY_HEADER_SIZE + record * record_size), SEEK_SET) == 0 &&
+           std::fread(prefix, 1, sizeof(prefix), in) == sizeof(prefix);
+  };
+
+  // แถว [0, end) จบด้วยเกมที่ครบหรือไม่: แถวสุดท้ายมี SELFPLAY_FLAG_LAST แถวของเกมนั้นมีลำดับการตัดสินใจ 0, 1, 2, ...
+  // ต่อกัน และแถวก่อนหน้าเกมเป็นแถวสุดท้ายของเกมก่อนหน้า (กันข้อมูลขยะที่บังเอิญมีบิต flag ตรง)
+  auto endsWithCompleteGame = [&](uint64_t end) -> bool
+  {
+    if (!readPrefix(end - 1) || !(prefix[14] & SELFPLAY_FLAG_LAST))
+    {
+      return false;
+    }
+    uint64_t game = getFixed(prefix, 8);
+    uint64_t last_decision = getFixed(prefix + 8, 2);
+    if (last_decision >= end)
+    {
+      return false;
+    }
+    uint64_t first = end - 1 - last_decision;
+    for (uint64_t decision = 0; decision < last_decision; ++decision)
+    {
+      if (!readPrefix(first + decision) || getFixed(prefix, 8) != game || getFixed(prefix + 8, 2) != decision ||
+          (prefix[14] & SELFPLAY_FLAG_LAST))
+      {
+        return false;
+      }
+    }
+    return first == 0 || (readPrefix(first - 1) && (prefix[14] & SELFPLAY_FLAG_LAST) && getFixed(prefix, 8) + 1 == game);
+  };
+
+  uint64_t complete = records;
+  while (complete > 0 && !endsWithCompleteGame(complete))
+  {
+    complete--;
+  }
+  if (complete != records && !is_last)
+  {
+    std::fclose(in);
+    error = "'" + path + "' มีเกมที่เขียนไม่ครบทั้งที่ไม่ใช่ shard สุดท้าย";
+    return false;
+  }
+  shard.records = complete;
+  if (complete > 0)
+  {
+    readPrefix(complete - 1);
+    shard.last_game = getFixed(prefix, 8);
+    readPrefix(0);
+    shard.first_game = getFixed(prefix, 8);
+  }
+  std::fclose(in);
+
+  uint64_t complete_size = SELFPLAY_HEADER_SIZE + complete * record_size;
+  if (complete_size != size)
+  {
+    fs::resize_file(path, complete_size, ec);
+    if (ec)
+    {
+      error = "ตัดเกมที่เขียนไม่ครบใน '" + path + "' ไม่ได้";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SelfPlayWriter::open(const std::string &directory_path, const SelfPlaySettings &dataset_settings,
+                          uint64_t records_per_shard)
+{
+  close();
+  directory = directory_path;
+  settings = dataset_settings;
+  shard_records = std::max<uint64_t>(1, records_per_shard);
+  shards.clear();
+  next_game = 0;
+  total_records = 0;
+  error.clear();
+
+  std::error_code ec;
+  fs::create_directories(directory, ec);
+  if (!fs::is_directory(directory, ec))
+  {
+    error = "สร้างโฟลเดอร์ '" + directory + "' ไม่ได้";
+    return false;
+  }
+
+  // shard มีหมายเลขต่อเนื่องจาก 0 จึงหยุดที่หมายเลขแรกที่ไม่มีไฟล์
+  while (fs::exists(fs::path(directory) / shardName(shards.size()), ec))
+  {
+    SelfPlayShard shard;
+    shard.name = shardName(shards.size());
+    shards.push_back(shard);
+  }
+  for (size_t i = 0; i < shards.size(); ++i)
+  {
+    if (!readShard((fs::path(directory) / shards[i].name).string(), shards[i], i + 1 == shards.size()))
+    {
+      shards.clear();
+      return false;
+    }
+    total_records += shards[i].records;
+    if (shards[i].records > 0)
+    {
+      next_game = shards[i].last_game + 1;
+    }
+  }
+
+  bool append = !shards.empty() && fs::file_size(fs::path(directory) / shards.back().name, ec) >= SELFPLAY_HEADER_SIZE;
+  if (shards.empty())
+  {
+    SelfPlayShard shard;
+    shard.name = shardName(0);
+    shards.push_back(shard);
+  }
+  return openShard(append) && writeIndex();
+}
+
+bool SelfPlayWriter::openShard(bool append)
+{
+  std::string path = (fs::path(directory) / shards.back().name).string();
+  file = std::fopen(path.c_str(), append ? "ab" : "wb");
+  if (!file)
+  {
+    error = "เปิด '" + path + "' เพื่อเขียนไม่ได้";
+    return false;
+  }
+  if (!append)
+  {
+    std::string header = encodeHeader(settings);
+    if (std::fwrite(header.data(), 1, header.size(), file) != header.size() || std::fflush(file) != 0)
+    {
+      error = "เขียนส่วนหัวของ '" + path + "' ไม่ได้";
+      return false;
+    }
+  }
+  return true;
+}
+
+// เขียนไฟล์ชั่วคราวแล้วเปลี่ยนชื่อทับ ผู้อ่านจึงไม่เห็น index ที่เขียนไม่ครบ
+bool SelfPlayWriter::writeIndex()
+{
+  fs::path index_path = fs::path(directory) / SELFPLAY_INDEX_NAME;
+  fs::path temp_path = index_path;
+  temp_path += ".tmp";
+  std::FILE *out = std::fopen(temp_path.string().c_str(), "wb");
+  if (!out)
+  {
+    error = "เขียน '" + index_path.string() + "' ไม่ได้";
+    return false;
+  }
+  std::fprintf(out, "# shard\trecords\tfirst_game\tlast_game (record_size=%zu observation=%u actions=%u)\n",
+               settings.getRecordSize(), settings.observation_size, settings.action_count);
+  for (const SelfPlayShard &shard : shards)
+  {
+    if (shard.records == 0)
+    {
+      std::fprintf(out, "%s\t0\t-\t-\n", shard.name.c_str());
+    }
+    else
+    {
+      std::fprintf(out, "%s\t%llu\t%llu\t%llu\n", shard.name.c_str(), static_cast<unsigned long long>(shard.records),
+                   static_cast<unsigned long long>(shard.first_game), static_cast<unsigned long long>(shard.last_game));
+    }
+  }
+  bool ok = std::fclose(out) == 0;
+  std::error_code ec;
+  fs::rename(temp_path, index_path, ec);
+  if (!ok || ec)
+  {
+    error = "เขียน '" + index_path.string() + "' ไม่ได้";
+    return false;
+  }
+  return true;
+}
+
+bool SelfPlayWriter::writeGame(const std::string &records)
+{
+  if (!file)
+  {
+    error = "ยังไม่ได้เปิดโฟลเดอร์ข้อมูล";
+    return false;
+  }
+  uint64_t count = records.size() / settings.getRecordSize();
+  if (count > 0 && shards.back().records >= shard_records)
+  {
+    // shard เต็ม: ปิดแล้วเปิด shard ใหม่ที่รอยต่อของเกม
+    std::fclose(file);
+    file = nullptr;
+    SelfPlayShard shard;
+    shard.name = shardName(shards.size());
+    shards.push_back(shard);
+    if (!openShard(false) || !writeIndex())
+    {
+      return false;
+    }
+  }
+  if (count > 0)
+  {
+    if (std::fwrite(records.data(), 1, records.size(), file) != records.size() || std::fflush(file) != 0)
+    {
+      error = "เขียนข้อมูลลง '" + shards.back().name + "' ไม่ได้ (ดิสก์เต็ม?)";
+      return false;
+    }
+    SelfPlayShard &shard = shards.back();
+    if (shard.records == 0)
+    {
+      shard.first_game = next_game;
+    }
+    shard.records += count;
+    shard.last_game = next_game;
+    total_records += count;
+  }
+  next_game++;
+  return true;
+}
+
+bool SelfPlayWriter::close()
+{
+  if (!file)
+  {
+    return true;
+  }
+  bool ok = std::fclose(file) == 0;
+  file = nullptr;
+  return writeIndex() && ok;
+}
@@ -0,0 +1,97 @@
+// SelfPlayDataset.h - ไฟล์ Header สำหรับชุดข้อมูลฝึกจากการเล่นกับตัวเอง (fibo_selfplay)
+// ข้อมูลแบ่งเป็นไฟล์ย่อย (shard) ในโฟลเดอร์เดียว แต่ละแถวคือการตัดสินใจ 1 ครั้งและมีขนาดคงที่
+// โปรแกรมฝึกจึงเปิดด้วย mmap (เช่น numpy.memmap) แล้วหยิบแถวใดก็ได้โดยไม่ต้องอ่านทั้งไฟล์
+//
+// รูปแบบ shard-NNNNN.fsp (ตัวเลขหลายไบต์เป็น little-endian)
+//   ส่วนหัว 64 ไบต์: "FIBOSPD" u8 รุ่นรูปแบบไฟล์, u32 ขนาดแถว, u32 ช่อง observation, u32 จำนวนการกระทำ,
+//                   u64 schema ของ ObservationEncoder, u32 เวอร์ชันกติกา, u32 จำนวนการจำลองต่อการตัดสินใจ,
+//                   u64 seed หลัก, ที่เหลือเป็น 0
+//   แถว (จำนวนแถว = (ขนาดไฟล์ - 64) / ขนาดแถว):
+//     u64 เกม, u16 ลำดับการตัดสินใจในเกม, i8 ผู้เล่นที่ตัดสินใจ, i8 ผลของผู้เล่นนั้น (+1 ชนะ, -1 แพ้, 0 ไม่มีผู้ชนะ),
+//     i16 การกระทำที่เลือก, u8 flags (SELFPLAY_FLAG_*), u8 ว่าง,
+//     i8 × ช่อง observation (ObservationEncoder แบบ int8_t), u8 × ceil(จำนวนการกระทำ / 8) legal mask แบบบิต (LSB ก่อน),
+//     u16 × จำนวนการกระทำ visit ของการค้นหา
+//   index.tsv: shard ละ 1 บรรทัด (ชื่อไฟล์, จำนวนแถว, เกมแรก, เกมสุดท้าย) เขียนใหม่ทุกครั้งที่เปลี่ยน shard และตอนปิด
+//
+// แถวของแต่ละเกมถูกเขียนต่อกันตามลำดับหมายเลขเกม และเกมหนึ่งไม่คร่อม 2 shard
+// ถ้าโปรแกรมถูกหยุดกลางคัน การเปิดครั้งถัดไปจะตัดเกมสุดท้ายที่เขียนไม่ครบทิ้งแล้วทำต่อจากเกมถัดไป
+#ifndef SELFPLAYDATASET_H
+#define SELFPLAYDATASET_H
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+
+constexpr uint8_t SELFPLAY_FLAG_LAST = 1; // การตัดสินใจสุดท้ายของเกม
+constexpr size_t SELFPLAY_HEADER_SIZE = 64;
+constexpr size_t SELFPLAY_RECORD_PREFIX = 16; // ขนาดของช่องคงที่ก่อน observation
+
+// ค่าที่ทุก shard ในโฟลเดอร์ต้องตรงกัน (ข้อมูลจากการตั้งค่าต่างกันห้ามปนกัน)
+struct SelfPlaySettings
+{
+  uint32_t observation_size = 0;
+  uint32_t action_count = 0;
+  uint64_t schema_id = 0;
+  uint32_t rules_version = 0;
+  uint32_t simulations = 0;
+  uint64_t seed = 0;
+
+  size_t getMaskBytes() const { return (action_count + 7) / 8; }
+  size_t getRecordSize() const { return SELFPLAY_RECORD_PREFIX + observation_size + getMaskBytes() + 2 * action_count; }
+};
+
+// ข้อมูลของ shard 1 ไฟล์ (สำหรับ index.tsv)
+struct SelfPlayShard
+{
+  std::string name;
+  uint64_t records = 0;
+  uint64_t first_game = 0;
+  uint64_t last_game = 0;
+};
+
+// ต่อแถวของการตัดสินใจ 1 ครั้งท้าย buffer ของเกม (ผลของเกมเติมทีหลังด้วย finishSelfPlayGame)
+void appendSelfPlayRecord(std::string &buffer, const SelfPlaySettings &settings, uint64_t game, int decision, int seat,
+                          int action, const int8_t *observation, const uint8_t *mask, const uint16_t *visits);
+
+// เติมผลของเกมให้ทุกแถวใน buffer และตั้ง SELFPLAY_FLAG_LAST ให้แถวสุดท้าย (winner -1 = ไม่มีผู้ชนะ)
+void finishSelfPlayGame(std::string &buffer, const SelfPlaySettings &settings, int winner);
+
+class SelfPlayWriter
+{
+private:
+  std::string directory;
+  SelfPlaySettings settings;
+  uint64_t shard_records; // เปิด shard ใหม่เมื่อ shard ปัจจุบันมีแถวถึงจำนวนนี้ (ที่รอยต่อของเกม)
+  std::FILE *file;
+  std::vector<SelfPlayShard> shards; // shard สุดท้ายคือไฟล์ที่เปิดเขียนอยู่
+  uint64_t next_game;
+  uint64_t total_records;
+  std::string error;
+
+  bool readShard(const std::string &path, SelfPlayShard &shard, bool is_last);
+  bool openShard(bool append);
+  bool writeIndex();
+
+public:
+  SelfPlayWriter();
+  ~SelfPlayWriter();
+  SelfPlayWriter(const SelfPlayWriter &) = delete;
+  SelfPlayWriter &operator=(const SelfPlayWriter &) = delete;
+
+  // เปิดโฟลเดอร์ (สร้างถ้ายังไม่มี) ถ้ามี shard อยู่แล้วจะตรวจว่าการตั้งค่าตรงกัน ตัดเกมที่เขียนไม่ครบ และเขียนต่อ
+  bool open(const std::string &directory_path, const SelfPlaySettings &dataset_settings, uint64_t records_per_shard);
+
+  // เขียนแถวทั้งหมดของเกม getNextGame() (จาก appendSelfPlayRecord + finishSelfPlayGame)
+  bool writeGame(const std::string &records);
+
+  // ปิด shard ปัจจุบันและเขียน index.tsv
+  bool close();
+
+  uint64_t getNextGame() const { return next_game; } // เกมถัดไปที่ต้องเขียน (= จำนวนเกมที่เขียนครบแล้ว)
+  uint64_t getRecordCount() const { return total_records; }
+  size_t getShardCount() const { return shards.size(); }
+  const std::string &getError() const { return error; }
+};
+
+#endif // SELFPLAYDATASET_H
@@ -0,0 +1,184 @@
+// SelfPlayMain.cpp - โปรแกรมสร้างข้อมูลฝึกจากการเล่นกับตัวเอง fibo_selfplay
+// บอท RolloutSearch เล่นกันเองหลายเกมพร้อมกัน แล้วบันทึกทุกการตัดสินใจลง shard ในโฟลเดอร์ที่กำหนด
+//   fibo_selfplay selfplay --games 100000 --simulations 64
+// กด Ctrl+C เพื่อหยุด (เกมที่เขียนครบแล้วถูกเก็บไว้) แล้วสั่งคำสั่งเดิมอีกครั้งเพื่อทำต่อ
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include "SelfPlay.h"
+#include "../Game Core/CardDatabase.h"
+#include "../Game Core/Trace.h"
+#include "../Game Core/Metrics.h"
+#include "../UI System/UIHelper.h"
+
+using namespace std;
+
+static atomic<bool> stop_requested(false);
+
+static void handleStopSignal(int)
+{
+  stop_requested.store(true);
+}
+
+// ตัวเลือก:
+//   --games <n>          จำนวนเกมทั้งหมดในโฟลเดอร์ (ค่าเริ่มต้น 1000 นับรวมเกมที่สร้างไว้แล้ว)
+//   --simulations <n>    การจำลองต่อการตัดสินใจ (ค่าเริ่มต้น 64)
+//   --explore <n>        การตัดสินใจแรกของเกมที่สุ่มตามสัดส่วน visit (ค่าเริ่มต้น 8)
+//   --seed <n>           seed หลัก (ค่าเริ่มต้น 1) ต้องเหมือนเดิมเมื่อทำต่อ
+//   --threads <n>        จำนวนเธรด (ค่าเริ่มต้น = จำนวนคอร์)
+//   --shard-records <n>  แถวต่อ shard (ค่าเริ่มต้น 1000000)
+//   --window <n>         เกมที่เล่นล่วงหน้าได้ก่อนต้องรอดิสก์ (ค่าเริ่มต้น 4 เท่าของจำนวนเธรด)
+//   --cards <file>       ไฟล์ข้อมูลการ์ด (ค่าเริ่มต้น cards.json)
+//   --trace <file>       บันทึกเวลาของแต่ละเกม การค้นหา และการเขียนดิสก์ทุกเธรดเป็น Chrome trace JSON
+//   --metrics <file>     เขียนตัวนับและฮิสโตแกรมเป็นไฟล์ Prometheus ทุกครั้งที่รายงานความคืบหน้า ("-" = สรุปตอนจบ)
+// ตามด้วยโฟลเดอร์ปลายทาง 1 โฟลเดอร์
+int main(int argc, char *argv[])
+{
+  SelfPlayOptions options;
+  uint64_t shard_records = 1000000;
+  string cards_path = "cards.json";
+  string out_dir;
+  string trace_path;
+  string metrics_path;
+  bool valid = true;
+  for (int i = 1; i < argc && valid; ++i)
+  {
+    string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    try
+    {
+      if (arg == "--games" && has_value)
+      {
+        options.games = stoull(argv[++i]);
+      }
+      else if (arg == "--simulations" && has_value)
+      {
+        options.simulations = stoi(argv[++i]);
+      }
+      else if (arg == "--explore" && has_value)
+      {
+        options.explore_decisions = stoi(argv[++i]);
+      }
+      else if (arg == "--seed" && has_value)
+      {
+        options.seed = stoull(argv[++i]);
+      }
+      else if (arg == "--threads" && has_value)
+      {
+        options.threads = static_cast<unsigned>(stoul(argv[++i]));
+      }
+      else if (arg == "--shard-records" && has_value)
+      {
+        shard_records = stoull(argv[++i]);
+      }
+      else if (arg == "--window" && has_value)
+      {
+        options.window_games = static_cast<size_t>(stoull(argv[++i]));
+      }
+      else if (arg == "--cards" && has_value)
+      {
+        cards_path = argv[++i];
+      }
+      else if (arg == "--trace" && has_value)
+      {
+        trace_path = argv[++i];
+      }
+      else if (arg == "--metrics" && has_value)
+      {
+        metrics_path = argv[++i];
+      }
+      else if (!arg.empty() && arg[0] != '-' && out_dir.empty())
+      {
+        out_dir = arg;
+      }
+      else
+      {
+        valid = false;
+      }
+    }
+    catch (const exception &)
+    {
+      valid = false;
+    }
+  }
+  if (!valid || out_dir.empty())
+  {
+    cerr << "วิธีใช้: " << argv[0]
+         << " [--games <n>] [--simulations <n>] [--explore <n>] [--seed <n>] [--threads <n>]"
+            " [--shard-records <n>] [--window <n>] [--cards <file>] [--trace <file>] [--metrics <file>]"
+            " <โฟลเดอร์ปลายทาง>"
+         << endl;
+    return 2;
+  }
+
+  UIHelper::SetAnimationEnabled(false);
+  vector<Card> catalog = loadCardsFromJson(cards_path);
+  if (catalog.empty())
+  {
+    return 1;
+  }
+
+  SelfPlayWriter writer;
+  if (!writer.open(out_dir, makeSelfPlaySettings(ObservationEncoder(catalog), options), shard_records))
+  {
+    UIHelper::PrintError(writer.getError());
+    return 1;
+  }
+  uint64_t resumed_from = writer.getNextGame();
+  if (resumed_from > 0)
+  {
+    UIHelper::PrintInfo("ทำต่อจากเกม " + to_string(resumed_from) + " (มีข้อมูลแล้ว " +
+                        to_string(writer.getRecordCount()) + " แถว ใน " + to_string(writer.getShardCount()) + " shard)");
+  }
+  if (resumed_from >= options.games)
+  {
+    UIHelper::PrintSuccess("มีครบ " + to_string(options.games) + " เกมแล้ว");
+    return writer.close() ? 0 : 1;
+  }
+
+  signal(SIGINT, handleStopSignal);
+  signal(SIGTERM, handleStopSignal);
+
+  auto started = chrono::steady_clock::now();
+  SelfPlayProgress last_progress;
+  auto report = [&](const SelfPlayProgress &progress)
+  {
+    last_progress = progress;
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+    cout << "\rเกม " << progress.next_game << "/" << options.games << "  แถว " << writer.getRecordCount() << "  "
+         << fixed << setprecision(0) << (seconds > 0 ? static_cast<double>(progress.records_written) / seconds : 0.0)
+         << " แถว/วินาที  เขียนดิสก์ " << setprecision(1) << progress.disk_seconds << " วินาที  รอ window "
+         << progress.window_waits << " ครั้ง   " << flush;
+    if (!metrics_path.empty() && metrics_path != "-")
+    {
+      MetricsRegistry::global().writePrometheusFile(metrics_path);
+    }
+  };
+  ScopedTrace trace_scope(trace_path);
+  ScopedMetricsOutput metrics_scope(metrics_path);
+  bool ok = runSelfPlay(catalog, options, writer, stop_requested, report);
+  cout << endl;
+  if (ALLOCATION_PROFILE_ENABLED && last_progress.games_written > 0)
+  {
+    writeAllocationReport(cerr, "fibo_selfplay", last_progress.allocations, last_progress.games_written);
+  }
+  ok = writer.close() && ok;
+  if (!ok)
+  {
+    UIHelper::PrintError(writer.getError());
+    return 1;
+  }
+  if (writer.getNextGame() < options.games)
+  {
+    UIHelper::PrintWarning("หยุดที่เกม " + to_string(writer.getNextGame()) + " - สั่งคำสั่งเดิมอีกครั้งเพื่อทำต่อ");
+    return 0;
+  }
+  UIHelper::PrintSuccess("ครบ " + to_string(options.games) + " เกม (" + to_string(writer.getRecordCount()) +
+                         " แถว ใน " + to_string(writer.getShardCount()) + " shard)");
+  return 0;
+}
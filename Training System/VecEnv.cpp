@@ -0,0 +1,342 @@
+// VecEnv.cpp - ไฟล์ Source สำหรับสภาพแวดล้อมแบบเวกเตอร์สำหรับฝึก reinforcement learning
+#include "VecEnv.h"
+#include "../Game Core/CardDatabase.h"
+#include "../UI System/OutputSink.h"
+#include <algorithm>
+#include <cstring>
+
+uint64_t nextEpisodeSeed(uint64_t seed)
+{
+  uint64_t z = seed + 0x9E3779B97F4A7C15ull;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// --- การแปลงหมายเลขการกระทำ ---
+
+bool envActionToGame(const Match &match, int action_id, GameAction &out)
+{
+  if (action_id < 0 || action_id >= ENV_ACTION_COUNT)
+  {
+    return false;
+  }
+  if (action_id < ENV_ACTION_CALL)
+  {
+    out = GameAction::ride(action_id - ENV_ACTION_RIDE);
+  }
+  else if (action_id < ENV_ACTION_END_MAIN)
+  {
+    int offset = action_id - ENV_ACTION_CALL;
+    out = GameAction::call(offset / NUM_REAR_GUARD_CIRCLES, offset % NUM_REAR_GUARD_CIRCLES);
+  }
+  else if (action_id == ENV_ACTION_END_MAIN)
+  {
+    out = GameAction::endMain();
+  }
+  else if (action_id < ENV_ACTION_END_BATTLE)
+  {
+    int offset = action_id - ENV_ACTION_ATTACK;
+    int attacker_idx = offset / 2 / ENV_FRONT_UNITS;
+    int target_idx = offset / 2 % ENV_FRONT_UNITS;
+    out = GameAction::attack(attacker_idx, target_idx);
+    if (offset % 2 == 1)
+    {
+      // Boost ได้เฉพาะเมื่อมี Booster ที่ใช้ได้ ไม่เช่นนั้นใช้ตำแหน่งที่ไม่มีจริงเพื่อให้ถูกปฏิเสธ
+      // (ไม่ให้กลายเป็นการโจมตีแบบไม่ Boost ซึ่งมีหมายเลขของตัวเองอยู่แล้ว)
+      int booster_idx = match.getPlayer(match.getCurrentPlayerIndex()).chooseBooster(attacker_idx);
+      out.booster = booster_idx >= 0 ? static_cast<int8_t>(booster_idx) : INT8_MIN;
+    }
+  }
+  else if (action_id == ENV_ACTION_END_BATTLE)
+  {
+    out = GameAction::endBattle();
+  }
+  else if (action_id < ENV_ACTION_END_GUARD)
+  {
+    out = GameAction::guard(action_id - ENV_ACTION_GUARD);
+  }
+  else
+  {
+    out = GameAction::endGuard();
+  }
+  return true;
+}
+
+int envActionId(const GameAction &action)
+{
+  bool hand_ok = action.source >= 0 && action.source < ENV_MAX_HAND;
+  switch (action.type)
+  {
+  case ActionType::Ride:
+    return hand_ok ? ENV_ACTION_RIDE + action.source : -1;
+  case ActionType::Call:
+    return hand_ok && action.target >= 0 && action.target < NUM_REAR_GUARD_CIRCLES
+               ? ENV_ACTION_CALL + action.source * NUM_REAR_GUARD_CIRCLES + action.target
+               : -1;
+  case ActionType::EndMain:
+    return ENV_ACTION_END_MAIN;
+  case ActionType::Attack:
+    if (action.source < 0 || action.source >= ENV_FRONT_UNITS || action.target < 0 || action.target >= ENV_FRONT_UNITS)
+    {
+      return -1;
+    }
+    return ENV_ACTION_ATTACK + (action.source * ENV_FRONT_UNITS + action.target) * 2 + (action.booster >= 0 ? 1 : 0);
+  case ActionType::EndBattle:
+    return ENV_ACTION_END_BATTLE;
+  case ActionType::Guard:
+    return hand_ok ? ENV_ACTION_GUARD + action.source : -1;
+  case ActionType::EndGuard:
+    return ENV_ACTION_END_GUARD;
+  }
+  return -1;
+}
+
+// --- legal-action mask ---
+
+void writeEnvLegalMask(const Match &match, uint8_t *out)
+{
+  std::memset(out, 0, ENV_ACTION_COUNT);
+  int acting = match.getActingPlayerIndex();
+  if (acting < 0)
+  {
+    return;
+  }
+  int hand_size = static_cast<int>(std::min(match.getPlayer(acting).getHandSize(), static_cast<size_t>(ENV_MAX_HAND)));
+  switch (match.getPendingDecision())
+  {
+  case DecisionType::MainPhase:
+    for (int h = 0; h < hand_size; ++h)
+    {
+      out[ENV_ACTION_RIDE + h] = match.isLegal(GameAction::ride(h)) ? 1 : 0;
+      for (int rc = 0; rc < NUM_REAR_GUARD_CIRCLES; ++rc)
+      {
+        out[ENV_ACTION_CALL + h * NUM_REAR_GUARD_CIRCLES + rc] = match.isLegal(GameAction::call(h, rc)) ? 1 : 0;
+      }
+    }
+    out[ENV_ACTION_END_MAIN] = 1;
+    break;
+  case DecisionType::BattlePhase:
+    for (int id = ENV_ACTION_ATTACK; id < ENV_ACTION_END_BATTLE; ++id)
+    {
+      GameAction action;
+      out[id] = envActionToGame(match, id, action) && match.isLegal(action) ? 1 : 0;
+    }
+    out[ENV_ACTION_END_BATTLE] = 1;
+    break;
+  case DecisionType::Guard:
+    std::memset(out + ENV_ACTION_GUARD, 1, static_cast<size_t>(hand_size));
+    out[ENV_ACTION_END_GUARD] = 1;
+    break;
+  default:
+    break;
+  }
+}
+
+// --- VecEnv ---
+
+VecEnv::VecEnv(size_t num_envs, const std::vector<Card> &card_catalog, unsigned threads)
+    : matches(num_envs), seeds(num_envs, 0), episode_steps(num_envs, 0),
+      prototype_deck(card_catalog, getStandardDeckRecipe()), encoder(card_catalog), job(nullptr), generation(0), busy_workers(0), next_env(0),
+      stopping(false)
+{
+  if (threads == 0)
+  {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  // ไม่สร้างเธรดเกินจำนวนชุดเกมที่มีให้หยิบ
+  threads = static_cast<unsigned>(std::min<size_t>(threads, (num_envs + ENVS_PER_CLAIM - 1) / ENVS_PER_CLAIM));
+  for (unsigned t = 1; t < threads; ++t)
+  {
+    workers.emplace_back(&VecEnv::workerLoop, this);
+  }
+}
+
+VecEnv::~VecEnv()
+{
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    stopping = true;
+  }
+  work_ready.notify_all();
+  for (std::thread &worker : workers)
+  {
+    worker.join();
+  }
+}
+
+void VecEnv::workerLoop()
+{
+  NullSink quiet; // ข้อความที่เกมพิมพ์ไม่ต้องแสดง (sink แยกกันในแต่ละเธรด)
+  ScopedOutputSink quiet_scope(&quiet);
+  uint64_t seen = 0;
+  for (;;)
+  {
+    {
+      std::unique_lock<std::mutex> lock(pool_mutex);
+      work_ready.wait(lock, [&] { return stopping || generation != seen; });
+      if (stopping)
+      {
+        return;
+      }
+      seen = generation;
+    }
+    runChunks();
+    {
+      std::lock_guard<std::mutex> lock(pool_mutex);
+      if (--busy_workers == 0)
+      {
+        work_done.notify_one();
+      }
+    }
+  }
+}
+
+void VecEnv::runChunks()
+{
+  for (;;)
+  {
+    size_t begin = next_env.fetch_add(ENVS_PER_CLAIM, std::memory_order_relaxed);
+    if (begin >= matches.size())
+    {
+      return;
+    }
+    (*job)(begin, std::min(matches.size(), begin + ENVS_PER_CLAIM));
+  }
+}
+
+// แบ่งเกมเป็นชุดละ ENVS_PER_CLAIM ให้ทุกเธรดแย่งกันหยิบ แล้วรอจนทุกเธรดทำรอบนี้เสร็จ
+void VecEnv::parallelFor(const std::function<void(size_t, size_t)> &work)
+{
+  if (workers.empty())
+  {
+    work(0, matches.size());
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    job = &work;
+    next_env.store(0, std::memory_order_relaxed);
+    busy_workers = workers.size();
+    generation++;
+  }
+  work_ready.notify_all();
+  runChunks();
+  std::unique_lock<std::mutex> lock(pool_mutex);
+  work_done.wait(lock, [&] { return busy_workers == 0; });
+  job = nullptr;
+}
+
+bool VecEnv::startGame(size_t index, uint64_t seed)
+{
+  const std::string names[2] = {"Player 1", "Player 2"};
+  std::optional<Match> &match = matches[index];
+  match.emplace(names[0], prototype_deck, names[1], prototype_deck);
+  if (!match->setup(STARTER_CODE_NAME, seed))
+  {
+    return false;
+  }
+  seeds[index] = seed;
+  episode_steps[index] = 0;
+  match->start(static_cast<int>(nextEpisodeSeed(seed) & 1)); // ผู้เล่นที่เริ่มก่อนก็มาจาก seed เช่นกัน
+  return true;
+}
+
+bool VecEnv::reset(const uint64_t *seeds_in, float *observations, uint8_t *masks, int8_t *players)
+{
+  NullSink quiet;
+  ScopedOutputSink quiet_scope(&quiet);
+  std::atomic<bool> failed(false);
+  std::function<void(size_t, size_t)> work = [&](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      if (!startGame(i, seeds_in[i]))
+      {
+        failed.store(true, std::memory_order_relaxed);
+        continue;
+      }
+      const Match &match = *matches[i];
+      encoder.encode(match, match.getActingPlayerIndex(), observations + i * encoder.size());
+      writeEnvLegalMask(match, masks + i * ENV_ACTION_COUNT);
+      if (players)
+      {
+        players[i] = static_cast<int8_t>(match.getActingPlayerIndex());
+      }
+    }
+  };
+  parallelFor(work);
+  if (failed.load())
+  {
+    error = "ตั้งค่าเกมไม่ได้ (ไม่พบการ์ด Starter ในแคตตาล็อก)";
+    return false;
+  }
+  return true;
+}
+
+bool VecEnv::step(const int32_t *actions, float *observations, uint8_t *masks, float *rewards, uint8_t *dones,
+                  int8_t *players)
+{
+  NullSink quiet;
+  ScopedOutputSink quiet_scope(&quiet);
+  std::atomic<uint64_t> finished(0), illegal(0);
+  std::atomic<bool> failed(false);
+  std::function<void(size_t, size_t)> work = [&](size_t begin, size_t end)
+  {
+    uint64_t local_finished = 0, local_illegal = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+      if (!matches[i].has_value())
+      {
+        failed.store(true, std::memory_order_relaxed); // ยังไม่ได้ reset()
+        continue;
+      }
+      Match &match = *matches[i];
+      int actor = match.getActingPlayerIndex();
+      GameAction action;
+      if (envActionToGame(match, actions[i], action) && match.submit(action))
+      {
+        episode_steps[i]++;
+      }
+      else
+      {
+        local_illegal++;
+      }
+
+      rewards[i] = 0.0f;
+      dones[i] = 0;
+      if (match.isOver())
+      {
+        int winner = match.getWinnerIndex();
+        rewards[i] = winner < 0 ? 0.0f : (winner == actor ? 1.0f : -1.0f);
+        dones[i] = 1;
+        local_finished++;
+        if (!startGame(i, nextEpisodeSeed(seeds[i])))
+        {
+          failed.store(true, std::memory_order_relaxed);
+          continue;
+        }
+      }
+      const Match &next = *matches[i];
+      encoder.encode(next, next.getActingPlayerIndex(), observations + i * encoder.size());
+      writeEnvLegalMask(next, masks + i * ENV_ACTION_COUNT);
+      if (players)
+      {
+        players[i] = static_cast<int8_t>(next.getActingPlayerIndex());
+      }
+    }
+    finished.fetch_add(local_finished, std::memory_order_relaxed);
+    illegal.fetch_add(local_illegal, std::memory_order_relaxed);
+  };
+  parallelFor(work);
+
+  stats.steps += matches.size();
+  stats.episodes += finished.load();
+  stats.illegal_actions += illegal.load();
+  if (failed.load())
+  {
+    error = "เดินเกมไม่ได้ (ต้องเรียก reset() ก่อน step())";
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,118 @@
+// VecEnv.h - ไฟล์ Header สำหรับสภาพแวดล้อมแบบเวกเตอร์ (VecEnv) สำหรับฝึก reinforcement learning
+// ถือเกมอิสระ N เกมพร้อมกัน เรียก step() ครั้งเดียวเดินทุกเกมไป 1 การกระทำ
+// ผลลัพธ์ (observation, legal-action mask, reward, done) ถูกเขียนลงอาร์เรย์แบนที่ผู้เรียกจองไว้
+// ข้อมูลของแต่ละเกมเก็บแบบ struct-of-arrays (อาร์เรย์ละ 1 ช่องต่อเกม) และแบ่งช่วงเกมให้หลายเธรดเดินพร้อมกัน
+// เกมที่จบจะถูกเริ่มใหม่ทันที (auto-reset) ด้วย seed ถัดไปที่คำนวณจาก seed เดิม ผลจึงเหมือนเดิมทุกครั้งที่รันซ้ำ
+#ifndef VECENV_H
+#define VECENV_H
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <optional>
+#include <functional>
+#include <condition_variable>
+#include "../Game Core/Match.h"
+#include "ObservationEncoder.h"
+
+// --- พื้นที่การกระทำ (action id) ---
+// การกระทำทุกชนิดถูกแปลงเป็นหมายเลขเดียวในช่วง [0, ENV_ACTION_COUNT)
+// ตำแหน่งบนมือเลือกได้ถึง ENV_MAX_HAND ใบแรก (การ์ดที่เกินจากนั้นยังอยู่บนมือแต่เลือกผ่าน VecEnv ไม่ได้)
+constexpr int ENV_MAX_HAND = 16;
+constexpr int ENV_FRONT_UNITS = 3; // VC, RC ซ้ายหน้า, RC ขวาหน้า (ดัชนีสถานะ 0-2)
+
+constexpr int ENV_ACTION_RIDE = 0;                              // + ตำแหน่งบนมือ
+constexpr int ENV_ACTION_CALL = ENV_ACTION_RIDE + ENV_MAX_HAND; // + มือ * 5 + ช่อง RC
+constexpr int ENV_ACTION_END_MAIN = ENV_ACTION_CALL + ENV_MAX_HAND * NUM_REAR_GUARD_CIRCLES;
+constexpr int ENV_ACTION_ATTACK = ENV_ACTION_END_MAIN + 1;                            // + (Attacker * 3 + เป้าหมาย) * 2 + Boost
+constexpr int ENV_ACTION_END_BATTLE = ENV_ACTION_ATTACK + ENV_FRONT_UNITS * ENV_FRONT_UNITS * 2;
+constexpr int ENV_ACTION_GUARD = ENV_ACTION_END_BATTLE + 1;                           // + ตำแหน่งบนมือ
+constexpr int ENV_ACTION_END_GUARD = ENV_ACTION_GUARD + ENV_MAX_HAND;
+constexpr int ENV_ACTION_COUNT = ENV_ACTION_END_GUARD + 1;
+
+// seed ถัดไปที่คำนวณจาก seed เดิม (SplitMix64) - ใช้เริ่มเกมใหม่ในช่องเดิมหลังเกมจบ
+// ลำดับของเกมในแต่ละช่องจึงขึ้นกับ seed จาก reset() เท่านั้น
+uint64_t nextEpisodeSeed(uint64_t seed);
+
+// แปลงหมายเลขการกระทำเป็น GameAction ของแมตช์ (Boost ใช้ Booster ที่ตำแหน่งนั้นของ Attacker)
+// คืนค่า false ถ้าหมายเลขอยู่นอกช่วง
+bool envActionToGame(const Match &match, int action_id, GameAction &out);
+
+// หมายเลขการกระทำของ GameAction (-1 = แทนด้วยหมายเลขไม่ได้ เช่น ตำแหน่งบนมือเกิน ENV_MAX_HAND)
+int envActionId(const GameAction &action);
+
+// mask ของการกระทำที่ทำได้ (1 = ทำได้) - observation มาจาก ObservationEncoder จากมุมมองของผู้เล่นที่ต้องตัดสินใจ
+void writeEnvLegalMask(const Match &match, uint8_t *out);
+
+// สถิติสะสมของ VecEnv
+struct VecEnvStats
+{
+  uint64_t steps = 0;
+  uint64_t episodes = 0;        // เกมที่จบ (และเริ่มใหม่อัตโนมัติ)
+  uint64_t illegal_actions = 0; // การกระทำที่ไม่อยู่ใน mask (สถานะของเกมนั้นไม่เปลี่ยน)
+};
+
+class VecEnv
+{
+public:
+  static constexpr size_t ENVS_PER_CLAIM = 64; // เกมที่เธรดหยิบไปเดินต่อครั้ง
+
+private:
+  // --- ข้อมูลของแต่ละเกม (struct-of-arrays: ดัชนีเดียวกันคือเกมเดียวกัน) ---
+  std::vector<std::optional<Match>> matches;
+  std::vector<uint64_t> seeds;         // seed ของเกมปัจจุบันในแต่ละช่อง
+  std::vector<uint32_t> episode_steps; // การกระทำที่เดินไปแล้วในเกมปัจจุบัน
+
+  Deck prototype_deck; // เด็คมาตรฐานที่คัดลอกไปใช้ทุกเกม (ไม่ต้องค้นแคตตาล็อกใหม่ทุกครั้งที่เริ่มเกม)
+  ObservationEncoder encoder;
+  VecEnvStats stats;
+  std::string error;
+
+  // --- thread pool: เธรดถาวรที่รองานทีละรอบ (เธรดที่เรียก step() ก็ช่วยทำงานด้วย) ---
+  std::vector<std::thread> workers;
+  std::mutex pool_mutex;
+  std::condition_variable work_ready;
+  std::condition_variable work_done;
+  const std::function<void(size_t, size_t)> *job; // งานของรอบปัจจุบัน: เดินเกมในช่วง [begin, end)
+  uint64_t generation;                            // เพิ่มทุกครั้งที่เริ่มงานรอบใหม่
+  size_t busy_workers;                            // เธรดที่ยังทำงานรอบปัจจุบันไม่เสร็จ
+  std::atomic<size_t> next_env;
+  bool stopping;
+
+  void workerLoop();
+  void runChunks();
+  void parallelFor(const std::function<void(size_t, size_t)> &work);
+  bool startGame(size_t index, uint64_t seed);
+
+public:
+  // threads = 0 คือใช้ทุกคอร์ (ไม่เกิน 1 เธรดต่อ ENVS_PER_CLAIM เกม)
+  VecEnv(size_t num_envs, const std::vector<Card> &card_catalog, unsigned threads = 0);
+  ~VecEnv();
+  VecEnv(const VecEnv &) = delete;
+  VecEnv &operator=(const VecEnv &) = delete;
+
+  // เริ่มทุกเกมใหม่ด้วย seed ของแต่ละเกม (seeds มี size() ช่อง) แล้วเขียน observation และ mask แรก
+  // observations มี size() * getObservationSize() ช่อง และ masks มี size() * ENV_ACTION_COUNT ช่อง
+  // players (ไม่บังคับ) = ผู้เล่นที่ต้องตัดสินใจในแต่ละเกม - คืนค่า false ถ้าตั้งค่าเกมไม่ได้ (ดู getError())
+  bool reset(const uint64_t *seeds_in, float *observations, uint8_t *masks, int8_t *players = nullptr);
+
+  // เดินทุกเกมไป 1 การกระทำ (actions มี size() ช่อง) - reward เป็นของผู้เล่นที่ทำการกระทำนั้น:
+  // +1 ชนะ, -1 แพ้, 0 ระหว่างเกมหรือเสมอ เกมที่จบได้ done = 1 และ observation/mask ของเกมใหม่แทน
+  bool step(const int32_t *actions, float *observations, uint8_t *masks, float *rewards, uint8_t *dones,
+            int8_t *players = nullptr);
+
+  size_t size() const { return matches.size(); }
+  size_t getThreadCount() const { return workers.size() + 1; }
+  size_t getObservationSize() const { return encoder.size(); }
+  const ObservationEncoder &getEncoder() const { return encoder; }
+  const Match &getMatch(size_t index) const { return matches[index].value(); }
+  uint64_t getSeed(size_t index) const { return seeds[index]; }
+  uint32_t getEpisodeSteps(size_t index) const { return episode_steps[index]; }
+  const VecEnvStats &getStats() const { return stats; }
+  const std::string &getError() const { return error; }
+};
+
+#endif // VECENV_H
@@ -0,0 +1,53 @@
+/* fibo_env.h - C ABI ของ VecEnv สำหรับโปรแกรมฝึกภายนอก (เช่น Python ผ่าน ctypes/cffi)
+ * build เป็น libfibo_env.so ด้วย "Build Tools/build_tools.sh"
+ *
+ * อาร์เรย์ทั้งหมดเป็นของผู้เรียกและเรียงแบบแบน (เกม i อยู่ที่ช่อง i * ขนาดต่อเกม):
+ *   observations: float  [num_envs * fibo_env_observation_size(env)] (รูปแบบตาม ObservationEncoder.h)
+ *   masks:        uint8  [num_envs * fibo_env_action_count()] (1 = การกระทำนี้ทำได้)
+ *   actions:      int32  [num_envs]
+ *   rewards:      float  [num_envs] (ของผู้เล่นที่ทำการกระทำนั้น: +1 ชนะ, -1 แพ้, 0 อื่นๆ)
+ *   dones:        uint8  [num_envs] (1 = เกมจบในก้าวนี้ และ observation เป็นของเกมใหม่แล้ว)
+ *   players:      int8   [num_envs] ผู้เล่นที่ต้องตัดสินใจ (0/1) - ส่ง NULL ได้ถ้าไม่ต้องการ
+ * ฟังก์ชันที่คืนค่า int: 0 = สำเร็จ, -1 = ผิดพลาด (ดูสาเหตุจาก fibo_env_last_error())
+ * env 1 ตัวห้ามเรียกจากหลายเธรดพร้อมกัน (ภายในแบ่งงานให้ thread pool ของตัวเองอยู่แล้ว)
+ */
+#ifndef FIBO_ENV_H
+#define FIBO_ENV_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define FIBO_ENV_API_VERSION 2 /* เพิ่มเมื่อฟังก์ชัน ขนาด observation หรือความหมายของ action id เปลี่ยน */
+
+  typedef struct FiboVecEnv FiboVecEnv;
+
+  int fibo_env_api_version(void);
+  int fibo_env_action_count(void);
+
+  /* สร้าง env ที่มี num_envs เกม (num_threads = 0 คือใช้ทุกคอร์) - คืนค่า NULL ถ้าโหลดไฟล์การ์ดไม่ได้ */
+  FiboVecEnv *fibo_env_create(const char *cards_path, int num_envs, int num_threads);
+  void fibo_env_destroy(FiboVecEnv *env);
+
+  int fibo_env_num_envs(const FiboVecEnv *env);
+  int fibo_env_observation_size(const FiboVecEnv *env); /* ขึ้นกับจำนวนการ์ดในแคตตาล็อก */
+  /* รุ่นของ ObservationEncoder รวมกับแคตตาล็อก - ข้อมูลที่ค่าเท่ากันใช้โมเดลเดียวกันได้ */
+  uint64_t fibo_env_observation_schema(const FiboVecEnv *env);
+  int fibo_env_reset(FiboVecEnv *env, const uint64_t *seeds, float *observations, uint8_t *masks, int8_t *players);
+  int fibo_env_step(FiboVecEnv *env, const int32_t *actions, float *observations, uint8_t *masks, float *rewards,
+                    uint8_t *dones, int8_t *players);
+
+  /* สถิติสะสม (ส่ง NULL ได้ทุกช่อง) */
+  void fibo_env_stats(const FiboVecEnv *env, uint64_t *steps, uint64_t *episodes, uint64_t *illegal_actions);
+
+  /* สาเหตุของข้อผิดพลาดล่าสุดในเธรดนี้ (ข้อความ UTF-8 ใช้ได้จนกว่าจะเรียกฟังก์ชันอื่นในเธรดเดียวกัน) */
+  const char *fibo_env_last_error(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FIBO_ENV_H */
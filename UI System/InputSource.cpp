@@ -0,0 +1,98 @@
+// InputSource.cpp - การดำเนินการของระบบแหล่งข้อมูลนำเข้า
+#include "InputSource.h"
+#include "OutputSink.h"
+#include <iostream>
+
+using namespace std;
+
+// แหล่งข้อมูลเริ่มต้นและแหล่งข้อมูลที่เลือกไว้ของแต่ละเธรด
+static ConsoleInputSource console_input_source;
+static thread_local InputSource *current_input_source = nullptr;
+
+InputSource &InputSource::Current()
+{
+  return current_input_source ? *current_input_source : console_input_source;
+}
+
+void InputSource::SetCurrent(InputSource *source)
+{
+  current_input_source = source;
+}
+
+string InputSource::NextLine()
+{
+  Out().flush(); // ให้ข้อความคำถามแสดงก่อนรอรับข้อมูล
+  string line;
+  if (!Current().ReadLine(line))
+  {
+    throw InputExhaustedError();
+  }
+  return line;
+}
+
+// ConsoleInputSource - อ่านจากคีย์บอร์ด
+bool ConsoleInputSource::ReadLine(string &line)
+{
+  return static_cast<bool>(getline(cin, line));
+}
+
+// ScriptInputSource - อ่านจากไฟล์สคริปต์
+ScriptInputSource::ScriptInputSource(const string &path, bool echo)
+    : file(path), echo_input(echo), lines_consumed(0)
+{
+}
+
+bool ScriptInputSource::IsOpen() const
+{
+  return file.is_open();
+}
+
+size_t ScriptInputSource::GetLinesConsumed() const
+{
+  return lines_consumed;
+}
+
+bool ScriptInputSource::ReadLine(string &line)
+{
+  while (getline(file, line))
+  {
+    // ตัด '\r' ท้ายบรรทัดสำหรับสคริปต์ที่บันทึกบน Windows
+    if (!line.empty() && line.back() == '\r')
+    {
+      line.pop_back();
+    }
+    if (!line.empty() && line[0] == '#')
+    {
+      continue; // ข้ามคอมเมนต์
+    }
+    ++lines_consumed;
+    if (echo_input)
+    {
+      Out() << line << "\n";
+    }
+    return true;
+  }
+  return false;
+}
+
+// QueueInputSource - อ่านจากคิวในหน่วยความจำ
+void QueueInputSource::Push(const string &line)
+{
+  pending_lines.push_back(line);
+}
+
+size_t QueueInputSource::Remaining() const
+{
+  return pending_lines.size();
+}
+
+bool QueueInputSource::ReadLine(string &line)
+{
+  if (pending_lines.empty())
+  {
+    return false;
+  }
+  line = std::move(pending_lines.front());
+  pending_lines.pop_front();
+  return true;
+}
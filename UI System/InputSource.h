@@ -0,0 +1,74 @@
+// InputSource.h - ไฟล์ Header สำหรับระบบแหล่งข้อมูลนำเข้า (Input Source)
+// แยกการรับข้อมูลออกจาก std::cin เพื่อให้สคริปต์ที่บันทึกไว้สามารถขับเคลื่อนโค้ด UI จริงได้ตั้งแต่ต้นจนจบ
+#ifndef INPUTSOURCE_H
+#define INPUTSOURCE_H
+
+#include <string>
+#include <deque>
+#include <fstream>
+#include <stdexcept>
+
+// ข้อผิดพลาดเมื่อแหล่งข้อมูลหมด (เช่น สคริปต์จบแล้ว หรือผู้ใช้กด Ctrl+D)
+class InputExhaustedError : public std::runtime_error
+{
+public:
+  InputExhaustedError() : std::runtime_error("input source exhausted") {}
+};
+
+// คลาสฐานของแหล่งข้อมูลนำเข้า - ทุกจุดที่รับข้อมูลจากผู้เล่นจะอ่านผ่านคลาสนี้
+class InputSource
+{
+public:
+  virtual ~InputSource() = default;
+
+  // อ่านข้อมูล 1 บรรทัด (ไม่รวม '\n') คืนค่า false เมื่อไม่มีข้อมูลเหลือ
+  virtual bool ReadLine(std::string &line) = 0;
+
+  // แหล่งข้อมูลนี้มีมนุษย์อยู่ปลายทางหรือไม่
+  virtual bool IsInteractive() const { return false; }
+
+  // แหล่งข้อมูลที่ใช้งานอยู่ของเธรดปัจจุบัน (ค่าเริ่มต้นคือคอนโซล)
+  static InputSource &Current();
+  static void SetCurrent(InputSource *source); // nullptr = กลับไปใช้คอนโซล
+
+  // อ่านบรรทัดถัดไปจากแหล่งข้อมูลปัจจุบัน โยน InputExhaustedError เมื่อข้อมูลหมด
+  static std::string NextLine();
+};
+
+// อ่านข้อมูลจากคีย์บอร์ดผ่าน std::cin (โหมดปกติ)
+class ConsoleInputSource : public InputSource
+{
+public:
+  bool ReadLine(std::string &line) override;
+  bool IsInteractive() const override { return true; }
+};
+
+// อ่านข้อมูลจากไฟล์สคริปต์ทีละบรรทัด (บรรทัดที่ขึ้นต้นด้วย '#' คือคอมเมนต์)
+class ScriptInputSource : public InputSource
+{
+private:
+  std::ifstream file;     // ไฟล์สคริปต์
+  bool echo_input;        // แสดงข้อมูลที่อ่านได้บนหน้าจอเหมือนผู้เล่นพิมพ์เอง
+  size_t lines_consumed;  // จำนวนบรรทัดที่ใช้ไปแล้ว
+
+public:
+  explicit ScriptInputSource(const std::string &path, bool echo = true);
+
+  bool IsOpen() const;
+  size_t GetLinesConsumed() const;
+  bool ReadLine(std::string &line) override;
+};
+
+// คิวข้อมูลในหน่วยความจำ - ใช้ป้อนคำสั่งจากโค้ดโดยตรง
+class QueueInputSource : public InputSource
+{
+private:
+  std::deque<std::string> pending_lines; // บรรทัดที่รอการอ่าน
+
+public:
+  void Push(const std::string &line);
+  size_t Remaining() const;
+  bool ReadLine(std::string &line) override;
+};
+
+#endif // INPUTSOURCE_H
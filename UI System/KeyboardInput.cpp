@@ -0,0 +1,253 @@
+// KeyboardInput.cpp - การดำเนินการของระบบรับปุ่มกดทีละปุ่ม
+#include "KeyboardInput.h"
+#include "InputSource.h"
+#include "OutputSink.h"
+#ifdef _WIN32
+#include <windows.h>
+#include <conio.h>
+#include <io.h>
+#include <cstdio>
+#else
+#include <termios.h>
+#include <unistd.h>
+#include <poll.h>
+#endif
+
+using namespace std;
+
+static bool keyboard_enabled = true;  // ปิดได้จากบรรทัดคำสั่ง
+static function<void()> idle_handler; // เรียกระหว่างรอปุ่ม
+static int raw_mode_depth = 0;        // จำนวน RawModeGuard ที่ซ้อนกันอยู่
+
+#ifdef _WIN32
+// Windows: คอนโซลส่งปุ่มทีละตัวผ่าน _getch อยู่แล้ว ไม่ต้องเปลี่ยนโหมด
+static bool StdinIsTerminal() { return _isatty(_fileno(stdin)) != 0; }
+static bool StdoutIsTerminal() { return _isatty(_fileno(stdout)) != 0; }
+
+// อ่าน 1 ไบต์ภายในเวลาที่กำหนด: คืนค่า -1 เมื่อหมดเวลา
+static int ReadByte(int timeout_ms)
+{
+  DWORD start = GetTickCount();
+  while (!_kbhit())
+  {
+    if (timeout_ms >= 0 && static_cast<int>(GetTickCount() - start) >= timeout_ms)
+    {
+      return -1;
+    }
+    Sleep(5);
+  }
+  return _getch();
+}
+
+static KeyEvent DecodeKey(int c)
+{
+  if (c == 0 || c == 0xE0)
+  {
+    // ปุ่มพิเศษ: ไบต์ถัดไปบอกว่าเป็นปุ่มอะไร
+    switch (_getch())
+    {
+    case 72:
+      return KeyEvent(Key::Up);
+    case 80:
+      return KeyEvent(Key::Down);
+    case 75:
+      return KeyEvent(Key::Left);
+    case 77:
+      return KeyEvent(Key::Right);
+    default:
+      return KeyEvent(Key::None);
+    }
+  }
+  switch (c)
+  {
+  case 3:
+  case 4:
+  case 26:
+    return KeyEvent(Key::EndOfInput);
+  case '\r':
+  case '\n':
+    return KeyEvent(Key::Enter);
+  case 8:
+    return KeyEvent(Key::Backspace);
+  case '\t':
+    return KeyEvent(Key::Tab);
+  case 27:
+    return KeyEvent(Key::Escape);
+  default:
+    return KeyEvent(Key::Character, static_cast<char>(c));
+  }
+}
+#else
+static termios saved_termios; // โหมดเทอร์มินัลเดิมก่อนเปิด raw
+
+static bool StdinIsTerminal() { return isatty(STDIN_FILENO) != 0; }
+static bool StdoutIsTerminal() { return isatty(STDOUT_FILENO) != 0; }
+
+// อ่าน 1 ไบต์ภายในเวลาที่กำหนด: คืนค่า -1 เมื่อหมดเวลา, -2 เมื่อ stdin ถูกปิด
+static int ReadByte(int timeout_ms)
+{
+  pollfd fd = {STDIN_FILENO, POLLIN, 0};
+  if (poll(&fd, 1, timeout_ms) <= 0)
+  {
+    return -1;
+  }
+  unsigned char c;
+  if (read(STDIN_FILENO, &c, 1) != 1)
+  {
+    return -2;
+  }
+  return c;
+}
+
+// แปลง escape sequence ของปุ่มลูกศร ("\033[A", "\033OA", ...)
+static KeyEvent DecodeEscape()
+{
+  // ESC เดี่ยวๆ จะไม่มีไบต์ตามมาในเวลาอันสั้น
+  int next = ReadByte(30);
+  if (next < 0)
+  {
+    return KeyEvent(Key::Escape);
+  }
+  if (next != '[' && next != 'O')
+  {
+    return KeyEvent(Key::None);
+  }
+  // อ่านจนถึงไบต์สุดท้ายของ sequence (0x40-0x7E)
+  int final_byte = ReadByte(30);
+  while (final_byte >= 0 && (final_byte < 0x40 || final_byte > 0x7E))
+  {
+    final_byte = ReadByte(30);
+  }
+  switch (final_byte)
+  {
+  case 'A':
+    return KeyEvent(Key::Up);
+  case 'B':
+    return KeyEvent(Key::Down);
+  case 'C':
+    return KeyEvent(Key::Right);
+  case 'D':
+    return KeyEvent(Key::Left);
+  default:
+    return KeyEvent(Key::None);
+  }
+}
+
+static KeyEvent DecodeKey(int c)
+{
+  switch (c)
+  {
+  case -2:
+  case 3:
+  case 4:
+    return KeyEvent(Key::EndOfInput);
+  case '\r':
+  case '\n':
+    return KeyEvent(Key::Enter);
+  case 8:
+  case 127:
+    return KeyEvent(Key::Backspace);
+  case '\t':
+    return KeyEvent(Key::Tab);
+  case 27:
+    return DecodeEscape();
+  default:
+    return KeyEvent(Key::Character, static_cast<char>(c));
+  }
+}
+#endif
+
+bool KeyboardInput::IsActive()
+{
+  return keyboard_enabled && InputSource::Current().IsInteractive() &&
+         OutputSink::Current().IsTerminal() && StdinIsTerminal() && StdoutIsTerminal();
+}
+
+void KeyboardInput::SetEnabled(bool enabled)
+{
+  keyboard_enabled = enabled;
+}
+
+void KeyboardInput::SetIdleHandler(function<void()> handler)
+{
+  idle_handler = std::move(handler);
+}
+
+KeyEvent KeyboardInput::ReadKey(int timeout_ms)
+{
+  int c = ReadByte(timeout_ms);
+  if (c == -1)
+  {
+    return KeyEvent(Key::None);
+  }
+  return DecodeKey(c);
+}
+
+KeyEvent KeyboardInput::WaitForKey(int tick_ms)
+{
+  Out().flush(); // ให้หน้าจอแสดงครบก่อนรอปุ่ม
+  while (true)
+  {
+    KeyEvent event = ReadKey(tick_ms);
+    if (event.key == Key::EndOfInput)
+    {
+      throw InputExhaustedError();
+    }
+    if (event.key != Key::None)
+    {
+      return event;
+    }
+    if (idle_handler)
+    {
+      idle_handler();
+      Out().flush();
+    }
+  }
+}
+
+// RawModeGuard
+RawModeGuard::RawModeGuard() : active(false)
+{
+  if (raw_mode_depth > 0)
+  {
+    // มี guard ชั้นนอกเปิดโหมด raw ไว้แล้ว
+    ++raw_mode_depth;
+    active = true;
+    return;
+  }
+  if (!StdinIsTerminal())
+  {
+    return;
+  }
+#ifndef _WIN32
+  if (tcgetattr(STDIN_FILENO, &saved_termios) != 0)
+  {
+    return;
+  }
+  termios raw = saved_termios;
+  raw.c_lflag &= ~(ICANON | ECHO | ISIG); // อ่านทีละปุ่ม ไม่แสดงปุ่มที่กด Ctrl+C อ่านเป็นปุ่มปกติ
+  raw.c_iflag &= ~(IXON | ICRNL);
+  raw.c_cc[VMIN] = 1;
+  raw.c_cc[VTIME] = 0;
+  if (tcsetattr(STDIN_FILENO, TCSANOW, &raw) != 0)
+  {
+    return;
+  }
+#endif
+  raw_mode_depth = 1;
+  active = true;
+}
+
+RawModeGuard::~RawModeGuard()
+{
+  if (!active)
+  {
+    return;
+  }
+  if (--raw_mode_depth == 0)
+  {
+#ifndef _WIN32
+    tcsetattr(STDIN_FILENO, TCSANOW, &saved_termios);
+#endif
+  }
+}
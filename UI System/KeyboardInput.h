@@ -0,0 +1,70 @@
+// KeyboardInput.h - ไฟล์ Header สำหรับระบบรับปุ่มกดทีละปุ่ม (Raw-mode keyboard input)
+// เปิดโหมด raw ของเทอร์มินัลเพื่ออ่านปุ่มทันทีโดยไม่ต้องกด Enter รองรับปุ่มลูกศร
+// และการรอปุ่มแบบมีเวลาจำกัด เพื่อให้ UI ทำงานอย่างอื่นต่อได้ระหว่างรอผู้เล่น
+#ifndef KEYBOARDINPUT_H
+#define KEYBOARDINPUT_H
+
+#include <functional>
+
+// ชนิดของปุ่มที่อ่านได้
+enum class Key
+{
+  None,      // ไม่มีปุ่มถูกกดภายในเวลาที่กำหนด
+  Character, // ตัวอักษรทั่วไป (ดูค่าใน KeyEvent::ch)
+  Enter,
+  Escape,
+  Backspace,
+  Tab,
+  Up,
+  Down,
+  Left,
+  Right,
+  EndOfInput // Ctrl+C, Ctrl+D หรือ stdin ถูกปิด
+};
+
+// ผลลัพธ์จากการอ่านปุ่ม 1 ครั้ง
+struct KeyEvent
+{
+  Key key;
+  char ch; // ตัวอักษรเมื่อ key == Key::Character
+
+  KeyEvent(Key k = Key::None, char c = '\0') : key(k), ch(c) {}
+};
+
+class KeyboardInput
+{
+public:
+  // ใช้งานโหมดปุ่มเดียวได้หรือไม่: เปิดอยู่ + อ่านจากคอนโซลจริง + แสดงผลบนเทอร์มินัลจริง
+  // (เมื่ออ่านจากสคริปต์หรือ stdin ถูก redirect จะกลับไปใช้การพิมพ์ทีละบรรทัดตามเดิม)
+  static bool IsActive();
+  static void SetEnabled(bool enabled); // ปิดได้ด้วย --line-input
+
+  // อ่านปุ่ม 1 ปุ่ม รอไม่เกิน timeout_ms มิลลิวินาที (ค่าติดลบ = รอจนกว่าจะมีปุ่ม)
+  // ต้องเรียกภายใน RawModeGuard
+  static KeyEvent ReadKey(int timeout_ms);
+
+  // รอปุ่มถัดไป ระหว่างรอจะเรียก idle handler ทุก tick_ms มิลลิวินาที
+  // โยน InputExhaustedError เมื่อได้ Key::EndOfInput
+  static KeyEvent WaitForKey(int tick_ms = 100);
+
+  // ฟังก์ชันที่ถูกเรียกระหว่างรอปุ่ม (เช่น แอนิเมชันหรือแสดงความคืบหน้าของบอท)
+  // ถูกเรียกจากเธรดของ UI จึงเขียนผ่าน Out() ได้ตามปกติ
+  static void SetIdleHandler(std::function<void()> handler);
+};
+
+// เปิดโหมด raw ของเทอร์มินัลภายใน scope แล้วคืนค่าเดิมเมื่อออกจาก scope (รวมถึงตอนเกิด exception)
+class RawModeGuard
+{
+private:
+  bool active; // เปลี่ยนโหมดเทอร์มินัลสำเร็จหรือไม่
+
+public:
+  RawModeGuard();
+  ~RawModeGuard();
+  RawModeGuard(const RawModeGuard &) = delete;
+  RawModeGuard &operator=(const RawModeGuard &) = delete;
+
+  bool IsActive() const { return active; }
+};
+
+#endif // KEYBOARDINPUT_H
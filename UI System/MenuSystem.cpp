@@ -2,6 +2,11 @@
 // ไฟล์นี้ประกอบด้วยการทำงานของระบบเมนูทั้งหมด รวมถึงการแสดงผล การรับข้อมูล และการจัดการการโต้ตอบกับผู้เล่น
 #include "MenuSystem.h"
 #include "UIHelper.h"
+#include "InputSource.h"
+#include "OutputSink.h"
+#include "KeyboardInput.h"
+#include "../Game Core/Trace.h"
+#include "../Game Core/AllocationProfile.h"
 #include <iostream>
 #include <algorithm>
 #include <limits>
@@ -17,6 +22,7 @@ using namespace std;
 // - player_for_display: ข้อมูลผู้เล่นที่ต้องการแสดงสถานะ
 string MenuSystem::GetUserInput(const string &prompt, bool clear_screen, Player *player_for_display)
 {
+  ALLOC_SCOPE(UI);
   if (clear_screen)
   {
     UIHelper::ClearScreen();
@@ -32,31 +38,120 @@ string MenuSystem::GetUserInput(const string &prompt, bool clear_screen, Player
     player_for_display->displayField();
   }
 
-  cout << "\n"
-       << Colors::BRIGHT_CYAN << prompt << Colors::RESET;
-  string input;
-  getline(cin, input);
-  return input;
+  Out() << "\n"
+        << Colors::BRIGHT_CYAN << prompt << Colors::RESET;
+  return InputSource::NextLine();
 }
 
 // DisplayMenuHeader - แสดงส่วนหัวของเมนู
+// - out: บัฟเฟอร์ที่ใช้ประกอบหน้าจอเมนู
 // - title: ชื่อเมนู
 // - subtitle: ข้อความอธิบายเพิ่มเติม (ถ้ามี)
-void MenuSystem::DisplayMenuHeader(const string &title, const string &subtitle)
+void MenuSystem::DisplayMenuHeader(TextBuffer &out, const string &title, const string &subtitle)
 {
-  UIHelper::PrintSectionHeader(title, Icons::MENU, Colors::BRIGHT_CYAN);
+  UIHelper::AppendSectionHeader(out, title, Icons::MENU, Colors::BRIGHT_CYAN);
   if (!subtitle.empty())
   {
-    cout << Colors::BRIGHT_BLACK << "   " << subtitle << Colors::RESET << "\n";
+    out << Colors::BRIGHT_BLACK << "   " << subtitle << Colors::RESET << "\n";
   }
 }
 
 // DisplayMenuFooter - แสดงส่วนท้ายของเมนูพร้อมคำแนะนำการใช้งานลัด
-void MenuSystem::DisplayMenuFooter()
+void MenuSystem::DisplayMenuFooter(TextBuffer &out)
+{
+  out << "\n";
+  UIHelper::AppendHorizontalLine(out, "─", 70, Colors::BRIGHT_BLACK);
+  UIHelper::AppendShortcuts(out);
+}
+
+// ReadMenuSelection - รับการเลือกเมนูแบบกดปุ่มเดียว (โหมด raw)
+// - ปุ่มลูกศรขึ้น/ลงเลื่อนไฮไลต์ แล้วกด Enter เพื่อเลือก
+// - กดปุ่มที่ตรงกับคีย์ของตัวเลือก (หรือ h/q/s) เพื่อเลือกทันที
+// - ESC เลือกตัวเลือกยกเลิก ("-1") ถ้ามี
+// คืนค่าคีย์ที่เลือกในรูปแบบเดียวกับที่ผู้เล่นพิมพ์ในโหมดปกติ
+string MenuSystem::ReadMenuSelection(const vector<MenuOption> &options, int highlighted)
+{
+  RawModeGuard raw_mode;
+  Out() << "\n"
+        << Colors::BRIGHT_CYAN << "เลือก (↑/↓ + Enter หรือกดปุ่ม): " << Colors::RESET;
+
+  auto move_highlight = [&options, &highlighted](int step)
+  {
+    int count = static_cast<int>(options.size());
+    for (int moved = 1; moved <= count; moved++)
+    {
+      int candidate = ((highlighted + step * moved) % count + count) % count;
+      if (options[candidate].enabled)
+      {
+        RedrawMenuOption(options, highlighted, false);
+        highlighted = candidate;
+        RedrawMenuOption(options, highlighted, true);
+        return;
+      }
+    }
+  };
+
+  string selected;
+  while (selected.empty())
+  {
+    KeyEvent event = KeyboardInput::WaitForKey();
+    switch (event.key)
+    {
+    case Key::Up:
+      if (highlighted >= 0)
+        move_highlight(-1);
+      break;
+    case Key::Down:
+    case Key::Tab:
+      if (highlighted >= 0)
+        move_highlight(1);
+      break;
+    case Key::Enter:
+      if (highlighted >= 0)
+        selected = options[highlighted].key;
+      break;
+    case Key::Escape:
+      for (const auto &option : options)
+      {
+        if (option.key == "-1" && option.enabled)
+          selected = option.key;
+      }
+      break;
+    case Key::Character:
+    {
+      char c = static_cast<char>(tolower(static_cast<unsigned char>(event.ch)));
+      if (c == 'h' || c == 'q' || c == 's')
+      {
+        selected = string(1, c);
+        break;
+      }
+      for (const auto &option : options)
+      {
+        if (option.enabled && option.key.size() == 1 && option.key[0] == event.ch)
+          selected = option.key;
+      }
+      break;
+    }
+    default:
+      break;
+    }
+  }
+
+  Out() << selected << "\n"; // แสดงตัวเลือกเหมือนผู้เล่นพิมพ์เอง
+  return selected;
+}
+
+// RedrawMenuOption - วาดตัวเลือกเมนูบรรทัดเดียวใหม่โดยไม่ต้องล้างหน้าจอ
+// ใช้ตำแหน่งแถวจากโครงร่างของ ShowMenu: ตัวเลือกทั้งหมด, บรรทัดว่าง, เส้นคั่น, ทางลัด, บรรทัดว่าง, คำถาม
+void MenuSystem::RedrawMenuOption(const vector<MenuOption> &options, int index, bool highlighted)
 {
-  cout << "\n";
-  UIHelper::PrintHorizontalLine("─", 70, Colors::BRIGHT_BLACK);
-  UIHelper::PrintShortcuts();
+  if (index < 0 || !OutputSink::Enabled())
+    return;
+  int rows_up = static_cast<int>(options.size()) - index + 4;
+  TextBuffer out;
+  out << "\0337\033[" << rows_up << "A\r\033[2K"; // บันทึกตำแหน่งเคอร์เซอร์ แล้วขึ้นไปยังแถวของตัวเลือก
+  AppendMenuOption(out, options[index], highlighted);
+  out << "\0338"; // กลับไปที่ตำแหน่งเดิม
 }
 
 // Core Menu Functions
@@ -69,6 +164,7 @@ void MenuSystem::DisplayMenuFooter()
 MenuResult MenuSystem::ShowMenu(const string &title, const vector<MenuOption> &options,
                                 const string &subtitle, Player *player_context)
 {
+  ALLOC_SCOPE(UI);
   UIHelper::ClearScreen();
 
   if (player_context)
@@ -80,29 +176,37 @@ MenuResult MenuSystem::ShowMenu(const string &title, const vector<MenuOption> &o
                                0, 0);
   }
 
-  DisplayMenuHeader(title, subtitle);
-
-  // Display options
-  for (size_t i = 0; i < options.size(); i++)
+  // ในโหมดปุ่มเดียวจะไฮไลต์ตัวเลือกแรกที่ใช้งานได้ไว้ก่อน
+  bool single_key = KeyboardInput::IsActive();
+  int highlighted = -1;
+  if (single_key)
   {
-    const auto &option = options[i];
-    string color = option.enabled ? Colors::WHITE : Colors::BRIGHT_BLACK;
-    string status_icon = option.enabled ? " " : Colors::BRIGHT_BLACK + " (ปิดใช้งาน)" + Colors::RESET;
+    for (size_t i = 0; i < options.size() && highlighted < 0; i++)
+    {
+      if (options[i].enabled)
+        highlighted = static_cast<int>(i);
+    }
+  }
 
-    cout << color << "[" << option.key << "] " << option.icon << " "
-         << option.display_text << status_icon << Colors::RESET;
+  // ประกอบทั้งหน้าเมนูในบัฟเฟอร์เดียวแล้วส่งออกก่อนรอรับข้อมูล
+  if (OutputSink::Enabled())
+  {
+    TRACE_SPAN("ui", "MenuSystem::ShowMenu");
+    TextBuffer out;
+    DisplayMenuHeader(out, title, subtitle);
 
-    if (!option.description.empty())
+    // Display options
+    for (size_t i = 0; i < options.size(); i++)
     {
-      cout << Colors::BRIGHT_BLACK << " - " << option.description << Colors::RESET;
+      AppendMenuOption(out, options[i], static_cast<int>(i) == highlighted);
+      out << "\n";
     }
-    cout << "\n";
-  }
 
-  DisplayMenuFooter();
+    DisplayMenuFooter(out);
+  }
 
   // Get input
-  string input = GetUserInput("เลือก: ", false);
+  string input = single_key ? ReadMenuSelection(options, highlighted) : GetUserInput("เลือก: ", false);
 
   // Handle special inputs first
   if (input == "h" || input == "H")
@@ -141,6 +245,7 @@ MenuResult MenuSystem::ShowMenu(const string &title, const vector<MenuOption> &o
 // Game-Specific Menus
 MenuResult MenuSystem::ShowMainPhaseMenu(Player *current_player)
 {
+  ALLOC_SCOPE(UI);
   vector<MenuOption> options = {
       MenuOption("1", "Ride การ์ด", Icons::CROWN, "เปลี่ยน Vanguard"),
       MenuOption("2", "Call ยูนิต", Icons::CARD, "วางการ์ดลง Rear Guard"),
@@ -163,6 +268,7 @@ MenuResult MenuSystem::ShowMainPhaseMenu(Player *current_player)
 
 MenuResult MenuSystem::ShowBattlePhaseMenu(Player *current_player)
 {
+  ALLOC_SCOPE(UI);
   vector<MenuOption> options = {
       MenuOption("1", "เลือก Attacker", Icons::SWORD, "เลือกยูนิตที่จะโจมตี"),
       MenuOption("2", "ดูสนามรวม", Icons::FIELD, "ดูสนามทั้งสองฝ่าย"),
@@ -176,6 +282,7 @@ MenuResult MenuSystem::ShowBattlePhaseMenu(Player *current_player)
 
 MenuResult MenuSystem::ShowRideMenu(Player *current_player)
 {
+  ALLOC_SCOPE(UI);
   if (current_player->getHandSize() == 0)
   {
     UIHelper::PrintWarning("ไม่มีการ์ดบนมือให้ Ride");
@@ -192,13 +299,13 @@ MenuResult MenuSystem::ShowRideMenu(Player *current_player)
   UIHelper::PrintSectionHeader("RIDE PHASE - เลือกการ์ดเพื่อ Ride", Icons::CROWN);
 
   // Show current VG
-  if (current_player->getVanguard().has_value())
+  if (current_player->getVanguard())
   {
-    cout << Colors::YELLOW << "Vanguard ปัจจุบัน: " << Colors::RESET;
-    const Card &vg = current_player->getVanguard().value();
-    cout << UIHelper::FormatCard(vg.getName(), vg.getGrade()) << endl;
-    cout << Colors::BRIGHT_BLACK << "คุณสามารถ Ride เกรด " << (vg.getGrade() + 1)
-         << " หรือเกรดเดียวกัน" << Colors::RESET << "\n\n";
+    Out() << Colors::YELLOW << "Vanguard ปัจจุบัน: " << Colors::RESET;
+    const Card &vg = *current_player->getVanguard();
+    Out() << UIHelper::FormatCard(vg.getNameView(), vg.getGrade()) << endl;
+    Out() << Colors::BRIGHT_BLACK << "คุณสามารถ Ride เกรด " << (vg.getGrade() + 1)
+          << " หรือเกรดเดียวกัน" << Colors::RESET << "\n\n";
   }
 
   // Show hand
@@ -210,6 +317,7 @@ MenuResult MenuSystem::ShowRideMenu(Player *current_player)
 
 MenuResult MenuSystem::ShowCallMenu(Player *current_player)
 {
+  ALLOC_SCOPE(UI);
   if (current_player->getHandSize() == 0)
   {
     UIHelper::PrintWarning("ไม่มีการ์ดบนมือให้ Call");
@@ -240,6 +348,7 @@ MenuResult MenuSystem::ShowCallMenu(Player *current_player)
 
 MenuResult MenuSystem::ShowAttackerMenu(Player *current_player)
 {
+  ALLOC_SCOPE(UI);
   UIHelper::ClearScreen();
   UIHelper::PrintSectionHeader("เลือก Attacker", Icons::SWORD);
 
@@ -257,7 +366,7 @@ MenuResult MenuSystem::ShowAttackerMenu(Player *current_player)
   vector<MenuOption> options;
   for (size_t i = 0; i < attackers.size(); i++)
   {
-    string icon = (attackers[i].first == 0) ? Icons::CROWN : Icons::SWORD;
+    string_view icon = (attackers[i].first == 0) ? Icons::CROWN : Icons::SWORD;
     options.emplace_back(to_string(i), attackers[i].second, icon);
   }
   options.emplace_back("-1", "ยกเลิก", Icons::BACK);
@@ -275,18 +384,19 @@ MenuResult MenuSystem::ShowAttackerMenu(Player *current_player)
 
 MenuResult MenuSystem::ShowGuardMenu(Player *current_player, int incoming_power)
 {
+  ALLOC_SCOPE(UI);
   UIHelper::ClearScreen();
   UIHelper::PrintSectionHeader("GUARD PHASE - ป้องกัน", Icons::SHIELD);
 
-  cout << Colors::BRIGHT_RED << Icons::SWORD << " พลังโจมตีที่เข้ามา: "
-       << incoming_power << Colors::RESET << "\n\n";
+  Out() << Colors::BRIGHT_RED << Icons::SWORD << " พลังโจมตีที่เข้ามา: "
+        << incoming_power << Colors::RESET << "\n\n";
 
   current_player->displayHand(true);
   current_player->displayGuardianZone();
 
-  cout << "\n"
-       << Colors::BRIGHT_BLUE << Icons::SHIELD << " Shield รวมปัจจุบัน: "
-       << current_player->getGuardianZoneShieldTotal() << Colors::RESET << "\n\n";
+  Out() << "\n"
+        << Colors::BRIGHT_BLUE << Icons::SHIELD << " Shield รวมปัจจุบัน: "
+        << current_player->getGuardianZoneShieldTotal() << Colors::RESET << "\n\n";
 
   vector<MenuOption> options = {
       MenuOption("1", "เลือกการ์ดเพื่อ Guard", Icons::SHIELD, "ป้องกันด้วยการ์ดจากมือ"),
@@ -304,6 +414,7 @@ MenuResult MenuSystem::ShowGuardMenu(Player *current_player, int incoming_power)
 // Input Functions
 int MenuSystem::GetCardSelectionFromHand(Player *player, const string &action_name, bool allow_cancel)
 {
+  ALLOC_SCOPE(UI);
   if (player->getHandSize() == 0)
   {
     UIHelper::PrintError("ไม่มีการ์ดบนมือ");
@@ -327,40 +438,41 @@ int MenuSystem::GetCardSelectionFromHand(Player *player, const string &action_na
 int MenuSystem::GetRCPositionSelection(const std::string & /*action_name*/)
 {
   UIHelper::PrintInfo("เลือกตำแหน่ง Rear Guard Circle:");
-  cout << Colors::CYAN << "[0] FL (Front Left)   [1] FR (Front Right)" << Colors::RESET << "\n";
-  cout << Colors::CYAN << "[2] BL (Back Left)    [3] BC (Back Center)    [4] BR (Back Right)" << Colors::RESET << "\n";
+  Out() << Colors::CYAN << "[0] FL (Front Left)   [1] FR (Front Right)" << Colors::RESET << "\n";
+  Out() << Colors::CYAN << "[2] BL (Back Left)    [3] BC (Back Center)    [4] BR (Back Right)" << Colors::RESET << "\n";
 
   return GetIntegerInput("เลือกตำแหน่ง RC (0-4) หรือ -1 เพื่อยกเลิก: ", -1, 4);
 }
 
 int MenuSystem::GetTargetSelection(Player *attacker, Player *defender)
 {
+  ALLOC_SCOPE(UI);
   UIHelper::ClearScreen();
   UIHelper::PrintSectionHeader("เลือกเป้าหมายการโจมตี", Icons::TARGET);
 
   attacker->displayField();
-  cout << "\n"
-       << Colors::BRIGHT_RED << "--- สนามของฝ่ายป้องกัน ("
-       << defender->getName() << ") ---" << Colors::RESET << "\n";
+  Out() << "\n"
+        << Colors::BRIGHT_RED << "--- สนามของฝ่ายป้องกัน ("
+        << defender->getName() << ") ---" << Colors::RESET << "\n";
   defender->displayField(true);
 
   vector<pair<int, string>> targets;
 
   // Add VG as target
-  if (defender->getVanguard().has_value())
+  if (defender->getVanguard())
   {
-    targets.push_back({0, "VC: " + defender->getVanguard().value().getName()});
+    targets.push_back({0, UIHelper::Join({"VC: ", defender->getVanguard()->getNameView()})});
   }
 
   // Add front row RCs as targets
-  const auto &rcs = defender->getRearGuards();
-  if (rcs[0].has_value())
+  const auto rcs = defender->getRearGuards();
+  if (rcs[0])
   { // RC_FRONT_LEFT
-    targets.push_back({1, "RC FL: " + rcs[0].value().getName()});
+    targets.push_back({1, UIHelper::Join({"RC FL: ", rcs[0]->getNameView()})});
   }
-  if (rcs[1].has_value())
+  if (rcs[1])
   { // RC_FRONT_RIGHT
-    targets.push_back({2, "RC FR: " + rcs[1].value().getName()});
+    targets.push_back({2, UIHelper::Join({"RC FR: ", rcs[1]->getNameView()})});
   }
 
   if (targets.empty())
@@ -369,11 +481,11 @@ int MenuSystem::GetTargetSelection(Player *attacker, Player *defender)
     return -1;
   }
 
-  cout << "\n"
-       << Colors::BRIGHT_YELLOW << "เป้าหมายที่โจมตีได้:" << Colors::RESET << "\n";
+  Out() << "\n"
+        << Colors::BRIGHT_YELLOW << "เป้าหมายที่โจมตีได้:" << Colors::RESET << "\n";
   for (size_t i = 0; i < targets.size(); i++)
   {
-    cout << "[" << i << "] " << targets[i].second << "\n";
+    Out() << "[" << i << "] " << targets[i].second << "\n";
   }
 
   int selection = GetIntegerInput("เลือกเป้าหมาย: ", 0, static_cast<int>(targets.size()) - 1);
@@ -383,13 +495,14 @@ int MenuSystem::GetTargetSelection(Player *attacker, Player *defender)
 // Confirmation Functions
 bool MenuSystem::ShowConfirmation(const string &message, const string &details)
 {
+  ALLOC_SCOPE(UI);
   UIHelper::ClearScreen();
   UIHelper::PrintSectionHeader("ยืนยันการกระทำ", Icons::HELP);
 
-  cout << Colors::BRIGHT_YELLOW << Icons::WARNING << " " << message << Colors::RESET << "\n";
+  Out() << Colors::BRIGHT_YELLOW << Icons::WARNING << " " << message << Colors::RESET << "\n";
   if (!details.empty())
   {
-    cout << Colors::BRIGHT_BLACK << details << Colors::RESET << "\n";
+    Out() << Colors::BRIGHT_BLACK << details << Colors::RESET << "\n";
   }
 
   return ShowYesNoPrompt("คุณต้องการดำเนินการต่อหรือไม่?");
@@ -397,8 +510,9 @@ bool MenuSystem::ShowConfirmation(const string &message, const string &details)
 
 bool MenuSystem::ShowYesNoPrompt(const string &question, bool default_yes)
 {
-  string prompt = question + " (" +
-                  (default_yes ? Colors::GREEN + "Y" + Colors::RESET + "/n" : "y/" + Colors::GREEN + "N" + Colors::RESET) + "): ";
+  ALLOC_SCOPE(UI);
+  string prompt = default_yes ? UIHelper::Join({question, " (", Colors::GREEN, "Y", Colors::RESET, "/n): "})
+                              : UIHelper::Join({question, " (y/", Colors::GREEN, "N", Colors::RESET, "): "});
 
   char response = GetCharInput(prompt, "yYnN");
 
@@ -412,6 +526,7 @@ bool MenuSystem::ShowYesNoPrompt(const string &question, bool default_yes)
 // Information Display
 void MenuSystem::ShowCardDetails(const Card &card)
 {
+  ALLOC_SCOPE(UI);
   UIHelper::ClearScreen();
   UIHelper::PrintCardPreview(card.getName(), card.getGrade(), card.getPower(),
                              card.getShield(), card.getCritical(),
@@ -421,17 +536,18 @@ void MenuSystem::ShowCardDetails(const Card &card)
 
 void MenuSystem::ShowFieldOverview(Player *player1, Player *player2, Player *current_player)
 {
+  ALLOC_SCOPE(UI);
   UIHelper::ClearScreen();
   UIHelper::PrintSectionHeader("FIELD OVERVIEW", Icons::FIELD);
   // Show current player's field
-  cout << Colors::BRIGHT_CYAN << "=== " << current_player->getName() << " (Your Field) ===" << Colors::RESET << "\n";
+  Out() << Colors::BRIGHT_CYAN << "=== " << current_player->getName() << " (Your Field) ===" << Colors::RESET << "\n";
   current_player->displayField();
   // Show opponent's field if provided
   if (player1 && player2)
   {
     Player *opponent = (current_player == player1) ? player2 : player1;
-    cout << "\n"
-         << Colors::BRIGHT_RED << "=== " << opponent->getName() << " (Opponent Field) ===" << Colors::RESET << "\n";
+    Out() << "\n"
+          << Colors::BRIGHT_RED << "=== " << opponent->getName() << " (Opponent Field) ===" << Colors::RESET << "\n";
     opponent->displayField();
   }
   WaitForKeyPress("กด Enter เพื่อกลับ...");
@@ -439,28 +555,29 @@ void MenuSystem::ShowFieldOverview(Player *player1, Player *player2, Player *cur
 
 void MenuSystem::ShowGameHelp(const string &current_phase)
 {
+  ALLOC_SCOPE(UI);
   UIHelper::ClearScreen();
   UIHelper::PrintSectionHeader("GAME HELP", Icons::HELP);
 
-  cout << Colors::BRIGHT_CYAN << "📖 การควบคุมเกม:" << Colors::RESET << "\n";
-  cout << "[h] - แสดงความช่วยเหลือ\n";
-  cout << "[s] - แสดงสถานะเต็ม\n";
-  cout << "[f] - แสดงสนามรวม\n";
-  cout << "[q] - ออกจากเกม\n\n";
+  Out() << Colors::BRIGHT_CYAN << "📖 การควบคุมเกม:" << Colors::RESET << "\n";
+  Out() << "[h] - แสดงความช่วยเหลือ\n";
+  Out() << "[s] - แสดงสถานะเต็ม\n";
+  Out() << "[f] - แสดงสนามรวม\n";
+  Out() << "[q] - ออกจากเกม\n\n";
 
-  cout << Colors::BRIGHT_YELLOW << "🎯 วัตถุประสงค์:" << Colors::RESET << "\n";
-  cout << "• ทำดาเมจใส่คู่แข่งครบ " << Player::MAX_DAMAGE << " แต้ม\n";
-  cout << "• หรือทำให้เด็คของคู่แข่งหมด\n\n";
+  Out() << Colors::BRIGHT_YELLOW << "🎯 วัตถุประสงค์:" << Colors::RESET << "\n";
+  Out() << "• ทำดาเมจใส่คู่แข่งครบ " << Player::MAX_DAMAGE << " แต้ม\n";
+  Out() << "• หรือทำให้เด็คของคู่แข่งหมด\n\n";
 
-  cout << Colors::BRIGHT_GREEN << "⚔️ การต่อสู้:" << Colors::RESET << "\n";
-  cout << "• เลือก Attacker จาก VC หรือ RC แถวหน้า\n";
-  cout << "• เลือก Booster จากแถวหลัง (ถ้ามี)\n";
-  cout << "• VG โจมตี = Drive Check\n";
-  cout << "• Hit = ฝ่ายตรงข้าม Damage Check\n\n";
+  Out() << Colors::BRIGHT_GREEN << "⚔️ การต่อสู้:" << Colors::RESET << "\n";
+  Out() << "• เลือก Attacker จาก VC หรือ RC แถวหน้า\n";
+  Out() << "• เลือก Booster จากแถวหลัง (ถ้ามี)\n";
+  Out() << "• VG โจมตี = Drive Check\n";
+  Out() << "• Hit = ฝ่ายตรงข้าม Damage Check\n\n";
 
   if (!current_phase.empty())
   {
-    cout << Colors::BRIGHT_MAGENTA << "[" << current_phase << "]" << Colors::RESET << "\n";
+    Out() << Colors::BRIGHT_MAGENTA << "[" << current_phase << "]" << Colors::RESET << "\n";
     ShowPhaseHelp(current_phase);
   }
   WaitForKeyPress();
@@ -468,30 +585,32 @@ void MenuSystem::ShowGameHelp(const string &current_phase)
 
 void MenuSystem::ShowPhaseHelp(const string &phase_name)
 {
-  cout << Colors::BRIGHT_MAGENTA << "📋 " << phase_name << " Help:" << Colors::RESET << "\n";
+  ALLOC_SCOPE(UI);
+  Out() << Colors::BRIGHT_MAGENTA << "📋 " << phase_name << " Help:" << Colors::RESET << "\n";
 
   if (phase_name == "MAIN PHASE")
   {
-    cout << "• Ride: เปลี่ยน VG (เกรด +1 หรือเท่าเดิม)\n";
-    cout << "• Call: วางยูนิตลง RC (เกรด ≤ VG)\n";
+    Out() << "• Ride: เปลี่ยน VG (เกรด +1 หรือเท่าเดิม)\n";
+    Out() << "• Call: วางยูนิตลง RC (เกรด ≤ VG)\n";
   }
   else if (phase_name == "BATTLE PHASE")
   {
-    cout << "• เลือก Attacker (VC/RC แถวหน้า)\n";
-    cout << "• เลือก Booster (แถวหลัง G0-1)\n";
-    cout << "• โจมตีได้หลายครั้งต่อเทิร์น\n";
+    Out() << "• เลือก Attacker (VC/RC แถวหน้า)\n";
+    Out() << "• เลือก Booster (แถวหลัง G0-1)\n";
+    Out() << "• โจมตีได้หลายครั้งต่อเทิร์น\n";
   }
   else if (phase_name == "GUARD PHASE")
   {
-    cout << "• ใช้การ์ดจากมือเพื่อป้องกัน\n";
-    cout << "• Shield รวม ≥ Attack Power = ป้องกันสำเร็จ\n";
+    Out() << "• ใช้การ์ดจากมือเพื่อป้องกัน\n";
+    Out() << "• Shield รวม ≥ Attack Power = ป้องกันสำเร็จ\n";
   }
-  cout << "\n";
+  Out() << "\n";
 }
 
 // Game State Functions
 MenuResult MenuSystem::ShowGameStartMenu()
 {
+  ALLOC_SCOPE(UI);
   UIHelper::PrintGameTitle();
 
   vector<MenuOption> options = {
@@ -504,23 +623,24 @@ MenuResult MenuSystem::ShowGameStartMenu()
 
 void MenuSystem::ShowGameOverScreen(Player *winner, Player *loser, const string &reason)
 {
+  ALLOC_SCOPE(UI);
   UIHelper::ClearScreen();
   UIHelper::PrintSectionHeader("GAME OVER", Icons::VICTORY, Colors::BRIGHT_YELLOW);
 
-  cout << "\n"
-       << Colors::BRIGHT_GREEN << Icons::VICTORY << " ผู้ชนะ: "
-       << Colors::BOLD << winner->getName() << Colors::RESET << "\n";
-  cout << Colors::BRIGHT_RED << Icons::SKULL << " ผู้แพ้: "
-       << loser->getName() << Colors::RESET << "\n\n";
+  Out() << "\n"
+        << Colors::BRIGHT_GREEN << Icons::VICTORY << " ผู้ชนะ: "
+        << Colors::BOLD << winner->getName() << Colors::RESET << "\n";
+  Out() << Colors::BRIGHT_RED << Icons::SKULL << " ผู้แพ้: "
+        << loser->getName() << Colors::RESET << "\n\n";
 
-  cout << Colors::BRIGHT_CYAN << "สาเหตุ: " << reason << Colors::RESET << "\n\n";
+  Out() << Colors::BRIGHT_CYAN << "สาเหตุ: " << reason << Colors::RESET << "\n\n";
 
   // Show final stats
-  cout << Colors::BRIGHT_YELLOW << "📊 สถิติสุดท้าย:" << Colors::RESET << "\n";
-  cout << winner->getName() << " - ดาเมจ: " << winner->getDamageCount()
-       << "/" << Player::MAX_DAMAGE << ", เด็ค: " << winner->getDeck().getSize() << " ใบ\n";
-  cout << loser->getName() << " - ดาเมจ: " << loser->getDamageCount()
-       << "/" << Player::MAX_DAMAGE << ", เด็ค: " << loser->getDeck().getSize() << " ใบ\n\n";
+  Out() << Colors::BRIGHT_YELLOW << "📊 สถิติสุดท้าย:" << Colors::RESET << "\n";
+  Out() << winner->getName() << " - ดาเมจ: " << winner->getDamageCount()
+        << "/" << Player::MAX_DAMAGE << ", เด็ค: " << winner->getDeck().getSize() << " ใบ\n";
+  Out() << loser->getName() << " - ดาเมจ: " << loser->getDamageCount()
+        << "/" << Player::MAX_DAMAGE << ", เด็ค: " << loser->getDeck().getSize() << " ใบ\n\n";
 
   UIHelper::PrintBox("ขอบคุณที่เล่น FIBO Card Commandos!", "THANK YOU",
                      Colors::BRIGHT_MAGENTA, Colors::BRIGHT_WHITE);
@@ -528,14 +648,15 @@ void MenuSystem::ShowGameOverScreen(Player *winner, Player *loser, const string
 
 void MenuSystem::ShowTurnStartScreen(Player *current_player, int turn_number)
 {
+  ALLOC_SCOPE(UI);
   UIHelper::ClearScreen();
   UIHelper::PrintPhaseHeader("TURN START", current_player->getName(), turn_number);
 
   current_player->displayField();
 
-  cout << "\n"
-       << Colors::BRIGHT_GREEN << Icons::CONFIRM << " ยูนิตทั้งหมด Stand แล้ว" << Colors::RESET << "\n";
-  cout << Colors::BRIGHT_CYAN << Icons::CARD << " จั่วการ์ด 1 ใบ" << Colors::RESET << "\n\n";
+  Out() << "\n"
+        << Colors::BRIGHT_GREEN << Icons::CONFIRM << " ยูนิตทั้งหมด Stand แล้ว" << Colors::RESET << "\n";
+  Out() << Colors::BRIGHT_CYAN << Icons::CARD << " จั่วการ์ด 1 ใบ" << Colors::RESET << "\n\n";
 
   WaitForKeyPress("กด Enter เพื่อเริ่มเทิร์น...");
 }
@@ -548,25 +669,36 @@ void MenuSystem::WaitForKeyPress(const string &message)
 
 string MenuSystem::FormatMenuOption(const MenuOption &option, int index, bool numbered)
 {
-  string result = "";
+  string index_text = to_string(index);
+  string_view label = (numbered && index >= 0) ? string_view(index_text) : string_view(option.key);
+  return UIHelper::Join({"[", label, "] ", option.icon, " ", option.display_text,
+                         option.description.empty() ? "" : " - ", option.description});
+}
 
-  if (numbered && index >= 0)
+// AppendMenuOption - เขียนตัวเลือกเมนู 1 บรรทัดลงบัฟเฟอร์ (ไม่รวม '\n')
+// ตัวเลือกที่ปิดใช้งานจะเป็นสีเทา ตัวเลือกที่ถูกไฮไลต์จะแสดงแบบสลับสี
+void MenuSystem::AppendMenuOption(TextBuffer &out, const MenuOption &option, bool highlighted)
+{
+  out << (option.enabled ? Colors::WHITE : Colors::BRIGHT_BLACK);
+  if (highlighted)
+  {
+    out << Colors::REVERSE;
+  }
+  out << "[" << option.key << "] " << option.icon << " " << option.display_text;
+  if (option.enabled)
   {
-    result += "[" + to_string(index) + "] ";
+    out << " ";
   }
   else
   {
-    result += "[" + option.key + "] ";
+    out << Colors::BRIGHT_BLACK << " (ปิดใช้งาน)" << Colors::RESET;
   }
-
-  result += option.icon + " " + option.display_text;
+  out << Colors::RESET;
 
   if (!option.description.empty())
   {
-    result += " - " + option.description;
+    out << Colors::BRIGHT_BLACK << " - " << option.description << Colors::RESET;
   }
-
-  return result;
 }
 
 void MenuSystem::ShowLoadingScreen(const string &message, int duration_ms)
@@ -577,11 +709,12 @@ void MenuSystem::ShowLoadingScreen(const string &message, int duration_ms)
 // Advanced Input
 string MenuSystem::GetPlayerName(const string &prompt)
 {
+  ALLOC_SCOPE(UI);
   string name;
   while (true)
   {
-    cout << Colors::BRIGHT_CYAN << prompt << Colors::RESET;
-    getline(cin, name);
+    Out() << Colors::BRIGHT_CYAN << prompt << Colors::RESET;
+    name = InputSource::NextLine();
 
     if (!name.empty() && name.length() <= 20)
     {
@@ -594,13 +727,14 @@ string MenuSystem::GetPlayerName(const string &prompt)
 
 int MenuSystem::GetIntegerInput(const string &prompt, int min_val, int max_val, Player *player_context)
 {
+  ALLOC_SCOPE(UI);
   int value;
   string input;
 
   while (true)
   {
-    cout << Colors::BRIGHT_CYAN << prompt << Colors::RESET;
-    getline(cin, input);
+    Out() << Colors::BRIGHT_CYAN << prompt << Colors::RESET;
+    input = InputSource::NextLine();
 
     // Handle special commands
     if (input == "h" && player_context)
@@ -633,12 +767,32 @@ int MenuSystem::GetIntegerInput(const string &prompt, int min_val, int max_val,
 
 char MenuSystem::GetCharInput(const std::string &prompt, const std::string &valid_chars, [[maybe_unused]] Player *player_context)
 {
+  ALLOC_SCOPE(UI);
   string input;
 
+  if (KeyboardInput::IsActive())
+  {
+    // โหมดปุ่มเดียว: รับทันทีที่กดปุ่มที่ถูกต้อง ไม่ต้องกด Enter
+    RawModeGuard raw_mode;
+    Out() << Colors::BRIGHT_CYAN << prompt << Colors::RESET;
+    while (true)
+    {
+      KeyEvent event = KeyboardInput::WaitForKey();
+      if (event.key != Key::Character)
+        continue;
+      char c = static_cast<char>(tolower(static_cast<unsigned char>(event.ch)));
+      if (valid_chars.find(c) != string::npos)
+      {
+        Out() << event.ch << "\n";
+        return c;
+      }
+    }
+  }
+
   while (true)
   {
-    cout << Colors::BRIGHT_CYAN << prompt << Colors::RESET;
-    getline(cin, input);
+    Out() << Colors::BRIGHT_CYAN << prompt << Colors::RESET;
+    input = InputSource::NextLine();
 
     if (input.length() == 1)
     {
@@ -651,4 +805,4 @@ char MenuSystem::GetCharInput(const std::string &prompt, const std::string &vali
 
     UIHelper::PrintError("กรุณาเลือกจาก: " + valid_chars);
   }
-}
\ No newline at end of file
+}
@@ -4,22 +4,25 @@
 #define MENUSYSTEM_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
 #include "../Game Core/Player.h"
 
+class TextBuffer;
+
 // โครงสร้างตัวเลือกเมนู (Menu Option Structure)
 struct MenuOption
 {
-  std::string key;          // คีย์สำหรับการเลือก (เช่น "1", "r", "h")
-  std::string display_text; // ข้อความที่แสดงในเมนู
-  std::string icon;         // ไอคอนประกอบรายการเมนู
-  std::string description;  // คำอธิบายเพิ่มเติมของตัวเลือก
-  bool enabled;             // สถานะการเปิด/ปิดใช้งานตัวเลือก
+  std::string key;              // คีย์สำหรับการเลือก (เช่น "1", "r", "h")
+  std::string display_text;     // ข้อความที่แสดงในเมนู
+  std::string_view icon;        // ไอคอนประกอบรายการเมนู (ชี้ไปที่ค่าคงที่ใน Icons)
+  std::string_view description; // คำอธิบายเพิ่มเติมของตัวเลือก (ข้อความคงที่)
+  bool enabled;                 // สถานะการเปิด/ปิดใช้งานตัวเลือก
 
   // คอนสตรัคเตอร์สำหรับสร้างตัวเลือกเมนูใหม่
-  MenuOption(const std::string &k, const std::string &text, const std::string &ic = "",
-             const std::string &desc = "", bool en = true)
+  MenuOption(const std::string &k, const std::string &text, std::string_view ic = "",
+             std::string_view desc = "", bool en = true)
       : key(k), display_text(text), icon(ic), description(desc), enabled(en) {}
 };
 
@@ -42,8 +45,13 @@ private:
   // ฟังก์ชันช่วยเหลือภายใน
   static std::string GetUserInput(const std::string &prompt, bool clear_screen = true,
                                   Player *player_for_display = nullptr);                     // รับข้อมูลจากผู้ใช้
-  static void DisplayMenuHeader(const std::string &title, const std::string &subtitle = ""); // แสดงส่วนหัวของเมนู
-  static void DisplayMenuFooter();                                                           // แสดงส่วนท้ายของเมนู
+  static void DisplayMenuHeader(TextBuffer &out, const std::string &title,
+                                const std::string &subtitle = ""); // แสดงส่วนหัวของเมนู
+  static void DisplayMenuFooter(TextBuffer &out);                   // แสดงส่วนท้ายของเมนู
+  static std::string ReadMenuSelection(const std::vector<MenuOption> &options,
+                                       int highlighted);            // เลือกเมนูด้วยปุ่มเดียว/ปุ่มลูกศร (โหมด raw)
+  static void RedrawMenuOption(const std::vector<MenuOption> &options, int index,
+                               bool highlighted);                   // วาดตัวเลือกเมนูบรรทัดเดียวใหม่
 
 public:
   // ฟังก์ชันหลักของเมนู (Core Menu Functions)
@@ -83,6 +91,7 @@ public:
   // ฟังก์ชันอรรถประโยชน์ (Utility Functions)
   static void WaitForKeyPress(const std::string &message = "");                                        // รอการกดปุ่มจากผู้ใช้
   static std::string FormatMenuOption(const MenuOption &option, int index = -1, bool numbered = true); // จัดรูปแบบตัวเลือกเมนู
+  static void AppendMenuOption(TextBuffer &out, const MenuOption &option, bool highlighted = false);  // เขียนตัวเลือกเมนูลงบัฟเฟอร์
   static void ShowLoadingScreen(const std::string &message, int duration_ms = 1000);                   // แสดงหน้าจอโหลด
 
   // การรับข้อมูลขั้นสูง (Advanced Input)
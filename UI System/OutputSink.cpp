@@ -0,0 +1,297 @@
+// OutputSink.cpp - การดำเนินการของระบบปลายทางการแสดงผล
+#include "OutputSink.h"
+#include <streambuf>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+namespace
+{
+  // streambuf ที่รวบรวมข้อความไว้ในบัฟเฟอร์ของเธรดแล้วส่งต่อให้ sink เป็นก้อน
+  class SinkStreamBuf : public streambuf
+  {
+  private:
+    char buffer[4096];
+    OutputSink *sink = nullptr;
+
+    void SendBuffer()
+    {
+      ptrdiff_t pending = pptr() - pbase();
+      if (pending > 0 && sink)
+      {
+        sink->Write(pbase(), static_cast<size_t>(pending));
+      }
+      setp(buffer, buffer + sizeof(buffer));
+    }
+
+  public:
+    SinkStreamBuf() { setp(buffer, buffer + sizeof(buffer)); }
+
+    void SetSink(OutputSink *new_sink)
+    {
+      sync();
+      sink = new_sink;
+    }
+
+  protected:
+    int_type overflow(int_type ch) override
+    {
+      SendBuffer();
+      if (!traits_type::eq_int_type(ch, traits_type::eof()))
+      {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+      }
+      return traits_type::not_eof(ch);
+    }
+
+    streamsize xsputn(const char *s, streamsize n) override
+    {
+      if (n > epptr() - pptr())
+      {
+        SendBuffer();
+        // ข้อความยาวกว่าบัฟเฟอร์ทั้งก้อน - ส่งตรงโดยไม่ต้องคัดลอก
+        if (n >= static_cast<streamsize>(sizeof(buffer)))
+        {
+          if (sink)
+            sink->Write(s, static_cast<size_t>(n));
+          return n;
+        }
+      }
+      memcpy(pptr(), s, static_cast<size_t>(n));
+      pbump(static_cast<int>(n));
+      return n;
+    }
+
+    int sync() override
+    {
+      SendBuffer();
+      if (sink)
+        sink->Flush();
+      return 0;
+    }
+  };
+
+  // สตรีมของแต่ละเธรดที่ผูกกับ sink ปัจจุบัน
+  struct ThreadOutput
+  {
+    SinkStreamBuf stream_buffer;
+    ostream stream;
+    OutputSink *sink;
+
+    ThreadOutput();
+    ~ThreadOutput() { stream_buffer.pubsync(); }
+    void Bind(OutputSink *new_sink);
+  };
+
+  StdoutSink stdout_sink;
+  thread_local ThreadOutput thread_output;
+
+  ThreadOutput::ThreadOutput() : stream(nullptr), sink(nullptr)
+  {
+    Bind(&stdout_sink);
+  }
+
+  void ThreadOutput::Bind(OutputSink *new_sink)
+  {
+    stream_buffer.SetSink(new_sink);
+    sink = new_sink;
+    if (new_sink->IsNull())
+    {
+      stream.rdbuf(nullptr); // ตั้ง badbit ให้ทุก operator<< จบทันที
+    }
+    else
+    {
+      stream.rdbuf(&stream_buffer);
+      stream.clear();
+    }
+  }
+}
+
+OutputSink &OutputSink::Current()
+{
+  return *thread_output.sink;
+}
+
+void OutputSink::SetCurrent(OutputSink *sink)
+{
+  thread_output.Bind(sink ? sink : &stdout_sink);
+}
+
+bool OutputSink::Enabled()
+{
+  return !thread_output.sink->IsNull();
+}
+
+unique_ptr<OutputSink> OutputSink::Create(const string &spec)
+{
+  if (spec == "stdout")
+  {
+    return make_unique<StdoutSink>();
+  }
+  if (spec == "null")
+  {
+    return make_unique<NullSink>();
+  }
+  if (spec.rfind("file:", 0) == 0 && spec.size() > 5)
+  {
+    auto file_sink = make_unique<FileSink>(spec.substr(5));
+    if (!file_sink->IsOpen())
+    {
+      return nullptr;
+    }
+    return file_sink;
+  }
+  if (spec == "ring")
+  {
+    return make_unique<RingBufferSink>();
+  }
+  if (spec.rfind("ring:", 0) == 0)
+  {
+    try
+    {
+      long long capacity = stoll(spec.substr(5));
+      if (capacity > 0)
+      {
+        return make_unique<RingBufferSink>(static_cast<size_t>(capacity));
+      }
+    }
+    catch (...)
+    {
+    }
+  }
+  return nullptr;
+}
+
+ostream &Out()
+{
+  return thread_output.stream;
+}
+
+// StdoutSink
+void StdoutSink::Write(const char *data, size_t size)
+{
+  fwrite(data, 1, size, stdout);
+}
+
+void StdoutSink::Flush()
+{
+  fflush(stdout);
+}
+
+// FileSink
+FileSink::FileSink(const string &path, size_t buffer_size)
+    : file(fopen(path.c_str(), "wb")), buffer(max<size_t>(buffer_size, 1)), used(0)
+{
+}
+
+FileSink::~FileSink()
+{
+  FlushToDisk();
+  if (file)
+  {
+    fclose(file);
+  }
+}
+
+bool FileSink::IsOpen() const
+{
+  return file != nullptr;
+}
+
+void FileSink::FlushBuffer()
+{
+  if (file && used > 0)
+  {
+    fwrite(buffer.data(), 1, used, file);
+  }
+  used = 0;
+}
+
+void FileSink::Write(const char *data, size_t size)
+{
+  if (used + size > buffer.size())
+  {
+    FlushBuffer();
+    if (size > buffer.size())
+    {
+      if (file)
+        fwrite(data, 1, size, file);
+      return;
+    }
+  }
+  memcpy(buffer.data() + used, data, size);
+  used += size;
+}
+
+void FileSink::FlushToDisk()
+{
+  FlushBuffer();
+  if (file)
+  {
+    fflush(file);
+  }
+}
+
+// RingBufferSink
+RingBufferSink::RingBufferSink(size_t capacity)
+    : ring(max<size_t>(capacity, 1)), head(0), stored(0)
+{
+}
+
+void RingBufferSink::Write(const char *data, size_t size)
+{
+  // เก็บเฉพาะส่วนท้ายที่พอดีกับความจุ
+  if (size > ring.size())
+  {
+    data += size - ring.size();
+    size = ring.size();
+  }
+  size_t first_part = min(size, ring.size() - head);
+  memcpy(ring.data() + head, data, first_part);
+  memcpy(ring.data(), data + first_part, size - first_part);
+  head = (head + size) % ring.size();
+  stored = min(stored + size, ring.size());
+}
+
+string RingBufferSink::GetContents() const
+{
+  string contents;
+  contents.reserve(stored);
+  size_t start = (head + ring.size() - stored) % ring.size();
+  size_t first_part = min(stored, ring.size() - start);
+  contents.append(ring.data() + start, first_part);
+  contents.append(ring.data(), stored - first_part);
+  return contents;
+}
+
+bool RingBufferSink::DumpTo(const string &path) const
+{
+  FILE *dump = fopen(path.c_str(), "wb");
+  if (!dump)
+  {
+    return false;
+  }
+  string contents = GetContents();
+  fwrite(contents.data(), 1, contents.size(), dump);
+  fclose(dump);
+  return true;
+}
+
+void RingBufferSink::Clear()
+{
+  head = 0;
+  stored = 0;
+}
+
+// ScopedOutputSink
+ScopedOutputSink::ScopedOutputSink(OutputSink *sink) : previous(&OutputSink::Current())
+{
+  OutputSink::SetCurrent(sink);
+}
+
+ScopedOutputSink::~ScopedOutputSink()
+{
+  OutputSink::SetCurrent(previous);
+}
@@ -0,0 +1,108 @@
+// OutputSink.h - ไฟล์ Header สำหรับระบบปลายทางการแสดงผล (Output Sink)
+// ทุกจุดที่พิมพ์ข้อความในเกมจะเขียนผ่าน Out() ซึ่งส่งต่อไปยัง sink ที่เลือกไว้
+// ทำให้เลือกได้ว่าจะส่งผลลัพธ์ไปที่หน้าจอ ไฟล์ บัฟเฟอร์วงแหวน หรือทิ้งไปเลย
+#ifndef OUTPUTSINK_H
+#define OUTPUTSINK_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <memory>
+#include <ostream>
+
+// คลาสฐานของปลายทางการแสดงผล
+class OutputSink
+{
+public:
+  virtual ~OutputSink() = default;
+
+  virtual void Write(const char *data, size_t size) = 0; // เขียนข้อมูลดิบ
+  virtual void Flush() {}                                // ทำให้ข้อมูลที่เขียนไปแล้วมองเห็นได้ทันที
+  virtual bool IsNull() const { return false; }          // sink นี้ทิ้งข้อมูลทั้งหมดหรือไม่
+  virtual bool IsTerminal() const { return false; }      // sink นี้คือหน้าจอเทอร์มินัลจริงหรือไม่
+
+  // sink ที่ใช้งานอยู่ของเธรดปัจจุบัน (ค่าเริ่มต้นคือ stdout)
+  static OutputSink &Current();
+  static void SetCurrent(OutputSink *sink); // nullptr = กลับไปใช้ stdout
+
+  // มีคนอ่านผลลัพธ์หรือไม่ - ใช้ข้ามการจัดรูปแบบข้อความที่ไม่มีใครเห็น
+  static bool Enabled();
+
+  // สร้าง sink จากข้อความกำหนดค่า: "stdout", "null", "file:<path>", "ring" หรือ "ring:<bytes>"
+  // คืนค่า nullptr ถ้ารูปแบบไม่ถูกต้องหรือเปิดไฟล์ไม่ได้
+  static std::unique_ptr<OutputSink> Create(const std::string &spec);
+};
+
+// เขียนไปที่ stdout (โหมดปกติ)
+class StdoutSink : public OutputSink
+{
+public:
+  void Write(const char *data, size_t size) override;
+  void Flush() override;
+  bool IsTerminal() const override { return true; }
+};
+
+// เขียนลงไฟล์ผ่านบัฟเฟอร์ภายใน (เขียนลงดิสก์เมื่อบัฟเฟอร์เต็มหรือเมื่อปิดไฟล์)
+class FileSink : public OutputSink
+{
+private:
+  std::FILE *file;          // ไฟล์ปลายทาง
+  std::vector<char> buffer; // บัฟเฟอร์ก่อนเขียนลงไฟล์
+  size_t used;              // จำนวนไบต์ในบัฟเฟอร์
+
+  void FlushBuffer();
+
+public:
+  explicit FileSink(const std::string &path, size_t buffer_size = 64 * 1024);
+  ~FileSink() override;
+  FileSink(const FileSink &) = delete;
+  FileSink &operator=(const FileSink &) = delete;
+
+  bool IsOpen() const;
+  void Write(const char *data, size_t size) override;
+  void FlushToDisk(); // บังคับเขียนข้อมูลทั้งหมดลงไฟล์
+};
+
+// เก็บเฉพาะข้อความล่าสุดในบัฟเฟอร์วงแหวน (ใช้ดูย้อนหลังเมื่อโปรแกรมล่ม)
+class RingBufferSink : public OutputSink
+{
+private:
+  std::vector<char> ring; // หน่วยความจำวงแหวน
+  size_t head;            // ตำแหน่งที่จะเขียนถัดไป
+  size_t stored;          // จำนวนไบต์ที่เก็บอยู่
+
+public:
+  explicit RingBufferSink(size_t capacity = 64 * 1024);
+
+  void Write(const char *data, size_t size) override;
+  std::string GetContents() const;            // ข้อความที่เก็บไว้เรียงจากเก่าไปใหม่
+  bool DumpTo(const std::string &path) const; // บันทึกข้อความลงไฟล์
+  void Clear();
+};
+
+// ทิ้งข้อมูลทั้งหมด - Out() จะไม่จัดรูปแบบข้อความใดๆ เลย
+class NullSink : public OutputSink
+{
+public:
+  void Write(const char *, size_t) override {}
+  bool IsNull() const override { return true; }
+};
+
+// เปลี่ยน sink ชั่วคราวภายใน scope แล้วคืนค่าเดิมเมื่อออกจาก scope
+class ScopedOutputSink
+{
+private:
+  OutputSink *previous;
+
+public:
+  explicit ScopedOutputSink(OutputSink *sink);
+  ~ScopedOutputSink();
+  ScopedOutputSink(const ScopedOutputSink &) = delete;
+  ScopedOutputSink &operator=(const ScopedOutputSink &) = delete;
+};
+
+// สตรีมสำหรับพิมพ์ผ่าน sink ปัจจุบัน - ใช้แทน std::cout ทุกจุด
+// เมื่อ sink เป็น NullSink สตรีมจะอยู่ในสถานะ bad ทำให้ operator<< ไม่จัดรูปแบบข้อมูล
+std::ostream &Out();
+
+#endif // OUTPUTSINK_H
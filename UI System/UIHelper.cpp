@@ -2,9 +2,13 @@
 // ไฟล์นี้มีฟังก์ชันสำหรับจัดการการแสดงผลต่างๆ เช่น การล้างหน้าจอ การวาดกรอบ และการแสดงผลพิเศษ
 #include "UIHelper.h"
 #include "Player.h"
+#include "InputSource.h"
+#include "OutputSink.h"
+#include "KeyboardInput.h"
+#include "../Game Core/Trace.h"
+#include "../Game Core/AllocationProfile.h"
+#include "../Game Core/BattleResolver.h"
 #include <iostream>
-#include <iomanip>
-#include <sstream>
 #include <cwchar>
 #include <locale>
 #include <cstring>
@@ -16,11 +20,38 @@
 
 using namespace std;
 
+// โหมดแอนิเมชัน - ปิดได้เมื่อเล่นสคริปต์ซ้ำหรือรันแบบอัตโนมัติ
+static bool animation_enabled = true;
+
+void UIHelper::SetAnimationEnabled(bool enabled)
+{
+  animation_enabled = enabled;
+}
+
+bool UIHelper::IsAnimationEnabled()
+{
+  return animation_enabled;
+}
+
 // การจัดการหน้าจอ (Screen Management)
 // ClearScreen - ล้างหน้าจอเทอร์มินัล
 // รองรับทั้งระบบ Windows และ Unix-like
 void UIHelper::ClearScreen()
 {
+  if (!OutputSink::Enabled())
+  {
+    return;
+  }
+  TRACE_SPAN("ui", "UIHelper::ClearScreen");
+  ALLOC_SCOPE(UI);
+  // เมื่อไม่ได้แสดงผลบนเทอร์มินัลจริง หรืออยู่ในโหมดไม่มีแอนิเมชัน
+  // ใช้ ANSI escape แทนการเรียกคำสั่งระบบ (ไม่ต้องสร้างโปรเซสใหม่)
+  if (!animation_enabled || !OutputSink::Current().IsTerminal())
+  {
+    Out() << "\033[2J\033[H";
+    return;
+  }
+  Out().flush();
 #ifdef _WIN32
   HANDLE hStdOut = GetStdHandle(STD_OUTPUT_HANDLE);
   CONSOLE_SCREEN_BUFFER_INFO csbi;
@@ -46,9 +77,16 @@ void UIHelper::ClearScreen()
 // - message: ข้อความที่จะแสดงระหว่างรอ
 void UIHelper::PauseForUser(const string &message)
 {
-  cout << "\n"
-       << Colors::BRIGHT_BLACK << Icons::INFO << " " << message << Colors::RESET << endl;
-  cin.get();
+  Out() << "\n"
+        << Colors::BRIGHT_BLACK << Icons::INFO << " " << message << Colors::RESET << endl;
+  if (KeyboardInput::IsActive())
+  {
+    // โหมดปุ่มเดียว: กดปุ่มใดก็ได้เพื่อไปต่อ
+    RawModeGuard raw_mode;
+    KeyboardInput::WaitForKey();
+    return;
+  }
+  InputSource::NextLine();
 }
 
 // ShowLoadingAnimation - แสดงแอนิเมชันโหลด
@@ -56,40 +94,156 @@ void UIHelper::PauseForUser(const string &message)
 // - duration_ms: ระยะเวลาในการแสดงแอนิเมชัน (มิลลิวินาที)
 void UIHelper::ShowLoadingAnimation(const string &message, int duration_ms)
 {
-  cout << "\n"
-       << Colors::BRIGHT_CYAN << message << " ";
-  cout.flush();
+  if (!OutputSink::Enabled())
+    return;
+  Out() << "\n"
+        << Colors::BRIGHT_CYAN << message << " ";
+  Out().flush();
 
   string spinner = "|/-\\";
-  int steps = duration_ms / 100;
+  int steps = animation_enabled ? duration_ms / 100 : 0;
 
   for (int i = 0; i < steps; i++)
   {
-    cout << "\b" << spinner[i % 4];
-    cout.flush();
+    Out() << "\b" << spinner[i % 4];
+    Out().flush();
     this_thread::sleep_for(chrono::milliseconds(100));
   }
-  cout << "\b " << Icons::CONFIRM << Colors::RESET << endl;
+  Out() << "\b " << Icons::CONFIRM << Colors::RESET << endl;
 }
 
-// ฟังก์ชันช่วยเหลือสำหรับการทำซ้ำตัวอักษร (Helper functions for character repetition)
-// RepeatChar - สร้างสตริงจากการทำซ้ำตัวอักษรหรือสตริง
-// - c: ตัวอักษรที่ต้องการทำซ้ำ
-// - s: สตริงที่ต้องการทำซ้ำ (สำหรับตัวอักษรหลายไบต์)
-// - n: จำนวนครั้งที่ต้องการทำซ้ำ
-string UIHelper::RepeatChar(char c, int n)
+// แถบสัญลักษณ์ซ้ำ (Precomputed glyph strips)
+// สร้างตั้งแต่ตอนคอมไพล์ เส้นขอบ/แถบความคืบหน้าจึงเป็นแค่การคัดลอกช่วงของแถบนี้
+namespace
 {
-  return string(n, c);
+  constexpr size_t GLYPH_STRIP_LENGTH = 80; // จำนวนสัญลักษณ์ต่อแถบ (ยาวกว่าหน้าจอ 70 ช่อง)
+
+  template <size_t GlyphBytes>
+  struct GlyphStrip
+  {
+    char data[GlyphBytes * GLYPH_STRIP_LENGTH];
+
+    constexpr GlyphStrip(const char (&glyph)[GlyphBytes + 1]) : data{}
+    {
+      for (size_t i = 0; i < GlyphBytes * GLYPH_STRIP_LENGTH; ++i)
+      {
+        data[i] = glyph[i % GlyphBytes];
+      }
+    }
+
+    constexpr string_view View() const { return string_view(data, sizeof(data)); }
+  };
+
+  constexpr GlyphStrip<3> DOUBLE_LINE_STRIP("═");
+  constexpr GlyphStrip<3> SINGLE_LINE_STRIP("─");
+  constexpr GlyphStrip<3> FULL_BLOCK_STRIP("█");
+  constexpr GlyphStrip<3> LIGHT_SHADE_STRIP("░");
+  constexpr GlyphStrip<3> DARK_SHADE_STRIP("▓");
+  constexpr GlyphStrip<2> MIDDLE_DOT_STRIP("·");
+  constexpr GlyphStrip<1> EQUALS_STRIP("=");
+  constexpr GlyphStrip<1> DASH_STRIP("-");
+  constexpr GlyphStrip<1> SPACE_STRIP(" ");
 }
 
-string UIHelper::RepeatChar(const string &s, int n)
+string_view UIHelper::GetGlyphStrip(string_view glyph)
 {
-  string result = "";
-  for (int i = 0; i < n; ++i)
+  static constexpr string_view strips[] = {
+      DOUBLE_LINE_STRIP.View(), SINGLE_LINE_STRIP.View(), FULL_BLOCK_STRIP.View(),
+      LIGHT_SHADE_STRIP.View(), DARK_SHADE_STRIP.View(), MIDDLE_DOT_STRIP.View(),
+      EQUALS_STRIP.View(), DASH_STRIP.View(), SPACE_STRIP.View()};
+  for (string_view strip : strips)
   {
-    result += s;
+    if (strip.size() == glyph.size() * GLYPH_STRIP_LENGTH && strip.substr(0, glyph.size()) == glyph)
+    {
+      return strip;
+    }
   }
-  return result;
+  return string_view();
+}
+
+// TextBuffer - บัฟเฟอร์ข้อความสำหรับประกอบหน้าจอ
+void TextBuffer::Reserve(size_t bytes)
+{
+  if (used + bytes > sizeof(data))
+  {
+    Flush();
+  }
+}
+
+void TextBuffer::Flush()
+{
+  if (used > 0)
+  {
+    Out().write(data, static_cast<streamsize>(used));
+    used = 0;
+  }
+}
+
+TextBuffer &TextBuffer::Append(string_view text)
+{
+  if (text.size() > sizeof(data))
+  {
+    // ข้อความยาวกว่าบัฟเฟอร์ทั้งก้อน - ส่งตรงโดยไม่ต้องคัดลอก
+    Flush();
+    Out().write(text.data(), static_cast<streamsize>(text.size()));
+    return *this;
+  }
+  Reserve(text.size());
+  memcpy(data + used, text.data(), text.size());
+  used += text.size();
+  return *this;
+}
+
+TextBuffer &TextBuffer::Append(char c)
+{
+  Reserve(1);
+  data[used++] = c;
+  return *this;
+}
+
+TextBuffer &TextBuffer::AppendSigned(long long value)
+{
+  Reserve(24);
+  used = to_chars(data + used, data + sizeof(data), value).ptr - data;
+  return *this;
+}
+
+TextBuffer &TextBuffer::AppendUnsigned(unsigned long long value)
+{
+  Reserve(24);
+  used = to_chars(data + used, data + sizeof(data), value).ptr - data;
+  return *this;
+}
+
+TextBuffer &TextBuffer::Repeat(string_view glyph, int count)
+{
+  if (glyph.empty() || count <= 0)
+  {
+    return *this;
+  }
+  string_view strip = UIHelper::GetGlyphStrip(glyph);
+  if (strip.empty())
+  {
+    // สัญลักษณ์ที่ไม่มีแถบสำเร็จรูป - ต่อทีละตัว
+    for (int i = 0; i < count; ++i)
+    {
+      Append(glyph);
+    }
+    return *this;
+  }
+  size_t remaining = glyph.size() * static_cast<size_t>(count);
+  while (remaining > 0)
+  {
+    size_t chunk = min(remaining, strip.size());
+    Append(strip.substr(0, chunk));
+    remaining -= chunk;
+  }
+  return *this;
+}
+
+TextBuffer &TextBuffer::Repeat(char c, int count)
+{
+  return Repeat(string_view(&c, 1), count);
 }
 
 // การวาดกรอบและเส้น (Box Drawing)
@@ -97,14 +251,23 @@ string UIHelper::RepeatChar(const string &s, int n)
 // - c: ตัวอักษรหรือสตริงที่ใช้วาดเส้น
 // - length: ความยาวของเส้น
 // - color: สีของเส้น
-void UIHelper::PrintHorizontalLine(char c, int length, const string &color)
+void UIHelper::PrintHorizontalLine(char c, int length, string_view color)
 {
-  cout << color << RepeatChar(c, length) << Colors::RESET << endl;
+  TextBuffer out;
+  AppendHorizontalLine(out, string_view(&c, 1), length, color);
 }
 
-void UIHelper::PrintHorizontalLine(const string &s, int length, const string &color)
+void UIHelper::PrintHorizontalLine(string_view s, int length, string_view color)
 {
-  cout << color << RepeatChar(s, length) << Colors::RESET << endl;
+  TextBuffer out;
+  AppendHorizontalLine(out, s, length, color);
+}
+
+void UIHelper::AppendHorizontalLine(TextBuffer &out, string_view s, int length, string_view color)
+{
+  out << color;
+  out.Repeat(s, length);
+  out << Colors::RESET << '\n';
 }
 
 // PrintBox - วาดกรอบสี่เหลี่ยมพร้อมเนื้อหาและหัวข้อ
@@ -112,8 +275,19 @@ void UIHelper::PrintHorizontalLine(const string &s, int length, const string &co
 // - title: หัวข้อของกรอบ
 // - border_color: สีของกรอบ
 // - text_color: สีของข้อความ
-void UIHelper::PrintBox(const string &content, const string &title,
-                        const string &border_color, const string &text_color)
+void UIHelper::PrintBox(string_view content, string_view title,
+                        string_view border_color, string_view text_color)
+{
+  if (!OutputSink::Enabled())
+    return;
+  TRACE_SPAN("ui", "UIHelper::PrintBox");
+  ALLOC_SCOPE(UI);
+  TextBuffer out;
+  AppendBox(out, content, title, border_color, text_color);
+}
+
+void UIHelper::AppendBox(TextBuffer &out, string_view content, string_view title,
+                         string_view border_color, string_view text_color)
 {
   int content_length = GetDisplayWidth(content);
   int title_length = GetDisplayWidth(title);
@@ -121,226 +295,328 @@ void UIHelper::PrintBox(const string &content, const string &title,
   box_width = max(box_width, 50); // minimum width
 
   // Top border
-  cout << border_color << "╔" << RepeatChar("═", box_width - 2) << "╗" << Colors::RESET << endl;
+  out << border_color << "╔";
+  out.Repeat("═", box_width - 2) << "╗" << Colors::RESET << '\n';
 
   // Title (if provided)
   if (!title.empty())
   {
-    int title_padding_total = box_width - GetDisplayWidth(title) - 2;
+    int title_padding_total = box_width - title_length - 2;
     int title_padding_left = title_padding_total / 2;
     int title_padding_right = title_padding_total - title_padding_left;
-    cout << border_color << "║" << Colors::RESET;
-    cout << RepeatChar(' ', title_padding_left) << Colors::BOLD << text_color << title << Colors::RESET;
-    cout << RepeatChar(' ', title_padding_right);
-    cout << border_color << "║" << Colors::RESET << endl;
-    cout << border_color << "╠" << RepeatChar("═", box_width - 2) << "╣" << Colors::RESET << endl;
+    out << border_color << "║" << Colors::RESET;
+    out.Spaces(title_padding_left) << Colors::BOLD << text_color << title << Colors::RESET;
+    out.Spaces(title_padding_right);
+    out << border_color << "║" << Colors::RESET << '\n';
+    out << border_color << "╠";
+    out.Repeat("═", box_width - 2) << "╣" << Colors::RESET << '\n';
   }
 
   // Content
-  int content_padding_total = box_width - GetDisplayWidth(content) - 2;
+  int content_padding_total = box_width - content_length - 2;
   int content_padding_left = content_padding_total / 2;
   int content_padding_right = content_padding_total - content_padding_left;
-  cout << border_color << "║" << Colors::RESET;
-  cout << RepeatChar(' ', content_padding_left) << text_color << content << Colors::RESET;
-  cout << RepeatChar(' ', content_padding_right);
-  cout << border_color << "║" << Colors::RESET << endl;
+  out << border_color << "║" << Colors::RESET;
+  out.Spaces(content_padding_left) << text_color << content << Colors::RESET;
+  out.Spaces(content_padding_right);
+  out << border_color << "║" << Colors::RESET << '\n';
 
   // Bottom border
-  cout << border_color << "╚" << RepeatChar("═", box_width - 2) << "╝" << Colors::RESET << endl;
+  out << border_color << "╚";
+  out.Repeat("═", box_width - 2) << "╝" << Colors::RESET << '\n';
 }
 
-void UIHelper::PrintSectionHeader(const string &title, const string &icon, const string &color)
+void UIHelper::PrintSectionHeader(string_view title, string_view icon, string_view color)
 {
-  cout << "\n";
-  PrintHorizontalLine("═", 70, color);
-  string header_text = icon + " " + title + " " + icon;
-  int display_width_header = GetDisplayWidth(header_text);
+  if (!OutputSink::Enabled())
+    return;
+  TRACE_SPAN("ui", "UIHelper::PrintSectionHeader");
+  ALLOC_SCOPE(UI);
+  TextBuffer out;
+  AppendSectionHeader(out, title, icon, color);
+}
+
+void UIHelper::AppendSectionHeader(TextBuffer &out, string_view title, string_view icon, string_view color)
+{
+  out << '\n';
+  AppendHorizontalLine(out, "═", 70, color);
+  // ความกว้างของ "icon title icon" คำนวณทีละส่วนโดยไม่ต้องต่อข้อความ
+  int display_width_header = 2 * GetDisplayWidth(icon) + GetDisplayWidth(title) + 2;
   int padding = (70 - display_width_header) / 2;
   padding = max(0, padding); // Ensure padding is not negative
-  cout << color << RepeatChar(' ', padding) << header_text << Colors::RESET << endl;
-  PrintHorizontalLine("═", 70, color);
+  out << color;
+  out.Spaces(padding) << icon << ' ' << title << ' ' << icon << Colors::RESET << '\n';
+  AppendHorizontalLine(out, "═", 70, color);
 }
 
-void UIHelper::PrintPhaseHeader(const string &phase_name, const string &player_name,
-                                int turn_number, const string &color)
+void UIHelper::PrintPhaseHeader(string_view phase_name, string_view player_name,
+                                int turn_number, string_view color)
 {
-  string turn_info = turn_number > 0 ? " - TURN " + to_string(turn_number) : "";
-  string full_header = Icons::PHASE + " " + phase_name + " | " + Icons::PLAYER + " " + player_name + turn_info;
+  if (!OutputSink::Enabled())
+    return;
+  TRACE_SPAN("ui", "UIHelper::PrintPhaseHeader");
+  ALLOC_SCOPE(UI);
+  // ประกอบหัวข้อไว้ในบัฟเฟอร์ชั่วคราวบน stack เพื่อวัดความกว้างก่อนจัดกึ่งกลาง
+  char turn_info[32] = "";
+  if (turn_number > 0)
+  {
+    memcpy(turn_info, " - TURN ", 8);
+    *to_chars(turn_info + 8, turn_info + sizeof(turn_info) - 1, turn_number).ptr = '\0';
+  }
+  int display_width_header = GetDisplayWidth(Icons::PHASE) + 1 + GetDisplayWidth(phase_name) + 3 +
+                             GetDisplayWidth(Icons::PLAYER) + 1 + GetDisplayWidth(player_name) +
+                             GetDisplayWidth(turn_info);
 
-  cout << "\n";
-  PrintHorizontalLine("─", 70, color);
-  int display_width_header = GetDisplayWidth(full_header);
+  TextBuffer out;
+  out << '\n';
+  AppendHorizontalLine(out, "─", 70, color);
   int padding = (70 - display_width_header) / 2;
+  out << color;
   if (padding > 0)
   {
-    cout << color << RepeatChar(' ', padding) << Colors::BOLD << full_header << Colors::RESET << endl;
-  }
-  else
-  {
-    cout << color << Colors::BOLD << full_header << Colors::RESET << endl;
+    out.Spaces(padding);
   }
-  PrintHorizontalLine("─", 70, color);
+  out << Colors::BOLD << Icons::PHASE << ' ' << phase_name << " | " << Icons::PLAYER << ' '
+      << player_name << turn_info << Colors::RESET << '\n';
+  AppendHorizontalLine(out, "─", 70, color);
 }
 
 // Message Types
 void UIHelper::PrintSuccess(const string &message)
 {
-  cout << "\n"
-       << Colors::BRIGHT_GREEN << Icons::CONFIRM << " SUCCESS: " << message << Colors::RESET << endl;
+  ALLOC_SCOPE(UI);
+  Out() << "\n"
+        << Colors::BRIGHT_GREEN << Icons::CONFIRM << " SUCCESS: " << message << Colors::RESET << endl;
 }
 
 void UIHelper::PrintError(const string &message)
 {
-  cout << "\n"
-       << Colors::BRIGHT_RED << Icons::CANCEL << " ERROR: " << message << Colors::RESET << endl;
+  ALLOC_SCOPE(UI);
+  Out() << "\n"
+        << Colors::BRIGHT_RED << Icons::CANCEL << " ERROR: " << message << Colors::RESET << endl;
 }
 
 void UIHelper::PrintWarning(const string &message)
 {
-  cout << "\n"
-       << Colors::BRIGHT_YELLOW << Icons::WARNING << " WARNING: " << message << Colors::RESET << endl;
+  ALLOC_SCOPE(UI);
+  Out() << "\n"
+        << Colors::BRIGHT_YELLOW << Icons::WARNING << " WARNING: " << message << Colors::RESET << endl;
 }
 
 void UIHelper::PrintInfo(const string &message)
 {
-  cout << "\n"
-       << Colors::BRIGHT_CYAN << Icons::INFO << " INFO: " << message << Colors::RESET << endl;
+  ALLOC_SCOPE(UI);
+  Out() << "\n"
+        << Colors::BRIGHT_CYAN << Icons::INFO << " INFO: " << message << Colors::RESET << endl;
 }
 
 // Game Status
 void UIHelper::PrintGameTitle()
 {
+  if (!OutputSink::Enabled())
+    return;
+  TRACE_SPAN("ui", "UIHelper::PrintGameTitle");
+  ALLOC_SCOPE(UI);
   ClearScreen();
-  cout << "\n";
-  PrintHorizontalLine("█", 70, Colors::BRIGHT_MAGENTA);
-  cout << Colors::BRIGHT_MAGENTA << Colors::BOLD;
-  cout << "███████ ██ ██████   ██████      ██████  █████  ██████  ██████  " << endl;
-  cout << "██      ██ ██   ██ ██    ██    ██      ██   ██ ██   ██ ██   ██ " << endl;
-  cout << "█████   ██ ██████  ██    ██    ██      ███████ ██████  ██   ██ " << endl;
-  cout << "██      ██ ██   ██ ██    ██    ██    ██      ██   ██ ██   ██ " << endl;
-  cout << "██      ██ ██████   ██████      ██████ ██   ██ ██   ██ ██████  " << endl;
-  cout << Colors::RESET;
-  PrintHorizontalLine("█", 70, Colors::BRIGHT_MAGENTA);
-  cout << Colors::BRIGHT_CYAN << Colors::BOLD;
-  string title_text = "                   ⚔️ COMMANDOS BATTLE SYSTEM ⚔️";
+  TextBuffer out;
+  out << '\n';
+  AppendHorizontalLine(out, "█", 70, Colors::BRIGHT_MAGENTA);
+  out << Colors::BRIGHT_MAGENTA << Colors::BOLD;
+  out << "███████ ██ ██████   ██████      ██████  █████  ██████  ██████  " << '\n';
+  out << "██      ██ ██   ██ ██    ██    ██      ██   ██ ██   ██ ██   ██ " << '\n';
+  out << "█████   ██ ██████  ██    ██    ██      ███████ ██████  ██   ██ " << '\n';
+  out << "██      ██ ██   ██ ██    ██    ██    ██      ██   ██ ██   ██ " << '\n';
+  out << "██      ██ ██████   ██████      ██████ ██   ██ ██   ██ ██████  " << '\n';
+  out << Colors::RESET;
+  AppendHorizontalLine(out, "█", 70, Colors::BRIGHT_MAGENTA);
+  out << Colors::BRIGHT_CYAN << Colors::BOLD;
+  string_view title_text = "                   ⚔️ COMMANDOS BATTLE SYSTEM ⚔️";
   int title_padding = (70 - GetDisplayWidth(title_text)) / 2;
   title_padding = max(0, title_padding);
-  cout << RepeatChar(' ', title_padding) << title_text << endl;
-  cout << Colors::RESET;
-  PrintHorizontalLine("█", 70, Colors::BRIGHT_MAGENTA);
+  out.Spaces(title_padding) << title_text << '\n';
+  out << Colors::RESET;
+  AppendHorizontalLine(out, "█", 70, Colors::BRIGHT_MAGENTA);
 }
 
 void UIHelper::PrintQuickStatus(const string &player_name, int hand_size, int deck_size,
                                 int damage_count, int soul_count, int drop_count)
 {
-  cout << "\n";
+  if (!OutputSink::Enabled())
+    return;
+  TRACE_SPAN("ui", "UIHelper::PrintQuickStatus");
+  ALLOC_SCOPE(UI);
+  Out() << "\n";
   PrintHorizontalLine("─", 70, Colors::BRIGHT_BLACK);
-  cout << Colors::BRIGHT_CYAN << Icons::PLAYER << " " << player_name << Colors::RESET;
-  cout << " | " << Colors::YELLOW << Icons::HAND << " " << hand_size;
-  cout << " | " << Colors::BLUE << Icons::DECK << " " << deck_size;
-  cout << " | " << Colors::RED << Icons::DAMAGE << " " << damage_count << "/" << Player::MAX_DAMAGE;
-  cout << " | " << Colors::MAGENTA << Icons::SOUL << " " << soul_count;
-  cout << " | " << Colors::BRIGHT_BLACK << Icons::DROP << " " << drop_count << Colors::RESET << endl;
+  Out() << Colors::BRIGHT_CYAN << Icons::PLAYER << " " << player_name << Colors::RESET;
+  Out() << " | " << Colors::YELLOW << Icons::HAND << " " << hand_size;
+  Out() << " | " << Colors::BLUE << Icons::DECK << " " << deck_size;
+  Out() << " | " << Colors::RED << Icons::DAMAGE << " " << damage_count << "/" << Player::MAX_DAMAGE;
+  Out() << " | " << Colors::MAGENTA << Icons::SOUL << " " << soul_count;
+  Out() << " | " << Colors::BRIGHT_BLACK << Icons::DROP << " " << drop_count << Colors::RESET << endl;
   PrintHorizontalLine("─", 70, Colors::BRIGHT_BLACK);
 }
 
 void UIHelper::PrintShortcuts()
 {
-  cout << Colors::BRIGHT_BLACK << "🚀 SHORTCUTS: ";
-  cout << "[h]elp [s]tatus [f]ield [ESC]back [Space]skip [Tab]switch" << Colors::RESET << endl;
+  TextBuffer out;
+  AppendShortcuts(out);
+}
+
+void UIHelper::AppendShortcuts(TextBuffer &out)
+{
+  out << Colors::BRIGHT_BLACK << "🚀 SHORTCUTS: ";
+  out << "[h]elp [s]tatus [f]ield [ESC]back [Space]skip [Tab]switch" << Colors::RESET << '\n';
 }
 
 // Progress/Animation
 void UIHelper::PrintProgressBar(int current, int max_val, const string &label)
 {
+  if (!OutputSink::Enabled())
+    return;
+  TRACE_SPAN("ui", "UIHelper::PrintProgressBar");
+  ALLOC_SCOPE(UI);
   int bar_width = 20;
   float progress = (max_val > 0) ? (float)current / max_val : 0;
   int filled = (int)(progress * bar_width);
   int empty = bar_width - filled;
 
-  cout << label << " [";
+  TextBuffer out;
+  out << label << " [";
   if (filled > 0)
   {
-    cout << Colors::GREEN << RepeatChar("█", filled);
+    out << Colors::GREEN;
+    out.Repeat("█", filled);
   }
   if (empty > 0)
   {
-    cout << Colors::BRIGHT_BLACK << RepeatChar("░", empty);
+    out << Colors::BRIGHT_BLACK;
+    out.Repeat("░", empty);
   }
-  cout << "] " << current << "/" << max_val << " (" << (int)(progress * 100) << "%)" << endl;
+  out << "] " << current << "/" << max_val << " (" << (int)(progress * 100) << "%)" << '\n';
 }
 
 void UIHelper::AnimateText(const string &text, int delay_ms)
 {
+  if (!OutputSink::Enabled())
+    return;
+  if (!animation_enabled)
+  {
+    Out() << text << endl;
+    return;
+  }
   for (char c : text)
   {
-    cout << c;
-    cout.flush();
+    Out() << c;
+    Out().flush();
     this_thread::sleep_for(chrono::milliseconds(delay_ms));
   }
-  cout << endl;
+  Out() << endl;
 }
 
 void UIHelper::ShowDriveCheckAnimation()
 {
-  cout << Colors::BRIGHT_YELLOW << Icons::TARGET << " Drive Check";
+  if (!OutputSink::Enabled())
+    return;
+  TRACE_SPAN("ui", "UIHelper::ShowDriveCheckAnimation");
+  ALLOC_SCOPE(UI);
+  Out() << Colors::BRIGHT_YELLOW << Icons::TARGET << " Drive Check";
   for (int i = 0; i < 3; i++)
   {
-    cout << ".";
-    cout.flush();
-    this_thread::sleep_for(chrono::milliseconds(400));
+    Out() << ".";
+    if (animation_enabled)
+    {
+      Out().flush();
+      this_thread::sleep_for(chrono::milliseconds(400));
+    }
   }
-  cout << " " << Icons::LIGHTNING << Colors::RESET << endl;
+  Out() << " " << Icons::LIGHTNING << Colors::RESET << endl;
 }
 
 void UIHelper::ShowDamageAnimation()
 {
-  cout << Colors::BRIGHT_RED;
+  if (!OutputSink::Enabled())
+    return;
+  TRACE_SPAN("ui", "UIHelper::ShowDamageAnimation");
+  ALLOC_SCOPE(UI);
+  Out() << Colors::BRIGHT_RED;
   for (int i = 0; i < 3; i++)
   {
-    cout << Icons::DAMAGE << " ";
-    cout.flush();
-    this_thread::sleep_for(chrono::milliseconds(300));
+    Out() << Icons::DAMAGE << " ";
+    if (animation_enabled)
+    {
+      Out().flush();
+      this_thread::sleep_for(chrono::milliseconds(300));
+    }
   }
-  cout << Colors::RESET << endl;
+  Out() << Colors::RESET << endl;
 }
 
 void UIHelper::ShowPhaseTransition(const string &from, const string &to)
 {
-  cout << "\n"
-       << Colors::BRIGHT_CYAN << Icons::TURN << " " << from << " → " << to << Colors::RESET << endl;
+  if (!OutputSink::Enabled())
+    return;
+  TRACE_SPAN("ui", "UIHelper::ShowPhaseTransition");
+  ALLOC_SCOPE(UI);
+  Out() << "\n"
+        << Colors::BRIGHT_CYAN << Icons::TURN << " " << from << " → " << to << Colors::RESET << endl;
 
   string progress = "▓▓▓▓▓▓▓▓▓▓";
-  cout << Colors::GREEN << progress << " 100%" << Colors::RESET << endl;
-  this_thread::sleep_for(chrono::milliseconds(800));
+  Out() << Colors::GREEN << progress << " 100%" << Colors::RESET << endl;
+  if (animation_enabled)
+  {
+    this_thread::sleep_for(chrono::milliseconds(800));
+  }
 }
 
 // Input Helpers
-string UIHelper::ColorText(const string &text, const string &color)
+string UIHelper::Join(initializer_list<string_view> parts)
 {
-  return color + text + Colors::RESET;
+  ALLOC_SCOPE(UI);
+  size_t total = 0;
+  for (string_view part : parts)
+  {
+    total += part.size();
+  }
+  string result;
+  result.reserve(total);
+  for (string_view part : parts)
+  {
+    result.append(part.data(), part.size());
+  }
+  return result;
+}
+
+string UIHelper::ColorText(string_view text, string_view color)
+{
+  ALLOC_SCOPE(UI);
+  return Join({color, text, Colors::RESET});
 }
 
-string UIHelper::FormatCard(const string &name, int grade, bool is_standing, bool show_icons)
+string UIHelper::FormatCard(string_view name, int grade, bool is_standing, bool show_icons)
 {
-  string result = "";
+  ALLOC_SCOPE(UI);
+  char grade_text[16];
+  string_view grade_digits(grade_text, to_chars(grade_text, grade_text + sizeof(grade_text), grade).ptr - grade_text);
+
+  string result;
+  result.reserve(name.size() + 32);
 
   if (show_icons)
   {
-    result += GetGradeIcon(grade) + " ";
+    result.append(GetGradeIcon(grade)).append(" ");
   }
 
-  result += "G" + to_string(grade) + " " + name;
+  result.append("G").append(grade_digits).append(" ").append(name);
 
   if (!is_standing)
   {
-    result += " " + Colors::BRIGHT_BLACK + "(REST)" + Colors::RESET;
+    result.append(" ").append(Colors::BRIGHT_BLACK).append("(REST)").append(Colors::RESET);
   }
 
   return result;
 }
 
-string UIHelper::GetGradeIcon(int grade)
+string_view UIHelper::GetGradeIcon(int grade)
 {
   switch (grade)
   {
@@ -359,7 +635,7 @@ string UIHelper::GetGradeIcon(int grade)
   }
 }
 
-string UIHelper::GetStatusIcon(bool is_standing)
+string_view UIHelper::GetStatusIcon(bool is_standing)
 {
   return is_standing ? Icons::RUNNER : Icons::SLEEP;
 }
@@ -367,75 +643,107 @@ string UIHelper::GetStatusIcon(bool is_standing)
 // Card Display Helpers
 string UIHelper::FormatPowerShield(int power, int shield)
 {
-  return Colors::RED + Icons::SWORD + to_string(power) + Colors::RESET +
-         " " + Colors::BLUE + Icons::SHIELD + to_string(shield) + Colors::RESET;
+  ALLOC_SCOPE(UI);
+  string power_text = to_string(power);
+  string shield_text = to_string(shield);
+  return Join({Colors::RED, Icons::SWORD, power_text, Colors::RESET,
+               " ", Colors::BLUE, Icons::SHIELD, shield_text, Colors::RESET});
 }
 
 string UIHelper::FormatCardShort(const string &code, const string &name, int grade)
 {
-  return GetGradeIcon(grade) + " [" + code + "] " + name;
+  ALLOC_SCOPE(UI);
+  return Join({GetGradeIcon(grade), " [", code, "] ", name});
 }
 
 // Layout Helpers
 void UIHelper::PrintCardPreview(const std::string &name, int grade, int power, int shield,
                                 int critical, const std::string &skill, const std::string &type)
 {
+  if (!OutputSink::Enabled())
+    return;
+  TRACE_SPAN("ui", "UIHelper::PrintCardPreview");
+  ALLOC_SCOPE(UI);
   const int preview_width = 50;
-  PrintHorizontalLine("─", preview_width, Colors::CYAN);
-  std::cout << Colors::CYAN << "│" << Colors::BOLD << std::left << std::setw(preview_width - 2) << (" " + name) << Colors::RESET << Colors::CYAN << "│" << std::endl;
-  PrintHorizontalLine("─", preview_width, Colors::CYAN);
-
-  std::string grade_str = "Grade: " + GetGradeIcon(grade) + " " + std::to_string(grade);
-  std::string type_str = "Type: " + type;
-  std::cout << Colors::CYAN << "│ " << Colors::RESET << grade_str;
-  std::cout << RepeatChar(' ', preview_width - GetDisplayWidth(Colors::CYAN + "│ " + Colors::RESET + grade_str + RepeatChar(' ', 1) + type_str + Colors::CYAN + "│")) << type_str << " " << Colors::CYAN << "│" << std::endl;
-
-  std::string power_str = "Power: " + Colors::GREEN + std::to_string(power) + Colors::RESET;
-  std::string shield_str = "Shield: " + Colors::BLUE + std::to_string(shield) + Colors::RESET;
-  std::cout << Colors::CYAN << "│ " << Colors::RESET << power_str;
-  std::cout << RepeatChar(' ', preview_width - GetDisplayWidth(Colors::CYAN + "│ " + Colors::RESET + power_str + RepeatChar(' ', 1) + shield_str + Colors::CYAN + "│")) << shield_str << " " << Colors::CYAN << "│" << std::endl;
+  // ความกว้างของขอบซ้าย "│ " และขอบขวา "│" รวมรหัสสี (วัดแบบเดียวกับข้อความในแต่ละแถว)
+  const int frame_width = GetDisplayWidth(Colors::CYAN) + GetDisplayWidth("│ ") + GetDisplayWidth(Colors::RESET) +
+                          GetDisplayWidth(Colors::CYAN) + GetDisplayWidth("│");
 
-  std::string critical_str = "Critical: " + Colors::RED + std::to_string(critical) + Colors::RESET;
-  std::cout << Colors::CYAN << "│ " << Colors::RESET << critical_str << RepeatChar(' ', preview_width - GetDisplayWidth(Colors::CYAN + "│ " + Colors::RESET + critical_str + Colors::CYAN + "│")) << Colors::CYAN << "│" << std::endl;
+  // ตัวเลขแต่ละค่าแปลงเป็นข้อความในบัฟเฟอร์บน stack
+  char number_text[4][16];
+  auto format_number = [&number_text](int slot, int value)
+  {
+    char *end = to_chars(number_text[slot], number_text[slot] + sizeof(number_text[slot]), value).ptr;
+    return string_view(number_text[slot], end - number_text[slot]);
+  };
+  string_view grade_digits = format_number(0, grade);
+  string_view power_digits = format_number(1, power);
+  string_view shield_digits = format_number(2, shield);
+  string_view critical_digits = format_number(3, critical);
+
+  TextBuffer out;
+  AppendHorizontalLine(out, "─", preview_width, Colors::CYAN);
+  out << Colors::CYAN << "│" << Colors::BOLD;
+  out << ' ' << name;
+  out.Spaces(preview_width - 2 - 1 - static_cast<int>(name.size()));
+  out << Colors::RESET << Colors::CYAN << "│" << '\n';
+  AppendHorizontalLine(out, "─", preview_width, Colors::CYAN);
+
+  // "Grade: <icon> <grade>" ... "Type: <type>"
+  int grade_width = GetDisplayWidth("Grade: ") + GetDisplayWidth(GetGradeIcon(grade)) + 1 + GetDisplayWidth(grade_digits);
+  int type_width = GetDisplayWidth("Type: ") + GetDisplayWidth(type);
+  out << Colors::CYAN << "│ " << Colors::RESET << "Grade: " << GetGradeIcon(grade) << ' ' << grade_digits;
+  out.Spaces(preview_width - (frame_width + grade_width + 1 + type_width));
+  out << "Type: " << type << " " << Colors::CYAN << "│" << '\n';
+
+  // "Power: <power>" ... "Shield: <shield>"
+  int power_width = GetDisplayWidth("Power: ") + GetDisplayWidth(Colors::GREEN) + GetDisplayWidth(power_digits) + GetDisplayWidth(Colors::RESET);
+  int shield_width = GetDisplayWidth("Shield: ") + GetDisplayWidth(Colors::BLUE) + GetDisplayWidth(shield_digits) + GetDisplayWidth(Colors::RESET);
+  out << Colors::CYAN << "│ " << Colors::RESET << "Power: " << Colors::GREEN << power_digits << Colors::RESET;
+  out.Spaces(preview_width - (frame_width + power_width + 1 + shield_width));
+  out << "Shield: " << Colors::BLUE << shield_digits << Colors::RESET << " " << Colors::CYAN << "│" << '\n';
+
+  // "Critical: <critical>"
+  int critical_width = GetDisplayWidth("Critical: ") + GetDisplayWidth(Colors::RED) + GetDisplayWidth(critical_digits) + GetDisplayWidth(Colors::RESET);
+  out << Colors::CYAN << "│ " << Colors::RESET << "Critical: " << Colors::RED << critical_digits << Colors::RESET;
+  out.Spaces(preview_width - (frame_width + critical_width));
+  out << Colors::CYAN << "│" << '\n';
 
   if (!skill.empty() && skill != "-")
   {
-    PrintHorizontalLine("·", preview_width, Colors::BRIGHT_BLACK);
-    std::string skill_label = Colors::YELLOW + Icons::MAGIC + " Skill: " + Colors::RESET;
-    std::string current_skill_text = skill;
+    AppendHorizontalLine(out, "·", preview_width, Colors::BRIGHT_BLACK);
+    const int skill_label_width = GetDisplayWidth(Colors::YELLOW) + GetDisplayWidth(Icons::MAGIC) +
+                                  GetDisplayWidth(" Skill: ") + GetDisplayWidth(Colors::RESET);
+    string_view current_skill_text = skill;
     bool first_line_of_skill = true;
 
     while (!current_skill_text.empty())
     {
-      std::cout << Colors::CYAN << "│ " << Colors::RESET;
-      std::string line_prefix;
+      out << Colors::CYAN << "│ " << Colors::RESET;
       if (first_line_of_skill)
       {
-        line_prefix = skill_label;
-        std::cout << line_prefix;
+        out << Colors::YELLOW << Icons::MAGIC << " Skill: " << Colors::RESET;
       }
       else
       {
-        line_prefix = RepeatChar(' ', GetDisplayWidth(skill_label));
-        std::cout << line_prefix; // Indent subsequent lines
+        out.Spaces(skill_label_width); // Indent subsequent lines
       }
 
-      int available_display_width = preview_width - GetDisplayWidth(Colors::CYAN + "│ " + Colors::RESET + line_prefix + Colors::CYAN + "│");
+      int available_display_width = preview_width - frame_width - skill_label_width;
 
-      std::string segment_to_print;
-      // int chars_can_fit_approx = available_display_width; // Approximation (REMOVED as unused)
+      string_view segment_to_print;
 
       if (GetDisplayWidth(current_skill_text) <= available_display_width)
       {
         segment_to_print = current_skill_text;
-        current_skill_text.clear();
+        current_skill_text = string_view();
       }
       else
       {
         // Iterate to find how many actual characters fit
         int actual_chars_fit = 0;
         for (size_t i = 0; i < current_skill_text.length(); ++i)
-        { // Changed i to size_t
+        {
           if (GetDisplayWidth(current_skill_text.substr(0, i + 1)) <= available_display_width)
           {
             actual_chars_fit = i + 1;
@@ -468,47 +776,51 @@ void UIHelper::PrintCardPreview(const std::string &name, int grade, int power, i
           current_skill_text = current_skill_text.substr(actual_chars_fit);
         }
       }
-      std::cout << segment_to_print;
+      out << segment_to_print;
       // Calculate padding for the right side of the current line
-      int current_line_content_display_width = GetDisplayWidth(line_prefix + segment_to_print);
-      std::cout << RepeatChar(' ', preview_width - GetDisplayWidth(Colors::CYAN + "│ " + Colors::RESET) - current_line_content_display_width - GetDisplayWidth(Colors::CYAN + "│")) << Colors::CYAN << "│" << std::endl;
+      out.Spaces(available_display_width - GetDisplayWidth(segment_to_print));
+      out << Colors::CYAN << "│" << '\n';
       first_line_of_skill = false;
     } // End of while loop for skill wrapping
   } // End of if skill not empty
-  PrintHorizontalLine("─", preview_width, Colors::CYAN);
+  AppendHorizontalLine(out, "─", preview_width, Colors::CYAN);
 }
 
-void UIHelper::PrintBattleStats(const string &attacker_name, int attack_power, int critical,
-                                const string &defender_name, int defense_power)
+void UIHelper::PrintBattleStats(string_view attacker_name, int attack_power, int critical,
+                                string_view defender_name, int defense_power)
 {
-  cout << "\n";
+  if (!OutputSink::Enabled())
+    return;
+  TRACE_SPAN("ui", "UIHelper::PrintBattleStats");
+  ALLOC_SCOPE(UI);
+  Out() << "\n";
   PrintSectionHeader("BATTLE CALCULATION", Icons::SWORD, Colors::BRIGHT_RED);
 
-  cout << Colors::RED << Icons::SWORD << " ATTACKER: " << Colors::BOLD << attacker_name << Colors::RESET;
-  cout << " | Power: " << Colors::BRIGHT_RED << attack_power << Colors::RESET;
-  cout << " | Critical: " << Colors::YELLOW << critical << Colors::RESET << endl;
+  Out() << Colors::RED << Icons::SWORD << " ATTACKER: " << Colors::BOLD << attacker_name << Colors::RESET;
+  Out() << " | Power: " << Colors::BRIGHT_RED << attack_power << Colors::RESET;
+  Out() << " | Critical: " << Colors::YELLOW << critical << Colors::RESET << endl;
 
-  cout << Colors::BLUE << Icons::SHIELD << " DEFENDER: " << Colors::BOLD << defender_name << Colors::RESET;
-  cout << " | Defense: " << Colors::BRIGHT_BLUE << defense_power << Colors::RESET << endl;
+  Out() << Colors::BLUE << Icons::SHIELD << " DEFENDER: " << Colors::BOLD << defender_name << Colors::RESET;
+  Out() << " | Defense: " << Colors::BRIGHT_BLUE << defense_power << Colors::RESET << endl;
 
-  cout << "\n"
-       << Colors::BRIGHT_YELLOW;
-  if (attack_power >= defense_power)
+  Out() << "\n"
+        << Colors::BRIGHT_YELLOW;
+  if (isBattleHit(attack_power, defense_power))
   {
-    cout << Icons::CONFIRM << " RESULT: HIT! 💥" << Colors::RESET << endl;
+    Out() << Icons::CONFIRM << " RESULT: HIT! 💥" << Colors::RESET << endl;
   }
   else
   {
-    cout << Icons::CANCEL << " RESULT: MISS! 🛡️" << Colors::RESET << endl;
+    Out() << Icons::CANCEL << " RESULT: MISS! 🛡️" << Colors::RESET << endl;
   }
 }
 
 // Helper to estimate display width of a UTF-8 string (works on Windows, no wcwidth)
-int UIHelper::GetDisplayWidth(const std::string &str)
+int UIHelper::GetDisplayWidth(std::string_view str)
 {
   int width = 0;
   std::mbstate_t state = std::mbstate_t();
-  const char *ptr = str.c_str();
+  const char *ptr = str.data();
   size_t len = str.length();
   wchar_t wc;
   size_t i = 0;
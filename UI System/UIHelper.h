@@ -4,6 +4,10 @@
 #define UIHELPER_H
 
 #include <string>
+#include <string_view>
+#include <charconv>
+#include <type_traits>
+#include <initializer_list>
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -12,97 +16,135 @@
 namespace Colors
 {
   // สีพื้นฐาน
-  const std::string RESET = "\033[0m";    // รีเซ็ตการจัดรูปแบบทั้งหมด
-  const std::string BLACK = "\033[30m";   // สีดำ
-  const std::string RED = "\033[31m";     // สีแดง
-  const std::string GREEN = "\033[32m";   // สีเขียว
-  const std::string YELLOW = "\033[33m";  // สีเหลือง
-  const std::string BLUE = "\033[34m";    // สีน้ำเงิน
-  const std::string MAGENTA = "\033[35m"; // สีม่วง
-  const std::string CYAN = "\033[36m";    // สีฟ้า
-  const std::string WHITE = "\033[37m";   // สีขาว
+  inline constexpr std::string_view RESET = "\033[0m";    // รีเซ็ตการจัดรูปแบบทั้งหมด
+  inline constexpr std::string_view BLACK = "\033[30m";   // สีดำ
+  inline constexpr std::string_view RED = "\033[31m";     // สีแดง
+  inline constexpr std::string_view GREEN = "\033[32m";   // สีเขียว
+  inline constexpr std::string_view YELLOW = "\033[33m";  // สีเหลือง
+  inline constexpr std::string_view BLUE = "\033[34m";    // สีน้ำเงิน
+  inline constexpr std::string_view MAGENTA = "\033[35m"; // สีม่วง
+  inline constexpr std::string_view CYAN = "\033[36m";    // สีฟ้า
+  inline constexpr std::string_view WHITE = "\033[37m";   // สีขาว
 
   // สีสว่าง (Bright colors)
-  const std::string BRIGHT_BLACK = "\033[90m";   // สีดำสว่าง
-  const std::string BRIGHT_RED = "\033[91m";     // สีแดงสว่าง
-  const std::string BRIGHT_GREEN = "\033[92m";   // สีเขียวสว่าง
-  const std::string BRIGHT_YELLOW = "\033[93m";  // สีเหลืองสว่าง
-  const std::string BRIGHT_BLUE = "\033[94m";    // สีน้ำเงินสว่าง
-  const std::string BRIGHT_MAGENTA = "\033[95m"; // สีม่วงสว่าง
-  const std::string BRIGHT_CYAN = "\033[96m";    // สีฟ้าสว่าง
-  const std::string BRIGHT_WHITE = "\033[97m";   // สีขาวสว่าง
+  inline constexpr std::string_view BRIGHT_BLACK = "\033[90m";   // สีดำสว่าง
+  inline constexpr std::string_view BRIGHT_RED = "\033[91m";     // สีแดงสว่าง
+  inline constexpr std::string_view BRIGHT_GREEN = "\033[92m";   // สีเขียวสว่าง
+  inline constexpr std::string_view BRIGHT_YELLOW = "\033[93m";  // สีเหลืองสว่าง
+  inline constexpr std::string_view BRIGHT_BLUE = "\033[94m";    // สีน้ำเงินสว่าง
+  inline constexpr std::string_view BRIGHT_MAGENTA = "\033[95m"; // สีม่วงสว่าง
+  inline constexpr std::string_view BRIGHT_CYAN = "\033[96m";    // สีฟ้าสว่าง
+  inline constexpr std::string_view BRIGHT_WHITE = "\033[97m";   // สีขาวสว่าง
 
   // รูปแบบข้อความ (Text styles)
-  const std::string BOLD = "\033[1m";      // ตัวหนา
-  const std::string UNDERLINE = "\033[4m"; // ขีดเส้นใต้
-  const std::string ITALIC = "\033[3m";    // ตัวเอียง
+  inline constexpr std::string_view BOLD = "\033[1m";      // ตัวหนา
+  inline constexpr std::string_view UNDERLINE = "\033[4m"; // ขีดเส้นใต้
+  inline constexpr std::string_view ITALIC = "\033[3m";    // ตัวเอียง
+  inline constexpr std::string_view REVERSE = "\033[7m";   // สลับสีตัวอักษรกับพื้นหลัง (ใช้ไฮไลต์)
 
   // สีพื้นหลัง (Background colors)
-  const std::string BG_BLACK = "\033[40m";   // พื้นหลังสีดำ
-  const std::string BG_RED = "\033[41m";     // พื้นหลังสีแดง
-  const std::string BG_GREEN = "\033[42m";   // พื้นหลังสีเขียว
-  const std::string BG_YELLOW = "\033[43m";  // พื้นหลังสีเหลือง
-  const std::string BG_BLUE = "\033[44m";    // พื้นหลังสีน้ำเงิน
-  const std::string BG_MAGENTA = "\033[45m"; // พื้นหลังสีม่วง
-  const std::string BG_CYAN = "\033[46m";    // พื้นหลังสีฟ้า
-  const std::string BG_WHITE = "\033[47m";   // พื้นหลังสีขาว
+  inline constexpr std::string_view BG_BLACK = "\033[40m";   // พื้นหลังสีดำ
+  inline constexpr std::string_view BG_RED = "\033[41m";     // พื้นหลังสีแดง
+  inline constexpr std::string_view BG_GREEN = "\033[42m";   // พื้นหลังสีเขียว
+  inline constexpr std::string_view BG_YELLOW = "\033[43m";  // พื้นหลังสีเหลือง
+  inline constexpr std::string_view BG_BLUE = "\033[44m";    // พื้นหลังสีน้ำเงิน
+  inline constexpr std::string_view BG_MAGENTA = "\033[45m"; // พื้นหลังสีม่วง
+  inline constexpr std::string_view BG_CYAN = "\033[46m";    // พื้นหลังสีฟ้า
+  inline constexpr std::string_view BG_WHITE = "\033[47m";   // พื้นหลังสีขาว
 }
 
 // ไอคอน Unicode สำหรับการแสดงผลในเกม
 namespace Icons
 {
   // ไอคอนพื้นฐานของเกม
-  const std::string CARD = "🃏";      // ไอคอนการ์ด
-  const std::string SWORD = "⚔️";      // ไอคอนการโจมตี
-  const std::string SHIELD = "🛡️";     // ไอคอนการป้องกัน
-  const std::string HEART = "💚";     // ไอคอนพลังชีวิต
-  const std::string DIAMOND = "💎";   // ไอคอนเพชร/ของมีค่า
-  const std::string STAR = "⭐";      // ไอคอนดาว/พิเศษ
-  const std::string FIRE = "🔥";      // ไอคอนไฟ/พลังโจมตี
-  const std::string LIGHTNING = "⚡"; // ไอคอนสายฟ้า
-  const std::string CROWN = "👑";     // ไอคอนมงกุฎ
-  const std::string TARGET = "🎯";    // ไอคอนเป้าหมาย
-  const std::string RUNNER = "🏃";    // ไอคอนการวิ่ง
-  const std::string SLEEP = "💤";     // ไอคอนการพัก
-  const std::string MAGIC = "✨";     // ไอคอนเวทมนตร์
-  const std::string HEAL = "💚";      // ไอคอนการรักษา
-  const std::string DRAW = "📝";      // ไอคอนการจั่วการ์ด
-  const std::string CRITICAL = "💥";  // ไอคอนการโจมตีรุนแรง
-  const std::string DAMAGE = "🩸";    // ไอคอนความเสียหาย
-  const std::string SKULL = "💀";     // ไอคอนหัวกะโหลก
-  const std::string VICTORY = "🏆";   // ไอคอนชัยชนะ
-  const std::string PLAYER = "👤";    // ไอคอนผู้เล่น
-  const std::string TURN = "🔄";      // ไอคอนการเปลี่ยนเทิร์น
-  const std::string PHASE = "⏰";     // ไอคอนเฟส
-  const std::string MENU = "📋";      // ไอคอนเมนู
-  const std::string HELP = "💡";      // ไอคอนช่วยเหลือ
-  const std::string EXIT = "🚪";      // ไอคอนออกจากเกม
-  const std::string NEXT = "▶️";       // ไอคอนถัดไป
-  const std::string BACK = "◀️";       // ไอคอนย้อนกลับ
-  const std::string UP = "⬆️";         // ไอคอนขึ้น
-  const std::string DOWN = "⬇️";       // ไอคอนลง
-  const std::string CONFIRM = "✅";   // ไอคอนยืนยัน
-  const std::string CANCEL = "❌";    // ไอคอนยกเลิก
-  const std::string WARNING = "⚠️";    // ไอคอนคำเตือน
-  const std::string INFO = "ℹ️";       // ไอคอนข้อมูล
-  const std::string DECK = "📚";      // ไอคอนสำรับการ์ด
-  const std::string HAND = "🤲";      // ไอคอนมือ
-  const std::string FIELD = "🏟️";     // ไอคอนสนาม
-  const std::string SOUL = "👻";      // ไอคอนวิญญาณ
-  const std::string DROP = "🗑️";      // ไอคอนการ์ดที่ถูกทิ้ง
-  const std::string GUARD = "🛡️";      // ไอคอนการ์ดป้องกัน
+  inline constexpr std::string_view CARD = "🃏";      // ไอคอนการ์ด
+  inline constexpr std::string_view SWORD = "⚔️";      // ไอคอนการโจมตี
+  inline constexpr std::string_view SHIELD = "🛡️";     // ไอคอนการป้องกัน
+  inline constexpr std::string_view HEART = "💚";     // ไอคอนพลังชีวิต
+  inline constexpr std::string_view DIAMOND = "💎";   // ไอคอนเพชร/ของมีค่า
+  inline constexpr std::string_view STAR = "⭐";      // ไอคอนดาว/พิเศษ
+  inline constexpr std::string_view FIRE = "🔥";      // ไอคอนไฟ/พลังโจมตี
+  inline constexpr std::string_view LIGHTNING = "⚡"; // ไอคอนสายฟ้า
+  inline constexpr std::string_view CROWN = "👑";     // ไอคอนมงกุฎ
+  inline constexpr std::string_view TARGET = "🎯";    // ไอคอนเป้าหมาย
+  inline constexpr std::string_view RUNNER = "🏃";    // ไอคอนการวิ่ง
+  inline constexpr std::string_view SLEEP = "💤";     // ไอคอนการพัก
+  inline constexpr std::string_view MAGIC = "✨";     // ไอคอนเวทมนตร์
+  inline constexpr std::string_view HEAL = "💚";      // ไอคอนการรักษา
+  inline constexpr std::string_view DRAW = "📝";      // ไอคอนการจั่วการ์ด
+  inline constexpr std::string_view CRITICAL = "💥";  // ไอคอนการโจมตีรุนแรง
+  inline constexpr std::string_view DAMAGE = "🩸";    // ไอคอนความเสียหาย
+  inline constexpr std::string_view SKULL = "💀";     // ไอคอนหัวกะโหลก
+  inline constexpr std::string_view VICTORY = "🏆";   // ไอคอนชัยชนะ
+  inline constexpr std::string_view PLAYER = "👤";    // ไอคอนผู้เล่น
+  inline constexpr std::string_view TURN = "🔄";      // ไอคอนการเปลี่ยนเทิร์น
+  inline constexpr std::string_view PHASE = "⏰";     // ไอคอนเฟส
+  inline constexpr std::string_view MENU = "📋";      // ไอคอนเมนู
+  inline constexpr std::string_view HELP = "💡";      // ไอคอนช่วยเหลือ
+  inline constexpr std::string_view EXIT = "🚪";      // ไอคอนออกจากเกม
+  inline constexpr std::string_view NEXT = "▶️";       // ไอคอนถัดไป
+  inline constexpr std::string_view BACK = "◀️";       // ไอคอนย้อนกลับ
+  inline constexpr std::string_view UP = "⬆️";         // ไอคอนขึ้น
+  inline constexpr std::string_view DOWN = "⬇️";       // ไอคอนลง
+  inline constexpr std::string_view CONFIRM = "✅";   // ไอคอนยืนยัน
+  inline constexpr std::string_view CANCEL = "❌";    // ไอคอนยกเลิก
+  inline constexpr std::string_view WARNING = "⚠️";    // ไอคอนคำเตือน
+  inline constexpr std::string_view INFO = "ℹ️";       // ไอคอนข้อมูล
+  inline constexpr std::string_view DECK = "📚";      // ไอคอนสำรับการ์ด
+  inline constexpr std::string_view HAND = "🤲";      // ไอคอนมือ
+  inline constexpr std::string_view FIELD = "🏟️";     // ไอคอนสนาม
+  inline constexpr std::string_view SOUL = "👻";      // ไอคอนวิญญาณ
+  inline constexpr std::string_view DROP = "🗑️";      // ไอคอนการ์ดที่ถูกทิ้ง
+  inline constexpr std::string_view GUARD = "🛡️";      // ไอคอนการ์ดป้องกัน
 }
 
 // ไอคอนแสดงเกรดของการ์ด
 namespace GradeIcons
 {
-  const std::string G0 = "⚪"; // เกรด 0 (สีขาว)
-  const std::string G1 = "🔵"; // เกรด 1 (สีน้ำเงิน)
-  const std::string G2 = "🟡"; // เกรด 2 (สีเหลือง)
-  const std::string G3 = "🟠"; // เกรด 3 (สีส้ม)
-  const std::string G4 = "🔴"; // เกรด 4 (สีแดง)
+  inline constexpr std::string_view G0 = "⚪"; // เกรด 0 (สีขาว)
+  inline constexpr std::string_view G1 = "🔵"; // เกรด 1 (สีน้ำเงิน)
+  inline constexpr std::string_view G2 = "🟡"; // เกรด 2 (สีเหลือง)
+  inline constexpr std::string_view G3 = "🟠"; // เกรด 3 (สีส้ม)
+  inline constexpr std::string_view G4 = "🔴"; // เกรด 4 (สีแดง)
 }
 
+// บัฟเฟอร์ข้อความขนาดคงที่สำหรับประกอบบรรทัดหรือกล่องทั้งก้อนก่อนส่งออกทีเดียว
+// ข้อมูลอยู่ภายในออบเจกต์ (บน stack) เมื่อเต็มจะส่งต่อไปที่ Out() แล้วเขียนต่อ
+// จึงวาดหน้าจอได้โดยไม่ต้องจองหน่วยความจำบน heap เลย
+class TextBuffer
+{
+private:
+  char data[1024]; // ข้อความที่รอส่งออก
+  size_t used;     // จำนวนไบต์ที่ใช้ไปแล้ว
+
+  void Reserve(size_t bytes); // ส่งข้อมูลออกก่อนถ้าที่ว่างไม่พอ
+  TextBuffer &AppendSigned(long long value);
+  TextBuffer &AppendUnsigned(unsigned long long value);
+
+public:
+  TextBuffer() : used(0) {}
+  ~TextBuffer() { Flush(); }
+  TextBuffer(const TextBuffer &) = delete;
+  TextBuffer &operator=(const TextBuffer &) = delete;
+
+  TextBuffer &Append(std::string_view text);                   // ต่อข้อความ
+  TextBuffer &Append(char c);                                  // ต่อตัวอักษร 1 ตัว
+  TextBuffer &Repeat(std::string_view glyph, int count);       // ต่อสัญลักษณ์ซ้ำ count ครั้ง
+  TextBuffer &Repeat(char c, int count);                       // ต่อตัวอักษรซ้ำ count ครั้ง
+  TextBuffer &Spaces(int count) { return Repeat(' ', count); } // ต่อช่องว่าง
+  void Flush();                                                // ส่งข้อความที่ค้างอยู่ไปที่ Out()
+
+  TextBuffer &operator<<(std::string_view text) { return Append(text); }
+  TextBuffer &operator<<(char c) { return Append(c); }
+  template <typename Integer>
+  typename std::enable_if<std::is_integral<Integer>::value, TextBuffer &>::type operator<<(Integer value)
+  {
+    if (std::is_signed<Integer>::value)
+      return AppendSigned(static_cast<long long>(value));
+    return AppendUnsigned(static_cast<unsigned long long>(value));
+  }
+};
+
 class UIHelper
 {
 public:
@@ -112,15 +154,24 @@ public:
   static void ShowLoadingAnimation(const std::string &message, int duration_ms = 1500); // แสดงแอนิเมชันโหลด
 
   // การวาดกล่อง
-  static void PrintHorizontalLine(char c = '=', int length = 70, const std::string &color = Colors::CYAN);    // วาดเส้นแนวนอน
-  static void PrintHorizontalLine(const std::string &s, int length, const std::string &color = Colors::CYAN); // วาดเส้นแนวนอนด้วยข้อความ
-  static void PrintBox(const std::string &content, const std::string &title = "",
-                       const std::string &border_color = Colors::CYAN,
-                       const std::string &text_color = Colors::WHITE); // วาดกล่องข้อความ
-  static void PrintSectionHeader(const std::string &title, const std::string &icon = Icons::STAR,
-                                 const std::string &color = Colors::BRIGHT_YELLOW); // แสดงหัวข้อส่วน
-  static void PrintPhaseHeader(const std::string &phase_name, const std::string &player_name,
-                               int turn_number = 0, const std::string &color = Colors::BRIGHT_CYAN); // แสดงหัวข้อเฟส
+  static void PrintHorizontalLine(char c = '=', int length = 70, std::string_view color = Colors::CYAN);  // วาดเส้นแนวนอน
+  static void PrintHorizontalLine(std::string_view s, int length, std::string_view color = Colors::CYAN); // วาดเส้นแนวนอนด้วยข้อความ
+  static void PrintBox(std::string_view content, std::string_view title = "",
+                       std::string_view border_color = Colors::CYAN,
+                       std::string_view text_color = Colors::WHITE); // วาดกล่องข้อความ
+  static void PrintSectionHeader(std::string_view title, std::string_view icon = Icons::STAR,
+                                 std::string_view color = Colors::BRIGHT_YELLOW); // แสดงหัวข้อส่วน
+  static void PrintPhaseHeader(std::string_view phase_name, std::string_view player_name,
+                               int turn_number = 0, std::string_view color = Colors::BRIGHT_CYAN); // แสดงหัวข้อเฟส
+
+  // การวาดลงบัฟเฟอร์ (ใช้ประกอบหลายส่วนเป็นหน้าจอเดียวโดยไม่จองหน่วยความจำ)
+  static void AppendHorizontalLine(TextBuffer &out, std::string_view s, int length,
+                                   std::string_view color = Colors::CYAN); // ต่อเส้นแนวนอน
+  static void AppendBox(TextBuffer &out, std::string_view content, std::string_view title = "",
+                        std::string_view border_color = Colors::CYAN,
+                        std::string_view text_color = Colors::WHITE); // ต่อกล่องข้อความ
+  static void AppendSectionHeader(TextBuffer &out, std::string_view title, std::string_view icon = Icons::STAR,
+                                  std::string_view color = Colors::BRIGHT_YELLOW); // ต่อหัวข้อส่วน
 
   // ประเภทข้อความ
   static void PrintSuccess(const std::string &message); // แสดงข้อความสำเร็จ
@@ -133,6 +184,7 @@ public:
   static void PrintQuickStatus(const std::string &player_name, int hand_size, int deck_size,
                                int damage_count, int soul_count, int drop_count); // แสดงสถานะเกมแบบย่อ
   static void PrintShortcuts();                                                   // แสดงทางลัด
+  static void AppendShortcuts(TextBuffer &out);                                   // ต่อข้อความทางลัดลงบัฟเฟอร์
 
   // ความคืบหน้า/แอนิเมชัน
   static void PrintProgressBar(int current, int max, const std::string &label = ""); // แสดงแถบความคืบหน้า
@@ -140,13 +192,16 @@ public:
   static void ShowDriveCheckAnimation();                                             // แสดงแอนิเมชันตรวจสอบการ์ด
   static void ShowDamageAnimation();                                                 // แสดงแอนิเมชันความเสียหาย
   static void ShowPhaseTransition(const std::string &from, const std::string &to);   // แสดงการเปลี่ยนเฟส
+  static void SetAnimationEnabled(bool enabled);                                     // เปิด/ปิดแอนิเมชันและการหน่วงเวลา
+  static bool IsAnimationEnabled();                                                  // ตรวจสอบว่าเปิดแอนิเมชันอยู่หรือไม่
 
   // ตัวช่วยสำหรับการป้อนข้อมูล
-  static std::string ColorText(const std::string &text, const std::string &color); // เปลี่ยนสีข้อความ
-  static std::string FormatCard(const std::string &name, int grade, bool is_standing = true,
-                                bool show_icons = true); // จัดรูปแบบการ์ด
-  static std::string GetGradeIcon(int grade);            // รับไอคอนเกรด
-  static std::string GetStatusIcon(bool is_standing);    // รับไอคอนสถานะ
+  static std::string ColorText(std::string_view text, std::string_view color); // เปลี่ยนสีข้อความ
+  static std::string FormatCard(std::string_view name, int grade, bool is_standing = true,
+                                bool show_icons = true);                       // จัดรูปแบบการ์ด
+  static std::string_view GetGradeIcon(int grade);                             // รับไอคอนเกรด
+  static std::string_view GetStatusIcon(bool is_standing);                     // รับไอคอนสถานะ
+  static std::string Join(std::initializer_list<std::string_view> parts);      // ต่อข้อความหลายส่วนด้วยการจองหน่วยความจำครั้งเดียว
 
   // ตัวช่วยแสดงการ์ด
   static std::string FormatPowerShield(int power, int shield);                                     // จัดรูปแบบพลังและโล่
@@ -155,15 +210,13 @@ public:
   // ตัวช่วยการจัดวาง
   static void PrintCardPreview(const std::string &name, int grade, int power, int shield,
                                int critical, const std::string &skill, const std::string &type); // แสดงตัวอย่างการ์ด
-  static void PrintBattleStats(const std::string &attacker_name, int attack_power, int critical,
-                               const std::string &defender_name, int defense_power); // แสดงสถิติการต่อสู้
+  static void PrintBattleStats(std::string_view attacker_name, int attack_power, int critical,
+                               std::string_view defender_name, int defense_power); // แสดงสถิติการต่อสู้
 
-  static int GetDisplayWidth(const std::string &str); // รับความกว้างของการแสดงผล
+  static int GetDisplayWidth(std::string_view str); // รับความกว้างของการแสดงผล
 
-private:
-  static std::string RepeatChar(char c, int n);               // ทำซ้ำตัวอักษร
-  static std::string RepeatChar(wchar_t wc, int n);           // ทำซ้ำตัวอักษรแบบ wide
-  static std::string RepeatChar(const std::string &s, int n); // ทำซ้ำข้อความ
+  // แถบสัญลักษณ์ซ้ำที่คำนวณไว้ตั้งแต่ตอนคอมไพล์ (คืนค่าว่างถ้าไม่มีแถบของสัญลักษณ์นั้น)
+  static std::string_view GetGlyphStrip(std::string_view glyph);
 };
 
 #endif // UIHELPER_H
\ No newline at end of file